@@ -3,6 +3,8 @@
 #include <chrono>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <vector>
 
 #include <hot/rowex/HOTRowex.hpp>
 #include <idx/benchmark/Benchmark.hpp>
@@ -15,7 +17,7 @@ class HotRowexIntegerBenchmarkWrapper {
 	using NoThreadInfo = idx::benchmark::NoThreadInfo;
 	using TrieType = hot::rowex::HOTRowex<uint64_t, idx::contenthelpers::IdentityKeyExtractor>;
 	TrieType mTrie;
-
+	std::unique_ptr<TrieType> mBulkLoadedTrie;
 
 public:
 	inline NoThreadInfo getThreadInformation() const {
@@ -32,6 +34,15 @@ public:
 		return result.mIsValid & (result.mValue == key);
 	}
 
+	inline bool bulkLoadParallel(std::vector<uint64_t> const & sortedKeys) {
+		mBulkLoadedTrie.reset(new TrieType());
+		return mBulkLoadedTrie->bulkLoadParallel(sortedKeys.begin(), sortedKeys.end()) == sortedKeys.size();
+	}
+
+	inline void releaseBulkLoadedIndex() {
+		mBulkLoadedTrie.reset();
+	}
+
 	inline bool iterateAll(NoThreadInfo /* unused dummy threadInformation */, std::vector<uint64_t> const & iterateKeys) {
 		size_t i=0;
 		bool iteratedAll = true;
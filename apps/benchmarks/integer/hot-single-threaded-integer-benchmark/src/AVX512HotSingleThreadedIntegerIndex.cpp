@@ -0,0 +1,22 @@
+//compiles the benchmarked index for AVX-512, even if the benchmark is compiled for the x86-64 baseline
+#define HOT_TARGET_AVX512
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <idx/contenthelpers/IdentityKeyExtractor.hpp>
+
+#include "HotSingleThreadedIntegerIndex.hpp"
+
+#include <hot/commons/BeginInstructionSetTarget.hpp>
+#include "HotSingleThreadedIntegerIndexImplementation.hpp"
+#include <hot/commons/EndInstructionSetTarget.hpp>
+
+std::unique_ptr<HotSingleThreadedIntegerIndex> createAVX512HotSingleThreadedIntegerIndex() {
+	return createHotSingleThreadedIntegerIndex();
+}
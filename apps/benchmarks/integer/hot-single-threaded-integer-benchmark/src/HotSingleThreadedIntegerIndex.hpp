@@ -0,0 +1,46 @@
+#ifndef __HOT_SINGLE_THREADED_INTEGER_INDEX__
+#define __HOT_SINGLE_THREADED_INTEGER_INDEX__
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * The operations of single threaded HOT which are benchmarked. The interface does not depend on the instruction set HOT is compiled for,
+ * which allows to benchmark each variant of the index through the same wrapper. For the semantics of the operations see HotSingleThreadedIntegerBenchmarkWrapper.
+ */
+class HotSingleThreadedIntegerIndex {
+public:
+	virtual ~HotSingleThreadedIntegerIndex() = default;
+
+	virtual bool insert(uint64_t key) = 0;
+	virtual bool remove(uint64_t key) = 0;
+	virtual bool removeBatch(uint64_t const * sortedKeys, size_t numberKeys) = 0;
+	virtual bool search(uint64_t key) = 0;
+	virtual bool searchBatch(uint64_t const * keys, size_t numberKeys) = 0;
+	virtual bool bulkLoad(std::vector<uint64_t> const & sortedKeys) = 0;
+	virtual bool bulkLoadParallel(std::vector<uint64_t> const & sortedKeys) = 0;
+	virtual void releaseBulkLoadedIndex() = 0;
+	virtual bool iterateAll(std::vector<uint64_t> const & iterateKeys) = 0;
+	virtual bool scanWithIterator(uint64_t startKey, size_t numberValues, uint64_t expectedLastKey) = 0;
+	virtual bool scanRange(uint64_t startKey, size_t numberValues, uint64_t expectedLastKey) = 0;
+	virtual std::pair<size_t, std::map<std::string, double>> getStatistics() = 0;
+};
+
+using HotSingleThreadedIntegerIndexFactory = std::unique_ptr<HotSingleThreadedIntegerIndex> (*)();
+
+/**
+ * @return the index compiled for AVX2 in a target region, regardless of the instruction set the benchmark is compiled for
+ */
+std::unique_ptr<HotSingleThreadedIntegerIndex> createAVX2HotSingleThreadedIntegerIndex();
+
+/**
+ * @return the index compiled for AVX-512 in a target region, regardless of the instruction set the benchmark is compiled for
+ */
+std::unique_ptr<HotSingleThreadedIntegerIndex> createAVX512HotSingleThreadedIntegerIndex();
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef __HOT_SINGLE_THREADED_INTEGER_INDEX_IMPLEMENTATION__
+#define __HOT_SINGLE_THREADED_INTEGER_INDEX_IMPLEMENTATION__
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <hot/singlethreaded/HOTSingleThreaded.hpp>
+#include <hot/singlethreaded/HOTSingleThreadedParallelBulkLoad.hpp>
+#include <idx/contenthelpers/IdentityKeyExtractor.hpp>
+#include <idx/contenthelpers/OptionalValue.hpp>
+
+#include "HotSingleThreadedIntegerIndex.hpp"
+
+/**
+ * The implementation is included by each translation unit compiling a variant of the index. It has internal linkage,
+ * which ensures that each variant runs its own code instead of the code of another variant selected by the linker.
+ */
+namespace {
+
+constexpr size_t LOOKUP_BATCH_BUFFER_SIZE = 256;
+
+/**
+ * Single threaded HOT compiled for the instruction set of the translation unit including this header
+ */
+class HotSingleThreadedIntegerIndexImplementation final : public HotSingleThreadedIntegerIndex {
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<uint64_t, idx::contenthelpers::IdentityKeyExtractor>;
+	TrieType mTrie;
+	TrieType mBulkLoadedTrie;
+
+public:
+	bool insert(uint64_t key) override {
+		return mTrie.insert(key);
+	}
+
+	bool remove(uint64_t key) override {
+		return mTrie.remove(key);
+	}
+
+	bool removeBatch(uint64_t const * sortedKeys, size_t numberKeys) override {
+		return mTrie.removeBatch(sortedKeys, numberKeys) == numberKeys;
+	}
+	
+	bool search(uint64_t key) override {
+		idx::contenthelpers::OptionalValue<uint64_t> result = mTrie.lookup(key);
+		return result.mIsValid & (result.mValue == key);
+	}
+
+	bool searchBatch(uint64_t const * keys, size_t numberKeys) override {
+		std::array<idx::contenthelpers::OptionalValue<uint64_t>, LOOKUP_BATCH_BUFFER_SIZE> results;
+		bool allLookedUp = true;
+		for(size_t batchStart = 0; batchStart < numberKeys; batchStart += LOOKUP_BATCH_BUFFER_SIZE) {
+			size_t batchSize = std::min(LOOKUP_BATCH_BUFFER_SIZE, numberKeys - batchStart);
+			mTrie.lookupBatch(keys + batchStart, batchSize, results.data());
+			for(size_t i = 0; i < batchSize; ++i) {
+				allLookedUp &= results[i].mIsValid & (results[i].mValue == keys[batchStart + i]);
+			}
+		}
+		return allLookedUp;
+	}
+
+	bool bulkLoad(std::vector<uint64_t> const & sortedKeys) override {
+		mBulkLoadedTrie = TrieType();
+		return mBulkLoadedTrie.bulkLoad(sortedKeys.begin(), sortedKeys.end()) == sortedKeys.size();
+	}
+
+	bool bulkLoadParallel(std::vector<uint64_t> const & sortedKeys) override {
+		mBulkLoadedTrie = TrieType();
+		return hot::singlethreaded::bulkLoadParallel(mBulkLoadedTrie, sortedKeys.begin(), sortedKeys.end()) == sortedKeys.size();
+	}
+
+	void releaseBulkLoadedIndex() override {
+		mBulkLoadedTrie = TrieType();
+	}
+
+	bool iterateAll(std::vector<uint64_t> const & iterateKeys) override {
+		size_t i=0;
+		bool iteratedAll = true;
+		for(uint64_t value : mTrie) {
+			iteratedAll = iteratedAll & (value == iterateKeys[i]);
+			++i;
+		}
+		return iteratedAll & (i == iterateKeys.size());
+	}
+
+	bool scanWithIterator(uint64_t startKey, size_t numberValues, uint64_t expectedLastKey) override {
+		uint64_t lastValue = 0;
+		TrieType::const_iterator iterator = mTrie.lower_bound(startKey);
+		for(size_t i = 0; i < numberValues && iterator != mTrie.end(); ++i, ++iterator) {
+			lastValue = *iterator;
+		}
+		return lastValue == expectedLastKey;
+	}
+
+	bool scanRange(uint64_t startKey, size_t numberValues, uint64_t expectedLastKey) override {
+		uint64_t lastValue = 0;
+		mTrie.scanRangeWithLimit(startKey, numberValues, [&](uint64_t const * values, size_t numberScannedValues) {
+			lastValue = values[numberScannedValues - 1];
+		});
+		return lastValue == expectedLastKey;
+	}
+
+	std::pair<size_t, std::map<std::string, double>> getStatistics() override {
+		return mTrie.getStatistics();
+	}
+};
+
+std::unique_ptr<HotSingleThreadedIntegerIndex> createHotSingleThreadedIntegerIndex() {
+	return std::unique_ptr<HotSingleThreadedIntegerIndex>(new HotSingleThreadedIntegerIndexImplementation());
+}
+
+}
+
+#endif
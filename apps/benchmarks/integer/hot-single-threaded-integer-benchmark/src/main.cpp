@@ -1,47 +1,94 @@
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <chrono>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <vector>
 
-#include <hot/singlethreaded/HOTSingleThreaded.hpp>
+#include <hot/commons/InstructionSetDispatch.hpp>
 #include <idx/benchmark/Benchmark.hpp>
-#include <idx/contenthelpers/IdentityKeyExtractor.hpp>
-#include <idx/contenthelpers/OptionalValue.hpp>
+
+#include "HotSingleThreadedIntegerIndex.hpp"
+#include "HotSingleThreadedIntegerIndexImplementation.hpp"
+
+#ifdef USE_INSTRUCTION_SET_VARIANTS
+using BenchmarkedIndex = HotSingleThreadedIntegerIndex;
+
+/**
+ * @return the variant of the index compiled for the highest instruction set supported by the processor
+ */
+std::unique_ptr<BenchmarkedIndex> createBenchmarkedIndex() {
+	return hot::commons::selectForSupportedInstructionSet<HotSingleThreadedIntegerIndexFactory>({
+		&createHotSingleThreadedIntegerIndex, &createAVX2HotSingleThreadedIntegerIndex, &createAVX512HotSingleThreadedIntegerIndex
+	})();
+}
+#else
+//as the implementation is final, its operations are called directly and can be inlined
+using BenchmarkedIndex = HotSingleThreadedIntegerIndexImplementation;
+
+std::unique_ptr<BenchmarkedIndex> createBenchmarkedIndex() {
+	return std::unique_ptr<BenchmarkedIndex>(new BenchmarkedIndex());
+}
+#endif
 
 /**
  * Wrapper class to fulfill the requirements of the benchmarking framework
  */
 class HotSingleThreadedIntegerBenchmarkWrapper {
-	using TrieType = hot::singlethreaded::HOTSingleThreaded<uint64_t, idx::contenthelpers::IdentityKeyExtractor>;
-	TrieType mTrie;
+	std::unique_ptr<BenchmarkedIndex> mIndex;
 
 public:
+	HotSingleThreadedIntegerBenchmarkWrapper() : mIndex(createBenchmarkedIndex()) {
+	}
+
 	inline bool insert(uint64_t key) {
-		return mTrie.insert(key);
+		return mIndex->insert(key);
 	}
 
 	inline bool remove(uint64_t key) {
-		return mTrie.remove(key);
+		return mIndex->remove(key);
+	}
+
+	inline bool removeBatch(uint64_t const * sortedKeys, size_t numberKeys) {
+		return mIndex->removeBatch(sortedKeys, numberKeys);
 	}
-	
+
 	inline bool search(uint64_t key) {
-		idx::contenthelpers::OptionalValue<uint64_t> result = mTrie.lookup(key);
-		return result.mIsValid & (result.mValue == key);
+		return mIndex->search(key);
+	}
+
+	inline bool searchBatch(uint64_t const * keys, size_t numberKeys) {
+		return mIndex->searchBatch(keys, numberKeys);
+	}
+
+	inline bool bulkLoad(std::vector<uint64_t> const & sortedKeys) {
+		return mIndex->bulkLoad(sortedKeys);
+	}
+
+	inline bool bulkLoadParallel(std::vector<uint64_t> const & sortedKeys) {
+		return mIndex->bulkLoadParallel(sortedKeys);
+	}
+
+	inline void releaseBulkLoadedIndex() {
+		mIndex->releaseBulkLoadedIndex();
 	}
 
 	inline bool iterateAll(std::vector<uint64_t> const & iterateKeys) {
-		size_t i=0;
-		bool iteratedAll = true;
-		for(uint64_t value : mTrie) {
-			iteratedAll = iteratedAll & (value == iterateKeys[i]);
-			++i;
-		}
-		return iteratedAll & (i == iterateKeys.size());
+		return mIndex->iterateAll(iterateKeys);
+	}
+
+	inline bool scanWithIterator(uint64_t startKey, size_t numberValues, uint64_t expectedLastKey) {
+		return mIndex->scanWithIterator(startKey, numberValues, expectedLastKey);
+	}
+
+	inline bool scanRange(uint64_t startKey, size_t numberValues, uint64_t expectedLastKey) {
+		return mIndex->scanRange(startKey, numberValues, expectedLastKey);
 	}
 
 	idx::benchmark::IndexStatistics getStatistics() {
-		std::pair<size_t, std::map<std::string, double>> stats = mTrie.getStatistics();
+		std::pair<size_t, std::map<std::string, double>> stats = mIndex->getStatistics();
 
 		return { stats.first, stats.second };
 	}
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <hot/singlethreaded/HOTSingleThreaded.hpp>
+#include <idx/contenthelpers/IdentityKeyExtractor.hpp>
+
+constexpr size_t NUMBER_LOOKUP_ROUNDS = 5;
+
+template<typename Operation> double measureNanosecondsPerOperation(size_t numberOperations, Operation const & operation) {
+	auto start = std::chrono::steady_clock::now();
+	operation();
+	std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+	return duration.count() / numberOperations;
+}
+
+/**
+ * @return the median of the nanoseconds per lookup of all rounds looking up each key once
+ */
+template<typename TrieType, typename KeyType> double benchmarkLookups(TrieType const & trie, std::vector<KeyType> const & keys, uint64_t & checksum) {
+	std::vector<double> nanosecondsPerLookup;
+	for(size_t round = 0; round < NUMBER_LOOKUP_ROUNDS; ++round) {
+		nanosecondsPerLookup.push_back(measureNanosecondsPerOperation(keys.size(), [&]() {
+			for(KeyType const & key : keys) {
+				checksum += trie.lookup(key).mIsValid;
+			}
+		}));
+	}
+	std::sort(nanosecondsPerLookup.begin(), nanosecondsPerLookup.end());
+	return nanosecondsPerLookup[NUMBER_LOOKUP_ROUNDS / 2];
+}
+
+/**
+ * inserts all values into a trie, freezes it and compares the lookup latency and the memory consumption of both representations
+ */
+template<typename ValueType> void benchmark(std::string const & name, std::vector<ValueType> values, std::mt19937_64 & randomGenerator, uint64_t & checksum) {
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthelpers::IdentityKeyExtractor>;
+	TrieType trie;
+	for(ValueType const & value : values) {
+		trie.insert(value);
+	}
+	auto frozenTrie = trie.freeze();
+	std::shuffle(values.begin(), values.end(), randomGenerator);
+
+	double mutableNanoseconds = benchmarkLookups(trie, values, checksum);
+	double frozenNanoseconds = benchmarkLookups(frozenTrie, values, checksum);
+	std::cout << name << "\t" << frozenTrie.getNumberValues() << "\t\t" << mutableNanoseconds << "\t\t" << frozenNanoseconds
+		<< "\t\t" << trie.getStatistics().first << "\t\t" << frozenTrie.getSizeInBytes() << std::endl;
+}
+
+/**
+ * Compares lookups in a mutable HOTSingleThreaded instance with lookups in its frozen representation.
+ *
+ * usage: frozen-lookup-benchmark [numberKeys]
+ */
+int main(int argc, char** argv) {
+	size_t numberKeys = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+	std::mt19937_64 randomGenerator(42u);
+	uint64_t checksum = 0;
+
+	std::vector<uint64_t> integers;
+	for(size_t i = 0; i < numberKeys; ++i) {
+		//values stored in HOT must not use the most significant bit
+		integers.push_back(randomGenerator() >> 1u);
+	}
+
+	std::vector<std::string> strings;
+	for(size_t i = 0; i < numberKeys; ++i) {
+		std::string string = "key" + std::to_string(randomGenerator() % (numberKeys * 10u));
+		strings.push_back(string + std::string(randomGenerator() % 16u, 'x'));
+	}
+	std::vector<char const*> cStrings;
+	for(std::string const & string : strings) {
+		cStrings.push_back(string.c_str());
+	}
+
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << "keys\t\tvalues\t\tmutable [ns/lookup]\tfrozen [ns/lookup]\tmutable [bytes]\tfrozen [bytes]" << std::endl;
+	benchmark("uint64_t", integers, randomGenerator, checksum);
+	benchmark("string\t", cStrings, randomGenerator, checksum);
+	std::cout << std::endl << "checksum: " << checksum << std::endl;
+
+	return 0;
+}
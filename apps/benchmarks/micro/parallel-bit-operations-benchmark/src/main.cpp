@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <hot/commons/ParallelBitOperations.hpp>
+#include <hot/singlethreaded/HOTSingleThreaded.hpp>
+#include <idx/contenthelpers/IdentityKeyExtractor.hpp>
+
+using hot::commons::ParallelBitOperationsImplementation;
+
+constexpr size_t NUMBER_OPERANDS = 4096;
+constexpr size_t NUMBER_OPERATION_ROUNDS = 2000;
+constexpr size_t NUMBER_LOOKUP_ROUNDS = 5;
+
+using TrieType = hot::singlethreaded::HOTSingleThreaded<uint64_t, idx::contenthelpers::IdentityKeyExtractor>;
+
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+std::vector<ParallelBitOperationsImplementation> const IMPLEMENTATIONS {
+	ParallelBitOperationsImplementation::Instructions, ParallelBitOperationsImplementation::Emulation
+};
+#else
+//without the emulation compiled in, the instructions are used without checking the selected implementation, which is the baseline for the costs of this check
+std::vector<ParallelBitOperationsImplementation> const IMPLEMENTATIONS {
+	ParallelBitOperationsImplementation::Instructions
+};
+#endif
+
+std::string getName(ParallelBitOperationsImplementation implementation) {
+	return implementation == ParallelBitOperationsImplementation::Instructions ? "pext/pdep" : "emulation";
+}
+
+void printHeader(std::string const & parameterName, std::string const & unit) {
+	std::cout << std::endl << parameterName;
+	for(ParallelBitOperationsImplementation implementation : IMPLEMENTATIONS) {
+		std::cout << "\t" << getName(implementation) << " " << unit;
+	}
+	std::cout << std::endl;
+}
+
+template<typename Operation> double measureNanosecondsPerOperation(size_t numberOperations, Operation const & operation) {
+	auto start = std::chrono::steady_clock::now();
+	operation();
+	std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+	return duration.count() / numberOperations;
+}
+
+/**
+ * creates masks with the given number of bits set, which are spread over all 64 bits like the masks used by SingleMaskPartialKeyMapping
+ */
+std::vector<uint64_t> getRandomMasks(std::mt19937_64 & randomGenerator, size_t numberBitsSet) {
+	std::vector<uint64_t> masks;
+	for(size_t i = 0; i < NUMBER_OPERANDS; ++i) {
+		uint64_t mask = 0;
+		while(static_cast<size_t>(hot::commons::populationCount64(mask)) < numberBitsSet) {
+			mask |= 1ul << (randomGenerator() % 64u);
+		}
+		masks.push_back(mask);
+	}
+	return masks;
+}
+
+/**
+ * Measures the latency of extracting a partial key with a different mask each time, which corresponds to a lookup traversing a path of nodes.
+ * Each extraction depends on the previous one, like the next node to visit depends on the partial key of the current node.
+ * Like the partial key mappings of the nodes, the emulation steps of each mask are computed in advance.
+ */
+double benchmarkExtraction(std::vector<uint64_t> const & sources, std::vector<uint64_t> const & masks, uint64_t & checksum) {
+	std::vector<hot::commons::ParallelBitOperationsEmulationSteps<uint64_t>> steps;
+	for(uint64_t mask : masks) {
+		steps.emplace_back(mask);
+	}
+	return measureNanosecondsPerOperation(NUMBER_OPERATION_ROUNDS * NUMBER_OPERANDS, [&]() {
+		uint64_t extractedBits = 0;
+		for(size_t round = 0; round < NUMBER_OPERATION_ROUNDS; ++round) {
+			for(size_t i = 0; i < NUMBER_OPERANDS; ++i) {
+				extractedBits = hot::commons::extractBits64(sources[i] ^ (extractedBits & 1u), masks[i], steps[i]);
+			}
+		}
+		checksum += extractedBits;
+	});
+}
+
+/**
+ * Measures recoding the 32 partial keys of a node with fixed masks, like a node is copied while removing or adding a discriminative bit.
+ */
+double benchmarkRecoding(std::vector<uint64_t> const & sources, std::vector<uint64_t> const & masks, uint64_t & checksum) {
+	constexpr size_t NUMBER_ENTRIES = 32;
+	return measureNanosecondsPerOperation(NUMBER_OPERATION_ROUNDS * NUMBER_OPERANDS / NUMBER_ENTRIES, [&]() {
+		std::array<uint32_t, NUMBER_ENTRIES> recodedPartialKeys;
+		for(size_t round = 0; round < NUMBER_OPERATION_ROUNDS; ++round) {
+			for(size_t node = 0; node < NUMBER_OPERANDS; node += NUMBER_ENTRIES) {
+				hot::commons::ParallelBitMask<uint32_t> const compression(static_cast<uint32_t>(masks[node]));
+				hot::commons::ParallelBitMask<uint32_t> const recoding(static_cast<uint32_t>(masks[node] >> 32u));
+				for(size_t i = 0; i < NUMBER_ENTRIES; ++i) {
+					recodedPartialKeys[i] = recoding.depositBits(compression.extractBits(static_cast<uint32_t>(sources[node + i])));
+				}
+				checksum += recodedPartialKeys[round % NUMBER_ENTRIES];
+			}
+		}
+	});
+}
+
+double benchmarkLookups(TrieType const & trie, std::vector<uint64_t> const & keys, uint64_t & checksum) {
+	std::vector<double> nanosecondsPerLookup;
+	for(size_t round = 0; round < NUMBER_LOOKUP_ROUNDS; ++round) {
+		nanosecondsPerLookup.push_back(measureNanosecondsPerOperation(keys.size(), [&]() {
+			for(uint64_t key : keys) {
+				checksum += trie.lookup(key).mIsValid;
+			}
+		}));
+	}
+	std::sort(nanosecondsPerLookup.begin(), nanosecondsPerLookup.end());
+	return nanosecondsPerLookup[NUMBER_LOOKUP_ROUNDS / 2];
+}
+
+/**
+ * Compares the pext and pdep instructions with their emulation on the executing processor.
+ * The emulation is only measured if the benchmark is compiled with USE_PARALLEL_BIT_OPERATIONS_EMULATION, otherwise the instructions are measured without checking the selected implementation.
+ *
+ * usage: parallel-bit-operations-benchmark [numberKeys]
+ */
+int main(int argc, char** argv) {
+	size_t numberKeys = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+	std::mt19937_64 randomGenerator(42u);
+	uint64_t checksum = 0;
+
+	std::cout << "detected implementation: " << getName(hot::commons::detectPreferredParallelBitOperationsImplementation()) << std::endl;
+	std::cout << "emulation compiled in: " << (IMPLEMENTATIONS.size() > 1u ? "yes" : "no") << std::endl;
+	std::cout << std::fixed << std::setprecision(2);
+
+	std::vector<uint64_t> sources;
+	for(size_t i = 0; i < NUMBER_OPERANDS; ++i) {
+		sources.push_back(randomGenerator());
+	}
+
+	printHeader("bits set", "[ns/extract]");
+	for(size_t numberBitsSet : { 4u, 8u, 16u, 24u, 32u }) {
+		std::vector<uint64_t> masks = getRandomMasks(randomGenerator, numberBitsSet);
+		std::cout << numberBitsSet;
+		for(ParallelBitOperationsImplementation implementation : IMPLEMENTATIONS) {
+			hot::commons::setParallelBitOperationsImplementation(implementation);
+			std::cout << "\t\t" << benchmarkExtraction(sources, masks, checksum);
+		}
+		std::cout << std::endl;
+	}
+
+	printHeader("bits set", "[ns/node]");
+	for(size_t numberBitsSet : { 16u, 32u }) {
+		std::vector<uint64_t> masks = getRandomMasks(randomGenerator, numberBitsSet);
+		std::cout << numberBitsSet;
+		for(ParallelBitOperationsImplementation implementation : IMPLEMENTATIONS) {
+			hot::commons::setParallelBitOperationsImplementation(implementation);
+			std::cout << "\t\t" << benchmarkRecoding(sources, masks, checksum);
+		}
+		std::cout << std::endl;
+	}
+
+	std::vector<uint64_t> keys;
+	TrieType trie;
+	for(size_t i = 0; i < numberKeys; ++i) {
+		//values stored in HOT must not use the most significant bit
+		uint64_t key = randomGenerator() >> 1u;
+		if(trie.insert(key)) {
+			keys.push_back(key);
+		}
+	}
+	std::shuffle(keys.begin(), keys.end(), randomGenerator);
+
+	printHeader("keys\t", "[ns/lookup]");
+	std::cout << keys.size();
+	for(ParallelBitOperationsImplementation implementation : IMPLEMENTATIONS) {
+		hot::commons::setParallelBitOperationsImplementation(implementation);
+		std::cout << "\t\t" << benchmarkLookups(trie, keys, checksum);
+	}
+	std::cout << std::endl << std::endl << "checksum: " << checksum << std::endl;
+
+	return 0;
+}
@@ -1,3 +1,5 @@
+#include <cstring>
+
 #include <hot/rowex/HOTRowex.hpp>
 #include <idx/benchmark/StringBenchmark.hpp>
 
@@ -39,6 +41,20 @@ public:
 		return iteratedAll && i == iterateKeys.size();
 	}
 
+	bool prefixScanWithLowerBound(NoThreadInfo /* unused dummy threadInformation */, std::pair<char*, size_t> const & prefix, size_t expectedNumberValues) {
+		size_t numberValues = 0;
+		for(TrieType::const_iterator it = mTrie.lower_bound(prefix.first); it != mTrie.end() && std::strncmp(*it, prefix.first, prefix.second) == 0; ++it) {
+			++numberValues;
+		}
+		return numberValues == expectedNumberValues;
+	}
+
+	bool prefixScan(NoThreadInfo /* unused dummy threadInformation */, std::pair<char*, size_t> const & prefix, size_t expectedNumberValues) {
+		size_t numberValues = mTrie.prefixScan(prefix.first, prefix.second, [](const char* const * /* values */, size_t /* numberValues */) {
+		});
+		return numberValues == expectedNumberValues;
+	}
+
 	idx::benchmark::IndexStatistics getStatistics() {
 		std::pair<size_t, std::map<std::string, double>> stats = mTrie.getStatistics();
 		return { stats.first, stats.second };
@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+
 #include <hot/singlethreaded/HOTSingleThreaded.hpp>
 #include <idx/benchmark/StringBenchmark.hpp>
 
@@ -5,6 +9,8 @@
 #include <idx/contenthelpers/OptionalValue.hpp>
 
 
+constexpr size_t LOOKUP_BATCH_BUFFER_SIZE = 256;
+
 class HotSingleThreadedBenchmarkWrapper {
 	using TrieType = hot::singlethreaded::HOTSingleThreaded<const char*, idx::contenthelpers::IdentityKeyExtractor>;
 	TrieType mTrie;
@@ -23,6 +29,22 @@ public:
 		return result.mIsValid;
 	}
 
+	bool searchBatch(std::pair<char*, size_t> const * lookupKeys, size_t numberKeys) {
+		std::array<const char*, LOOKUP_BATCH_BUFFER_SIZE> keys;
+		std::array<idx::contenthelpers::OptionalValue<const char*>, LOOKUP_BATCH_BUFFER_SIZE> results;
+		bool allLookedUp = true;
+		for(size_t batchStart = 0; batchStart < numberKeys; batchStart += LOOKUP_BATCH_BUFFER_SIZE) {
+			size_t batchSize = std::min(LOOKUP_BATCH_BUFFER_SIZE, numberKeys - batchStart);
+			for(size_t i = 0; i < batchSize; ++i) {
+				keys[i] = lookupKeys[batchStart + i].first;
+			}
+			mTrie.lookupBatch(keys.data(), batchSize, results.data());
+			for(size_t i = 0; i < batchSize; ++i) {
+				allLookedUp &= results[i].mIsValid;
+			}
+		}
+		return allLookedUp;
+	}
 
 	bool iterate(std::vector<std::pair<char*, size_t>> const & iterateKeys) {
 		size_t i=0;
@@ -34,6 +56,20 @@ public:
 		return iteratedAll && i == iterateKeys.size();
 	}
 
+	bool prefixScanWithLowerBound(std::pair<char*, size_t> const & prefix, size_t expectedNumberValues) {
+		size_t numberValues = 0;
+		for(TrieType::const_iterator it = mTrie.lower_bound(prefix.first); it != mTrie.end() && std::strncmp(*it, prefix.first, prefix.second) == 0; ++it) {
+			++numberValues;
+		}
+		return numberValues == expectedNumberValues;
+	}
+
+	bool prefixScan(std::pair<char*, size_t> const & prefix, size_t expectedNumberValues) {
+		size_t numberValues = mTrie.prefixScan(prefix.first, prefix.second, [](const char* const * /* values */, size_t /* numberValues */) {
+		});
+		return numberValues == expectedNumberValues;
+	}
+
 	idx::benchmark::IndexStatistics getStatistics() {
 		std::pair<size_t, std::map<std::string, double>> stats = mTrie.getStatistics();
 		return { stats.first, stats.second };
@@ -2,16 +2,80 @@
 #define __HOT__COMMONS__ALGORITHMS__
 
 #include <cassert>
+#include <cstdint>
 #include <bitset>
 #include <immintrin.h>
 #include <iostream>
 
-namespace hot { namespace commons {
+#include "hot/commons/SIMDHelper.hpp"
+#include "hot/commons/InstructionSet.hpp"
+
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+/**
+ * Bit counting operations with the semantics of the tzcnt, lzcnt and popcnt instructions, which are defined for a value of zero as well.
+ * If the code is compiled for the corresponding instruction set extension or for AVX2, which implies all of them, the instructions are used directly.
+ * Otherwise the operations are implemented with the compiler builtins, which work on every x86-64 processor.
+ */
+inline __attribute__((always_inline)) uint32_t countTrailingZeros32(uint32_t value) {
+#if defined(__BMI__) || defined(HOT_COMPILED_FOR_AVX2)
+	return _tzcnt_u32(value);
+#else
+	return (value == 0u) ? 32u : static_cast<uint32_t>(__builtin_ctz(value));
+#endif
+}
+
+inline __attribute__((always_inline)) uint32_t countTrailingZeros64(uint64_t value) {
+#if defined(__BMI__) || defined(HOT_COMPILED_FOR_AVX2)
+	return static_cast<uint32_t>(_tzcnt_u64(value));
+#else
+	return (value == 0u) ? 64u : static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+}
+
+inline __attribute__((always_inline)) uint32_t countLeadingZeros32(uint32_t value) {
+#if defined(__LZCNT__) || defined(HOT_COMPILED_FOR_AVX2)
+	return _lzcnt_u32(value);
+#else
+	return (value == 0u) ? 32u : static_cast<uint32_t>(__builtin_clz(value));
+#endif
+}
+
+inline __attribute__((always_inline)) uint32_t countLeadingZeros64(uint64_t value) {
+#if defined(__LZCNT__) || defined(HOT_COMPILED_FOR_AVX2)
+	return static_cast<uint32_t>(_lzcnt_u64(value));
+#else
+	return (value == 0u) ? 64u : static_cast<uint32_t>(__builtin_clzll(value));
+#endif
+}
+
+inline __attribute__((always_inline)) uint32_t populationCount32(uint32_t value) {
+#if defined(__POPCNT__) || defined(HOT_COMPILED_FOR_AVX2)
+	return static_cast<uint32_t>(_mm_popcnt_u32(value));
+#else
+	return static_cast<uint32_t>(__builtin_popcount(value));
+#endif
+}
+
+inline __attribute__((always_inline)) uint32_t populationCount64(uint64_t value) {
+#if defined(__POPCNT__) || defined(HOT_COMPILED_FOR_AVX2)
+	return static_cast<uint32_t>(_mm_popcnt_u64(value));
+#else
+	return static_cast<uint32_t>(__builtin_popcountll(value));
+#endif
+}
+
+/**
+ * Clears the least significant bit which is set. Compilers emit the blsr instruction for this pattern if BMI1 is available.
+ */
+inline __attribute__((always_inline)) uint32_t resetLowestSetBit32(uint32_t value) {
+	return value & (value - 1u);
+}
 
 inline uint32_t getBytesUsedInExtractionMask(uint64_t successiveExtractionMask) {
 	uint32_t const unsetBytes = _mm_movemask_pi8(_mm_cmpeq_pi8(_mm_and_si64(_mm_set_pi64x(successiveExtractionMask), _mm_set_pi64x(UINT64_MAX)), _mm_setzero_si64()));
 	//8 - numberUnsetBytes
-	return 8 - _mm_popcnt_u32(unsetBytes);
+	return 8 - populationCount32(unsetBytes);
 }
 
 inline uint16_t getMaximumMaskByteIndex(uint16_t bitsUsed) {
@@ -20,18 +84,18 @@ inline uint16_t getMaximumMaskByteIndex(uint16_t bitsUsed) {
 
 template<uint numberExtractionMasks> inline std::array<uint64_t, numberExtractionMasks> getUsedExtractionBitsForMask(uint32_t usedBits, uint64_t  const * extractionMask);
 
-template<uint numberExtractionMasks> inline __m256i extractionMaskToRegister(std::array<uint64_t, numberExtractionMasks> const & extractionData);
+template<uint numberExtractionMasks> inline SIMDHelper<256u>::SIMDRegisterType extractionMaskToRegister(std::array<uint64_t, numberExtractionMasks> const & extractionData);
 
-template<> inline __m256i extractionMaskToRegister<1>(std::array<uint64_t, 1> const & extractionData) {
-	return _mm256_set_epi64x(extractionData[0], 0ul, 0ul, 0ul);
+template<> inline SIMDHelper<256u>::SIMDRegisterType extractionMaskToRegister<1>(std::array<uint64_t, 1> const & extractionData) {
+	return SIMDHelper<256u>::toRegister(std::array<uint64_t, 4> { 0ul, 0ul, 0ul, extractionData[0] });
 };
 
-template<> inline __m256i extractionMaskToRegister<2>(std::array<uint64_t, 2> const & extractionData) {
-	return _mm256_set_epi64x(extractionData[0], extractionData[1], 0ul, 0ul);
+template<> inline SIMDHelper<256u>::SIMDRegisterType extractionMaskToRegister<2>(std::array<uint64_t, 2> const & extractionData) {
+	return SIMDHelper<256u>::toRegister(std::array<uint64_t, 4> { 0ul, 0ul, extractionData[1], extractionData[0] });
 }
 
-template<> inline __m256i extractionMaskToRegister<4>(std::array<uint64_t, 4> const & extractionData) {
-	return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(extractionData.data()));
+template<> inline SIMDHelper<256u>::SIMDRegisterType extractionMaskToRegister<4>(std::array<uint64_t, 4> const & extractionData) {
+	return SIMDHelper<256u>::toRegister(extractionData);
 }
 
 template<size_t numberBytes> inline std::array<uint8_t, numberBytes>  extractSuccesiveFromRandomBytes(uint8_t const * bytes, uint8_t const * bytePositions) {
@@ -89,12 +153,12 @@ inline bool isBitSet(uint8_t const * existingRawKey, uint16_t const mAbsoluteBit
 }
 
 inline uint16_t getLeastSignificantBitIndexInByte(uint8_t byte) {
-	return (7 - _tzcnt_u32(byte));
+	return (7 - countTrailingZeros32(byte));
 }
 
 inline uint16_t getMostSignificantBitIndexInByte(uint8_t byte) {
 	assert(byte > 0);
-	return _lzcnt_u32(byte) - 24;
+	return countLeadingZeros32(byte) - 24;
 }
 
 inline __attribute__((always_inline)) int getMostSignificantBitIndex(uint32_t number) {
@@ -103,6 +167,6 @@ inline __attribute__((always_inline)) int getMostSignificantBitIndex(uint32_t nu
 	return msb;
 }
 
-} }
+} } }
 
 #endif
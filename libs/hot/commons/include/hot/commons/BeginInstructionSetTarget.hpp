@@ -0,0 +1,97 @@
+#ifndef __HOT__COMMONS__BEGIN_INSTRUCTION_SET_TARGET__
+#define __HOT__COMMONS__BEGIN_INSTRUCTION_SET_TARGET__
+
+/**
+ * Compiles the headers of HOT included after this header for a higher instruction set than the rest of the translation unit.
+ * Together with the instruction set specific namespaces (see InstructionSet.hpp) this allows a single binary, which is compiled for the x86-64 baseline,
+ * to contain variants of an index compiled for AVX2 or AVX-512 and to select the best variant supported by the processor on startup.
+ *
+ * Each variant is compiled in a translation unit of its own, which defines either HOT_TARGET_AVX2 or HOT_TARGET_AVX512, e.g. as a per source compile definition:
+ *
+ * 	#include <idx/contenthelpers/IdentityKeyExtractor.hpp>
+ *
+ * 	#include <hot/commons/BeginInstructionSetTarget.hpp>
+ * 	#include <hot/singlethreaded/HOTSingleThreaded.hpp>
+ *
+ * 	//the entry points of the variant, e.g. a function filling a table of function pointers or implementing an abstract index interface
+ *
+ * 	#include <hot/commons/EndInstructionSetTarget.hpp>
+ *
+ * The following rules apply to such a translation unit:
+ *
+ * 	+ This header must be included before any other header of HOT, as the instruction set specific namespace is determined on the first inclusion of InstructionSet.hpp.
+ * 	+ All headers of the standard library and of third party libraries must be included before this header.
+ * 	  Otherwise templates shared with other translation units would be compiled for the higher instruction set and the linker could pick them for baseline code.
+ * 	  This header includes all such headers used by HOT itself, other headers like key extractors must be included by the translation unit.
+ * 	+ The code using HOT should be placed before EndInstructionSetTarget.hpp as well, so that the operations of the index can be inlined into it.
+ * 	+ An index must be created, used and destroyed within the same variant. As the types of the variants are placed in different namespaces, the compiler enforces this.
+ *
+ * Selecting a variant is done with hot::commons::selectForSupportedInstructionSet, which is declared in InstructionSetDispatch.hpp.
+ * The target regions rely on "#pragma GCC target" and are therefore only supported by GCC.
+ */
+#if !defined(__GNUC__) || defined(__clang__)
+#error "instruction set specific variants of HOT require the target pragma of GCC"
+#endif
+
+#ifdef HOT_INSTRUCTION_SET_NAMESPACE
+#error "BeginInstructionSetTarget.hpp must be included before any other header of HOT"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <execinfo.h>
+#include <immintrin.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_invoke.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/task_arena.h>
+
+#include <idx/contenthelpers/ContentEquals.hpp>
+#include <idx/contenthelpers/KeyComparator.hpp>
+#include <idx/contenthelpers/KeyUtilities.hpp>
+#include <idx/contenthelpers/OptionalValue.hpp>
+#include <idx/contenthelpers/TidConverters.hpp>
+
+#include <hot/commons/InstructionSetDispatch.hpp>
+#include <hot/commons/ParallelBitOperationsConfiguration.hpp>
+
+#pragma GCC push_options
+#if defined(HOT_TARGET_AVX512)
+#define USE_AVX512
+#pragma GCC target("avx2,bmi,bmi2,lzcnt,popcnt,avx512f,avx512bw,avx512vl")
+#elif defined(HOT_TARGET_AVX2)
+#pragma GCC target("avx2,bmi,bmi2,lzcnt,popcnt")
+#else
+#error "either HOT_TARGET_AVX2 or HOT_TARGET_AVX512 must be defined"
+#endif
+
+#endif
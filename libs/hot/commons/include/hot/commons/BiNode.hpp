@@ -4,8 +4,9 @@
 #include <hot/commons/DiscriminativeBit.hpp>
 
 #include <hot/commons/BiNodeInterface.hpp>
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace commons {
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 template<typename ChildPointerType> inline BiNode<ChildPointerType>::BiNode(uint16_t const discriminativeBitIndex, uint16_t const height, ChildPointerType const & left, ChildPointerType const & right) :  mDiscriminativeBitIndex(discriminativeBitIndex), mHeight(height), mLeft(left), mRight(right) {
 }
@@ -17,6 +18,6 @@ return discriminativeBit.mValue
 	   : BiNode<ChildPointerType> { discriminativeBit.mAbsoluteBitIndex, newHeight, newEntry, existingNode };
 }
 
-}}
+}}}
 
 #endif
\ No newline at end of file
@@ -4,8 +4,9 @@
 #include <cstdint>
 
 #include "hot/commons/EntriesRange.hpp"
+#include "hot/commons/InstructionSet.hpp"
 
-namespace hot { namespace commons {
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 /**
  * The BiNodeInformation, contains all information which is necessary a BiNode and the entries in its subtree for a linearized binary patricia trie.
@@ -36,6 +37,6 @@ struct BiNodeInformation {
 
 };
 
-}}
+}}}
 
 #endif
\ No newline at end of file
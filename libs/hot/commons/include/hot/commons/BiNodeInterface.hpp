@@ -1,7 +1,9 @@
 #ifndef __HOT__COMMONS__BI_NODE_INTERFACE___
 #define __HOT__COMMONS__BI_NODE_INTERFACE___
 
-namespace hot { namespace commons {
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 template<typename ChildPointerType> struct BiNode {
 	uint16_t mDiscriminativeBitIndex;
@@ -20,6 +22,6 @@ template<typename ChildPointerType> struct BiNode {
 	inline static BiNode createFromExistingAndNewEntry(DiscriminativeBit const & discriminativeBit, ChildPointerType const & existingNode, ChildPointerType const & newEntry);
 };
 
-}}
+}}}
 
 #endif
\ No newline at end of file
@@ -5,7 +5,9 @@
 #include <cstdint>
 #include <iterator>
 
-namespace hot { namespace commons {
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 constexpr uint32_t ALL_SLOTS_USED_MASK32 = 0xFFFFFFFF;
 constexpr uint32_t ALL_SLOTS_EMPTY_MASK32 = 0x00000000;
@@ -97,9 +99,9 @@ public:
 
 };
 
-}}
+}}}
 
-namespace hot { namespace commons {
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 inline BitMask32::BitMask32() : mUsedSlots(0) {
 }
@@ -265,6 +267,6 @@ inline bool BitMask32Iterator::operator!=(BitMask32Iterator const & rhs) const {
 	return mCopy != rhs.mCopy;
 }
 
-} }
+} } }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,461 @@
+#ifndef __HOT__COMMONS__BULK_LOADER__
+#define __HOT__COMMONS__BULK_LOADER__
+
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <vector>
+
+#include <hot/commons/DiscriminativeBit.hpp>
+#include <hot/commons/MultiMaskPartialKeyMapping.hpp>
+#include <hot/commons/PartialKeyMappingHelpers.hpp>
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+constexpr uint16_t BULK_LOADER_MAXIMUM_NUMBER_NODE_ENTRIES = 32u;
+
+/**
+ * Creates a node from a sequence of entries which are ordered according to their keys.
+ * The structure of the node's underlying binary patricia trie is solely described by the discriminative bits separating each pair of adjacent entries.
+ * The discriminative bits representation and the partial key type are chosen as compact as possible and the node is allocated exactly once.
+ *
+ * @tparam ChildPointerType the type of the child pointers stored in the node
+ * @tparam NodeTemplate the node template to instantiate
+ * @param height the height of the node to create
+ * @param numberEntries the number of entries to store, which must be at least two
+ * @param separatingBitIndexes an array of numberEntries - 1 absolute bit indexes. The i-th bit index is the index of the first bit in which the keys of the i-th and the (i+1)-th entry differ.
+ * @param entries the entries to store ordered by their keys
+ * @return a child pointer to the newly created node
+ */
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate> inline ChildPointerType createNodeFromSortedEntries(
+	uint16_t const height, uint16_t const numberEntries, uint16_t const * separatingBitIndexes, ChildPointerType const * entries
+) {
+	assert(numberEntries >= 2 && numberEntries <= BULK_LOADER_MAXIMUM_NUMBER_NODE_ENTRIES);
+
+	MultiMaskPartialKeyMapping<4u> const allDiscriminativeBits { separatingBitIndexes, static_cast<unsigned int>(numberEntries - 1u) };
+	return extractAndExecuteWithCorrectMaskAndDiscriminativeBitsRepresentation(allDiscriminativeBits, allDiscriminativeBits.getAllMaskBits(),
+		[&](auto const & finalDiscriminativeBitsRepresentation, auto maximumMask) {
+			using FinalDiscriminativeBitsRepresentationType = typename std::remove_const<
+				typename std::remove_reference<decltype(finalDiscriminativeBitsRepresentation)>::type
+			>::type;
+			using PartialKeyType = decltype(maximumMask);
+
+			NodeTemplate<FinalDiscriminativeBitsRepresentationType, PartialKeyType>* node = new (numberEntries) NodeTemplate<FinalDiscriminativeBitsRepresentationType, PartialKeyType>(
+				height, numberEntries, finalDiscriminativeBitsRepresentation
+			);
+
+			//The sparse partial key of an entry consists of those discriminative bits on its path, where the path follows the right subtree.
+			//For the i-th entry these are all separating bits j < i, which are more significant than all separating bits between j and i.
+			std::array<uint16_t, BULK_LOADER_MAXIMUM_NUMBER_NODE_ENTRIES> rightPathBitIndexes;
+			std::array<PartialKeyType, BULK_LOADER_MAXIMUM_NUMBER_NODE_ENTRIES> rightPathPartialKeys;
+			unsigned int rightPathLength = 0u;
+
+			ChildPointerType* pointers = node->getPointers();
+			node->mPartialKeys.mEntries[0] = 0u;
+			pointers[0] = entries[0];
+			for(unsigned int i = 1u; i < numberEntries; ++i) {
+				uint16_t separatingBitIndex = separatingBitIndexes[i - 1];
+				while(rightPathLength > 0 && rightPathBitIndexes[rightPathLength - 1] > separatingBitIndex) {
+					--rightPathLength;
+				}
+				PartialKeyType partialKey = static_cast<PartialKeyType>(
+					((rightPathLength > 0) ? rightPathPartialKeys[rightPathLength - 1] : 0u)
+					| finalDiscriminativeBitsRepresentation.getMaskFor(DiscriminativeBit { separatingBitIndex })
+				);
+				rightPathBitIndexes[rightPathLength] = separatingBitIndex;
+				rightPathPartialKeys[rightPathLength] = partialKey;
+				++rightPathLength;
+
+				node->mPartialKeys.mEntries[i] = partialKey;
+				pointers[i] = entries[i];
+			}
+			return node->toChildPointer();
+		}
+	);
+}
+
+/**
+ * describes how the BulkLoader combines two adjacent subtrees, which are separated by the least significant separating bit on its rightmost path
+ */
+enum class SubtreeCombination {
+	/**
+	 * both subtrees have the same height and their root entries are merged into a single node
+	 */
+	MERGE_ROOTS,
+	/**
+	 * the right subtree is smaller and becomes a single entry of the left subtree's root
+	 */
+	ADD_RIGHT_TO_LEFT,
+	/**
+	 * the left subtree is smaller and becomes a single entry of the right subtree's root
+	 */
+	ADD_LEFT_TO_RIGHT,
+	/**
+	 * both subtrees become the entries of a new root with increased height
+	 */
+	CREATE_PARENT
+};
+
+/**
+ * determines how two adjacent subtrees are combined, given the height of each subtree and the number of entries of its root
+ *
+ * @param leftHeight the height of the left subtree
+ * @param leftNumberEntries the number of entries of the left subtree's root
+ * @param rightHeight the height of the right subtree
+ * @param rightNumberEntries the number of entries of the right subtree's root
+ * @return the way both subtrees are combined
+ */
+inline SubtreeCombination getSubtreeCombination(uint16_t leftHeight, uint16_t leftNumberEntries, uint16_t rightHeight, uint16_t rightNumberEntries) {
+	if(leftHeight == rightHeight && (leftNumberEntries + rightNumberEntries) <= BULK_LOADER_MAXIMUM_NUMBER_NODE_ENTRIES) {
+		return SubtreeCombination::MERGE_ROOTS;
+	} else if(leftHeight > rightHeight && leftNumberEntries < BULK_LOADER_MAXIMUM_NUMBER_NODE_ENTRIES) {
+		return SubtreeCombination::ADD_RIGHT_TO_LEFT;
+	} else if(leftHeight < rightHeight && rightNumberEntries < BULK_LOADER_MAXIMUM_NUMBER_NODE_ENTRIES) {
+		return SubtreeCombination::ADD_LEFT_TO_RIGHT;
+	} else {
+		return SubtreeCombination::CREATE_PARENT;
+	}
+}
+
+/**
+ * The shape of a subtree consists of its height and the number of entries of its root. A single leaf entry has height 1 and a single entry.
+ */
+struct SubtreeShape {
+	uint16_t mHeight;
+	uint16_t mNumberEntries;
+};
+
+/**
+ * A SubtreeShapeCalculator determines the shape of the subtree a BulkLoader would construct from a sequence of at most { @link BULK_LOADER_MAXIMUM_NUMBER_NODE_ENTRIES } subtrees without creating any node.
+ * Applied bottom up to the entries of each node of a trie, it determines the height of an optimal trie containing the same keys.
+ */
+class SubtreeShapeCalculator {
+	struct OpenSubtree {
+		SubtreeShape mShape;
+		uint16_t mSeparatingBitIndexBefore;
+	};
+
+	std::array<OpenSubtree, BULK_LOADER_MAXIMUM_NUMBER_NODE_ENTRIES> mRightmostPath;
+	size_t mRightmostPathLength = 0u;
+	size_t mNumberClosedNodes = 0u;
+
+public:
+	/**
+	 * appends the first subtree
+	 *
+	 * @param shape the shape of the subtree containing the smallest keys
+	 */
+	inline void append(SubtreeShape const & shape) {
+		assert(mRightmostPathLength == 0u);
+		mRightmostPath[mRightmostPathLength++] = OpenSubtree { shape, 0u };
+	}
+
+	/**
+	 * appends a further subtree
+	 *
+	 * @param separatingBitIndex the index of the first bit in which the keys of the previously appended subtree and the keys of the new subtree differ
+	 * @param shape the shape of the subtree to append
+	 */
+	inline void append(uint16_t separatingBitIndex, SubtreeShape const & shape) {
+		assert(mRightmostPathLength > 0u);
+		while(mRightmostPathLength > 1u && mRightmostPath[mRightmostPathLength - 1u].mSeparatingBitIndexBefore > separatingBitIndex) {
+			combineTopmostSubtrees();
+		}
+		assert(mRightmostPathLength < BULK_LOADER_MAXIMUM_NUMBER_NODE_ENTRIES);
+		mRightmostPath[mRightmostPathLength++] = OpenSubtree { shape, separatingBitIndex };
+	}
+
+	/**
+	 * combines all appended subtrees
+	 *
+	 * @return the shape of the resulting subtree
+	 */
+	inline SubtreeShape finish() {
+		while(mRightmostPathLength > 1u) {
+			combineTopmostSubtrees();
+		}
+		return mRightmostPath[0].mShape;
+	}
+
+	/**
+	 * @return the number of nodes, which were closed while combining the appended subtrees. The root of the resulting subtree is not included.
+	 */
+	inline size_t getNumberClosedNodes() const {
+		return mNumberClosedNodes;
+	}
+
+private:
+	inline void close(SubtreeShape const & shape) {
+		mNumberClosedNodes += (shape.mNumberEntries > 1u);
+	}
+
+	inline void combineTopmostSubtrees() {
+		SubtreeShape const right = mRightmostPath[--mRightmostPathLength].mShape;
+		SubtreeShape & left = mRightmostPath[mRightmostPathLength - 1u].mShape;
+		switch(getSubtreeCombination(left.mHeight, left.mNumberEntries, right.mHeight, right.mNumberEntries)) {
+			case SubtreeCombination::MERGE_ROOTS:
+				left.mNumberEntries += right.mNumberEntries;
+				break;
+			case SubtreeCombination::ADD_RIGHT_TO_LEFT:
+				close(right);
+				++left.mNumberEntries;
+				break;
+			case SubtreeCombination::ADD_LEFT_TO_RIGHT:
+				close(left);
+				left = SubtreeShape { right.mHeight, static_cast<uint16_t>(right.mNumberEntries + 1u) };
+				break;
+			default: //SubtreeCombination::CREATE_PARENT
+				close(left);
+				close(right);
+				left = SubtreeShape { static_cast<uint16_t>(std::max(left.mHeight, right.mHeight) + 1u), 2u };
+		}
+	}
+};
+
+/**
+ * A BulkLoader constructs a height optimized trie bottom up from a sequence of leaf entries, which are appended in ascending key order.
+ *
+ * The appended entries and the discriminative bits separating adjacent entries implicitly describe a binary patricia trie.
+ * While this binary patricia trie is traversed in post order, its binary nodes are greedily combined into compound nodes in the same way the incremental insert operation does it:
+ * two subtrees of equal height are merged into a single node if the total number of entries does not exceed the maximum fanout,
+ * a subtree of smaller height is added as a single entry to a subtree of larger height
+ * and in all other cases a new node of increased height containing both subtrees is created.
+ * Compound nodes are kept open as long as entries can be added and are only allocated, once they are closed.
+ * Hence, each node is allocated exactly once and the overall construction requires linear time.
+ *
+ * Only the open nodes on the rightmost path of the binary patricia trie are kept in memory.
+ * Their entries are stored consecutively on a single stack, such that merging two adjacent open nodes does not require to copy any entry.
+ *
+ * @tparam ChildPointerType the type of the child pointers used by the trie
+ * @tparam NodeTemplate the node template of the trie
+ */
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate> class BulkLoader {
+	struct OpenNode {
+		uint16_t mHeight;
+		uint16_t mNumberEntries;
+		size_t mFirstEntryIndex;
+	};
+
+	//the i-th separating bit index separates the i-th and the (i+1)-th entry
+	std::vector<ChildPointerType> mEntries;
+	std::vector<uint16_t> mSeparatingBitIndexes;
+	std::vector<OpenNode> mRightmostPath;
+
+public:
+	/**
+	 * The root of a completely loaded subtree, whose node has not been allocated yet.
+	 * In contrast to a closed child pointer, the root of a subtree can still absorb entries, when it is combined with other subtrees.
+	 */
+	struct Subtree {
+		uint16_t mHeight;
+		uint16_t mNumberEntries;
+		std::array<uint16_t, BULK_LOADER_MAXIMUM_NUMBER_NODE_ENTRIES - 1> mSeparatingBitIndexes;
+		std::array<ChildPointerType, BULK_LOADER_MAXIMUM_NUMBER_NODE_ENTRIES> mEntries;
+	};
+
+	/**
+	 * appends the first leaf entry
+	 *
+	 * @param leaf the entry with the smallest key
+	 */
+	inline void append(ChildPointerType const & leaf);
+
+	/**
+	 * appends a subtree as the first entry
+	 *
+	 * @param subtree the loaded subtree containing the smallest keys
+	 */
+	inline void append(Subtree const & subtree);
+
+	/**
+	 * appends a further leaf entry, whose key must be larger than the key of the previously appended entry
+	 *
+	 * @param separatingBit the first bit in which the key of the previously appended entry and the key of the new entry differ
+	 * @param leaf the entry to append
+	 */
+	inline void append(DiscriminativeBit const & separatingBit, ChildPointerType const & leaf);
+
+	/**
+	 * appends a further loaded subtree, whose smallest key must be larger than the key of the previously appended entry
+	 *
+	 * @param separatingBit the first bit in which the key of the previously appended entry and the smallest key of the subtree differ
+	 * @param subtree the subtree to append
+	 */
+	inline void append(DiscriminativeBit const & separatingBit, Subtree const & subtree);
+
+	/**
+	 * closes all open nodes and resets the bulk loader
+	 *
+	 * @return the root of the constructed trie or an empty child pointer if no entry was appended
+	 */
+	inline ChildPointerType finish();
+
+	/**
+	 * combines all open nodes into a single subtree without allocating its root node and resets the bulk loader
+	 *
+	 * @return the subtree containing all appended entries. If no entry was appended the resulting subtree has no entries.
+	 */
+	inline Subtree finishSubtree();
+
+	/**
+	 * allocates the root node of a loaded subtree
+	 *
+	 * @param subtree the subtree to close
+	 * @return a child pointer to the subtree's root, the single entry of the subtree or an empty child pointer in case the subtree is empty
+	 */
+	static inline ChildPointerType close(Subtree const & subtree);
+
+private:
+	inline void pushSubtree(Subtree const & subtree);
+	inline uint16_t getSeparatingBitIndexBeforeTopmostSubtree() const;
+	inline ChildPointerType close(OpenNode const & openNode) const;
+	inline void combineTopmostSubtrees();
+};
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate> inline void BulkLoader<ChildPointerType, NodeTemplate>::append(ChildPointerType const & leaf) {
+	assert(mEntries.empty());
+	mEntries.push_back(leaf);
+	mRightmostPath.push_back(OpenNode { 1u, 1u, 0u });
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate> inline void BulkLoader<ChildPointerType, NodeTemplate>::append(
+	DiscriminativeBit const & separatingBit, ChildPointerType const & leaf
+) {
+	assert(!mEntries.empty());
+	//entries are expected in ascending key order, hence the new key must have the separating bit set
+	assert(separatingBit.mValue);
+
+	//all subtrees separated by less significant bits are complete
+	while(mRightmostPath.size() > 1 && getSeparatingBitIndexBeforeTopmostSubtree() > separatingBit.mAbsoluteBitIndex) {
+		combineTopmostSubtrees();
+	}
+	mSeparatingBitIndexes.push_back(separatingBit.mAbsoluteBitIndex);
+	mEntries.push_back(leaf);
+	mRightmostPath.push_back(OpenNode { 1u, 1u, mEntries.size() - 1 });
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate> inline void BulkLoader<ChildPointerType, NodeTemplate>::append(Subtree const & subtree) {
+	assert(mEntries.empty());
+	pushSubtree(subtree);
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate> inline void BulkLoader<ChildPointerType, NodeTemplate>::append(
+	DiscriminativeBit const & separatingBit, Subtree const & subtree
+) {
+	assert(!mEntries.empty());
+	assert(separatingBit.mValue);
+
+	while(mRightmostPath.size() > 1 && getSeparatingBitIndexBeforeTopmostSubtree() > separatingBit.mAbsoluteBitIndex) {
+		combineTopmostSubtrees();
+	}
+	mSeparatingBitIndexes.push_back(separatingBit.mAbsoluteBitIndex);
+	pushSubtree(subtree);
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate> inline ChildPointerType BulkLoader<ChildPointerType, NodeTemplate>::finish() {
+	ChildPointerType root {};
+	if(!mRightmostPath.empty()) {
+		while(mRightmostPath.size() > 1) {
+			combineTopmostSubtrees();
+		}
+		root = close(mRightmostPath.back());
+		mEntries.clear();
+		mSeparatingBitIndexes.clear();
+		mRightmostPath.clear();
+	}
+	return root;
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate> inline typename BulkLoader<ChildPointerType, NodeTemplate>::Subtree BulkLoader<ChildPointerType, NodeTemplate>::finishSubtree() {
+	Subtree subtree;
+	subtree.mHeight = 0u;
+	subtree.mNumberEntries = 0u;
+	if(!mRightmostPath.empty()) {
+		while(mRightmostPath.size() > 1) {
+			combineTopmostSubtrees();
+		}
+		OpenNode const & root = mRightmostPath.back();
+		subtree.mHeight = root.mHeight;
+		subtree.mNumberEntries = root.mNumberEntries;
+		std::copy(mSeparatingBitIndexes.begin(), mSeparatingBitIndexes.end(), subtree.mSeparatingBitIndexes.begin());
+		std::copy(mEntries.begin(), mEntries.end(), subtree.mEntries.begin());
+		mEntries.clear();
+		mSeparatingBitIndexes.clear();
+		mRightmostPath.clear();
+	}
+	return subtree;
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate> inline ChildPointerType BulkLoader<ChildPointerType, NodeTemplate>::close(Subtree const & subtree) {
+	return (subtree.mNumberEntries == 0)
+		? ChildPointerType {}
+		: ((subtree.mNumberEntries == 1)
+			? subtree.mEntries[0]
+			: createNodeFromSortedEntries<ChildPointerType, NodeTemplate>(subtree.mHeight, subtree.mNumberEntries, subtree.mSeparatingBitIndexes.data(), subtree.mEntries.data())
+		);
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate> inline void BulkLoader<ChildPointerType, NodeTemplate>::pushSubtree(Subtree const & subtree) {
+	assert(subtree.mNumberEntries > 0);
+	size_t firstEntryIndex = mEntries.size();
+	mSeparatingBitIndexes.insert(mSeparatingBitIndexes.end(), subtree.mSeparatingBitIndexes.begin(), subtree.mSeparatingBitIndexes.begin() + (subtree.mNumberEntries - 1));
+	mEntries.insert(mEntries.end(), subtree.mEntries.begin(), subtree.mEntries.begin() + subtree.mNumberEntries);
+	mRightmostPath.push_back(OpenNode { subtree.mHeight, subtree.mNumberEntries, firstEntryIndex });
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate> inline uint16_t BulkLoader<ChildPointerType, NodeTemplate>::getSeparatingBitIndexBeforeTopmostSubtree() const {
+	return mSeparatingBitIndexes[mRightmostPath.back().mFirstEntryIndex - 1];
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate> inline ChildPointerType BulkLoader<ChildPointerType, NodeTemplate>::close(OpenNode const & openNode) const {
+	return (openNode.mNumberEntries == 1)
+		? mEntries[openNode.mFirstEntryIndex]
+		: createNodeFromSortedEntries<ChildPointerType, NodeTemplate>(
+			openNode.mHeight, openNode.mNumberEntries, mSeparatingBitIndexes.data() + openNode.mFirstEntryIndex, mEntries.data() + openNode.mFirstEntryIndex
+		);
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate> inline void BulkLoader<ChildPointerType, NodeTemplate>::combineTopmostSubtrees() {
+	OpenNode const right = mRightmostPath.back();
+	mRightmostPath.pop_back();
+	OpenNode & left = mRightmostPath.back();
+	size_t const leftIndex = left.mFirstEntryIndex;
+	size_t const rightIndex = right.mFirstEntryIndex;
+
+	switch(getSubtreeCombination(left.mHeight, left.mNumberEntries, right.mHeight, right.mNumberEntries)) {
+		case SubtreeCombination::MERGE_ROOTS:
+			//both nodes are already stored consecutively and separated by the right separating bit
+			left.mNumberEntries += right.mNumberEntries;
+			break;
+		case SubtreeCombination::ADD_RIGHT_TO_LEFT:
+			mEntries[rightIndex] = close(right);
+			mEntries.resize(rightIndex + 1);
+			mSeparatingBitIndexes.resize(rightIndex);
+			++left.mNumberEntries;
+			break;
+		case SubtreeCombination::ADD_LEFT_TO_RIGHT:
+			mEntries[leftIndex] = close(left);
+			std::copy(mEntries.begin() + rightIndex, mEntries.end(), mEntries.begin() + leftIndex + 1);
+			std::copy(mSeparatingBitIndexes.begin() + rightIndex - 1, mSeparatingBitIndexes.end(), mSeparatingBitIndexes.begin() + leftIndex);
+			mEntries.resize(leftIndex + 1 + right.mNumberEntries);
+			mSeparatingBitIndexes.resize(leftIndex + right.mNumberEntries);
+			left = OpenNode { right.mHeight, static_cast<uint16_t>(right.mNumberEntries + 1u), leftIndex };
+			break;
+		default: { //SubtreeCombination::CREATE_PARENT
+			ChildPointerType const leftEntry = close(left);
+			mEntries[leftIndex + 1] = close(right);
+			mEntries[leftIndex] = leftEntry;
+			mSeparatingBitIndexes[leftIndex] = mSeparatingBitIndexes[rightIndex - 1];
+			mEntries.resize(leftIndex + 2);
+			mSeparatingBitIndexes.resize(leftIndex + 1);
+			left = OpenNode { static_cast<uint16_t>(std::max(left.mHeight, right.mHeight) + 1u), 2u, leftIndex };
+		}
+	}
+}
+
+}}}
+
+#endif
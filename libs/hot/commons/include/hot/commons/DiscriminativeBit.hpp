@@ -2,9 +2,11 @@
 #define __HOT__COMMONS__DISCRIMINATIVE_BIT__
 
 #include "hot/commons/Algorithms.hpp"
+#include "idx/contenthelpers/KeyUtilities.hpp"
 #include "idx/contenthelpers/OptionalValue.hpp"
+#include "hot/commons/InstructionSet.hpp"
 
-namespace hot { namespace commons {
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 constexpr uint8_t BYTE_WITH_MOST_SIGNIFICANT_BIT = 0b10000000;
 
@@ -66,6 +68,28 @@ template<typename Operation> inline bool executeForDiffingKeys(uint8_t const* ex
 	return false;
 };
 
+/**
+ * executes an operation for the most significant bit in which two variable length keys differ. Bytes following the length of a key are treated as zero bytes.
+ *
+ * @param existingKey the bytes of the existing key
+ * @param newKey the bytes of the new key
+ * @param keyLengthInBytes the maximum number of bytes to compare
+ * @param operation the operation to execute with the discriminative bit
+ * @return whether the keys differ
+ */
+template<typename Operation> inline bool executeForDiffingKeys(idx::contenthelpers::KeyBytesView const & existingKey, idx::contenthelpers::KeyBytesView const & newKey, uint16_t keyLengthInBytes, Operation const & operation) {
+	size_t numberBytesToCompare = std::min<size_t>(std::max(existingKey.mLength, newKey.mLength), keyLengthInBytes);
+	for(size_t index = 0; index < numberBytesToCompare; ++index) {
+		uint8_t newByte = newKey[index];
+		uint8_t existingByte = existingKey[index];
+		if(existingByte != newByte) {
+			operation(DiscriminativeBit {static_cast<uint16_t>(index), existingByte, newByte });
+			return true;
+		}
+	}
+	return false;
+};
+
 inline idx::contenthelpers::OptionalValue<DiscriminativeBit> getMismatchingBit(uint8_t const* existingKey, uint8_t const* newKey, uint16_t keyLengthInBytes) {
 	for(size_t index = 0; index < keyLengthInBytes; ++index) {
 		uint8_t newByte = newKey[index];
@@ -77,6 +101,18 @@ inline idx::contenthelpers::OptionalValue<DiscriminativeBit> getMismatchingBit(u
 	return { false, { 0, 0, 0 }};
 };
 
-} }
+inline idx::contenthelpers::OptionalValue<DiscriminativeBit> getMismatchingBit(idx::contenthelpers::KeyBytesView const & existingKey, idx::contenthelpers::KeyBytesView const & newKey, uint16_t keyLengthInBytes) {
+	size_t numberBytesToCompare = std::min<size_t>(std::max(existingKey.mLength, newKey.mLength), keyLengthInBytes);
+	for(size_t index = 0; index < numberBytesToCompare; ++index) {
+		uint8_t newByte = newKey[index];
+		uint8_t existingByte = existingKey[index];
+		if(existingByte != newByte) {
+			return { true, DiscriminativeBit { static_cast<uint16_t>(index), existingByte, newByte } };
+		}
+	}
+	return { false, { 0, 0, 0 }};
+};
+
+} } }
 
 #endif
@@ -0,0 +1,13 @@
+#ifndef __HOT__COMMONS__END_INSTRUCTION_SET_TARGET__
+#define __HOT__COMMONS__END_INSTRUCTION_SET_TARGET__
+
+/**
+ * Ends the region started by BeginInstructionSetTarget.hpp. Code following this header is compiled for the instruction set of the translation unit again.
+ */
+#ifndef __HOT__COMMONS__BEGIN_INSTRUCTION_SET_TARGET__
+#error "EndInstructionSetTarget.hpp requires BeginInstructionSetTarget.hpp to be included before"
+#endif
+
+#pragma GCC pop_options
+
+#endif
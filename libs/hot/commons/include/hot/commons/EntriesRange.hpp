@@ -3,7 +3,9 @@
 
 #include <cstdint>
 
-namespace hot { namespace commons {
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 /**
  * Describes a range of entries by its start index and the number of entries contained.
@@ -22,6 +24,6 @@ struct EntriesRange {
 	}
 };
 
-}}
+}}}
 
 #endif
\ No newline at end of file
@@ -4,8 +4,9 @@
 #include <cassert>
 
 #include <hot/commons/DiscriminativeBit.hpp>
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace commons {
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 /**
  * The insert information contains all information, which is necessary to actually insert a new key.
@@ -46,6 +47,6 @@ struct InsertInformation {
 
 };
 
-} }
+} } }
 
 #endif
\ No newline at end of file
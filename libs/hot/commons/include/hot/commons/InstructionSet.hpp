@@ -0,0 +1,84 @@
+#ifndef __HOT__COMMONS__INSTRUCTION_SET__
+#define __HOT__COMMONS__INSTRUCTION_SET__
+
+#include <cstdint>
+
+#include <hot/commons/InstructionSetDispatch.hpp>
+
+/**
+ * Whether the code is compiled for AVX2, which implies BMI1, BMI2, LZCNT and POPCNT.
+ * Besides the compiler flags, this is the case in target regions started by BeginInstructionSetTarget.hpp.
+ * For C++ code GCC does not update its predefined macros like __AVX2__ within target regions, therefore the headers of HOT check this macro instead.
+ */
+#if defined(USE_AVX512) || defined(HOT_TARGET_AVX2) || (defined(__AVX2__) && defined(__BMI2__))
+#define HOT_COMPILED_FOR_AVX2
+#endif
+
+/**
+ * Implementations for a specific instruction set are annotated with the corresponding macro.
+ * If the code is compiled for the instruction set, they are inlined like any other code.
+ * Otherwise they are compiled for the instruction set nevertheless, which allows to call them on processors supporting it.
+ */
+#ifdef HOT_COMPILED_FOR_AVX2
+#define HOT_AVX2_FUNCTION inline __attribute__((always_inline))
+#else
+#define HOT_AVX2_FUNCTION inline __attribute__((target("avx2,bmi,bmi2,lzcnt,popcnt")))
+#endif
+
+#ifdef USE_AVX512
+#define HOT_AVX512_FUNCTION inline __attribute__((always_inline))
+#else
+#define HOT_AVX512_FUNCTION inline __attribute__((target("avx2,bmi,bmi2,lzcnt,popcnt,avx512f,avx512bw,avx512vl")))
+#endif
+
+/**
+ * All declarations of HOT, which depend on the instruction set, are placed in an inline namespace named after the instruction set the code is compiled for.
+ * The inline namespace is transparent to users of HOT, but gives the variants compiled for different instruction sets distinct symbol names.
+ * This allows to link several variants into the same binary, by compiling them in separate translation units (see BeginInstructionSetTarget.hpp).
+ */
+#if defined(USE_AVX512)
+#define HOT_INSTRUCTION_SET_NAMESPACE avx512
+#elif defined(HOT_COMPILED_FOR_AVX2)
+#define HOT_INSTRUCTION_SET_NAMESPACE avx2
+#else
+#define HOT_INSTRUCTION_SET_NAMESPACE sse2
+#endif
+
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+/**
+ * The instruction set the code is compiled for. The implementations for this instruction set are selected at compile time.
+ *
+ * The individual implementations are not selected at runtime, as they consist of only a few instructions.
+ * Calling an implementation for a higher instruction set prevents it from being inlined and costs more than the higher instruction set saves.
+ * Instead whole indexes are compiled for several instruction sets and selected at their entry points (see BeginInstructionSetTarget.hpp).
+ */
+constexpr InstructionSet COMPILED_INSTRUCTION_SET =
+#if defined(USE_AVX512)
+	InstructionSet::AVX512;
+#elif defined(HOT_COMPILED_FOR_AVX2)
+	InstructionSet::AVX2;
+#else
+	InstructionSet::SSE2;
+#endif
+
+/**
+ * @param instructionSet the instruction set required by an implementation
+ * @return whether the code is compiled for the given instruction set and therefore the implementation can be used
+ */
+constexpr bool isCompiledFor(InstructionSet instructionSet) {
+	return instructionSet <= COMPILED_INSTRUCTION_SET;
+}
+
+/**
+ * Applications distributing a single binary to different machines can use this check on startup to report an unsupported processor instead of failing with an illegal instruction later on.
+ *
+ * @return whether the processor supports the instruction set the code is compiled for
+ */
+inline bool isCompiledInstructionSetSupported() {
+	return getSupportedInstructionSet() >= COMPILED_INSTRUCTION_SET;
+}
+
+}}}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef __HOT__COMMONS__INSTRUCTION_SET_DISPATCH__
+#define __HOT__COMMONS__INSTRUCTION_SET_DISPATCH__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * The declarations in this header do not depend on the instruction set the code is compiled for.
+ * Unlike all other headers of HOT, they are therefore not placed in an instruction set specific namespace (see InstructionSet.hpp)
+ * and are shared by all variants of HOT linked into the same binary.
+ *
+ * To ensure that the shared code is compiled for the baseline instruction set, this header must be included before any instruction set is targeted.
+ * BeginInstructionSetTarget.hpp takes care of this.
+ */
+namespace hot { namespace commons {
+
+/**
+ * The instruction sets for which specialized implementations of the performance critical operations exist.
+ * Each instruction set includes all instruction sets listed before it:
+ *
+ * 	+ SSE2 is part of every x86-64 processor and is used by the portable implementations
+ * 	+ AVX2 additionally requires BMI1, BMI2, LZCNT and POPCNT as they are available on every processor supporting AVX2
+ * 	+ AVX512 additionally requires the AVX-512 foundation, byte and word and vector length extensions
+ */
+enum class InstructionSet : uint8_t {
+	SSE2 = 0u,
+	AVX2 = 1u,
+	AVX512 = 2u
+};
+
+constexpr size_t NUMBER_INSTRUCTION_SETS = 3u;
+
+/**
+ * Queries the processor for the highest supported instruction set. The operating system's support for the extended register state is considered as well.
+ *
+ * @return the highest instruction set supported by the processor executing this code
+ */
+inline InstructionSet detectInstructionSet() {
+	__builtin_cpu_init();
+	//the AVX2 and AVX-512 variants are compiled with all instruction set extensions required by AVX2, therefore each of them is checked
+	bool supportsAVX2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("lzcnt") && __builtin_cpu_supports("popcnt");
+	bool supportsAVX512 = supportsAVX2 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl");
+	return supportsAVX512 ? InstructionSet::AVX512 : (supportsAVX2 ? InstructionSet::AVX2 : InstructionSet::SSE2);
+}
+
+/**
+ * @return the highest instruction set supported by the processor, which is detected only once on its first invocation
+ */
+inline InstructionSet getSupportedInstructionSet() {
+	static InstructionSet const supportedInstructionSet = detectInstructionSet();
+	return supportedInstructionSet;
+}
+
+/**
+ * Selects between variants of the same functionality, which are compiled for different instruction sets.
+ * This is intended to be done once on startup, e.g. to choose the function pointers or the factory used to access an index.
+ *
+ * 	hot::commons::selectForSupportedInstructionSet<IndexFactory const *>({ &sse2::factory, &avx2::factory, nullptr })
+ *
+ * @param variants the variants indexed by the instruction set they are compiled for. Variants which are not available are nullptr, the SSE2 variant must be available.
+ * @param supportedInstructionSet the highest instruction set, which may be used
+ * @return the variant compiled for the highest instruction set, which is available and supported
+ */
+template<typename VariantPointer> inline VariantPointer selectForSupportedInstructionSet(std::array<VariantPointer, NUMBER_INSTRUCTION_SETS> const & variants, InstructionSet supportedInstructionSet = getSupportedInstructionSet()) {
+	for(size_t instructionSetIndex = static_cast<size_t>(supportedInstructionSet); instructionSetIndex > 0u; --instructionSetIndex) {
+		if(variants[instructionSetIndex] != nullptr) {
+			return variants[instructionSetIndex];
+		}
+	}
+	return variants[static_cast<size_t>(InstructionSet::SSE2)];
+}
+
+}}
+
+#endif
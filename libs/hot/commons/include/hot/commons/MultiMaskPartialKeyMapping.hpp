@@ -4,43 +4,54 @@
 #include <immintrin.h>
 
 #include <array>
+#include <cstring>
 #include <set>
 
 #include "hot/commons/Algorithms.hpp"
 #include "hot/commons/DiscriminativeBit.hpp"
+#include "hot/commons/ParallelBitOperations.hpp"
 #include "hot/commons/MultiMaskPartialKeyMappingInterface.hpp"
 #include "hot/commons/PartialKeyMappingBase.hpp"
 #include "hot/commons/SingleMaskPartialKeyMapping.hpp"
+#include "hot/commons/InstructionSet.hpp"
 
-namespace hot { namespace commons {
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 constexpr uint8_t BYTE_WITH_HIGHEST_BIT_SET = (1u << 7);
 
+#ifndef USE_LONG_KEYS
 template<unsigned int numberExtractionMasks> inline typename MultiMaskPartialKeyMapping<numberExtractionMasks>::SIMDRegisterType
 MultiMaskPartialKeyMapping<numberExtractionMasks>::getPositionsRegister() const {
 	return SIMDHelperType::toRegister(mExtractionPositions);
 }
+#endif
 
 template<unsigned int numberExtractionMasks> inline typename MultiMaskPartialKeyMapping<numberExtractionMasks>::SIMDRegisterType
 MultiMaskPartialKeyMapping<numberExtractionMasks>::getExtractionDataRegister() const {
 	return SIMDHelperType::toRegister(mExtractionData);
 }
 
+#ifndef USE_LONG_KEYS
 template<unsigned int numberExtractionMasks> inline void
 MultiMaskPartialKeyMapping<numberExtractionMasks>::setPositions(typename MultiMaskPartialKeyMapping<numberExtractionMasks>::SIMDRegisterType positions) {
 	return SIMDHelperType::store(positions, mExtractionPositions);
 }
+#endif
 
 template<unsigned int numberExtractionMasks> inline void
 MultiMaskPartialKeyMapping<numberExtractionMasks>::setExtractionData(typename MultiMaskPartialKeyMapping<numberExtractionMasks>::SIMDRegisterType extractionData) {
 	return SIMDHelperType::store(extractionData, mExtractionData);
 }
 
+#ifndef USE_LONG_KEYS
 template<> inline MultiMaskPartialKeyMapping<1u>::MultiMaskPartialKeyMapping(MultiMaskPartialKeyMapping<1u> const & src)
 	: PartialKeyMappingBase()
 {
 	*reinterpret_cast<uint64_t*>(this) = *reinterpret_cast<uint64_t const *>(&src);
 	SIMDHelper<128>::store(SIMDHelper<128>::toRegister(&(src.mExtractionPositions)), &mExtractionPositions);
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+	mExtractionEmulation = src.mExtractionEmulation;
+#endif
 }
 
 template<> inline MultiMaskPartialKeyMapping<2u>::MultiMaskPartialKeyMapping(MultiMaskPartialKeyMapping<2u> const & src)
@@ -48,6 +59,9 @@ template<> inline MultiMaskPartialKeyMapping<2u>::MultiMaskPartialKeyMapping(Mul
 {
 	*reinterpret_cast<uint64_t*>(this) = *reinterpret_cast<uint64_t const *>(&src);
 	SIMDHelper<256>::store(SIMDHelper<256>::toRegister(&(src.mExtractionPositions)), &mExtractionPositions);
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+	mExtractionEmulation = src.mExtractionEmulation;
+#endif
 }
 
 template<> inline MultiMaskPartialKeyMapping<4u>::MultiMaskPartialKeyMapping(MultiMaskPartialKeyMapping<4u> const & src)
@@ -56,6 +70,9 @@ template<> inline MultiMaskPartialKeyMapping<4u>::MultiMaskPartialKeyMapping(Mul
 	*reinterpret_cast<uint64_t*>(this) = *reinterpret_cast<uint64_t const *>(&src);
 	setPositions(src.getPositionsRegister());
 	setExtractionData(src.getExtractionDataRegister());
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+	mExtractionEmulation = src.mExtractionEmulation;
+#endif
 }
 
 template<> inline MultiMaskPartialKeyMapping<4u>::MultiMaskPartialKeyMapping(MultiMaskPartialKeyMapping<2u> const & src)
@@ -64,6 +81,7 @@ template<> inline MultiMaskPartialKeyMapping<4u>::MultiMaskPartialKeyMapping(Mul
 	*reinterpret_cast<uint64_t*>(this) = *reinterpret_cast<uint64_t const *>(&src);
 	setPositions(SIMDHelper<256u>::convertWithZeroExtend(src.getPositionsRegister()));
 	setExtractionData(SIMDHelper<256u>::convertWithZeroExtend(src.getExtractionDataRegister()));
+	initializeExtractionEmulation();
 }
 
 template<> inline MultiMaskPartialKeyMapping<2u>::MultiMaskPartialKeyMapping(MultiMaskPartialKeyMapping<1u> const & src)
@@ -72,8 +90,32 @@ template<> inline MultiMaskPartialKeyMapping<2u>::MultiMaskPartialKeyMapping(Mul
 	*reinterpret_cast<uint64_t*>(this) = *reinterpret_cast<uint64_t const *>(&src);
 	setPositions(SIMDHelper<128u>::convertWithZeroExtend(src.getPositionsRegister()));
 	setExtractionData(SIMDHelper<128u>::convertWithZeroExtend(src.getExtractionDataRegister()));
+	initializeExtractionEmulation();
+}
+#else
+//with long keys the extraction byte positions are twice as wide as the extraction bytes and cannot be processed together with them
+template<unsigned int numberExtractionMasks> inline MultiMaskPartialKeyMapping<numberExtractionMasks>::MultiMaskPartialKeyMapping(MultiMaskPartialKeyMapping<numberExtractionMasks> const & src)
+	: PartialKeyMappingBase(), mExtractionPositions(src.mExtractionPositions), mExtractionData(src.mExtractionData)
+{
+	*reinterpret_cast<uint64_t*>(this) = *reinterpret_cast<uint64_t const *>(&src);
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+	mExtractionEmulation = src.mExtractionEmulation;
+#endif
 }
 
+template<unsigned int numberExtractionMasks> inline MultiMaskPartialKeyMapping<numberExtractionMasks>::MultiMaskPartialKeyMapping(
+	typename std::conditional<numberExtractionMasks == 1, SingleMaskPartialKeyMapping, MultiMaskPartialKeyMapping<numberExtractionMasks/2>>::type const &src
+) : PartialKeyMappingBase()
+{
+	static_assert(numberExtractionMasks > 1, "only multi mask partial key mappings can be converted");
+	*reinterpret_cast<uint64_t*>(this) = *reinterpret_cast<uint64_t const *>(&src);
+	initializeDataAndPositionsWithZero();
+	std::memcpy(mExtractionPositions.data(), src.mExtractionPositions.data(), sizeof(src.mExtractionPositions));
+	std::memcpy(mExtractionData.data(), src.mExtractionData.data(), sizeof(src.mExtractionData));
+	initializeExtractionEmulation();
+}
+#endif
+
 template<unsigned int numberExtractionMasks> inline MultiMaskPartialKeyMapping<numberExtractionMasks>::MultiMaskPartialKeyMapping(
 	SingleMaskPartialKeyMapping const & existing, DiscriminativeBit const & significantKeyInformation
 ) : PartialKeyMappingBase(existing, significantKeyInformation)
@@ -81,7 +123,7 @@ template<unsigned int numberExtractionMasks> inline MultiMaskPartialKeyMapping<n
 	initializeDataAndPositionsWithZero();
 
 	uint32_t usedBytes = existing.getUsedBytesMask();
-	uint32_t existingNumberRandomBytes = _mm_popcnt_u32(usedBytes);
+	uint32_t existingNumberRandomBytes = populationCount32(usedBytes);
 	unsigned int isBefore = significantKeyInformation.mAbsoluteBitIndex < existing.mMostSignificantDiscriminativeBitIndex;
 
 	unsigned int newValueIndex = (1 - isBefore) * existingNumberRandomBytes;
@@ -90,14 +132,15 @@ template<unsigned int numberExtractionMasks> inline MultiMaskPartialKeyMapping<n
 
 	unsigned int targetIndex = isBefore;
 	while(usedBytes > 0) {
-		unsigned int sourceByteIndex = __tzcnt_u32(usedBytes);
-		usedBytes = _blsr_u32(usedBytes);
+		unsigned int sourceByteIndex = countTrailingZeros32(usedBytes);
+		usedBytes = resetLowestSetBit32(usedBytes);
 		setExtractionBytePosition(targetIndex, existing.getExtractionBytePosition(sourceByteIndex));
 		setExtractionByte(targetIndex, existing.getExtractionByte(sourceByteIndex));
 		++targetIndex;
 	}
 	mNumberExtractionBytes = existingNumberRandomBytes + 1;
 	mNumberKeyBits = existing.calculateNumberBitsUsed() + 1;
+	initializeExtractionEmulation();
 }
 
 //detect insert position -> add byte|position -> finish
@@ -114,6 +157,7 @@ template<unsigned int numberExtractionMasks> inline MultiMaskPartialKeyMapping<n
 	setExtractionByte(extractionByteIndex, newExtractionByte);
 	bool isNewBit = (existingExtractionByte ^ newExtractionByte) > 0;
 	mNumberKeyBits += isNewBit;
+	initializeExtractionEmulation();
 }
 
 template<unsigned int numberExtractionMasks> inline MultiMaskPartialKeyMapping<numberExtractionMasks>::MultiMaskPartialKeyMapping(
@@ -121,12 +165,19 @@ template<unsigned int numberExtractionMasks> inline MultiMaskPartialKeyMapping<n
 	typename MultiMaskPartialKeyMapping<numberExtractionMasks>::SIMDRegisterType const & maskForLessSignificantBytes
 )  : PartialKeyMappingBase(existing, significantKeyInformation), mNumberExtractionBytes(existing.mNumberExtractionBytes + 1), mNumberKeyBits(existing.mNumberKeyBits + 1)
 {
+#ifdef USE_LONG_KEYS
+	mExtractionPositions = existing.mExtractionPositions;
+	for(unsigned int targetIndex = existing.mNumberExtractionBytes; targetIndex > extractionByteIndex; --targetIndex) {
+		setExtractionBytePosition(targetIndex, getExtractionBytePosition(targetIndex - 1));
+	}
+#else
 	SIMDRegisterType extractionPositionRegister = existing.getPositionsRegister();
 	SIMDRegisterType movedPositions = SIMDHelperType::shiftLeftOneByte(SIMDHelperType::binaryAnd(maskForLessSignificantBytes, extractionPositionRegister));
 	setPositions(SIMDHelperType::binaryOr(
 		SIMDHelperType::binaryAndNot(maskForLessSignificantBytes, extractionPositionRegister),
 		movedPositions
 	));
+#endif
 
 	SIMDRegisterType extractionDataRegister = existing.getExtractionDataRegister();
 	setExtractionData(SIMDHelperType::binaryOr(
@@ -136,6 +187,7 @@ template<unsigned int numberExtractionMasks> inline MultiMaskPartialKeyMapping<n
 
 	setExtractionByte(extractionByteIndex, significantKeyInformation.getExtractionByte());
 	setExtractionBytePosition(extractionByteIndex, significantKeyInformation.mByteIndex);
+	initializeExtractionEmulation();
 }
 
 template<> template<> inline MultiMaskPartialKeyMapping<2u>::MultiMaskPartialKeyMapping(
@@ -158,30 +210,69 @@ inline MultiMaskPartialKeyMapping<numberExtractionMasks>::MultiMaskPartialKeyMap
 	uint16_t const mostSignificantBitIndex, uint16_t const leastSignificantBitIndex,
 	uint16_t const numberBytesUsed, uint16_t const bitsUsed
 ) : MultiMaskPartialKeyMapping<numberExtractionMasks>(mostSignificantBitIndex, leastSignificantBitIndex, numberBytesUsed, bitsUsed) {
-	assert(_mm_popcnt_u32(bitsUsed) >= 1);
+	assert(populationCount32(bitsUsed) >= 1);
 
 	initializeDataAndPositionsWithZero();
 	uint8_t const * extractionBytesUsed = reinterpret_cast<uint8_t const *>(extractionDataUsed.data());
 
 	int i=0;
 	while(bytesUsedMask > 0) {
-		unsigned int extractionByteIndex = __tzcnt_u32(bytesUsedMask);
+		unsigned int extractionByteIndex = countTrailingZeros32(bytesUsedMask);
 		setExtractionBytePosition(i, existing.getExtractionBytePosition(extractionByteIndex));
 		setExtractionByte(i, extractionBytesUsed[extractionByteIndex]);
-		bytesUsedMask = _blsr_u32(bytesUsedMask);
+		bytesUsedMask = resetLowestSetBit32(bytesUsedMask);
 		++i;
 	}
+	initializeExtractionEmulation();
 }
 
 template<unsigned int numberExtractionMasks> inline MultiMaskPartialKeyMapping<numberExtractionMasks>::MultiMaskPartialKeyMapping(
 	uint16_t const numberBytesUsed, uint16_t const numberBitsUsed,
-	ExtractionDataArray const & extractionPositions,
+	ExtractionPositionsArray const & extractionPositions,
 	ExtractionDataArray const & extractionData
-) : PartialKeyMappingBase(getMostSignificantBitIndexInByte(getExtractionByteAt(extractionData,0)) + (getExtractionByteAt(extractionPositions, 0) * 8), getLeastSignificantBitIndexInByte(getExtractionByteAt(extractionData, numberBytesUsed - 1)) + (getExtractionByteAt(extractionPositions, numberBytesUsed - 1) * 8)),
+) : PartialKeyMappingBase(getMostSignificantBitIndexInByte(getExtractionByteAt(extractionData,0)) + (getExtractionBytePositionAt(extractionPositions, 0) * 8), getLeastSignificantBitIndexInByte(getExtractionByteAt(extractionData, numberBytesUsed - 1)) + (getExtractionBytePositionAt(extractionPositions, numberBytesUsed - 1) * 8)),
 	mNumberExtractionBytes(numberBytesUsed), mNumberKeyBits(numberBitsUsed),
 	mExtractionPositions(extractionPositions),
 	mExtractionData(extractionData)
 {
+	initializeExtractionEmulation();
+}
+
+template<unsigned int numberExtractionMasks> inline MultiMaskPartialKeyMapping<numberExtractionMasks>::MultiMaskPartialKeyMapping(
+	uint16_t const * discriminativeBitIndexes, unsigned int const numberDiscriminativeBitIndexes
+) : PartialKeyMappingBase(UINT16_MAX, 0u), mNumberExtractionBytes(0u), mNumberKeyBits(0u)
+{
+	assert(numberDiscriminativeBitIndexes >= 1);
+	initializeDataAndPositionsWithZero();
+
+	for(unsigned int i = 0u; i < numberDiscriminativeBitIndexes; ++i) {
+		DiscriminativeBit const discriminativeBit { discriminativeBitIndexes[i] };
+		mMostSignificantDiscriminativeBitIndex = std::min(mMostSignificantDiscriminativeBitIndex, discriminativeBit.mAbsoluteBitIndex);
+		mLeastSignificantDiscriminativeBitIndex = std::max(mLeastSignificantDiscriminativeBitIndex, discriminativeBit.mAbsoluteBitIndex);
+
+		//the extraction bytes are kept ordered by their position in the key
+		unsigned int extractionByteIndex = 0u;
+		while(extractionByteIndex < mNumberExtractionBytes && getExtractionBytePosition(extractionByteIndex) < discriminativeBit.mByteIndex) {
+			++extractionByteIndex;
+		}
+
+		if(extractionByteIndex == mNumberExtractionBytes || getExtractionBytePosition(extractionByteIndex) != discriminativeBit.mByteIndex) {
+			assert(mNumberExtractionBytes < (numberExtractionMasks * 8));
+			for(unsigned int targetIndex = mNumberExtractionBytes; targetIndex > extractionByteIndex; --targetIndex) {
+				setExtractionBytePosition(targetIndex, getExtractionBytePosition(targetIndex - 1));
+				setExtractionByte(targetIndex, getExtractionByte(targetIndex - 1));
+			}
+			setExtractionBytePosition(extractionByteIndex, discriminativeBit.mByteIndex);
+			setExtractionByte(extractionByteIndex, 0u);
+			++mNumberExtractionBytes;
+		}
+
+		uint8_t existingExtractionByte = getExtractionByte(extractionByteIndex);
+		uint8_t newExtractionByte = existingExtractionByte | discriminativeBit.getExtractionByte();
+		setExtractionByte(extractionByteIndex, newExtractionByte);
+		mNumberKeyBits += (existingExtractionByte != newExtractionByte);
+	}
+	initializeExtractionEmulation();
 }
 
 template<unsigned int numberExtractionMasks>
@@ -191,10 +282,38 @@ inline MultiMaskPartialKeyMapping<numberExtractionMasks>::MultiMaskPartialKeyMap
 ) : PartialKeyMappingBase(mostSignificantBitIndex, leastSignificantBitIndex), mNumberExtractionBytes(numberBytesUsed), mNumberKeyBits(bitsUsed) {
 }
 
+template<unsigned int numberExtractionMasks> inline void MultiMaskPartialKeyMapping<numberExtractionMasks>::initializeExtractionEmulation() {
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+	for(unsigned int maskIndex = 0u; maskIndex < numberExtractionMasks; ++maskIndex) {
+		mExtractionEmulation[maskIndex] = ParallelBitOperationsEmulationSteps<uint64_t>(mExtractionData[maskIndex]);
+	}
+#endif
+}
+
+template<unsigned int numberExtractionMasks> inline __attribute__((always_inline)) uint64_t MultiMaskPartialKeyMapping<numberExtractionMasks>::extractBitsForMask(uint64_t source, unsigned int maskIndex) const {
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+	return extractBits64(source, mExtractionData[maskIndex], mExtractionEmulation[maskIndex]);
+#else
+	return extractBits64(source, mExtractionData[maskIndex]);
+#endif
+}
+
+template<unsigned int numberExtractionMasks> inline __attribute__((always_inline)) uint64_t MultiMaskPartialKeyMapping<numberExtractionMasks>::depositBitsForMask(uint64_t source, unsigned int maskIndex) const {
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+	return depositBits64(source, mExtractionData[maskIndex], mExtractionEmulation[maskIndex]);
+#else
+	return depositBits64(source, mExtractionData[maskIndex]);
+#endif
+}
+
 template<unsigned int numberExtractionMasks> inline __attribute__((always_inline)) uint32_t MultiMaskPartialKeyMapping<numberExtractionMasks>::extractMask(uint8_t const * keyBytes) const {
 	return extractMaskForMappedInput(mapInput(keyBytes));
 }
 
+template<unsigned int numberExtractionMasks> inline __attribute__((always_inline)) uint32_t MultiMaskPartialKeyMapping<numberExtractionMasks>::extractMask(idx::contenthelpers::KeyBytesView const & keyBytes) const {
+	return extractMaskForMappedInput(mapInput(keyBytes));
+}
+
 /**
  * Extracts a bit masks corresponding to 111111111|00000000 with the first zero bit marking the misssmatching bit index.
  */
@@ -224,7 +343,7 @@ template<unsigned int numberExtractionMasks> template<typename Operation> inline
 	SIMDRegisterType simdMask = getMaskForPositionsLargerOrEqualTo(significantKeyInformation.mByteIndex);
 	//| (UINT32_MAX << mNumberExtractionBytes) is important here. it corresponds to all bytes which are currently unused. Hence, they are expected to be larger
 	uint32_t maskForPositionsLargerOrEqual = SIMDHelperType::moveMask8(simdMask) | (UINT32_MAX << mNumberExtractionBytes);
-	unsigned int possibleExtractionByteIndex = __tzcnt_u32(maskForPositionsLargerOrEqual);
+	unsigned int possibleExtractionByteIndex = countTrailingZeros32(maskForPositionsLargerOrEqual);
 	bool isByteContainedAtPosition = (possibleExtractionByteIndex < mNumberExtractionBytes) & (getExtractionBytePosition(possibleExtractionByteIndex) == significantKeyInformation.mByteIndex);
 
 	constexpr unsigned int nextNumberExtractionMasks = numberExtractionMasks == 4 ? numberExtractionMasks : numberExtractionMasks * 2;
@@ -238,12 +357,12 @@ template<unsigned int numberExtractionMasks> template<typename Operation> inline
 
 template<unsigned int numberExtractionMasks> template<typename Operation>
 inline auto MultiMaskPartialKeyMapping<numberExtractionMasks>::extract(uint32_t bitsUsed, Operation const &operation) const {
-	assert(_mm_popcnt_u32(bitsUsed) >= 1);
+	assert(populationCount32(bitsUsed) >= 1);
 
 	ExtractionDataArray extractionDataForBitsUsed = getUsedExtractionBitsForMask(bitsUsed);
 	uint32_t bytesUsedMask = getBytesUsedMaskForExtractionData(extractionDataForBitsUsed);
 
-	unsigned int mostSignificantExtractionByteIndex = _tzcnt_u32(bytesUsedMask);
+	unsigned int mostSignificantExtractionByteIndex = countTrailingZeros32(bytesUsedMask);
 	unsigned int leastSignificantExtractionByteIndex = getLeastSignificantBytIndexForBytesUsedMask(bytesUsedMask);
 
 	unsigned int leastSignificantExtractionBytePosition = getExtractionBytePosition(leastSignificantExtractionByteIndex);
@@ -260,7 +379,7 @@ inline auto MultiMaskPartialKeyMapping<numberExtractionMasks>::extract(uint32_t
 
 	unsigned int isRandomExtractionMask = (leastSignificantExtractionBytePosition - mostSignificantExtractionBytePosition) >= 8;
 
-	uint16_t numberBytesUsed = _mm_popcnt_u32(bytesUsedMask);
+	uint16_t numberBytesUsed = populationCount32(bytesUsedMask);
 	//log2 + shift right ---> numberBytes 0-7 > 0, numberBytes 7 - 16 > 1, numberBytes 17 - 24 > 2, numberBytes 25 - 32 > 3
 	uint32_t numberRandomExtractionMasksMinusOne = (numberBytesUsed-1)/8;
 
@@ -269,7 +388,7 @@ inline auto MultiMaskPartialKeyMapping<numberExtractionMasks>::extract(uint32_t
 	switch(numberRandomExtractionMasksMinusOne + isRandomExtractionMask) {
 		case 0:
 			return operation(SingleMaskPartialKeyMapping(
-				reinterpret_cast<uint8_t const *>(mExtractionPositions.data()),
+				reinterpret_cast<ExtractionBytePositionType const *>(mExtractionPositions.data()),
 				reinterpret_cast<uint8_t const *>(extractionDataForBitsUsed.data()),
 				bytesUsedMask,
 				mostSignificantBitPosition,
@@ -278,13 +397,13 @@ inline auto MultiMaskPartialKeyMapping<numberExtractionMasks>::extract(uint32_t
 		case 1:
 			return operation(MultiMaskPartialKeyMapping<1u>(
 				(MultiMaskPartialKeyMapping<numberExtractionMasks> const &)(*this), bytesUsedMask, extractionDataForBitsUsed,
-				mostSignificantBitPosition, leastSignificantBitPosition, numberBytesUsed, static_cast<uint16_t>(_mm_popcnt_u32(bitsUsed))
+				mostSignificantBitPosition, leastSignificantBitPosition, numberBytesUsed, static_cast<uint16_t>(populationCount32(bitsUsed))
 			));
 		case 2:
 			if(numberExtractionMasks >= 2) {
 				return operation(MultiMaskPartialKeyMapping<2u>(
 					*this, bytesUsedMask, extractionDataForBitsUsed,
-					mostSignificantBitPosition, leastSignificantBitPosition, numberBytesUsed, static_cast<uint16_t>(_mm_popcnt_u32(bitsUsed))
+					mostSignificantBitPosition, leastSignificantBitPosition, numberBytesUsed, static_cast<uint16_t>(populationCount32(bitsUsed))
 				));
 			}
       // fall through
@@ -292,7 +411,7 @@ inline auto MultiMaskPartialKeyMapping<numberExtractionMasks>::extract(uint32_t
 			if(numberExtractionMasks >= 4) {
 				return operation(MultiMaskPartialKeyMapping<4u>(
 					*this, bytesUsedMask, extractionDataForBitsUsed,
-					mostSignificantBitPosition, leastSignificantBitPosition, numberBytesUsed, static_cast<uint16_t>(_mm_popcnt_u32(bitsUsed))
+					mostSignificantBitPosition, leastSignificantBitPosition, numberBytesUsed, static_cast<uint16_t>(populationCount32(bitsUsed))
 				));
 			}
 	}
@@ -300,9 +419,9 @@ inline auto MultiMaskPartialKeyMapping<numberExtractionMasks>::extract(uint32_t
 	return operation(*reinterpret_cast<MultiMaskPartialKeyMapping<4u>*>(0ul));
 }
 
-template<unsigned int numberExtractionMasks> inline std::array<uint8_t, 256> MultiMaskPartialKeyMapping<numberExtractionMasks>::createIntermediateKeyWithOnlySignificantBitsSet() const {
-	std::array<uint8_t, 256> intermediateKey;
-	std::memset(intermediateKey.data(), 0, 256);
+template<unsigned int numberExtractionMasks> inline std::array<uint8_t, NUMBER_ADDRESSABLE_KEY_BYTES> MultiMaskPartialKeyMapping<numberExtractionMasks>::createIntermediateKeyWithOnlySignificantBitsSet() const {
+	std::array<uint8_t, NUMBER_ADDRESSABLE_KEY_BYTES> intermediateKey;
+	std::memset(intermediateKey.data(), 0, NUMBER_ADDRESSABLE_KEY_BYTES);
 	for(size_t i=0u; i < mNumberExtractionBytes; ++i) {
 		intermediateKey[getExtractionBytePosition(i)] = getExtractionByte(i);
 	}
@@ -333,24 +452,42 @@ template<> template<typename Operation> inline auto MultiMaskPartialKeyMapping<4
 }
 
 template<unsigned int numberExtractionMasks> template<typename Operation> inline auto MultiMaskPartialKeyMapping<numberExtractionMasks>::executeWithCompressedDiscriminativeBitsRepresentation(Operation const & operation) const {
-	uint8_t leasSignificantExtractionBytePosition = getExtractionBytePosition(getNumberExtractionBytes() - 1);
-	uint8_t mostSignificantExtractionBytePosition = getExtractionBytePosition(0);
+	ExtractionBytePositionType leasSignificantExtractionBytePosition = getExtractionBytePosition(getNumberExtractionBytes() - 1);
+	ExtractionBytePositionType mostSignificantExtractionBytePosition = getExtractionBytePosition(0);
 	size_t extractionByteRange = leasSignificantExtractionBytePosition - mostSignificantExtractionBytePosition;
 	if(extractionByteRange < 8) {
-		operation(SingleMaskPartialKeyMapping(reinterpret_cast<uint8_t const*>(mExtractionPositions.data()), reinterpret_cast<uint8_t const*>(mExtractionData.data()), getMaskForExtractionBytesUsed(), mMostSignificantDiscriminativeBitIndex, mLeastSignificantDiscriminativeBitIndex));
+		operation(SingleMaskPartialKeyMapping(reinterpret_cast<ExtractionBytePositionType const*>(mExtractionPositions.data()), reinterpret_cast<uint8_t const*>(mExtractionData.data()), getMaskForExtractionBytesUsed(), mMostSignificantDiscriminativeBitIndex, mLeastSignificantDiscriminativeBitIndex));
 	} else if(getNumberExtractionBytes() <= 8) {
 		std::array<uint64_t, 1> temporaryExtractionData = { mExtractionData[0] };
-		std::array<uint64_t, 1> temporaryExtractionPositions = { mExtractionPositions[0] };
+		typename MultiMaskPartialKeyMapping<1>::ExtractionPositionsArray temporaryExtractionPositions;
+		std::memcpy(temporaryExtractionPositions.data(), mExtractionPositions.data(), sizeof(temporaryExtractionPositions));
 		operation(MultiMaskPartialKeyMapping<1>(mNumberExtractionBytes, mNumberKeyBits, temporaryExtractionPositions, temporaryExtractionData));
 	} else if(getNumberExtractionBytes() <= 16) {
 		std::array<uint64_t, 2> temporaryExtractionData = { mExtractionData[0], mExtractionData[1] };
-		std::array<uint64_t, 2> temporaryExtractionPositions = { mExtractionPositions[0], mExtractionPositions[1] };
+		typename MultiMaskPartialKeyMapping<2>::ExtractionPositionsArray temporaryExtractionPositions;
+		std::memcpy(temporaryExtractionPositions.data(), mExtractionPositions.data(), std::min(sizeof(temporaryExtractionPositions), sizeof(mExtractionPositions)));
 		operation(MultiMaskPartialKeyMapping<2>(mNumberExtractionBytes, mNumberKeyBits, temporaryExtractionPositions, temporaryExtractionData));
 	} else {
 		operation(*this);
 	}
 };
 
+#ifdef USE_LONG_KEYS
+template<unsigned int numberExtractionMasks> inline typename MultiMaskPartialKeyMapping<numberExtractionMasks>::SIMDRegisterType
+MultiMaskPartialKeyMapping<numberExtractionMasks>::getMaskForPositionsLargerOrEqualTo(unsigned int bytePosition) const {
+	//the mask refers to the extraction bytes and not to the twice as wide extraction byte positions
+	ExtractionDataArray mask = zeroInitializedArray();
+	for(unsigned int i = 0; i < mNumberExtractionBytes; ++i) {
+		setExtractionByteAt(mask, i, (getExtractionBytePosition(i) >= bytePosition) ? UINT8_MAX : 0u);
+	}
+	return SIMDHelperType::toRegister(mask);
+}
+
+template<unsigned int numberExtractionMasks> inline void MultiMaskPartialKeyMapping<numberExtractionMasks>::initializeDataAndPositionsWithZero() {
+	mExtractionPositions.fill(0ul);
+	mExtractionData.fill(0ul);
+}
+#else
 template<> inline __m64 MultiMaskPartialKeyMapping<1u>::getMaskForPositionsLargerOrEqualTo(unsigned int bytePosition) const {
 	__m64 bytePositionSearchRegister = _mm_set1_pi8(bytePosition);
 	__m64 positionsRegister = getPositionsRegister();
@@ -363,10 +500,10 @@ template<> inline __m128i MultiMaskPartialKeyMapping<2u>::getMaskForPositionsLar
 	return _mm_cmpeq_epi8( positionsRegister, _mm_max_epu8(bytePositionSearchRegister, positionsRegister));
 }
 
-template<> inline __m256i MultiMaskPartialKeyMapping<4u>::getMaskForPositionsLargerOrEqualTo(unsigned int bytePosition) const {
-	__m256i bytePositionSearchRegister = _mm256_set1_epi8(bytePosition);
-	__m256i positionsRegister= getPositionsRegister();
-	return _mm256_cmpeq_epi8(positionsRegister, _mm256_max_epu8(bytePositionSearchRegister, positionsRegister));
+template<> inline typename MultiMaskPartialKeyMapping<4u>::SIMDRegisterType MultiMaskPartialKeyMapping<4u>::getMaskForPositionsLargerOrEqualTo(unsigned int bytePosition) const {
+	SIMDRegisterType bytePositionSearchRegister = SIMDHelperType::set1_epi8(bytePosition);
+	SIMDRegisterType positionsRegister= getPositionsRegister();
+	return SIMDHelperType::cmpeq_epi8(positionsRegister, SIMDHelperType::max_epu8(bytePositionSearchRegister, positionsRegister));
 }
 
 template<> inline void MultiMaskPartialKeyMapping<1u>::initializeDataAndPositionsWithZero() {
@@ -375,53 +512,62 @@ template<> inline void MultiMaskPartialKeyMapping<1u>::initializeDataAndPosition
 }
 
 template<> inline void MultiMaskPartialKeyMapping<2u>::initializeDataAndPositionsWithZero() {
-	_mm256_storeu_si256(reinterpret_cast<__m256i*>(mExtractionPositions.data()), _mm256_setzero_si256());
+	SIMDHelper<256u>::store(SIMDHelper<256u>::zero(), mExtractionPositions.data());
 }
 
 template<> inline void MultiMaskPartialKeyMapping<4u>::initializeDataAndPositionsWithZero() {
-	__m256i zero = _mm256_setzero_si256();
-	_mm256_storeu_si256(reinterpret_cast<__m256i*>(mExtractionPositions.data()), zero);
-	_mm256_storeu_si256(reinterpret_cast<__m256i*>(mExtractionData.data()), zero);
+	SIMDRegisterType zero = SIMDHelperType::zero();
+	SIMDHelperType::store(zero, mExtractionPositions.data());
+	SIMDHelperType::store(zero, mExtractionData);
 }
+#endif
 
 template<unsigned int numberExtractionMasks> inline typename MultiMaskPartialKeyMapping<numberExtractionMasks>::ExtractionDataArray MultiMaskPartialKeyMapping<numberExtractionMasks>::mapInput(uint8_t const __restrict__ * keyBytes) const {
 	ExtractionDataArray mappedInput = zeroInitializedArray();
 	uint8_t* __restrict__ mappedInputBytes = reinterpret_cast<uint8_t*>(mappedInput.data());
-	uint8_t const * __restrict__ positions = reinterpret_cast<uint8_t const* >(mExtractionPositions.data());
+	ExtractionBytePositionType const * __restrict__ positions = reinterpret_cast<ExtractionBytePositionType const* >(mExtractionPositions.data());
 	for(int i=0; i < mNumberExtractionBytes; ++i) {
 		mappedInputBytes[i] = keyBytes[positions[i]];
 	}
 	return std::move(mappedInput);
 };
 
+template<unsigned int numberExtractionMasks> inline typename MultiMaskPartialKeyMapping<numberExtractionMasks>::ExtractionDataArray MultiMaskPartialKeyMapping<numberExtractionMasks>::mapInput(idx::contenthelpers::KeyBytesView const & keyBytes) const {
+	ExtractionDataArray mappedInput = zeroInitializedArray();
+	uint8_t* __restrict__ mappedInputBytes = reinterpret_cast<uint8_t*>(mappedInput.data());
+	ExtractionBytePositionType const * __restrict__ positions = reinterpret_cast<ExtractionBytePositionType const* >(mExtractionPositions.data());
+	for(int i=0; i < mNumberExtractionBytes; ++i) {
+		mappedInputBytes[i] = keyBytes[positions[i]];
+	}
+	return mappedInput;
+};
+
 template<> inline __attribute__((always_inline)) uint32_t MultiMaskPartialKeyMapping<1u>::extractMaskForMappedInput(typename MultiMaskPartialKeyMapping<1u>::ExtractionDataArray const & mappedInputData) const {
-	return _pext_u64(mappedInputData[0], mExtractionData[0]);
+	return extractBitsForMask(mappedInputData[0], 0u);
 }
 
 template<> inline __attribute__((always_inline)) uint32_t MultiMaskPartialKeyMapping<2u>::extractMaskForMappedInput(typename MultiMaskPartialKeyMapping<2u>::ExtractionDataArray const & mappedInputData) const {
 	uint64_t const mask1 = mExtractionData[0];
-	uint64_t const mask2 = mExtractionData[1];
 
-	uint64_t firstMask = _pext_u64(mappedInputData[0], mask1);
-	uint64_t secondMask = _pext_u64(mappedInputData[1], mask2);
+	uint64_t firstMask = extractBitsForMask(mappedInputData[0], 0u);
+	uint64_t secondMask = extractBitsForMask(mappedInputData[1], 1u);
 	//larger byte positions result in larger bit position => the most significant bits correspond to the least significant bytes.
-	return firstMask + (secondMask << _mm_popcnt_u64(mask1));
+	return firstMask + (secondMask << populationCount64(mask1));
 }
 
 template<> inline __attribute__((always_inline)) uint32_t MultiMaskPartialKeyMapping<4u>::extractMaskForMappedInput(typename MultiMaskPartialKeyMapping<4u>::ExtractionDataArray const & mappedInputData) const {
 	const uint64_t mask1 = mExtractionData[0];
 	const uint64_t mask2 = mExtractionData[1];
 	const uint64_t mask3 = mExtractionData[2];
-	const uint64_t mask4 = mExtractionData[3];
 
-	uint64_t firstMask = _pext_u64(mappedInputData[0], mask1);
-	uint64_t secondMask = _pext_u64(mappedInputData[1], mask2);
-	uint64_t thirdMask = _pext_u64(mappedInputData[2], mask3);
-	uint64_t fourthMask = _pext_u64(mappedInputData[3], mask4);
+	uint64_t firstMask = extractBitsForMask(mappedInputData[0], 0u);
+	uint64_t secondMask = extractBitsForMask(mappedInputData[1], 1u);
+	uint64_t thirdMask = extractBitsForMask(mappedInputData[2], 2u);
+	uint64_t fourthMask = extractBitsForMask(mappedInputData[3], 3u);
 
-	unsigned int firstOffset = _mm_popcnt_u64(mask1);
-	unsigned int secondOffset = _mm_popcnt_u64(mask2) + firstOffset;
-	unsigned int thirdOffset = _mm_popcnt_u64(mask3) + secondOffset;
+	unsigned int firstOffset = populationCount64(mask1);
+	unsigned int secondOffset = populationCount64(mask2) + firstOffset;
+	unsigned int thirdOffset = populationCount64(mask3) + secondOffset;
 
 	return firstMask + (secondMask << firstOffset) + (thirdMask << secondOffset) + (fourthMask << thirdOffset);
 }
@@ -454,12 +600,21 @@ template<unsigned int numberExtractionMasks> inline uint32_t MultiMaskPartialKey
 }
 
 template<unsigned int numberExtractionMasks> inline uint32_t MultiMaskPartialKeyMapping<numberExtractionMasks>::getExtractionByteIndexForPosition(uint16_t bytePosition) const {
+#ifdef USE_LONG_KEYS
+	unsigned int extractionByteIndex = 0u;
+	while(getExtractionBytePosition(extractionByteIndex) != bytePosition) {
+		++extractionByteIndex;
+	}
+	assert(extractionByteIndex < mNumberExtractionBytes);
+	return extractionByteIndex;
+#else
 	SIMDRegisterType needle = SIMDHelperType::set1_epi8(bytePosition);
 	SIMDRegisterType haystack = getPositionsRegister();
 	uint32_t bytePositionMask = SIMDHelperType::moveMask8(SIMDHelperType::cmpeq_epi8(needle, haystack)) & getMaskForExtractionBytesUsed();
 	assert(bytePositionMask != 0);
-	assert(_mm_popcnt_u32(bytePositionMask) == 1);
-	return _tzcnt_u32(bytePositionMask);
+	assert(populationCount32(bytePositionMask) == 1);
+	return countTrailingZeros32(bytePositionMask);
+#endif
 }
 
 
@@ -469,17 +624,16 @@ template<unsigned int numberExtractionMasks> inline uint8_t MultiMaskPartialKeyM
 }
 
 template<> inline typename MultiMaskPartialKeyMapping<1u>::ExtractionDataArray MultiMaskPartialKeyMapping<1u>::getUsedExtractionBitsForMask(uint32_t usedMaskBits) const {
-	return { _pdep_u64(usedMaskBits, mExtractionData[0]) };
+	return { depositBitsForMask(usedMaskBits, 0u) };
 }
 
 template<> inline typename MultiMaskPartialKeyMapping<2u>::ExtractionDataArray MultiMaskPartialKeyMapping<2u>::getUsedExtractionBitsForMask(uint32_t usedMaskBits) const {
 	uint64_t const extractionMask1 = mExtractionData[0];
-	uint64_t const extractionMask2 = mExtractionData[1];
 
 	uint64_t const usedBits1 = usedMaskBits;
-	uint64_t const usedBits2 = usedMaskBits >> _mm_popcnt_u64(extractionMask1);
+	uint64_t const usedBits2 = usedMaskBits >> populationCount64(extractionMask1);
 
-	return { _pdep_u64(usedBits1, extractionMask1), _pdep_u64(usedBits2, extractionMask2) };
+	return { depositBitsForMask(usedBits1, 0u), depositBitsForMask(usedBits2, 1u) };
 }
 
 template<> inline typename MultiMaskPartialKeyMapping<4u>::ExtractionDataArray MultiMaskPartialKeyMapping<4u>::getUsedExtractionBitsForMask(uint32_t usedMaskBits) const {
@@ -487,14 +641,13 @@ template<> inline typename MultiMaskPartialKeyMapping<4u>::ExtractionDataArray M
 	uint64_t const extractionMask1 = mExtractionData[0];
 	uint64_t const extractionMask2 = mExtractionData[1];
 	uint64_t const extractionMask3 = mExtractionData[2];
-	uint64_t const extractionMask4 = mExtractionData[3];
 
 	uint64_t const usedBits1 = usedMaskBits;
-	uint64_t const usedBits2 = usedBits1 >> _mm_popcnt_u64(extractionMask1);
-	uint64_t const usedBits3 = usedBits2 >> _mm_popcnt_u64(extractionMask2);
-	uint64_t const usedBits4 = usedBits3 >> _mm_popcnt_u64(extractionMask3);
+	uint64_t const usedBits2 = usedBits1 >> populationCount64(extractionMask1);
+	uint64_t const usedBits3 = usedBits2 >> populationCount64(extractionMask2);
+	uint64_t const usedBits4 = usedBits3 >> populationCount64(extractionMask3);
 
-	return { _pdep_u64(usedBits1, extractionMask1), _pdep_u64(usedBits2, extractionMask2), _pdep_u64(usedBits3, extractionMask3), _pdep_u64(usedBits4, extractionMask4) };
+	return { depositBitsForMask(usedBits1, 0u), depositBitsForMask(usedBits2, 1u), depositBitsForMask(usedBits3, 2u), depositBitsForMask(usedBits4, 3u) };
 }
 
 template<> inline typename MultiMaskPartialKeyMapping<1u>::ExtractionDataArray MultiMaskPartialKeyMapping<1u>::zeroInitializedArray() {
@@ -512,7 +665,7 @@ template<> inline typename MultiMaskPartialKeyMapping<2u>::ExtractionDataArray M
 
 template<> inline typename MultiMaskPartialKeyMapping<4u>::ExtractionDataArray MultiMaskPartialKeyMapping<4u>::zeroInitializedArray() {
 	ExtractionDataArray data;
-	_mm256_storeu_si256(reinterpret_cast<__m256i*>(data.data()), _mm256_setzero_si256());
+	SIMDHelperType::store(SIMDHelperType::zero(), data);
 	return std::move(data);
 }
 
@@ -525,6 +678,10 @@ template<unsigned int numberExtractionMasks>  inline void MultiMaskPartialKeyMap
 	reinterpret_cast<uint8_t *>(extractionData.data())[extractionByteIndex] = extractionByte;
 }
 
+template<unsigned int numberExtractionMasks> inline ExtractionBytePositionType MultiMaskPartialKeyMapping<numberExtractionMasks>::getExtractionBytePositionAt(typename MultiMaskPartialKeyMapping<numberExtractionMasks>::ExtractionPositionsArray const &extractionPositions, uint32_t extractionByteIndex) {
+	return reinterpret_cast<ExtractionBytePositionType const *>(extractionPositions.data())[extractionByteIndex];
+}
+
 template<unsigned int numberExtractionMasks>  inline uint32_t MultiMaskPartialKeyMapping<numberExtractionMasks>::getMaskForExtractionBytesUsed() const {
 	return (UINT32_MAX >> (32 - mNumberExtractionBytes));
 }
@@ -534,15 +691,15 @@ template<unsigned int numberExtractionMasks> inline uint32_t MultiMaskPartialKey
 }
 
 template<unsigned int numberExtractionMasks> inline uint32_t MultiMaskPartialKeyMapping<numberExtractionMasks>::getLeastSignificantBytIndexForBytesUsedMask(uint32_t bytesUsedMask) const {
-	return 31 - _lzcnt_u32(bytesUsedMask);
+	return 31 - countLeadingZeros32(bytesUsedMask);
 }
 
 template<unsigned int numberExtractionMasks> template<typename PartialKeyType> inline PartialKeyType MultiMaskPartialKeyMapping<numberExtractionMasks>::getMostSignifikantMaskBit(PartialKeyType mask) const {
 	ExtractionDataArray usedExtractionBits = getUsedExtractionBitsForMask(mask);
 	uint32_t usedExtractionBytesMask = getBytesUsedMaskForExtractionData(usedExtractionBits);
-	uint32_t highestExtractionByteIndex = __tzcnt_u32(usedExtractionBytesMask);
+	uint32_t highestExtractionByteIndex = countTrailingZeros32(usedExtractionBytesMask);
 	uint8_t highestByte = getExtractionByteAt(usedExtractionBits, highestExtractionByteIndex);
-	uint8_t extractionByteWithHighestBitSet = BYTE_WITH_HIGHEST_BIT_SET >> (_lzcnt_u32(highestByte) - 24);
+	uint8_t extractionByteWithHighestBitSet = BYTE_WITH_HIGHEST_BIT_SET >> (countLeadingZeros32(highestByte) - 24);
 
 	ExtractionDataArray extractionData = zeroInitializedArray();
 	setExtractionByteAt(extractionData, highestExtractionByteIndex, extractionByteWithHighestBitSet);
@@ -558,12 +715,12 @@ template<unsigned int numberExtractionMasks> inline uint16_t MultiMaskPartialKey
 }
 
 
-template<unsigned int numberExtractionMasks> inline uint8_t MultiMaskPartialKeyMapping<numberExtractionMasks>::getExtractionBytePosition(unsigned int index) const {
-	return reinterpret_cast<uint8_t const *>(mExtractionPositions.data())[index];
+template<unsigned int numberExtractionMasks> inline ExtractionBytePositionType MultiMaskPartialKeyMapping<numberExtractionMasks>::getExtractionBytePosition(unsigned int index) const {
+	return getExtractionBytePositionAt(mExtractionPositions, index);
 }
 
-template<unsigned int numberExtractionMasks> inline void MultiMaskPartialKeyMapping<numberExtractionMasks>::setExtractionBytePosition(unsigned int index, uint8_t extractionByte) {
-	reinterpret_cast<uint8_t *>(mExtractionPositions.data())[index] = extractionByte;
+template<unsigned int numberExtractionMasks> inline void MultiMaskPartialKeyMapping<numberExtractionMasks>::setExtractionBytePosition(unsigned int index, ExtractionBytePositionType bytePosition) {
+	reinterpret_cast<ExtractionBytePositionType *>(mExtractionPositions.data())[index] = bytePosition;
 }
 
 template<unsigned int numberExtractionMasks> inline uint8_t MultiMaskPartialKeyMapping<numberExtractionMasks>::getExtractionByte(unsigned int index) const {
@@ -580,7 +737,7 @@ template<unsigned int numberExtractionMasks> inline std::set<uint16_t> MultiMask
 		unsigned int extractionBasePosition = convertBytesToBits(getExtractionBytePosition(i));
 		uint32_t extractionByte = getExtractionByte(i);
 		while(extractionByte > 0) {
-			uint32_t byteRelativeBitPosition = __lzcnt32(extractionByte) - 24;
+			uint32_t byteRelativeBitPosition = countLeadingZeros32(extractionByte) - 24;
 			extractionBits.insert(extractionBasePosition + byteRelativeBitPosition);
 			extractionByte &= ~getExtractionByteWithBitSetAtRelativePosition(byteRelativeBitPosition);
 		}
@@ -592,6 +749,30 @@ template<unsigned int numberExtractionMasks> inline uint16_t MultiMaskPartialKey
 	return mNumberExtractionBytes;
 }
 
-} }
+template<unsigned int numberExtractionMasks> inline bool MultiMaskPartialKeyMapping<numberExtractionMasks>::isValidForMaximumKeyLength(size_t maximumKeyLength) const {
+	size_t numberAddressableBytes = std::min(maximumKeyLength, NUMBER_ADDRESSABLE_KEY_BYTES);
+	if(mNumberExtractionBytes == 0u || mNumberExtractionBytes > (numberExtractionMasks * 8)) {
+		return false;
+	}
+
+	unsigned int numberKeyBits = 0u;
+	for(unsigned int i = 0u; i < (numberExtractionMasks * 8); ++i) {
+		bool isUsed = i < mNumberExtractionBytes;
+		if((getExtractionByte(i) != 0u) != isUsed) {
+			return false;
+		}
+		if(isUsed && (getExtractionBytePosition(i) >= numberAddressableBytes || (i > 0u && getExtractionBytePosition(i) <= getExtractionBytePosition(i - 1u)))) {
+			return false;
+		}
+		numberKeyBits += populationCount32(getExtractionByte(i));
+	}
+
+	unsigned int lastIndex = mNumberExtractionBytes - 1u;
+	return numberKeyBits == mNumberKeyBits
+		&& mMostSignificantDiscriminativeBitIndex == getMostSignificantBitIndexInByte(getExtractionByte(0u)) + (getExtractionBytePosition(0u) * 8u)
+		&& mLeastSignificantDiscriminativeBitIndex == getLeastSignificantBitIndexInByte(getExtractionByte(lastIndex)) + (getExtractionBytePosition(lastIndex) * 8u);
+}
+
+} } }
 
 #endif
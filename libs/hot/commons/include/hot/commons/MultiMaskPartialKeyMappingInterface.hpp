@@ -7,10 +7,12 @@
 #include <utility>
 #include <type_traits>
 
+#include "hot/commons/ParallelBitOperations.hpp"
 #include "hot/commons/PartialKeyMappingBase.hpp"
 #include "hot/commons/SIMDHelper.hpp"
+#include "hot/commons/InstructionSet.hpp"
 
-namespace hot { namespace commons {
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 class SingleMaskPartialKeyMapping;
 
@@ -31,21 +33,51 @@ public:
 	using SIMDHelperType = SIMDHelper<NUMBER_BITS>;
 	using SIMDRegisterType = typename SIMDHelperType::SIMDRegisterType;
 	using ExtractionDataArray = std::array<uint64_t, numberExtractionMasks>;
+	/**
+	 * the array storing the positions of the extraction bytes. It consists of numberExtractionMasks * 8 entries of type ExtractionBytePositionType.
+	 */
+	using ExtractionPositionsArray = std::array<uint64_t, numberExtractionMasks * sizeof(ExtractionBytePositionType)>;
 
 private:
 
 	uint16_t mNumberExtractionBytes;
 	uint16_t mNumberKeyBits;
 
-	ExtractionDataArray mExtractionPositions;
+	ExtractionPositionsArray mExtractionPositions;
 	ExtractionDataArray mExtractionData;
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+	/**
+	 * the emulation steps for each of the masks in mExtractionData, which are computed at the end of each constructor and therefore not for each extraction
+	 */
+	std::array<ParallelBitOperationsEmulationSteps<uint64_t>, numberExtractionMasks> mExtractionEmulation;
+#endif
 
+#ifndef USE_LONG_KEYS
 	inline SIMDRegisterType getPositionsRegister() const;
+#endif
 	inline SIMDRegisterType getExtractionDataRegister() const;
 private:
+#ifndef USE_LONG_KEYS
 	inline void setPositions(SIMDRegisterType positions);
+#endif
 	inline void setExtractionData(SIMDRegisterType data);
 
+	inline void initializeExtractionEmulation();
+
+	/**
+	 * @param source the input mapped to the extraction mask
+	 * @param maskIndex the index of the extraction mask in mExtractionData
+	 * @return the bits of source selected by the extraction mask
+	 */
+	inline uint64_t extractBitsForMask(uint64_t source, unsigned int maskIndex) const;
+
+	/**
+	 * @param source the bits to deposit
+	 * @param maskIndex the index of the extraction mask in mExtractionData
+	 * @return the least significant bits of source deposited to the bits selected by the extraction mask
+	 */
+	inline uint64_t depositBitsForMask(uint64_t source, unsigned int maskIndex) const;
+
 public:
 	inline MultiMaskPartialKeyMapping(MultiMaskPartialKeyMapping<numberExtractionMasks> const & src);
 
@@ -94,10 +126,19 @@ public:
 
 	inline MultiMaskPartialKeyMapping(
 		uint16_t const numberBytesUsed, uint16_t const bitsUsed,
-		ExtractionDataArray const & mExtractionPositions,
+		ExtractionPositionsArray const & mExtractionPositions,
 		ExtractionDataArray const & mExtractionData
 	);
 
+	/**
+	 * Creates a new multi mask partial key mapping, which extracts exactly the given discriminative bits.
+	 * The bit indexes may be passed in arbitrary order and may contain duplicates, but must not span more than numberExtractionMasks * 8 different key bytes.
+	 *
+	 * @param discriminativeBitIndexes the absolute indexes of the discriminative bits to extract
+	 * @param numberDiscriminativeBitIndexes the number of passed bit indexes
+	 */
+	inline MultiMaskPartialKeyMapping(uint16_t const * discriminativeBitIndexes, unsigned int const numberDiscriminativeBitIndexes);
+
 protected:
 	inline MultiMaskPartialKeyMapping(
 		uint16_t const mostSignificantBitIndex, uint16_t const leastSignificantBitIndex,
@@ -107,6 +148,14 @@ protected:
 public:
 	inline uint32_t extractMask(uint8_t const *keyBytes) const;
 
+	/**
+	 * extracts the partial key of a variable length key in place, treating all bytes following the key's length as zero bytes
+	 *
+	 * @param keyBytes the bytes of the key
+	 * @return the partial key
+	 */
+	inline uint32_t extractMask(idx::contenthelpers::KeyBytesView const & keyBytes) const;
+
 	/**
 	 * Given a key information it generates a prefix up to the position represented by the key information and generates a mask corresponding to the bits defined in this extraction mask
 	 *
@@ -147,7 +196,7 @@ public:
 	template<typename Operation>
 	inline auto extract(uint32_t bitsUsed, Operation const &operation) const;
 
-	inline std::array<uint8_t, 256> createIntermediateKeyWithOnlySignificantBitsSet() const;
+	inline std::array<uint8_t, NUMBER_ADDRESSABLE_KEY_BYTES> createIntermediateKeyWithOnlySignificantBitsSet() const;
 
 	/**
 	 * a helper function which invokes a callback with the this partial key mapping itself and the smallest possible partial key type which is necessary to represent partial keys
@@ -184,6 +233,8 @@ private:
 
 	inline ExtractionDataArray mapInput(uint8_t const __restrict__ *keyBytes) const;
 
+	inline ExtractionDataArray mapInput(idx::contenthelpers::KeyBytesView const & keyBytes) const;
+
 	inline uint32_t extractMaskForMappedInput(ExtractionDataArray const &mappedInputData) const;
 
 public:
@@ -235,6 +286,8 @@ private:
 
 	static inline void setExtractionByteAt(ExtractionDataArray &extractionData, uint32_t extractionByteIndex, uint8_t extractionByte);
 
+	static inline ExtractionBytePositionType getExtractionBytePositionAt(ExtractionPositionsArray const & extractionPositions, uint32_t extractionByteIndex);
+
 	inline uint32_t getMaskForExtractionBytesUsed() const;
 
 	inline uint32_t getBytesUsedMaskForExtractionData(ExtractionDataArray const & extractionData) const;
@@ -262,9 +315,9 @@ public:
 	 */
 	inline uint16_t getLeastSignificantBitIndex(uint32_t mask) const;
 
-	inline uint8_t getExtractionBytePosition(unsigned int index) const;
+	inline ExtractionBytePositionType getExtractionBytePosition(unsigned int index) const;
 
-	inline void setExtractionBytePosition(unsigned int index, uint8_t byte);
+	inline void setExtractionBytePosition(unsigned int index, ExtractionBytePositionType bytePosition);
 
 	inline uint8_t getExtractionByte(unsigned int index) const;
 
@@ -280,8 +333,17 @@ public:
 	 * @return the number of the underlying 8 byte masks which are currently not 0
 	 */
 	inline uint16_t getNumberExtractionBytes() const;
+
+	/**
+	 * Checks a partial key mapping, which was not created by one of the constructors but restored from a memory image, e.g. while loading a file.
+	 *
+	 * @param maximumKeyLength the maximum length of the keys in bytes
+	 * @return whether the used extraction bytes are ordered by their positions, which are smaller than the maximum key length, whether exactly the used extraction bytes are not 0
+	 * 	and whether the number of key bits and the bit indexes are consistent with the extraction bytes
+	 */
+	inline bool isValidForMaximumKeyLength(size_t maximumKeyLength) const;
 };
 
-} }
+} } }
 
 #endif
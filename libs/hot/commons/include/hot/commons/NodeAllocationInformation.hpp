@@ -1,7 +1,9 @@
 #ifndef __HOT__ROWEX__NODE_ALLOCATION_INFORMATION__
 #define __HOT__ROWEX__NODE_ALLOCATION_INFORMATION__
 
-namespace hot { namespace commons {
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 struct NodeAllocationInformation {
 	uint32_t const mEntriesMask;
@@ -14,6 +16,6 @@ struct NodeAllocationInformation {
 	}
 };
 
-}}
+}}}
 
 #endif
\ No newline at end of file
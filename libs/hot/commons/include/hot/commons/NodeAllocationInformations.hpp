@@ -4,8 +4,9 @@
 #include <array>
 
 #include "hot/commons/NodeAllocationInformation.hpp"
+#include "hot/commons/InstructionSet.hpp"
 
-namespace hot { namespace commons {
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 constexpr size_t MAXIMUM_NUMBER_NODE_ENTRIES = 32;
 
@@ -57,6 +58,6 @@ template<typename NodeTypename> inline NodeAllocationInformation const & NodeAll
 	return mAllocationInformations[numberEntries - 1];
 }
 
-}}
+}}}
 
 #endif
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef __HOT__COMMONS__NODE_MEMORY__
+#define __HOT__COMMONS__NODE_MEMORY__
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <new>
+
+#include "hot/commons/NodeAllocationInformations.hpp"
+#include "hot/commons/ParallelBitOperations.hpp"
+#include "hot/commons/PartialKeyMappingBase.hpp"
+#include "hot/commons/SlabAllocator.hpp"
+#include "hot/commons/InstructionSet.hpp"
+
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+/**
+ * The largest node of each HOT variant has 32 entries, 32 bit partial keys and a partial key mapping using four extraction masks.
+ * Without any optional data, its header, partial key mapping, partial keys and child pointers fit into 60 longs.
+ *
+ * @param additionalSizeInBytes the number of bytes, which a HOT variant additionally stores in its largest node, e.g. the subtree counts of its entries
+ * @return the maximum size of a node of a HOT variant in bytes
+ */
+constexpr size_t getMaximumNodeSizeInBytes(size_t additionalSizeInBytes) {
+	return 60u * sizeof(uint64_t) + additionalSizeInBytes
+		//with long keys each of the up to 32 extraction byte positions of the largest partial key mapping occupies additional bytes
+		+ MAXIMUM_NUMBER_NODE_ENTRIES * (sizeof(ExtractionBytePositionType) - sizeof(uint8_t))
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+		//the largest partial key mapping additionally stores the emulation steps of its four extraction masks
+		+ 4u * sizeof(ParallelBitOperationsEmulationSteps<uint64_t>)
+#endif
+		;
+}
+
+/**
+ * the maximum number of bytes required to store the subtree counts of a node's entries, which are only stored by HOTSingleThreaded if USE_ORDER_STATISTICS is defined
+ */
+#ifdef USE_ORDER_STATISTICS
+constexpr size_t MAXIMUM_SUBTREE_COUNTS_SIZE_IN_BYTES = MAXIMUM_NUMBER_NODE_ENTRIES * sizeof(uint32_t);
+#else
+constexpr size_t MAXIMUM_SUBTREE_COUNTS_SIZE_IN_BYTES = 0u;
+#endif
+
+/**
+ * the maximum size of a node allocated by any of the HOT variants
+ */
+constexpr size_t MAXIMUM_SLAB_NODE_SIZE_IN_BYTES = getMaximumNodeSizeInBytes(MAXIMUM_SUBTREE_COUNTS_SIZE_IN_BYTES);
+
+using NodeSlabAllocator = SlabAllocator<MAXIMUM_SLAB_NODE_SIZE_IN_BYTES>;
+
+/**
+ * @return the slab allocator shared by all nodes in case USE_SLAB_ALLOCATOR is defined.
+ * It is never destroyed, as nodes may still be released by destructors of other static objects.
+ */
+inline NodeSlabAllocator & getNodeSlabAllocator() {
+#ifdef USE_HUGETLB_SLABS
+	static NodeSlabAllocator* slabAllocator = new NodeSlabAllocator(SlabBacking::HUGETLB_PAGES);
+#else
+	static NodeSlabAllocator* slabAllocator = new NodeSlabAllocator(SlabBacking::TRANSPARENT_HUGE_PAGES);
+#endif
+	return *slabAllocator;
+}
+
+/**
+ * Allocates the raw memory for a node.
+ * In case USE_SLAB_ALLOCATOR is defined, the node is carved out of a 64 byte aligned slot of a huge page backed slab.
+ * Otherwise it is allocated using posix_memalign with the given alignment.
+ *
+ * @param sizeInBytes the size of the node in bytes
+ * @param alignment the minimum alignment of the node
+ * @return the memory allocated for the node
+ */
+inline void* allocateNodeMemory(size_t sizeInBytes, size_t alignment) {
+#ifdef USE_SLAB_ALLOCATOR
+	assert(alignment <= SLAB_OBJECT_ALIGNMENT);
+	(void) alignment;
+	return getNodeSlabAllocator().allocate(sizeInBytes);
+#else
+	void* memory = nullptr;
+	int error = posix_memalign(&memory, alignment, sizeInBytes);
+	if(error != 0) {
+		//"Got error on alignment"
+		throw std::bad_alloc();
+	}
+	return memory;
+#endif
+}
+
+/**
+ * releases memory previously allocated by { @link allocateNodeMemory }
+ *
+ * @param memory the memory of the node to release
+ */
+inline void releaseNodeMemory(void* memory) {
+#ifdef USE_SLAB_ALLOCATOR
+	getNodeSlabAllocator().release(memory);
+#else
+	free(memory);
+#endif
+}
+
+} } }
+
+#endif
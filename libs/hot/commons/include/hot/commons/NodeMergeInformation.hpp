@@ -12,13 +12,15 @@
 #include <hot/commons/DiscriminativeBit.hpp>
 #include <hot/commons/BitMask32.hpp>
 #include <hot/commons/MultiMaskPartialKeyMapping.hpp>
+#include <hot/commons/SIMDHelper.hpp>
+#include <hot/commons/InstructionSet.hpp>
 
 
-namespace hot { namespace commons {
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 class NodeMergeInformation {
-	std::array<uint8_t, 256> mKeyWithOnlyBitForLeftSourceInformation;
-	std::array<uint8_t, 256> mKeyWithOnlyBitForRightSourceInformation;
+	std::array<uint8_t, NUMBER_ADDRESSABLE_KEY_BYTES> mKeyWithOnlyBitForLeftSourceInformation;
+	std::array<uint8_t, NUMBER_ADDRESSABLE_KEY_BYTES> mKeyWithOnlyBitForRightSourceInformation;
 	bool mHasMergedMask;
 	alignas(std::alignment_of<MultiMaskPartialKeyMapping<4>>::value) std::array<uint8_t, sizeof(MultiMaskPartialKeyMapping<4>)> mRawMergedMask;
 
@@ -62,31 +64,33 @@ public:
   	}
 
 private:
-    void initializeMergedMask(uint16_t rootBit, std::array<uint8_t, 256> const & first, std::array<uint8_t, 256> const & second) {
+    void initializeMergedMask(uint16_t rootBit, std::array<uint8_t, NUMBER_ADDRESSABLE_KEY_BYTES> const & first, std::array<uint8_t, NUMBER_ADDRESSABLE_KEY_BYTES> const & second) {
 		//AVX-512 ?
-		alignas(8) std::array<uint64_t, 4> bytePositions;
+		alignas(8) MultiMaskPartialKeyMapping<4>::ExtractionPositionsArray bytePositions;
 		alignas(8) std::array<uint64_t, 4> byteMasks;
-		alignas(8) std::array<uint8_t, 256> result;
+		alignas(8) std::array<uint8_t, NUMBER_ADDRESSABLE_KEY_BYTES> result;
 
 		std::fill(byteMasks.begin(), byteMasks.end(), 0);
 		std::fill(bytePositions.begin(), bytePositions.end(), 0);
 
-		uint8_t* rawBytePosition = reinterpret_cast<uint8_t*>(bytePositions.data());
+		ExtractionBytePositionType* rawBytePosition = reinterpret_cast<ExtractionBytePositionType*>(bytePositions.data());
 		uint8_t* rawByteMasks = reinterpret_cast<uint8_t*>(byteMasks.data());
 
 		uint16_t nextBytePositionToUse = 0u;
 
 
-		__m256i zero = _mm256_setzero_si256();
+		using SIMDHelperType = SIMDHelper<256u>;
+		using SIMDRegisterType = SIMDHelperType::SIMDRegisterType;
+		SIMDRegisterType zero = SIMDHelperType::zero();
 
-		for(size_t i=0; i < 256; i+= sizeof(__m256i)) {
-			__m256i firstPortion = _mm256_loadu_si256((__m256i const *) (first.data() + i));
-			__m256i secondPortion = _mm256_loadu_si256((__m256i const *) (second.data() + i));
-			__m256i bothBitsSet = _mm256_or_si256(firstPortion, secondPortion);
+		for(size_t i=0; i < NUMBER_ADDRESSABLE_KEY_BYTES; i+= 32u) {
+			SIMDRegisterType firstPortion = SIMDHelperType::toRegister(first.data() + i);
+			SIMDRegisterType secondPortion = SIMDHelperType::toRegister(second.data() + i);
+			SIMDRegisterType bothBitsSet = SIMDHelperType::binaryOr(firstPortion, secondPortion);
 
-			BitMask32 usedByteIndexes(~(_mm256_movemask_epi8(_mm256_cmpeq_epi8(zero, bothBitsSet))));
+			BitMask32 usedByteIndexes(~(SIMDHelperType::moveMask8(SIMDHelperType::cmpeq_epi8(zero, bothBitsSet))));
 
-			_mm256_storeu_si256(reinterpret_cast<__m256i*>(result.data() + i),  _mm256_or_si256(firstPortion, secondPortion));
+			SIMDHelperType::store(bothBitsSet, result.data() + i);
 			//iterate over potentially set bytes
 			for(uint32_t relativeUsedBytesIndex : usedByteIndexes) {
 				size_t absoluteUsedBytesIndex = i + relativeUsedBytesIndex;
@@ -127,14 +131,14 @@ private:
     }
 
     static size_t popcount(std::array<uint64_t, 4> const & rawByteMasks) {
-		return _mm_popcnt_u64(rawByteMasks[0])
-			+ _mm_popcnt_u64(rawByteMasks[1])
-			+ _mm_popcnt_u64(rawByteMasks[2])
-			+ _mm_popcnt_u64(rawByteMasks[3]);
+		return populationCount64(rawByteMasks[0])
+			+ populationCount64(rawByteMasks[1])
+			+ populationCount64(rawByteMasks[2])
+			+ populationCount64(rawByteMasks[3]);
     }
 
 };
 
-}}
+}}}
 
 #endif
\ No newline at end of file
@@ -4,8 +4,9 @@
 #include "hot/commons/NodeType.hpp"
 #include "hot/commons/MultiMaskPartialKeyMappingInterface.hpp"
 #include "hot/commons/SingleMaskPartialKeyMappingInterface.hpp"
+#include "hot/commons/InstructionSet.hpp"
 
-namespace hot { namespace commons {
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> struct NodeParametersToNodeType {
 };
@@ -85,6 +86,6 @@ template<> struct NodeTypeToNodeParameters<NodeType ::MULTI_MASK_32_BYTES_AND_32
 	using PartialKeyType = uint32_t;
 };
 
-}}
+}}}
 
 #endif
\ No newline at end of file
@@ -1,7 +1,11 @@
 #ifndef __HOT__COMMONS__NODE_TYPE__
 #define __HOT__COMMONS__NODE_TYPE__
 
-namespace hot { namespace commons {
+#include <cstddef>
+
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 enum class NodeType : unsigned int {
 	SINGLE_MASK_8_BIT_PARTIAL_KEYS = 0,
@@ -14,6 +18,30 @@ enum class NodeType : unsigned int {
 	MULTI_MASK_32_BYTES_AND_32_BIT_PARTIAL_KEYS = 7
 };
 
+/**
+ * Determines whether a trie whose keys consist of at most maximumKeyLength bytes can only contain single mask node types.
+ * A single mask covers the discriminative bits of 8 successive key bytes, hence each node of such a trie uses a single mask, regardless of whether it was created by an insert, a split, a merge or a bulk load.
+ * For longer keys all node types can occur, as keys longer than 8 bytes may require two extraction masks combined with 32 bit partial keys, which are represented by MULTI_MASK_32_BYTES_AND_32_BIT_PARTIAL_KEYS.
+ *
+ * @param maximumKeyLength the maximum length of the keys in bytes
+ * @return whether only SINGLE_MASK_8_BIT_PARTIAL_KEYS, SINGLE_MASK_16_BIT_PARTIAL_KEYS and SINGLE_MASK_32_BIT_PARTIAL_KEYS nodes can occur
+ */
+constexpr bool hasOnlySingleMaskNodeTypes(size_t maximumKeyLength) {
+	return maximumKeyLength <= 8u;
+}
+
+/**
+ * Determines whether nodes of a given type can occur in a trie whose keys consist of at most maximumKeyLength bytes (see { @link #hasOnlySingleMaskNodeTypes(size_t) }).
+ * This is used to validate node types, which are not known at compile time, before dispatching on them.
+ *
+ * @param nodeType the node type to check
+ * @param maximumKeyLength the maximum length of the keys in bytes
+ * @return whether nodes of this type can occur
+ */
+constexpr bool canNodeTypeOccur(NodeType nodeType, size_t maximumKeyLength) {
+	return nodeType <= (hasOnlySingleMaskNodeTypes(maximumKeyLength) ? NodeType::SINGLE_MASK_32_BIT_PARTIAL_KEYS : NodeType::MULTI_MASK_32_BYTES_AND_32_BIT_PARTIAL_KEYS);
+}
+
 inline NodeType getRandomNodeType(uint numberKeyBits, uint numberRandomBytes) {
 	//log2 + shift right ---> numberBytes 0-7 > 0, numberBytes 7 - 16 > 1, numberBytes 16 - 32 > 2
 	uint32_t numberMaskBytes = (32 - __builtin_clz((numberKeyBits - 1)/8));
@@ -51,6 +79,6 @@ inline std::string nodeAlgorithmToString(NodeType nodeAlgorithmType) {
 	}
 }
 
-}}
+}}}
 
 #endif
\ No newline at end of file
@@ -0,0 +1,289 @@
+#ifndef __HOT__COMMONS__PARALLEL_BIT_OPERATIONS__
+#define __HOT__COMMONS__PARALLEL_BIT_OPERATIONS__
+
+#include <immintrin.h>
+
+#include <cstdint>
+
+#include <hot/commons/InstructionSet.hpp>
+#include <hot/commons/ParallelBitOperationsConfiguration.hpp>
+
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+/**
+ * Parallel bit extract and deposit operations as provided by the BMI2 instructions pext and pdep.
+ *
+ * If the code is compiled for BMI2, which is part of the AVX2 instruction set, extractBits32, extractBits64, depositBits32 and depositBits64 use the instructions directly,
+ * unless the emulation was compiled in and selected at runtime (see ParallelBitOperationsImplementation).
+ * Otherwise they use a portable implementation, which iterates over the set bits of the mask.
+ *
+ * @tparam instructionSet the instruction set to implement the operations with
+ */
+template<InstructionSet instructionSet> struct ParallelBitOperations {
+	/**
+	 * @param source the value to extract the bits from
+	 * @param mask a mask of the bits to extract
+	 * @return the bits of source selected by mask, stored in the least significant bits of the result
+	 */
+	template<typename IntegerType> static inline IntegerType extractBits(IntegerType source, IntegerType mask) {
+		IntegerType extractedBits = 0u;
+		for(IntegerType resultBit = 1u; mask != 0u; resultBit = static_cast<IntegerType>(resultBit << 1u)) {
+			extractedBits |= ((source & mask & -mask) != 0u) ? resultBit : 0u;
+			mask &= mask - 1u;
+		}
+		return extractedBits;
+	}
+
+	/**
+	 * @param source the value to deposit the least significant bits of
+	 * @param mask a mask of the bits to deposit the bits of source to
+	 * @return a value with the least significant bits of source scattered to the bit positions set in mask
+	 */
+	template<typename IntegerType> static inline IntegerType depositBits(IntegerType source, IntegerType mask) {
+		IntegerType depositedBits = 0u;
+		for(IntegerType sourceBit = 1u; mask != 0u; sourceBit = static_cast<IntegerType>(sourceBit << 1u)) {
+			depositedBits |= ((source & sourceBit) != 0u) ? (mask & -mask) : 0u;
+			mask &= mask - 1u;
+		}
+		return depositedBits;
+	}
+};
+
+template<> struct ParallelBitOperations<InstructionSet::AVX2> {
+	static HOT_AVX2_FUNCTION uint32_t extractBits(uint32_t source, uint32_t mask) {
+		return _pext_u32(source, mask);
+	}
+
+	static HOT_AVX2_FUNCTION uint64_t extractBits(uint64_t source, uint64_t mask) {
+		return _pext_u64(source, mask);
+	}
+
+	static HOT_AVX2_FUNCTION uint32_t depositBits(uint32_t source, uint32_t mask) {
+		return _pdep_u32(source, mask);
+	}
+
+	static HOT_AVX2_FUNCTION uint64_t depositBits(uint64_t source, uint64_t mask) {
+		return _pdep_u64(source, mask);
+	}
+};
+
+/**
+ * The steps emulating pext and pdep for a single mask with a fixed number of shift and mask steps, using the compress and expand algorithms from Hacker's Delight (section 7-4 and 7-5).
+ *
+ * In step i all bits, whose distance to their target position has bit i set, are moved by 2^i positions.
+ * The bits moved in each step only depend on the mask, therefore they are computed once on construction and are shared by the extract and deposit operations.
+ * Computing them requires the prefix parity of a mask, which is a carry-less multiplication with a mask of all ones and uses pclmulqdq if available.
+ *
+ * The mask itself is not stored, as the partial key mappings storing the steps next to their extraction masks would otherwise store it twice.
+ * Unlike the microcoded pext and pdep instructions of AMD processors prior to Zen 3, the costs do not depend on the number of bits set in the mask.
+ *
+ * @tparam IntegerType either uint32_t or uint64_t
+ */
+template<typename IntegerType> class ParallelBitOperationsEmulationSteps {
+	static constexpr unsigned NUMBER_STEPS = (sizeof(IntegerType) == 8u) ? 6u : 5u;
+
+	IntegerType mMovedBits[NUMBER_STEPS];
+
+public:
+	/**
+	 * the steps of an empty mask
+	 */
+	inline ParallelBitOperationsEmulationSteps() : mMovedBits {} {
+	}
+
+	//is not inlined to keep the code size of the callers small, as the instructions are used instead on most processors
+	inline __attribute__((noinline)) explicit ParallelBitOperationsEmulationSteps(IntegerType mask) {
+		//marks the zero bits of the mask, which are to the right of each bit
+		IntegerType zerosToTheRight = static_cast<IntegerType>(~mask << 1u);
+		for(unsigned i = 0u; i < NUMBER_STEPS; ++i) {
+			IntegerType oddNumberOfZeros = getPrefixParity(zerosToTheRight);
+			IntegerType movedBits = oddNumberOfZeros & mask;
+			mMovedBits[i] = movedBits;
+			mask = static_cast<IntegerType>((mask ^ movedBits) | (movedBits >> (1u << i)));
+			zerosToTheRight &= ~oddNumberOfZeros;
+		}
+	}
+
+	/**
+	 * @param source the value to extract the bits from
+	 * @param mask the mask these steps were computed for
+	 * @return the same result as pext(source, mask)
+	 */
+	inline IntegerType extractBits(IntegerType source, IntegerType mask) const {
+		IntegerType extractedBits = source & mask;
+		for(unsigned i = 0u; i < NUMBER_STEPS; ++i) {
+			IntegerType movedBits = extractedBits & mMovedBits[i];
+			extractedBits = static_cast<IntegerType>((extractedBits ^ movedBits) | (movedBits >> (1u << i)));
+		}
+		return extractedBits;
+	}
+
+	/**
+	 * @param source the value to deposit the least significant bits of
+	 * @param mask the mask these steps were computed for
+	 * @return the same result as pdep(source, mask)
+	 */
+	inline IntegerType depositBits(IntegerType source, IntegerType mask) const {
+		IntegerType depositedBits = source;
+		for(unsigned i = NUMBER_STEPS; i > 0u; --i) {
+			IntegerType movedBits = mMovedBits[i - 1u];
+			depositedBits = static_cast<IntegerType>((depositedBits & ~movedBits) | ((depositedBits << (1u << (i - 1u))) & movedBits));
+		}
+		return depositedBits & mask;
+	}
+
+private:
+	/**
+	 * @return a value whose bit i is the parity of the bits 0 to i of the given value
+	 */
+	static inline IntegerType getPrefixParity(IntegerType value) {
+#ifdef __PCLMUL__
+		return static_cast<IntegerType>(_mm_cvtsi128_si64(_mm_clmulepi64_si128(_mm_cvtsi64_si128(static_cast<int64_t>(value)), _mm_set1_epi64x(-1), 0)));
+#else
+		for(unsigned shift = 1u; shift < sizeof(IntegerType) * 8u; shift <<= 1u) {
+			value ^= static_cast<IntegerType>(value << shift);
+		}
+		return value;
+#endif
+	}
+};
+
+/**
+ * Emulates pext and pdep for a single mask (see ParallelBitOperationsEmulationSteps).
+ *
+ * @tparam IntegerType either uint32_t or uint64_t
+ */
+template<typename IntegerType> class ParallelBitOperationsEmulation {
+	IntegerType mMask;
+	ParallelBitOperationsEmulationSteps<IntegerType> mSteps;
+
+public:
+	inline ParallelBitOperationsEmulation() : mMask(0u), mSteps() {
+	}
+
+	inline ParallelBitOperationsEmulation(IntegerType mask) : mMask(mask), mSteps(mask) {
+	}
+
+	/**
+	 * @param source the value to extract the bits from
+	 * @return the same result as pext(source, mask)
+	 */
+	inline IntegerType extractBits(IntegerType source) const {
+		return mSteps.extractBits(source, mMask);
+	}
+
+	/**
+	 * @param source the value to deposit the least significant bits of
+	 * @return the same result as pdep(source, mask)
+	 */
+	inline IntegerType depositBits(IntegerType source) const {
+		return mSteps.depositBits(source, mMask);
+	}
+};
+
+/**
+ * The implementation of the parallel bit operations used if the emulation is not selected.
+ */
+using CompiledParallelBitOperations = ParallelBitOperations<isCompiledFor(InstructionSet::AVX2) ? InstructionSet::AVX2 : InstructionSet::SSE2>;
+
+/**
+ * Applies the parallel bit operations with a mask, whose emulation steps were computed in advance, like the extraction masks of a partial key mapping.
+ * If the emulation is not compiled in, the steps are ignored and the result is the same as the one of the corresponding free function.
+ *
+ * @param source the value to extract the bits from
+ * @param mask a mask of the bits to extract
+ * @param steps the emulation steps computed for mask
+ * @return the same result as pext(source, mask)
+ */
+inline __attribute__((always_inline)) uint64_t extractBits64(uint64_t source, uint64_t mask, ParallelBitOperationsEmulationSteps<uint64_t> const & steps) {
+	return (isCompiledFor(InstructionSet::AVX2) && isParallelBitOperationsEmulationSelected())
+		? steps.extractBits(source, mask)
+		: CompiledParallelBitOperations::extractBits(source, mask);
+}
+
+/**
+ * @param source the value to deposit the least significant bits of
+ * @param mask a mask of the bits to deposit the bits of source to
+ * @param steps the emulation steps computed for mask
+ * @return the same result as pdep(source, mask)
+ */
+inline __attribute__((always_inline)) uint64_t depositBits64(uint64_t source, uint64_t mask, ParallelBitOperationsEmulationSteps<uint64_t> const & steps) {
+	return (isCompiledFor(InstructionSet::AVX2) && isParallelBitOperationsEmulationSelected())
+		? steps.depositBits(source, mask)
+		: CompiledParallelBitOperations::depositBits(source, mask);
+}
+
+inline __attribute__((always_inline)) uint32_t extractBits32(uint32_t source, uint32_t mask) {
+	return !isCompiledFor(InstructionSet::AVX2)
+		? ParallelBitOperations<InstructionSet::SSE2>::extractBits(source, mask)
+		: (isParallelBitOperationsEmulationSelected()
+			? ParallelBitOperationsEmulation<uint32_t>(mask).extractBits(source)
+			: ParallelBitOperations<InstructionSet::AVX2>::extractBits(source, mask));
+}
+
+inline __attribute__((always_inline)) uint64_t extractBits64(uint64_t source, uint64_t mask) {
+	return !isCompiledFor(InstructionSet::AVX2)
+		? ParallelBitOperations<InstructionSet::SSE2>::extractBits(source, mask)
+		: (isParallelBitOperationsEmulationSelected()
+			? ParallelBitOperationsEmulation<uint64_t>(mask).extractBits(source)
+			: ParallelBitOperations<InstructionSet::AVX2>::extractBits(source, mask));
+}
+
+inline __attribute__((always_inline)) uint32_t depositBits32(uint32_t source, uint32_t mask) {
+	return !isCompiledFor(InstructionSet::AVX2)
+		? ParallelBitOperations<InstructionSet::SSE2>::depositBits(source, mask)
+		: (isParallelBitOperationsEmulationSelected()
+			? ParallelBitOperationsEmulation<uint32_t>(mask).depositBits(source)
+			: ParallelBitOperations<InstructionSet::AVX2>::depositBits(source, mask));
+}
+
+inline __attribute__((always_inline)) uint64_t depositBits64(uint64_t source, uint64_t mask) {
+	return !isCompiledFor(InstructionSet::AVX2)
+		? ParallelBitOperations<InstructionSet::SSE2>::depositBits(source, mask)
+		: (isParallelBitOperationsEmulationSelected()
+			? ParallelBitOperationsEmulation<uint64_t>(mask).depositBits(source)
+			: ParallelBitOperations<InstructionSet::AVX2>::depositBits(source, mask));
+}
+
+/**
+ * Applies the parallel bit operations with the same mask to many values, like recoding all partial keys of a node when it is copied.
+ * The implementation is selected once on construction and if the emulation is selected, its mask dependent steps are computed only once.
+ *
+ * @tparam IntegerType either uint32_t or uint64_t
+ */
+template<typename IntegerType> class ParallelBitMask {
+	IntegerType mMask;
+	bool mIsEmulated;
+	ParallelBitOperationsEmulation<IntegerType> mEmulation;
+
+public:
+	inline ParallelBitMask(IntegerType mask) : mMask(mask), mIsEmulated(isCompiledFor(InstructionSet::AVX2) && isParallelBitOperationsEmulationSelected()) {
+		if(mIsEmulated) {
+			mEmulation = ParallelBitOperationsEmulation<IntegerType>(mask);
+		}
+	}
+
+	/**
+	 * @param source the value to extract the bits selected by this mask from
+	 * @return the same result as pext(source, mask)
+	 */
+	inline IntegerType extractBits(IntegerType source) const {
+		return !isCompiledFor(InstructionSet::AVX2)
+			? ParallelBitOperations<InstructionSet::SSE2>::extractBits(source, mMask)
+			: (mIsEmulated ? mEmulation.extractBits(source) : ParallelBitOperations<InstructionSet::AVX2>::extractBits(source, mMask));
+	}
+
+	/**
+	 * @param source the value to deposit the least significant bits of to the bits selected by this mask
+	 * @return the same result as pdep(source, mask)
+	 */
+	inline IntegerType depositBits(IntegerType source) const {
+		return !isCompiledFor(InstructionSet::AVX2)
+			? ParallelBitOperations<InstructionSet::SSE2>::depositBits(source, mMask)
+			: (mIsEmulated ? mEmulation.depositBits(source) : ParallelBitOperations<InstructionSet::AVX2>::depositBits(source, mMask));
+	}
+};
+
+}}}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef __HOT__COMMONS__PARALLEL_BIT_OPERATIONS_CONFIGURATION__
+#define __HOT__COMMONS__PARALLEL_BIT_OPERATIONS_CONFIGURATION__
+
+#include <cstdint>
+
+/**
+ * The configuration of the parallel bit operations is independent of the instruction set the code is compiled for.
+ * Like InstructionSetDispatch.hpp it is not placed in an instruction set specific namespace, therefore a single configuration applies to all variants of HOT linked into the same binary.
+ */
+namespace hot { namespace commons {
+
+/**
+ * Selects whether the pext and pdep instructions or their emulation are used on processors supporting BMI2.
+ *
+ * 	+ Instructions are the best choice for all Intel processors and AMD processors since Zen 3.
+ * 	+ Emulation is the best choice for AMD processors prior to Zen 3, which implement pext and pdep in microcode.
+ * 	  Their latency grows with the number of bits set in the mask, up to several hundred cycles.
+ *
+ * Both implementations compute the same results. Therefore the implementation can be changed at any time without affecting existing indexes.
+ * It has no effect if the code is not compiled for BMI2, as the portable implementation is used in this case.
+ *
+ * The emulation is only available if the code is compiled with USE_PARALLEL_BIT_OPERATIONS_EMULATION.
+ * In this case the partial key mappings store the emulation steps of their extraction masks and each extraction checks the selected implementation.
+ * Otherwise the instructions are used without any check and selecting the emulation has no effect.
+ */
+enum class ParallelBitOperationsImplementation : uint8_t {
+	Instructions = 0u,
+	Emulation = 1u
+};
+
+/**
+ * Detects AMD processors prior to Zen 3, which implement pext and pdep in microcode.
+ * The emulation has only been measured on Intel processors, where each extraction is about four times and each lookup about 1.7 times slower than with the instructions.
+ * Therefore the emulation is not selected automatically, but applications can select the result of this function after measuring it on their processors.
+ *
+ * @return the implementation of the parallel bit operations, which is expected to perform best on the processor executing this code
+ */
+inline ParallelBitOperationsImplementation detectPreferredParallelBitOperationsImplementation() {
+	__builtin_cpu_init();
+	bool hasMicrocodedParallelBitOperations = __builtin_cpu_is("amd") && (__builtin_cpu_is("amdfam15h") || __builtin_cpu_is("amdfam17h"));
+	return hasMicrocodedParallelBitOperations ? ParallelBitOperationsImplementation::Emulation : ParallelBitOperationsImplementation::Instructions;
+}
+
+/**
+ * Holds the selected implementation. It is a static member of a class template, to be defined in a header only library.
+ * It is constant initialized with the instructions, which avoids a guard for its initialization on each access.
+ */
+template<typename Dummy = void> struct ParallelBitOperationsConfiguration {
+	static ParallelBitOperationsImplementation selectedImplementation;
+};
+
+template<typename Dummy> ParallelBitOperationsImplementation ParallelBitOperationsConfiguration<Dummy>::selectedImplementation = ParallelBitOperationsImplementation::Instructions;
+
+/**
+ * @return the implementation of the parallel bit operations currently used
+ */
+inline ParallelBitOperationsImplementation getParallelBitOperationsImplementation() {
+	return ParallelBitOperationsConfiguration<>::selectedImplementation;
+}
+
+/**
+ * Selects the implementation of the parallel bit operations, e.g. for benchmarking or for processors with microcoded pext and pdep instructions.
+ * It is not synchronized with concurrent operations and therefore should be called before any index is accessed by multiple threads.
+ *
+ * @param implementation the implementation of the parallel bit operations to use from now on
+ */
+inline void setParallelBitOperationsImplementation(ParallelBitOperationsImplementation implementation) {
+	ParallelBitOperationsConfiguration<>::selectedImplementation = implementation;
+}
+
+/**
+ * @return whether the emulation is compiled in and selected, which is a constant if it is not compiled in
+ */
+inline __attribute__((always_inline)) bool isParallelBitOperationsEmulationSelected() {
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+	return ParallelBitOperationsConfiguration<>::selectedImplementation == ParallelBitOperationsImplementation::Emulation;
+#else
+	return false;
+#endif
+}
+
+}}
+
+#endif
@@ -0,0 +1,291 @@
+#ifndef __HOT__COMMONS__PARALLEL_BULK_LOADER__
+#define __HOT__COMMONS__PARALLEL_BULK_LOADER__
+
+#include <cassert>
+#include <cstdint>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_invoke.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/task_arena.h>
+
+#include <hot/commons/BulkLoader.hpp>
+#include <hot/commons/DiscriminativeBit.hpp>
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+/**
+ * marks a pair of adjacent entries with equal keys
+ */
+constexpr uint16_t NO_SEPARATING_BIT_INDEX = UINT16_MAX;
+
+/**
+ * marks a pair of adjacent entries whose keys are in descending order. As keys consist of less than 8192 bytes, no separating bit has this index.
+ */
+constexpr uint16_t DESCENDING_KEYS_SEPARATING_BIT_INDEX = UINT16_MAX - 1u;
+
+/**
+ * the minimum number of entries which are loaded by a single task
+ */
+constexpr size_t PARALLEL_BULK_LOADER_MINIMUM_GRAIN_SIZE = 4096u;
+
+/**
+ * the number of adjacent pairs of entries, whose most significant separating bit is summarized by a single leaf of the minimum tree
+ */
+constexpr size_t PARALLEL_BULK_LOADER_BLOCK_SIZE = 64u;
+
+/**
+ * A ParallelBulkLoader constructs a height optimized trie bottom up from a sequence of leaf entries ordered by their keys using multiple TBB tasks.
+ *
+ * The most significant bit separating any two adjacent entries of a range is the root bit of the range's binary patricia trie.
+ * Splitting a range at this bit therefore partitions it into the ranges of the root's left and right subtree, which are independent of each other.
+ * Ranges are split recursively, the resulting ranges are loaded in parallel using a { @link BulkLoader } each
+ * and the roots of both subtrees are stitched together by appending them to a further BulkLoader.
+ *
+ * The separating bits of all adjacent entries are determined in a single parallel pass, which also records the most significant separating bit of each block of
+ * { @link PARALLEL_BULK_LOADER_BLOCK_SIZE } adjacent pairs in the leaves of an implicit binary minimum tree.
+ * Finding the root bit of a range therefore only scans the partially covered blocks at both ends of the range and O(log n) nodes of the minimum tree,
+ * instead of all separating bits of the range at each level of the recursion.
+ * As the roots of the loaded subtrees are not allocated until they are stitched together, they are still able to absorb entries,
+ * and the resulting trie is constructed by the same combination rules as a trie loaded sequentially.
+ *
+ * @tparam ChildPointerType the type of the child pointers used by the trie
+ * @tparam NodeTemplate the node template of the trie
+ * @tparam LeafProvider a function object which returns the leaf child pointer for a given entry index
+ */
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate, typename LeafProvider> class ParallelBulkLoader {
+	using BulkLoaderType = BulkLoader<ChildPointerType, NodeTemplate>;
+	using SubtreeType = typename BulkLoaderType::Subtree;
+
+	struct MinimumSeparatingBit {
+		uint16_t mBitIndex;
+		size_t mPosition;
+	};
+
+	size_t mNumberEntries;
+	LeafProvider const & mGetLeaf;
+	//the i-th separating bit index separates the i-th and the (i+1)-th entry
+	std::vector<uint16_t> mSeparatingBitIndexes;
+	size_t mNumberDuplicates;
+	size_t mNumberDescendingPairs;
+	size_t mGrainSize;
+	size_t mNumberMinimumTreeLeaves;
+	//node i has the children 2i and 2i + 1, the leaf of block b is stored at mNumberMinimumTreeLeaves + b
+	std::vector<MinimumSeparatingBit> mMinimumTree;
+
+public:
+	/**
+	 * determines the bits separating each pair of adjacent entries in parallel
+	 *
+	 * @param numberEntries the number of entries to load
+	 * @param getSeparatingBitIndex a function object which returns the index of the first bit in which the keys of the i-th and the (i+1)-th entry differ,
+	 * { @link NO_SEPARATING_BIT_INDEX } in case both keys are equal or { @link DESCENDING_KEYS_SEPARATING_BIT_INDEX } in case the key of the i-th entry is larger
+	 * @param getLeaf a function object which returns the leaf child pointer of the i-th entry
+	 */
+	template<typename SeparatingBitIndexProvider> ParallelBulkLoader(
+		size_t numberEntries, SeparatingBitIndexProvider const & getSeparatingBitIndex, LeafProvider const & getLeaf
+	);
+
+	/**
+	 * @return whether the keys of all entries are in ascending order, which is required to load them
+	 */
+	inline bool isSorted() const;
+
+	/**
+	 * loads all entries, which must be sorted (see { @link #isSorted() }). Entries with a key equal to the key of their predecessor are not loaded.
+	 *
+	 * @return the root of the constructed trie or an empty child pointer if there are no entries
+	 */
+	inline ChildPointerType load() const;
+
+	/**
+	 * @return the number of entries which are part of the constructed trie
+	 */
+	inline size_t getNumberLoadedEntries() const;
+
+private:
+	inline SubtreeType loadSubtree(size_t begin, size_t end) const;
+	inline SubtreeType loadSubtreeSequentially(size_t begin, size_t end) const;
+	inline MinimumSeparatingBit findMostSignificantSeparatingBit(size_t begin, size_t end) const;
+	inline MinimumSeparatingBit findMostSignificantSeparatingBitOfBlocks(size_t firstBlock, size_t endBlock) const;
+	inline MinimumSeparatingBit scanForMostSignificantSeparatingBit(size_t firstPosition, size_t endPosition) const;
+	static inline MinimumSeparatingBit getMoreSignificant(MinimumSeparatingBit const & left, MinimumSeparatingBit const & right);
+};
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate, typename LeafProvider>
+template<typename SeparatingBitIndexProvider> ParallelBulkLoader<ChildPointerType, NodeTemplate, LeafProvider>::ParallelBulkLoader(
+	size_t numberEntries, SeparatingBitIndexProvider const & getSeparatingBitIndex, LeafProvider const & getLeaf
+) : mNumberEntries(numberEntries), mGetLeaf(getLeaf), mSeparatingBitIndexes(std::max<size_t>(numberEntries, 1u) - 1u), mNumberDuplicates(0u), mNumberDescendingPairs(0u),
+	mGrainSize(std::max<size_t>(numberEntries / (static_cast<size_t>(tbb::this_task_arena::max_concurrency()) * 16u), PARALLEL_BULK_LOADER_MINIMUM_GRAIN_SIZE)),
+	mNumberMinimumTreeLeaves(1u), mMinimumTree()
+{
+	size_t const numberBlocks = (mSeparatingBitIndexes.size() + PARALLEL_BULK_LOADER_BLOCK_SIZE - 1u) / PARALLEL_BULK_LOADER_BLOCK_SIZE;
+	while(mNumberMinimumTreeLeaves < numberBlocks) {
+		mNumberMinimumTreeLeaves *= 2u;
+	}
+	mMinimumTree.resize(2u * mNumberMinimumTreeLeaves, MinimumSeparatingBit { NO_SEPARATING_BIT_INDEX, 0u });
+
+	//the number of duplicates and the number of pairs in descending order
+	using PairCounts = std::pair<size_t, size_t>;
+	PairCounts const pairCounts = tbb::parallel_reduce(tbb::blocked_range<size_t>(0u, numberBlocks, std::max<size_t>(mGrainSize / PARALLEL_BULK_LOADER_BLOCK_SIZE, 1u)), PairCounts { 0u, 0u },
+		[&](tbb::blocked_range<size_t> const & blocks, PairCounts counts) {
+			for(size_t block = blocks.begin(); block < blocks.end(); ++block) {
+				size_t const blockEnd = std::min((block + 1u) * PARALLEL_BULK_LOADER_BLOCK_SIZE, mSeparatingBitIndexes.size());
+				MinimumSeparatingBit minimum { NO_SEPARATING_BIT_INDEX, block * PARALLEL_BULK_LOADER_BLOCK_SIZE };
+				for(size_t i = block * PARALLEL_BULK_LOADER_BLOCK_SIZE; i < blockEnd; ++i) {
+					uint16_t separatingBitIndex = getSeparatingBitIndex(i);
+					mSeparatingBitIndexes[i] = separatingBitIndex;
+					counts.first += (separatingBitIndex == NO_SEPARATING_BIT_INDEX);
+					counts.second += (separatingBitIndex == DESCENDING_KEYS_SEPARATING_BIT_INDEX);
+					if(separatingBitIndex < minimum.mBitIndex) {
+						minimum = MinimumSeparatingBit { separatingBitIndex, i };
+					}
+				}
+				mMinimumTree[mNumberMinimumTreeLeaves + block] = minimum;
+			}
+			return counts;
+		},
+		[](PairCounts const & left, PairCounts const & right) {
+			return PairCounts { left.first + right.first, left.second + right.second };
+		}
+	);
+	mNumberDuplicates = pairCounts.first;
+	mNumberDescendingPairs = pairCounts.second;
+
+	for(size_t node = mNumberMinimumTreeLeaves - 1u; node > 0u; --node) {
+		mMinimumTree[node] = getMoreSignificant(mMinimumTree[2u * node], mMinimumTree[2u * node + 1u]);
+	}
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate, typename LeafProvider> inline bool ParallelBulkLoader<ChildPointerType, NodeTemplate, LeafProvider>::isSorted() const {
+	return mNumberDescendingPairs == 0u;
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate, typename LeafProvider> inline ChildPointerType ParallelBulkLoader<ChildPointerType, NodeTemplate, LeafProvider>::load() const {
+	assert(isSorted());
+	return (mNumberEntries == 0u) ? ChildPointerType {} : BulkLoaderType::close(loadSubtree(0u, mNumberEntries));
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate, typename LeafProvider> inline size_t ParallelBulkLoader<ChildPointerType, NodeTemplate, LeafProvider>::getNumberLoadedEntries() const {
+	return mNumberEntries - mNumberDuplicates;
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate, typename LeafProvider> inline typename ParallelBulkLoader<ChildPointerType, NodeTemplate, LeafProvider>::SubtreeType
+ParallelBulkLoader<ChildPointerType, NodeTemplate, LeafProvider>::loadSubtree(size_t begin, size_t end) const {
+	if((end - begin) <= mGrainSize) {
+		return loadSubtreeSequentially(begin, end);
+	}
+
+	MinimumSeparatingBit rootBit = findMostSignificantSeparatingBit(begin, end);
+	if(rootBit.mBitIndex == NO_SEPARATING_BIT_INDEX) {
+		//all keys of the range are equal
+		return loadSubtreeSequentially(begin, end);
+	}
+
+	//the root bit separates the entries at position mPosition and mPosition + 1
+	size_t splitPosition = rootBit.mPosition + 1u;
+	SubtreeType left;
+	SubtreeType right;
+	tbb::parallel_invoke(
+		[&]() { left = loadSubtree(begin, splitPosition); },
+		[&]() { right = loadSubtree(splitPosition, end); }
+	);
+
+	BulkLoaderType bulkLoader;
+	bulkLoader.append(left);
+	bulkLoader.append(DiscriminativeBit { rootBit.mBitIndex }, right);
+	return bulkLoader.finishSubtree();
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate, typename LeafProvider> inline typename ParallelBulkLoader<ChildPointerType, NodeTemplate, LeafProvider>::SubtreeType
+ParallelBulkLoader<ChildPointerType, NodeTemplate, LeafProvider>::loadSubtreeSequentially(size_t begin, size_t end) const {
+	BulkLoaderType bulkLoader;
+	bulkLoader.append(mGetLeaf(begin));
+	for(size_t i = begin + 1u; i < end; ++i) {
+		uint16_t separatingBitIndex = mSeparatingBitIndexes[i - 1u];
+		if(separatingBitIndex != NO_SEPARATING_BIT_INDEX) {
+			bulkLoader.append(DiscriminativeBit { separatingBitIndex }, mGetLeaf(i));
+		}
+	}
+	return bulkLoader.finishSubtree();
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate, typename LeafProvider> inline typename ParallelBulkLoader<ChildPointerType, NodeTemplate, LeafProvider>::MinimumSeparatingBit
+ParallelBulkLoader<ChildPointerType, NodeTemplate, LeafProvider>::findMostSignificantSeparatingBit(size_t begin, size_t end) const {
+	//in a range of distinct ordered keys the most significant separating bit is unique
+	size_t const endPosition = end - 1u;
+	size_t const firstCompleteBlock = (begin + PARALLEL_BULK_LOADER_BLOCK_SIZE - 1u) / PARALLEL_BULK_LOADER_BLOCK_SIZE;
+	size_t const endCompleteBlock = endPosition / PARALLEL_BULK_LOADER_BLOCK_SIZE;
+	if(firstCompleteBlock >= endCompleteBlock) {
+		return scanForMostSignificantSeparatingBit(begin, endPosition);
+	}
+
+	MinimumSeparatingBit minimum = scanForMostSignificantSeparatingBit(begin, firstCompleteBlock * PARALLEL_BULK_LOADER_BLOCK_SIZE);
+	minimum = getMoreSignificant(minimum, findMostSignificantSeparatingBitOfBlocks(firstCompleteBlock, endCompleteBlock));
+	return getMoreSignificant(minimum, scanForMostSignificantSeparatingBit(endCompleteBlock * PARALLEL_BULK_LOADER_BLOCK_SIZE, endPosition));
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate, typename LeafProvider> inline typename ParallelBulkLoader<ChildPointerType, NodeTemplate, LeafProvider>::MinimumSeparatingBit
+ParallelBulkLoader<ChildPointerType, NodeTemplate, LeafProvider>::findMostSignificantSeparatingBitOfBlocks(size_t firstBlock, size_t endBlock) const {
+	MinimumSeparatingBit leftMinimum { NO_SEPARATING_BIT_INDEX, 0u };
+	MinimumSeparatingBit rightMinimum { NO_SEPARATING_BIT_INDEX, 0u };
+	for(size_t left = mNumberMinimumTreeLeaves + firstBlock, right = mNumberMinimumTreeLeaves + endBlock; left < right; left /= 2u, right /= 2u) {
+		if(left & 1u) {
+			leftMinimum = getMoreSignificant(leftMinimum, mMinimumTree[left++]);
+		}
+		if(right & 1u) {
+			rightMinimum = getMoreSignificant(mMinimumTree[--right], rightMinimum);
+		}
+	}
+	return getMoreSignificant(leftMinimum, rightMinimum);
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate, typename LeafProvider> inline typename ParallelBulkLoader<ChildPointerType, NodeTemplate, LeafProvider>::MinimumSeparatingBit
+ParallelBulkLoader<ChildPointerType, NodeTemplate, LeafProvider>::scanForMostSignificantSeparatingBit(size_t firstPosition, size_t endPosition) const {
+	MinimumSeparatingBit minimum { NO_SEPARATING_BIT_INDEX, firstPosition };
+	for(size_t i = firstPosition; i < endPosition; ++i) {
+		if(mSeparatingBitIndexes[i] < minimum.mBitIndex) {
+			minimum = MinimumSeparatingBit { mSeparatingBitIndexes[i], i };
+		}
+	}
+	return minimum;
+}
+
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate, typename LeafProvider> inline typename ParallelBulkLoader<ChildPointerType, NodeTemplate, LeafProvider>::MinimumSeparatingBit
+ParallelBulkLoader<ChildPointerType, NodeTemplate, LeafProvider>::getMoreSignificant(MinimumSeparatingBit const & left, MinimumSeparatingBit const & right) {
+	return (right.mBitIndex < left.mBitIndex) ? right : left;
+}
+
+/**
+ * Loads a sequence of leaf entries ordered by their keys in parallel using the TBB task scheduler.
+ * The number of threads used is bounded by the concurrency of the calling thread's task arena.
+ *
+ * @tparam ChildPointerType the type of the child pointers used by the trie
+ * @tparam NodeTemplate the node template of the trie
+ * @param numberEntries the number of entries to load
+ * @param getSeparatingBitIndex a function object which returns the index of the first bit in which the keys of the i-th and the (i+1)-th entry differ,
+ * { @link NO_SEPARATING_BIT_INDEX } in case both keys are equal or { @link DESCENDING_KEYS_SEPARATING_BIT_INDEX } in case the key of the i-th entry is larger
+ * @param getLeaf a function object which returns the leaf child pointer of the i-th entry
+ * @return a pair consisting of the root of the constructed trie and the number of loaded entries. Entries with a key equal to the key of their predecessor are not loaded.
+ * @throws std::invalid_argument if the keys of the entries are not in ascending order. In this case no node is created.
+ */
+template<typename ChildPointerType, template <typename, typename> typename NodeTemplate, typename SeparatingBitIndexProvider, typename LeafProvider> inline std::pair<ChildPointerType, size_t> parallelBulkLoad(
+	size_t numberEntries, SeparatingBitIndexProvider const & getSeparatingBitIndex, LeafProvider const & getLeaf
+) {
+	ParallelBulkLoader<ChildPointerType, NodeTemplate, LeafProvider> bulkLoader { numberEntries, getSeparatingBitIndex, getLeaf };
+	if(!bulkLoader.isSorted()) {
+		throw std::invalid_argument("the entries to bulk load are not sorted in ascending key order");
+	}
+	ChildPointerType root = bulkLoader.load();
+	return { root, bulkLoader.getNumberLoadedEntries() };
+}
+
+}}}
+
+#endif
@@ -1,7 +1,9 @@
 #ifndef __HOT__COMMONS__GENERIC_MASK_CONVERSION_INFORMATION___
 #define __HOT__COMMONS__GENERIC_MASK_CONVERSION_INFORMATION___
 
-namespace hot { namespace commons {
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 template<typename PartialKeyType> struct PartialKeyConversionInformation {
 	PartialKeyType const mAdditionalMask;
@@ -11,6 +13,6 @@ template<typename PartialKeyType> struct PartialKeyConversionInformation {
 	}
 };
 
-} }
+} } }
 
 #endif
\ No newline at end of file
@@ -2,8 +2,32 @@
 #define __HOT__COMMONS__PARTIAL_KEY_MAPPING_BASE_HPP___
 
 #include "hot/commons/DiscriminativeBit.hpp"
+#include "hot/commons/InstructionSet.hpp"
 
-namespace hot { namespace commons {
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+#ifdef USE_LONG_KEYS
+/**
+ * The type used by partial key mappings to store the positions of the key bytes containing discriminative bits.
+ * With long keys discriminative bits may be located behind the first 256 key bytes, hence byte positions require 16 bits.
+ */
+using ExtractionBytePositionType = uint16_t;
+
+/**
+ * The number of leading key bytes which may contain discriminative bits. It is limited by the 16 bit discriminative bit indexes.
+ */
+constexpr size_t NUMBER_ADDRESSABLE_KEY_BYTES = 8192u;
+#else
+/**
+ * The type used by partial key mappings to store the positions of the key bytes containing discriminative bits.
+ */
+using ExtractionBytePositionType = uint8_t;
+
+/**
+ * The number of leading key bytes which may contain discriminative bits.
+ */
+constexpr size_t NUMBER_ADDRESSABLE_KEY_BYTES = 256u;
+#endif
 
 /**
  * A Base class for all partial key mapping informations
@@ -34,6 +58,6 @@ protected:
 	}
 };
 
-} }
+} } }
 
 #endif
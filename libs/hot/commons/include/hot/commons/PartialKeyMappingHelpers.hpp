@@ -2,8 +2,9 @@
 #define __HOT__COMMONS__PARTIAL_KEY_MAPPING_HELPERS__
 
 #include "hot/commons/DiscriminativeBit.hpp"
+#include "hot/commons/InstructionSet.hpp"
 
-namespace hot { namespace commons {
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 
 template<typename DiscriminativeBitsRepresentation, typename PartialKeyType, typename Operation> inline auto extractAndExecuteWithCorrectMaskAndDiscriminativeBitsRepresentation(DiscriminativeBitsRepresentation const & extractionInformation, PartialKeyType compressionMask, Operation const & operation) {
@@ -23,6 +24,6 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType, typ
 
 
 
-}}
+}}}
 
 #endif
\ No newline at end of file
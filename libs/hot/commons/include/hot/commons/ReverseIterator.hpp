@@ -0,0 +1,58 @@
+#ifndef __HOT__COMMONS__REVERSE_ITERATOR__
+#define __HOT__COMMONS__REVERSE_ITERATOR__
+
+#include <utility>
+
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+/**
+ * Adapts a bidirectional trie iterator to traverse the values in descending key order.
+ *
+ * In contrast to std::reverse_iterator, a ReverseIterator refers to the same value as the adapted iterator.
+ * This is required, as the iterators of the tries can not be decremented starting from their end iterator.
+ * Hence the reverse end iterator adapts the end iterator of the trie, which is reached by decrementing an iterator positioned on the smallest value.
+ *
+ * @tparam Iterator the type of the adapted iterator
+ */
+template<typename Iterator> class ReverseIterator {
+	Iterator mIterator;
+
+public:
+	explicit ReverseIterator(Iterator const & iterator) : mIterator(iterator) {
+	}
+
+	inline auto operator*() const -> decltype(*std::declval<Iterator const &>()) {
+		return *mIterator;
+	}
+
+	inline ReverseIterator<Iterator> & operator++() {
+		--mIterator;
+		return *this;
+	}
+
+	inline ReverseIterator<Iterator> & operator--() {
+		++mIterator;
+		return *this;
+	}
+
+	bool operator==(ReverseIterator<Iterator> const & other) const {
+		return mIterator == other.mIterator;
+	}
+
+	bool operator!=(ReverseIterator<Iterator> const & other) const {
+		return mIterator != other.mIterator;
+	}
+
+	/**
+	 * @return the adapted iterator, which is positioned on the same value
+	 */
+	Iterator const & base() const {
+		return mIterator;
+	}
+};
+
+} } }
+
+#endif
@@ -5,7 +5,9 @@
 #include <cstdint>
 #include <immintrin.h>
 
-namespace hot { namespace commons {
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 template<uint numberBits> struct SIMDRegisterTypeMapper {
 };
@@ -18,9 +20,24 @@ template<> struct SIMDRegisterTypeMapper<128u> {
 	using SIMDRegisterType = __m128i;
 };
 
+#ifdef HOT_COMPILED_FOR_AVX2
 template<> struct SIMDRegisterTypeMapper<256u> {
 	using SIMDRegisterType = __m256i;
 };
+#else
+/**
+ * If the code is not compiled for AVX2, 256 bit registers are emulated by a pair of 128 bit registers.
+ * This allows to use the same implementation of multi mask partial key mappings on every x86-64 processor.
+ */
+struct EmulatedSIMDRegister256 {
+	__m128i mLow;
+	__m128i mHigh;
+};
+
+template<> struct SIMDRegisterTypeMapper<256u> {
+	using SIMDRegisterType = EmulatedSIMDRegister256;
+};
+#endif
 
 template<uint numberBits>
 struct SIMDHelper {
@@ -49,6 +66,15 @@ struct SIMDHelper {
 	 */
 	static inline SIMDRegisterType set1_epi8(uint8_t byte);
 
+	/**
+	 * compares packed unsigned 8-bit integers in a and b
+	 *
+	 * @param a first SIMD register
+	 * @param b second SIMD register
+	 * @return for each packaged 8-bit integer the larger of the two values
+	 */
+	static inline SIMDRegisterType max_epu8(SIMDRegisterType a, SIMDRegisterType b);
+
 	/**
 	 * Creates a SIMD-register with all bits beeing set to 0
 	 * @return the newly created SIMD-register
@@ -136,6 +162,10 @@ struct SIMDHelper<64u> {
 		return _mm_set1_pi8(byte);
 	}
 
+	static inline  __attribute__((always_inline)) SIMDRegisterType max_epu8(SIMDRegisterType a, SIMDRegisterType b) {
+		return _mm_max_pu8(a, b);
+	}
+
 	static inline  __attribute__((always_inline)) SIMDRegisterType zero() {
 		return _mm_setzero_si64();
 	}
@@ -196,6 +226,10 @@ struct SIMDHelper<128u> {
 		return _mm_set1_epi8(byte);
 	}
 
+	static inline  __attribute__((always_inline)) SIMDRegisterType max_epu8(SIMDRegisterType a, SIMDRegisterType b) {
+		return _mm_max_epu8(a, b);
+	}
+
 	static inline  __attribute__((always_inline)) SIMDRegisterType zero() {
 		return _mm_setzero_si128();
 	}
@@ -213,11 +247,11 @@ struct SIMDHelper<128u> {
 	}
 
 	static inline  __attribute__((always_inline)) SIMDRegisterType toRegister(std::array<uint64_t, 2u> const &array) {
-		return _mm_lddqu_si128(reinterpret_cast<SIMDRegisterType const *>(array.data()));
+		return _mm_loadu_si128(reinterpret_cast<SIMDRegisterType const *>(array.data()));
 	}
 
 	static inline  __attribute__((always_inline)) SIMDRegisterType toRegister(void const *rawData) {
-		return _mm_lddqu_si128(reinterpret_cast<SIMDRegisterType const *>(rawData));
+		return _mm_loadu_si128(reinterpret_cast<SIMDRegisterType const *>(rawData));
 	}
 
 	static inline  __attribute__((always_inline)) SIMDRegisterType shiftLeftOneByte(SIMDRegisterType a) {
@@ -233,6 +267,7 @@ struct SIMDHelper<128u> {
 	}
 };
 
+#ifdef HOT_COMPILED_FOR_AVX2
 template<>
 struct SIMDHelper<256u> {
 	using SIMDRegisterType = typename SIMDRegisterTypeMapper<256>::SIMDRegisterType;
@@ -254,6 +289,10 @@ struct SIMDHelper<256u> {
 		return _mm256_set1_epi8(byte);
 	}
 
+	static inline  __attribute__((always_inline)) SIMDRegisterType max_epu8(SIMDRegisterType a, SIMDRegisterType b) {
+		return _mm256_max_epu8(a, b);
+	}
+
 	static inline  __attribute__((always_inline)) SIMDRegisterType set1(uint8_t byte) {
 		return _mm256_set1_epi8(byte);
 	}
@@ -319,7 +358,112 @@ struct SIMDHelper<256u> {
 	}
 
 };
+#else
+template<>
+struct SIMDHelper<256u> {
+	using SIMDRegisterType = typename SIMDRegisterTypeMapper<256>::SIMDRegisterType;
+	using HalfHelper = SIMDHelper<128u>;
+
+	static inline  __attribute__((always_inline)) SIMDRegisterType combine(HalfHelper::SIMDRegisterType low, HalfHelper::SIMDRegisterType high) {
+		SIMDRegisterType result;
+		result.mLow = low;
+		result.mHigh = high;
+		return result;
+	}
+
+	static inline  __attribute__((always_inline)) uint32_t moveMask8(SIMDRegisterType inputRegister) {
+		return HalfHelper::moveMask8(inputRegister.mLow) | (HalfHelper::moveMask8(inputRegister.mHigh) << 16);
+	}
+
+	static inline  __attribute__((always_inline)) SIMDRegisterType cmpeq_epi8(SIMDRegisterType a, SIMDRegisterType b) {
+		return combine(HalfHelper::cmpeq_epi8(a.mLow, b.mLow), HalfHelper::cmpeq_epi8(a.mHigh, b.mHigh));
+	}
+
+	static inline  __attribute__((always_inline)) SIMDRegisterType convertWithZeroExtend(HalfHelper::SIMDRegisterType sourceRegister) {
+		return combine(sourceRegister, HalfHelper::zero());
+	}
+
+	static inline  __attribute__((always_inline)) SIMDRegisterType set1_epi8(uint8_t byte) {
+		HalfHelper::SIMDRegisterType half = HalfHelper::set1_epi8(byte);
+		return combine(half, half);
+	}
+
+	static inline  __attribute__((always_inline)) SIMDRegisterType max_epu8(SIMDRegisterType a, SIMDRegisterType b) {
+		return combine(HalfHelper::max_epu8(a.mLow, b.mLow), HalfHelper::max_epu8(a.mHigh, b.mHigh));
+	}
+
+	static inline  __attribute__((always_inline)) SIMDRegisterType set1(uint8_t byte) {
+		return set1_epi8(byte);
+	}
+
+	static inline  __attribute__((always_inline)) SIMDRegisterType set1(uint16_t unsignedShort) {
+		HalfHelper::SIMDRegisterType half = _mm_set1_epi16(unsignedShort);
+		return combine(half, half);
+	}
+
+	static inline  __attribute__((always_inline)) SIMDRegisterType set1(uint32_t unsigneInt) {
+		HalfHelper::SIMDRegisterType half = _mm_set1_epi32(unsigneInt);
+		return combine(half, half);
+	}
+
+	static inline  __attribute__((always_inline)) SIMDRegisterType zero() {
+		return combine(HalfHelper::zero(), HalfHelper::zero());
+	}
+
+	/**
+	*
+	* @return an 256 bit simd register with all bits set
+	*/
+	static inline  __attribute__((always_inline)) SIMDRegisterType maxValue() {
+		SIMDRegisterType zeroRegister = zero();
+		return cmpeq_epi8(zeroRegister, zeroRegister);
+	}
+
+	static inline  __attribute__((always_inline)) SIMDRegisterType binaryAnd(SIMDRegisterType a, SIMDRegisterType b) {
+		return combine(HalfHelper::binaryAnd(a.mLow, b.mLow), HalfHelper::binaryAnd(a.mHigh, b.mHigh));
+	}
+
+	static inline  __attribute__((always_inline)) SIMDRegisterType binaryOr(SIMDRegisterType a, SIMDRegisterType b) {
+		return combine(HalfHelper::binaryOr(a.mLow, b.mLow), HalfHelper::binaryOr(a.mHigh, b.mHigh));
+	}
+
+	static inline  __attribute__((always_inline)) SIMDRegisterType binaryAndNot(SIMDRegisterType a, SIMDRegisterType b) {
+		return combine(HalfHelper::binaryAndNot(a.mLow, b.mLow), HalfHelper::binaryAndNot(a.mHigh, b.mHigh));
+	}
+
+	static inline  __attribute__((always_inline)) SIMDRegisterType toRegister(std::array<uint64_t, 4u> const & array) {
+		return toRegister(array.data());
+	}
+
+	static inline  __attribute__((always_inline)) SIMDRegisterType toRegister(void const * rawData) {
+		return combine(HalfHelper::toRegister(rawData), HalfHelper::toRegister(reinterpret_cast<uint8_t const *>(rawData) + 16));
+	}
+
+	/**
+	 * the most significant byte of the lower half is shifted into the least significant byte of the upper half
+	 *
+	 * @param a the parameter to shift
+	 * @return the shifted SIMD-register
+	 */
+	static inline  __attribute__((always_inline)) SIMDRegisterType shiftLeftOneByte(SIMDRegisterType a) {
+		return combine(
+			HalfHelper::shiftLeftOneByte(a.mLow),
+			HalfHelper::binaryOr(HalfHelper::shiftLeftOneByte(a.mHigh), _mm_bsrli_si128(a.mLow, 15))
+		);
+	}
+
+	static inline  __attribute__((always_inline)) void store(SIMDRegisterType data, std::array<uint64_t, 4u> & array) {
+		store(data, array.data());
+	}
+
+	static inline  __attribute__((always_inline)) void store(SIMDRegisterType data, void* location) {
+		HalfHelper::store(data.mLow, location);
+		HalfHelper::store(data.mHigh, reinterpret_cast<uint8_t*>(location) + 16);
+	}
+
+};
+#endif
 
-}}
+}}}
 
 #endif
\ No newline at end of file
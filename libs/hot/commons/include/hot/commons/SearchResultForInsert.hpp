@@ -3,7 +3,9 @@
 
 #include <cstdint>
 
-namespace hot { namespace commons {
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 /**
  * A Helper Function for storing additional result information:
@@ -27,6 +29,6 @@ struct SearchResultForInsert {
 	}
 };
 
-}}
+}}}
 
 #endif
\ No newline at end of file
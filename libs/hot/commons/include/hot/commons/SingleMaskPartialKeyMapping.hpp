@@ -8,12 +8,14 @@
 
 #include "hot/commons/Algorithms.hpp"
 #include "hot/commons/DiscriminativeBit.hpp"
+#include "hot/commons/ParallelBitOperations.hpp"
 
 #include "hot/commons/PartialKeyMappingBase.hpp"
 #include "hot/commons/SingleMaskPartialKeyMappingInterface.hpp"
 #include "hot/commons/MultiMaskPartialKeyMapping.hpp"
+#include "hot/commons/InstructionSet.hpp"
 
-namespace hot { namespace commons {
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 constexpr uint64_t SUCCESSIVE_EXTRACTION_MASK_WITH_HIGHEST_BIT_SET = 1ul << 63;
 
@@ -21,17 +23,21 @@ inline SingleMaskPartialKeyMapping::SingleMaskPartialKeyMapping(SingleMaskPartia
 	: PartialKeyMappingBase()
 {
 	_mm_storeu_si128(reinterpret_cast<__m128i*>(this), _mm_loadu_si128(reinterpret_cast<__m128i const *>(&src)));
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+	mSuccessiveExtractionEmulation = src.mSuccessiveExtractionEmulation;
+#endif
 }
 
 inline SingleMaskPartialKeyMapping::SingleMaskPartialKeyMapping(DiscriminativeBit const & discriminativeBit)
 	: PartialKeyMappingBase(discriminativeBit.mAbsoluteBitIndex, discriminativeBit.mAbsoluteBitIndex),
 	  mOffsetInBytes(getSuccesiveByteOffsetForMostRightByte(discriminativeBit.mByteIndex)),
 	  mSuccessiveExtractionMask(getSuccessiveMaskForBit(discriminativeBit.mByteIndex, discriminativeBit.mByteRelativeBitIndex)) {
-	assert(mOffsetInBytes < 255);
+	assert(mOffsetInBytes < NUMBER_ADDRESSABLE_KEY_BYTES);
+	initializeExtractionEmulation();
 }
 
 inline SingleMaskPartialKeyMapping::SingleMaskPartialKeyMapping(
-	uint8_t const * extractionBytePositions,
+	ExtractionBytePositionType const * extractionBytePositions,
 	uint8_t const * extractionByteData,
 	uint32_t const extractionBytesUsedMask,
 	uint16_t const mostSignificantBitIndex,
@@ -40,7 +46,8 @@ inline SingleMaskPartialKeyMapping::SingleMaskPartialKeyMapping(
 	mOffsetInBytes(getSuccesiveByteOffsetForLeastSignificantBitIndex(leastSignificantBitIndex)),
 	mSuccessiveExtractionMask(getSuccessiveExtractionMaskFromRandomBytes(extractionBytePositions, extractionByteData, extractionBytesUsedMask, mOffsetInBytes))
 {
-	assert(mOffsetInBytes < 255);
+	assert(mOffsetInBytes < NUMBER_ADDRESSABLE_KEY_BYTES);
+	initializeExtractionEmulation();
 }
 
 
@@ -54,7 +61,8 @@ inline SingleMaskPartialKeyMapping::SingleMaskPartialKeyMapping(
 		| (existing.mSuccessiveExtractionMask >> (convertBytesToBits(mOffsetInBytes - existing.mOffsetInBytes)))
 	)
 {
-	assert(mOffsetInBytes < 255);
+	assert(mOffsetInBytes < NUMBER_ADDRESSABLE_KEY_BYTES);
+	initializeExtractionEmulation();
 }
 
 
@@ -64,12 +72,12 @@ inline SingleMaskPartialKeyMapping::SingleMaskPartialKeyMapping(
 	uint32_t const & maskBitsNeeded
 ) : SingleMaskPartialKeyMapping(existing, existing.getSuccessiveMaskForMask(maskBitsNeeded))
 {
-	assert(_mm_popcnt_u32(maskBitsNeeded) >= 1);
-	assert(mOffsetInBytes < 255);
+	assert(populationCount32(maskBitsNeeded) >= 1);
+	assert(mOffsetInBytes < NUMBER_ADDRESSABLE_KEY_BYTES);
 }
 
 inline uint16_t SingleMaskPartialKeyMapping::calculateNumberBitsUsed() const {
-	return _mm_popcnt_u64(mSuccessiveExtractionMask);
+	return populationCount64(mSuccessiveExtractionMask);
 }
 
 template<typename PartialKeyType> inline PartialKeyType
@@ -105,7 +113,7 @@ template<typename Operation> inline auto SingleMaskPartialKeyMapping::insert(Dis
 }
 
 template<typename Operation> inline auto SingleMaskPartialKeyMapping::extract(uint32_t bitsUsed, Operation const & operation) const {
-	assert(_mm_popcnt_u32(bitsUsed) >= 1);
+	assert(populationCount32(bitsUsed) >= 1);
 	return operation(SingleMaskPartialKeyMapping { *this, bitsUsed } );
 }
 
@@ -139,7 +147,7 @@ inline uint8_t SingleMaskPartialKeyMapping::getExtractionByte(unsigned int byteI
 	return reinterpret_cast<uint8_t const *>(&mSuccessiveExtractionMask)[byteIndex];
 }
 
-inline uint8_t SingleMaskPartialKeyMapping::getExtractionBytePosition(unsigned int byteIndex) const {
+inline ExtractionBytePositionType SingleMaskPartialKeyMapping::getExtractionBytePosition(unsigned int byteIndex) const {
 	return byteIndex + mOffsetInBytes;
 }
 
@@ -152,16 +160,27 @@ inline uint32_t SingleMaskPartialKeyMapping::getMaskFor(DiscriminativeBit const
 }
 
 inline uint32_t SingleMaskPartialKeyMapping::getAllMaskBits() const {
-	return _pext_u64(mSuccessiveExtractionMask, mSuccessiveExtractionMask);
+	return extractMaskFromSuccessiveBytes(mSuccessiveExtractionMask);
 }
 
 inline __attribute__((always_inline)) uint32_t SingleMaskPartialKeyMapping::extractMask(uint8_t const * keyBytes) const {
 	return  extractMaskFromSuccessiveBytes(*reinterpret_cast<uint64_t const*>(keyBytes + mOffsetInBytes));
 }
 
-inline std::array<uint8_t, 256> SingleMaskPartialKeyMapping::createIntermediateKeyWithOnlySignificantBitsSet() const {
-	std::array<uint8_t, 256> intermediateKey;
-	std::memset(intermediateKey.data(), 0, 256);
+inline __attribute__((always_inline)) uint32_t SingleMaskPartialKeyMapping::extractMask(idx::contenthelpers::KeyBytesView const & keyBytes) const {
+	uint64_t successiveBytes = 0u;
+	if(keyBytes.mLength >= mOffsetInBytes + sizeof(successiveBytes)) {
+		successiveBytes = *reinterpret_cast<uint64_t const*>(keyBytes.mBytes + mOffsetInBytes);
+	} else if(keyBytes.mLength > mOffsetInBytes) {
+		//only the bytes within the key are loaded, the remaining bytes stay zero
+		std::memcpy(&successiveBytes, keyBytes.mBytes + mOffsetInBytes, keyBytes.mLength - mOffsetInBytes);
+	}
+	return extractMaskFromSuccessiveBytes(successiveBytes);
+}
+
+inline std::array<uint8_t, NUMBER_ADDRESSABLE_KEY_BYTES> SingleMaskPartialKeyMapping::createIntermediateKeyWithOnlySignificantBitsSet() const {
+	std::array<uint8_t, NUMBER_ADDRESSABLE_KEY_BYTES> intermediateKey;
+	std::memset(intermediateKey.data(), 0, NUMBER_ADDRESSABLE_KEY_BYTES);
 	std::memmove(intermediateKey.data() + mOffsetInBytes, &mSuccessiveExtractionMask, sizeof(mSuccessiveExtractionMask));
 	return intermediateKey;
 };
@@ -175,10 +194,21 @@ inline SingleMaskPartialKeyMapping::SingleMaskPartialKeyMapping(
 	mOffsetInBytes(static_cast<uint32_t>(getSuccesiveByteOffsetForLeastSignificantBitIndex(mLeastSignificantDiscriminativeBitIndex))),
 	mSuccessiveExtractionMask(newExtractionMaskWithSameOffset << (convertBytesToBits(existing.mOffsetInBytes - mOffsetInBytes)))
 {
+	initializeExtractionEmulation();
+}
+
+inline void SingleMaskPartialKeyMapping::initializeExtractionEmulation() {
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+	mSuccessiveExtractionEmulation = ParallelBitOperationsEmulationSteps<uint64_t>(mSuccessiveExtractionMask);
+#endif
 }
 
 inline __attribute__((always_inline)) uint32_t SingleMaskPartialKeyMapping::extractMaskFromSuccessiveBytes(uint64_t const inputMask) const {
-	return static_cast<uint32_t>( _pext_u64(inputMask, mSuccessiveExtractionMask));
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+	return static_cast<uint32_t>(extractBits64(inputMask, mSuccessiveExtractionMask, mSuccessiveExtractionEmulation));
+#else
+	return static_cast<uint32_t>( extractBits64(inputMask, mSuccessiveExtractionMask));
+#endif
 }
 
 inline __m64 SingleMaskPartialKeyMapping::getRegister() const {
@@ -198,7 +228,11 @@ inline uint64_t SingleMaskPartialKeyMapping::getSuccessiveMaskForAbsoluteBitPosi
 }
 
 inline uint64_t SingleMaskPartialKeyMapping::getSuccessiveMaskForMask(uint32_t const mask) const {
-	return _pdep_u64(mask, mSuccessiveExtractionMask);
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+	return depositBits64(mask, mSuccessiveExtractionMask, mSuccessiveExtractionEmulation);
+#else
+	return depositBits64(mask, mSuccessiveExtractionMask);
+#endif
 }
 
 inline uint SingleMaskPartialKeyMapping::getSuccesiveByteOffsetForLeastSignificantBitIndex(uint leastSignificantBitIndex) {
@@ -208,16 +242,16 @@ inline uint SingleMaskPartialKeyMapping::getSuccesiveByteOffsetForLeastSignifica
 inline uint16_t SingleMaskPartialKeyMapping::calculateRelativeMostSignificantBitIndex(uint64_t rawExtractionMask) {
 	assert(rawExtractionMask != 0);
 	uint64_t reverseMask = __builtin_bswap64(rawExtractionMask);
-	return __lzcnt64(reverseMask);
+	return countLeadingZeros64(reverseMask);
 }
 
 inline uint16_t SingleMaskPartialKeyMapping::calculateRelativeLeastSignificantBitIndex(uint64_t rawExtractionMask) {
 	assert(rawExtractionMask != 0);
-	return 63 - __tzcnt_u64(__builtin_bswap64(rawExtractionMask));
+	return 63 - countTrailingZeros64(__builtin_bswap64(rawExtractionMask));
 }
 
 inline uint64_t SingleMaskPartialKeyMapping::getSuccessiveExtractionMaskFromRandomBytes(
-	uint8_t const * extractionBytePositions,
+	ExtractionBytePositionType const * extractionBytePositions,
 	uint8_t const * extractionByteData,
 	uint32_t extractionBytesUsedMask,
 	uint32_t const offsetInBytes
@@ -225,19 +259,19 @@ inline uint64_t SingleMaskPartialKeyMapping::getSuccessiveExtractionMaskFromRand
 	uint64_t successiveExtractionMask = 0ul;
 	uint8_t* successiveExtractionBytes = reinterpret_cast<uint8_t*>(&successiveExtractionMask);
 	while(extractionBytesUsedMask > 0) {
-		uint extractionByteIndex = __tzcnt_u32(extractionBytesUsedMask);
+		uint extractionByteIndex = countTrailingZeros32(extractionBytesUsedMask);
 		uint targetExtractionBytePosition = extractionBytePositions[extractionByteIndex] - offsetInBytes;
 		successiveExtractionBytes[targetExtractionBytePosition] = extractionByteData[extractionByteIndex];
-		extractionBytesUsedMask = _blsr_u32(extractionBytesUsedMask);
+		extractionBytesUsedMask = resetLowestSetBit32(extractionBytesUsedMask);
 	}
 	return successiveExtractionMask;
 }
 
 template<typename PartialKeyType> inline PartialKeyType SingleMaskPartialKeyMapping::getMostSignifikantMaskBit(PartialKeyType mask) const {
 	uint64_t correspondingSuccessiveExtractionMask = getSuccessiveMaskForMask(mask);
-	unsigned int byteShiftOffset = __tzcnt_u64(correspondingSuccessiveExtractionMask) & (~0b111);
+	unsigned int byteShiftOffset = countTrailingZeros64(correspondingSuccessiveExtractionMask) & (~0b111);
 	uint64_t mostSignificantExtractionByteMask = correspondingSuccessiveExtractionMask & (static_cast<uint64_t>(UINT8_MAX) << byteShiftOffset); //pad -> remove relative bit index
-	uint64_t extractionMaskWithOnlyMostSignificanMaskBitSet =  SUCCESSIVE_EXTRACTION_MASK_WITH_HIGHEST_BIT_SET >> _lzcnt_u64(mostSignificantExtractionByteMask);
+	uint64_t extractionMaskWithOnlyMostSignificanMaskBitSet =  SUCCESSIVE_EXTRACTION_MASK_WITH_HIGHEST_BIT_SET >> countLeadingZeros64(mostSignificantExtractionByteMask);
 	return extractMaskFromSuccessiveBytes(extractionMaskWithOnlyMostSignificanMaskBitSet);
 }
 
@@ -253,7 +287,7 @@ inline std::set<uint16_t> SingleMaskPartialKeyMapping::getDiscriminativeBits() c
 		uint isZero = swapedExtractionMask == 0;
 		uint notIsZero = 1 - isZero;
 
-		uint16_t bitIndex = (isZero * 63) + (notIsZero * __lzcnt64(swapedExtractionMask));
+		uint16_t bitIndex = (isZero * 63) + (notIsZero * countLeadingZeros64(swapedExtractionMask));
 		uint64_t extractionBit = (1ul << 63) >> bitIndex;
 		swapedExtractionMask &= (~extractionBit);
 
@@ -263,6 +297,15 @@ inline std::set<uint16_t> SingleMaskPartialKeyMapping::getDiscriminativeBits() c
 	return extractionBits;
 }
 
-} }
+inline bool SingleMaskPartialKeyMapping::isValidForMaximumKeyLength(size_t maximumKeyLength) const {
+	size_t numberAddressableBits = std::min(maximumKeyLength, NUMBER_ADDRESSABLE_KEY_BYTES) * 8u;
+	return mSuccessiveExtractionMask != 0u
+		&& mLeastSignificantDiscriminativeBitIndex < numberAddressableBits
+		&& mOffsetInBytes == getSuccesiveByteOffsetForLeastSignificantBitIndex(mLeastSignificantDiscriminativeBitIndex)
+		&& mMostSignificantDiscriminativeBitIndex == convertBytesToBits(mOffsetInBytes) + calculateRelativeMostSignificantBitIndex(mSuccessiveExtractionMask)
+		&& mLeastSignificantDiscriminativeBitIndex == convertBytesToBits(mOffsetInBytes) + calculateRelativeLeastSignificantBitIndex(mSuccessiveExtractionMask);
+}
+
+} } }
 
 #endif
@@ -2,9 +2,11 @@
 #define __HOT__COMMONS__SINGLE_MASK_PARTIAL_KEY_MAPPING_INTERFACE_HPP___
 
 
+#include "hot/commons/ParallelBitOperations.hpp"
 #include "hot/commons/PartialKeyMappingBase.hpp"
+#include "hot/commons/InstructionSet.hpp"
 
-namespace hot { namespace commons {
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 template<uint numberExtractionMasks> struct MultiMaskPartialKeyMapping;
 
@@ -18,6 +20,12 @@ public:
 private:
 	uint32_t mOffsetInBytes;
 	uint64_t mSuccessiveExtractionMask;
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+	/**
+	 * the emulation steps for mSuccessiveExtractionMask, which are computed whenever the mask is set and therefore not for each extraction
+	 */
+	ParallelBitOperationsEmulationSteps<uint64_t> mSuccessiveExtractionEmulation;
+#endif
 
 public:
 	inline SingleMaskPartialKeyMapping(SingleMaskPartialKeyMapping const &src);
@@ -41,7 +49,7 @@ public:
 	 * @param leastSignificantBitIndex
 	 */
 	inline SingleMaskPartialKeyMapping(
-		uint8_t const* extractionBytePositions,
+		ExtractionBytePositionType const* extractionBytePositions,
 		uint8_t const * extractionByteData,
 		uint32_t const extractionBytesUsedMask,
 		uint16_t const mostSignificantBitIndex,
@@ -139,7 +147,7 @@ public:
 	inline uint32_t getByteOffset() const;
 
 	inline uint8_t getExtractionByte(unsigned int byteIndex) const;
-	inline uint8_t getExtractionBytePosition(unsigned int byteIndex) const;
+	inline ExtractionBytePositionType getExtractionBytePosition(unsigned int byteIndex) const;
 
 	/**
 	 *
@@ -162,16 +170,26 @@ public:
 
 	inline uint32_t extractMask(uint8_t const *keyBytes) const;
 
+	/**
+	 * extracts the partial key of a variable length key in place, treating all bytes following the key's length as zero bytes
+	 *
+	 * @param keyBytes the bytes of the key
+	 * @return the partial key
+	 */
+	inline uint32_t extractMask(idx::contenthelpers::KeyBytesView const & keyBytes) const;
+
 	/**
 	 *
 	 * @return a key which has only those discriminative bits set which are represented by this partial key mapping
 	 */
-	inline std::array<uint8_t, 256> createIntermediateKeyWithOnlySignificantBitsSet() const;
+	inline std::array<uint8_t, NUMBER_ADDRESSABLE_KEY_BYTES> createIntermediateKeyWithOnlySignificantBitsSet() const;
 
 private:
 	//delegating constructor
 	inline SingleMaskPartialKeyMapping(SingleMaskPartialKeyMapping const &existing, uint64_t const newExtractionMaskWithSameOffset);
 
+	inline void initializeExtractionEmulation();
+
 	inline uint32_t extractMaskFromSuccessiveBytes(uint64_t const inputMask) const;
 
 	inline __m64 getRegister() const;
@@ -191,7 +209,7 @@ private:
 	static inline uint16_t calculateRelativeLeastSignificantBitIndex(uint64_t rawExtractionMask);
 
 	static inline uint64_t getSuccessiveExtractionMaskFromRandomBytes(
-		uint8_t const * extractionBytePositions,
+		ExtractionBytePositionType const * extractionBytePositions,
 		uint8_t const * extractionByteData,
 		uint32_t extractionBytesUsedMask,
 		uint32_t const offsetInBytes
@@ -222,8 +240,16 @@ public:
 	 * @return a set of all the discriminative bit positions represnted by this partial key mapping
 	 */
 	inline std::set<uint16_t> getDiscriminativeBits() const;
+
+	/**
+	 * Checks a partial key mapping, which was not created by one of the constructors but restored from a memory image, e.g. while loading a file.
+	 *
+	 * @param maximumKeyLength the maximum length of the keys in bytes
+	 * @return whether the mapping extracts at least one bit, whose byte position is smaller than the maximum key length and whether its offset and its bit indexes are consistent with its mask
+	 */
+	inline bool isValidForMaximumKeyLength(size_t maximumKeyLength) const;
 };
 
-} }
+} } }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,318 @@
+#ifndef __HOT__COMMONS__SLAB_ALLOCATOR__
+#define __HOT__COMMONS__SLAB_ALLOCATOR__
+
+#include <sys/mman.h>
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+
+#include <array>
+#include <mutex>
+#include <new>
+
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+/**
+ * the size and the alignment of a slab. It corresponds to the size of a huge page on x86-64.
+ */
+constexpr size_t SLAB_SIZE = 2u * 1024u * 1024u;
+
+/**
+ * the alignment of all objects allocated from a slab, which corresponds to the size of a cache line
+ */
+constexpr size_t SLAB_OBJECT_ALIGNMENT = 64u;
+
+/**
+ * the number of bytes left unused at the end of each slab.
+ * SIMD searches may read beyond the end of a node and therefore must not reach into an unmapped page.
+ */
+constexpr size_t SLAB_TRAILING_PADDING = 64u;
+
+/**
+ * determines how the memory of a slab is backed
+ */
+enum class SlabBacking {
+	/**
+	 * regular pages
+	 */
+	REGULAR_PAGES,
+	/**
+	 * regular pages which are marked using madvise(MADV_HUGEPAGE) to be backed by transparent huge pages
+	 */
+	TRANSPARENT_HUGE_PAGES,
+	/**
+	 * explicitly reserved huge pages using MAP_HUGETLB. In case no huge page is available, transparent huge pages are used instead.
+	 */
+	HUGETLB_PAGES
+};
+
+/**
+ * A SlabAllocator serves fixed size objects aligned to cache line boundaries.
+ *
+ * Object sizes are rounded up to multiples of { @link SLAB_OBJECT_ALIGNMENT } and each resulting size class carves its objects out of separate slabs.
+ * Each slab is a { @link SLAB_SIZE } sized and aligned memory region directly requested from the operating system.
+ * Its header is stored at the beginning of the slab, which allows to determine the slab of an object by its address only.
+ * Slabs which do not contain any objects anymore are returned to the operating system,
+ * except for a single slab per size class which is retained to prevent repeatedly mapping and unmapping a slab.
+ *
+ * All operations are thread safe. Each size class is protected by its own lock.
+ *
+ * @tparam MAXIMUM_OBJECT_SIZE the maximum size of an object in bytes
+ */
+template<size_t MAXIMUM_OBJECT_SIZE> class SlabAllocator {
+	static constexpr size_t NUMBER_SIZE_CLASSES = (MAXIMUM_OBJECT_SIZE + SLAB_OBJECT_ALIGNMENT - 1u) / SLAB_OBJECT_ALIGNMENT;
+
+	struct FreeObject {
+		FreeObject* mNext;
+	};
+
+	struct SizeClass;
+
+	struct alignas(SLAB_OBJECT_ALIGNMENT) Slab {
+		SizeClass* const mSizeClass;
+		FreeObject* mFreeObjects;
+		char* mUnusedBegin;
+		char* const mEnd;
+		Slab* mPrevious;
+		Slab* mNext;
+		uint32_t mNumberUsedObjects;
+
+		inline Slab(SizeClass* sizeClass);
+
+		inline bool isFull() const;
+		inline bool isEmpty() const;
+		inline void* allocate();
+		inline void release(void* object);
+	};
+
+	struct SizeClass {
+		std::mutex mLock;
+		size_t const mObjectSize;
+		//all slabs of this size class which have unused space
+		Slab* mAvailableSlabs;
+		size_t mNumberSlabs;
+
+		inline SizeClass(size_t objectSize);
+		inline void pushAvailableSlab(Slab* slab);
+		inline void removeAvailableSlab(Slab* slab);
+	};
+
+	static_assert(sizeof(Slab) == SLAB_OBJECT_ALIGNMENT, "the slab header must fit into a single cache line");
+
+	SlabBacking const mBacking;
+	std::array<SizeClass*, NUMBER_SIZE_CLASSES> mSizeClasses;
+
+public:
+	/**
+	 * @param backing determines how the memory of the slabs is backed
+	 */
+	inline SlabAllocator(SlabBacking backing = SlabBacking::TRANSPARENT_HUGE_PAGES);
+	SlabAllocator(SlabAllocator const & other) = delete;
+	SlabAllocator& operator=(SlabAllocator const & other) = delete;
+
+	/**
+	 * returns all slabs to the operating system. All objects allocated from this allocator become invalid.
+	 */
+	inline ~SlabAllocator();
+
+	/**
+	 * @param sizeInBytes the size of the object to allocate. It must not exceed MAXIMUM_OBJECT_SIZE
+	 * @return a pointer to an object of at least the given size aligned to { @link SLAB_OBJECT_ALIGNMENT }
+	 */
+	inline void* allocate(size_t sizeInBytes);
+
+	/**
+	 * returns an object to the slab it was allocated from
+	 *
+	 * @param object a pointer to an object previously allocated from this allocator
+	 */
+	inline void release(void* object);
+
+	/**
+	 * @return the number of slabs currently mapped by this allocator
+	 */
+	inline size_t getNumberSlabs();
+
+private:
+	inline Slab* mapSlab(SizeClass* sizeClass);
+	inline void unmapSlab(Slab* slab);
+	static inline size_t sizeToSizeClassIndex(size_t sizeInBytes);
+};
+
+template<size_t MAXIMUM_OBJECT_SIZE> inline SlabAllocator<MAXIMUM_OBJECT_SIZE>::Slab::Slab(SizeClass* sizeClass)
+	: mSizeClass(sizeClass), mFreeObjects(nullptr), mUnusedBegin(reinterpret_cast<char*>(this) + sizeof(Slab)),
+	  mEnd(reinterpret_cast<char*>(this) + SLAB_SIZE - SLAB_TRAILING_PADDING), mPrevious(nullptr), mNext(nullptr), mNumberUsedObjects(0u)
+{
+}
+
+template<size_t MAXIMUM_OBJECT_SIZE> inline bool SlabAllocator<MAXIMUM_OBJECT_SIZE>::Slab::isFull() const {
+	return (mFreeObjects == nullptr) & ((mUnusedBegin + mSizeClass->mObjectSize) > mEnd);
+}
+
+template<size_t MAXIMUM_OBJECT_SIZE> inline bool SlabAllocator<MAXIMUM_OBJECT_SIZE>::Slab::isEmpty() const {
+	return mNumberUsedObjects == 0u;
+}
+
+template<size_t MAXIMUM_OBJECT_SIZE> inline void* SlabAllocator<MAXIMUM_OBJECT_SIZE>::Slab::allocate() {
+	assert(!isFull());
+	void* object;
+	if(mFreeObjects != nullptr) {
+		object = mFreeObjects;
+		mFreeObjects = mFreeObjects->mNext;
+	} else {
+		//objects are carved out of the untouched part of the slab on demand, to not touch pages which are never used
+		object = mUnusedBegin;
+		mUnusedBegin += mSizeClass->mObjectSize;
+	}
+	++mNumberUsedObjects;
+	return object;
+}
+
+template<size_t MAXIMUM_OBJECT_SIZE> inline void SlabAllocator<MAXIMUM_OBJECT_SIZE>::Slab::release(void* object) {
+	assert(mNumberUsedObjects > 0u);
+	FreeObject* freeObject = reinterpret_cast<FreeObject*>(object);
+	freeObject->mNext = mFreeObjects;
+	mFreeObjects = freeObject;
+	--mNumberUsedObjects;
+}
+
+template<size_t MAXIMUM_OBJECT_SIZE> inline SlabAllocator<MAXIMUM_OBJECT_SIZE>::SizeClass::SizeClass(size_t objectSize)
+	: mLock(), mObjectSize(objectSize), mAvailableSlabs(nullptr), mNumberSlabs(0u)
+{
+}
+
+template<size_t MAXIMUM_OBJECT_SIZE> inline void SlabAllocator<MAXIMUM_OBJECT_SIZE>::SizeClass::pushAvailableSlab(Slab* slab) {
+	slab->mPrevious = nullptr;
+	slab->mNext = mAvailableSlabs;
+	if(mAvailableSlabs != nullptr) {
+		mAvailableSlabs->mPrevious = slab;
+	}
+	mAvailableSlabs = slab;
+}
+
+template<size_t MAXIMUM_OBJECT_SIZE> inline void SlabAllocator<MAXIMUM_OBJECT_SIZE>::SizeClass::removeAvailableSlab(Slab* slab) {
+	if(slab->mPrevious != nullptr) {
+		slab->mPrevious->mNext = slab->mNext;
+	} else {
+		mAvailableSlabs = slab->mNext;
+	}
+	if(slab->mNext != nullptr) {
+		slab->mNext->mPrevious = slab->mPrevious;
+	}
+	slab->mPrevious = nullptr;
+	slab->mNext = nullptr;
+}
+
+template<size_t MAXIMUM_OBJECT_SIZE> inline SlabAllocator<MAXIMUM_OBJECT_SIZE>::SlabAllocator(SlabBacking backing) : mBacking(backing) {
+	for(size_t sizeClassIndex = 0u; sizeClassIndex < NUMBER_SIZE_CLASSES; ++sizeClassIndex) {
+		mSizeClasses[sizeClassIndex] = new SizeClass((sizeClassIndex + 1u) * SLAB_OBJECT_ALIGNMENT);
+	}
+}
+
+template<size_t MAXIMUM_OBJECT_SIZE> inline SlabAllocator<MAXIMUM_OBJECT_SIZE>::~SlabAllocator() {
+	for(SizeClass* sizeClass : mSizeClasses) {
+		//full slabs are not linked and can therefore not be released. Objects must be released before the allocator is destroyed
+		while(sizeClass->mAvailableSlabs != nullptr) {
+			Slab* slab = sizeClass->mAvailableSlabs;
+			sizeClass->removeAvailableSlab(slab);
+			unmapSlab(slab);
+		}
+		delete sizeClass;
+	}
+}
+
+template<size_t MAXIMUM_OBJECT_SIZE> inline void* SlabAllocator<MAXIMUM_OBJECT_SIZE>::allocate(size_t sizeInBytes) {
+	SizeClass* sizeClass = mSizeClasses[sizeToSizeClassIndex(sizeInBytes)];
+	std::lock_guard<std::mutex> lock(sizeClass->mLock);
+
+	Slab* slab = sizeClass->mAvailableSlabs;
+	if(slab == nullptr) {
+		slab = mapSlab(sizeClass);
+		sizeClass->pushAvailableSlab(slab);
+	}
+
+	void* object = slab->allocate();
+	if(slab->isFull()) {
+		sizeClass->removeAvailableSlab(slab);
+	}
+	return object;
+}
+
+template<size_t MAXIMUM_OBJECT_SIZE> inline void SlabAllocator<MAXIMUM_OBJECT_SIZE>::release(void* object) {
+	Slab* slab = reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(object) & ~(static_cast<uintptr_t>(SLAB_SIZE) - 1u));
+	SizeClass* sizeClass = slab->mSizeClass;
+	std::lock_guard<std::mutex> lock(sizeClass->mLock);
+
+	bool wasFull = slab->isFull();
+	slab->release(object);
+	if(wasFull) {
+		sizeClass->pushAvailableSlab(slab);
+	}
+
+	//an empty slab is only retained if it is the only slab of its size class with unused space
+	bool isOnlyAvailableSlab = (sizeClass->mAvailableSlabs == slab) & (slab->mNext == nullptr);
+	if(slab->isEmpty() & !isOnlyAvailableSlab) {
+		sizeClass->removeAvailableSlab(slab);
+		unmapSlab(slab);
+	}
+}
+
+template<size_t MAXIMUM_OBJECT_SIZE> inline size_t SlabAllocator<MAXIMUM_OBJECT_SIZE>::getNumberSlabs() {
+	size_t numberSlabs = 0u;
+	for(SizeClass* sizeClass : mSizeClasses) {
+		std::lock_guard<std::mutex> lock(sizeClass->mLock);
+		numberSlabs += sizeClass->mNumberSlabs;
+	}
+	return numberSlabs;
+}
+
+template<size_t MAXIMUM_OBJECT_SIZE> inline typename SlabAllocator<MAXIMUM_OBJECT_SIZE>::Slab* SlabAllocator<MAXIMUM_OBJECT_SIZE>::mapSlab(SizeClass* sizeClass) {
+	void* memory = MAP_FAILED;
+#ifdef MAP_HUGETLB
+	if(mBacking == SlabBacking::HUGETLB_PAGES) {
+		//huge page mappings are always aligned to the huge page size
+		memory = mmap(nullptr, SLAB_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	}
+#endif
+	if(memory == MAP_FAILED) {
+		//over allocate to be able to align the slab to its size and unmap the unaligned parts afterwards
+		char* unalignedMemory = reinterpret_cast<char*>(mmap(nullptr, 2u * SLAB_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+		if(unalignedMemory == MAP_FAILED) {
+			throw std::bad_alloc();
+		}
+		uintptr_t unalignedAddress = reinterpret_cast<uintptr_t>(unalignedMemory);
+		char* alignedMemory = reinterpret_cast<char*>((unalignedAddress + SLAB_SIZE - 1u) & ~(static_cast<uintptr_t>(SLAB_SIZE) - 1u));
+		size_t leadingSize = static_cast<size_t>(alignedMemory - unalignedMemory);
+		if(leadingSize > 0u) {
+			munmap(unalignedMemory, leadingSize);
+		}
+		munmap(alignedMemory + SLAB_SIZE, SLAB_SIZE - leadingSize);
+		memory = alignedMemory;
+#ifdef MADV_HUGEPAGE
+		if(mBacking != SlabBacking::REGULAR_PAGES) {
+			madvise(memory, SLAB_SIZE, MADV_HUGEPAGE);
+		}
+#endif
+	}
+
+	++sizeClass->mNumberSlabs;
+	return new (memory) Slab(sizeClass);
+}
+
+template<size_t MAXIMUM_OBJECT_SIZE> inline void SlabAllocator<MAXIMUM_OBJECT_SIZE>::unmapSlab(Slab* slab) {
+	--slab->mSizeClass->mNumberSlabs;
+	munmap(slab, SLAB_SIZE);
+}
+
+template<size_t MAXIMUM_OBJECT_SIZE> inline size_t SlabAllocator<MAXIMUM_OBJECT_SIZE>::sizeToSizeClassIndex(size_t sizeInBytes) {
+	assert(sizeInBytes > 0u);
+	assert(sizeInBytes <= MAXIMUM_OBJECT_SIZE);
+	return (sizeInBytes - 1u) / SLAB_OBJECT_ALIGNMENT;
+}
+
+} } }
+
+#endif
@@ -8,8 +8,9 @@
 #include <cstdint>
 
 #include <hot/commons/Algorithms.hpp>
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace commons {
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 constexpr uint16_t alignToNextHighestValueDivisableBy8(uint16_t size) {
 	return static_cast<uint16_t>((size % 8 == 0) ? size : ((size & (~7)) + 8));
@@ -75,15 +76,33 @@ struct alignas(8) SparsePartialKeys {
 	 * @return the resulting mask with each bit representing the result of a single compressed mask. bit 0 (least significant) correspond to the mask 0, bit 1 corresponds to mask 1 and so forth.
 	 */
 	inline uint32_t findMasksByPattern(PartialKeyType const partialKeyPattern) const {
-		__m256i searchRegister = broadcastToSIMDRegister(partialKeyPattern);
-
-		return findMasksByPattern(searchRegister, searchRegister);
+		return findMasksByPattern(partialKeyPattern, partialKeyPattern);
 	}
 
-private:
-	inline uint32_t findMasksByPattern(__m256i const usedBitsMask, __m256i const expectedBitsMask) const;
+	/**
+	 * Determines all sparse partial keys which have the expected values for the considered bits: sparsePartialKey[i] & consideredBits == expectedBits
+	 *
+	 * @param consideredBits the bits of the sparse partial keys to compare
+	 * @param expectedBits the values of the considered bits
+	 * @return the resulting mask with each bit representing the result of a single compressed mask. bit 0 (least significant) correspond to the mask 0, bit 1 corresponds to mask 1 and so forth.
+	 */
+	inline uint32_t findMasksByPattern(PartialKeyType const consideredBits, PartialKeyType const expectedBits) const;
 
-	inline __m256i broadcastToSIMDRegister(PartialKeyType const mask) const;
+	/**
+	 * The implementation of search for a specific instruction set, which must only be called on processors supporting it.
+	 * The search method itself uses the implementation for the instruction set the code is compiled for.
+	 *
+	 * @tparam instructionSet the instruction set to implement the search with
+	 */
+	template<InstructionSet instructionSet> inline uint32_t search(PartialKeyType const densePartialSearchKey) const;
+
+	/**
+	 * The implementation of findMasksByPattern for a specific instruction set, which must only be called on processors supporting it.
+	 * The findMasksByPattern method itself uses the implementation for the instruction set the code is compiled for.
+	 *
+	 * @tparam instructionSet the instruction set to implement findMasksByPattern with
+	 */
+	template<InstructionSet instructionSet> inline uint32_t findMasksByPattern(PartialKeyType const consideredBits, PartialKeyType const expectedBits) const;
 
 public:
 
@@ -96,15 +115,7 @@ public:
 	 * @return a resulting bit mask with each bit represent whether the corresponding entry is part of the requested subtree or not.
 	 */
 	inline uint32_t getAffectedSubtreeMask(PartialKeyType usedPrefixBitsPattern, PartialKeyType const expectedPrefixBits) const {
-		//assumed this should be the same as
-		//affectedMaskBitsRegister = broadcastToSIMDRegister(affectedBitsMask)
-		//expectedMaskBitsRegister = broadcastToSIMDRegister(expectedMaskBits)
-		//return findMasksByPattern(affectedMaskBitsRegister, expectedMaskBitsRegister) & usedEntriesMask;
-
-		__m256i prefixBITSSIMDMask = broadcastToSIMDRegister(usedPrefixBitsPattern);
-		__m256i prefixMask = broadcastToSIMDRegister(expectedPrefixBits);
-
-		unsigned int affectedSubtreeMask = findMasksByPattern(prefixBITSSIMDMask, prefixMask);
+		unsigned int affectedSubtreeMask = findMasksByPattern(usedPrefixBitsPattern, expectedPrefixBits);
 
 		//uint affectedSubtreeMask = findMasksByPattern(mEntries[entryIndex] & subtreePrefixMask) & usedEntriesMask;
 		//at least the zero mask must match
@@ -197,8 +208,8 @@ public:
 		return relevantBitsInFirstPart | relevantBitsInSecondPart;
 	}
 
-	static inline uint16_t estimateSize(uint16_t numberEntries) {
-		return alignToNextHighestValueDivisableBy8(numberEntries * sizeof(PartialKeyType));
+	static constexpr uint16_t estimateSize(uint16_t numberEntries) {
+		return alignToNextHighestValueDivisableBy8(static_cast<uint16_t>(numberEntries * sizeof(PartialKeyType)));
 	}
 
 	/**
@@ -206,7 +217,7 @@ public:
 	 */
 	inline void printMasks(uint32_t maskOfEntriesToPrint, std::map<uint16_t, uint16_t> const & maskBitMapping, std::ostream & outputStream = std::cout) const {
 		while(maskOfEntriesToPrint > 0) {
-			uint entryIndex = __tzcnt_u32(maskOfEntriesToPrint);
+			uint entryIndex = __builtin_ctz(maskOfEntriesToPrint);
 			std::bitset<sizeof(PartialKeyType) * 8> maskBits(mEntries[entryIndex]);
 			outputStream << "mask[" << entryIndex << "] = \toriginal: " << maskBits << "\tmapped: ";
 			printMaskWithMapping(mEntries[entryIndex], maskBitMapping, outputStream);
@@ -226,7 +237,7 @@ public:
 
 	inline void printMasks(uint32_t maskOfEntriesToPrint, std::ostream & outputStream = std::cout) const {
 		while(maskOfEntriesToPrint > 0) {
-			uint entryIndex = __tzcnt_u32(maskOfEntriesToPrint);
+			uint entryIndex = __builtin_ctz(maskOfEntriesToPrint);
 
 			std::bitset<sizeof(PartialKeyType) * 8> maskBits(mEntries[entryIndex]);
 			outputStream << "mask[" << entryIndex << "] = " << maskBits << std::endl;
@@ -256,27 +267,99 @@ template<typename PartialKeyType> void SparsePartialKeys<PartialKeyType>::operat
 	delete [] masks;
 }
 
-template<>
-inline __attribute__((always_inline)) uint32_t SparsePartialKeys<uint8_t>::search(uint8_t const uncompressedSearchMask) const {
+template<typename PartialKeyType> inline __attribute__((always_inline)) uint32_t SparsePartialKeys<PartialKeyType>::search(PartialKeyType const densePartialSearchKey) const {
+	if(isCompiledFor(InstructionSet::AVX512)) {
+		return search<InstructionSet::AVX512>(densePartialSearchKey);
+	} else if(isCompiledFor(InstructionSet::AVX2)) {
+		return search<InstructionSet::AVX2>(densePartialSearchKey);
+	} else {
+		return search<InstructionSet::SSE2>(densePartialSearchKey);
+	}
+}
+
+template<typename PartialKeyType> inline __attribute__((always_inline)) uint32_t SparsePartialKeys<PartialKeyType>::findMasksByPattern(PartialKeyType const consideredBits, PartialKeyType const expectedBits) const {
+	if(isCompiledFor(InstructionSet::AVX512)) {
+		return findMasksByPattern<InstructionSet::AVX512>(consideredBits, expectedBits);
+	} else if(isCompiledFor(InstructionSet::AVX2)) {
+		return findMasksByPattern<InstructionSet::AVX2>(consideredBits, expectedBits);
+	} else {
+		return findMasksByPattern<InstructionSet::SSE2>(consideredBits, expectedBits);
+	}
+}
+
+template<typename PartialKeyType> template<InstructionSet instructionSet> inline uint32_t SparsePartialKeys<PartialKeyType>::search(PartialKeyType const densePartialSearchKey) const {
+	//a sparse partial key complies to the search key if it has no bit set, which is not set in the search key
+	return findMasksByPattern<instructionSet>(static_cast<PartialKeyType>(~densePartialSearchKey), static_cast<PartialKeyType>(0u));
+}
+
+template<> template<>
+inline uint32_t SparsePartialKeys<uint8_t>::findMasksByPattern<InstructionSet::SSE2>(uint8_t const consideredBits, uint8_t const expectedBits) const {
+	__m128i consideredBitsRegister = _mm_set1_epi8(static_cast<char>(consideredBits));
+	__m128i expectedBitsRegister = _mm_set1_epi8(static_cast<char>(expectedBits));
+
+	__m128i haystack1 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(mEntries));
+	__m128i haystack2 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(mEntries + 16));
+
+	uint32_t searchResult1 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(haystack1, consideredBitsRegister), expectedBitsRegister)));
+	uint32_t searchResult2 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(haystack2, consideredBitsRegister), expectedBitsRegister)));
+
+	return searchResult1 | (searchResult2 << 16);
+}
+
+template<> template<>
+inline uint32_t SparsePartialKeys<uint16_t>::findMasksByPattern<InstructionSet::SSE2>(uint16_t const consideredBits, uint16_t const expectedBits) const {
+	__m128i consideredBitsRegister = _mm_set1_epi16(static_cast<short>(consideredBits));
+	__m128i expectedBitsRegister = _mm_set1_epi16(static_cast<short>(expectedBits));
+
+	uint32_t resultMask = 0u;
+	for(size_t i = 0u; i < 2u; ++i) {
+		__m128i haystack1 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(mEntries + i * 16u));
+		__m128i haystack2 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(mEntries + i * 16u + 8u));
+
+		__m128i searchResult1 = _mm_cmpeq_epi16(_mm_and_si128(haystack1, consideredBitsRegister), expectedBitsRegister);
+		__m128i searchResult2 = _mm_cmpeq_epi16(_mm_and_si128(haystack2, consideredBitsRegister), expectedBitsRegister);
+
+		//packing with signed saturation preserves the 0 and -1 results of the comparison
+		resultMask |= static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(searchResult1, searchResult2))) << (i * 16u);
+	}
+	return resultMask;
+}
+
+template<> template<>
+inline uint32_t SparsePartialKeys<uint32_t>::findMasksByPattern<InstructionSet::SSE2>(uint32_t const consideredBits, uint32_t const expectedBits) const {
+	__m128i consideredBitsRegister = _mm_set1_epi32(static_cast<int>(consideredBits));
+	__m128i expectedBitsRegister = _mm_set1_epi32(static_cast<int>(expectedBits));
+
+	uint32_t resultMask = 0u;
+	for(size_t i = 0u; i < 2u; ++i) {
+		__m128i haystack1 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(mEntries + i * 16u));
+		__m128i haystack2 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(mEntries + i * 16u + 4u));
+		__m128i haystack3 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(mEntries + i * 16u + 8u));
+		__m128i haystack4 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(mEntries + i * 16u + 12u));
+
+		__m128i searchResult1 = _mm_cmpeq_epi32(_mm_and_si128(haystack1, consideredBitsRegister), expectedBitsRegister);
+		__m128i searchResult2 = _mm_cmpeq_epi32(_mm_and_si128(haystack2, consideredBitsRegister), expectedBitsRegister);
+		__m128i searchResult3 = _mm_cmpeq_epi32(_mm_and_si128(haystack3, consideredBitsRegister), expectedBitsRegister);
+		__m128i searchResult4 = _mm_cmpeq_epi32(_mm_and_si128(haystack4, consideredBitsRegister), expectedBitsRegister);
+
+		__m128i intermediateResult = _mm_packs_epi16(_mm_packs_epi32(searchResult1, searchResult2), _mm_packs_epi32(searchResult3, searchResult4));
+		resultMask |= static_cast<uint32_t>(_mm_movemask_epi8(intermediateResult)) << (i * 16u);
+	}
+	return resultMask;
+}
+
+template<> template<>
+HOT_AVX2_FUNCTION uint32_t SparsePartialKeys<uint8_t>::search<InstructionSet::AVX2>(uint8_t const uncompressedSearchMask) const {
 	__m256i searchRegister = _mm256_set1_epi8(uncompressedSearchMask); //2 instr
 
 	__m256i haystack = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(mEntries)); //3 instr
-#ifdef USE_AVX512
-	uint32_t const resultMask = _mm256_cmpeq_epi8_mask (_mm256_and_si256(haystack, searchRegister), haystack);
-#else
 	__m256i searchResult = _mm256_cmpeq_epi8(_mm256_and_si256(haystack, searchRegister), haystack);
 	uint32_t const resultMask = static_cast<uint32_t>(_mm256_movemask_epi8(searchResult));
-#endif
 	return resultMask;
 }
 
-template<>
-inline __attribute__((always_inline)) uint32_t SparsePartialKeys<uint16_t>::search(uint16_t const uncompressedSearchMask) const {
-#ifdef USE_AVX512
-	__m512i searchRegister = _mm512_set1_epi16(uncompressedSearchMask); //2 instr
-	__m512i haystack = _mm512_loadu_si512(reinterpret_cast<__m512i const *>(mEntries)); //3 instr
-	return static_cast<uint32_t>(_mm512_cmpeq_epi16_mask(_mm512_and_si512(haystack, searchRegister), haystack));
-#else
+template<> template<>
+HOT_AVX2_FUNCTION uint32_t SparsePartialKeys<uint16_t>::search<InstructionSet::AVX2>(uint16_t const uncompressedSearchMask) const {
 	__m256i searchRegister = _mm256_set1_epi16(uncompressedSearchMask); //2 instr
 
 	__m256i haystack1 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(mEntries)); //3 instr
@@ -292,11 +375,10 @@ inline __attribute__((always_inline)) uint32_t SparsePartialKeys<uint16_t>::sear
 	), perm_mask);
 
 	return static_cast<uint32_t>(_mm256_movemask_epi8(intermediateResult));
-#endif
 }
 
-template<>
-inline __attribute__((always_inline)) uint32_t SparsePartialKeys<uint32_t>::search(uint32_t const uncompressedSearchMask) const {
+template<> template<>
+HOT_AVX2_FUNCTION uint32_t SparsePartialKeys<uint32_t>::search<InstructionSet::AVX2>(uint32_t const uncompressedSearchMask) const {
 	__m256i searchRegister = _mm256_set1_epi32(uncompressedSearchMask); //2 instr
 
 	__m256i haystack1 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(mEntries));
@@ -319,15 +401,21 @@ inline __attribute__((always_inline)) uint32_t SparsePartialKeys<uint32_t>::sear
 	return static_cast<uint32_t>(_mm256_movemask_epi8(intermediateResult));
 }
 
-template<>
-inline uint32_t SparsePartialKeys<uint8_t>::findMasksByPattern(__m256i consideredBitsRegister, __m256i expectedBitsRegister) const {
+template<> template<>
+HOT_AVX2_FUNCTION uint32_t SparsePartialKeys<uint8_t>::findMasksByPattern<InstructionSet::AVX2>(uint8_t const consideredBits, uint8_t const expectedBits) const {
+	__m256i consideredBitsRegister = _mm256_set1_epi8(consideredBits);
+	__m256i expectedBitsRegister = _mm256_set1_epi8(expectedBits);
+
 	__m256i haystack = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(mEntries)); //3 instr
 	__m256i searchResult = _mm256_cmpeq_epi8(_mm256_and_si256(haystack, consideredBitsRegister), expectedBitsRegister);
 	return static_cast<uint32_t>(_mm256_movemask_epi8(searchResult));
 }
 
-template<>
-inline uint32_t SparsePartialKeys<uint16_t>::findMasksByPattern(__m256i consideredBitsRegister, __m256i expectedBitsRegister) const {
+template<> template<>
+HOT_AVX2_FUNCTION uint32_t SparsePartialKeys<uint16_t>::findMasksByPattern<InstructionSet::AVX2>(uint16_t const consideredBits, uint16_t const expectedBits) const {
+	__m256i consideredBitsRegister = _mm256_set1_epi16(consideredBits);
+	__m256i expectedBitsRegister = _mm256_set1_epi16(expectedBits);
+
 	__m256i haystack1 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(mEntries)); //3 instr
 	__m256i haystack2 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(mEntries + 16)); //4 instr
 
@@ -343,8 +431,11 @@ inline uint32_t SparsePartialKeys<uint16_t>::findMasksByPattern(__m256i consider
 	return static_cast<uint32_t>(_mm256_movemask_epi8(intermediateResult));
 }
 
-template<>
-inline uint32_t SparsePartialKeys<uint32_t>::findMasksByPattern(__m256i consideredBitsRegister, __m256i expectedBitsRegister) const {
+template<> template<>
+HOT_AVX2_FUNCTION uint32_t SparsePartialKeys<uint32_t>::findMasksByPattern<InstructionSet::AVX2>(uint32_t const consideredBits, uint32_t const expectedBits) const {
+	__m256i consideredBitsRegister = _mm256_set1_epi32(consideredBits);
+	__m256i expectedBitsRegister = _mm256_set1_epi32(expectedBits);
+
 	__m256i haystack1 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(mEntries));
 	__m256i haystack2 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(mEntries + 8));
 	__m256i haystack3 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(mEntries + 16));
@@ -365,21 +456,58 @@ inline uint32_t SparsePartialKeys<uint32_t>::findMasksByPattern(__m256i consider
 	return static_cast<uint32_t>(_mm256_movemask_epi8(intermediateResult));
 }
 
-template<>
-inline __m256i SparsePartialKeys<uint8_t>::broadcastToSIMDRegister(uint8_t const mask) const {
-	return _mm256_set1_epi8(mask);
+template<> template<>
+HOT_AVX512_FUNCTION uint32_t SparsePartialKeys<uint8_t>::search<InstructionSet::AVX512>(uint8_t const uncompressedSearchMask) const {
+	//a sparse partial key complies to the search key if it has no bit set, which is not set in the search key
+	__m256i unsetSearchBitsRegister = _mm256_set1_epi8(static_cast<char>(~uncompressedSearchMask));
+	__m256i haystack = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(mEntries));
+	return static_cast<uint32_t>(_mm256_testn_epi8_mask(haystack, unsetSearchBitsRegister));
+}
+
+template<> template<>
+HOT_AVX512_FUNCTION uint32_t SparsePartialKeys<uint16_t>::search<InstructionSet::AVX512>(uint16_t const uncompressedSearchMask) const {
+	__m512i unsetSearchBitsRegister = _mm512_set1_epi16(static_cast<short>(~uncompressedSearchMask));
+	__m512i haystack = _mm512_loadu_si512(mEntries);
+	return static_cast<uint32_t>(_mm512_testn_epi16_mask(haystack, unsetSearchBitsRegister));
+}
+
+template<> template<>
+HOT_AVX512_FUNCTION uint32_t SparsePartialKeys<uint32_t>::search<InstructionSet::AVX512>(uint32_t const uncompressedSearchMask) const {
+	__m512i unsetSearchBitsRegister = _mm512_set1_epi32(static_cast<int>(~uncompressedSearchMask));
+	__m512i haystack1 = _mm512_loadu_si512(mEntries);
+	__m512i haystack2 = _mm512_loadu_si512(mEntries + 16);
+	uint32_t searchResult1 = _mm512_testn_epi32_mask(haystack1, unsetSearchBitsRegister);
+	uint32_t searchResult2 = _mm512_testn_epi32_mask(haystack2, unsetSearchBitsRegister);
+	return searchResult1 | (searchResult2 << 16);
+}
+
+template<> template<>
+HOT_AVX512_FUNCTION uint32_t SparsePartialKeys<uint8_t>::findMasksByPattern<InstructionSet::AVX512>(uint8_t const consideredBits, uint8_t const expectedBits) const {
+	__m256i consideredBitsRegister = _mm256_set1_epi8(static_cast<char>(consideredBits));
+	__m256i expectedBitsRegister = _mm256_set1_epi8(static_cast<char>(expectedBits));
+	__m256i haystack = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(mEntries));
+	return static_cast<uint32_t>(_mm256_cmpeq_epi8_mask(_mm256_and_si256(haystack, consideredBitsRegister), expectedBitsRegister));
 }
 
-template<>
-inline __m256i SparsePartialKeys<uint16_t>::broadcastToSIMDRegister(uint16_t const mask) const {
-	return _mm256_set1_epi16(mask);
+template<> template<>
+HOT_AVX512_FUNCTION uint32_t SparsePartialKeys<uint16_t>::findMasksByPattern<InstructionSet::AVX512>(uint16_t const consideredBits, uint16_t const expectedBits) const {
+	__m512i consideredBitsRegister = _mm512_set1_epi16(static_cast<short>(consideredBits));
+	__m512i expectedBitsRegister = _mm512_set1_epi16(static_cast<short>(expectedBits));
+	__m512i haystack = _mm512_loadu_si512(mEntries);
+	return static_cast<uint32_t>(_mm512_cmpeq_epi16_mask(_mm512_and_si512(haystack, consideredBitsRegister), expectedBitsRegister));
 }
 
-template<>
-inline __m256i SparsePartialKeys<uint32_t>::broadcastToSIMDRegister(uint32_t const mask) const {
-	return _mm256_set1_epi32(mask);
+template<> template<>
+HOT_AVX512_FUNCTION uint32_t SparsePartialKeys<uint32_t>::findMasksByPattern<InstructionSet::AVX512>(uint32_t const consideredBits, uint32_t const expectedBits) const {
+	__m512i consideredBitsRegister = _mm512_set1_epi32(static_cast<int>(consideredBits));
+	__m512i expectedBitsRegister = _mm512_set1_epi32(static_cast<int>(expectedBits));
+	__m512i haystack1 = _mm512_loadu_si512(mEntries);
+	__m512i haystack2 = _mm512_loadu_si512(mEntries + 16);
+	uint32_t searchResult1 = _mm512_cmpeq_epi32_mask(_mm512_and_si512(haystack1, consideredBitsRegister), expectedBitsRegister);
+	uint32_t searchResult2 = _mm512_cmpeq_epi32_mask(_mm512_and_si512(haystack2, consideredBitsRegister), expectedBitsRegister);
+	return searchResult1 | (searchResult2 << 16);
 }
 
-}}
+}}}
 
 #endif
@@ -5,8 +5,9 @@
 
 #include <hot/commons/SingleMaskPartialKeyMapping.hpp>
 #include <hot/commons/BiNode.hpp>
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace commons {
+namespace hot { namespace commons { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 template<typename ChildPointerType, template <typename, typename> typename NodeTemplate> inline NodeTemplate<SingleMaskPartialKeyMapping, uint8_t>* createTwoEntriesNode(BiNode<ChildPointerType> const & binaryNode) {
 	constexpr uint16_t NUMBER_ENTRIES_IN_TWO_ENTRIES_NODE = 2u;
@@ -25,6 +26,6 @@ template<typename ChildPointerType, template <typename, typename> typename NodeT
 	return node;
 };
 
-} }
+} } }
 
 #endif
\ No newline at end of file
@@ -9,9 +9,10 @@
 #include <tbb/enumerable_thread_specific.h>
 
 #include "hot/rowex/ThreadSpecificEpochBasedReclamationInformation.hpp"
+#include "hot/commons/InstructionSet.hpp"
 
 
-namespace hot { namespace rowex {
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 class EpochBasedMemoryReclamationStrategy {
 	static uint32_t NEXT_EPOCH[3];
@@ -60,7 +61,7 @@ public:
 uint32_t EpochBasedMemoryReclamationStrategy::NEXT_EPOCH[3] = { 1, 2, 0 };
 uint32_t EpochBasedMemoryReclamationStrategy::PREVIOUS_EPOCH[3] = { 2, 0, 1 };
 
-} }
+} } }
 
 
 
@@ -5,6 +5,8 @@
 #include <cassert>
 #include <cstdint>
 #include <iostream>
+#include <iterator>
+#include <type_traits>
 #include <utility>
 #include <set>
 #include <map>
@@ -15,6 +17,7 @@
 #include <hot/commons/BiNode.hpp>
 #include <hot/commons/DiscriminativeBit.hpp>
 #include <hot/commons/InsertInformation.hpp>
+#include <hot/commons/ParallelBulkLoader.hpp>
 #include <hot/commons/TwoEntriesNode.hpp>
 
 #include "hot/rowex/HOTRowexChildPointer.hpp"
@@ -32,13 +35,15 @@
 #include "idx/contenthelpers/ContentEquals.hpp"
 #include "idx/contenthelpers/KeyComparator.hpp"
 #include "idx/contenthelpers/OptionalValue.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace rowex {
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 template<typename ValueType, template <typename> typename KeyExtractor> KeyExtractor<ValueType> HOTRowex<ValueType, KeyExtractor>::extractKey;
 template<typename ValueType, template <typename> typename KeyExtractor>
 	typename idx::contenthelpers::KeyComparator<typename  HOTRowex<ValueType, KeyExtractor>::KeyType>::type
 	HOTRowex<ValueType, KeyExtractor>::compareKeys;
+template<typename ValueType, template <typename> typename KeyExtractor> constexpr size_t HOTRowex<ValueType, KeyExtractor>::MAXIMUM_KEY_LENGTH;
 
 template<typename ValueType, template <typename> typename KeyExtractor> HOTRowex<ValueType, KeyExtractor>::HOTRowex() : mRoot {}, mMemoryReclamation(EpochBasedMemoryReclamationStrategy::getInstance()) {
 }
@@ -60,12 +65,12 @@ template<typename ValueType, template <typename> typename KeyExtractor> HOTRowex
 
 template<typename ValueType, template <typename> typename KeyExtractor> inline idx::contenthelpers::OptionalValue<ValueType> HOTRowex<ValueType, KeyExtractor>::lookup(HOTRowex<ValueType, KeyExtractor>::KeyType const &key) const {
 	MemoryGuard memoryGuard(mMemoryReclamation);
-	auto const & fixedSizeKey = idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(key));
-	uint8_t const* byteKey = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
+	auto const & fixedSizeKey = idx::contenthelpers::toByteComparableKey(key);
+	auto byteKey = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
 
 	HOTRowexChildPointer current =  mRoot;
 	while(!current.isLeaf()) {
-		current = *(current.search(byteKey));
+		current = *(current.search<MAXIMUM_KEY_LENGTH>(byteKey));
 	}
 	ValueType const & value = idx::contenthelpers::tidToValue<ValueType>(current.getTid());
 	return { idx::contenthelpers::contentEquals(extractKey(value), key), value };
@@ -80,7 +85,88 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline i
 }
 
 
+template<typename ValueType, template <typename> typename KeyExtractor> template<typename Visitor> inline size_t HOTRowex<ValueType, KeyExtractor>::prefixScan(char const * prefix, size_t prefixLength, Visitor && visitor) const {
+	static_assert(std::is_same<KeyType, char const *>::value, "prefix scans are only supported for c string keys");
+
+	MemoryGuard memoryGuard(mMemoryReclamation);
+	HOTRowexChildPointer currentRoot = mRoot;
+	//no key can start with a prefix which does not fit into the fixed size key representation including the terminating zero byte
+	if(!currentRoot.isUsed() || prefixLength >= idx::contenthelpers::getMaxKeyLength<KeyType>()) {
+		return 0u;
+	}
+
+	idx::contenthelpers::KeyBytesView const prefixBytes { reinterpret_cast<uint8_t const *>(prefix), prefixLength };
+	uint16_t prefixBitLength = static_cast<uint16_t>(prefixLength * 8u);
+
+	std::array<HOTRowexChildPointer const *, 64> currentEntries;
+	std::array<HOTRowexChildPointer const *, 64> entriesEnds;
+	HOTRowexChildPointer firstValue = currentRoot;
+	if(currentRoot.isLeaf()) {
+		currentEntries[0] = &firstValue;
+		entriesEnds[0] = &firstValue + 1;
+	} else {
+		HOTRowexChildPointer current = currentRoot;
+		bool isRangeDetermined = false;
+		while(!isRangeDetermined && current.isNode()) {
+			isRangeDetermined = current.executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(true, [&](auto const & node) -> bool {
+				if(node.mDiscriminativeBitsRepresentation.mMostSignificantDiscriminativeBitIndex >= prefixBitLength) {
+					//all keys contained in the node share the bits of the prefix
+					currentEntries[0] = node.getPointers();
+					entriesEnds[0] = node.end();
+					return true;
+				}
+				//the entries sharing the prefix bits with the searched entry form a subtree of the node, exactly like the entries affected by an insert at the first bit following the prefix
+				HOTRowexChildPointer const * searchedEntry = node.search(prefixBytes);
+				hot::commons::InsertInformation const & prefixSubtree = node.getInsertInformation(static_cast<uint32_t>(searchedEntry - node.getPointers()), hot::commons::DiscriminativeBit(prefixBitLength));
+				currentEntries[0] = node.getPointers() + prefixSubtree.getFirstIndexInAffectedSubtree();
+				entriesEnds[0] = currentEntries[0] + prefixSubtree.getNumberEntriesInAffectedSubtree();
+				return prefixSubtree.getNumberEntriesInAffectedSubtree() > 1u;
+			});
+			current = *currentEntries[0];
+		}
+
+		firstValue = current;
+		while(firstValue.isNode()) {
+			firstValue = *firstValue.getNode()->getPointers();
+		}
+	}
+
+	//all keys in the determined entries share the prefix bits, hence they either all start with the prefix or none does
+	if(std::strncmp(extractKey(idx::contenthelpers::tidToValue<ValueType>(firstValue.getTid())), prefix, prefixLength) != 0) {
+		return 0u;
+	}
+
+	std::array<ValueType, hot::commons::MAXIMUM_NUMBER_NODE_ENTRIES> batch;
+	size_t numberVisitedValues = 0u;
+	size_t depth = 0u;
+	while(true) {
+		HOTRowexChildPointer const * & currentEntry = currentEntries[depth];
+		HOTRowexChildPointer entry;
+		size_t batchSize = 0u;
+		//each entry is only read once, as it might be modified concurrently
+		for(; currentEntry != entriesEnds[depth] && (entry = *currentEntry).isLeaf(); ++currentEntry) {
+			batch[batchSize++] = idx::contenthelpers::tidToValue<ValueType>(entry.getTid());
+		}
+		if(batchSize > 0u) {
+			visitor(batch.data(), batchSize);
+			numberVisitedValues += batchSize;
+		}
+
+		if(currentEntry != entriesEnds[depth]) {
+			++currentEntry;
+			HOTRowexNodeBase const * childNode = entry.getNode();
+			currentEntries[++depth] = childNode->begin();
+			entriesEnds[depth] = childNode->end();
+		} else if(depth == 0u) {
+			return numberVisitedValues;
+		} else {
+			--depth;
+		}
+	}
+}
+
 template<typename ValueType, template <typename> typename KeyExtractor> inline bool HOTRowex<ValueType, KeyExtractor>::insert(ValueType const & value) {
+	idx::contenthelpers::checkKey(extractKey(value));
 	MemoryGuard guard(mMemoryReclamation);
 	return insertGuarded(value);
 }
@@ -88,8 +174,8 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline b
 template<typename ValueType, template <typename> typename KeyExtractor> inline bool HOTRowex<ValueType, KeyExtractor>::insertGuarded(ValueType const & value) {
 	idx::contenthelpers::OptionalValue<bool> insertionResult;
 
-	auto const & fixedSizeKey = idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(extractKey(value)));
-	uint8_t const* keyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
+	auto const & fixedSizeKey = idx::contenthelpers::toByteComparableKey(extractKey(value));
+	auto keyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
 
 	while(!insertionResult.mIsValid) {
 		//This temporary variable is important to prevent race conditions, which can occur
@@ -107,9 +193,8 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline b
 		} else if (currentRoot.isLeaf()) {
 			HOTRowexChildPointer valueToInsert(idx::contenthelpers::valueToTid(value));
 			ValueType const &currentLeafValue = idx::contenthelpers::tidToValue<ValueType>(currentRoot.getTid());
-			auto const &existingFixedSizeKey = idx::contenthelpers::toFixSizedKey(
-				idx::contenthelpers::toBigEndianByteOrder(extractKey(currentLeafValue)));
-			uint8_t const *existingKeyBytes = idx::contenthelpers::interpretAsByteArray(existingFixedSizeKey);
+			auto const &existingFixedSizeKey = idx::contenthelpers::toByteComparableKey(extractKey(currentLeafValue));
+			auto existingKeyBytes = idx::contenthelpers::interpretAsByteArray(existingFixedSizeKey);
 			idx::contenthelpers::OptionalValue<hot::commons::DiscriminativeBit> const &mismatchingBit = hot::commons::getMismatchingBit(existingKeyBytes, keyBytes, static_cast<uint16_t>(idx::contenthelpers::getMaxKeyLength<KeyType>()));
 
 			if (mismatchingBit.mIsValid) {
@@ -126,11 +211,50 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline b
 	return insertionResult.mValue;
 }
 
+template<typename ValueType, template <typename> typename KeyExtractor> template<typename RandomAccessIterator> inline size_t HOTRowex<ValueType, KeyExtractor>::bulkLoadParallel(RandomAccessIterator begin, RandomAccessIterator end) {
+	for(RandomAccessIterator current = begin; current != end; ++current) {
+		idx::contenthelpers::checkKey(extractKey(*current));
+	}
+	HOTRowexChildPointer currentRoot = mRoot;
+	if(currentRoot.isNode() && currentRoot.getNode() == nullptr) {
+		std::pair<HOTRowexChildPointer, size_t> loadResult = hot::commons::parallelBulkLoad<HOTRowexChildPointer, HOTRowexNode>(
+			static_cast<size_t>(std::distance(begin, end)),
+			[&](size_t index) {
+				auto const & fixedSizeKey = idx::contenthelpers::toByteComparableKey(extractKey(begin[index]));
+				auto const & nextFixedSizeKey = idx::contenthelpers::toByteComparableKey(extractKey(begin[index + 1]));
+				uint16_t separatingBitIndex = hot::commons::NO_SEPARATING_BIT_INDEX;
+				hot::commons::executeForDiffingKeys(
+					idx::contenthelpers::interpretAsByteArray(fixedSizeKey), idx::contenthelpers::interpretAsByteArray(nextFixedSizeKey), idx::contenthelpers::getMaxKeyLength<KeyType>(),
+					[&](hot::commons::DiscriminativeBit const & separatingBit) {
+						separatingBitIndex = separatingBit.mValue ? separatingBit.mAbsoluteBitIndex : hot::commons::DESCENDING_KEYS_SEPARATING_BIT_INDEX;
+					}
+				);
+				return separatingBitIndex;
+			},
+			[&](size_t index) {
+				return HOTRowexChildPointer(idx::contenthelpers::valueToTid(begin[index]));
+			}
+		);
+		if(mRoot.compareAndSwap(currentRoot, loadResult.first)) {
+			return loadResult.second;
+		}
+		//the loaded trie has never been published, therefore it can be freed immediately
+		loadResult.first.deleteSubtree();
+	}
+
+	size_t numberInsertedValues = 0u;
+	for(RandomAccessIterator current = begin; current != end; ++current) {
+		numberInsertedValues += insert(*current);
+	}
+	return numberInsertedValues;
+}
+
 template<typename ValueType, template <typename> typename KeyExtractor> inline idx::contenthelpers::OptionalValue<ValueType> HOTRowex<ValueType, KeyExtractor>::upsert(ValueType newValue) {
+	idx::contenthelpers::checkKey(extractKey(newValue));
 	MemoryGuard guard(mMemoryReclamation);
 	KeyType newKey = extractKey(newValue);
-	auto const & fixedSizeKey = idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(extractKey(newValue)));
-	uint8_t const* keyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
+	auto const & fixedSizeKey = idx::contenthelpers::toByteComparableKey(extractKey(newValue));
+	auto keyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
 	idx::contenthelpers::OptionalValue<ValueType> upsertResult;
 	bool upsertCompleted = false;
 
@@ -244,7 +368,7 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline v
 
 template<typename ValueType, template <typename> typename KeyExtractor> inline void HOTRowex<ValueType, KeyExtractor>::normalInsert(typename HOTRowex<ValueType, KeyExtractor>::InsertStackEntryType & currentNodeStackEntry, hot::commons::InsertInformation const & insertInformation, HOTRowexChildPointer const & valueToInsert) {
 	currentNodeStackEntry.updateChildPointer(
-		currentNodeStackEntry.getChildPointer().executeForSpecificNodeType(false, [&](auto & currentNode) -> HOTRowexChildPointer {
+		currentNodeStackEntry.getChildPointer().template executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto & currentNode) -> HOTRowexChildPointer {
 			return currentNode.addEntry(insertInformation, valueToInsert);
 		})
 	);
@@ -254,14 +378,14 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline h
 	typename HOTRowex<ValueType, KeyExtractor>::InsertStackEntryType &currentInsertStackEntry,
 	hot::commons::InsertInformation const &insertInformation, HOTRowexChildPointer const &valueToInsert) {
 
-	return currentInsertStackEntry.getChildPointer().executeForSpecificNodeType(false, [&](auto & currentNode) -> hot::commons::BiNode<HOTRowexChildPointer> {
+	return currentInsertStackEntry.getChildPointer().template executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto & currentNode) -> hot::commons::BiNode<HOTRowexChildPointer> {
 				return currentNode.split(insertInformation, valueToInsert);
 	});
 }
 
 template<typename ValueType, template <typename> typename KeyExtractor> inline hot::commons::BiNode<HOTRowexChildPointer> HOTRowex<ValueType, KeyExtractor>::integrateAndSplit(typename HOTRowex<ValueType, KeyExtractor>::InsertStackEntryType & currentInsertStackEntry, hot::commons::BiNode<HOTRowexChildPointer> const & splitEntries) {
 	//parent pull up
-	return currentInsertStackEntry.getChildPointer().executeForSpecificNodeType(false, [&](auto & currentNode) -> hot::commons::BiNode<HOTRowexChildPointer> {
+	return currentInsertStackEntry.getChildPointer().template executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto & currentNode) -> hot::commons::BiNode<HOTRowexChildPointer> {
 		//the right branch of the new bi node is always the one to insert, as this was not inserted before....
 		hot::commons::DiscriminativeBit discriminativeBit = { splitEntries.mDiscriminativeBitIndex, true };
 		hot::commons::InsertInformation const & insertInformation = currentInsertStackEntry.getInsertInformation(discriminativeBit);
@@ -294,7 +418,7 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline v
 	HOTRowexChildPointer const & currentNodePointer = currentNodeStackEntry.getChildPointer();
 	uint32_t entryIndex = currentNodeStackEntry.mSearchResultForInsert.mEntryIndex;
 
-	HOTRowexChildPointer const & newNode = currentNodePointer.executeForSpecificNodeType(false, [&](auto & parentNode) -> HOTRowexChildPointer {
+	HOTRowexChildPointer const & newNode = currentNodePointer.executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto & parentNode) -> HOTRowexChildPointer {
 		hot::commons::InsertInformation const &insertInformation = parentNode.getInsertInformation(entryIndex, discriminativeBit);
 		//simple parent pullup
 		return parentNode.addEntry(insertInformation, splitEntries.mRight);
@@ -313,6 +437,14 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline t
 	return HOTRowexSynchronizedIterator<ValueType, KeyExtractor>::end();
 }
 
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTRowex<ValueType, KeyExtractor>::const_reverse_iterator HOTRowex<ValueType, KeyExtractor>::rbegin() const {
+	return const_reverse_iterator(HOTRowexSynchronizedIterator<ValueType, KeyExtractor>::getLast(&mRoot, const_cast<EpochBasedMemoryReclamationStrategy*>(mMemoryReclamation)));
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTRowex<ValueType, KeyExtractor>::const_reverse_iterator HOTRowex<ValueType, KeyExtractor>::rend() const {
+	return const_reverse_iterator(HOTRowexSynchronizedIterator<ValueType, KeyExtractor>::end());
+}
+
 template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTRowex<ValueType, KeyExtractor>::const_iterator HOTRowex<ValueType, KeyExtractor>::find(typename HOTRowex<ValueType, KeyExtractor>::KeyType const & searchKey) const {
 	return HOTRowexSynchronizedIterator<ValueType, KeyExtractor>::find(&mRoot, searchKey, const_cast<EpochBasedMemoryReclamationStrategy*>(mMemoryReclamation));
 }
@@ -325,6 +457,14 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline t
 	return HOTRowexSynchronizedIterator<ValueType, KeyExtractor>::getBounded(&mRoot, searchKey, false, const_cast<EpochBasedMemoryReclamationStrategy*>(mMemoryReclamation));
 }
 
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTRowex<ValueType, KeyExtractor>::const_iterator HOTRowex<ValueType, KeyExtractor>::floor(typename HOTRowex<ValueType, KeyExtractor>::KeyType const & searchKey) const {
+	return HOTRowexSynchronizedIterator<ValueType, KeyExtractor>::getBoundedBackward(&mRoot, searchKey, true, const_cast<EpochBasedMemoryReclamationStrategy*>(mMemoryReclamation));
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTRowex<ValueType, KeyExtractor>::const_iterator HOTRowex<ValueType, KeyExtractor>::predecessor(typename HOTRowex<ValueType, KeyExtractor>::KeyType const & searchKey) const {
+	return HOTRowexSynchronizedIterator<ValueType, KeyExtractor>::getBoundedBackward(&mRoot, searchKey, false, const_cast<EpochBasedMemoryReclamationStrategy*>(mMemoryReclamation));
+}
+
 template<typename ValueType, template <typename> typename KeyExtractor>
 inline HOTRowexChildPointer HOTRowex<ValueType, KeyExtractor>::getNodeAtPath(std::initializer_list<unsigned int> path) {
 	HOTRowexChildPointer current = mRoot;
@@ -340,7 +480,7 @@ inline void HOTRowex<ValueType, KeyExtractor>::collectStatsForSubtree(
 	HOTRowexChildPointer const & subTreeRoot, std::map<std::string, double> & stats
 ) const {
 	if(!subTreeRoot.isLeaf()) {
-		subTreeRoot.executeForSpecificNodeType(true, [&, this](auto & node) -> void {
+		subTreeRoot.executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(true, [&, this](auto & node) -> void {
 			std::string nodeType = nodeAlgorithmToString(node.mNodeType);
 			stats["total"] += node.getNodeSizeInBytes();
 			stats[nodeType] += 1.0;
@@ -420,7 +560,7 @@ inline void HOTRowex<ValueType, KeyExtractor>::getBinaryTrieValueDistribution(
 	if(childPointer.isLeaf()) {
 		++leafNodesPerDepth[binaryTrieDepth];
 	} else {
-		childPointer.executeForSpecificNodeType(true, [&, this](auto &node) {
+		childPointer.executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(true, [&, this](auto &node) {
 			std::array<uint8_t, 32> binaryEntryDepthsInNode = node.getEntryDepths();
 			size_t i=0;
 			for(HOTRowexChildPointer const & pointer : node) {
@@ -431,6 +571,6 @@ inline void HOTRowex<ValueType, KeyExtractor>::getBinaryTrieValueDistribution(
 	}
 }
 
-}}
+}}}
 
 #endif
\ No newline at end of file
@@ -6,8 +6,9 @@
 
 #include "hot/rowex/HOTRowexChildPointerInterface.hpp"
 #include "hot/rowex/HOTRowexNodeInterface.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace rowex {
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 constexpr intptr_t NODE_ALGORITHM_TYPE_EXTRACTION_MASK = 0x7u;
 constexpr intptr_t POINTER_AND_IS_LEAF_VALUE_MASK = 15u;
@@ -25,7 +26,7 @@ template<hot::commons::NodeType nodeAlgorithmType> inline auto HOTRowexChildPoin
 	return reinterpret_cast<HOTRowexNode<DiscriminativeBitsRepresentationType, PartialKeyType> *>(node);
 }
 
-template<typename Operation> inline auto HOTRowexChildPointer::executeForSpecificNodeType(bool const withPrefetch, Operation const & operation) const {
+template<size_t maximumKeyLength, typename Operation> inline auto HOTRowexChildPointer::executeForSpecificNodeType(bool const withPrefetch, Operation const & operation) const {
 	HOTRowexNodeBase const * node = getNode();
 
 	if(withPrefetch) {
@@ -35,27 +36,10 @@ template<typename Operation> inline auto HOTRowexChildPointer::executeForSpecifi
 		__builtin_prefetch(reinterpret_cast<char const*>(node) + 192);
 	}
 
-	switch(getNodeType()) {
-		case hot::commons::NodeType::SINGLE_MASK_8_BIT_PARTIAL_KEYS:
-			return operation(*castToNode<hot::commons::NodeType::SINGLE_MASK_8_BIT_PARTIAL_KEYS>(node));
-		case hot::commons::NodeType::SINGLE_MASK_16_BIT_PARTIAL_KEYS:
-			return operation(*castToNode<hot::commons::NodeType::SINGLE_MASK_16_BIT_PARTIAL_KEYS>(node));
-		case hot::commons::NodeType::SINGLE_MASK_32_BIT_PARTIAL_KEYS:
-			return operation(*castToNode<hot::commons::NodeType::SINGLE_MASK_32_BIT_PARTIAL_KEYS>(node));
-		case hot::commons::NodeType::MULTI_MASK_8_BYTES_AND_8_BIT_PARTIAL_KEYS:
-			return operation(*castToNode<hot::commons::NodeType::MULTI_MASK_8_BYTES_AND_8_BIT_PARTIAL_KEYS>(node));
-		case hot::commons::NodeType::MULTI_MASK_8_BYTES_AND_16_BIT_PARTIAL_KEYS:
-			return operation(*castToNode<hot::commons::NodeType::MULTI_MASK_8_BYTES_AND_16_BIT_PARTIAL_KEYS>(node));
-		case hot::commons::NodeType::MULTI_MASK_8_BYTES_AND_32_BIT_PARTIAL_KEYS:
-			return operation(*castToNode<hot::commons::NodeType::MULTI_MASK_8_BYTES_AND_32_BIT_PARTIAL_KEYS>(node));
-		case hot::commons::NodeType::MULTI_MASK_16_BYTES_AND_16_BIT_PARTIAL_KEYS:
-			return operation(*castToNode<hot::commons::NodeType::MULTI_MASK_16_BYTES_AND_16_BIT_PARTIAL_KEYS>(node));
-		default: //hot::commons::NodeType::MULTI_MASK_32_BYTES_AND_32_BIT_PARTIAL_KEYS:
-			return operation(*castToNode<hot::commons::NodeType::MULTI_MASK_32_BYTES_AND_32_BIT_PARTIAL_KEYS>(node));
-	}
+	return executeForNodeType(getNodeType(), node, operation, std::integral_constant<bool, hot::commons::hasOnlySingleMaskNodeTypes(maximumKeyLength)>());
 }
 
-template<typename Operation> inline auto HOTRowexChildPointer::executeForSpecificNodeType(bool const withPrefetch, Operation const & operation) {
+template<size_t maximumKeyLength, typename Operation> inline auto HOTRowexChildPointer::executeForSpecificNodeType(bool const withPrefetch, Operation const & operation) {
 	HOTRowexNodeBase * node = getNode();
 
 	if(withPrefetch) {
@@ -65,7 +49,13 @@ template<typename Operation> inline auto HOTRowexChildPointer::executeForSpecifi
 		__builtin_prefetch(reinterpret_cast<char*>(node) + 192);
 	}
 
-	switch(getNodeType()) {
+	return executeForNodeType(getNodeType(), node, operation, std::integral_constant<bool, hot::commons::hasOnlySingleMaskNodeTypes(maximumKeyLength)>());
+}
+
+template<typename NodeBaseType, typename Operation> inline auto HOTRowexChildPointer::executeForNodeType(
+	hot::commons::NodeType nodeType, NodeBaseType * node, Operation const & operation, std::false_type
+) {
+	switch(nodeType) {
 		case hot::commons::NodeType::SINGLE_MASK_8_BIT_PARTIAL_KEYS:
 			return operation(*castToNode<hot::commons::NodeType::SINGLE_MASK_8_BIT_PARTIAL_KEYS>(node));
 		case hot::commons::NodeType::SINGLE_MASK_16_BIT_PARTIAL_KEYS:
@@ -85,6 +75,20 @@ template<typename Operation> inline auto HOTRowexChildPointer::executeForSpecifi
 	}
 }
 
+template<typename NodeBaseType, typename Operation> inline auto HOTRowexChildPointer::executeForNodeType(
+	hot::commons::NodeType nodeType, NodeBaseType * node, Operation const & operation, std::true_type
+) {
+	assert(nodeType <= hot::commons::NodeType::SINGLE_MASK_32_BIT_PARTIAL_KEYS);
+	switch(nodeType) {
+		case hot::commons::NodeType::SINGLE_MASK_8_BIT_PARTIAL_KEYS:
+			return operation(*castToNode<hot::commons::NodeType::SINGLE_MASK_8_BIT_PARTIAL_KEYS>(node));
+		case hot::commons::NodeType::SINGLE_MASK_16_BIT_PARTIAL_KEYS:
+			return operation(*castToNode<hot::commons::NodeType::SINGLE_MASK_16_BIT_PARTIAL_KEYS>(node));
+		default: //hot::commons::NodeType::SINGLE_MASK_32_BIT_PARTIAL_KEYS:
+			return operation(*castToNode<hot::commons::NodeType::SINGLE_MASK_32_BIT_PARTIAL_KEYS>(node));
+	}
+}
+
 inline HOTRowexChildPointer::HOTRowexChildPointer() : mPointer(reinterpret_cast<intptr_t>(nullptr)) {
 }
 
@@ -174,8 +178,8 @@ inline uint16_t HOTRowexChildPointer::getHeight() const {
 	return isLeaf() ? 0 : getNode()->mHeight;
 }
 
-inline HOTRowexChildPointer const * HOTRowexChildPointer::search(uint8_t const * const & keyBytes) const {
-	return executeForSpecificNodeType(true,	[&](const auto & node) {
+template<size_t maximumKeyLength, typename KeyBytesType> inline HOTRowexChildPointer const * HOTRowexChildPointer::search(KeyBytesType const & keyBytes) const {
+	return executeForSpecificNodeType<maximumKeyLength>(true,	[&](const auto & node) {
 		return node.search(keyBytes);
 	});
 }
@@ -222,6 +226,6 @@ inline bool HOTRowexChildPointer::isNode() const {
 	return isNode(mPointer.load(read_memory_order));
 }
 
-}}
+}}}
 
 #endif
\ No newline at end of file
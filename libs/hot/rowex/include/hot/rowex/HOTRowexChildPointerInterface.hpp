@@ -2,11 +2,14 @@
 #define __HOT__ROWEX__CHILD_POINTER_INTERFACE__
 
 #include <atomic>
+#include <cstdint>
 #include <set>
+#include <type_traits>
 
 #include <hot/commons/NodeType.hpp>
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace rowex {
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 struct HOTRowexNodeBase;
 
@@ -23,12 +26,15 @@ public:
 	 * Be aware to only call this method on child pointer representing valid nodes.
 	 * For all other cases this may result in undefined behaviour.
 	 *
+	 * If the maximum length of the keys is known at compile time, only the node types which can occur for keys of this length are dispatched.
+	 *
+	 * @tparam maximumKeyLength the maximum length in bytes of the keys stored in the trie containing the node, which defaults to an unbounded key length
 	 * @tparam Operation the type of the operation to execute on the node, the return type of the operation determines the return type of the node
 	 * @param withPrefetch determines whether the node should be prefetched before invoking the operation
 	 * @param operation the type of the operation to execute on the node
 	 * @return the result of the operation invoked on the actual node
 	 */
-	template<typename Operation>
+	template<size_t maximumKeyLength = SIZE_MAX, typename Operation>
 	inline auto executeForSpecificNodeType(bool const withPrefetch, Operation const &operation) const;
 
 	/**
@@ -37,12 +43,15 @@ public:
 	 * Be aware to only call this method on child pointer representing valid nodes.
 	 * For all other cases this may result in undefined behaviour.
 	 *
+	 * If the maximum length of the keys is known at compile time, only the node types which can occur for keys of this length are dispatched.
+	 *
+	 * @tparam maximumKeyLength the maximum length in bytes of the keys stored in the trie containing the node, which defaults to an unbounded key length
 	 * @tparam Operation the type of the operation to execute on the node, the return type of the operation determines the return type of the node
 	 * @param withPrefetch determines whether the node should be prefetched before invoking the operation
 	 * @param operation the type of the operation to execute on the node
 	 * @return the result of the operation invoked on the actual node
 	 */
-	template<typename Operation>
+	template<size_t maximumKeyLength = SIZE_MAX, typename Operation>
 	inline auto executeForSpecificNodeType(bool const withPrefetch, Operation const &operation);
 
 	/**
@@ -140,7 +149,13 @@ public:
 
 	inline uint16_t getHeight() const;
 
-	inline HOTRowexChildPointer const * search(uint8_t const * const & keyBytes) const;
+	/**
+	 * searches the node represented by this child pointer
+	 *
+	 * @tparam maximumKeyLength the maximum length in bytes of the keys stored in the trie, which restricts the dispatched node types (see { @link #executeForSpecificNodeType })
+	 */
+	template<size_t maximumKeyLength = SIZE_MAX, typename KeyBytesType>
+	inline HOTRowexChildPointer const * search(KeyBytesType const & keyBytes) const;
 
 	/**
 	 * Determines the number of entries in the node represented by this child pointer instance.
@@ -203,8 +218,20 @@ private:
 
 	template<hot::commons::NodeType  nodeAlgorithmType>
 	static inline auto castToNode(HOTRowexNodeBase *node);
+
+	/**
+	 * calls the passed operation with the actual node type, considering all node types
+	 */
+	template<typename NodeBaseType, typename Operation>
+	static inline auto executeForNodeType(hot::commons::NodeType nodeType, NodeBaseType * node, Operation const & operation, std::false_type hasOnlySingleMaskNodeTypes);
+
+	/**
+	 * calls the passed operation with the actual node type, considering only the single mask node types
+	 */
+	template<typename NodeBaseType, typename Operation>
+	static inline auto executeForNodeType(hot::commons::NodeType nodeType, NodeBaseType * node, Operation const & operation, std::true_type hasOnlySingleMaskNodeTypes);
 };
 
-}}
+}}}
 
 #endif
\ No newline at end of file
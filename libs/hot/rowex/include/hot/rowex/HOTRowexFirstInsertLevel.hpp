@@ -2,8 +2,9 @@
 #define __HOT__ROWEX__FIRST_INSERT_LEVEL__
 
 #include <hot/commons/InsertInformation.hpp>
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace rowex {
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 template<typename InsertStackEntryType>
 struct HOTRowexFirstInsertLevel {
@@ -17,6 +18,6 @@ struct HOTRowexFirstInsertLevel {
 	}
 };
 
-} }
+} } }
 
 #endif
\ No newline at end of file
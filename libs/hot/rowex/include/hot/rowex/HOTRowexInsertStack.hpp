@@ -16,8 +16,9 @@
 
 #include "hot/rowex/HOTRowexChildPointer.hpp"
 #include "hot/rowex/HOTRowexFirstInsertLevel.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace rowex {
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 template<typename ValueType, template<typename> typename KeyExtractor, typename InsertStackEntry>
 struct HOTRowexInsertStack {
@@ -38,7 +39,7 @@ struct HOTRowexInsertStack {
 	}
 
 	//do not initialize, for performance Reasons
-	HOTRowexInsertStack(HOTRowexChildPointer currentRoot, HOTRowexChildPointer* rootPointer, uint8_t const *newKeyBytes) : mLeafEntry(reinterpret_cast<EntryType*>(mRawStack)) {
+	HOTRowexInsertStack(HOTRowexChildPointer currentRoot, HOTRowexChildPointer* rootPointer, idx::contenthelpers::KeyBytesType<KeyType> const & newKeyBytes) : mLeafEntry(reinterpret_cast<EntryType*>(mRawStack)) {
 		HOTRowexChildPointer* currentPointerLocation = rootPointer;
 		HOTRowexChildPointer currentPointer = currentRoot;
 		while (!currentPointer.isLeaf()) {
@@ -138,19 +139,18 @@ struct HOTRowexInsertStack {
 			   : HOTRowexFirstInsertLevel<EntryType> { possibleInsertStackEntry, insertInformation, isSingleEntry & isLeafEntry & (possibleInsertStackEntry->getChildPointer().getHeight() > 1) };
 	}
 
-	idx::contenthelpers::OptionalValue<hot::commons::DiscriminativeBit> getMismatchingBit(uint8_t const *newKeyBytes) const {
+	idx::contenthelpers::OptionalValue<hot::commons::DiscriminativeBit> getMismatchingBit(idx::contenthelpers::KeyBytesType<KeyType> const & newKeyBytes) const {
 		intptr_t tid = mLeafEntry->getChildPointer().getTid();
 		ValueType const &existingValue = idx::contenthelpers::tidToValue<ValueType>(tid);
 		KeyType const &existingKey = extractKey(existingValue);
-		auto const &existingFixedSizeKey = idx::contenthelpers::toFixSizedKey(
-			idx::contenthelpers::toBigEndianByteOrder(existingKey));
-		uint8_t const *existingKeyBytes = idx::contenthelpers::interpretAsByteArray(existingFixedSizeKey);
+		auto const &existingFixedSizeKey = idx::contenthelpers::toByteComparableKey(existingKey);
+		auto existingKeyBytes = idx::contenthelpers::interpretAsByteArray(existingFixedSizeKey);
 		return hot::commons::getMismatchingBit(existingKeyBytes, newKeyBytes, static_cast<uint16_t>(idx::contenthelpers::getMaxKeyLength<KeyType>()));
 	}
 };
 
 template<typename ValueType, template <typename> typename KeyExtractor, typename InsertStackEntry> KeyExtractor<ValueType> HOTRowexInsertStack<ValueType, KeyExtractor, InsertStackEntry>::extractKey;
 
-}}
+}}}
 
 #endif
\ No newline at end of file
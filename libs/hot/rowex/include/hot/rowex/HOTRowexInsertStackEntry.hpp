@@ -6,8 +6,9 @@
 #include <hot/commons/SearchResultForInsert.hpp>
 
 #include "HOTRowexChildPointer.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace rowex {
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 class HOTRowexInsertStackEntry {
 	HOTRowexChildPointer mChildPointer;
@@ -87,6 +88,6 @@ private:
 	}
 };
 
-}}
+}}}
 
 #endif
\ No newline at end of file
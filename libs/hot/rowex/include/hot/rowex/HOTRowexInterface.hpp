@@ -2,9 +2,12 @@
 #define __HOT__ROWEX__HOT_ROWEX_INTERFACE__
 
 #include <idx/contenthelpers/KeyComparator.hpp>
+#include <idx/contenthelpers/KeyUtilities.hpp>
 #include <idx/contenthelpers/OptionalValue.hpp>
 
 #include <hot/commons/InsertInformation.hpp>
+#include <hot/commons/ParallelBulkLoader.hpp>
+#include <hot/commons/ReverseIterator.hpp>
 #include <hot/commons/BiNode.hpp>
 
 #include "hot/rowex/HOTRowexChildPointerInterface.hpp"
@@ -12,8 +15,9 @@
 #include "hot/rowex/HOTRowexInsertStack.hpp"
 #include "hot/rowex/HOTRowexInsertStackEntry.hpp"
 #include "hot/rowex/HOTRowexIterator.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace rowex {
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 /**
  * HOTRowex represents a concurrent height optimized trie using a
@@ -34,8 +38,11 @@ template<typename ValueType, template <typename> typename KeyExtractor> struct H
 	using InsertStackType = HOTRowexInsertStack<ValueType, KeyExtractor, HOTRowexInsertStackEntry>;
 	using InsertStackEntryType = typename InsertStackType::EntryType;
 	using const_iterator = HOTRowexSynchronizedIterator<ValueType, KeyExtractor>;
+	using const_reverse_iterator = hot::commons::ReverseIterator<const_iterator>;
 
 	static typename idx::contenthelpers::KeyComparator<KeyType>::type compareKeys;
+	//determines at compile time, which node types can occur in this trie. For keys of up to 8 bytes the node type dispatch is restricted to the single mask node types.
+	static constexpr size_t MAXIMUM_KEY_LENGTH = idx::contenthelpers::getMaxKeyLength<KeyType>();
 
 	HOTRowexChildPointer mRoot;
 
@@ -57,7 +64,7 @@ template<typename ValueType, template <typename> typename KeyExtractor> struct H
 	 * For a given key it looks up the stored value
 	 *
 	 * @param key the key to lookup
-	 * @return the looked up value. The result is valid, if a matching record was found.
+	 * @return the looked up value. The result is valid, if a matching record was found. Keys longer than the maximum key length are never found, as they cannot be inserted.
 	 */
 	inline idx::contenthelpers::OptionalValue<ValueType> lookup(KeyType const &key) const;
 
@@ -70,12 +77,28 @@ template<typename ValueType, template <typename> typename KeyExtractor> struct H
 	 */
 	inline idx::contenthelpers::OptionalValue<ValueType> scan(KeyType const &key, size_t numberValues) const;
 
+	/**
+	 * Visits all values whose keys start with the given prefix in ascending key order. It is only available for c string keys.
+	 *
+	 * The trie is descended to the smallest subtree whose entries contain all keys sharing the bits of the prefix.
+	 * A single key of this subtree is compared against the prefix, afterwards all values of the subtree are passed to the visitor without comparing any further keys.
+	 * Like iterating, the scan is not atomic. Values inserted concurrently may or may not be visited.
+	 *
+	 * @param prefix the prefix of the keys to visit. It must not contain a zero byte within its first prefixLength bytes.
+	 * @param prefixLength the length of the prefix in bytes. A prefix of length zero visits all values.
+	 * @param visitor a callable which is invoked as visitor(ValueType const * values, size_t numberValues) for each batch of consecutive values whose keys start with the prefix.
+	 * 	The passed values are only valid for the duration of the call.
+	 * @return the total number of visited values
+	 */
+	template<typename Visitor> inline size_t prefixScan(char const * prefix, size_t prefixLength, Visitor && visitor) const;
+
 	/**
 	 * Inserts the given record into the index. The value is inserted according to its keys value.
 	 * In case the index already contains a value for the corresponding key, the value is not inserted.
 	 *
 	 * @param value the value to insert.
 	 * @return true if the value can be inserted, false if the index already contains a value for the corresponding key
+	 * @throws std::length_error if the key is longer than the maximum key length (see { @link idx::contenthelpers::isSupportedKeyLength }). Such keys are never truncated silently.
 	 */
 	inline bool insert(ValueType const & value);
 private:
@@ -89,9 +112,29 @@ public:
 	 *
 	 * @param newValue the value to upsert.
 	 * @return the value of a previously contained value for the same key or an invalid result otherwise
+	 * @throws std::length_error if the key is longer than the maximum key length (see { @link idx::contenthelpers::isSupportedKeyLength }). Such keys are never truncated silently.
 	 */
 	inline idx::contenthelpers::OptionalValue<ValueType> upsert(ValueType newValue);
 
+	/**
+	 * Loads a sequence of values, which is sorted in ascending key order, into an empty index using multiple threads.
+	 *
+	 * The sequence is recursively partitioned at the most significant bit separating any two adjacent keys of a partition.
+	 * Each partition is loaded by a separate TBB task and the roots of the resulting subtries are stitched together into the top levels of the trie.
+	 * The number of threads used is bounded by the concurrency of the calling thread's task arena.
+	 * The loaded trie is published atomically, hence concurrent readers either observe an empty index or the completely loaded one.
+	 * Values with a key equal to the key of their predecessor are not loaded.
+	 * In case the index is not empty or a concurrent writer modified the index during the load, the values are inserted one by one using { @link #insert(ValueType const &) }.
+	 *
+	 * @tparam RandomAccessIterator a random access iterator whose value type is ValueType
+	 * @param begin an iterator to the value with the smallest key
+	 * @param end the iterator marking the end of the sequence of values
+	 * @return the number of values loaded into the index
+	 * @throws std::length_error if any key is longer than the maximum key length (see { @link idx::contenthelpers::isSupportedKeyLength }). In this case no value is loaded.
+	 * @throws std::invalid_argument if the index is empty and the keys are not in ascending order. In this case no value is loaded.
+	 */
+	template<typename RandomAccessIterator> inline size_t bulkLoadParallel(RandomAccessIterator begin, RandomAccessIterator end);
+
 private:
 	inline idx::contenthelpers::OptionalValue<bool> insertNewValue(
 		InsertStackType & insertStack, hot::commons::DiscriminativeBit const & newBit, ValueType const & value
@@ -126,6 +169,16 @@ public:
 	 */
 	inline const_iterator const & end() const;
 
+	/**
+	 * @return a reverse iterator to the last value according to the key order, which traverses the values in descending key order.
+	 */
+	inline const_reverse_iterator rbegin() const;
+
+	/**
+	 * @return a reverse iterator which is positioned before the first element.
+	 */
+	inline const_reverse_iterator rend() const;
+
 	/**
 	 * searches an entry for the given key. In case an entry is found, an iterator for this entry is returned.
 	 * If no matching entry is found the { @link #end() } iterator is returned.
@@ -152,6 +205,24 @@ public:
 	 */
 	inline const_iterator upper_bound(KeyType const & searchKey) const;
 
+	/**
+	 * returns an iterator to the last entry which has a key, which is not larger than the given search key.
+	 * This is either an iterator to the matching entry itself or the last value contained in the index which has a key which is smaller than the search key.
+	 * Starting at the returned iterator, the preceding values can be traversed in descending key order by decrementing the iterator.
+	 *
+	 * @param searchKey the search key to determine the floor for
+	 * @return either the last entry which has a key, which is not larger than the given search key or the end iterator if no entry fulfills the floor condition
+	 */
+	inline const_iterator floor(KeyType const & searchKey) const;
+
+	/**
+	 * returns an iterator to the last entry which has a key which is smaller than the given search key
+	 *
+	 * @param searchKey the search key to determine the predecessor for
+	 * @return either the last entry which has a key smaller than the search key or the end iterator if no entry fulfills the predecessor condition
+	 */
+	inline const_iterator predecessor(KeyType const & searchKey) const;
+
 	/**
 	 * helper function for debuggin purposes only, which for a given path returns the child pointer stored at this location.
 	 * A path to a childpointer consists of a top down ordered list of indexes, where each index determines the position of the pointer to follow.
@@ -193,6 +264,6 @@ private:
 
 };
 
-}}
+}}}
 
 #endif
\ No newline at end of file
@@ -19,8 +19,9 @@
 #include "hot/rowex/HOTRowexIteratorStackEntry.hpp"
 #include "hot/rowex/EpochBasedMemoryReclamationStrategy.hpp"
 #include "hot/rowex/MemoryGuard.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace rowex {
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 using HOTRowexSynchronizedIteratorStackState = HOTRowexIteratorStackState<HOTRowexIteratorStackEntry>;
 
@@ -55,6 +56,27 @@ public:
 		return END_ITERATOR;
 	}
 
+	static inline HOTRowexSynchronizedIterator getLast(HOTRowexChildPointer const * rootPointerLocation, EpochBasedMemoryReclamationStrategy * const & memoryReclamationStrategy) {
+		MemoryGuard guard(memoryReclamationStrategy);
+		HOTRowexChildPointer rootPointer = *rootPointerLocation;
+		return rootPointer.isUsed() ? HOTRowexSynchronizedIterator(rootPointerLocation, memoryReclamationStrategy, [&](HOTRowexChildPointer * const & bufferRoot, HOTRowexIteratorStackEntry * const stackRoot) {
+			return fillBufferBackward(
+				HotRowexIteratorBufferState<KeyType>(bufferRoot),
+				HOTRowexSynchronizedIteratorStackState({ stackRoot, static_cast<int32_t>(ITERATOR_FILL_BUFFER_STATE_DESCEND + rootPointer.isLeafInt()), stackRoot->init(rootPointerLocation, rootPointer, rootPointerLocation + 1) }),
+				guard
+			);
+		}) : END_ITERATOR;
+	}
+
+	static inline HOTRowexSynchronizedIterator getBoundedBackward(HOTRowexChildPointer const * rootPointerLocation, KeyType const & searchKey, bool isFloor, EpochBasedMemoryReclamationStrategy * const & memoryReclamationStrategy) {
+		MemoryGuard guard(memoryReclamationStrategy);
+		HOTRowexChildPointer rootPointer = *rootPointerLocation;
+		return rootPointer.isUsed() ? HOTRowexSynchronizedIterator(rootPointerLocation, memoryReclamationStrategy, [&](HOTRowexChildPointer * const & bufferRoot, HOTRowexIteratorStackEntry * const stackRoot) {
+			FixedSizedKeyType const & fixedSizedKey = toFixedSizedKey(searchKey);
+			return fillBufferBackwardForBoundWithByteKey(bufferRoot, stackRoot, rootPointerLocation, rootPointer, idx::contenthelpers::interpretAsByteArray(fixedSizedKey), isFloor, guard);
+		}) : END_ITERATOR;
+	}
+
 	static inline HOTRowexSynchronizedIterator getBounded(HOTRowexChildPointer const * rootPointer, KeyType const & searchKey, bool isLowerBound, EpochBasedMemoryReclamationStrategy * const & memoryReclamationStrategy) {
 		MemoryGuard guard(memoryReclamationStrategy);
 		HOTRowexChildPointer const & currentRoot = *rootPointer;
@@ -111,6 +133,10 @@ private:
 		: mRootPointerLocation(rootPointerLocation), mMemoryReclamationStrategy(memoryReclamationStrategy), mCurrentBufferState(fillBufferForBound(getBufferRoot(), getStackRoot(), rootPointerLocation, rootPointer, searchKey, isLowerBound, currentMemoryGuard)) {
 	}
 
+	template<typename InitialBufferFiller> inline HOTRowexSynchronizedIterator(HOTRowexChildPointer const * rootPointerLocation, EpochBasedMemoryReclamationStrategy* memoryReclamationStrategy, InitialBufferFiller const & fillInitialBuffer)
+		: mRootPointerLocation(rootPointerLocation), mMemoryReclamationStrategy(memoryReclamationStrategy), mCurrentBufferState(fillInitialBuffer(getBufferRoot(), getStackRoot())) {
+	}
+
 	inline HOTRowexSynchronizedIterator() : mRootPointerLocation(&HOTRowexIteratorEndToken::END_TOKEN), mCurrentBufferState(getBufferRoot()) {
 	}
 
@@ -136,6 +162,27 @@ public:
 		return *this;
 	}
 
+	/**
+	 * moves the iterator to the value preceding the current value in key order.
+	 * Decrementing an iterator positioned on the smallest value yields the end iterator. Decrementing the end iterator yields the end iterator again.
+	 * Like incrementing, the buffered values are consumed first. Afterwards the buffer is refilled in descending key order starting before the first buffered key.
+	 */
+	inline HOTRowexSynchronizedIterator<ValueType, KeyExtractor> & operator--() {
+		if(mCurrentBufferState.canRetreat()) {
+			mCurrentBufferState.retreat();
+		} else {
+			MemoryGuard guard { mMemoryReclamationStrategy };
+			const HOTRowexChildPointer currentRoot = *mRootPointerLocation;
+			//an empty buffer implies that the end iterator is decremented
+			if(currentRoot.isUsed() & !mCurrentBufferState.isEmpty()) {
+				mCurrentBufferState = fillBufferBackwardForBoundWithByteKey(getBufferRoot(), getStackRoot(), mRootPointerLocation, currentRoot, mCurrentBufferState.getFirstAccessedKey(), false, guard);
+			} else {
+				mCurrentBufferState = { getBufferRoot() };
+			}
+		}
+		return *this;
+	}
+
 	inline HOTRowexSynchronizedIterator<ValueType, KeyExtractor>& operator=(HOTRowexSynchronizedIterator<ValueType, KeyExtractor> const & other) {
 		mMemoryReclamationStrategy = other.mMemoryReclamationStrategy;
 		mRootPointerLocation = other.mRootPointerLocation;
@@ -181,6 +228,12 @@ private:
 		return currentStackEntry->getCurrent().isLeafInt();
 	}
 
+	static inline int32_t retreatOrAscend(HOTRowexIteratorStackEntry const * const rootStackEntry, HOTRowexIteratorStackEntry const * const currentStackEntry) {
+		//as the stack entries only store the end of their node's entries, the first entry is determined using the node referenced by the parent stack entry
+		bool isFirstElement = (currentStackEntry == rootStackEntry) || (currentStackEntry->getCurrentPointerLocation() == (currentStackEntry - 1)->getCurrent().getNode()->getPointers());
+		return isFirstElement ? ITERATOR_FILL_BUFFER_STATE_ASCEND : ITERATOR_FILL_BUFFER_STATE_RETREAT;
+	}
+
 	static inline HotRowexIteratorBufferState<KeyType> fillBufferForBound(HOTRowexChildPointer * const & bufferRoot, HOTRowexIteratorStackEntry * currentStackRoot, HOTRowexChildPointer const * rootPointerLocation, HOTRowexChildPointer const & rootPointer, KeyType const & searchKey, bool isLowerBound, MemoryGuard const &guard) {
 		FixedSizedKeyType const & fixedSizedKeyType = toFixedSizedKey(searchKey);
 		return fillBufferForBoundWithByteKey(bufferRoot, currentStackRoot, rootPointerLocation, rootPointer, idx::contenthelpers::interpretAsByteArray(fixedSizedKeyType), isLowerBound, guard);
@@ -250,11 +303,15 @@ private:
 					break;
 				}
 				case ITERATOR_FILL_BUFFER_STATE_STORE: {
+					if(iteratorBufferState.isEmpty()) {
+						iteratorBufferState.setFirstAccessedKey(getKeyForStackEntry(stackState.mStackEntry));
+					}
 					iteratorBufferState.push_back(stackState.mStackEntry->getCurrent());
 					if(!iteratorBufferState.isFull()) {
 						stackState.mBufferState = ascendOrAdvance(stackState.mStackEntry);
 					} else {
 						iteratorBufferState.setLastAccessedKey(getKeyForStackEntry(stackState.mStackEntry));
+						iteratorBufferState.mIsEndOfDataReached = false;
 						return iteratorBufferState;
 					}
 					break;
@@ -277,6 +334,106 @@ private:
 		}
 	}
 
+	static inline HotRowexIteratorBufferState<KeyType> fillBufferBackwardForBoundWithByteKey(HOTRowexChildPointer * const & bufferRoot, HOTRowexIteratorStackEntry * currentStackRoot, HOTRowexChildPointer const * rootPointerLocation, HOTRowexChildPointer const & rootPointer, uint8_t const* searchKeyBytes, bool isFloor, MemoryGuard const &guard) {
+		HOTRowexIteratorStackEntry * currentStackEntry = currentStackRoot;
+		currentStackEntry->init(rootPointerLocation, rootPointer, rootPointerLocation + 1);
+
+		std::array<uint16_t, 64> mMostSignificantBitIndexes;
+		uint16_t* mMostSignificantBitIndex = mMostSignificantBitIndexes.data();
+
+		while(!currentStackEntry->getCurrent().isLeaf()) {
+			HOTRowexIteratorStackEntry * nextStackEntry = currentStackEntry + 1;
+			currentStackEntry->getCurrent().executeForSpecificNodeType(true, [&](auto & node) -> void {
+				*mMostSignificantBitIndex = node.mDiscriminativeBitsRepresentation.mMostSignificantDiscriminativeBitIndex;
+				nextStackEntry->init(node.search(searchKeyBytes), node.end());
+			});
+			++mMostSignificantBitIndex;
+			currentStackEntry = nextStackEntry;
+		}
+
+		FixedSizedKeyType const & existingFixedSizeKey = idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(getKeyForStackEntry(currentStackEntry)));
+		uint8_t const* existingKeyBytes = idx::contenthelpers::interpretAsByteArray(existingFixedSizeKey);
+
+		idx::contenthelpers::OptionalValue<hot::commons::DiscriminativeBit> mismatchingBit = hot::commons::getMismatchingBit(existingKeyBytes, searchKeyBytes, idx::contenthelpers::getMaxKeyLength<KeyType>());
+
+		if(!mismatchingBit.mIsValid) {
+			//in case of isFloor == true the next ACTION is STORE otherwise the next ACTION is RETREAT or ASCEND
+			return fillBufferBackward({ bufferRoot }, { currentStackRoot, isFloor ? ITERATOR_FILL_BUFFER_STATE_STORE : retreatOrAscend(currentStackRoot, currentStackEntry), currentStackEntry }, guard);
+		} else if(currentStackEntry == currentStackRoot) {
+			//the root is a single leaf, which is only stored if its key is smaller than the search key
+			return fillBufferBackward({ bufferRoot }, { currentStackRoot, mismatchingBit.mValue.mValue ? ITERATOR_FILL_BUFFER_STATE_STORE : ITERATOR_FILL_BUFFER_STATE_END, currentStackEntry }, guard);
+		}
+
+		HOTRowexChildPointer const * childPointerLocation = currentStackEntry->getCurrentPointerLocation();
+		--mMostSignificantBitIndex;
+		--currentStackEntry;
+		unsigned int entryIndex = childPointerLocation - currentStackEntry->getCurrent().getNode()->getPointers();
+		while (getIteratorStackDepth(currentStackRoot, currentStackEntry) > 0 && mismatchingBit.mValue.mAbsoluteBitIndex < *mMostSignificantBitIndex) {
+			HOTRowexIteratorStackEntry* parentStackEntry = currentStackEntry - 1;
+			entryIndex = currentStackEntry->getCurrentPointerLocation() - parentStackEntry->getCurrent().getNode()->getPointers();
+			currentStackEntry = parentStackEntry;
+			--mMostSignificantBitIndex;
+		}
+		return fillBufferBackward({ bufferRoot }, currentStackEntry->getCurrent().executeForSpecificNodeType(false, [&](auto const &existingNode) -> HOTRowexSynchronizedIteratorStackState {
+			hot::commons::InsertInformation const & insertInformation = existingNode.getInsertInformation(entryIndex, mismatchingBit.mValue);
+			HOTRowexChildPointer const * firstEntryLocationInAffectedSubtree = existingNode.getPointers() + insertInformation.getFirstIndexInAffectedSubtree();
+
+			if(insertInformation.mKeyInformation.mValue) {
+				//the search key is larger than all keys in the affected subtree, hence the largest value of the affected subtree is stored first
+				(++currentStackEntry)->init(firstEntryLocationInAffectedSubtree + insertInformation.getNumberEntriesInAffectedSubtree() - 1, existingNode.end());
+				return HOTRowexSynchronizedIteratorStackState(currentStackRoot, HOTRowexSynchronizedIterator::descendOrStore(currentStackEntry), currentStackEntry);
+			} else {
+				//the search key is smaller than all keys in the affected subtree, hence the values preceding the affected subtree are stored
+				(++currentStackEntry)->init(firstEntryLocationInAffectedSubtree, existingNode.end());
+				return HOTRowexSynchronizedIteratorStackState(currentStackRoot, HOTRowexSynchronizedIterator::retreatOrAscend(currentStackRoot, currentStackEntry), currentStackEntry);
+			}
+		}), guard);
+	}
+
+	/**
+	 * fills the buffer in descending key order. In contrast to fillBuffer, DESCEND continues with the last entry of a node and ASCEND is followed by RETREAT instead of ADVANCE.
+	 * Afterwards the buffered entries are reversed, such that the buffer is in ascending key order and positioned on its largest entry.
+	 */
+	static inline HotRowexIteratorBufferState<KeyType> fillBufferBackward(HotRowexIteratorBufferState<KeyType> iteratorBufferState, HOTRowexSynchronizedIteratorStackState stackState, MemoryGuard const & /* guard */) {
+		bool isBufferFull = false;
+		while(!isBufferFull && stackState.mBufferState != ITERATOR_FILL_BUFFER_STATE_END) {
+			switch(stackState.mBufferState) {
+				case ITERATOR_FILL_BUFFER_STATE_DESCEND: {
+					HOTRowexNodeBase *childNode = stackState.mStackEntry->getCurrent().getNode();
+					(++stackState.mStackEntry)->init(childNode->end() - 1, childNode->end());
+					stackState.mBufferState = descendOrStore(stackState.mStackEntry);
+					break;
+				}
+				case ITERATOR_FILL_BUFFER_STATE_STORE: {
+					iteratorBufferState.push_back(stackState.mStackEntry->getCurrent());
+					isBufferFull = iteratorBufferState.isFull();
+					stackState.mBufferState = retreatOrAscend(stackState.mRootEntry, stackState.mStackEntry);
+					break;
+				}
+				case ITERATOR_FILL_BUFFER_STATE_RETREAT: {
+					stackState.mStackEntry->retreat();
+					stackState.mBufferState = descendOrStore(stackState.mStackEntry);
+					break;
+				}
+				default: { //ASCEND
+					bool elementsRemaining = ((--stackState.mStackEntry) >= stackState.mRootEntry);
+					//abort if stack is consumed
+					stackState.mBufferState = elementsRemaining ? retreatOrAscend(stackState.mRootEntry, stackState.mStackEntry) : ITERATOR_FILL_BUFFER_STATE_END;
+					break;
+				}
+			}
+		}
+
+		iteratorBufferState.reverseEntries();
+		if(!iteratorBufferState.isEmpty()) {
+			iteratorBufferState.setFirstAccessedKey(getKeyForChildPointer(iteratorBufferState.mBuffer[0]));
+			iteratorBufferState.setLastAccessedKey(getKeyForChildPointer(iteratorBufferState.mBuffer[iteratorBufferState.mCurrentBufferSize - 1]));
+			//the values following the buffered values are determined by searching for the upper bound of the last buffered key
+			iteratorBufferState.mIsEndOfDataReached = false;
+		}
+		return iteratorBufferState;
+	}
+
 	static inline FixedSizedKeyType toFixedSizedKey(KeyType const & key) {
 		return idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(key));
 	}
@@ -294,6 +451,6 @@ private:
 template<typename ValueType, template <typename> typename KeyExtractor> HOTRowexSynchronizedIterator<ValueType, KeyExtractor> const HOTRowexSynchronizedIterator<ValueType, KeyExtractor>::END_ITERATOR {};
 template<typename ValueType, template <typename> typename KeyExtractor> KeyExtractor<ValueType> HOTRowexSynchronizedIterator<ValueType, KeyExtractor>::extractKey;
 
-}}
+}}}
 
 #endif
\ No newline at end of file
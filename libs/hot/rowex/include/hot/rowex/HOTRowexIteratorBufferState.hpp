@@ -1,13 +1,15 @@
 #ifndef __HOT__ROWEX__ITERATOR_BUFFER_STATE__
 #define __HOT__ROWEX__ITERATOR_BUFFER_STATE__
 
+#include <algorithm>
 #include <cstdlib>
 #include <idx/contenthelpers/KeyUtilities.hpp>
 
 #include "hot/rowex/HOTRowexIteratorEndToken.hpp"
 #include "hot/rowex/HOTRowexChildPointer.hpp"
+#include "hot/commons/InstructionSet.hpp"
 
-namespace hot { namespace rowex {
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 template<typename KeyType> struct HotRowexIteratorBufferState {
 	static constexpr size_t MAXIMUM_NUMBER_NUMBER_ENTRIES_IN_BUFFER = 128u;
@@ -19,9 +21,13 @@ template<typename KeyType> struct HotRowexIteratorBufferState {
 	size_t mCurrentBufferIndex;
 	size_t mCurrentBufferSize;
 
+	FixedSizedKeyType mFirstAccessedKey;
 	FixedSizedKeyType mLastAccessedKey;
 
-	HotRowexIteratorBufferState(HOTRowexChildPointer * const & buffer) : mBuffer(buffer), mCurrentBufferIndex(0u), mCurrentBufferSize(0), mLastAccessedKey() {
+	//whether no values follow the last buffered value. Otherwise the buffer is refilled starting after mLastAccessedKey once it is consumed.
+	bool mIsEndOfDataReached;
+
+	HotRowexIteratorBufferState(HOTRowexChildPointer * const & buffer) : mBuffer(buffer), mCurrentBufferIndex(0u), mCurrentBufferSize(0), mFirstAccessedKey(), mLastAccessedKey(), mIsEndOfDataReached(true) {
 		buffer[0] = HOTRowexIteratorEndToken::END_TOKEN;
 	}
 
@@ -32,7 +38,9 @@ template<typename KeyType> struct HotRowexIteratorBufferState {
 		mBuffer[0] = HOTRowexIteratorEndToken::END_TOKEN;
 		mCurrentBufferIndex = other.mCurrentBufferIndex;
 		mCurrentBufferSize = other.mCurrentBufferSize;
+		mFirstAccessedKey = other.mFirstAccessedKey;
 		mLastAccessedKey = other.mLastAccessedKey;
+		mIsEndOfDataReached = other.mIsEndOfDataReached;
 		std::memmove(mBuffer, other.mBuffer, sizeof(HOTRowexChildPointer) * other.mCurrentBufferSize);
 	}
 
@@ -41,7 +49,7 @@ template<typename KeyType> struct HotRowexIteratorBufferState {
 	}
 
 	bool endOfDataReached() {
-		return mCurrentBufferSize < MAXIMUM_NUMBER_NUMBER_ENTRIES_IN_BUFFER;
+		return mIsEndOfDataReached;
 	}
 
 	bool isEmpty() {
@@ -60,10 +68,34 @@ template<typename KeyType> struct HotRowexIteratorBufferState {
 		return (mCurrentBufferIndex + 1) < mCurrentBufferSize;
 	}
 
+	void retreat() {
+		--mCurrentBufferIndex;
+	}
+
+	bool canRetreat() {
+		return mCurrentBufferIndex > 0;
+	}
+
 	void push_back(HOTRowexChildPointer const & entryToStore) {
 		mBuffer[mCurrentBufferSize++] = entryToStore;
 	}
 
+	/**
+	 * restores ascending key order for entries which were pushed in descending key order and positions the buffer on its last entry
+	 */
+	void reverseEntries() {
+		std::reverse(mBuffer, mBuffer + mCurrentBufferSize);
+		mCurrentBufferIndex = (mCurrentBufferSize > 0) ? (mCurrentBufferSize - 1) : 0;
+	}
+
+	void setFirstAccessedKey(KeyType const & firstAccessedKey) {
+		mFirstAccessedKey = idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(firstAccessedKey));
+	}
+
+	const uint8_t* getFirstAccessedKey() {
+		return idx::contenthelpers::interpretAsByteArray(mFirstAccessedKey);
+	}
+
 	void setLastAccessedKey(KeyType const & lastAccessedKey) {
 		mLastAccessedKey = idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(lastAccessedKey));
 	}
@@ -73,6 +105,6 @@ template<typename KeyType> struct HotRowexIteratorBufferState {
 	}
 };
 
-}}
+}}}
 
 #endif
\ No newline at end of file
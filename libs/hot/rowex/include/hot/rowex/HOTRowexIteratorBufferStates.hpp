@@ -1,12 +1,16 @@
 #ifndef __HOT__ROWEX__FILL_BUFFER_STATES__
 #define __HOT__ROWEX__FILL_BUFFER_STATES__
 
-namespace hot { namespace rowex {
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 	constexpr int32_t ITERATOR_FILL_BUFFER_STATE_DESCEND = 0;
 	constexpr int32_t ITERATOR_FILL_BUFFER_STATE_STORE = 1;
 	constexpr int32_t ITERATOR_FILL_BUFFER_STATE_ADVANCE = 2;
 	constexpr int32_t ITERATOR_FILL_BUFFER_STATE_ASCEND = 3;
 	constexpr int32_t ITERATOR_FILL_BUFFER_STATE_END = 4;
-}}
+	//only used for filling the buffer in descending key order, in which case DESCEND continues with the last entry of a node and ASCEND is followed by RETREAT
+	constexpr int32_t ITERATOR_FILL_BUFFER_STATE_RETREAT = 5;
+}}}
 
 #endif
\ No newline at end of file
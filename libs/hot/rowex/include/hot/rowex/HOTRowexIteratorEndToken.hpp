@@ -2,8 +2,9 @@
 #define __HOT__ROWEX__ITERATOR_END_TOKEN__
 
 #include "HOTRowexChildPointer.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace rowex {
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 template<int dummy>
 struct HOTRowexIteratorEndTokenWorkaround {
@@ -13,7 +14,7 @@ template<int dummy> HOTRowexChildPointer HOTRowexIteratorEndTokenWorkaround<dumm
 
 using HOTRowexIteratorEndToken = HOTRowexIteratorEndTokenWorkaround<0>;
 
-}}
+}}}
 
 #endif
 
@@ -1,7 +1,9 @@
 #ifndef __HOT__ROWEX__SYNCHRONIZED_ITERATOR_STACK_ENTRY__
 #define __HOT__ROWEX__SYNCHRONIZED_ITERATOR_STACK_ENTRY__
 
-namespace hot { namespace rowex {
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 class HOTRowexIteratorStackEntry {
 	HOTRowexChildPointer const * mCurrentPointerLocation;
@@ -43,8 +45,13 @@ public:
 		++mCurrentPointerLocation;
 		mCurrent = *mCurrentPointerLocation;
 	}
+
+	void retreat() {
+		--mCurrentPointerLocation;
+		mCurrent = *mCurrentPointerLocation;
+	}
 };
 
-}}
+}}}
 
 #endif
\ No newline at end of file
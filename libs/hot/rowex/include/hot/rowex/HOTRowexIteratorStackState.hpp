@@ -6,7 +6,9 @@
 
 #include <cstdint>
 
-namespace hot { namespace rowex {
+#include "hot/commons/InstructionSet.hpp"
+
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 template<typename StackEntryType> struct HOTRowexIteratorStackState {
 	StackEntryType *mRootEntry;
@@ -30,6 +32,6 @@ template<typename StackEntryType> struct HOTRowexIteratorStackState {
 	}
 };
 
-}}
+}}}
 
 #endif
\ No newline at end of file
@@ -11,14 +11,17 @@
 #include <hot/commons/SparsePartialKeys.hpp>
 #include <hot/commons/MultiMaskPartialKeyMapping.hpp>
 #include <hot/commons/NodeAllocationInformations.hpp>
+#include <hot/commons/NodeMemory.hpp>
+#include <hot/commons/ParallelBitOperations.hpp>
 #include <hot/commons/SearchResultForInsert.hpp>
 #include <hot/commons/TwoEntriesNode.hpp>
 
 #include "hot/rowex/HOTRowexNodeBase.hpp"
 #include "hot/rowex/HOTRowexNodeInterface.hpp"
 #include "hot/rowex/HOTRowexChildPointer.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace rowex {
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 constexpr uint32_t calculatePointerSize(uint16_t const numberEntries) {
 	constexpr uint32_t childPointerSize = static_cast<uint32_t>(sizeof(HOTRowexChildPointer));
@@ -68,22 +71,21 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType>  vo
 	hot::commons::NodeAllocationInformation const & allocationInformation = hot::commons::NodeAllocationInformations<HOTRowexNode<DiscriminativeBitsRepresentation, PartialKeyType>>::getAllocationInformation(numberEntries);
 	assert(numberEntries >= 2);
 
-	void* memoryForNode = nullptr;
-	uint error = posix_memalign(&memoryForNode, SIMD_COB_TRIE_NODE_ALIGNMENT, allocationInformation.mTotalSizeInBytes);
-	if(error != 0) {
-		//"Got error on alignment"
-		throw std::bad_alloc();
-	}
-	return memoryForNode;
+	return hot::commons::allocateNodeMemory(allocationInformation.mTotalSizeInBytes, SIMD_COB_TRIE_NODE_ALIGNMENT);
 };
 
 template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> void HOTRowexNode<DiscriminativeBitsRepresentation, PartialKeyType>::operator delete (void * rawMemory) {
-	free(rawMemory);
+	hot::commons::releaseNodeMemory(rawMemory);
 }
 
 template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inline hot::commons::NodeAllocationInformation HOTRowexNode<DiscriminativeBitsRepresentation, PartialKeyType>::getNodeAllocationInformation(uint16_t const numberEntries) {
 	constexpr uint32_t entriesMasksBaseSize = static_cast<uint32_t>(sizeof(hot::commons::SparsePartialKeys<PartialKeyType>));
 	constexpr uint32_t baseSize = static_cast<uint32_t>(sizeof(HOTRowexNode<DiscriminativeBitsRepresentation, PartialKeyType>)) - entriesMasksBaseSize;
+	static_assert(
+		hot::commons::SparsePartialKeys<PartialKeyType>::estimateSize(hot::commons::MAXIMUM_NUMBER_NODE_ENTRIES) + baseSize + calculatePointerSize(hot::commons::MAXIMUM_NUMBER_NODE_ENTRIES)
+			<= hot::commons::getMaximumNodeSizeInBytes(0u),
+		"the largest node of each node type must fit into the slots of the slab allocator"
+	);
 
 	uint32_t pointersSize = calculatePointerSize(numberEntries);
 	uint16_t pointerOffset = hot::commons::SparsePartialKeys<PartialKeyType>::estimateSize(numberEntries) + baseSize;
@@ -116,21 +118,22 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 	PartialKeyType __restrict__ * targetMasks = mPartialKeys.mEntries;
 
 	PartialKeyConversionInformation const & conversionInformation = getConversionInformation(sourceNode, insertInformation);
+	hot::commons::ParallelBitMask<uint32_t> const conversion(conversionInformation.mConversionMask);
 	hot::commons::DiscriminativeBit const & keyInformation = insertInformation.mKeyInformation;
 
 	unsigned int firstIndexInAffectedSubtree = insertInformation.getFirstIndexInAffectedSubtree();
 	unsigned int numberEntriesInAffectedSubtree = insertInformation.getNumberEntriesInAffectedSubtree();
 
 	for(unsigned int i = 0u; i < firstIndexInAffectedSubtree; ++i) {
-		targetMasks[i] = _pdep_u32(existingMasks[i], conversionInformation.mConversionMask);
+		targetMasks[i] = conversion.depositBits(existingMasks[i]);
 		targetPointers[i] = existingPointers[i];
 	}
 
-	uint32_t convertedSubTreePrefixMask = _pdep_u32(insertInformation.mSubtreePrefixPartialKey, conversionInformation.mConversionMask);
+	uint32_t convertedSubTreePrefixMask = conversion.depositBits(insertInformation.mSubtreePrefixPartialKey);
 	unsigned int firstIndexAfterAffectedSubtree = firstIndexInAffectedSubtree + numberEntriesInAffectedSubtree;
 	if(keyInformation.mValue) {
 		for (unsigned int i = firstIndexInAffectedSubtree; i < firstIndexAfterAffectedSubtree; ++i) {
-			targetMasks[i] = _pdep_u32(existingMasks[i], conversionInformation.mConversionMask);
+			targetMasks[i] = conversion.depositBits(existingMasks[i]);
 			targetPointers[i] = existingPointers[i];
 		}
 		targetMasks[firstIndexAfterAffectedSubtree] = static_cast<PartialKeyType>(convertedSubTreePrefixMask | conversionInformation.mAdditionalMask);
@@ -140,14 +143,14 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 		targetPointers[firstIndexInAffectedSubtree] = newValue;
 		for (unsigned int i = firstIndexInAffectedSubtree; i < firstIndexAfterAffectedSubtree; ++i) {
 			unsigned int targetIndex = i + 1u;
-			targetMasks[targetIndex] = static_cast<PartialKeyType>(_pdep_u32(existingMasks[i], conversionInformation.mConversionMask) | conversionInformation.mAdditionalMask);
+			targetMasks[targetIndex] = static_cast<PartialKeyType>(conversion.depositBits(existingMasks[i]) | conversionInformation.mAdditionalMask);
 			targetPointers[targetIndex] = existingPointers[i];
 		}
 	}
 
 	for(unsigned int i = firstIndexAfterAffectedSubtree; i < oldNumberEntries; ++i) {
 		unsigned int targetIndex = i + 1u;
-		targetMasks[targetIndex] = _pdep_u32(existingMasks[i], conversionInformation.mConversionMask);
+		targetMasks[targetIndex] = conversion.depositBits(existingMasks[i]);
 		targetPointers[targetIndex] = existingPointers[i];
 	}
 }
@@ -172,10 +175,11 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 	//This is important for the tree to have fast lookup and maintain integrity!! the first mask always is zero!!
 	targetMasks[0] = 0u;
 
+	hot::commons::ParallelBitMask<uint32_t> const compression(compressionMask);
 	for(uint32_t targetIndex = 1; targetIndex < numberEntriesInRange; ++targetIndex) {
 		uint32_t sourceIndex = firstIndexInRange + targetIndex;
 		targetPointers[targetIndex] = sourcePointers[sourceIndex];
-		targetMasks[targetIndex] = _pext_u32(sourceMasks[sourceIndex], compressionMask);
+		targetMasks[targetIndex] = compression.extractBits(sourceMasks[sourceIndex]);
 	}
 
 	assert(getMaskForLargerEntries() != this->mUsedEntriesMask);
@@ -195,8 +199,10 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 	hot::commons::DiscriminativeBit const & keyInformation = insertInformation.mKeyInformation;
 
 	PartialKeyType additionalBitConversionMask = conversionInformation.mConversionMask;
+	hot::commons::ParallelBitMask<uint32_t> const compression(compressionMask);
+	hot::commons::ParallelBitMask<uint32_t> const additionalBitConversion(additionalBitConversionMask);
 
-	PartialKeyType newMask = static_cast<PartialKeyType>(_pdep_u32(_pext_u32(insertInformation.mSubtreePrefixPartialKey, compressionMask), additionalBitConversionMask))
+	PartialKeyType newMask = static_cast<PartialKeyType>(additionalBitConversion.depositBits(compression.extractBits(insertInformation.mSubtreePrefixPartialKey)))
 		| (keyInformation.mValue * conversionInformation.mAdditionalMask);
 
 	//%32 to ensure it works in case of 0 for affected subtree
@@ -213,7 +219,7 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 
 	for(unsigned int targetIndex = 0; targetIndex < numberEntriesBeforeAffectedSubtree; ++targetIndex) {
 		unsigned int sourceIndex = firstIndexInRange + targetIndex;
-		targetMasks[targetIndex] = _pdep_u32(_pext_u32(existingMasks[sourceIndex], compressionMask), additionalBitConversionMask);
+		targetMasks[targetIndex] = additionalBitConversion.depositBits(compression.extractBits(existingMasks[sourceIndex]));
 		targetPointers[targetIndex] = existingPointers[sourceIndex];
 	}
 
@@ -225,7 +231,7 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 		unsigned int sourceIndex = originalFirstIndexInAffectedSubtree + indexInAffectedSubtree;
 		unsigned int targetIndex = firstTargetIndexInAffectedSubtree + indexInAffectedSubtree;
 
-		targetMasks[targetIndex] = _pdep_u32(_pext_u32(existingMasks[sourceIndex], compressionMask), additionalBitConversionMask) | additionalMaskForExistingEntries;
+		targetMasks[targetIndex] = additionalBitConversion.depositBits(compression.extractBits(existingMasks[sourceIndex])) | additionalMaskForExistingEntries;
 		targetPointers[targetIndex] = existingPointers[sourceIndex];
 	}
 
@@ -236,7 +242,7 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 	for(unsigned int indexAfterAffectedSubtree = 0; indexAfterAffectedSubtree < numberEntriesAfterAffectedSubtree; ++indexAfterAffectedSubtree) {
 		unsigned int sourceIndex = sourceIndexAfterAffectedSubtree + indexAfterAffectedSubtree;
 		unsigned int targetIndex = firstTargeIndexAfterAffectedSubtree + indexAfterAffectedSubtree;
-		targetMasks[targetIndex] = _pdep_u32(_pext_u32(existingMasks[sourceIndex], compressionMask), additionalBitConversionMask);
+		targetMasks[targetIndex] = additionalBitConversion.depositBits(compression.extractBits(existingMasks[sourceIndex]));
 		targetPointers[targetIndex] = existingPointers[sourceIndex];
 	}
 
@@ -250,11 +256,11 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 	assert(getMaskForLargerEntries() != this->mUsedEntriesMask);
 }
 
-template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inline HOTRowexChildPointer const * HOTRowexNode<DiscriminativeBitsRepresentation, PartialKeyType>::search(uint8_t const * keyBytes) const {
+template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> template<typename KeyBytesType> inline HOTRowexChildPointer const * HOTRowexNode<DiscriminativeBitsRepresentation, PartialKeyType>::search(KeyBytesType const & keyBytes) const {
 	return this->getPointers() + this->toResultIndex(mPartialKeys.search(mDiscriminativeBitsRepresentation.extractMask(keyBytes)));
 }
 
-template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inline HOTRowexChildPointer* HOTRowexNode<DiscriminativeBitsRepresentation, PartialKeyType>::searchForInsert(hot::commons::SearchResultForInsert & searchResultOut, uint8_t const * keyBytes) const {
+template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> template<typename KeyBytesType> inline HOTRowexChildPointer* HOTRowexNode<DiscriminativeBitsRepresentation, PartialKeyType>::searchForInsert(hot::commons::SearchResultForInsert & searchResultOut, KeyBytesType const & keyBytes) const {
 	uint32_t resultIndex = this->toResultIndex(mPartialKeys.search(mDiscriminativeBitsRepresentation.extractMask(keyBytes)));
 	searchResultOut.init(resultIndex, mDiscriminativeBitsRepresentation.mMostSignificantDiscriminativeBitIndex);
 	return this->mFirstChildPointer + resultIndex;
@@ -282,7 +288,7 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inl
 
 	assert(affectedSubtreeMask != 0);
 	uint32_t firstIndexInAffectedSubtree = __builtin_ctz(affectedSubtreeMask);
-	uint32_t numberEntriesInAffectedSubtree = _mm_popcnt_u32(affectedSubtreeMask);
+	uint32_t numberEntriesInAffectedSubtree = hot::commons::populationCount32(affectedSubtreeMask);
 
 	return { subtreePrefixMask, firstIndexInAffectedSubtree, numberEntriesInAffectedSubtree, discriminativeBit };
 }
@@ -389,7 +395,7 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inl
 	uint32_t largerEntries = getMaskForLargerEntries();
 	assert(largerEntries != 0);
 
-	uint32_t numberLargerEntries = _mm_popcnt_u32(largerEntries);
+	uint32_t numberLargerEntries = hot::commons::populationCount32(largerEntries);
 	uint32_t numberSmallerEntries = this->getNumberEntries() - numberLargerEntries;
 
 	assert(insertInformation.getNumberEntriesInAffectedSubtree() > 0);
@@ -418,7 +424,7 @@ typename HOTRowexNode<DiscriminativeBitsRepresentation, PartialKeyType>::Partial
 	SourcePartialKeyType compressionMask, hot::commons::InsertInformation const & insertionInformation
 ) const
 {
-	uint32_t allIntermediateMaskBits = _pext_u32(compressionMask, compressionMask);
+	uint32_t allIntermediateMaskBits = hot::commons::extractBits32(compressionMask, compressionMask);
 	return getConversionInformation(allIntermediateMaskBits, insertionInformation);
 }
 
@@ -454,7 +460,7 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inl
 
 		uint32_t rangeMask = ((UINT32_MAX >> (32 - numberEntriesInRange))) << minEntryIndexInRange;
 		uint32_t upperEntriesMask = mPartialKeys.findMasksByPattern(mostSignificantMaskBitInRange) & rangeMask;
-		size_t minimumUpperRangeEntryIndex = __tzcnt_u32(upperEntriesMask);
+		size_t minimumUpperRangeEntryIndex = hot::commons::countTrailingZeros32(upperEntriesMask);
 		size_t numberEntriesInLowerHalf = minimumUpperRangeEntryIndex - minEntryIndexInRange;
 		size_t numberEntriesInUpperHalf = numberEntriesInRange - numberEntriesInLowerHalf;
 		collectEntryDepth(entryDepths, minEntryIndexInRange, numberEntriesInLowerHalf, currentDepth + 1, usedMaskBits);
@@ -505,8 +511,8 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inl
 
 		int significantBitValue = significantBitValueStack[stackIndex];
 		if(significantBitValue == -1) {
-			if(_mm_popcnt_u32(entriesMask) == 1) {
-				uint entryIndex = __tzcnt_u32(entriesMask);
+			if(hot::commons::populationCount32(entriesMask) == 1) {
+				uint entryIndex = hot::commons::countTrailingZeros32(entriesMask);
 				uint32_t entryMask = 1l << entryIndex;
 				if((entryMask & entriesVisitedMask) != 0) {
 					std::cout << "Mask for path [";
@@ -534,8 +540,8 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inl
 				uint parentStackIndex = stackIndex - 1;
 				uint32_t currentSubtreeMask = entriesMaskStack[stackIndex];
 				assert(currentSubtreeMask != 0);
-				unsigned int firstBitInRange = _tzcnt_u32(currentSubtreeMask);
-				PartialKeyType subTreeBits = mPartialKeys.getRelevantBitsForRange(firstBitInRange, _mm_popcnt_u32(currentSubtreeMask));
+				unsigned int firstBitInRange = hot::commons::countTrailingZeros32(currentSubtreeMask);
+				PartialKeyType subTreeBits = mPartialKeys.getRelevantBitsForRange(firstBitInRange, hot::commons::populationCount32(currentSubtreeMask));
 				mostSignificantBitStack[stackIndex] = mDiscriminativeBitsRepresentation.getMostSignifikantMaskBit(subTreeBits);
 				prefixStack[stackIndex] = prefixStack[parentStackIndex] + (significantBitValueStack[parentStackIndex] * mostSignificantBitStack[parentStackIndex]);
 				subtreeBitsUsedStack[stackIndex] = subTreeBits & ~(mostSignificantBitStack[stackIndex]);
@@ -601,7 +607,7 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inl
 	std::map<uint16_t, uint16_t> maskBitMapping;
 	for(uint16_t extractionBitIndex : mDiscriminativeBitsRepresentation.getDiscriminativeBits()) {
 		uint32_t singleBitMask = mDiscriminativeBitsRepresentation.getMaskFor({ extractionBitIndex, 1 });
-		uint maskBitPosition = __tzcnt_u32(singleBitMask);
+		uint maskBitPosition = hot::commons::countTrailingZeros32(singleBitMask);
 		maskBitMapping[extractionBitIndex] = maskBitPosition;
 	}
 	return maskBitMapping;
@@ -612,6 +618,6 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inl
 	return mPartialKeys.printMasks(this->mUsedEntriesMask, getExtractionMaskToEntriesMasksMapping(), out);
 };
 
-}}
+}}}
 
 #endif
\ No newline at end of file
@@ -10,10 +10,11 @@
 
 #include "hot/rowex/HOTRowexNodeBaseInterface.hpp"
 #include "hot/rowex/HOTRowexChildPointerInterface.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
 constexpr uint32_t ALL_ENTRIES_USED_SIMD_COB_TRIE_INCREMENTAL = UINT32_MAX; //32 1 bits
 
-namespace hot { namespace rowex {
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 HOTRowexNodeBase::HOTRowexNodeBase(uint16_t const height, hot::commons::NodeAllocationInformation const & nodeAllocationInformation)
 	: mFirstChildPointer(reinterpret_cast<HOTRowexChildPointer*>(reinterpret_cast<char*>(this) + nodeAllocationInformation.mPointerOffset)), mUsedEntriesMask(nodeAllocationInformation.mEntriesMask), mHeight(height), mLock(), mIsObsolete(false) {
@@ -95,6 +96,6 @@ inline typename HOTRowexNodeBase::const_iterator HOTRowexNodeBase::end() const
 	return getPointers() + getNumberEntries();
 }
 
-}}
+}}}
 
 #endif
\ No newline at end of file
@@ -11,9 +11,10 @@
 
 #include "hot/rowex/HOTRowexChildPointerInterface.hpp"
 #include "hot/rowex/SpinLock.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
 
-namespace hot { namespace rowex {
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 constexpr size_t SIMD_COB_TRIE_NODE_ALIGNMENT = 8;
 
@@ -158,6 +159,6 @@ public:
 	inline const_iterator end() const;
 };
 
-}}
+}}}
 
 #endif
@@ -14,9 +14,10 @@
 #include <hot/commons/SearchResultForInsert.hpp>
 
 #include "hot/rowex/HOTRowexNodeBaseInterface.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
 
-namespace hot { namespace rowex {
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> struct alignas(SIMD_COB_TRIE_NODE_ALIGNMENT) HOTRowexNode;
 
@@ -138,10 +139,10 @@ public:
 	 * 	4. returns the result candidate at this location
 	 *
 	 *
-	 * @param keyBytes the key bytes of the search key
+	 * @param keyBytes the key bytes of the search key, which are either a pointer to the bytes of a fixed size key or a { @link idx::contenthelpers::KeyBytesView } of a variable length key
 	 * @return the result candidate
 	 */
-	inline HOTRowexChildPointer const * search(uint8_t const * keyBytes) const;
+	template<typename KeyBytesType> inline HOTRowexChildPointer const * search(KeyBytesType const & keyBytes) const;
 
 	/**
 	 * searches the node and returns a potential result candidate by:
@@ -154,10 +155,10 @@ public:
 	 * and the index of the result candidate. Both informations are required in HOT's insertion algorithm
 	 *
 	 * @param searchResultOut an outparameter for the additional result information
-	 * @param keyBytes the key bytes of the search key
+	 * @param keyBytes the key bytes of the search key, which are either a pointer to the bytes of a fixed size key or a { @link idx::contenthelpers::KeyBytesView } of a variable length key
 	 * @return the result candidate
 	 */
-	inline HOTRowexChildPointer* searchForInsert(hot::commons::SearchResultForInsert & searchResultOut, uint8_t const * keyBytes) const;
+	template<typename KeyBytesType> inline HOTRowexChildPointer* searchForInsert(hot::commons::SearchResultForInsert & searchResultOut, KeyBytesType const & keyBytes) const;
 
 	/**
 	 * Determines the information required to insert a new entry in the node.
@@ -291,6 +292,6 @@ private:
 
 };
 
-}}
+}}}
 
 #endif
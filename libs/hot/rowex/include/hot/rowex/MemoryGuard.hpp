@@ -2,8 +2,9 @@
 #define __HOT__ROWEX__MEMORY_GUARD__
 
 #include "hot/rowex/EpochBasedMemoryReclamationStrategy.hpp"
+#include "hot/commons/InstructionSet.hpp"
 
-namespace hot { namespace rowex {
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 class MemoryGuard {
 	EpochBasedMemoryReclamationStrategy* mMemoryReclamation;
@@ -21,6 +22,6 @@ public:
 	MemoryGuard &operator=(MemoryGuard const & other) = delete;
 };
 
-}}
+}}}
 
 #endif // __HOT_MEMORY_GUARD__
\ No newline at end of file
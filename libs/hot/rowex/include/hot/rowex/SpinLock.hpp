@@ -3,7 +3,9 @@
 
 #include <atomic>
 
-namespace hot { namespace rowex {
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 class SpinLock {
 	std::atomic_flag mFlag;
@@ -25,6 +27,6 @@ public:
 
 };
 
-}}
+}}}
 
 #endif
\ No newline at end of file
@@ -5,8 +5,9 @@
 #include <vector>
 
 #include "hot/rowex/HOTRowexChildPointer.hpp"
+#include "hot/commons/InstructionSet.hpp"
 
-namespace hot { namespace rowex {
+namespace hot { namespace rowex { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 constexpr uint32_t NUMBER_EPOCHS = 3;
 constexpr uint32_t NOT_IN_EPOCH = NUMBER_EPOCHS;
@@ -74,6 +75,6 @@ private:
 
 std::atomic<size_t> ThreadSpecificEpochBasedReclamationInformation::mNumberFrees { 0 };
 
-}}
+}}}
 
 #endif
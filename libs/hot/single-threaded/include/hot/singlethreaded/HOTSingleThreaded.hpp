@@ -1,19 +1,28 @@
 #ifndef __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED__
 #define __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED__
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstdint>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <set>
 #include <map>
 #include <numeric>
 #include <cstring>
+#include <string>
+#include <vector>
 
 
 #include <hot/commons/Algorithms.hpp>
 #include <hot/commons/BiNode.hpp>
+#include <hot/commons/BulkLoader.hpp>
 #include <hot/commons/DiscriminativeBit.hpp>
 #include <hot/commons/InsertInformation.hpp>
 #include <hot/commons/TwoEntriesNode.hpp>
@@ -26,79 +35,476 @@
 
 #include "hot/singlethreaded/HOTSingleThreadedIterator.hpp"
 #include "hot/singlethreaded/HOTSingleThreadedDeletionInformation.hpp"
+#include "hot/singlethreaded/HOTSingleThreadedFrozen.hpp"
+#include "hot/singlethreaded/HOTSingleThreadedSnapshot.hpp"
 
 #include "idx/contenthelpers/KeyUtilities.hpp"
 #include "idx/contenthelpers/TidConverters.hpp"
 #include "idx/contenthelpers/ContentEquals.hpp"
 #include "idx/contenthelpers/KeyComparator.hpp"
 #include "idx/contenthelpers/OptionalValue.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace singlethreaded {
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
-template<typename ValueType, template <typename> typename KeyExtractor> KeyExtractor<ValueType> HOTSingleThreaded<ValueType, KeyExtractor>::extractKey;
-template<typename ValueType, template <typename> typename KeyExtractor>
-	typename idx::contenthelpers::KeyComparator<typename  HOTSingleThreaded<ValueType, KeyExtractor>::KeyType>::type
-	HOTSingleThreaded<ValueType, KeyExtractor>::compareKeys;
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> KeyExtractor<ValueType> HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::extractKey;
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy>
+	typename idx::contenthelpers::KeyComparator<typename  HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::KeyType>::type
+	HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::compareKeys;
 
-template<typename ValueType, template <typename> typename KeyExtractor> typename HOTSingleThreaded<ValueType, KeyExtractor>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor>::END_ITERATOR {};
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::END_ITERATOR {};
 
-template<typename ValueType, template <typename> typename KeyExtractor> HOTSingleThreaded<ValueType, KeyExtractor>::HOTSingleThreaded() : mRoot {} {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> constexpr size_t HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::MAXIMUM_KEY_LENGTH;
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::HOTSingleThreaded() : mRoot {}, mNodeAllocatorPolicy {}, mSnapshotRegistry {}, mCompactionPosition {}, mRebalancingPosition {} {
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> HOTSingleThreaded<ValueType, KeyExtractor>::HOTSingleThreaded(HOTSingleThreaded && other) {
-	mRoot = other.mRoot;
-	other.mRoot = {};
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::HOTSingleThreaded(HOTSingleThreaded && other) : mRoot {}, mNodeAllocatorPolicy {}, mSnapshotRegistry {}, mCompactionPosition {}, mRebalancingPosition {} {
+	std::swap(mRoot, other.mRoot);
+	//the nodes are moved together with the allocator they were allocated from and the registry of the snapshots sharing them
+	mNodeAllocatorPolicy.swap(other.mNodeAllocatorPolicy);
+	std::swap(mSnapshotRegistry, other.mSnapshotRegistry);
+	std::swap(mCompactionPosition, other.mCompactionPosition);
+	std::swap(mRebalancingPosition, other.mRebalancingPosition);
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> HOTSingleThreaded<ValueType, KeyExtractor> & HOTSingleThreaded<ValueType, KeyExtractor>::operator=(HOTSingleThreaded && other) {
-	mRoot = other.mRoot;
-	other.mRoot = {};
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy> & HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::operator=(HOTSingleThreaded && other) {
+	//the previously contained nodes are released by the destructor of other
+	std::swap(mRoot, other.mRoot);
+	mNodeAllocatorPolicy.swap(other.mNodeAllocatorPolicy);
+	std::swap(mSnapshotRegistry, other.mSnapshotRegistry);
+	std::swap(mCompactionPosition, other.mCompactionPosition);
+	std::swap(mRebalancingPosition, other.mRebalancingPosition);
 	return *this;
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> HOTSingleThreaded<ValueType, KeyExtractor>::~HOTSingleThreaded() {
-	mRoot.deleteSubtree();
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::~HOTSingleThreaded() {
+	SnapshotRegistryScope snapshotRegistryScope { activateSnapshotRegistry() };
+	//snapshots reference the nodes of this trie, hence they must not outlive it
+	assert(!mSnapshotRegistry || !mSnapshotRegistry->hasLiveSnapshots());
+	mNodeAllocatorPolicy.deleteAllNodes(mRoot);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline void HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::clear() {
+	SnapshotRegistryScope snapshotRegistryScope { activateSnapshotRegistry() };
+	mNodeAllocatorPolicy.deleteAllNodes(mRoot);
+	mRoot = HOTSingleThreadedChildPointer();
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> inline bool HOTSingleThreaded<ValueType, KeyExtractor>::isEmpty() const {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline bool HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::isEmpty() const {
 	return !mRoot.isLeaf() & (mRoot.getNode() == nullptr);
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> inline bool HOTSingleThreaded<ValueType, KeyExtractor>::isRootANode() const {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline bool HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::isRootANode() const {
 	return mRoot.isNode() & (mRoot.getNode() != nullptr);
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor>inline __attribute__((always_inline)) idx::contenthelpers::OptionalValue<ValueType> HOTSingleThreaded<ValueType, KeyExtractor>::lookup(HOTSingleThreaded<ValueType, KeyExtractor>::KeyType const &key) {
-	auto const & fixedSizeKey = idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(key));
-	uint8_t const* byteKey = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy>inline __attribute__((always_inline)) idx::contenthelpers::OptionalValue<ValueType> HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::lookup(HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::KeyType const &key) const {
+	auto const & fixedSizeKey = idx::contenthelpers::toByteComparableKey(key);
+	auto byteKey = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
 
 	HOTSingleThreadedChildPointer current =  mRoot;
 	while((!current.isLeaf()) & (current.getNode() != nullptr)) {
-		HOTSingleThreadedChildPointer const * const & currentChildPointer = current.search(byteKey);
+		HOTSingleThreadedChildPointer const * const & currentChildPointer = current.search<MAXIMUM_KEY_LENGTH>(byteKey);
 		current = *currentChildPointer;
 	}
 	return current.isLeaf() ? extractAndMatchLeafValue(current, key) : idx::contenthelpers::OptionalValue<ValueType>();
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor>idx::contenthelpers::OptionalValue <ValueType> HOTSingleThreaded<ValueType, KeyExtractor>::extractAndMatchLeafValue( HOTSingleThreadedChildPointer const & current, HOTSingleThreaded<ValueType, KeyExtractor>::KeyType const &key) {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline void HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::lookupBatch(HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::KeyType const * keys, size_t numberKeys, idx::contenthelpers::OptionalValue<ValueType> * results) const {
+	using FixedSizeKeyType = typename std::decay<decltype(idx::contenthelpers::toByteComparableKey(std::declval<KeyType>()))>::type;
+
+	std::array<FixedSizeKeyType, LOOKUP_BATCH_WINDOW_SIZE> fixedSizeKeys;
+	std::array<HOTSingleThreadedChildPointer, LOOKUP_BATCH_WINDOW_SIZE> currentPointers;
+
+	//the keys are processed in windows, to bound the number of concurrently traversed paths and the space required for the fixed size keys
+	for(size_t windowStart = 0u; windowStart < numberKeys; windowStart += LOOKUP_BATCH_WINDOW_SIZE) {
+		size_t windowSize = std::min(LOOKUP_BATCH_WINDOW_SIZE, numberKeys - windowStart);
+		KeyType const * windowKeys = keys + windowStart;
+
+		for(size_t i = 0u; i < windowSize; ++i) {
+			fixedSizeKeys[i] = idx::contenthelpers::toByteComparableKey(windowKeys[i]);
+			currentPointers[i] = mRoot;
+		}
+
+		if(mRoot.isAValidNode()) {
+			mRoot.prefetch();
+		}
+
+		//each round descends every unfinished path by exactly one node. The node of the next level is prefetched right away,
+		//so it can be loaded while the nodes of the remaining paths in this window are searched.
+		bool hasUnfinishedPaths = mRoot.isAValidNode();
+		while(hasUnfinishedPaths) {
+			hasUnfinishedPaths = false;
+			for(size_t i = 0u; i < windowSize; ++i) {
+				HOTSingleThreadedChildPointer & current = currentPointers[i];
+				if(current.isAValidNode()) {
+					auto byteKey = idx::contenthelpers::interpretAsByteArray(fixedSizeKeys[i]);
+					current = *current.executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](const auto & node) {
+						return node.search(byteKey);
+					});
+					if(current.isLeaf()) {
+						idx::contenthelpers::prefetchTid<ValueType>(current.getTid());
+					} else {
+						current.prefetch();
+						hasUnfinishedPaths = true;
+					}
+				}
+			}
+		}
+
+		for(size_t i = 0u; i < windowSize; ++i) {
+			results[windowStart + i] = currentPointers[i].isLeaf() ? extractAndMatchLeafValue(currentPointers[i], windowKeys[i]) : idx::contenthelpers::OptionalValue<ValueType>();
+		}
+	}
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy>idx::contenthelpers::OptionalValue <ValueType> HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::extractAndMatchLeafValue( HOTSingleThreadedChildPointer const & current, HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::KeyType const &key) const {
 	ValueType const & value = idx::contenthelpers::tidToValue<ValueType>(current.getTid());
 	return { idx::contenthelpers::contentEquals(extractKey(value), key), value };
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor>inline idx::contenthelpers::OptionalValue<ValueType> HOTSingleThreaded<ValueType, KeyExtractor>::scan(KeyType const &key, size_t numberValues) const {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy>inline idx::contenthelpers::OptionalValue<ValueType> HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::scan(KeyType const &key, size_t numberValues) const {
+#ifdef USE_ORDER_STATISTICS
+	//the scanned values are skipped using the subtree counts instead of visiting them one by one
+	size_t firstRank = rank(key);
+	size_t numberValuesInTrie = mRoot.getNumberValuesInSubtree();
+	const_iterator iterator = (numberValues < (numberValuesInTrie - firstRank)) ? select(firstRank + numberValues) : END_ITERATOR;
+#else
 	const_iterator iterator = lower_bound(key);
 	for(size_t i = 0u; i < numberValues && iterator != end(); ++i) {
 		++iterator;
 	}
+#endif
 	return iterator == end() ? idx::contenthelpers::OptionalValue<ValueType>({}) : idx::contenthelpers::OptionalValue<ValueType>({ true, *iterator });
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor>inline unsigned int HOTSingleThreaded<ValueType, KeyExtractor>::searchForInsert(uint8_t const * keyBytes, std::array<HOTSingleThreadedInsertStackEntry, 64> & insertStack) {
+#ifdef USE_ORDER_STATISTICS
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline size_t HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::rank(KeyType const & key) const {
+	return getRankOfBound(key, true);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::select(size_t rank) const {
+	if(rank >= mRoot.getNumberValuesInSubtree()) {
+		return END_ITERATOR;
+	}
+
+	const_iterator it(&mRoot, &mRoot + 1);
+	HOTSingleThreadedChildPointer const * current = &mRoot;
+	size_t remainingRank = rank;
+	while(current->isAValidNode()) {
+		HOTSingleThreadedNodeBase const * node = current->getNode();
+		size_t entryIndex = 0u;
+		size_t numberValuesInEntry = node->getNumberValuesInSubtreeOfEntry(entryIndex);
+		while(remainingRank >= numberValuesInEntry) {
+			remainingRank -= numberValuesInEntry;
+			numberValuesInEntry = node->getNumberValuesInSubtreeOfEntry(++entryIndex);
+		}
+		current = it.descend(node->getPointers() + entryIndex, node->end());
+	}
+	return it;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline size_t HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::count(KeyType const & lowerKey, KeyType const & upperKey) const {
+	return compareKeys(upperKey, lowerKey) ? 0u : (getRankOfBound(upperKey, false) - getRankOfBound(lowerKey, true));
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline size_t HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::getRankOfBound(KeyType const & key, bool is_lower_bound) const {
+	if(mRoot.isLeaf()) {
+		KeyType const & existingKey = extractKey(idx::contenthelpers::tidToValue<ValueType>(mRoot.getTid()));
+		return (compareKeys(existingKey, key) || (!is_lower_bound && idx::contenthelpers::contentEquals(existingKey, key))) ? 1u : 0u;
+	}
+
+	const_iterator const & bound = lower_or_upper_bound(key, is_lower_bound);
+	if(bound == END_ITERATOR) {
+		return mRoot.getNumberValuesInSubtree();
+	}
+
+	//the rank is the sum of the values contained in all entries preceding the bound's path
+	size_t rank = 0u;
+	for(size_t depth = 1u; depth <= bound.mCurrentDepth; ++depth) {
+		HOTSingleThreadedNodeBase const * node = bound.mNodeStack[depth - 1u].getCurrent()->getNode();
+		rank += node->getNumberValuesBeforeEntry(static_cast<size_t>(bound.mNodeStack[depth].getCurrent() - node->getPointers()));
+	}
+	return rank;
+}
+#endif
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> template<typename Visitor> inline size_t HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::scanRange(KeyType const & lowerKey, KeyType const & upperKey, Visitor && visitor) const {
+	if(compareKeys(upperKey, lowerKey)) {
+		return 0u;
+	}
+
+	return visitBatchesStartingAtLowerBound(lowerKey, SIZE_MAX, [&](ValueType const * values, size_t numberValues) -> size_t {
+		//as the values are sorted, a batch whose last value is in range is entirely contained in the range
+		if(!compareKeys(upperKey, extractKey(values[numberValues - 1u]))) {
+			return numberValues;
+		}
+		return static_cast<size_t>(std::upper_bound(values, values + numberValues, upperKey, [](KeyType const & key, ValueType const & value) {
+			return compareKeys(key, extractKey(value));
+		}) - values);
+	}, visitor);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> template<typename Visitor> inline size_t HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::scanRangeWithLimit(KeyType const & lowerKey, size_t limit, Visitor && visitor) const {
+	return visitBatchesStartingAtLowerBound(lowerKey, limit, [](ValueType const * /* values */, size_t numberValues) -> size_t {
+		return numberValues;
+	}, visitor);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> template<typename BatchLimiter, typename Visitor> inline size_t HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::visitBatchesStartingAtLowerBound(KeyType const & lowerKey, size_t maximumNumberValues, BatchLimiter && limitBatch, Visitor && visitor) const {
+	if(isEmpty() || maximumNumberValues == 0u) {
+		return 0u;
+	}
+
+	std::array<ValueType, MAXIMUM_NUMBER_NODE_ENTRIES> batch {};
+	if(mRoot.isLeaf()) {
+		batch[0] = idx::contenthelpers::tidToValue<ValueType>(mRoot.getTid());
+		size_t numberValuesToVisit = compareKeys(extractKey(batch[0]), lowerKey) ? 0u : limitBatch(batch.data(), 1u);
+		if(numberValuesToVisit > 0u) {
+			visitor(batch.data(), numberValuesToVisit);
+		}
+		return numberValuesToVisit;
+	}
+
+	const_iterator bound = lower_bound(lowerKey);
+	if(bound == END_ITERATOR) {
+		return 0u;
+	}
+
+	//the bound's stack is used to traverse the remaining entries. As the entries on the path to the bound are already descended, each ancestor continues after its current entry
+	HOTSingleThreadedIteratorStackEntry* nodeStack = bound.mNodeStack;
+	size_t depth = bound.mCurrentDepth;
+	for(size_t ancestorDepth = 0u; ancestorDepth < depth; ++ancestorDepth) {
+		nodeStack[ancestorDepth].advance();
+	}
+
+	return visitBatchesOnStack(nodeStack, depth, maximumNumberValues, limitBatch, visitor);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> template<typename BatchLimiter, typename Visitor> inline size_t HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::visitBatchesOnStack(HOTSingleThreadedIteratorStackEntry* nodeStack, size_t depth, size_t maximumNumberValues, BatchLimiter && limitBatch, Visitor && visitor) {
+	std::array<ValueType, MAXIMUM_NUMBER_NODE_ENTRIES> batch {};
+	size_t numberVisitedValues = 0u;
+	while(true) {
+		HOTSingleThreadedChildPointer const * current = nodeStack[depth].getCurrent();
+		HOTSingleThreadedChildPointer const * end = nodeStack[depth].getEnd();
+
+		//no more leaf values are converted than can still be visited, which keeps short scans cheap
+		size_t maximumBatchSize = maximumNumberValues - numberVisitedValues;
+		size_t batchSize = 0u;
+		for(; current != end && current->isLeaf() && batchSize < maximumBatchSize; ++current) {
+			batch[batchSize++] = idx::contenthelpers::tidToValue<ValueType>(current->getTid());
+		}
+
+		if(batchSize > 0u) {
+			size_t numberValuesToVisit = limitBatch(batch.data(), batchSize);
+			if(numberValuesToVisit > 0u) {
+				visitor(batch.data(), numberValuesToVisit);
+			}
+			numberVisitedValues += numberValuesToVisit;
+			if(numberValuesToVisit < batchSize || numberVisitedValues == maximumNumberValues) {
+				return numberVisitedValues;
+			}
+		}
+
+		if(current != end) {
+			nodeStack[depth].init(current + 1, end);
+			HOTSingleThreadedNodeBase* childNode = current->getNode();
+			nodeStack[++depth].init(childNode->begin(), childNode->end());
+		} else if(depth == 0u) {
+			return numberVisitedValues;
+		} else {
+			--depth;
+		}
+	}
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> template<typename Visitor> inline size_t HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::prefixScan(char const * prefix, size_t prefixLength, Visitor && visitor) const {
+	static_assert(std::is_same<KeyType, char const *>::value, "prefix scans are only supported for c string keys");
+
+	//no key can start with a prefix which does not fit into the fixed size key representation including the terminating zero byte
+	if(isEmpty() || prefixLength >= idx::contenthelpers::getMaxKeyLength<KeyType>()) {
+		return 0u;
+	}
+
+	//the prefix is searched in place, the bytes following it are treated as zero bytes
+	idx::contenthelpers::KeyBytesView const prefixBytes { reinterpret_cast<uint8_t const *>(prefix), prefixLength };
+	uint16_t prefixBitLength = static_cast<uint16_t>(prefixLength * 8u);
+
+	HOTSingleThreadedChildPointer const * firstEntry = &mRoot;
+	HOTSingleThreadedChildPointer const * entriesEnd = &mRoot + 1;
+	bool isRangeDetermined = false;
+	while(!isRangeDetermined && firstEntry->isNode()) {
+		isRangeDetermined = firstEntry->executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(true, [&](auto const & node) -> bool {
+			if(node.mDiscriminativeBitsRepresentation.mMostSignificantDiscriminativeBitIndex >= prefixBitLength) {
+				//all keys contained in the node share the bits of the prefix
+				firstEntry = node.getPointers();
+				entriesEnd = node.end();
+				return true;
+			}
+			//the entries sharing the prefix bits with the searched entry form a subtree of the node, exactly like the entries affected by an insert at the first bit following the prefix
+			HOTSingleThreadedChildPointer const * searchedEntry = node.search(prefixBytes);
+			hot::commons::InsertInformation const & prefixSubtree = node.getInsertInformation(static_cast<uint>(searchedEntry - node.getPointers()), hot::commons::DiscriminativeBit(prefixBitLength));
+			firstEntry = node.getPointers() + prefixSubtree.getFirstIndexInAffectedSubtree();
+			entriesEnd = firstEntry + prefixSubtree.getNumberEntriesInAffectedSubtree();
+			return prefixSubtree.getNumberEntriesInAffectedSubtree() > 1u;
+		});
+	}
+
+	//all keys in the determined entries share the prefix bits, hence they either all start with the prefix or none does
+	HOTSingleThreadedChildPointer const * leafEntry = firstEntry;
+	while(leafEntry->isNode()) {
+		leafEntry = leafEntry->getNode()->getPointers();
+	}
+	if(std::strncmp(extractKey(idx::contenthelpers::tidToValue<ValueType>(leafEntry->getTid())), prefix, prefixLength) != 0) {
+		return 0u;
+	}
+
+	std::array<HOTSingleThreadedIteratorStackEntry, 64> nodeStack;
+	nodeStack[0].init(firstEntry, entriesEnd);
+	return visitBatchesOnStack(nodeStack.data(), 0u, SIZE_MAX, [](ValueType const * /* values */, size_t numberValues) -> size_t {
+		return numberValues;
+	}, visitor);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline idx::contenthelpers::OptionalValue<ValueType> HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::longestPrefixMatch(KeyType const & key) const {
+	static_assert(std::is_same<KeyType, char const *>::value, "longest prefix matches are only supported for c string keys");
+
+	if(isEmpty()) {
+		return idx::contenthelpers::OptionalValue<ValueType>();
+	} else if(mRoot.isLeaf()) {
+		ValueType const & existingValue = idx::contenthelpers::tidToValue<ValueType>(mRoot.getTid());
+		char const * existingKey = extractKey(existingValue);
+		return idx::contenthelpers::OptionalValue<ValueType>(std::strncmp(existingKey, key, std::strlen(existingKey)) == 0, existingValue);
+	}
+
+	auto const & fixedSizeKey = idx::contenthelpers::toByteComparableKey(key);
+	auto keyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
+
+	std::array<HOTSingleThreadedChildPointer const *, 64> nodesOnPath;
+	std::array<hot::commons::SearchResultForInsert, 64> searchResults;
+	unsigned int leafDepth = 0u;
+	HOTSingleThreadedChildPointer const * current = &mRoot;
+	while(!current->isLeaf()) {
+		nodesOnPath[leafDepth] = current;
+		current = current->executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(true, [&](auto const & node) {
+			return node.searchForInsert(searchResults[leafDepth], keyBytes);
+		});
+		++leafDepth;
+	}
+
+	ValueType const & existingValue = idx::contenthelpers::tidToValue<ValueType>(current->getTid());
+	auto const & existingFixedSizeKey = idx::contenthelpers::toByteComparableKey(extractKey(existingValue));
+	auto existingKeyBytes = idx::contenthelpers::interpretAsByteArray(existingFixedSizeKey);
+
+	uint16_t mismatchingBitIndex = 0u;
+	bool keysDiff = hot::commons::executeForDiffingKeys(existingKeyBytes, keyBytes, idx::contenthelpers::getMaxKeyLength<KeyType>(), [&](hot::commons::DiscriminativeBit const & significantKeyInformation) {
+		mismatchingBitIndex = significantKeyInformation.mAbsoluteBitIndex;
+	});
+	//the reached leaf is itself a prefix of the search key, if it ends in the byte containing the mismatching bit
+	if(!keysDiff || existingKeyBytes[mismatchingBitIndex / 8u] == 0u) {
+		return idx::contenthelpers::OptionalValue<ValueType>(true, existingValue);
+	}
+
+	//No stored key shares more bits with the search key than the reached leaf. Therefore, only prefixes ending at or before the mismatching bit are candidates.
+	//They are checked from the longest to the shortest one, which allows to backtrack the search path only once.
+	unsigned int depth = leafDepth - 1u;
+	for(size_t prefixLength = mismatchingBitIndex / 8u + 1u; prefixLength-- > 0u;) {
+		if(keyBytes[prefixLength] == 0u) {
+			continue;
+		}
+		//the bit at which the prefix of this length mismatches the search key is the first set bit of the search key following the prefix
+		uint16_t prefixEndBitIndex = static_cast<uint16_t>(prefixLength * 8u + __builtin_clz(keyBytes[prefixLength]) - 24u);
+		if(prefixEndBitIndex > mismatchingBitIndex) {
+			continue;
+		}
+		while(depth > 0u && prefixEndBitIndex < searchResults[depth].mMostSignificantBitIndex) {
+			--depth;
+		}
+
+		HOTSingleThreadedChildPointer const * candidateEntry = nodesOnPath[depth]->executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto const & node) -> HOTSingleThreadedChildPointer const * {
+			uint32_t entryIndex = searchResults[depth].mEntryIndex;
+			hot::commons::InsertInformation const & prefixSubtree = node.getInsertInformation(entryIndex, hot::commons::DiscriminativeBit(prefixEndBitIndex));
+			hot::commons::InsertInformation const & searchKeySubtree = node.getInsertInformation(entryIndex, hot::commons::DiscriminativeBit(prefixEndBitIndex + 1u));
+			//the subtree which would be split by inserting the search key contains only keys which are smaller than the search key at the mismatching bit.
+			//For all other candidates only if the prefix end bit is a discriminative bit on the search path, the subtree contains keys which are smaller than the search key at this bit
+			return (prefixEndBitIndex == mismatchingBitIndex || prefixSubtree.getNumberEntriesInAffectedSubtree() != searchKeySubtree.getNumberEntriesInAffectedSubtree())
+				? node.getPointers() + prefixSubtree.getFirstIndexInAffectedSubtree()
+				: nullptr;
+		});
+
+		if(candidateEntry != nullptr) {
+			while(candidateEntry->isNode()) {
+				candidateEntry = candidateEntry->getNode()->getPointers();
+			}
+			ValueType const & candidateValue = idx::contenthelpers::tidToValue<ValueType>(candidateEntry->getTid());
+			//the candidate shares all bits preceding the prefix end bit with the search key, hence it is the prefix iff it ends at this byte
+			if(extractKey(candidateValue)[prefixLength] == '\0') {
+				return idx::contenthelpers::OptionalValue<ValueType>(true, candidateValue);
+			}
+		}
+	}
+
+	return idx::contenthelpers::OptionalValue<ValueType>();
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline void HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::updateSubtreeCountsOnPath(idx::contenthelpers::KeyBytesType<KeyType> const & keyBytes) {
+	if(!SubtreeCountPolicy::MAINTAINS_SUBTREE_COUNTS) {
+		return;
+	}
+
+	std::array<HOTSingleThreadedNodeBase*, 64> nodesOnPath;
+	std::array<size_t, 64> entryIndexesOnPath;
+	size_t pathLength = 0u;
+	HOTSingleThreadedChildPointer const * current = &mRoot;
+	while(current->isAValidNode()) {
+		HOTSingleThreadedNodeBase* node = current->getNode();
+		current = current->search<MAXIMUM_KEY_LENGTH>(keyBytes);
+		nodesOnPath[pathLength] = node;
+		entryIndexesOnPath[pathLength] = static_cast<size_t>(current - node->getPointers());
+		++pathLength;
+	}
+
+	//the counts are updated bottom up, as the count of each entry is derived from the already updated counts of its child node
+	while(pathLength > 0u) {
+		--pathLength;
+		nodesOnPath[pathLength]->updateSubtreeCount(entryIndexesOnPath[pathLength]);
+	}
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline void HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::initializeSubtreeCountsBottomUp(HOTSingleThreadedChildPointer const & subtree) {
+	if(SubtreeCountPolicy::MAINTAINS_SUBTREE_COUNTS && subtree.isAValidNode()) {
+		HOTSingleThreadedNodeBase* node = subtree.getNode();
+		for(HOTSingleThreadedChildPointer const & childPointer : *node) {
+			initializeSubtreeCountsBottomUp(childPointer);
+		}
+		node->initializeSubtreeCounts();
+	}
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline void HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::initializeSubtreeCountsAboveRetainedNodes(
+	HOTSingleThreadedChildPointer const & subtree, std::vector<HOTSingleThreadedNodeBase const *> const & retainedNodes
+) {
+	if(SubtreeCountPolicy::MAINTAINS_SUBTREE_COUNTS && subtree.isAValidNode() && std::find(retainedNodes.begin(), retainedNodes.end(), subtree.getNode()) == retainedNodes.end()) {
+		HOTSingleThreadedNodeBase* node = subtree.getNode();
+		for(HOTSingleThreadedChildPointer const & childPointer : *node) {
+			initializeSubtreeCountsAboveRetainedNodes(childPointer, retainedNodes);
+		}
+		node->initializeSubtreeCounts();
+	}
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy>inline unsigned int HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::searchForInsert(idx::contenthelpers::KeyBytesType<KeyType> const & keyBytes, std::array<HOTSingleThreadedInsertStackEntry, 64> & insertStack) {
+	//the nodes on the returned path are modified in place, hence nodes shared with a snapshot are replaced by private copies
+	bool copiesSharedNodes = mSnapshotRegistry && mSnapshotRegistry->hasLiveSnapshots();
 	HOTSingleThreadedChildPointer* current = &mRoot;
 	unsigned int currentDepth = 0;
 	while(!current->isLeaf()) {
+		if(copiesSharedNodes) {
+			copySharedNode(*current);
+		}
 		insertStack[currentDepth].mChildPointer = current;
-		current = current->executeForSpecificNodeType(true, [&](auto & node) {
+		current = current->executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(true, [&](auto & node) {
 			HOTSingleThreadedInsertStackEntry & currentStackEntry = insertStack[currentDepth];
 			return node.searchForInsert(currentStackEntry.mSearchResultForInsert, keyBytes);
 		});
@@ -108,9 +514,11 @@ template<typename ValueType, template <typename> typename KeyExtractor>inline un
 	return currentDepth;
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> inline bool HOTSingleThreaded<ValueType, KeyExtractor>::remove(KeyType const & key) {
-	auto const & fixedSizeKey = idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(key));
-	uint8_t const* keyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline bool HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::remove(KeyType const & key) {
+	NodeAllocatorScope allocatorScope { mNodeAllocatorPolicy.getAllocatorId() };
+	SnapshotRegistryScope snapshotRegistryScope { activateSnapshotRegistry() };
+	auto const & fixedSizeKey = idx::contenthelpers::toByteComparableKey(key);
+	auto keyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
 	bool wasContained = false;
 
 	if(isRootANode()) {
@@ -121,6 +529,7 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline b
 		wasContained = idx::contenthelpers::contentEquals(existingKey, key);
 		if(wasContained) {
 			removeWithStack(insertStack, leafDepth - 1);
+			updateSubtreeCountsOnPath(keyBytes);
 		}
 	} else if(mRoot.isLeaf() && hasTheSameKey(mRoot.getTid(), key)) {
 		mRoot = HOTSingleThreadedChildPointer();
@@ -130,16 +539,16 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline b
 	return wasContained;
 };
 
-template<typename ValueType,  template <typename> typename KeyExtractor>
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy>
 void
-HOTSingleThreaded<ValueType, KeyExtractor>::removeWithStack(std::array<HOTSingleThreadedInsertStackEntry, 64> const &searchStack, unsigned int currentDepth) {
+HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::removeWithStack(std::array<HOTSingleThreadedInsertStackEntry, 64> const &searchStack, unsigned int currentDepth) {
 	removeAndExecuteOperationOnNewNodeBeforeIntegrationIntoTreeStructure(searchStack, currentDepth, determineDeletionInformation(searchStack, currentDepth), [](HOTSingleThreadedChildPointer const & newNode, size_t /* offset */){
 		return newNode;
 	});
 }
 
-template<typename ValueType,  template <typename> typename KeyExtractor>
-void HOTSingleThreaded<ValueType, KeyExtractor>::removeRecurseUp(std::array<HOTSingleThreadedInsertStackEntry, 64> const &searchStack, unsigned int currentDepth,  HOTSingleThreadedDeletionInformation const & deletionInformation, HOTSingleThreadedChildPointer const & replacement) {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy>
+void HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::removeRecurseUp(std::array<HOTSingleThreadedInsertStackEntry, 64> const &searchStack, unsigned int currentDepth,  HOTSingleThreadedDeletionInformation const & deletionInformation, HOTSingleThreadedChildPointer const & replacement) {
 	if(deletionInformation.getContainingNode().getNumberEntries() == 2) {
 		HOTSingleThreadedChildPointer previous = *searchStack[currentDepth].mChildPointer;
 		*searchStack[currentDepth].mChildPointer = replacement;
@@ -147,13 +556,14 @@ void HOTSingleThreaded<ValueType, KeyExtractor>::removeRecurseUp(std::array<HOTS
 	} else {
 		removeAndExecuteOperationOnNewNodeBeforeIntegrationIntoTreeStructure(searchStack, currentDepth, deletionInformation, [&](HOTSingleThreadedChildPointer const & newNode, size_t offset){
 			newNode.getNode()->getPointers()[offset + deletionInformation.getIndexOfEntryToReplace()] = replacement;
+			newNode.getNode()->updateSubtreeCount(offset + deletionInformation.getIndexOfEntryToReplace());
 			return newNode;
 		});
 	}
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> template<typename Operation>
-	void HOTSingleThreaded<ValueType, KeyExtractor>::removeAndExecuteOperationOnNewNodeBeforeIntegrationIntoTreeStructure(
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> template<typename Operation>
+	void HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::removeAndExecuteOperationOnNewNodeBeforeIntegrationIntoTreeStructure(
 		std::array<HOTSingleThreadedInsertStackEntry, 64> const &searchStack, unsigned int currentDepth, HOTSingleThreadedDeletionInformation const & deletionInformation, Operation const & operation
 	)
 {
@@ -194,7 +604,7 @@ template<typename ValueType, template <typename> typename KeyExtractor> template
 				//removeAndAdd
 				hot::commons::DiscriminativeBit keyInformation(parentDeletionInformation.getAffectedBiNode().mDiscriminativeBitIndex, !parentDeletionInformation.getDiscriminativeBitValueForEntry());
 				HOTSingleThreadedChildPointer previousNode = *current;
-				HOTSingleThreadedChildPointer newNode = operation(current->executeForSpecificNodeType(false, [&](auto const & currentNode) {
+				HOTSingleThreadedChildPointer newNode = operation(current->executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto const & currentNode) {
 					return currentNode.removeAndAddEntry(deletionInformation, keyInformation, *potentialDirectNeighbour);
 				}), parentDeletionInformation.getDiscriminativeBitValueForEntry());
 				removeRecurseUp(searchStack, parentDepth, parentDeletionInformation, newNode);
@@ -208,14 +618,14 @@ template<typename ValueType, template <typename> typename KeyExtractor> template
 	}
 };
 
-template<typename ValueType, template <typename> typename KeyExtractor> template<typename Operation>
-	void HOTSingleThreaded<ValueType, KeyExtractor>::removeEntryAndExecuteOperationOnNewNodeBeforeIntegrationIntoTreeStructure(
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> template<typename Operation>
+	void HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::removeEntryAndExecuteOperationOnNewNodeBeforeIntegrationIntoTreeStructure(
 		HOTSingleThreadedChildPointer* const currentNodePointer, HOTSingleThreadedDeletionInformation const & deletionInformation, Operation const & operation
 	)
 {
 	HOTSingleThreadedChildPointer previous = *currentNodePointer;
 	*currentNodePointer = operation(
-		currentNodePointer->executeForSpecificNodeType(false, [&](auto const & currentNode){
+		currentNodePointer->executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto const & currentNode){
 			return currentNode.removeEntry(deletionInformation);
 		}),
 		0
@@ -223,11 +633,175 @@ template<typename ValueType, template <typename> typename KeyExtractor> template
 	previous.free();
 };
 
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline size_t HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::removeRange(KeyType const & lowerKey, KeyType const & upperKey) {
+	if(isEmpty() || compareKeys(upperKey, lowerKey)) {
+		return 0u;
+	}
+
+	size_t numberRemovedValues = 0u;
+	if(mRoot.isLeaf()) {
+		KeyType const & existingKey = extractKey(idx::contenthelpers::tidToValue<ValueType>(mRoot.getTid()));
+		if(!compareKeys(existingKey, lowerKey) && !compareKeys(upperKey, existingKey)) {
+			mRoot = HOTSingleThreadedChildPointer();
+			numberRemovedValues = 1u;
+		}
+	} else {
+		NodeAllocatorScope allocatorScope { mNodeAllocatorPolicy.getAllocatorId() };
+		SnapshotRegistryScope snapshotRegistryScope { activateSnapshotRegistry() };
+		if(mSnapshotRegistry && mSnapshotRegistry->hasLiveSnapshots()) {
+			//the nodes on the paths to both boundaries are modified in place. As copying them invalidates the boundaries, they are determined again afterwards.
+			copySharedNodesOnPath(lower_bound(lowerKey));
+			copySharedNodesOnPath(upper_bound(upperKey));
+		}
+		const_iterator const & lowerBound = lower_bound(lowerKey);
+		const_iterator const & upperBound = upper_bound(upperKey);
+		if(lowerBound != upperBound) {
+			mRoot = removeRangeFromSubtree(mRoot, 0u, &lowerBound, (upperBound == END_ITERATOR) ? nullptr : &upperBound, numberRemovedValues);
+		}
+	}
+	return numberRemovedValues;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> HOTSingleThreadedChildPointer HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::removeRangeFromSubtree(
+	HOTSingleThreadedChildPointer const & subtree, unsigned int depth, const_iterator const * lowerBound, const_iterator const * upperBound, size_t & numberRemovedValues
+) {
+	HOTSingleThreadedNodeBase* node = subtree.getNode();
+	HOTSingleThreadedChildPointer* pointers = node->getPointers();
+	uint32_t numberEntries = static_cast<uint32_t>(node->getNumberEntries());
+	uint32_t firstIndex = (lowerBound != nullptr) ? static_cast<uint32_t>(lowerBound->mNodeStack[depth + 1].getCurrent() - pointers) : 0u;
+	uint32_t endIndex = (upperBound != nullptr) ? static_cast<uint32_t>(upperBound->mNodeStack[depth + 1].getCurrent() - pointers) : numberEntries;
+
+	if(firstIndex == endIndex) {
+		//both boundaries are located in the same entry, which keeps at least the value at the upper boundary
+		if(pointers[firstIndex].isNode()) {
+			pointers[firstIndex] = removeRangeFromSubtree(pointers[firstIndex], depth + 1, lowerBound, upperBound, numberRemovedValues);
+			node->updateSubtreeCount(firstIndex);
+		}
+		return subtree;
+	}
+
+	uint32_t removedEntriesMask = 0u;
+	uint32_t firstEntirelyRemovedIndex = firstIndex;
+	if(lowerBound != nullptr && pointers[firstIndex].isNode()) {
+		//the subtree containing the lower boundary may contain values smaller than the lower boundary
+		pointers[firstIndex] = removeRangeFromSubtree(pointers[firstIndex], depth + 1, lowerBound, nullptr, numberRemovedValues);
+		node->updateSubtreeCount(firstIndex);
+		removedEntriesMask |= static_cast<uint32_t>(pointers[firstIndex].isUnused()) << firstIndex;
+		++firstEntirelyRemovedIndex;
+	}
+	for(uint32_t entryIndex = firstEntirelyRemovedIndex; entryIndex < endIndex; ++entryIndex) {
+		numberRemovedValues += deleteSubtreeAndCountValues(pointers[entryIndex]);
+		removedEntriesMask |= 1u << entryIndex;
+	}
+	if(upperBound != nullptr && pointers[endIndex].isNode()) {
+		//the subtree containing the upper boundary may contain values smaller than the upper boundary
+		pointers[endIndex] = removeRangeFromSubtree(pointers[endIndex], depth + 1, nullptr, upperBound, numberRemovedValues);
+		node->updateSubtreeCount(endIndex);
+	}
 
-template<typename ValueType, template <typename> typename KeyExtractor> inline bool HOTSingleThreaded<ValueType, KeyExtractor>::insert(ValueType const & value) {
+	return removeEntriesFromNode(subtree, removedEntriesMask);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> HOTSingleThreadedChildPointer HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::removeEntriesFromNode(HOTSingleThreadedChildPointer const & node, uint32_t removedEntriesMask) {
+	if(removedEntriesMask == 0u) {
+		return node;
+	}
+
+	uint32_t numberEntries = static_cast<uint32_t>(node.getNumberEntries());
+	uint32_t remainingEntriesMask = ~removedEntriesMask & (UINT32_MAX >> (32u - numberEntries));
+	HOTSingleThreadedChildPointer replacement;
+	if(remainingEntriesMask != 0u) {
+		replacement = node.executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto const & existingNode) {
+			return existingNode.removeEntries(removedEntriesMask);
+		});
+	}
+	node.free();
+	return replacement;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> size_t HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::deleteSubtreeAndCountValues(HOTSingleThreadedChildPointer const & subtree) {
+	if(subtree.isLeaf()) {
+		return 1u;
+	}
+	return subtree.executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [](auto const & node) -> size_t {
+		size_t numberValues = 0u;
+		for(HOTSingleThreadedChildPointer const & childPointer : node) {
+			numberValues += deleteSubtreeAndCountValues(childPointer);
+		}
+		delete &node;
+		return numberValues;
+	});
+}
+
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline size_t HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::removeBatch(KeyType const * keys, size_t numberKeys) {
+	NodeAllocatorScope allocatorScope { mNodeAllocatorPolicy.getAllocatorId() };
+	SnapshotRegistryScope snapshotRegistryScope { activateSnapshotRegistry() };
+	std::array<HOTSingleThreadedInsertStackEntry, 64> searchStack;
+	size_t numberRemovedValues = 0u;
+	size_t keyIndex = 0u;
+
+	while(keyIndex < numberKeys && isRootANode()) {
+		auto const & fixedSizeKey = idx::contenthelpers::toByteComparableKey(keys[keyIndex]);
+		unsigned int leafDepth = searchForInsert(idx::contenthelpers::interpretAsByteArray(fixedSizeKey), searchStack);
+		if(!hasTheSameKey(searchStack[leafDepth].mChildPointer->getTid(), keys[keyIndex])) {
+			++keyIndex;
+			continue;
+		}
+
+		unsigned int nodeDepth = leafDepth - 1;
+		HOTSingleThreadedChildPointer* nodePointer = searchStack[nodeDepth].mChildPointer;
+		HOTSingleThreadedChildPointer const * pointers = nodePointer->getNode()->getPointers();
+		uint32_t removedEntriesMask = 1u << searchStack[nodeDepth].mSearchResultForInsert.mEntryIndex;
+
+		//the following keys are searched starting from the same node. As long as they match a leaf of this node, they are removed together.
+		//A key which is not found in this node may still be contained in a different part of the trie and therefore starts a new traversal from the root.
+		for(++keyIndex; keyIndex < numberKeys; ++keyIndex) {
+			auto const & nextFixedSizeKey = idx::contenthelpers::toByteComparableKey(keys[keyIndex]);
+			auto nextKeyBytes = idx::contenthelpers::interpretAsByteArray(nextFixedSizeKey);
+			HOTSingleThreadedChildPointer const * entry = nodePointer->executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto const & node) {
+				return node.search(nextKeyBytes);
+			});
+			if(!entry->isLeaf() || !hasTheSameKey(entry->getTid(), keys[keyIndex])) {
+				break;
+			}
+			removedEntriesMask |= 1u << (entry - pointers);
+		}
+
+		unsigned int numberEntriesToRemove = static_cast<unsigned int>(hot::commons::populationCount32(removedEntriesMask));
+		numberRemovedValues += numberEntriesToRemove;
+		if(numberEntriesToRemove == 1u) {
+			//a single entry is removed like in remove, which allows to merge the shrunken node with its neighbour
+			removeWithStack(searchStack, nodeDepth);
+		} else if(numberEntriesToRemove == nodePointer->getNumberEntries() && nodeDepth > 0u) {
+			//the node becomes empty and is therefore removed from its parent
+			HOTSingleThreadedChildPointer removedNode = *nodePointer;
+			removeWithStack(searchStack, nodeDepth - 1u);
+			removedNode.free();
+		} else {
+			*nodePointer = removeEntriesFromNode(*nodePointer, removedEntriesMask);
+		}
+		updateSubtreeCountsOnPath(idx::contenthelpers::interpretAsByteArray(fixedSizeKey));
+	}
+
+	//once the root is no longer a node it is either empty or a single leaf, which is removed if it matches one of the remaining keys
+	for(; keyIndex < numberKeys && mRoot.isLeaf(); ++keyIndex) {
+		if(hasTheSameKey(mRoot.getTid(), keys[keyIndex])) {
+			mRoot = HOTSingleThreadedChildPointer();
+			++numberRemovedValues;
+		}
+	}
+
+	return numberRemovedValues;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline bool HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::insert(ValueType const & value) {
+	idx::contenthelpers::checkKey(extractKey(value));
+	NodeAllocatorScope allocatorScope { mNodeAllocatorPolicy.getAllocatorId() };
+	SnapshotRegistryScope snapshotRegistryScope { activateSnapshotRegistry() };
 	bool inserted = true;
-	auto const & fixedSizeKey = idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(extractKey(value)));
-	uint8_t const* keyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
+	auto const & fixedSizeKey = idx::contenthelpers::toByteComparableKey(extractKey(value));
+	auto keyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
 
 	if(isRootANode()) {
 		std::array<HOTSingleThreadedInsertStackEntry, 64> insertStack;
@@ -235,15 +809,18 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline b
 		intptr_t tid = insertStack[leafDepth].mChildPointer->getTid();
 		KeyType const & existingKey = extractKey(idx::contenthelpers::tidToValue<ValueType>(tid));
 		inserted = insertWithInsertStack(insertStack, leafDepth, existingKey, keyBytes, value);
+		if(inserted) {
+			updateSubtreeCountsOnPath(keyBytes);
+		}
 	} else if(mRoot.isLeaf()) {
 		HOTSingleThreadedChildPointer valueToInsert(idx::contenthelpers::valueToTid(value));
 		ValueType const & currentLeafValue = idx::contenthelpers::tidToValue<ValueType>(mRoot.getTid());
-		auto const & existingFixedSizeKey = idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(extractKey(currentLeafValue)));
-		uint8_t const* existingKeyBytes = idx::contenthelpers::interpretAsByteArray(existingFixedSizeKey);
+		auto const & existingFixedSizeKey = idx::contenthelpers::toByteComparableKey(extractKey(currentLeafValue));
+		auto existingKeyBytes = idx::contenthelpers::interpretAsByteArray(existingFixedSizeKey);
 
 		inserted = hot::commons::executeForDiffingKeys(existingKeyBytes, keyBytes, idx::contenthelpers::getMaxKeyLength<KeyType>(), [&](hot::commons::DiscriminativeBit const & significantKeyInformation) {
 			hot::commons::BiNode<HOTSingleThreadedChildPointer> const &binaryNode = hot::commons::BiNode<HOTSingleThreadedChildPointer>::createFromExistingAndNewEntry(significantKeyInformation, mRoot, valueToInsert);
-			mRoot = hot::commons::createTwoEntriesNode<HOTSingleThreadedChildPointer, HOTSingleThreadedNode>(binaryNode)->toChildPointer();
+			mRoot = createTwoEntriesNode(binaryNode);
 		});
 
 	} else {
@@ -252,11 +829,11 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline b
 	return inserted;
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> inline bool HOTSingleThreaded<ValueType, KeyExtractor>::insertWithInsertStack(
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline bool HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::insertWithInsertStack(
 	std::array<HOTSingleThreadedInsertStackEntry, 64> &insertStack, unsigned int leafDepth, KeyType const &existingKey,
-	uint8_t const *newKeyBytes, ValueType const &newValue) {
-	auto const & existingFixedSizeKey = idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(existingKey));
-	uint8_t const* existingKeyBytes = idx::contenthelpers::interpretAsByteArray(existingFixedSizeKey);
+	idx::contenthelpers::KeyBytesType<KeyType> const & newKeyBytes, ValueType const &newValue) {
+	auto const & existingFixedSizeKey = idx::contenthelpers::toByteComparableKey(existingKey);
+	auto existingKeyBytes = idx::contenthelpers::interpretAsByteArray(existingFixedSizeKey);
 	return hot::commons::executeForDiffingKeys(existingKeyBytes, newKeyBytes, idx::contenthelpers::getMaxKeyLength<KeyType>(), [&](hot::commons::DiscriminativeBit const & significantKeyInformation) {
 		unsigned int insertDepth = 0;
 		//searches for the node to insert the new value into.
@@ -269,15 +846,68 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline b
 		assert(insertDepth < leafDepth);
 
 		HOTSingleThreadedChildPointer valueToInsert(idx::contenthelpers::valueToTid(newValue));
-		insertNewValueIntoNode(insertStack, significantKeyInformation, insertDepth, leafDepth, valueToInsert);
+		insertNewValueIntoNode<MAXIMUM_KEY_LENGTH>(insertStack, significantKeyInformation, insertDepth, leafDepth, valueToInsert);
 	});
 }
 
 
-template<typename ValueType, template <typename> typename KeyExtractor> inline idx::contenthelpers::OptionalValue<ValueType> HOTSingleThreaded<ValueType, KeyExtractor>::upsert(ValueType newValue) {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> template<typename Iterator> inline size_t HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::bulkLoad(Iterator begin, Iterator end) {
+	//all keys are checked upfront, as the trie cannot be left partially loaded
+	for(Iterator current = begin; current != end; ++current) {
+		idx::contenthelpers::checkKey(extractKey(*current));
+	}
+	NodeAllocatorScope allocatorScope { mNodeAllocatorPolicy.getAllocatorId() };
+	SnapshotRegistryScope snapshotRegistryScope { activateSnapshotRegistry() };
+	size_t numberLoadedValues = 0u;
+
+	if(!isEmpty()) {
+		for(Iterator current = begin; current != end; ++current) {
+			numberLoadedValues += insert(*current);
+		}
+	} else if(begin != end) {
+		using FixedSizeKeyType = typename std::decay<decltype(idx::contenthelpers::toByteComparableKey(std::declval<KeyType>()))>::type;
+		hot::commons::BulkLoader<HOTSingleThreadedChildPointer, HOTSingleThreadedNode> bulkLoader;
+
+		FixedSizeKeyType previousFixedSizeKey = idx::contenthelpers::toByteComparableKey(extractKey(*begin));
+		bulkLoader.append(HOTSingleThreadedChildPointer(idx::contenthelpers::valueToTid(*begin)));
+		++numberLoadedValues;
+
+		for(Iterator current = std::next(begin); current != end; ++current) {
+			ValueType const & value = *current;
+			FixedSizeKeyType fixedSizeKey = idx::contenthelpers::toByteComparableKey(extractKey(value));
+			bool isSorted = true;
+			bool isNewKey = hot::commons::executeForDiffingKeys(
+				idx::contenthelpers::interpretAsByteArray(previousFixedSizeKey), idx::contenthelpers::interpretAsByteArray(fixedSizeKey), idx::contenthelpers::getMaxKeyLength<KeyType>(),
+				[&](hot::commons::DiscriminativeBit const & separatingBit) {
+					isSorted = separatingBit.mValue;
+					if(isSorted) {
+						bulkLoader.append(separatingBit, HOTSingleThreadedChildPointer(idx::contenthelpers::valueToTid(value)));
+					}
+				}
+			);
+			if(!isSorted) {
+				//the nodes loaded so far have never been reachable from the trie or any of its snapshots
+				bulkLoader.finish().deleteSubtree();
+				throw std::invalid_argument("the values to bulk load are not sorted in ascending key order");
+			}
+			numberLoadedValues += isNewKey;
+			previousFixedSizeKey = fixedSizeKey;
+		}
+
+		mRoot = bulkLoader.finish();
+		initializeSubtreeCountsBottomUp(mRoot);
+	}
+
+	return numberLoadedValues;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline idx::contenthelpers::OptionalValue<ValueType> HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::upsert(ValueType newValue) {
+	idx::contenthelpers::checkKey(extractKey(newValue));
+	NodeAllocatorScope allocatorScope { mNodeAllocatorPolicy.getAllocatorId() };
+	SnapshotRegistryScope snapshotRegistryScope { activateSnapshotRegistry() };
 	KeyType newKey = extractKey(newValue);
-	auto const & fixedSizeKey = idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(extractKey(newValue)));
-	uint8_t const* keyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
+	auto const & fixedSizeKey = idx::contenthelpers::toByteComparableKey(extractKey(newValue));
+	auto keyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
 
 	if(isRootANode()) {
 		std::array<HOTSingleThreadedInsertStackEntry, 64> insertStack;
@@ -286,6 +916,7 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline i
 		ValueType const & existingValue = idx::contenthelpers::tidToValue<ValueType>(tid);
 
 		if(insertWithInsertStack(insertStack, leafDepth, extractKey(existingValue), keyBytes, newValue)) {
+			updateSubtreeCountsOnPath(keyBytes);
 			return idx::contenthelpers::OptionalValue<ValueType>();
 		} else {
 			*insertStack[leafDepth].mChildPointer = HOTSingleThreadedChildPointer(idx::contenthelpers::valueToTid(newValue));
@@ -306,27 +937,564 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline i
 	}
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreaded<ValueType, KeyExtractor>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor>::begin() const {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline HOTSingleThreadedSnapshot<ValueType, KeyExtractor> HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::snapshot() {
+	static_assert(!NodeAllocatorPolicy::RELEASES_NODES_IN_BULK, "Snapshots require that replaced nodes are released individually");
+	if(!mSnapshotRegistry) {
+		mSnapshotRegistry = std::make_shared<HOTSingleThreadedSnapshotRegistry>();
+	}
+	mSnapshotRegistry->reclaimRetiredNodes();
+	uint64_t version = mSnapshotRegistry->acquireSnapshot();
+	return HOTSingleThreadedSnapshot<ValueType, KeyExtractor>(mSnapshotRegistry, version, mRoot);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline size_t HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::getNumberRetiredNodes() const {
+	return mSnapshotRegistry ? mSnapshotRegistry->getNumberRetiredNodes() : 0u;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline NodeAllocatorPolicy const & HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::getNodeAllocatorPolicy() const {
+	return mNodeAllocatorPolicy;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline HOTSingleThreadedFrozen<ValueType, KeyExtractor> HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::freeze() const {
+	return HOTSingleThreadedFrozen<ValueType, KeyExtractor>(mRoot);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline bool HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::compact(size_t budget) {
+	if(!isRootANode()) {
+		mCompactionPosition.clear();
+		return true;
+	}
+
+	NodeAllocatorScope allocatorScope { mNodeAllocatorPolicy.getAllocatorId() };
+	SnapshotRegistryScope snapshotRegistryScope { activateSnapshotRegistry() };
+	if(mCompactionPosition.empty()) {
+		//a new pass does not place relocated nodes into the partially filled chunk of an arena, as this chunk would be kept alive by the nodes relocated into it
+		NodeAllocatorRegistry::getMemoryPool(mNodeAllocatorPolicy.getAllocatorId())->startNewArenaChunk();
+	}
+	bool copiesSharedNodes = mSnapshotRegistry && mSnapshotRegistry->hasLiveSnapshots();
+	auto isNode = [](HOTSingleThreadedChildPointer const & entry) {
+		return entry.isNode();
+	};
+
+	//the stored position is followed as long as it still describes a path in the current trie
+	std::array<HOTSingleThreadedChildPointer*, 64> path;
+	path[0] = &mRoot;
+	size_t depth = 0u;
+	for(uint8_t entryIndex : mCompactionPosition) {
+		if(entryIndex >= path[depth]->getNode()->getNumberEntries() || !path[depth]->getNode()->getPointers()[entryIndex].isNode()) {
+			break;
+		}
+		//the ancestors might have been shared with a snapshot taken since the last call
+		if(copiesSharedNodes) {
+			copySharedNode(*path[depth]);
+		}
+		path[depth + 1] = path[depth]->getNode()->getPointers() + entryIndex;
+		++depth;
+	}
+
+	for(size_t numberRelocatedNodes = 0u; numberRelocatedNodes < budget; ++numberRelocatedNodes) {
+		HOTSingleThreadedChildPointer previousNode = *path[depth];
+		*path[depth] = previousNode.executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [](auto const & node) {
+			return node.relocate();
+		});
+		//is retired by the active registry in case it is shared with a snapshot
+		previousNode.free();
+
+		HOTSingleThreadedNodeBase* node = path[depth]->getNode();
+		HOTSingleThreadedChildPointer* next = std::find_if(node->begin(), node->end(), isNode);
+		while(next == node->end()) {
+			if(depth == 0u) {
+				mCompactionPosition.clear();
+				//the pooled memory might still occupy the chunks of an arena, which were vacated by the relocated nodes
+				NodeAllocatorRegistry::getMemoryPool(mNodeAllocatorPolicy.getAllocatorId())->releaseFreeLists();
+				return true;
+			}
+			HOTSingleThreadedChildPointer* current = path[depth];
+			--depth;
+			node = path[depth]->getNode();
+			next = std::find_if(current + 1, node->end(), isNode);
+		}
+		path[++depth] = next;
+	}
+
+	mCompactionPosition.resize(depth);
+	for(size_t pathDepth = 1u; pathDepth <= depth; ++pathDepth) {
+		mCompactionPosition[pathDepth - 1u] = static_cast<uint8_t>(path[pathDepth] - path[pathDepth - 1u]->getNode()->getPointers());
+	}
+	return false;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline void HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::rebalance() {
+	mRebalancingPosition.clear();
+	if(isRootANode()) {
+		NodeAllocatorScope allocatorScope { mNodeAllocatorPolicy.getAllocatorId() };
+		SnapshotRegistryScope snapshotRegistryScope { activateSnapshotRegistry() };
+		bool copiesSharedNodes = mSnapshotRegistry && mSnapshotRegistry->hasLiveSnapshots();
+		mRoot = rebalanceSubtree(mRoot, copiesSharedNodes);
+	}
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline bool HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::rebalance(size_t budget) {
+	if(!isRootANode()) {
+		mRebalancingPosition.clear();
+		return true;
+	}
+
+	NodeAllocatorScope allocatorScope { mNodeAllocatorPolicy.getAllocatorId() };
+	SnapshotRegistryScope snapshotRegistryScope { activateSnapshotRegistry() };
+	bool copiesSharedNodes = mSnapshotRegistry && mSnapshotRegistry->hasLiveSnapshots();
+
+	std::array<HOTSingleThreadedChildPointer*, 64> path;
+	std::array<uint8_t, 64> entryIndexes;
+	path[0] = &mRoot;
+	size_t depth = 0u;
+
+	auto descendToFirstNodeInPostOrder = [&]() {
+		HOTSingleThreadedNodeBase* node = path[depth]->getNode();
+		HOTSingleThreadedChildPointer* next = std::find_if(node->begin(), node->end(), [](HOTSingleThreadedChildPointer const & entry) { return entry.isNode(); });
+		while(next != node->end()) {
+			++depth;
+			entryIndexes[depth] = static_cast<uint8_t>(next - node->getPointers());
+			path[depth] = next;
+			node = next->getNode();
+			next = std::find_if(node->begin(), node->end(), [](HOTSingleThreadedChildPointer const & entry) { return entry.isNode(); });
+		}
+	};
+	auto moveToNextNodeInPostOrder = [&]() {
+		HOTSingleThreadedNodeBase* parent = path[depth - 1u]->getNode();
+		HOTSingleThreadedChildPointer* next = std::find_if(path[depth] + 1, parent->end(), [](HOTSingleThreadedChildPointer const & entry) { return entry.isNode(); });
+		if(next == parent->end()) {
+			--depth;
+		} else {
+			entryIndexes[depth] = static_cast<uint8_t>(next - parent->getPointers());
+			path[depth] = next;
+			descendToFirstNodeInPostOrder();
+		}
+	};
+
+	//the stored position is followed as long as it still describes a path in the current trie
+	bool isStoredPositionValid = !mRebalancingPosition.empty();
+	for(uint8_t entryIndex : mRebalancingPosition) {
+		HOTSingleThreadedNodeBase* node = path[depth]->getNode();
+		if(entryIndex >= node->getNumberEntries() || !node->getPointers()[entryIndex].isNode()) {
+			isStoredPositionValid = false;
+			break;
+		}
+		++depth;
+		entryIndexes[depth] = entryIndex;
+		path[depth] = node->getPointers() + entryIndex;
+	}
+	if(isStoredPositionValid) {
+		moveToNextNodeInPostOrder();
+	} else {
+		descendToFirstNodeInPostOrder();
+	}
+
+	for(size_t numberVisitedNodes = 1u; true; ++numberVisitedNodes) {
+		if(isRebalancingBeneficial(*path[depth])) {
+			//the ancestors might be shared with a snapshot taken since the last modification
+			if(copiesSharedNodes) {
+				for(size_t ancestorDepth = 0u; ancestorDepth < depth; ++ancestorDepth) {
+					copySharedNode(*path[ancestorDepth]);
+					path[ancestorDepth + 1u] = path[ancestorDepth]->getNode()->getPointers() + entryIndexes[ancestorDepth + 1u];
+				}
+			}
+
+			*path[depth] = rebuildNode(*path[depth]);
+			//the height of each node must exceed the maximum height of its children by exactly one
+			while(depth > 0u && isRebalancingBeneficial(*path[depth - 1u])) {
+				--depth;
+				*path[depth] = rebuildNode(*path[depth]);
+			}
+		}
+
+		if(depth == 0u) {
+			mRebalancingPosition.clear();
+			return true;
+		} else if(numberVisitedNodes >= budget) {
+			break;
+		}
+		moveToNextNodeInPostOrder();
+	}
+
+	mRebalancingPosition.assign(entryIndexes.begin() + 1u, entryIndexes.begin() + depth + 1u);
+	return false;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline HOTSingleThreadedChildPointer HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::rebalanceSubtree(HOTSingleThreadedChildPointer const & subtree, bool copiesSharedNodes) {
+	HOTSingleThreadedChildPointer current = subtree;
+	size_t numberEntries = current.getNode()->getNumberEntries();
+	for(size_t entryIndex = 0u; entryIndex < numberEntries; ++entryIndex) {
+		HOTSingleThreadedChildPointer child = current.getNode()->getPointers()[entryIndex];
+		if(child.isNode()) {
+			HOTSingleThreadedChildPointer rebalancedChild = rebalanceSubtree(child, copiesSharedNodes);
+			if(rebalancedChild != child) {
+				if(copiesSharedNodes) {
+					copySharedNode(current);
+				}
+				current.getNode()->getPointers()[entryIndex] = rebalancedChild;
+			}
+		}
+	}
+	//all children are already rebalanced, hence a single rebuild yields the optimal shape of the subtree
+	return isRebalancingBeneficial(current) ? rebuildNode(current) : current;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline hot::commons::SubtreeShapeCalculator HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::combineEntryShapes(HOTSingleThreadedChildPointer const & node, bool reshapesChildNodes) {
+	hot::commons::SubtreeShapeCalculator shapeCalculator;
+	node.executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto const & currentNode) {
+		size_t numberEntries = currentNode.getNumberEntries();
+		for(size_t entryIndex = 0u; entryIndex < numberEntries; ++entryIndex) {
+			HOTSingleThreadedChildPointer const & entry = currentNode.getPointers()[entryIndex];
+			hot::commons::SubtreeShape entryShape { 1u, 1u };
+			if(entry.isNode()) {
+				entryShape = reshapesChildNodes
+					? combineEntryShapes(entry, true).finish()
+					: hot::commons::SubtreeShape { entry.getHeight(), static_cast<uint16_t>(entry.getNode()->getNumberEntries()) };
+			}
+			if(entryIndex == 0u) {
+				shapeCalculator.append(entryShape);
+			} else {
+				shapeCalculator.append(currentNode.getSeparatingBitIndex(entryIndex), entryShape);
+			}
+		}
+	});
+	return shapeCalculator;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline bool HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::isRebalancingBeneficial(HOTSingleThreadedChildPointer const & node) {
+	HOTSingleThreadedNodeBase const * currentNode = node.getNode();
+	uint16_t maximumChildHeight = 0u;
+	size_t numberChildNodes = 0u;
+	for(HOTSingleThreadedChildPointer const & entry : *currentNode) {
+		maximumChildHeight = std::max(maximumChildHeight, entry.getHeight());
+		numberChildNodes += entry.isNode();
+	}
+	//the height of a node is outdated in case its child nodes were rebuilt with a lower height
+	if(currentNode->mHeight != maximumChildHeight + 1u) {
+		return true;
+	}
+
+	hot::commons::SubtreeShapeCalculator shapeCalculator = combineEntryShapes(node, false);
+	hot::commons::SubtreeShape rebuiltShape = shapeCalculator.finish();
+	//the rebuilt subtree consists of its root and the closed nodes, which replace the node and its child nodes
+	return rebuiltShape.mHeight < currentNode->mHeight || (rebuiltShape.mHeight == currentNode->mHeight && shapeCalculator.getNumberClosedNodes() < numberChildNodes);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline HOTSingleThreadedChildPointer HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::rebuildNode(HOTSingleThreadedChildPointer const & node) {
+	using BulkLoaderType = hot::commons::BulkLoader<HOTSingleThreadedChildPointer, HOTSingleThreadedNode>;
+	BulkLoaderType bulkLoader;
+	std::vector<HOTSingleThreadedNodeBase const *> retainedNodes;
+
+	node.executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto const & currentNode) {
+		size_t numberEntries = currentNode.getNumberEntries();
+		for(size_t entryIndex = 0u; entryIndex < numberEntries; ++entryIndex) {
+			HOTSingleThreadedChildPointer const & entry = currentNode.getPointers()[entryIndex];
+			hot::commons::DiscriminativeBit separatingBit { (entryIndex == 0u) ? static_cast<uint16_t>(0u) : currentNode.getSeparatingBitIndex(entryIndex) };
+			if(entry.isLeaf()) {
+				if(entryIndex == 0u) {
+					bulkLoader.append(entry);
+				} else {
+					bulkLoader.append(separatingBit, entry);
+				}
+			} else {
+				//child nodes are reopened, such that their entries can be combined with adjacent entries
+				typename BulkLoaderType::Subtree reopenedChild = entry.executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto const & childNode) {
+					typename BulkLoaderType::Subtree subtree;
+					subtree.mHeight = childNode.mHeight;
+					subtree.mNumberEntries = static_cast<uint16_t>(childNode.getNumberEntries());
+					for(size_t childEntryIndex = 0u; childEntryIndex < subtree.mNumberEntries; ++childEntryIndex) {
+						HOTSingleThreadedChildPointer const & childEntry = childNode.getPointers()[childEntryIndex];
+						subtree.mEntries[childEntryIndex] = childEntry;
+						if(childEntryIndex > 0u) {
+							subtree.mSeparatingBitIndexes[childEntryIndex - 1u] = childNode.getSeparatingBitIndex(childEntryIndex);
+						}
+						if(SubtreeCountPolicy::MAINTAINS_SUBTREE_COUNTS && childEntry.isNode()) {
+							retainedNodes.push_back(childEntry.getNode());
+						}
+					}
+					return subtree;
+				});
+				if(entryIndex == 0u) {
+					bulkLoader.append(reopenedChild);
+				} else {
+					bulkLoader.append(separatingBit, reopenedChild);
+				}
+			}
+		}
+	});
+	HOTSingleThreadedChildPointer rebuiltNode = bulkLoader.finish();
+	initializeSubtreeCountsAboveRetainedNodes(rebuiltNode, retainedNodes);
+
+	//nodes shared with a snapshot are retired by the active registry
+	for(HOTSingleThreadedChildPointer const & entry : *node.getNode()) {
+		if(entry.isNode()) {
+			HOTSingleThreadedChildPointer reopenedChild = entry;
+			reopenedChild.free();
+		}
+	}
+	HOTSingleThreadedChildPointer previousNode = node;
+	previousNode.free();
+	return rebuiltNode;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline bool HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::save(std::string const & filePath) const {
+	std::ofstream output { filePath, std::ios::binary | std::ios::trunc };
+	if(!output) {
+		return false;
+	}
+
+	//the header is written again once the root's record reference and the number of records are known
+	HOTSingleThreadedFileHeader fileHeader;
+	std::memcpy(fileHeader.mMagic, HOT_SINGLE_THREADED_FILE_MAGIC, sizeof(fileHeader.mMagic));
+	fileHeader.mFormatVersion = HOT_SINGLE_THREADED_FILE_FORMAT_VERSION;
+	fileHeader.mLayoutFlags = HOTSingleThreadedFileHeader::getCurrentLayoutFlags();
+	fileHeader.mKeyType = static_cast<uint32_t>(getFileKeyType<KeyType>());
+	fileHeader.mMaximumKeyLength = static_cast<uint32_t>(MAXIMUM_KEY_LENGTH);
+	fileHeader.mNumberNodes = 0u;
+	fileHeader.mEncodedRoot = 0;
+	output.write(reinterpret_cast<char const*>(&fileHeader), sizeof(fileHeader));
+
+	HOTSingleThreadedChildPointer encodedRoot = isRootANode() ? saveSubtree(mRoot, output, fileHeader.mNumberNodes) : mRoot;
+	fileHeader.mEncodedRoot = *reinterpret_cast<intptr_t const *>(&encodedRoot);
+	output.seekp(0);
+	output.write(reinterpret_cast<char const*>(&fileHeader), sizeof(fileHeader));
+	output.flush();
+	return static_cast<bool>(output);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline bool HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::load(std::string const & filePath) {
+	std::ifstream input { filePath, std::ios::binary };
+	HOTSingleThreadedFileHeader fileHeader;
+	if(!input.read(reinterpret_cast<char*>(&fileHeader), sizeof(fileHeader)) || !fileHeader.template isCompatible<KeyType>()) {
+		return false;
+	}
+
+	clear();
+	NodeAllocatorScope allocatorScope { mNodeAllocatorPolicy.getAllocatorId() };
+	SnapshotRegistryScope snapshotRegistryScope { activateSnapshotRegistry() };
+	std::pair<bool, HOTSingleThreadedChildPointer> loadResult = loadNodes(input, fileHeader);
+	if(loadResult.first) {
+		mRoot = loadResult.second;
+	}
+	return loadResult.first;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline HOTSingleThreadedSnapshotRegistry* HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::activateSnapshotRegistry() {
+	if(!mSnapshotRegistry) {
+		return nullptr;
+	}
+	mSnapshotRegistry->reclaimRetiredNodes();
+	return mSnapshotRegistry.get();
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline void HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::copySharedNode(HOTSingleThreadedChildPointer & nodePointer) {
+	assert(HOTSingleThreadedSnapshotRegistry::getActiveRegistry() == mSnapshotRegistry.get());
+	if(mSnapshotRegistry->isShared(nodePointer.getNode())) {
+		HOTSingleThreadedChildPointer sharedNode = nodePointer;
+		nodePointer = sharedNode.executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto const & node) {
+			return node.compressEntries(0u, static_cast<uint16_t>(node.getNumberEntries()));
+		});
+		//is retired by the active registry
+		sharedNode.free();
+	}
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline void HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::copySharedNodesOnPath(const_iterator const & position) {
+	//the entry indexes are determined upfront, as copying the root changes the start of the iterator's path
+	std::array<size_t, 64> entryIndexes;
+	for(size_t depth = 1u; depth <= position.mCurrentDepth; ++depth) {
+		entryIndexes[depth] = static_cast<size_t>(position.mNodeStack[depth].getCurrent() - position.mNodeStack[depth - 1].getCurrent()->getNode()->getPointers());
+	}
+
+	HOTSingleThreadedChildPointer* current = &mRoot;
+	for(size_t depth = 1u; depth <= position.mCurrentDepth; ++depth) {
+		copySharedNode(*current);
+		current = current->getNode()->getPointers() + entryIndexes[depth];
+	}
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> HOTSingleThreadedChildPointer HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::saveSubtree(
+	HOTSingleThreadedChildPointer const & subtree, std::ostream & output, uint64_t & numberWrittenRecords
+) {
+	if(subtree.isLeaf()) {
+		return subtree;
+	}
+
+	HOTSingleThreadedNodeBase const * node = subtree.getNode();
+	size_t numberEntries = node->getNumberEntries();
+	std::array<HOTSingleThreadedChildPointer, MAXIMUM_NUMBER_NODE_ENTRIES> encodedChildren;
+	for(size_t entryIndex = 0u; entryIndex < numberEntries; ++entryIndex) {
+		encodedChildren[entryIndex] = saveSubtree(node->getPointers()[entryIndex], output, numberWrittenRecords);
+	}
+
+	//the image must neither contain absolute addresses nor the content of unused slots, which may be left over from removed entries or previous allocations.
+	//Hence only the used entries are copied into a zeroed image, which makes the file only depend on the content of the trie.
+	std::array<uint64_t, MAXIMUM_NODE_IMAGE_SIZE_IN_WORDS> nodeImage;
+	nodeImage.fill(0u);
+	char* imageBytes = reinterpret_cast<char*>(nodeImage.data());
+	HOTSingleThreadedNodeBase* imageBase = reinterpret_cast<HOTSingleThreadedNodeBase*>(imageBytes);
+	imageBase->mUsedEntriesMask = node->mUsedEntriesMask;
+	const_cast<uint16_t &>(imageBase->mHeight) = node->mHeight;
+
+	uint32_t sizeInBytes = subtree.executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto const & typedNode) {
+		using NodeType = typename std::decay<decltype(typedNode)>::type;
+		using DiscriminativeBitsRepresentationType = typename NodeType::DiscriminativeBitsRepresentationType;
+		hot::commons::NodeAllocationInformation const & allocationInformation = hot::commons::NodeAllocationInformations<NodeType>::getAllocationInformation(numberEntries);
+		assert(allocationInformation.mTotalSizeInBytes <= sizeof(nodeImage));
+		auto getOffset = [&](void const * member) {
+			return static_cast<size_t>(reinterpret_cast<char const*>(member) - reinterpret_cast<char const*>(&typedNode));
+		};
+
+		new (imageBytes + getOffset(&typedNode.mDiscriminativeBitsRepresentation)) DiscriminativeBitsRepresentationType(typedNode.mDiscriminativeBitsRepresentation);
+		std::memcpy(imageBytes + getOffset(typedNode.mPartialKeys.mEntries), typedNode.mPartialKeys.mEntries, numberEntries * sizeof(typedNode.mPartialKeys.mEntries[0]));
+		//the subtree counts of the used entries are stored in reverse order directly in front of the child pointers
+		size_t subtreeCountsSize = SubtreeCountPolicy::MAINTAINS_SUBTREE_COUNTS ? numberEntries * sizeof(SubtreeCount) : 0u;
+		std::memcpy(imageBytes + allocationInformation.mPointerOffset - subtreeCountsSize, reinterpret_cast<char const*>(&typedNode) + allocationInformation.mPointerOffset - subtreeCountsSize, subtreeCountsSize);
+		std::memcpy(imageBytes + allocationInformation.mPointerOffset, encodedChildren.data(), numberEntries * sizeof(HOTSingleThreadedChildPointer));
+		return static_cast<uint32_t>(allocationInformation.mTotalSizeInBytes);
+	});
+
+	HOTSingleThreadedFileRecordHeader recordHeader { static_cast<uint32_t>(subtree.getNodeType()), sizeInBytes };
+	output.write(reinterpret_cast<char const*>(&recordHeader), sizeof(recordHeader));
+	output.write(reinterpret_cast<char const*>(nodeImage.data()), sizeInBytes);
+	return toRecordReference(subtree.getNodeType(), numberWrittenRecords++);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> std::pair<bool, HOTSingleThreadedChildPointer> HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::loadNodes(
+	std::istream & input, HOTSingleThreadedFileHeader const & fileHeader
+) {
+	//the roots of the rebuilt subtrees whose parents were not read yet together with the indexes of their records
+	std::vector<std::pair<uint64_t, HOTSingleThreadedChildPointer>> pendingSubtrees;
+	alignas(FILE_RECORD_REFERENCE_ALIGNMENT) std::array<uint64_t, MAXIMUM_NODE_IMAGE_SIZE_IN_WORDS> nodeImage;
+	bool isValid = true;
+
+	for(uint64_t recordIndex = 0u; isValid && recordIndex < fileHeader.mNumberNodes; ++recordIndex) {
+		HOTSingleThreadedFileRecordHeader recordHeader;
+		isValid = input.read(reinterpret_cast<char*>(&recordHeader), sizeof(recordHeader))
+			&& recordHeader.mNodeType <= static_cast<uint32_t>(NODE_ALGORITHM_TYPE_EXTRACTION_MASK)
+			//nodes of types, which cannot occur for the trie's keys, are not even instantiated by the dispatch
+			&& hot::commons::canNodeTypeOccur(static_cast<hot::commons::NodeType>(recordHeader.mNodeType), MAXIMUM_KEY_LENGTH)
+			&& recordHeader.mSizeInBytes >= sizeof(HOTSingleThreadedNodeBase) && recordHeader.mSizeInBytes <= sizeof(nodeImage)
+			&& input.read(reinterpret_cast<char*>(nodeImage.data()), recordHeader.mSizeInBytes);
+		if(!isValid) {
+			break;
+		}
+
+		HOTSingleThreadedChildPointer imagePointer(static_cast<hot::commons::NodeType>(recordHeader.mNodeType), reinterpret_cast<HOTSingleThreadedNodeBase const *>(nodeImage.data()));
+		HOTSingleThreadedChildPointer rebuiltNode = imagePointer.executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto const & image) {
+			using NodeType = typename std::decay<decltype(image)>::type;
+			size_t numberEntries = image.getNumberEntries();
+			if(numberEntries < 2u || numberEntries > MAXIMUM_NUMBER_NODE_ENTRIES) {
+				return HOTSingleThreadedChildPointer();
+			}
+			//the mapping must only address bytes of the keys and extract partial keys fitting into the node's partial key type
+			if(!image.mDiscriminativeBitsRepresentation.isValidForMaximumKeyLength(MAXIMUM_KEY_LENGTH)
+				|| image.mDiscriminativeBitsRepresentation.calculateNumberBitsUsed() > sizeof(typename NodeType::PartialKeyType) * 8u) {
+				return HOTSingleThreadedChildPointer();
+			}
+			hot::commons::NodeAllocationInformation const & allocationInformation = hot::commons::NodeAllocationInformations<NodeType>::getAllocationInformation(numberEntries);
+			if(image.mUsedEntriesMask != allocationInformation.mEntriesMask || recordHeader.mSizeInBytes != allocationInformation.mTotalSizeInBytes) {
+				return HOTSingleThreadedChildPointer();
+			}
+
+			//the children, which are nodes, must be the most recently rebuilt subtrees in the same order
+			HOTSingleThreadedChildPointer const * imageChildren = reinterpret_cast<HOTSingleThreadedChildPointer const *>(reinterpret_cast<char const*>(&image) + allocationInformation.mPointerOffset);
+			size_t numberChildNodes = 0u;
+			uint16_t maximumChildHeight = 0u;
+			for(size_t entryIndex = numberEntries; entryIndex > 0u; --entryIndex) {
+				HOTSingleThreadedChildPointer const & imageChild = imageChildren[entryIndex - 1u];
+				if(imageChild.isLeaf()) {
+					continue;
+				}
+				if(numberChildNodes == pendingSubtrees.size()) {
+					return HOTSingleThreadedChildPointer();
+				}
+				std::pair<uint64_t, HOTSingleThreadedChildPointer> const & childNode = pendingSubtrees[pendingSubtrees.size() - 1u - numberChildNodes];
+				if(imageChild.isUnused() || getReferencedRecordIndex(imageChild) != childNode.first || imageChild.getNodeType() != childNode.second.getNodeType()) {
+					return HOTSingleThreadedChildPointer();
+				}
+				maximumChildHeight = std::max(maximumChildHeight, childNode.second.getHeight());
+				++numberChildNodes;
+			}
+			if(image.mHeight != maximumChildHeight + 1u) {
+				return HOTSingleThreadedChildPointer();
+			}
+
+			NodeType* node = new (static_cast<uint16_t>(numberEntries)) NodeType(image.mHeight, static_cast<uint16_t>(numberEntries), image.mDiscriminativeBitsRepresentation);
+			std::memcpy(
+				reinterpret_cast<char*>(node) + sizeof(HOTSingleThreadedNodeBase), reinterpret_cast<char const*>(&image) + sizeof(HOTSingleThreadedNodeBase),
+				allocationInformation.mTotalSizeInBytes - sizeof(HOTSingleThreadedNodeBase)
+			);
+			HOTSingleThreadedChildPointer* children = node->getPointers();
+			for(size_t entryIndex = numberEntries; entryIndex > 0u; --entryIndex) {
+				if(!children[entryIndex - 1u].isLeaf()) {
+					children[entryIndex - 1u] = pendingSubtrees.back().second;
+					pendingSubtrees.pop_back();
+				}
+			}
+			return node->toChildPointer();
+		});
+
+		isValid = !rebuiltNode.isUnused();
+		if(isValid) {
+			pendingSubtrees.emplace_back(recordIndex, rebuiltNode);
+		}
+	}
+
+	HOTSingleThreadedChildPointer encodedRoot = *reinterpret_cast<HOTSingleThreadedChildPointer const *>(&fileHeader.mEncodedRoot);
+	if(isValid && encodedRoot.isAValidNode()) {
+		//the root is stored last and all other nodes are contained in its subtree
+		isValid = pendingSubtrees.size() == 1u && getReferencedRecordIndex(encodedRoot) == pendingSubtrees.back().first
+			&& encodedRoot.getNodeType() == pendingSubtrees.back().second.getNodeType();
+	} else {
+		isValid = isValid && pendingSubtrees.empty();
+	}
+
+	if(!isValid) {
+		for(std::pair<uint64_t, HOTSingleThreadedChildPointer> & pendingSubtree : pendingSubtrees) {
+			pendingSubtree.second.deleteSubtree();
+		}
+		return { false, HOTSingleThreadedChildPointer() };
+	}
+	return { true, encodedRoot.isAValidNode() ? pendingSubtrees.back().second : encodedRoot };
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::begin() const {
 	return isEmpty() ? END_ITERATOR : const_iterator(&mRoot);
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreaded<ValueType, KeyExtractor>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor>::end() const {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::end() const {
 	return END_ITERATOR;
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreaded<ValueType, KeyExtractor>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor>::find(typename HOTSingleThreaded<ValueType, KeyExtractor>::KeyType const & searchKey) const {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::const_reverse_iterator HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::rbegin() const {
+	if(isEmpty()) {
+		return const_reverse_iterator(END_ITERATOR);
+	}
+
+	const_iterator it(&mRoot, &mRoot + 1);
+	it.descendRightmost();
+	return const_reverse_iterator(it);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::const_reverse_iterator HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::rend() const {
+	return const_reverse_iterator(END_ITERATOR);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::find(typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::KeyType const & searchKey) const {
 	return isRootANode() ? findForNonEmptyTrie(searchKey) : END_ITERATOR;
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreaded<ValueType, KeyExtractor>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor>::findForNonEmptyTrie(typename HOTSingleThreaded<ValueType, KeyExtractor>::KeyType const & searchKey) const {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::findForNonEmptyTrie(typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::KeyType const & searchKey) const {
 	HOTSingleThreadedChildPointer const * current = &mRoot;
 
-	auto const & fixedSizedSearchKey = idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(extractKey(searchKey)));
-	uint8_t const* searchKeyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizedSearchKey);
+	auto const & fixedSizedSearchKey = idx::contenthelpers::toByteComparableKey(extractKey(searchKey));
+	auto searchKeyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizedSearchKey);
 
-	HOTSingleThreaded<ValueType, KeyExtractor>::const_iterator it(current, current + 1);
+	HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::const_iterator it(current, current + 1);
 	while(!current->isLeaf()) {
-		current = it.descend(current->executeForSpecificNodeType(true, [&](auto & node) {
+		current = it.descend(current->executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(true, [&](auto & node) {
 			return node.search(searchKeyBytes);
 		}), current->getNode()->end());
 	}
@@ -336,20 +1504,20 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline t
 	return idx::contenthelpers::contentEquals(extractKey(leafValue), searchKey) ? it : END_ITERATOR;
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> inline  __attribute__((always_inline)) typename HOTSingleThreaded<ValueType, KeyExtractor>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor>::lower_bound(typename HOTSingleThreaded<ValueType, KeyExtractor>::KeyType const & searchKey) const {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline  __attribute__((always_inline)) typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::lower_bound(typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::KeyType const & searchKey) const {
 	return lower_or_upper_bound(searchKey, true);
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> inline  __attribute__((always_inline)) typename HOTSingleThreaded<ValueType, KeyExtractor>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor>::upper_bound(typename HOTSingleThreaded<ValueType, KeyExtractor>::KeyType const & searchKey) const {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline  __attribute__((always_inline)) typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::upper_bound(typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::KeyType const & searchKey) const {
 	return lower_or_upper_bound(searchKey, false);
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> inline  __attribute__((always_inline)) typename HOTSingleThreaded<ValueType, KeyExtractor>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor>::lower_or_upper_bound(typename HOTSingleThreaded<ValueType, KeyExtractor>::KeyType const & searchKey, bool is_lower_bound) const {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline  __attribute__((always_inline)) typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::lower_or_upper_bound(typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::KeyType const & searchKey, bool is_lower_bound) const {
 	if(isEmpty()) {
 		return END_ITERATOR;
 	}
 
-	HOTSingleThreaded<ValueType, KeyExtractor>::const_iterator it(&mRoot, &mRoot + 1);
+	HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::const_iterator it(&mRoot, &mRoot + 1);
 
 	if(mRoot.isLeaf()) {
 		ValueType const & existingValue = idx::contenthelpers::tidToValue<ValueType>(mRoot.getTid());
@@ -357,22 +1525,22 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline
 
 		return (idx::contenthelpers::contentEquals(searchKey, existingKey) || compareKeys(existingKey, searchKey)) ? it : END_ITERATOR;
 	} else {
-		auto const & fixedSizeKey = idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(searchKey));
-		uint8_t const* keyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
+		auto const & fixedSizeKey = idx::contenthelpers::toByteComparableKey(searchKey);
+		auto keyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
 
 		HOTSingleThreadedChildPointer const * current = &mRoot;
 		std::array<uint16_t, 64> mostSignificantBitIndexes;
 
 		while(!current->isLeaf()) {
-			current = it.descend(current->executeForSpecificNodeType(true, [&](auto & node) {
+			current = it.descend(current->executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(true, [&](auto & node) {
 				mostSignificantBitIndexes[it.mCurrentDepth] = node.mDiscriminativeBitsRepresentation.mMostSignificantDiscriminativeBitIndex;
 				return node.search(keyBytes);
 			}), current->getNode()->end());
 		}
 
 		ValueType const & existingValue = *it;
-		auto const & existingFixedSizeKey = idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(extractKey(existingValue)));
-		uint8_t const* existingKeyBytes = idx::contenthelpers::interpretAsByteArray(existingFixedSizeKey);
+		auto const & existingFixedSizeKey = idx::contenthelpers::toByteComparableKey(extractKey(existingValue));
+		auto existingKeyBytes = idx::contenthelpers::interpretAsByteArray(existingFixedSizeKey);
 
 		bool keysDiff = hot::commons::executeForDiffingKeys(existingKeyBytes, keyBytes, idx::contenthelpers::getMaxKeyLength<KeyType>(), [&](hot::commons::DiscriminativeBit const & significantKeyInformation) {
 			//searches for the node to insert the new value into.
@@ -386,7 +1554,7 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline
 			}
 
 			HOTSingleThreadedChildPointer const* currentNode = it.mNodeStack[it.mCurrentDepth].getCurrent();
-			currentNode->executeForSpecificNodeType(false, [&](auto const &existingNode) -> void {
+			currentNode->executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto const &existingNode) -> void {
 				hot::commons::InsertInformation const & insertInformation = existingNode.getInsertInformation(entryIndex, significantKeyInformation);
 
 				unsigned int nextEntryIndex = insertInformation.mKeyInformation.mValue
@@ -414,10 +1582,82 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline
 	}
 }
 
-inline void insertNewValueIntoNode(std::array<HOTSingleThreadedInsertStackEntry, 64> & insertStack, hot::commons::DiscriminativeBit const & significantKeyInformation, unsigned int insertDepth, unsigned int leafDepth, HOTSingleThreadedChildPointer const & valueToInsert) {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::floor(typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::KeyType const & searchKey) const {
+	return floor_or_predecessor(searchKey, true);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::predecessor(typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::KeyType const & searchKey) const {
+	return floor_or_predecessor(searchKey, false);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::const_iterator HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::floor_or_predecessor(typename HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::KeyType const & searchKey, bool is_floor) const {
+	if(isEmpty()) {
+		return END_ITERATOR;
+	}
+
+	HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::const_iterator it(&mRoot, &mRoot + 1);
+
+	if(mRoot.isLeaf()) {
+		ValueType const & existingValue = idx::contenthelpers::tidToValue<ValueType>(mRoot.getTid());
+		KeyType const & existingKey = extractKey(existingValue);
+
+		return (compareKeys(existingKey, searchKey) || (is_floor && idx::contenthelpers::contentEquals(searchKey, existingKey))) ? it : END_ITERATOR;
+	} else {
+		auto const & fixedSizeKey = idx::contenthelpers::toByteComparableKey(searchKey);
+		auto keyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
+
+		HOTSingleThreadedChildPointer const * current = &mRoot;
+		std::array<uint16_t, 64> mostSignificantBitIndexes;
+
+		while(!current->isLeaf()) {
+			current = it.descend(current->executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(true, [&](auto & node) {
+				mostSignificantBitIndexes[it.mCurrentDepth] = node.mDiscriminativeBitsRepresentation.mMostSignificantDiscriminativeBitIndex;
+				return node.search(keyBytes);
+			}), current->getNode()->end());
+		}
+
+		ValueType const & existingValue = *it;
+		auto const & existingFixedSizeKey = idx::contenthelpers::toByteComparableKey(extractKey(existingValue));
+		auto existingKeyBytes = idx::contenthelpers::interpretAsByteArray(existingFixedSizeKey);
+
+		bool keysDiff = hot::commons::executeForDiffingKeys(existingKeyBytes, keyBytes, idx::contenthelpers::getMaxKeyLength<KeyType>(), [&](hot::commons::DiscriminativeBit const & significantKeyInformation) {
+			//determines the subtree the search key would be inserted next to, in the same way as lower_or_upper_bound does
+			HOTSingleThreadedChildPointer const * child = it.mNodeStack[it.mCurrentDepth].getCurrent();
+			unsigned int entryIndex = child - it.mNodeStack[--it.mCurrentDepth].getCurrent()->getNode()->getPointers();
+			while (it.mCurrentDepth > 0 && significantKeyInformation.mAbsoluteBitIndex < mostSignificantBitIndexes[it.mCurrentDepth]) {
+				child = it.mNodeStack[it.mCurrentDepth].getCurrent();
+				entryIndex = child - it.mNodeStack[--it.mCurrentDepth].getCurrent()->getNode()->getPointers();
+			}
+
+			HOTSingleThreadedChildPointer const* currentNode = it.mNodeStack[it.mCurrentDepth].getCurrent();
+			currentNode->executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto const &existingNode) -> void {
+				hot::commons::InsertInformation const & insertInformation = existingNode.getInsertInformation(entryIndex, significantKeyInformation);
+				HOTSingleThreadedChildPointer const * firstEntryInAffectedSubtree = existingNode.getPointers() + insertInformation.getFirstIndexInAffectedSubtree();
+
+				if(insertInformation.mKeyInformation.mValue) {
+					//the search key is larger than all keys in the affected subtree, hence the result is the largest value of the affected subtree
+					it.descend(firstEntryInAffectedSubtree + insertInformation.getNumberEntriesInAffectedSubtree() - 1, existingNode.end());
+					it.descendRightmost();
+				} else {
+					//the search key is smaller than all keys in the affected subtree, hence the result is the value preceding the affected subtree
+					it.descend(firstEntryInAffectedSubtree, existingNode.end());
+					--it;
+				}
+			});
+		});
+
+		if(!keysDiff && !is_floor) {
+			--it;
+		}
+
+		return it;
+	}
+}
+
+template<size_t maximumKeyLength> inline void insertNewValueIntoNode(std::array<HOTSingleThreadedInsertStackEntry, 64> & insertStack, hot::commons::DiscriminativeBit const & significantKeyInformation, unsigned int insertDepth, unsigned int leafDepth, HOTSingleThreadedChildPointer const & valueToInsert) {
 	HOTSingleThreadedInsertStackEntry const & insertStackEntry = insertStack[insertDepth];
 
-	insertStackEntry.mChildPointer->executeForSpecificNodeType(false, [&](auto const &existingNode) -> void {
+	insertStackEntry.mChildPointer->executeForSpecificNodeType<maximumKeyLength>(false, [&](auto &existingNode) -> void {
 		uint32_t entryIndex = insertStackEntry.mSearchResultForInsert.mEntryIndex;
 		hot::commons::InsertInformation const &insertInformation = existingNode.getInsertInformation(
 			entryIndex, significantKeyInformation
@@ -437,7 +1677,7 @@ inline void insertNewValueIntoNode(std::array<HOTSingleThreadedInsertStackEntry,
 				insertInformation.mKeyInformation, leafEntry, valueToInsert
 			), true);
 		} else if(isSingleEntry) { //in this case the single entry is a boundary node -> insert the value into the child partition
-			insertStack[nextInsertDepth].mChildPointer->executeForSpecificNodeType(false, [&](auto &childPartition) -> void {
+			insertStack[nextInsertDepth].mChildPointer->executeForSpecificNodeType<maximumKeyLength>(false, [&](auto &childPartition) -> void {
 				insertNewValueResultingInNewPartitionRoot(childPartition, insertStack, significantKeyInformation, nextInsertDepth,
 														  valueToInsert);
 			});
@@ -447,7 +1687,7 @@ inline void insertNewValueIntoNode(std::array<HOTSingleThreadedInsertStackEntry,
 	});
 }
 
-template<typename NodeType> inline void insertNewValueResultingInNewPartitionRoot(NodeType const &existingNode,
+template<typename NodeType> inline void insertNewValueResultingInNewPartitionRoot(NodeType &existingNode,
 																				  std::array<HOTSingleThreadedInsertStackEntry, 64> &insertStack,
 																				  const hot::commons::DiscriminativeBit &keyInformation,
 																				  unsigned int insertDepth,
@@ -456,8 +1696,10 @@ template<typename NodeType> inline void insertNewValueResultingInNewPartitionRoo
 	if (!existingNode.isFull()) {
 		//As the insert results in a new partition root, no prefix bits are set and all entries in the partition are affected
 		hot::commons::InsertInformation insertInformation { 0, 0, static_cast<uint32_t>(existingNode.getNumberEntries()), keyInformation};
-		*(insertStackEntry.mChildPointer) = existingNode.addEntry(insertInformation, valueToInsert);
-		delete &existingNode;
+		if(!existingNode.tryToAddEntryInPlace(insertInformation, valueToInsert)) {
+			*(insertStackEntry.mChildPointer) = existingNode.addEntry(insertInformation, valueToInsert);
+			delete &existingNode;
+		}
 	} else {
 		assert(keyInformation.mAbsoluteBitIndex != insertStackEntry.mSearchResultForInsert.mMostSignificantBitIndex);
 		hot::commons::BiNode<HOTSingleThreadedChildPointer> const &binaryNode = hot::commons::BiNode<HOTSingleThreadedChildPointer>::createFromExistingAndNewEntry(keyInformation, *insertStackEntry.mChildPointer, valueToInsert);
@@ -465,16 +1707,18 @@ template<typename NodeType> inline void insertNewValueResultingInNewPartitionRoo
 	}
 }
 
-template<typename NodeType> inline void insertNewValue(NodeType const &existingNode,
+template<typename NodeType> inline void insertNewValue(NodeType &existingNode,
 													   std::array<HOTSingleThreadedInsertStackEntry, 64> &insertStack,
 													   hot::commons::InsertInformation const &insertInformation,
 													   unsigned int insertDepth, HOTSingleThreadedChildPointer const &valueToInsert) {
 	HOTSingleThreadedInsertStackEntry const & insertStackEntry = insertStack[insertDepth];
 
 	if (!existingNode.isFull()) {
-		HOTSingleThreadedChildPointer newNodePointer = existingNode.addEntry(insertInformation, valueToInsert);
-		*(insertStackEntry.mChildPointer) = newNodePointer;
-		delete &existingNode;
+		if(!existingNode.tryToAddEntryInPlace(insertInformation, valueToInsert)) {
+			HOTSingleThreadedChildPointer newNodePointer = existingNode.addEntry(insertInformation, valueToInsert);
+			*(insertStackEntry.mChildPointer) = newNodePointer;
+			delete &existingNode;
+		}
 	} else {
 		assert(insertInformation.mKeyInformation.mAbsoluteBitIndex != insertStackEntry.mSearchResultForInsert.mMostSignificantBitIndex);
 		if (insertInformation.mKeyInformation.mAbsoluteBitIndex > insertStackEntry.mSearchResultForInsert.mMostSignificantBitIndex) {
@@ -492,7 +1736,7 @@ template<typename NodeType> inline void insertNewValue(NodeType const &existingN
 
 inline void integrateBiNodeIntoTree(std::array<HOTSingleThreadedInsertStackEntry, 64> & insertStack, unsigned int currentDepth, hot::commons::BiNode<HOTSingleThreadedChildPointer> const & splitEntries, bool const newIsRight) {
 	if(currentDepth == 0) {
-		*insertStack[0].mChildPointer = hot::commons::createTwoEntriesNode<HOTSingleThreadedChildPointer, HOTSingleThreadedNode>(splitEntries)->toChildPointer();
+		*insertStack[0].mChildPointer = createTwoEntriesNode(splitEntries);
 	} else {
 		unsigned int parentDepth = currentDepth - 1;
 		HOTSingleThreadedInsertStackEntry const & parentInsertStackEntry = insertStack[parentDepth];
@@ -500,7 +1744,7 @@ inline void integrateBiNodeIntoTree(std::array<HOTSingleThreadedInsertStackEntry
 
 		HOTSingleThreadedNodeBase* existingParentNode = parentNodePointer.getNode();
 		if(existingParentNode->mHeight > splitEntries.mHeight) { //create intermediate partition if height(partition) + 1 < height(parentPartition)
-			*insertStack[currentDepth].mChildPointer = hot::commons::createTwoEntriesNode<HOTSingleThreadedChildPointer, HOTSingleThreadedNode>(splitEntries)->toChildPointer();
+			*insertStack[currentDepth].mChildPointer = createTwoEntriesNode(splitEntries);
 		} else { //integrate nodes into parent partition
 			hot::commons::DiscriminativeBit const significantKeyInformation { splitEntries.mDiscriminativeBitIndex, newIsRight };
 
@@ -513,9 +1757,15 @@ inline void integrateBiNodeIntoTree(std::array<HOTSingleThreadedInsertStackEntry
 				HOTSingleThreadedChildPointer valueToInsert { (newIsRight) ? splitEntries.mRight : splitEntries.mLeft };
 				HOTSingleThreadedChildPointer valueToReplace { (newIsRight) ? splitEntries.mLeft : splitEntries.mRight };
 
-				if(!parentNode.isFull()) {
+				if(parentNode.tryToAddEntryInPlace(insertInformation, valueToInsert)) {
+					parentNode.getPointers()[parentInsertStackEntry.mSearchResultForInsert.mEntryIndex + entryOffset] = valueToReplace;
+					parentNode.updateSubtreeCount(parentInsertStackEntry.mSearchResultForInsert.mEntryIndex + entryOffset);
+					//the parent node was modified in place and therefore must not be deleted
+					return;
+				} else if(!parentNode.isFull()) {
 					HOTSingleThreadedChildPointer newNodePointer = parentNode.addEntry(insertInformation, valueToInsert);
 					newNodePointer.getNode()->getPointers()[parentInsertStackEntry.mSearchResultForInsert.mEntryIndex + entryOffset] = valueToReplace;
+					newNodePointer.getNode()->updateSubtreeCount(parentInsertStackEntry.mSearchResultForInsert.mEntryIndex + entryOffset);
 					*parentInsertStackEntry.mChildPointer = newNodePointer;
 				} else {
 					//The diffing Bit index cannot be larger as the parents mostSignificantBitIndex. the reason is that otherwise
@@ -532,6 +1782,7 @@ inline void integrateBiNodeIntoTree(std::array<HOTSingleThreadedInsertStackEntry
 					unsigned int correspondingEntryIndexInPart = parentInsertStackEntry.mSearchResultForInsert.mEntryIndex - (isInUpperPart * numberEntriesInLowerPart) + entryOffset;
 					HOTSingleThreadedChildPointer nodePointerContainingSplitEntries = (isInUpperPart) ? newSplitEntries.mRight : newSplitEntries.mLeft;
 					nodePointerContainingSplitEntries.getNode()->getPointers()[correspondingEntryIndexInPart] = valueToReplace;
+					nodePointerContainingSplitEntries.getNode()->updateSubtreeCount(correspondingEntryIndexInPart);
 					integrateBiNodeIntoTree(insertStack, parentDepth, newSplitEntries, true);
 				}
 				delete &parentNode;
@@ -546,7 +1797,7 @@ inline void integrateBiNodeIntoTree(std::array<HOTSingleThreadedInsertStackEntry
 	}
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> inline HOTSingleThreadedChildPointer HOTSingleThreaded<ValueType, KeyExtractor>::getNodeAtPath(std::initializer_list<unsigned int> path) {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline HOTSingleThreadedChildPointer HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::getNodeAtPath(std::initializer_list<unsigned int> path) {
 	HOTSingleThreadedChildPointer current = mRoot;
 	for(unsigned int entryIndex : path) {
 		assert(!current.isLeaf());
@@ -555,20 +1806,25 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline H
 	return current;
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> inline void HOTSingleThreaded<ValueType, KeyExtractor>::collectStatsForSubtree(HOTSingleThreadedChildPointer const & subTreeRoot, std::map<std::string, double> & stats) const {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline void HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::collectStatsForSubtree(HOTSingleThreadedChildPointer const & subTreeRoot, std::map<std::string, double> & stats) const {
 	if(!subTreeRoot.isLeaf()) {
-		subTreeRoot.executeForSpecificNodeType(true, [&, this](auto & node) -> void {
+		subTreeRoot.executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(true, [&, this](auto & node) -> void {
 			std::string nodeType = nodeAlgorithmToString(node.mNodeType);
 			stats["total"] += node.getNodeSizeInBytes();
 			stats[nodeType] += 1.0;
 			for(HOTSingleThreadedChildPointer const & childPointer : node) {
+				if(childPointer.isNode()) {
+					intptr_t addressDistance = reinterpret_cast<intptr_t>(childPointer.getNode()) - reinterpret_cast<intptr_t>(&node);
+					stats["parentChildAddressDistance"] += static_cast<double>(std::abs(addressDistance));
+					stats["numberChildNodes"] += 1.0;
+				}
 				this->collectStatsForSubtree(childPointer, stats);
 			}
 		});
 	}
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> std::pair<size_t, std::map<std::string, double>> HOTSingleThreaded<ValueType, KeyExtractor>::getStatistics() const {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> std::pair<size_t, std::map<std::string, double>> HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::getStatistics() const {
 	std::map<size_t, size_t> leafNodesPerDepth;
 	getValueDistribution(mRoot, 0, leafNodesPerDepth);
 
@@ -577,7 +1833,7 @@ template<typename ValueType, template <typename> typename KeyExtractor> std::pai
 
 	std::map<std::string, double> statistics;
 	statistics["height"] = mRoot.getHeight();
-	statistics["numberAllocations"] = HOTSingleThreadedNodeBase::getNumberAllocations();
+	statistics["numberAllocations"] = mNodeAllocatorPolicy.getMemoryPool()->getNumberAllocations();
 
 	size_t overallLeafNodeCount = 0;
 	for(auto leafNodesOnDepth : leafNodesPerDepth) {
@@ -600,11 +1856,19 @@ template<typename ValueType, template <typename> typename KeyExtractor> std::pai
 
 	size_t totalSize = statistics["total"];
 	statistics.erase("total");
+	double numberChildNodes = statistics["numberChildNodes"];
+	statistics["averageParentChildAddressDistance"] = (numberChildNodes > 0.0) ? (statistics["parentChildAddressDistance"] / numberChildNodes) : 0.0;
+	statistics.erase("parentChildAddressDistance");
+	statistics.erase("numberChildNodes");
+
+	uint16_t optimalHeight = isRootANode() ? combineEntryShapes(mRoot, true).finish().mHeight : mRoot.getHeight();
+	statistics["optimalHeight"] = optimalHeight;
+	statistics["heightAboveOptimum"] = mRoot.getHeight() - optimalHeight;
 
 	return {totalSize, statistics };
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> inline void HOTSingleThreaded<ValueType, KeyExtractor>::getValueDistribution(HOTSingleThreadedChildPointer const & childPointer, size_t depth, std::map<size_t, size_t> & leafNodesPerDepth) const {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline void HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::getValueDistribution(HOTSingleThreadedChildPointer const & childPointer, size_t depth, std::map<size_t, size_t> & leafNodesPerDepth) const {
 	if(childPointer.isLeaf()) {
 		++leafNodesPerDepth[depth];
 	} else {
@@ -614,11 +1878,11 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline v
 	}
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor> inline void HOTSingleThreaded<ValueType, KeyExtractor>::getBinaryTrieValueDistribution(HOTSingleThreadedChildPointer const & childPointer, size_t binaryTrieDepth, std::map<size_t, size_t> & leafNodesPerDepth) const {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> inline void HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::getBinaryTrieValueDistribution(HOTSingleThreadedChildPointer const & childPointer, size_t binaryTrieDepth, std::map<size_t, size_t> & leafNodesPerDepth) const {
 	if(childPointer.isLeaf()) {
 		++leafNodesPerDepth[binaryTrieDepth];
 	} else {
-		childPointer.executeForSpecificNodeType(true, [&, this](auto &node) {
+		childPointer.executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(true, [&, this](auto &node) {
 			std::array<uint8_t, 32> binaryEntryDepthsInNode = node.getEntryDepths();
 			size_t i=0;
 			for(HOTSingleThreadedChildPointer const & pointer : node) {
@@ -629,30 +1893,30 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline v
 	}
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor>
-bool HOTSingleThreaded<ValueType, KeyExtractor>::hasTheSameKey(intptr_t tid, HOTSingleThreaded<ValueType, KeyExtractor>::KeyType  const & key) {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy>
+bool HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::hasTheSameKey(intptr_t tid, HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::KeyType  const & key) {
 	KeyType const & storedKey = extractKey(idx::contenthelpers::tidToValue<ValueType>(tid));
 	return idx::contenthelpers::contentEquals(storedKey, key);
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor>
-HOTSingleThreadedDeletionInformation HOTSingleThreaded<ValueType, KeyExtractor>::determineDeletionInformation(
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy>
+HOTSingleThreadedDeletionInformation HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::determineDeletionInformation(
 	const std::array<HOTSingleThreadedInsertStackEntry, 64> &searchStack, unsigned int currentDepth) {
 	HOTSingleThreadedInsertStackEntry const & currentEntry = searchStack[currentDepth];
 	uint32_t indexOfEntryToRemove = currentEntry.mSearchResultForInsert.mEntryIndex;
-	return currentEntry.mChildPointer->executeForSpecificNodeType(false, [&](auto const & currentNode) {
+	return currentEntry.mChildPointer->executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto const & currentNode) {
 		return currentNode.getDeletionInformation(indexOfEntryToRemove);
 	});
 
 }
 
-template<typename ValueType, template <typename> typename KeyExtractor>
-size_t HOTSingleThreaded<ValueType, KeyExtractor>::getHeight() const {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy>
+size_t HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>::getHeight() const {
 	return isEmpty() ? 0 : mRoot.getHeight();
 
 }
 
 
-} }
+} } }
 
 #endif
@@ -6,8 +6,9 @@
 
 #include "hot/singlethreaded/HOTSingleThreadedChildPointerInterface.hpp"
 #include "hot/singlethreaded/HOTSingleThreadedNode.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace singlethreaded {
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 constexpr intptr_t NODE_ALGORITHM_TYPE_EXTRACTION_MASK = 0x7u;
 constexpr intptr_t POINTER_AND_IS_LEAF_VALUE_MASK = 15u;
@@ -25,17 +26,30 @@ template<hot::commons::NodeType  nodeAlgorithmType> inline auto HOTSingleThreade
 	return reinterpret_cast<HOTSingleThreadedNode<DiscriminativeBitsRepresentationType, PartialKeyType> *>(node);
 }
 
-template<typename Operation> inline __attribute__((always_inline)) auto HOTSingleThreadedChildPointer::executeForSpecificNodeType(bool const withPrefetch, Operation const & operation) const {
+template<size_t maximumKeyLength, typename Operation> inline __attribute__((always_inline)) auto HOTSingleThreadedChildPointer::executeForSpecificNodeType(bool const withPrefetch, Operation const & operation) const {
 	HOTSingleThreadedNodeBase const * node = getNode();
 
 	if(withPrefetch) {
-		__builtin_prefetch(node);
-		__builtin_prefetch(reinterpret_cast<char const*>(node) + 64);
-		__builtin_prefetch(reinterpret_cast<char const*>(node) + 128);
-		__builtin_prefetch(reinterpret_cast<char const*>(node) + 192);
+		prefetch();
 	}
 
-	switch(getNodeType()) {
+	return executeForNodeType(getNodeType(), node, operation, std::integral_constant<bool, hot::commons::hasOnlySingleMaskNodeTypes(maximumKeyLength)>());
+}
+
+template<size_t maximumKeyLength, typename Operation> inline __attribute__((always_inline)) auto HOTSingleThreadedChildPointer::executeForSpecificNodeType(bool const withPrefetch, Operation const & operation) {
+	HOTSingleThreadedNodeBase * node = getNode();
+
+	if(withPrefetch) {
+		prefetch();
+	}
+
+	return executeForNodeType(getNodeType(), node, operation, std::integral_constant<bool, hot::commons::hasOnlySingleMaskNodeTypes(maximumKeyLength)>());
+}
+
+template<typename NodeBaseType, typename Operation> inline __attribute__((always_inline)) auto HOTSingleThreadedChildPointer::executeForNodeType(
+	hot::commons::NodeType nodeType, NodeBaseType * node, Operation const & operation, std::false_type
+) {
+	switch(nodeType) {
 		case hot::commons::NodeType ::SINGLE_MASK_8_BIT_PARTIAL_KEYS:
 			return operation(*castToNode<hot::commons::NodeType ::SINGLE_MASK_8_BIT_PARTIAL_KEYS>(node));
 		case hot::commons::NodeType ::SINGLE_MASK_16_BIT_PARTIAL_KEYS:
@@ -55,33 +69,17 @@ template<typename Operation> inline __attribute__((always_inline)) auto HOTSingl
 	}
 }
 
-template<typename Operation> inline __attribute__((always_inline)) auto HOTSingleThreadedChildPointer::executeForSpecificNodeType(bool const withPrefetch, Operation const & operation) {
-	HOTSingleThreadedNodeBase * node = getNode();
-
-	if(withPrefetch) {
-		__builtin_prefetch(node);
-		__builtin_prefetch(reinterpret_cast<char*>(node) + 64);
-		__builtin_prefetch(reinterpret_cast<char*>(node) + 128);
-		__builtin_prefetch(reinterpret_cast<char*>(node) + 192);
-	}
-
-	switch(getNodeType()) {
+template<typename NodeBaseType, typename Operation> inline __attribute__((always_inline)) auto HOTSingleThreadedChildPointer::executeForNodeType(
+	hot::commons::NodeType nodeType, NodeBaseType * node, Operation const & operation, std::true_type
+) {
+	assert(nodeType <= hot::commons::NodeType ::SINGLE_MASK_32_BIT_PARTIAL_KEYS);
+	switch(nodeType) {
 		case hot::commons::NodeType ::SINGLE_MASK_8_BIT_PARTIAL_KEYS:
 			return operation(*castToNode<hot::commons::NodeType ::SINGLE_MASK_8_BIT_PARTIAL_KEYS>(node));
 		case hot::commons::NodeType ::SINGLE_MASK_16_BIT_PARTIAL_KEYS:
 			return operation(*castToNode<hot::commons::NodeType ::SINGLE_MASK_16_BIT_PARTIAL_KEYS>(node));
-		case hot::commons::NodeType ::SINGLE_MASK_32_BIT_PARTIAL_KEYS:
+		default: //hot::commons::NodeType ::SINGLE_MASK_32_BIT_PARTIAL_KEYS:
 			return operation(*castToNode<hot::commons::NodeType ::SINGLE_MASK_32_BIT_PARTIAL_KEYS>(node));
-		case hot::commons::NodeType ::MULTI_MASK_8_BYTES_AND_8_BIT_PARTIAL_KEYS:
-			return operation(*castToNode<hot::commons::NodeType ::MULTI_MASK_8_BYTES_AND_8_BIT_PARTIAL_KEYS>(node));
-		case hot::commons::NodeType ::MULTI_MASK_8_BYTES_AND_16_BIT_PARTIAL_KEYS:
-			return operation(*castToNode<hot::commons::NodeType ::MULTI_MASK_8_BYTES_AND_16_BIT_PARTIAL_KEYS>(node));
-		case hot::commons::NodeType ::MULTI_MASK_8_BYTES_AND_32_BIT_PARTIAL_KEYS:
-			return operation(*castToNode<hot::commons::NodeType ::MULTI_MASK_8_BYTES_AND_32_BIT_PARTIAL_KEYS>(node));
-		case hot::commons::NodeType ::MULTI_MASK_16_BYTES_AND_16_BIT_PARTIAL_KEYS:
-			return operation(*castToNode<hot::commons::NodeType ::MULTI_MASK_16_BYTES_AND_16_BIT_PARTIAL_KEYS>(node));
-		default: //hot::commons::NodeType ::MULTI_MASK_32_BYTES_AND_32_BIT_PARTIAL_KEYS:
-			return operation(*castToNode<hot::commons::NodeType::MULTI_MASK_32_BYTES_AND_32_BIT_PARTIAL_KEYS>(node));
 	}
 }
 
@@ -138,6 +136,14 @@ inline intptr_t HOTSingleThreadedChildPointer::getTid() const {
 	return mPointer >> 1;
 }
 
+inline void HOTSingleThreadedChildPointer::prefetch() const {
+	char const * node = reinterpret_cast<char const*>(getNode());
+	__builtin_prefetch(node);
+	__builtin_prefetch(node + 64);
+	__builtin_prefetch(node + 128);
+	__builtin_prefetch(node + 192);
+}
+
 inline bool HOTSingleThreadedChildPointer::isLeaf() const {
 	return mPointer & 1;
 }
@@ -158,8 +164,8 @@ inline uint16_t HOTSingleThreadedChildPointer::getHeight() const {
 	return isLeaf() ? 0 : getNode()->mHeight;
 }
 
-template<typename... Args> inline __attribute__((always_inline)) auto HOTSingleThreadedChildPointer::search(Args... args) const {
-	return executeForSpecificNodeType(true,	[&](const auto & node) {
+template<size_t maximumKeyLength, typename... Args> inline __attribute__((always_inline)) auto HOTSingleThreadedChildPointer::search(Args... args) const {
+	return executeForSpecificNodeType<maximumKeyLength>(true,	[&](const auto & node) {
 		return node.search(args...);
 	});
 }
@@ -168,6 +174,10 @@ inline unsigned int HOTSingleThreadedChildPointer::getNumberEntries() const {
 	return isLeaf() ? 1 : getNode()->getNumberEntries();
 }
 
+inline size_t HOTSingleThreadedChildPointer::getNumberValuesInSubtree() const {
+	return isLeaf() ? 1u : ((getNode() == nullptr) ? 0u : getNode()->getNumberValuesInSubtree());
+}
+
 inline std::set<uint16_t> HOTSingleThreadedChildPointer::getDiscriminativeBits() const {
 	return executeForSpecificNodeType(false, [&](const auto & node) {
 		return node.mDiscriminativeBitsRepresentation.getDiscriminativeBits();
@@ -193,6 +203,6 @@ inline void HOTSingleThreadedChildPointer::deleteSubtree() {
 	}
 }
 
-} }
+} } }
 
 #endif
@@ -1,12 +1,15 @@
 #ifndef __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_CHILD_POINTER_INTERFACE__
 #define __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_CHILD_POINTER_INTERFACE__
 
+#include <cstdint>
 #include <set>
+#include <type_traits>
 
 #include <hot/commons/DiscriminativeBit.hpp>
 #include <hot/commons/NodeType.hpp>
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace singlethreaded {
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 struct HOTSingleThreadedNodeBase;
 
@@ -26,12 +29,16 @@ public:
 	 * Be aware to only call this method on child pointer representing valid nodes.
 	 * For all other cases this may result in undefined behaviour.
 	 *
+	 * If the maximum length of the keys is known at compile time, only the node types which can occur for keys of this length are dispatched.
+	 * For keys of up to 8 bytes this restricts the dispatch to the single mask node types, which results in smaller code and fewer branches on the traversal path.
+	 *
+	 * @tparam maximumKeyLength the maximum length in bytes of the keys stored in the trie containing the node, which defaults to an unbounded key length
 	 * @tparam Operation the type of the operation to execute on the node, the return type of the operation determines the return type of the node
 	 * @param withPrefetch determines whether the node should be prefetched before invoking the operation
 	 * @param operation the type of the operation to execute on the node
 	 * @return the result of the operation invoked on the actual node
 	 */
-	template<typename Operation>
+	template<size_t maximumKeyLength = SIZE_MAX, typename Operation>
 	inline auto executeForSpecificNodeType(bool const withPrefetch, Operation const &operation) const;
 
 	/**
@@ -40,12 +47,16 @@ public:
 	 * Be aware to only call this method on child pointer representing valid nodes.
 	 * For all other cases this may result in undefined behaviour.
 	 *
+	 * If the maximum length of the keys is known at compile time, only the node types which can occur for keys of this length are dispatched.
+	 * For keys of up to 8 bytes this restricts the dispatch to the single mask node types, which results in smaller code and fewer branches on the traversal path.
+	 *
+	 * @tparam maximumKeyLength the maximum length in bytes of the keys stored in the trie containing the node, which defaults to an unbounded key length
 	 * @tparam Operation the type of the operation to execute on the node, the return type of the operation determines the return type of the node
 	 * @param withPrefetch determines whether the node should be prefetched before invoking the operation
 	 * @param operation the type of the operation to execute on the node
 	 * @return the result of the operation invoked on the actual node
 	 */
-	template<typename Operation>
+	template<size_t maximumKeyLength = SIZE_MAX, typename Operation>
 	inline auto executeForSpecificNodeType(bool const withPrefetch, Operation const &operation);
 
 	/**
@@ -110,6 +121,12 @@ public:
 	 */
 	inline intptr_t getTid() const;
 
+	/**
+	 * Issues prefetches for the first four cache lines of the node referenced by this child pointer.
+	 * Be aware that this is only meaningful for child pointers of type node.
+	 */
+	inline void prefetch() const;
+
 	/**
 	 * @return whether this child pointer instance points to a leaf value or a child node.
 	 */
@@ -133,7 +150,12 @@ public:
 
 	inline uint16_t getHeight() const;
 
-	template<typename... Args>
+	/**
+	 * searches the node represented by this child pointer
+	 *
+	 * @tparam maximumKeyLength the maximum length in bytes of the keys stored in the trie, which restricts the dispatched node types (see { @link #executeForSpecificNodeType })
+	 */
+	template<size_t maximumKeyLength = SIZE_MAX, typename... Args>
 	inline auto search(Args... args) const;
 
 	/**
@@ -145,6 +167,16 @@ public:
 	 */
 	inline unsigned int getNumberEntries() const;
 
+	/**
+	 * Determines the number of values stored in the subtree represented by this child pointer.
+	 * For a leaf this is one, for an unused child pointer zero and for a node the sum of its subtree counts.
+	 *
+	 * Be aware that this is only defined for nodes if subtree counts are maintained (see { @link SubtreeCountPolicy }).
+	 *
+	 * @return the number of values stored in the subtree
+	 */
+	inline size_t getNumberValuesInSubtree() const;
+
 	/**
 	 * Collects all discriminative bits used in the binary trie, this pointers instance references to.
 	 *
@@ -178,8 +210,21 @@ public:
 	 * deletes all nodes contained in this subtree, including this node itself
 	 */
 	inline void deleteSubtree();
+
+private:
+	/**
+	 * calls the passed operation with the actual node type, considering all node types
+	 */
+	template<typename NodeBaseType, typename Operation>
+	static inline auto executeForNodeType(hot::commons::NodeType nodeType, NodeBaseType * node, Operation const & operation, std::false_type hasOnlySingleMaskNodeTypes);
+
+	/**
+	 * calls the passed operation with the actual node type, considering only the single mask node types
+	 */
+	template<typename NodeBaseType, typename Operation>
+	static inline auto executeForNodeType(hot::commons::NodeType nodeType, NodeBaseType * node, Operation const & operation, std::true_type hasOnlySingleMaskNodeTypes);
 };
 
-} }
+} } }
 
 #endif
\ No newline at end of file
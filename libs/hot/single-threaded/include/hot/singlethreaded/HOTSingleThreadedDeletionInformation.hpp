@@ -5,8 +5,9 @@
 
 #include "hot/singlethreaded/HOTSingleThreadedChildPointerInterface.hpp"
 #include "hot/singlethreaded/HOTSingleThreadedNodeBaseInterface.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace singlethreaded {
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 /**
  * The deletion information required to create a new node by removing an entry from a given node.
@@ -108,6 +109,6 @@ private:
 	}
 };
 
-}}
+}}}
 
 #endif
\ No newline at end of file
@@ -0,0 +1,150 @@
+#ifndef __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_FILE_FORMAT__
+#define __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_FILE_FORMAT__
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+#include <hot/commons/NodeType.hpp>
+#include <hot/commons/PartialKeyMappingBase.hpp>
+
+#include "hot/singlethreaded/HOTSingleThreadedChildPointerInterface.hpp"
+#include "hot/singlethreaded/HOTSingleThreadedNodeCapacityPolicy.hpp"
+#include "hot/singlethreaded/HOTSingleThreadedSubtreeCountPolicy.hpp"
+#include "idx/contenthelpers/KeyUtilities.hpp"
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+/**
+ * The file format used to save and load instances of HOTSingleThreaded.
+ *
+ * A file consists of a file header followed by one record per node. The records are stored in depth first post order, hence the children of a node precede the node itself and the root is stored last.
+ * Each record consists of a record header and the image of the node's memory. In this image the address of the node's first child pointer is cleared
+ * and each child pointer referencing a node is replaced by a record reference. A record reference is a child pointer of the same node type, whose address is derived from the index of the child's record in the file
+ * and satisfies the same alignment requirements as the address of a node. Child pointers referencing leaves are stored unchanged.
+ *
+ * The images depend on the subtree count and node capacity policies, on whether long keys and the parallel bit operations emulation are supported as well as on the byte order of the platform. Files are therefore only loaded by programs using the same configuration.
+ * As the partial key mappings of the nodes address bytes of the keys' byte representations, files are moreover only loaded by tries whose keys have the same kind of type and the same maximum length.
+ */
+constexpr char HOT_SINGLE_THREADED_FILE_MAGIC[8] = { 'H', 'O', 'T', 'S', 'T', 'F', 'I', 'L' };
+constexpr uint32_t HOT_SINGLE_THREADED_FILE_FORMAT_VERSION = 2u;
+
+constexpr uintptr_t FILE_RECORD_REFERENCE_ALIGNMENT = 16u;
+//exceeds the size of the largest node type with the maximum number of entries
+constexpr size_t MAXIMUM_NODE_IMAGE_SIZE_IN_WORDS = 128u;
+
+constexpr uint32_t FILE_LAYOUT_WITH_SUBTREE_COUNTS = 1u;
+constexpr uint32_t FILE_LAYOUT_WITH_NODE_SLACK_CAPACITY = 2u;
+constexpr uint32_t FILE_LAYOUT_WITH_LONG_KEYS = 4u;
+constexpr uint32_t FILE_LAYOUT_WITH_PARALLEL_BIT_OPERATIONS_EMULATION = 8u;
+
+/**
+ * The kinds of key types distinguished by files. Key types of the same kind and maximum length have the same byte representation, e.g. c strings and length delimited keys.
+ */
+enum class FileKeyType : uint32_t {
+	UNSIGNED_INTEGER = 1u,
+	SIGNED_INTEGER = 2u,
+	FLOATING_POINT = 3u,
+	TUPLE = 4u,
+	STRING = 5u,
+	OTHER = 6u
+};
+
+template<typename KeyType> struct IsStringKey : public std::integral_constant<bool,
+	std::is_same<KeyType, char const *>::value || std::is_same<KeyType, idx::contenthelpers::LengthDelimitedKey>::value
+#if __cplusplus >= 201703L
+	|| std::is_same<KeyType, std::string_view>::value
+#endif
+> {
+};
+
+/**
+ * @tparam KeyType the type of the keys stored in a trie
+ * @return the kind of the key type, which is stored in the file header
+ */
+template<typename KeyType> constexpr FileKeyType getFileKeyType() {
+	return std::is_floating_point<KeyType>::value ? FileKeyType::FLOATING_POINT
+		: std::is_integral<KeyType>::value ? (std::is_signed<KeyType>::value ? FileKeyType::SIGNED_INTEGER : FileKeyType::UNSIGNED_INTEGER)
+		: idx::contenthelpers::IsTupleKey<KeyType>::value ? FileKeyType::TUPLE
+		: IsStringKey<KeyType>::value ? FileKeyType::STRING
+		: FileKeyType::OTHER;
+}
+
+struct HOTSingleThreadedFileHeader {
+	char mMagic[8];
+	uint32_t mFormatVersion;
+	/**
+	 * the node layout affecting options the file was written with
+	 */
+	uint32_t mLayoutFlags;
+	/**
+	 * the { @link FileKeyType } of the keys the file was written with
+	 */
+	uint32_t mKeyType;
+	/**
+	 * the maximum length of the keys the file was written with in bytes
+	 */
+	uint32_t mMaximumKeyLength;
+	uint64_t mNumberNodes;
+	/**
+	 * the raw value of the root's child pointer, encoded like the child pointers contained in the node images
+	 */
+	intptr_t mEncodedRoot;
+
+	/**
+	 * @return the layout flags of the nodes in the current configuration
+	 */
+	static constexpr uint32_t getCurrentLayoutFlags() {
+		return (SubtreeCountPolicy::MAINTAINS_SUBTREE_COUNTS ? FILE_LAYOUT_WITH_SUBTREE_COUNTS : 0u)
+			| ((NodeCapacityPolicy::getCapacity(2u) != 2u) ? FILE_LAYOUT_WITH_NODE_SLACK_CAPACITY : 0u)
+			| ((sizeof(hot::commons::ExtractionBytePositionType) > 1u) ? FILE_LAYOUT_WITH_LONG_KEYS : 0u)
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+			| FILE_LAYOUT_WITH_PARALLEL_BIT_OPERATIONS_EMULATION
+#endif
+			;
+	}
+
+	/**
+	 * @tparam KeyType the type of the keys stored in the trie reading the file
+	 * @return whether the file was written by a compatible program for keys of the same kind and maximum length
+	 */
+	template<typename KeyType> bool isCompatible() const {
+		return std::memcmp(mMagic, HOT_SINGLE_THREADED_FILE_MAGIC, sizeof(mMagic)) == 0 && mFormatVersion == HOT_SINGLE_THREADED_FILE_FORMAT_VERSION
+			&& mLayoutFlags == getCurrentLayoutFlags()
+			&& mKeyType == static_cast<uint32_t>(getFileKeyType<KeyType>()) && mMaximumKeyLength == idx::contenthelpers::getMaxKeyLength<KeyType>();
+	}
+};
+
+struct HOTSingleThreadedFileRecordHeader {
+	uint32_t mNodeType;
+	uint32_t mSizeInBytes;
+};
+
+static_assert(sizeof(HOTSingleThreadedFileHeader) % 8u == 0u, "records must be aligned to 8 bytes");
+static_assert(sizeof(HOTSingleThreadedFileRecordHeader) == 8u, "records must be aligned to 8 bytes");
+
+/**
+ * @param nodeType the type of the referenced node
+ * @param recordIndex the index of the referenced node's record
+ * @return the record reference replacing a child pointer to the node in the file
+ */
+inline HOTSingleThreadedChildPointer toRecordReference(hot::commons::NodeType nodeType, uint64_t recordIndex) {
+	//the smallest address is reserved for the null pointer
+	return HOTSingleThreadedChildPointer(nodeType, reinterpret_cast<HOTSingleThreadedNodeBase const *>(static_cast<uintptr_t>(recordIndex + 1u) * FILE_RECORD_REFERENCE_ALIGNMENT));
+}
+
+/**
+ * @param recordReference a record reference contained in a file
+ * @return the index of the referenced record
+ */
+inline uint64_t getReferencedRecordIndex(HOTSingleThreadedChildPointer const & recordReference) {
+	return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(recordReference.getNode()) / FILE_RECORD_REFERENCE_ALIGNMENT) - 1u;
+}
+
+} } }
+
+#endif
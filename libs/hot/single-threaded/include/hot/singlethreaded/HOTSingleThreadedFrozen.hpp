@@ -0,0 +1,400 @@
+#ifndef __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_FROZEN__
+#define __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_FROZEN__
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <hot/commons/Algorithms.hpp>
+#include <hot/commons/DiscriminativeBit.hpp>
+#include <hot/commons/InsertInformation.hpp>
+#include <hot/commons/ReverseIterator.hpp>
+
+#include "hot/singlethreaded/HOTSingleThreadedChildPointer.hpp"
+#include "hot/singlethreaded/HOTSingleThreadedFrozenIterator.hpp"
+#include "hot/singlethreaded/HOTSingleThreadedFrozenNode.hpp"
+
+#include "idx/contenthelpers/ContentEquals.hpp"
+#include "idx/contenthelpers/KeyComparator.hpp"
+#include "idx/contenthelpers/KeyUtilities.hpp"
+#include "idx/contenthelpers/OptionalValue.hpp"
+#include "idx/contenthelpers/TidConverters.hpp"
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+//the root entry consists of a node header and a single entry, which is either the root's value or a reference to the root node
+constexpr size_t FROZEN_TRIE_ROOT_ENTRY_WORDS = 2u;
+//the SIMD search of the partial keys of the last node may read up to 128 bytes past their start
+constexpr size_t FROZEN_TRIE_PADDING_WORDS = 16u;
+
+/**
+ * An immutable representation of a HOTSingleThreaded instance optimized for lookups (see { @link HOTSingleThreaded#freeze() }).
+ *
+ * All nodes are packed into a single contiguous buffer in breadth first order, hence the upper levels of the trie, which are accessed by every lookup, are located at the beginning of the buffer.
+ * The nodes keep the discriminative bits and partial keys of the original nodes and are searched in the same way. Their headers are reduced to the masks of the used and leaf entries,
+ * while the children are referenced by 32 bit offsets instead of 64 bit pointers (see { @link HOTSingleThreadedFrozenNode }).
+ * The buffer is relocatable, but the frozen trie cannot be modified. The values are stored verbatim as in the original trie.
+ *
+ * @tparam ValueType the value type of the frozen trie
+ * @tparam KeyExtractor the key extractor of the frozen trie
+ */
+template<typename ValueType, template <typename> typename KeyExtractor> class HOTSingleThreadedFrozen {
+public:
+	static KeyExtractor<ValueType> extractKey;
+	using KeyType = decltype(extractKey(std::declval<ValueType>()));
+	static typename idx::contenthelpers::KeyComparator<KeyType>::type compareKeys;
+	//restricts the node type dispatch to the node types, which can occur for keys of this length
+	static constexpr size_t MAXIMUM_KEY_LENGTH = idx::contenthelpers::getMaxKeyLength<KeyType>();
+
+	using const_iterator = HOTSingleThreadedFrozenIterator<ValueType>;
+	using const_reverse_iterator = hot::commons::ReverseIterator<const_iterator>;
+	static const_iterator END_ITERATOR;
+
+private:
+	std::vector<uint64_t> mBuffer;
+	size_t mNumberValues;
+	size_t mHeight;
+
+public:
+	/**
+	 * creates an empty frozen trie
+	 */
+	inline HOTSingleThreadedFrozen();
+
+	/**
+	 * creates a frozen copy of a trie
+	 *
+	 * @param root the root of the trie to copy
+	 * @throws std::length_error in case the nodes of the trie do not fit into 4GB
+	 */
+	inline explicit HOTSingleThreadedFrozen(HOTSingleThreadedChildPointer const & root);
+
+	inline bool isEmpty() const;
+
+	/**
+	 * @return the number of values contained in the frozen trie
+	 */
+	inline size_t getNumberValues() const;
+
+	/**
+	 * @return the height of the frozen trie, which equals the height of the trie it was created from
+	 */
+	inline size_t getHeight() const;
+
+	/**
+	 * @return the size of the buffer containing all nodes in bytes
+	 */
+	inline size_t getSizeInBytes() const;
+
+	/**
+	 * For a given key it looks up the stored value
+	 *
+	 * @param key the key to lookup
+	 * @return the looked up value. The result is valid, if a matching record was found.
+	 */
+	inline idx::contenthelpers::OptionalValue<ValueType> lookup(KeyType const & key) const;
+
+	/**
+	 * @return an iterator to the first value according to the key order.
+	 */
+	inline const_iterator begin() const;
+
+	/**
+	 * @return an iterator which is positioned after the last element.
+	 */
+	inline const_iterator end() const;
+
+	/**
+	 * @return a reverse iterator to the last value according to the key order
+	 */
+	inline const_reverse_iterator rbegin() const;
+
+	/**
+	 * @return the reverse iterator which is positioned before the first element
+	 */
+	inline const_reverse_iterator rend() const;
+
+	/**
+	 * @param searchKey the key to search for
+	 * @return an iterator to the value with the given key or the end iterator if no such value exists
+	 */
+	inline const_iterator find(KeyType const & searchKey) const;
+
+	/**
+	 * @param searchKey the key to search for
+	 * @return an iterator to the first value whose key is not smaller than the search key
+	 */
+	inline const_iterator lower_bound(KeyType const & searchKey) const;
+
+	/**
+	 * @param searchKey the key to search for
+	 * @return an iterator to the first value whose key is larger than the search key
+	 */
+	inline const_iterator upper_bound(KeyType const & searchKey) const;
+
+private:
+	inline const_iterator lower_or_upper_bound(KeyType const & searchKey, bool is_lower_bound) const;
+
+	inline idx::contenthelpers::OptionalValue<ValueType> extractAndMatchLeafValue(uint64_t tid, KeyType const & key) const;
+
+	/**
+	 * descends from the root entry to the leaf, which is the only candidate to contain the search key
+	 *
+	 * @param keyBytes the search key
+	 * @param it an iterator positioned at the root entry of a non empty frozen trie. It is positioned at the candidate afterwards.
+	 * @param mostSignificantBitIndexes receives the most significant discriminative bit of the node on each level of the path
+	 */
+	inline void descendToCandidate(idx::contenthelpers::KeyBytesType<KeyType> const & keyBytes, const_iterator & it, std::array<uint16_t, 64> & mostSignificantBitIndexes) const;
+};
+
+template<typename ValueType, template <typename> typename KeyExtractor> KeyExtractor<ValueType> HOTSingleThreadedFrozen<ValueType, KeyExtractor>::extractKey;
+template<typename ValueType, template <typename> typename KeyExtractor>
+	typename idx::contenthelpers::KeyComparator<typename HOTSingleThreadedFrozen<ValueType, KeyExtractor>::KeyType>::type
+	HOTSingleThreadedFrozen<ValueType, KeyExtractor>::compareKeys;
+
+template<typename ValueType, template <typename> typename KeyExtractor> typename HOTSingleThreadedFrozen<ValueType, KeyExtractor>::const_iterator HOTSingleThreadedFrozen<ValueType, KeyExtractor>::END_ITERATOR {};
+
+template<typename ValueType, template <typename> typename KeyExtractor> constexpr size_t HOTSingleThreadedFrozen<ValueType, KeyExtractor>::MAXIMUM_KEY_LENGTH;
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline HOTSingleThreadedFrozen<ValueType, KeyExtractor>::HOTSingleThreadedFrozen()
+	: mBuffer(FROZEN_TRIE_ROOT_ENTRY_WORDS, 0u), mNumberValues(0u), mHeight(0u) {
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline HOTSingleThreadedFrozen<ValueType, KeyExtractor>::HOTSingleThreadedFrozen(HOTSingleThreadedChildPointer const & root)
+	: HOTSingleThreadedFrozen() {
+	if(root.isLeaf()) {
+		HOTSingleThreadedFrozenNodeBase & rootEntry = *reinterpret_cast<HOTSingleThreadedFrozenNodeBase*>(mBuffer.data());
+		rootEntry.mUsedEntriesMask = rootEntry.mLeafEntriesMask = 1u;
+		mBuffer[1] = static_cast<uint64_t>(root.getTid());
+		mNumberValues = 1u;
+		return;
+	} else if(root.isUnused()) {
+		return;
+	}
+
+	//the offsets of all nodes are determined upfront. The children of each node are contiguous in breadth first order.
+	std::vector<HOTSingleThreadedChildPointer> nodesInBreadthFirstOrder { root };
+	std::vector<uint64_t> wordOffsets;
+	uint64_t numberWords = FROZEN_TRIE_ROOT_ENTRY_WORDS;
+	for(size_t nodeIndex = 0u; nodeIndex < nodesInBreadthFirstOrder.size(); ++nodeIndex) {
+		HOTSingleThreadedChildPointer const node = nodesInBreadthFirstOrder[nodeIndex];
+		size_t numberLeafEntries = 0u;
+		for(HOTSingleThreadedChildPointer const & child : *node.getNode()) {
+			if(child.isLeaf()) {
+				++numberLeafEntries;
+			} else {
+				nodesInBreadthFirstOrder.push_back(child);
+			}
+		}
+		if(numberWords > MAXIMUM_FROZEN_NODE_WORD_OFFSET) {
+			throw std::length_error("The nodes of a frozen trie must not exceed 4GB");
+		}
+		wordOffsets.push_back(numberWords);
+		mNumberValues += numberLeafEntries;
+		numberWords += node.executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto const & existingNode) {
+			using ExistingNodeType = typename std::decay<decltype(existingNode)>::type;
+			using FrozenNodeType = HOTSingleThreadedFrozenNode<typename ExistingNodeType::DiscriminativeBitsRepresentationType, typename ExistingNodeType::PartialKeyType>;
+			return FrozenNodeType::getSizeInBytes(existingNode.getNumberEntries(), numberLeafEntries) / sizeof(uint64_t);
+		});
+	}
+
+	mBuffer.resize(numberWords + FROZEN_TRIE_PADDING_WORDS, 0u);
+	reinterpret_cast<HOTSingleThreadedFrozenNodeBase*>(mBuffer.data())->mUsedEntriesMask = 1u;
+	*reinterpret_cast<FrozenNodeReference*>(mBuffer.data() + 1) = toFrozenNodeReference(root.getNodeType(), wordOffsets[0]);
+	mHeight = root.getHeight();
+
+	size_t nextChildIndex = 1u;
+	for(size_t nodeIndex = 0u; nodeIndex < nodesInBreadthFirstOrder.size(); ++nodeIndex) {
+		nodesInBreadthFirstOrder[nodeIndex].executeForSpecificNodeType<MAXIMUM_KEY_LENGTH>(false, [&](auto const & existingNode) {
+			using ExistingNodeType = typename std::decay<decltype(existingNode)>::type;
+			using FrozenNodeType = HOTSingleThreadedFrozenNode<typename ExistingNodeType::DiscriminativeBitsRepresentationType, typename ExistingNodeType::PartialKeyType>;
+
+			size_t numberEntries = existingNode.getNumberEntries();
+			uint32_t leafEntriesMask = 0u;
+			for(size_t entryIndex = 0u; entryIndex < numberEntries; ++entryIndex) {
+				leafEntriesMask |= static_cast<uint32_t>(existingNode.getPointers()[entryIndex].isLeaf()) << entryIndex;
+			}
+
+			void* memory = mBuffer.data() + wordOffsets[nodeIndex];
+			FrozenNodeType::initialize(memory, existingNode, leafEntriesMask);
+			uint64_t* leaves = reinterpret_cast<uint64_t*>(reinterpret_cast<char*>(memory) + FrozenNodeType::getLeavesOffset(numberEntries));
+			FrozenNodeReference* childNodes = reinterpret_cast<FrozenNodeReference*>(leaves + __builtin_popcount(leafEntriesMask));
+			for(HOTSingleThreadedChildPointer const & child : existingNode) {
+				if(child.isLeaf()) {
+					*leaves++ = static_cast<uint64_t>(child.getTid());
+				} else {
+					*childNodes++ = toFrozenNodeReference(child.getNodeType(), wordOffsets[nextChildIndex++]);
+				}
+			}
+		});
+	}
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline bool HOTSingleThreadedFrozen<ValueType, KeyExtractor>::isEmpty() const {
+	return mNumberValues == 0u;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline size_t HOTSingleThreadedFrozen<ValueType, KeyExtractor>::getNumberValues() const {
+	return mNumberValues;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline size_t HOTSingleThreadedFrozen<ValueType, KeyExtractor>::getHeight() const {
+	return mHeight;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline size_t HOTSingleThreadedFrozen<ValueType, KeyExtractor>::getSizeInBytes() const {
+	return mBuffer.size() * sizeof(uint64_t);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline idx::contenthelpers::OptionalValue<ValueType> HOTSingleThreadedFrozen<ValueType, KeyExtractor>::lookup(KeyType const & key) const {
+	uint64_t const * buffer = mBuffer.data();
+	HOTSingleThreadedFrozenNodeBase const & rootEntry = *reinterpret_cast<HOTSingleThreadedFrozenNodeBase const *>(buffer);
+	if(rootEntry.mLeafEntriesMask != 0u) {
+		return extractAndMatchLeafValue(buffer[1], key);
+	} else if(rootEntry.mUsedEntriesMask == 0u) {
+		return {};
+	}
+
+	auto const & fixedSizeKey = idx::contenthelpers::toByteComparableKey(key);
+	auto keyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
+
+	FrozenNodeReference current = *reinterpret_cast<FrozenNodeReference const *>(buffer + 1);
+	uint64_t const * leaf = nullptr;
+	while(leaf == nullptr) {
+		executeForFrozenNodeType<MAXIMUM_KEY_LENGTH>(current, buffer, [&](auto const & node) {
+			unsigned int entryIndex = node.search(keyBytes);
+			unsigned int slotIndex = node.getSlotIndex(entryIndex);
+			if(node.isLeafEntry(entryIndex)) {
+				leaf = node.getLeaves() + slotIndex;
+			} else {
+				current = node.getChildNodes()[slotIndex];
+				prefetchFrozenNode(current, buffer);
+			}
+		});
+	}
+	return extractAndMatchLeafValue(*leaf, key);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreadedFrozen<ValueType, KeyExtractor>::const_iterator HOTSingleThreadedFrozen<ValueType, KeyExtractor>::begin() const {
+	if(isEmpty()) {
+		return END_ITERATOR;
+	}
+	const_iterator it(mBuffer.data());
+	it.descend();
+	return it;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreadedFrozen<ValueType, KeyExtractor>::const_iterator HOTSingleThreadedFrozen<ValueType, KeyExtractor>::end() const {
+	return END_ITERATOR;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreadedFrozen<ValueType, KeyExtractor>::const_reverse_iterator HOTSingleThreadedFrozen<ValueType, KeyExtractor>::rbegin() const {
+	if(isEmpty()) {
+		return const_reverse_iterator(END_ITERATOR);
+	}
+	const_iterator it(mBuffer.data());
+	it.descendRightmost();
+	return const_reverse_iterator(it);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreadedFrozen<ValueType, KeyExtractor>::const_reverse_iterator HOTSingleThreadedFrozen<ValueType, KeyExtractor>::rend() const {
+	return const_reverse_iterator(END_ITERATOR);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreadedFrozen<ValueType, KeyExtractor>::const_iterator HOTSingleThreadedFrozen<ValueType, KeyExtractor>::find(KeyType const & searchKey) const {
+	if(isEmpty()) {
+		return END_ITERATOR;
+	}
+
+	auto const & fixedSizeKey = idx::contenthelpers::toByteComparableKey(searchKey);
+	auto keyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
+	const_iterator it(mBuffer.data());
+	std::array<uint16_t, 64> mostSignificantBitIndexes;
+	descendToCandidate(keyBytes, it, mostSignificantBitIndexes);
+	return idx::contenthelpers::contentEquals(extractKey(*it), searchKey) ? it : END_ITERATOR;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreadedFrozen<ValueType, KeyExtractor>::const_iterator HOTSingleThreadedFrozen<ValueType, KeyExtractor>::lower_bound(KeyType const & searchKey) const {
+	return lower_or_upper_bound(searchKey, true);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreadedFrozen<ValueType, KeyExtractor>::const_iterator HOTSingleThreadedFrozen<ValueType, KeyExtractor>::upper_bound(KeyType const & searchKey) const {
+	return lower_or_upper_bound(searchKey, false);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreadedFrozen<ValueType, KeyExtractor>::const_iterator HOTSingleThreadedFrozen<ValueType, KeyExtractor>::lower_or_upper_bound(KeyType const & searchKey, bool is_lower_bound) const {
+	if(isEmpty()) {
+		return END_ITERATOR;
+	}
+
+	auto const & fixedSizeKey = idx::contenthelpers::toByteComparableKey(searchKey);
+	auto keyBytes = idx::contenthelpers::interpretAsByteArray(fixedSizeKey);
+	const_iterator it(mBuffer.data());
+	std::array<uint16_t, 64> mostSignificantBitIndexes;
+	descendToCandidate(keyBytes, it, mostSignificantBitIndexes);
+
+	ValueType const & existingValue = *it;
+	auto const & existingFixedSizeKey = idx::contenthelpers::toByteComparableKey(extractKey(existingValue));
+	auto existingKeyBytes = idx::contenthelpers::interpretAsByteArray(existingFixedSizeKey);
+
+	bool keysDiff = hot::commons::executeForDiffingKeys(existingKeyBytes, keyBytes, idx::contenthelpers::getMaxKeyLength<KeyType>(), [&](hot::commons::DiscriminativeBit const & significantKeyInformation) {
+		if(it.mCurrentDepth == 0) {
+			//the root is a single value
+			if(significantKeyInformation.mValue) {
+				++it;
+			}
+			return;
+		}
+
+		//the bound is located in the deepest node on the path, whose discriminative bits are not less significant than the mismatching bit
+		while(it.mCurrentDepth > 1 && significantKeyInformation.mAbsoluteBitIndex < mostSignificantBitIndexes[it.mCurrentDepth]) {
+			--it.mCurrentDepth;
+		}
+
+		FrozenNodeReference nodeReference = it.mNodeStack[it.mCurrentDepth - 1].getCurrentChildNode();
+		unsigned int boundIndex = executeForFrozenNodeType<MAXIMUM_KEY_LENGTH>(nodeReference, mBuffer.data(), [&](auto const & node) {
+			hot::commons::InsertInformation const & insertInformation = node.getInsertInformation(it.mNodeStack[it.mCurrentDepth].getCurrentIndex(), significantKeyInformation);
+			return insertInformation.mKeyInformation.mValue
+				? (insertInformation.getFirstIndexInAffectedSubtree() + insertInformation.getNumberEntriesInAffectedSubtree())
+				: insertInformation.getFirstIndexInAffectedSubtree();
+		});
+
+		if(boundIndex == it.mNodeStack[it.mCurrentDepth].getNumberEntries()) {
+			it.mNodeStack[it.mCurrentDepth].setCurrentIndex(boundIndex - 1u);
+			++it;
+		} else {
+			it.mNodeStack[it.mCurrentDepth].setCurrentIndex(boundIndex);
+			it.descend();
+		}
+	});
+
+	if(!keysDiff && !is_lower_bound) {
+		++it;
+	}
+
+	return it;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline idx::contenthelpers::OptionalValue<ValueType> HOTSingleThreadedFrozen<ValueType, KeyExtractor>::extractAndMatchLeafValue(uint64_t tid, KeyType const & key) const {
+	ValueType const & value = idx::contenthelpers::tidToValue<ValueType>(static_cast<intptr_t>(tid));
+	return { idx::contenthelpers::contentEquals(extractKey(value), key), value };
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline void HOTSingleThreadedFrozen<ValueType, KeyExtractor>::descendToCandidate(
+	idx::contenthelpers::KeyBytesType<KeyType> const & keyBytes, const_iterator & it, std::array<uint16_t, 64> & mostSignificantBitIndexes
+) const {
+	while(!it.mNodeStack[it.mCurrentDepth].isCurrentLeaf()) {
+		it.descend([&](auto const & node) {
+			mostSignificantBitIndexes[it.mCurrentDepth + 1] = node.mDiscriminativeBitsRepresentation.mMostSignificantDiscriminativeBitIndex;
+			return node.search(keyBytes);
+		});
+	}
+}
+
+} } }
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_FROZEN_ITERATOR__
+#define __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_FROZEN_ITERATOR__
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "hot/singlethreaded/HOTSingleThreadedFrozenNode.hpp"
+#include "idx/contenthelpers/TidConverters.hpp"
+#include "hot/commons/InstructionSet.hpp"
+
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+class HOTSingleThreadedFrozenIteratorStackEntry {
+	uint64_t const * mLeaves;
+	FrozenNodeReference const * mChildNodes;
+	uint32_t mLeafEntriesMask;
+	uint16_t mCurrentIndex;
+	uint16_t mNumberEntries;
+
+public:
+	//leaf uninitialized
+	HOTSingleThreadedFrozenIteratorStackEntry() {
+	}
+
+	void init(HOTSingleThreadedFrozenNodeBase const & node, uint64_t const * leaves, FrozenNodeReference const * childNodes, unsigned int currentIndex) {
+		mLeaves = leaves;
+		mChildNodes = childNodes;
+		mLeafEntriesMask = node.mLeafEntriesMask;
+		mCurrentIndex = static_cast<uint16_t>(currentIndex);
+		mNumberEntries = static_cast<uint16_t>(node.getNumberEntries());
+	}
+
+	unsigned int getCurrentIndex() const {
+		return mCurrentIndex;
+	}
+
+	void setCurrentIndex(unsigned int currentIndex) {
+		mCurrentIndex = static_cast<uint16_t>(currentIndex);
+	}
+
+	unsigned int getNumberEntries() const {
+		return mNumberEntries;
+	}
+
+	bool isExhausted() const {
+		return mCurrentIndex == mNumberEntries;
+	}
+
+	bool isCurrentLeaf() const {
+		return ((mLeafEntriesMask >> mCurrentIndex) & 1u) != 0u;
+	}
+
+	uint64_t const * getCurrentLeaf() const {
+		return mLeaves + __builtin_popcount(mLeafEntriesMask & ((1u << mCurrentIndex) - 1u));
+	}
+
+	FrozenNodeReference getCurrentChildNode() const {
+		return mChildNodes[__builtin_popcount(~mLeafEntriesMask & ((1u << mCurrentIndex) - 1u))];
+	}
+
+	void advance() {
+		if(mCurrentIndex != mNumberEntries) {
+			++mCurrentIndex;
+		}
+	}
+
+	void retreat() {
+		--mCurrentIndex;
+	}
+};
+
+template<typename ValueType, template <typename> typename KeyExtractor> class HOTSingleThreadedFrozen; //Forward Declaration for usage as friend class
+
+/**
+ * A bidirectional iterator over the values of a HOTSingleThreadedFrozen instance in key order.
+ * Like the iterator of HOTSingleThreaded it maintains the path from the root to the current value, but each entry of the path caches the start of the node's leaf and child node arrays.
+ */
+template<typename ValueType> class HOTSingleThreadedFrozenIterator {
+	template<typename ValueType2, template <typename> typename KeyExtractor> friend class hot::singlethreaded::HOTSingleThreadedFrozen;
+
+	uint64_t const * mBuffer;
+	std::array<HOTSingleThreadedFrozenIteratorStackEntry, 64> mNodeStack;
+	size_t mCurrentDepth;
+
+public:
+	HOTSingleThreadedFrozenIterator() : mBuffer(nullptr), mCurrentDepth(0) {
+		HOTSingleThreadedFrozenNodeBase emptyRoot { 0u, 0u };
+		mNodeStack[0].init(emptyRoot, nullptr, nullptr, 0u);
+	}
+
+	HOTSingleThreadedFrozenIterator(HOTSingleThreadedFrozenIterator const & other) : mBuffer(other.mBuffer), mCurrentDepth(other.mCurrentDepth) {
+		std::memcpy(mNodeStack.data(), other.mNodeStack.data(), sizeof(HOTSingleThreadedFrozenIteratorStackEntry) * (other.mCurrentDepth + 1));
+	}
+
+	HOTSingleThreadedFrozenIterator & operator=(HOTSingleThreadedFrozenIterator const & other) {
+		mBuffer = other.mBuffer;
+		mCurrentDepth = other.mCurrentDepth;
+		std::memcpy(mNodeStack.data(), other.mNodeStack.data(), sizeof(HOTSingleThreadedFrozenIteratorStackEntry) * (other.mCurrentDepth + 1));
+		return *this;
+	}
+
+	ValueType operator*() const {
+		return idx::contenthelpers::tidToValue<ValueType>(static_cast<intptr_t>(*mNodeStack[mCurrentDepth].getCurrentLeaf()));
+	}
+
+	HOTSingleThreadedFrozenIterator<ValueType> & operator++() {
+		mNodeStack[mCurrentDepth].advance();
+		while((mCurrentDepth > 0) & (mNodeStack[mCurrentDepth].isExhausted())) {
+			--mCurrentDepth;
+			mNodeStack[mCurrentDepth].advance();
+		}
+		if(!mNodeStack[0].isExhausted()) {
+			descend();
+		}
+		return *this;
+	}
+
+	/**
+	 * moves the iterator to the value preceding the current value in key order.
+	 * Decrementing an iterator positioned on the smallest value yields the end iterator. Decrementing the end iterator yields the end iterator again.
+	 */
+	HOTSingleThreadedFrozenIterator<ValueType> & operator--() {
+		while((mCurrentDepth > 0) && (mNodeStack[mCurrentDepth].getCurrentIndex() == 0u)) {
+			--mCurrentDepth;
+		}
+		if(mCurrentDepth == 0) {
+			mNodeStack[0].setCurrentIndex(mNodeStack[0].getNumberEntries());
+		} else {
+			mNodeStack[mCurrentDepth].retreat();
+			descendRightmost();
+		}
+		return *this;
+	}
+
+	bool operator==(HOTSingleThreadedFrozenIterator<ValueType> const & other) const {
+		return isEnd() ? other.isEnd() : (!other.isEnd() && mNodeStack[mCurrentDepth].getCurrentLeaf() == other.mNodeStack[other.mCurrentDepth].getCurrentLeaf());
+	}
+
+	bool operator!=(HOTSingleThreadedFrozenIterator<ValueType> const & other) const {
+		return !(*this == other);
+	}
+
+private:
+	/**
+	 * creates an iterator positioned at the root entry of a frozen trie's buffer
+	 */
+	HOTSingleThreadedFrozenIterator(uint64_t const * buffer) : mBuffer(buffer), mCurrentDepth(0) {
+		HOTSingleThreadedFrozenNodeBase const & root = *reinterpret_cast<HOTSingleThreadedFrozenNodeBase const *>(buffer);
+		mNodeStack[0].init(root, buffer + 1, reinterpret_cast<FrozenNodeReference const *>(buffer + 1), 0u);
+	}
+
+	bool isEnd() const {
+		return (mCurrentDepth == 0) & mNodeStack[0].isExhausted();
+	}
+
+	/**
+	 * descends from the current entry into the child node referenced by it
+	 *
+	 * @param selectEntry a callable which given the child node returns the index of the entry to descend to
+	 */
+	template<typename EntrySelector> void descend(EntrySelector const & selectEntry) {
+		executeForFrozenNodeType(mNodeStack[mCurrentDepth].getCurrentChildNode(), mBuffer, [&](auto const & node) {
+			mNodeStack[mCurrentDepth + 1].init(node, node.getLeaves(), node.getChildNodes(), selectEntry(node));
+		});
+		++mCurrentDepth;
+	}
+
+	void descend() {
+		while(!mNodeStack[mCurrentDepth].isCurrentLeaf()) {
+			descend([](HOTSingleThreadedFrozenNodeBase const &) { return 0u; });
+		}
+	}
+
+	void descendRightmost() {
+		while(!mNodeStack[mCurrentDepth].isCurrentLeaf()) {
+			descend([](HOTSingleThreadedFrozenNodeBase const & node) { return static_cast<unsigned int>(node.getNumberEntries() - 1u); });
+		}
+	}
+};
+
+}}}
+
+#endif
@@ -0,0 +1,221 @@
+#ifndef __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_FROZEN_NODE__
+#define __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_FROZEN_NODE__
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include <hot/commons/Algorithms.hpp>
+#include <hot/commons/DiscriminativeBit.hpp>
+#include <hot/commons/InsertInformation.hpp>
+#include <hot/commons/NodeParametersMapping.hpp>
+#include <hot/commons/NodeType.hpp>
+#include <hot/commons/SparsePartialKeys.hpp>
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+/**
+ * A reference to a frozen node consists of the node's offset in 8 byte words relative to the start of the frozen trie's buffer and the node's type encoded in the 3 least significant bits.
+ * Hence, the nodes of a frozen trie must be contained in the first 4GB of its buffer.
+ */
+using FrozenNodeReference = uint32_t;
+
+constexpr uint32_t FROZEN_NODE_TYPE_BITS = 3u;
+constexpr uint32_t FROZEN_NODE_TYPE_MASK = (1u << FROZEN_NODE_TYPE_BITS) - 1u;
+constexpr uint64_t MAXIMUM_FROZEN_NODE_WORD_OFFSET = UINT32_MAX >> FROZEN_NODE_TYPE_BITS;
+
+inline FrozenNodeReference toFrozenNodeReference(hot::commons::NodeType nodeType, uint64_t wordOffset) {
+	return static_cast<FrozenNodeReference>((wordOffset << FROZEN_NODE_TYPE_BITS) | static_cast<uint32_t>(nodeType));
+}
+
+inline hot::commons::NodeType getFrozenNodeType(FrozenNodeReference reference) {
+	return static_cast<hot::commons::NodeType>(reference & FROZEN_NODE_TYPE_MASK);
+}
+
+inline uint64_t const * getFrozenNodeAddress(FrozenNodeReference reference, uint64_t const * buffer) {
+	return buffer + (reference >> FROZEN_NODE_TYPE_BITS);
+}
+
+/**
+ * The header shared by all frozen nodes.
+ *
+ * In contrast to a HOTSingleThreadedNode, a frozen node contains neither a pointer to its child pointers nor its height or allocator.
+ * Its entries are split into two arrays, which follow the partial keys. The first array contains the values of all entries which are leaves in entry order, the second one
+ * contains 32 bit references to the child nodes of all other entries in entry order. The start of both arrays is determined by the node's type and number of entries.
+ */
+struct alignas(8) HOTSingleThreadedFrozenNodeBase {
+	/**
+	 * a mask having all bits set, which correspond to used entries. Smaller indexes correspond to less significant bits.
+	 */
+	uint32_t mUsedEntriesMask;
+
+	/**
+	 * a mask having all bits set, which correspond to entries whose values are stored in the leaf array
+	 */
+	uint32_t mLeafEntriesMask;
+
+	inline size_t getNumberEntries() const {
+		return static_cast<size_t>(__builtin_popcount(mUsedEntriesMask));
+	}
+
+	inline bool isLeafEntry(unsigned int entryIndex) const {
+		return ((mLeafEntriesMask >> entryIndex) & 1u) != 0u;
+	}
+
+	/**
+	 * @param entryIndex the index of an entry
+	 * @return the index of the entry's slot in the leaf array or the child node array depending on whether the entry is a leaf
+	 */
+	inline unsigned int getSlotIndex(unsigned int entryIndex) const {
+		uint32_t const entriesOfSameKind = isLeafEntry(entryIndex) ? mLeafEntriesMask : (mUsedEntriesMask & ~mLeafEntriesMask);
+		return static_cast<unsigned int>(__builtin_popcount(entriesOfSameKind & ((1u << entryIndex) - 1u)));
+	}
+
+protected:
+	inline unsigned int toResultIndex(uint32_t resultMask) const {
+		return hot::commons::getMostSignificantBitIndex(mUsedEntriesMask & resultMask);
+	}
+};
+
+template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> struct alignas(8) HOTSingleThreadedFrozenNode : HOTSingleThreadedFrozenNodeBase {
+	DiscriminativeBitsRepresentation mDiscriminativeBitsRepresentation;
+	hot::commons::SparsePartialKeys<PartialKeyType> mPartialKeys;
+
+	/**
+	 * @param numberEntries the number of entries of a node
+	 * @return the offset of the leaf array relative to the start of the node
+	 */
+	static constexpr size_t getLeavesOffset(size_t numberEntries) {
+		return sizeof(HOTSingleThreadedFrozenNode) - sizeof(hot::commons::SparsePartialKeys<PartialKeyType>)
+			+ hot::commons::alignToNextHighestValueDivisableBy8(static_cast<uint16_t>(numberEntries * sizeof(PartialKeyType)));
+	}
+
+	/**
+	 * @param numberEntries the number of entries of a node
+	 * @param numberLeafEntries the number of those entries which are leaves
+	 * @return the size of the node, which is a multiple of 8 bytes
+	 */
+	static constexpr size_t getSizeInBytes(size_t numberEntries, size_t numberLeafEntries) {
+		return getLeavesOffset(numberEntries) + numberLeafEntries * sizeof(uint64_t)
+			+ hot::commons::alignToNextHighestValueDivisableBy8(static_cast<uint16_t>((numberEntries - numberLeafEntries) * sizeof(FrozenNodeReference)));
+	}
+
+	inline uint64_t const * getLeaves() const {
+		return reinterpret_cast<uint64_t const *>(reinterpret_cast<char const *>(this) + getLeavesOffset(getNumberEntries()));
+	}
+
+	inline FrozenNodeReference const * getChildNodes() const {
+		return reinterpret_cast<FrozenNodeReference const *>(getLeaves() + __builtin_popcount(mLeafEntriesMask));
+	}
+
+	/**
+	 * @param keyBytes the key to search for, which is either a pointer to the bytes of a fixed size key or a { @link idx::contenthelpers::KeyBytesView } of a variable length key
+	 * @return the index of the entry, which is the only candidate to contain the key
+	 */
+	template<typename KeyBytesType> inline unsigned int search(KeyBytesType const & keyBytes) const {
+		return toResultIndex(mPartialKeys.search(mDiscriminativeBitsRepresentation.extractMask(keyBytes)));
+	}
+
+	/**
+	 * determines the entries which form the subtree a key would be inserted into in the same way as { @link HOTSingleThreadedNode#getInsertInformation }
+	 *
+	 * @param entryIndex the index of the entry whose key differs from the key at the discriminative bit
+	 * @param discriminativeBit the most significant bit, which differs between the key and the key of the entry
+	 * @return the information describing the affected subtree
+	 */
+	inline hot::commons::InsertInformation getInsertInformation(unsigned int entryIndex, hot::commons::DiscriminativeBit const & discriminativeBit) const {
+		PartialKeyType existingEntryMask = mPartialKeys.mEntries[entryIndex];
+		PartialKeyType prefixBits = mDiscriminativeBitsRepresentation.template getPrefixBitsMask<PartialKeyType>(discriminativeBit);
+		PartialKeyType subtreePrefixMask = existingEntryMask & prefixBits;
+
+		uint32_t affectedSubtreeMask = mPartialKeys.getAffectedSubtreeMask(prefixBits, subtreePrefixMask) & mUsedEntriesMask;
+		assert(affectedSubtreeMask != 0);
+		return { subtreePrefixMask, static_cast<uint32_t>(__builtin_ctz(affectedSubtreeMask)), static_cast<uint32_t>(__builtin_popcount(affectedSubtreeMask)), discriminativeBit };
+	}
+
+	/**
+	 * initializes a frozen node in zero initialized memory from the header, the discriminative bits and the partial keys of a node
+	 *
+	 * @param memory the memory of the frozen node
+	 * @param node the node to copy
+	 * @param leafEntriesMask the mask of the node's entries which are leaves
+	 * @return the initialized frozen node. Its leaf and child node arrays are not initialized.
+	 */
+	template<typename NodeType> static inline HOTSingleThreadedFrozenNode & initialize(void * memory, NodeType const & node, uint32_t leafEntriesMask) {
+		HOTSingleThreadedFrozenNode & frozenNode = *reinterpret_cast<HOTSingleThreadedFrozenNode*>(memory);
+		frozenNode.mUsedEntriesMask = node.mUsedEntriesMask;
+		frozenNode.mLeafEntriesMask = leafEntriesMask;
+		new (&frozenNode.mDiscriminativeBitsRepresentation) DiscriminativeBitsRepresentation(node.mDiscriminativeBitsRepresentation);
+		std::memcpy(frozenNode.mPartialKeys.mEntries, node.mPartialKeys.mEntries, node.getNumberEntries() * sizeof(PartialKeyType));
+		return frozenNode;
+	}
+};
+
+template<hot::commons::NodeType nodeType> inline auto castToFrozenNode(uint64_t const * node) {
+	using DiscriminativeBitsRepresentationType = typename hot::commons::NodeTypeToNodeParameters<nodeType>::PartialKeyMappingType;
+	using PartialKeyType = typename hot::commons::NodeTypeToNodeParameters<nodeType>::PartialKeyType;
+	return reinterpret_cast<HOTSingleThreadedFrozenNode<DiscriminativeBitsRepresentationType, PartialKeyType> const *>(node);
+}
+
+template<typename Operation> inline __attribute__((always_inline)) auto executeForFrozenNodeType(hot::commons::NodeType nodeType, uint64_t const * node, Operation const & operation, std::false_type) {
+	switch(nodeType) {
+		case hot::commons::NodeType::SINGLE_MASK_8_BIT_PARTIAL_KEYS:
+			return operation(*castToFrozenNode<hot::commons::NodeType::SINGLE_MASK_8_BIT_PARTIAL_KEYS>(node));
+		case hot::commons::NodeType::SINGLE_MASK_16_BIT_PARTIAL_KEYS:
+			return operation(*castToFrozenNode<hot::commons::NodeType::SINGLE_MASK_16_BIT_PARTIAL_KEYS>(node));
+		case hot::commons::NodeType::SINGLE_MASK_32_BIT_PARTIAL_KEYS:
+			return operation(*castToFrozenNode<hot::commons::NodeType::SINGLE_MASK_32_BIT_PARTIAL_KEYS>(node));
+		case hot::commons::NodeType::MULTI_MASK_8_BYTES_AND_8_BIT_PARTIAL_KEYS:
+			return operation(*castToFrozenNode<hot::commons::NodeType::MULTI_MASK_8_BYTES_AND_8_BIT_PARTIAL_KEYS>(node));
+		case hot::commons::NodeType::MULTI_MASK_8_BYTES_AND_16_BIT_PARTIAL_KEYS:
+			return operation(*castToFrozenNode<hot::commons::NodeType::MULTI_MASK_8_BYTES_AND_16_BIT_PARTIAL_KEYS>(node));
+		case hot::commons::NodeType::MULTI_MASK_8_BYTES_AND_32_BIT_PARTIAL_KEYS:
+			return operation(*castToFrozenNode<hot::commons::NodeType::MULTI_MASK_8_BYTES_AND_32_BIT_PARTIAL_KEYS>(node));
+		case hot::commons::NodeType::MULTI_MASK_16_BYTES_AND_16_BIT_PARTIAL_KEYS:
+			return operation(*castToFrozenNode<hot::commons::NodeType::MULTI_MASK_16_BYTES_AND_16_BIT_PARTIAL_KEYS>(node));
+		default: //hot::commons::NodeType::MULTI_MASK_32_BYTES_AND_32_BIT_PARTIAL_KEYS:
+			return operation(*castToFrozenNode<hot::commons::NodeType::MULTI_MASK_32_BYTES_AND_32_BIT_PARTIAL_KEYS>(node));
+	}
+}
+
+template<typename Operation> inline __attribute__((always_inline)) auto executeForFrozenNodeType(hot::commons::NodeType nodeType, uint64_t const * node, Operation const & operation, std::true_type) {
+	assert(nodeType <= hot::commons::NodeType::SINGLE_MASK_32_BIT_PARTIAL_KEYS);
+	switch(nodeType) {
+		case hot::commons::NodeType::SINGLE_MASK_8_BIT_PARTIAL_KEYS:
+			return operation(*castToFrozenNode<hot::commons::NodeType::SINGLE_MASK_8_BIT_PARTIAL_KEYS>(node));
+		case hot::commons::NodeType::SINGLE_MASK_16_BIT_PARTIAL_KEYS:
+			return operation(*castToFrozenNode<hot::commons::NodeType::SINGLE_MASK_16_BIT_PARTIAL_KEYS>(node));
+		default: //hot::commons::NodeType::SINGLE_MASK_32_BIT_PARTIAL_KEYS:
+			return operation(*castToFrozenNode<hot::commons::NodeType::SINGLE_MASK_32_BIT_PARTIAL_KEYS>(node));
+	}
+}
+
+/**
+ * executes an operation for a frozen node casted to its actual type
+ *
+ * @tparam maximumKeyLength the maximum length in bytes of the keys stored in the frozen trie. For keys of up to 8 bytes only the single mask node types are dispatched.
+ * @param reference the reference of the node
+ * @param buffer the buffer containing the node
+ * @param operation the operation to execute, which is invoked with a const reference to the node
+ * @return the result of the operation
+ */
+template<size_t maximumKeyLength = SIZE_MAX, typename Operation> inline __attribute__((always_inline)) auto executeForFrozenNodeType(FrozenNodeReference reference, uint64_t const * buffer, Operation const & operation) {
+	return executeForFrozenNodeType(
+		getFrozenNodeType(reference), getFrozenNodeAddress(reference, buffer), operation,
+		std::integral_constant<bool, hot::commons::hasOnlySingleMaskNodeTypes(maximumKeyLength)>()
+	);
+}
+
+inline void prefetchFrozenNode(FrozenNodeReference reference, uint64_t const * buffer) {
+	char const * node = reinterpret_cast<char const*>(getFrozenNodeAddress(reference, buffer));
+	__builtin_prefetch(node);
+	__builtin_prefetch(node + 64);
+	__builtin_prefetch(node + 128);
+}
+
+} } }
+
+#endif
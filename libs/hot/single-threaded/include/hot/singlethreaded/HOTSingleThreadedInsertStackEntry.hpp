@@ -4,8 +4,9 @@
 #include <hot/commons/SearchResultForInsert.hpp>
 
 #include "HOTSingleThreadedChildPointer.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace singlethreaded {
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 struct HOTSingleThreadedInsertStackEntry {
 	HOTSingleThreadedChildPointer *mChildPointer;
@@ -22,6 +23,6 @@ struct HOTSingleThreadedInsertStackEntry {
 	}
 };
 
-} }
+} } }
 
 #endif
\ No newline at end of file
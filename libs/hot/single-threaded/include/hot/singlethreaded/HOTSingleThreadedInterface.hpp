@@ -8,17 +8,25 @@
 #include <utility>
 #include <set>
 #include <map>
+#include <memory>
+#include <string>
 #include <numeric>
+#include <vector>
 #include <cstring>
 
 
 #include <hot/commons/Algorithms.hpp>
 #include <hot/commons/BiNode.hpp>
+#include <hot/commons/BulkLoader.hpp>
 #include <hot/commons/DiscriminativeBit.hpp>
 #include <hot/commons/InsertInformation.hpp>
+#include <hot/commons/ReverseIterator.hpp>
 #include <hot/commons/TwoEntriesNode.hpp>
 
+#include "hot/singlethreaded/HOTSingleThreadedFileFormat.hpp"
 #include "hot/singlethreaded/HOTSingleThreadedNode.hpp"
+#include "hot/singlethreaded/HOTSingleThreadedNodeAllocator.hpp"
+#include "hot/singlethreaded/HOTSingleThreadedSnapshotRegistry.hpp"
 
 //Helper Data Structures
 #include "HOTSingleThreadedInsertStackEntry.hpp"
@@ -31,11 +39,16 @@
 #include "idx/contenthelpers/ContentEquals.hpp"
 #include "idx/contenthelpers/KeyComparator.hpp"
 #include "idx/contenthelpers/OptionalValue.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
 
-namespace hot { namespace singlethreaded {
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 constexpr uint32_t MAXIMUM_NUMBER_NODE_ENTRIES = 32u;
+constexpr size_t LOOKUP_BATCH_WINDOW_SIZE = 16u;
+
+template<typename ValueType, template <typename> typename KeyExtractor> class HOTSingleThreadedSnapshot;
+template<typename ValueType, template <typename> typename KeyExtractor> class HOTSingleThreadedFrozen;
 
 /**
  * HOTSingleThreaded represents a single threaded height optimized trie.
@@ -45,18 +58,38 @@ constexpr uint32_t MAXIMUM_NUMBER_NODE_ENTRIES = 32u;
  *
  * @tparam ValueType The type of the value to index. The ValueType must no exceed 8 bytes and may only use the less significant 63 bits. It is therefore perfectly suited to use tuple identifiers as values.
  * @tparam KeyExtractor A Function given the ValueType returns a key, which by using the corresponding functions in idx::contenthelpers can be converted to a big endian ordered byte array.
+ * @tparam NodeAllocatorPolicy Determines the memory pool nodes are allocated from. Either { @link GlobalNodeAllocatorPolicy }, { @link ThreadLocalNodeAllocatorPolicy }, { @link PerInstanceNodeAllocatorPolicy } or { @link ArenaNodeAllocatorPolicy }.
+ * 	Using a per instance or thread local memory pool allows to modify distinct instances from different threads concurrently, e.g. to run one private index per core.
+ * 	Using an arena allows to delete all nodes of a trie at once without traversing it.
+ * 	The { @link SnapshotNodeAllocatorPolicy } is only used for the read only tries of snapshots (see { @link #snapshot() }).
  */
-template<typename ValueType, template <typename> typename KeyExtractor> struct HOTSingleThreaded {
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy = GlobalNodeAllocatorPolicy> struct HOTSingleThreaded {
 	static_assert(sizeof(ValueType) <= 8, "Only value types which can be stored in a pointer are allowed");
 	static KeyExtractor<ValueType> extractKey;
 	using KeyType = decltype(extractKey(std::declval<ValueType>()));
 	static typename idx::contenthelpers::KeyComparator<KeyType>::type compareKeys;
+	//determines at compile time, which node types can occur in this trie. For keys of up to 8 bytes the node type dispatch is restricted to the single mask node types.
+	static constexpr size_t MAXIMUM_KEY_LENGTH = idx::contenthelpers::getMaxKeyLength<KeyType>();
 
 	using const_iterator = HOTSingleThreadedIterator<ValueType>;
+	using const_reverse_iterator = hot::commons::ReverseIterator<const_iterator>;
 	static const_iterator END_ITERATOR;
 
 	HOTSingleThreadedChildPointer mRoot;
 
+private:
+	//executes { @link hot::singlethreaded::bulkLoadParallel }, which is defined in HOTSingleThreadedParallelBulkLoad.hpp
+	template<typename TrieType> friend struct HOTSingleThreadedParallelBulkLoader;
+
+	NodeAllocatorPolicy mNodeAllocatorPolicy;
+	//only created once the first snapshot is taken
+	std::shared_ptr<HOTSingleThreadedSnapshotRegistry> mSnapshotRegistry;
+	//the entry indexes on the path from the root to the node, which is relocated next by compact
+	std::vector<uint8_t> mCompactionPosition;
+	//the entry indexes on the path from the root to the node, which was visited last by rebalance
+	std::vector<uint8_t> mRebalancingPosition;
+
+public:
 	/**
 	 * Creates an empty order preserving index structure based on the HOT algorithm
 	 */
@@ -69,6 +102,11 @@ template<typename ValueType, template <typename> typename KeyExtractor> struct H
 
 	~HOTSingleThreaded();
 
+	/**
+	 * removes all entries of the trie. In case the trie uses the { @link ArenaNodeAllocatorPolicy } all nodes are released at once without traversing the trie.
+	 */
+	inline void clear();
+
 	inline bool isEmpty() const;
 	inline bool isRootANode() const;
 
@@ -76,14 +114,28 @@ template<typename ValueType, template <typename> typename KeyExtractor> struct H
 	 * For a given key it looks up the stored value
 	 *
 	 * @param key the key to lookup
-	 * @return the looked up value. The result is valid, if a matching record was found.
+	 * @return the looked up value. The result is valid, if a matching record was found. Keys longer than the maximum key length are never found, as they cannot be inserted.
+	 */
+	inline __attribute__((always_inline)) idx::contenthelpers::OptionalValue<ValueType> lookup(KeyType const &key) const;
+
+	/**
+	 * Looks up the stored values for a batch of keys.
+	 *
+	 * In contrast to calling { @link #lookup(KeyType const &) } for each key, the traversals of the individual keys are interleaved.
+	 * While the node of one key is searched, the nodes of the other keys are already prefetched, which allows to overlap the cache misses of independent lookups.
+	 * Furthermore, the leaf values are prefetched before they are matched against the search keys.
+	 *
+	 * @param keys a pointer to the first of the keys to lookup
+	 * @param numberKeys the number of keys to lookup
+	 * @param results an output array, which must provide space for numberKeys results. For each key the looked up value is stored at the corresponding position. A result is valid, if a matching record was found.
 	 */
-	inline __attribute__((always_inline)) idx::contenthelpers::OptionalValue<ValueType> lookup(KeyType const &key);
+	inline void lookupBatch(KeyType const * keys, size_t numberKeys, idx::contenthelpers::OptionalValue<ValueType> * results) const;
 
-	idx::contenthelpers::OptionalValue <ValueType> extractAndMatchLeafValue( HOTSingleThreadedChildPointer const & current, KeyType const &key);
+	idx::contenthelpers::OptionalValue <ValueType> extractAndMatchLeafValue( HOTSingleThreadedChildPointer const & current, KeyType const &key) const;
 
 	/**
-	 * Scans a given number of values and returns the value at the end of the scan operation
+	 * Scans a given number of values and returns the value at the end of the scan operation.
+	 * In case USE_ORDER_STATISTICS is defined, the scanned values are skipped using the subtree counts in time proportional to the height of the trie.
 	 *
 	 * @param key the key to start the scanning operation at
 	 * @param numberValues the number of values to scan in sequential order
@@ -91,20 +143,189 @@ template<typename ValueType, template <typename> typename KeyExtractor> struct H
 	 */
 	inline idx::contenthelpers::OptionalValue<ValueType> scan(KeyType const &key, size_t numberValues) const;
 
-	inline unsigned int searchForInsert(uint8_t const * keyBytes, std::array<HOTSingleThreadedInsertStackEntry, 64> & insertStack);
+#ifdef USE_ORDER_STATISTICS
+	/**
+	 * Determines the number of values whose keys are smaller than the given key in time proportional to the height of the trie.
+	 * It is only available if subtree counts are maintained, which requires USE_ORDER_STATISTICS to be defined.
+	 *
+	 * @param key the key to determine the rank for. It does not need to be contained in the trie.
+	 * @return the number of values with a key smaller than the given key, which is the zero based position the key has or would have in key order
+	 */
+	inline size_t rank(KeyType const & key) const;
+
+	/**
+	 * Determines the value at a given position in key order in time proportional to the height of the trie.
+	 * It is only available if subtree counts are maintained, which requires USE_ORDER_STATISTICS to be defined.
+	 *
+	 * @param rank the zero based position of the value to select
+	 * @return an iterator pointing to the value at the given position or the end iterator if the trie contains not more than rank values
+	 */
+	inline const_iterator select(size_t rank) const;
+
+	/**
+	 * Determines the number of values whose keys are contained in the closed range [lowerKey, upperKey] in time proportional to the height of the trie.
+	 * It is only available if subtree counts are maintained, which requires USE_ORDER_STATISTICS to be defined.
+	 *
+	 * @param lowerKey the smallest key to count
+	 * @param upperKey the largest key to count
+	 * @return the number of values contained in the range
+	 */
+	inline size_t count(KeyType const & lowerKey, KeyType const & upperKey) const;
+
+private:
+	/**
+	 * @param key the key to determine the bound for
+	 * @param is_lower_bound whether the rank of the lower bound or the upper bound of the key is determined
+	 * @return the number of values preceding the lower or upper bound of the given key
+	 */
+	inline size_t getRankOfBound(KeyType const & key, bool is_lower_bound) const;
+
+public:
+#endif
+
+	/**
+	 * Visits all values whose keys are contained in the closed range [lowerKey, upperKey] in ascending key order.
+	 *
+	 * In contrast to iterating with a { @link const_iterator }, the trie is only descended once to the lower bound of the range.
+	 * Afterwards the child pointer arrays of the nodes are traversed directly and the visitor is invoked once for each run of consecutive leaf entries in a node.
+	 * Only the last value of each run is compared against the upper key, unless the run crosses the end of the range.
+	 *
+	 * @param lowerKey the smallest key to visit
+	 * @param upperKey the largest key to visit
+	 * @param visitor a callable which is invoked as visitor(ValueType const * values, size_t numberValues) for each batch of consecutive values in the range.
+	 * 	The passed values are only valid for the duration of the call.
+	 * @return the total number of visited values
+	 */
+	template<typename Visitor> inline size_t scanRange(KeyType const & lowerKey, KeyType const & upperKey, Visitor && visitor) const;
+
+	/**
+	 * Visits at most limit values in ascending key order, starting with the smallest key which is not less than lowerKey.
+	 * The trie is traversed in the same way as by { @link #scanRange(KeyType const &, KeyType const &, Visitor &&) }.
+	 * It is not an overload of scanRange, as the limit and the key would have the same type for 64 bit integer keys.
+	 *
+	 * @param lowerKey the key to start the scan at
+	 * @param limit the maximum number of values to visit
+	 * @param visitor a callable which is invoked as visitor(ValueType const * values, size_t numberValues) for each batch of consecutive values.
+	 * 	The passed values are only valid for the duration of the call.
+	 * @return the total number of visited values
+	 */
+	template<typename Visitor> inline size_t scanRangeWithLimit(KeyType const & lowerKey, size_t limit, Visitor && visitor) const;
+
+	/**
+	 * Visits all values whose keys start with the given prefix in ascending key order. It is only available for c string keys.
+	 *
+	 * The trie is descended to the smallest subtree whose entries contain all keys sharing the bits of the prefix.
+	 * A single key of this subtree is compared against the prefix, afterwards all values of the subtree are passed to the visitor
+	 * in the same way as by { @link #scanRange(KeyType const &, KeyType const &, Visitor &&) } without comparing any further keys.
+	 *
+	 * @param prefix the prefix of the keys to visit. It must not contain a zero byte within its first prefixLength bytes.
+	 * @param prefixLength the length of the prefix in bytes. A prefix of length zero visits all values.
+	 * @param visitor a callable which is invoked as visitor(ValueType const * values, size_t numberValues) for each batch of consecutive values whose keys start with the prefix.
+	 * 	The passed values are only valid for the duration of the call.
+	 * @return the total number of visited values
+	 */
+	template<typename Visitor> inline size_t prefixScan(char const * prefix, size_t prefixLength, Visitor && visitor) const;
+
+	/**
+	 * Looks up the value whose key is the longest prefix of the given key. It is only available for c string keys.
+	 *
+	 * A stored key of length n is a prefix of the search key, iff it is the smallest key sharing the first n bytes and the leading zero bits of byte n with the search key.
+	 * Hence, it is the leftmost leaf of the subtree, which would be split by inserting a key mismatching the search key at the first set bit of byte n.
+	 * The trie is descended a single time. Afterwards, starting at the bit where the search key and the reached leaf mismatch,
+	 * the search path is backtracked in the same way as for an insert. Only those candidates are compared, whose prefix ends at the mismatching bit or at a discriminative bit on the search path.
+	 *
+	 * @param key the key to determine the longest stored prefix for
+	 * @return the value whose key is the longest prefix of the given key or the key itself. The result is invalid, if no stored key is a prefix of the given key.
+	 */
+	inline idx::contenthelpers::OptionalValue<ValueType> longestPrefixMatch(KeyType const & key) const;
+
+private:
+	/**
+	 * Traverses the values in ascending key order starting at the lower bound of the given key and passes them batch wise to the visitor.
+	 *
+	 * @param lowerKey the key whose lower bound is the first value to visit
+	 * @param maximumNumberValues the maximum number of values to visit
+	 * @param limitBatch a callable invoked as limitBatch(ValueType const * values, size_t numberValues) for each batch before it is passed to the visitor.
+	 * 	It returns how many of the batch's values are visited. In case not all values of a batch are visited, the traversal stops.
+	 * @param visitor the visitor to pass the batches to
+	 * @return the total number of visited values
+	 */
+	template<typename BatchLimiter, typename Visitor> inline size_t visitBatchesStartingAtLowerBound(KeyType const & lowerKey, size_t maximumNumberValues, BatchLimiter && limitBatch, Visitor && visitor) const;
+
+	/**
+	 * Passes the values of all entries remaining on the given node stack batch wise to the visitor.
+	 * The traversal continues at the current entry of the given depth and afterwards with the entries following the current entries of its ancestors.
+	 *
+	 * @param nodeStack the stack of entry ranges to traverse, it is modified during the traversal
+	 * @param depth the depth of the entry range the traversal starts with
+	 * @param maximumNumberValues the maximum number of values to visit
+	 * @param limitBatch a callable which determines how many values of a batch are visited, like for { @link #visitBatchesStartingAtLowerBound }
+	 * @param visitor the visitor to pass the batches to
+	 * @return the total number of visited values
+	 */
+	template<typename BatchLimiter, typename Visitor> static inline size_t visitBatchesOnStack(HOTSingleThreadedIteratorStackEntry* nodeStack, size_t depth, size_t maximumNumberValues, BatchLimiter && limitBatch, Visitor && visitor);
+
+public:
+	inline unsigned int searchForInsert(idx::contenthelpers::KeyBytesType<KeyType> const & keyBytes, std::array<HOTSingleThreadedInsertStackEntry, 64> & insertStack);
 
 	inline bool remove(KeyType const & key);
 
+	/**
+	 * Removes all values whose keys are contained in the closed range [lowerKey, upperKey].
+	 *
+	 * In contrast to removing each key individually, subtrees which are entirely contained in the range are unlinked and freed as a whole.
+	 * Only the nodes on the paths to the boundaries of the range are rebuilt, each of them at most once.
+	 * The costs are therefore proportional to the number of boundary nodes and freed nodes instead of the number of removed values times the height of the trie.
+	 *
+	 * @param lowerKey the smallest key to remove
+	 * @param upperKey the largest key to remove
+	 * @return the number of removed values
+	 */
+	inline size_t removeRange(KeyType const & lowerKey, KeyType const & upperKey);
+
+	/**
+	 * Removes the values of a batch of keys, which must be sorted in ascending order.
+	 *
+	 * For each key only a single root to leaf traversal is executed. All subsequent keys, which are located in the same node, are removed together with it.
+	 * Thereby only a single new node is created for each group of keys removed from the same node, instead of one node copy for each removed key.
+	 * Keys which are not contained, as well as duplicated keys, are ignored.
+	 *
+	 * @param keys a pointer to the first of the keys to remove
+	 * @param numberKeys the number of keys to remove
+	 * @return the number of removed values
+	 */
+	inline size_t removeBatch(KeyType const * keys, size_t numberKeys);
+
 	/**
 	 * Inserts the given value into the index. The value is inserted according to its keys value.
 	 * In case the index already contains a value for the corresponding key, the value is not inserted.
 	 *
 	 * @param value the value to insert.
 	 * @return true if the value can be inserted, false if the index already contains a value for the corresponding key
+	 * @throws std::length_error if the key is longer than the maximum key length (see { @link idx::contenthelpers::isSupportedKeyLength }). Such keys are never truncated silently.
+	 * @throws std::invalid_argument if the key is a length delimited key ending with a zero byte (see { @link idx::contenthelpers::isDistinguishableKey }).
 	 */
 	inline bool insert(ValueType const & value);
 	inline bool insertWithInsertStack(std::array<HOTSingleThreadedInsertStackEntry, 64> &insertStack, unsigned int leafDepth,
-									  KeyType const &existingKey, uint8_t const *newKeyBytes, ValueType const &newValue);
+									  KeyType const &existingKey, idx::contenthelpers::KeyBytesType<KeyType> const & newKeyBytes, ValueType const &newValue);
+
+	/**
+	 * Loads a sequence of values, which is sorted in ascending key order, into an empty index.
+	 *
+	 * In contrast to inserting each value on its own, the trie is constructed bottom up in linear time and each node is allocated exactly once.
+	 * The resulting trie satisfies the same height optimality invariants as a trie constructed by incremental inserts.
+	 * Values with a key equal to the key of their predecessor are not loaded.
+	 * In case the index is not empty, the values are inserted one by one using { @link #insert(ValueType const &) }.
+	 * A variant using multiple threads is provided by { @link hot::singlethreaded::bulkLoadParallel } in HOTSingleThreadedParallelBulkLoad.hpp.
+	 *
+	 * @tparam Iterator a forward iterator whose value type is ValueType
+	 * @param begin an iterator to the value with the smallest key
+	 * @param end the iterator marking the end of the sequence of values
+	 * @return the number of values loaded into the index
+	 * @throws std::length_error if any key is longer than the maximum key length (see { @link idx::contenthelpers::isSupportedKeyLength }). In this case no value is loaded.
+	 * @throws std::invalid_argument if any key is a length delimited key ending with a zero byte (see { @link idx::contenthelpers::isDistinguishableKey }) or if the index is empty and the keys are not in ascending order. In this case no value is loaded.
+	 */
+	template<typename Iterator> inline size_t bulkLoad(Iterator begin, Iterator end);
 
 	/**
 	 * Executes an upsert for the given value.
@@ -113,9 +334,109 @@ template<typename ValueType, template <typename> typename KeyExtractor> struct H
 	 *
 	 * @param newValue the value to upsert.
 	 * @return the value of a previously contained value for the same key or an invalid result otherwise
+	 * @throws std::length_error if the key is longer than the maximum key length (see { @link idx::contenthelpers::isSupportedKeyLength }). Such keys are never truncated silently.
+	 * @throws std::invalid_argument if the key is a length delimited key ending with a zero byte (see { @link idx::contenthelpers::isDistinguishableKey }).
 	 */
 	inline idx::contenthelpers::OptionalValue<ValueType> upsert(ValueType newValue);
 
+	/**
+	 * Creates a read only snapshot of the current state of the index in constant time.
+	 *
+	 * Nodes are shared between the index and its snapshots. Modifications of the index copy each shared node on the modified path instead of changing it in place
+	 * and retire replaced shared nodes instead of freeing them. Retired nodes are freed by the first modification after all snapshots referencing them were released.
+	 * Hence, the memory overhead is proportional to the number of nodes changed since the oldest live snapshot was taken.
+	 * A snapshot can be read and released by any thread, while the index is modified by its owning thread.
+	 * All snapshots must be released before the index is destroyed. Snapshots are not supported in combination with the { @link ArenaNodeAllocatorPolicy }.
+	 *
+	 * @return a handle to the snapshot, which releases it on destruction
+	 */
+	inline HOTSingleThreadedSnapshot<ValueType, KeyExtractor> snapshot();
+
+	/**
+	 * @return the number of nodes which were replaced while snapshots were live and are not yet freed, as they might still be reachable from a snapshot
+	 */
+	inline size_t getNumberRetiredNodes() const;
+
+	/**
+	 * @return the policy used to allocate the nodes of the index, which e.g. provides the number of chunks allocated by an { @link ArenaNodeAllocatorPolicy }
+	 */
+	inline NodeAllocatorPolicy const & getNodeAllocatorPolicy() const;
+
+	/**
+	 * Creates an immutable copy of the index, which is optimized for lookups and scans (see { @link HOTSingleThreadedFrozen }).
+	 * All nodes are copied into a single contiguous buffer in breadth first order. Their headers are reduced to 8 bytes and child nodes are referenced by 32 bit offsets.
+	 * The frozen copy is independent of the index and stays valid after the index is modified or destroyed.
+	 *
+	 * @return the frozen copy of the index
+	 * @throws std::length_error in case the nodes of the index do not fit into a frozen copy
+	 */
+	inline HOTSingleThreadedFrozen<ValueType, KeyExtractor> freeze() const;
+
+	/**
+	 * Incrementally relocates the nodes of the index to restore their locality after many modifications.
+	 *
+	 * The nodes are visited in depth first pre order and each visited node is copied into memory freshly allocated from the index's memory pool,
+	 * while the pointer of its parent is rewritten and the previous node is released. Hence each node is placed next to its parent or its preceding sibling's subtree,
+	 * in case the memory pool is backed by an arena (see { @link ArenaNodeAllocatorPolicy }). For other memory pools, the placement depends on the underlying allocator.
+	 * Each pass starts relocating into a new chunk of the arena. Once a pass is completed, the memory pooled by the index's memory pool is released.
+	 * This allows an arena to free all chunks vacated by the relocated nodes, hence repeated passes over an unchanged index end with the same number of chunks.
+	 * Each call relocates at most budget nodes and continues where the previous call stopped, which allows to interleave compaction with other operations.
+	 * Modifications between two calls are permitted. In case they changed the path to the next node to relocate, compaction continues at the deepest node still on this path.
+	 * While snapshots are live, nodes shared with them are copied instead of being released (see { @link #snapshot() }).
+	 * The statistic averageParentChildAddressDistance (see { @link #getStatistics() }) indicates whether compaction is beneficial.
+	 *
+	 * @param budget the maximum number of nodes to relocate
+	 * @return whether all nodes of the index have been relocated since the pass started, in which case the next call starts a new pass at the root
+	 */
+	inline bool compact(size_t budget);
+
+	/**
+	 * Restores a height optimized structure after many values were removed.
+	 *
+	 * Removing values merges and shrinks nodes only locally, which leaves underfull nodes behind and might keep the index higher than necessary.
+	 * Rebalancing visits the nodes bottom up and rebuilds a node together with its child nodes, in case combining their entries in the same way as the { @link hot::commons::BulkLoader }
+	 * results in fewer nodes or a lower height. Hence, adjacent underfull nodes are merged and nodes which are only required because of long chains of underfull nodes are removed.
+	 * As nodes always contain at least two entries, no further path compression is required.
+	 * After a complete pass the height of the index equals the height of a bulk loaded index containing the same values (see the statistic heightAboveOptimum of { @link #getStatistics() }).
+	 * While snapshots are live, nodes shared with them are copied instead of being released (see { @link #snapshot() }).
+	 */
+	inline void rebalance();
+
+	/**
+	 * Incrementally rebalances the index (see { @link #rebalance() }).
+	 *
+	 * Each call visits at least one and at most budget nodes in depth first post order and continues after the node visited last by the previous call.
+	 * Modifications between two calls are permitted. In case they changed the path to the node visited last, rebalancing continues with the first node in post order below the deepest node still on this path.
+	 * In case rebuilding a node lowers its height, its ancestors are rebuilt immediately as long as their heights are outdated, as the height of each node must exceed the maximum height of its children by exactly one.
+	 * Unvisited nodes below the topmost rebuilt ancestor are reconsidered by the next pass. Hence, a single incremental pass might not reach the optimal height, but repeated passes do.
+	 *
+	 * @param budget the maximum number of nodes to visit
+	 * @return whether the pass completed by visiting the root, in which case the next call starts a new pass
+	 */
+	inline bool rebalance(size_t budget);
+
+	/**
+	 * Writes the structure of the index to a file (see { @link HOTSingleThreadedFileFormat.hpp }).
+	 * The nodes are written in a single depth first traversal. Their memory images are stored together with their node types, but without any absolute addresses.
+	 * Values are stored verbatim, hence values which reference memory of the current process, like pointers to c strings, are only meaningful while this memory stays valid.
+	 *
+	 * @param filePath the path of the file to write
+	 * @return whether the file was written successfully
+	 */
+	inline bool save(std::string const & filePath) const;
+
+	/**
+	 * Replaces the content of the index by the content of a file written by { @link #save(std::string const &) }.
+	 * The file is read sequentially in a single pass and each node is rebuilt from its image, hence no node is split, merged or reencoded.
+	 * The file must have been written by a program using the same node layout, e.g. with the same subtree count and node capacity settings.
+	 * In case the file cannot be opened or was written with a different format or layout or for keys of a different kind of type or maximum length, the index remains unchanged.
+	 * In case the content of the file is corrupted, the index is empty afterwards.
+	 *
+	 * @param filePath the path of the file to read
+	 * @return whether the index was loaded successfully
+	 */
+	inline bool load(std::string const & filePath);
+
 	/**
 	 * @return an iterator to the first value according to the key order.
 	 */
@@ -126,6 +447,16 @@ template<typename ValueType, template <typename> typename KeyExtractor> struct H
 	 */
 	inline const_iterator end() const;
 
+	/**
+	 * @return a reverse iterator to the last value according to the key order, which traverses the values in descending key order.
+	 */
+	inline const_reverse_iterator rbegin() const;
+
+	/**
+	 * @return a reverse iterator which is positioned before the first element.
+	 */
+	inline const_reverse_iterator rend() const;
+
 	/**
 	 * searches an entry for the given key. In case an entry is found, an iterator for this entry is returned.
 	 * If no matching entry is found the { @link #end() } iterator is returned.
@@ -155,8 +486,27 @@ public:
 	 */
 	inline const_iterator upper_bound(KeyType const & searchKey) const;
 
+	/**
+	 * returns an iterator to the last entry which has a key, which is not larger than the given search key.
+	 * This is either an iterator to the matching entry itself or the last value contained in the index which has a key which is smaller than the search key.
+	 * Starting at the returned iterator, the preceding values can be traversed in descending key order by decrementing the iterator.
+	 *
+	 * @param searchKey the search key to determine the floor for
+	 * @return either the last entry which has a key, which is not larger than the given search key or the end iterator if no entry fulfills the floor condition
+	 */
+	inline const_iterator floor(KeyType const & searchKey) const;
+
+	/**
+	 * returns an iterator to the last entry which has a key which is smaller than the given search key
+	 *
+	 * @param searchKey the search key to determine the predecessor for
+	 * @return either the last entry which has a key smaller than the search key or the end iterator if no entry fulfills the predecessor condition
+	 */
+	inline const_iterator predecessor(KeyType const & searchKey) const;
+
 	private:
 	inline const_iterator lower_or_upper_bound(KeyType const & searchKey, bool is_lower_bound = true) const;
+	inline const_iterator floor_or_predecessor(KeyType const & searchKey, bool is_floor) const;
 
 public:
 	/**
@@ -187,7 +537,11 @@ public:
 	 * 		+ MULTI_MASK_8_BYTES_AND_32_BIT_PARTIAL_KEYS
 	 * 		+ MULTI_MASK_16_BYTES_AND_16_BIT_PARTIAL_KEYS
 	 * 		+ MULTI_MASK_32_BYTES_AND_32_BIT_PARTIAL_KEYS
-	 * 	- numberAllocations the actual number of allocations which where executd by the underlying memory pool
+	 * 	- numberAllocations the actual number of allocations which where executd by the memory pool of this instance's allocator policy
+	 * 	- averageParentChildAddressDistance the average distance in bytes between the address of a node and the addresses of its child nodes.
+	 * 		Large values indicate that the nodes are scattered in memory, which can be remedied by { @link #compact(size_t) }
+	 * 	- optimalHeight the height of a bulk loaded index containing the same values
+	 * 	- heightAboveOptimum the difference between the height and the optimal height, which can be remedied by { @link #rebalance() }
 	 *
 	 * @return the collected statistical values
 	 */
@@ -225,6 +579,137 @@ private:
 	HOTSingleThreadedDeletionInformation determineDeletionInformation(
 		const std::array<HOTSingleThreadedInsertStackEntry, 64> &searchStack, unsigned int currentDepth);
 
+	/**
+	 * Recalculates the subtree counts of all entries on the path to the given key bottom up.
+	 * After an insert or a remove only the counts of the entries on the modified path are outdated, as all newly created nodes derive their counts from their children.
+	 * In case subtree counts are not maintained, this is a no-op.
+	 *
+	 * @param keyBytes the key determining the path
+	 */
+	inline void updateSubtreeCountsOnPath(idx::contenthelpers::KeyBytesType<KeyType> const & keyBytes);
+
+	/**
+	 * Recalculates the subtree counts of all nodes in a subtree, e.g. after it was bulk loaded. In case subtree counts are not maintained, this is a no-op.
+	 *
+	 * @param subtree the root of the subtree
+	 */
+	static void initializeSubtreeCountsBottomUp(HOTSingleThreadedChildPointer const & subtree);
+
+	/**
+	 * Recalculates the subtree counts of all nodes of a subtree, which are not contained in the given nodes or below them. In case subtree counts are not maintained, this is a no-op.
+	 *
+	 * @param subtree the root of the subtree
+	 * @param retainedNodes the nodes whose subtree counts are still valid
+	 */
+	static void initializeSubtreeCountsAboveRetainedNodes(HOTSingleThreadedChildPointer const & subtree, std::vector<HOTSingleThreadedNodeBase const *> const & retainedNodes);
+
+	/**
+	 * Simulates how the { @link hot::commons::BulkLoader } combines the entries of a node, which are either leaves or the reopened roots of subtrees.
+	 *
+	 * @param node the node whose entries are combined
+	 * @param reshapesChildNodes whether the shape of each child node is itself determined recursively or taken from the child node as it is
+	 * @return the calculator after all entries have been appended
+	 */
+	static hot::commons::SubtreeShapeCalculator combineEntryShapes(HOTSingleThreadedChildPointer const & node, bool reshapesChildNodes);
+
+	/**
+	 * Determines whether rebuilding a node together with its child nodes results in a lower height or in fewer nodes or whether the node's height is outdated, because its child nodes were rebuilt.
+	 *
+	 * @param node the node to check
+	 * @return whether rebalancing the node is beneficial
+	 */
+	static bool isRebalancingBeneficial(HOTSingleThreadedChildPointer const & node);
+
+	/**
+	 * Rebuilds a node by combining its entries with the entries of its child nodes in the same way as the { @link hot::commons::BulkLoader }.
+	 * The node and its child nodes are freed, while the nodes below them are reused.
+	 *
+	 * @param node the node to rebuild
+	 * @return the root of the rebuilt subtree, which has at most the height of the previous node
+	 */
+	static HOTSingleThreadedChildPointer rebuildNode(HOTSingleThreadedChildPointer const & node);
+
+	/**
+	 * rebalances all nodes of a subtree bottom up
+	 *
+	 * @param subtree the root of the subtree, which is not modified in case it is shared with a live snapshot
+	 * @param copiesSharedNodes whether nodes shared with a live snapshot must be copied before being modified
+	 * @return the root of the rebalanced subtree
+	 */
+	inline HOTSingleThreadedChildPointer rebalanceSubtree(HOTSingleThreadedChildPointer const & subtree, bool copiesSharedNodes);
+
+	/**
+	 * removes all values of a subtree, which are located between the given boundaries.
+	 *
+	 * @param subtree the root node of the subtree
+	 * @param depth the depth of the subtree root in the paths of the boundary iterators
+	 * @param lowerBound the iterator pointing to the first value to remove or nullptr in case all values of the subtree before the upper bound are removed
+	 * @param upperBound the iterator pointing to the first value not to remove or nullptr in case all values of the subtree after the lower bound are removed
+	 * @param numberRemovedValues an output parameter which is incremented by the number of removed values
+	 * @return the new root of the subtree, which is unused in case all of its values were removed
+	 */
+	static HOTSingleThreadedChildPointer removeRangeFromSubtree(
+		HOTSingleThreadedChildPointer const & subtree, unsigned int depth, const_iterator const * lowerBound, const_iterator const * upperBound, size_t & numberRemovedValues
+	);
+
+	/**
+	 * replaces a node by a node consisting only of its entries not contained in the given mask
+	 *
+	 * @param node the node to remove the entries from. It is freed in case any entry is removed.
+	 * @param removedEntriesMask a mask having the bits of the entries to remove set
+	 * @return the replacement of the node, which is either a new node, the single remaining entry or unused in case all entries were removed
+	 */
+	static HOTSingleThreadedChildPointer removeEntriesFromNode(HOTSingleThreadedChildPointer const & node, uint32_t removedEntriesMask);
+
+	/**
+	 * frees all nodes of a subtree
+	 *
+	 * @param subtree the root of the subtree to free
+	 * @return the number of values contained in the freed subtree
+	 */
+	static size_t deleteSubtreeAndCountValues(HOTSingleThreadedChildPointer const & subtree);
+
+	/**
+	 * Prepares a modification of the index by freeing retired nodes which are no longer reachable from any snapshot.
+	 *
+	 * @return the snapshot registry which must be active during the modification or nullptr if no snapshot was ever taken
+	 */
+	inline HOTSingleThreadedSnapshotRegistry* activateSnapshotRegistry();
+
+	/**
+	 * replaces a node which is shared with a live snapshot by a private copy and retires the shared node.
+	 * This must be called for each node before it is modified in place, starting at the root, as the child pointer itself is modified.
+	 *
+	 * @param nodePointer the child pointer to the node, which is either the root or contained in a node which is not shared
+	 */
+	inline void copySharedNode(HOTSingleThreadedChildPointer & nodePointer);
+
+	/**
+	 * replaces all nodes on the path to the given position, which are shared with a live snapshot, by private copies
+	 *
+	 * @param position an iterator describing the path. It is invalidated in case any node was copied.
+	 */
+	inline void copySharedNodesOnPath(const_iterator const & position);
+
+	/**
+	 * writes the records of all nodes of a subtree in depth first post order
+	 *
+	 * @param subtree the root of the subtree to write
+	 * @param output the stream to write to
+	 * @param numberWrittenRecords the number of records written so far. It is incremented for each written record.
+	 * @return the record reference of the subtree's root or the root itself in case it is a leaf
+	 */
+	static HOTSingleThreadedChildPointer saveSubtree(HOTSingleThreadedChildPointer const & subtree, std::ostream & output, uint64_t & numberWrittenRecords);
+
+	/**
+	 * reads the records of all nodes contained in a file and rebuilds the nodes
+	 *
+	 * @param input the stream positioned at the first record
+	 * @param fileHeader the already validated header of the file
+	 * @return whether the records were valid and in this case the root of the rebuilt trie. Otherwise all nodes rebuilt so far are freed.
+	 */
+	static std::pair<bool, HOTSingleThreadedChildPointer> loadNodes(std::istream & input, HOTSingleThreadedFileHeader const & fileHeader);
+
 public:
 	/**
 	 * @return the overall tree height
@@ -232,7 +717,7 @@ public:
 	size_t getHeight() const;
 };
 
-inline void insertNewValueIntoNode(
+template<size_t maximumKeyLength> inline void insertNewValueIntoNode(
 	std::array<HOTSingleThreadedInsertStackEntry, 64> & insertStack, hot::commons::DiscriminativeBit const & significantKeyInformation,
 	unsigned int insertDepth, unsigned int leafDepth, HOTSingleThreadedChildPointer const & valueToInsert
 );
@@ -250,6 +735,6 @@ inline void integrateBiNodeIntoTree(
 );
 
 
-} }
+} } }
 
 #endif
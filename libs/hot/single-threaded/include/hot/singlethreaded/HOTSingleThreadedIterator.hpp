@@ -7,8 +7,9 @@
 #include "hot/singlethreaded/HOTSingleThreadedChildPointer.hpp"
 #include "hot/singlethreaded/HOTSingleThreadedNodeBase.hpp"
 #include "idx/contenthelpers/TidConverters.hpp"
+#include "hot/commons/InstructionSet.hpp"
 
-namespace hot { namespace singlethreaded {
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 class HOTSingleThreadedIteratorStackEntry {
 	HOTSingleThreadedChildPointer const * mCurrent;
@@ -30,6 +31,10 @@ public:
 		return mCurrent;
 	}
 
+	HOTSingleThreadedChildPointer const * getEnd() const {
+		return mEnd;
+	}
+
 	bool isExhausted() {
 		return mCurrent == mEnd;
 	}
@@ -39,12 +44,16 @@ public:
 			++mCurrent;
 		}
 	}
+
+	void retreat() {
+		--mCurrent;
+	}
 };
 
-template<typename ValueType, template <typename> typename KeyExtractor> class HOTSingleThreaded; //Forward Declaration of SIMDCobTrie for usage as friend class
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> struct HOTSingleThreaded; //Forward Declaration of SIMDCobTrie for usage as friend class
 
 template<typename ValueType> class HOTSingleThreadedIterator {
-	template<typename ValueType2, template <typename> typename KeyExtractor> friend class hot::singlethreaded::HOTSingleThreaded;
+	template<typename ValueType2, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> friend struct hot::singlethreaded::HOTSingleThreaded;
 
 	static HOTSingleThreadedChildPointer END_TOKEN;
 
@@ -85,6 +94,23 @@ public:
 		return *this;
 	}
 
+	/**
+	 * moves the iterator to the value preceding the current value in key order.
+	 * Decrementing an iterator positioned on the smallest value yields the end iterator. Decrementing the end iterator yields the end iterator again.
+	 */
+	HOTSingleThreadedIterator<ValueType> & operator--() {
+		while((mCurrentDepth > 0) && isFirstEntryOfNode(mCurrentDepth)) {
+			--mCurrentDepth;
+		}
+		if(mCurrentDepth == 0) {
+			mNodeStack[0].init(&END_TOKEN, &END_TOKEN);
+		} else {
+			mNodeStack[mCurrentDepth].retreat();
+			descendRightmost();
+		}
+		return *this;
+	}
+
 	bool operator==(HOTSingleThreadedIterator<ValueType> const & other) const {
 		return (*mNodeStack[mCurrentDepth].getCurrent()) == (*other.mNodeStack[other.mCurrentDepth].getCurrent());
 	}
@@ -106,6 +132,18 @@ private:
 		}
 	}
 
+	void descendRightmost() {
+		HOTSingleThreadedChildPointer const* currentSubtreeRoot = mNodeStack[mCurrentDepth].getCurrent();
+		while(currentSubtreeRoot->isAValidNode()) {
+			HOTSingleThreadedNodeBase* currentSubtreeRootNode = currentSubtreeRoot->getNode();
+			currentSubtreeRoot = descend(currentSubtreeRootNode->end() - 1, currentSubtreeRootNode->end());
+		}
+	}
+
+	bool isFirstEntryOfNode(size_t depth) const {
+		return mNodeStack[depth].getCurrent() == mNodeStack[depth - 1].getCurrent()->getNode()->getPointers();
+	}
+
 	HOTSingleThreadedChildPointer const* descend(HOTSingleThreadedChildPointer const* current, HOTSingleThreadedChildPointer const* end) {
 		return mNodeStack[++mCurrentDepth].init(current, end);
 	}
@@ -113,6 +151,6 @@ private:
 
 template<typename KeyHelper> HOTSingleThreadedChildPointer HOTSingleThreadedIterator<KeyHelper>::END_TOKEN {};
 
-}}
+}}}
 
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_NODE__
 
 #include <cstdint>
+#include <cstring>
 
 #include <idx/contenthelpers/OptionalValue.hpp>
 
@@ -11,17 +12,21 @@
 #include <hot/commons/InsertInformation.hpp>
 #include <hot/commons/NodeAllocationInformations.hpp>
 #include <hot/commons/NodeMergeInformation.hpp>
+#include <hot/commons/ParallelBitOperations.hpp>
 #include <hot/commons/PartialKeyMappingHelpers.hpp>
 #include <hot/commons/SearchResultForInsert.hpp>
 #include <hot/commons/SparsePartialKeys.hpp>
 #include <hot/commons/TwoEntriesNode.hpp>
 
 #include "hot/singlethreaded/HOTSingleThreadedNodeBase.hpp"
+#include "hot/singlethreaded/HOTSingleThreadedNodeCapacityPolicy.hpp"
 #include "hot/singlethreaded/HOTSingleThreadedNodeInterface.hpp"
+#include "hot/singlethreaded/HOTSingleThreadedSnapshotRegistry.hpp"
 
 #include "HOTSingleThreadedChildPointer.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace singlethreaded {
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 constexpr uint32_t calculatePointerSize(uint16_t const numberEntries) {
 	constexpr uint32_t childPointerSize = static_cast<uint32_t>(sizeof(HOTSingleThreadedChildPointer));
@@ -74,7 +79,11 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> voi
 	assert(numberEntries >= 2);
 	/*NodeAllocationInformation const & allocationInformation = mAllocationInformation[numberEntries];*/
 	uint16_t sizeInBytes = allocationInformation.mTotalSizeInBytes;
-	void* memory = HOTSingleThreadedNodeBase::getMemoryPool()->alloc(sizeInBytes/sizeof(uint64_t));
+	void* memory = HOTSingleThreadedNodeBase::getMemoryPool(NodeAllocatorRegistry::getCurrentAllocatorId())->alloc(sizeInBytes/sizeof(uint64_t));
+	HOTSingleThreadedSnapshotRegistry* snapshotRegistry = HOTSingleThreadedSnapshotRegistry::getActiveRegistry();
+	if(snapshotRegistry != nullptr) {
+		snapshotRegistry->recordCreation(reinterpret_cast<HOTSingleThreadedNodeBase const *>(memory));
+	}
 	return memory;
 	/*void* memoryForNode = nullptr;
 	uint error = posix_memalign(&memoryForNode, SIMD_COB_TRIE_NODE_ALIGNMENT, allocationInformation.mTotalSizeInBytes);
@@ -88,17 +97,31 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> voi
 
 template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> void HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::operator delete (void * rawMemory) {
 	//free(rawMemory);
-	size_t previousNumberEntries = reinterpret_cast<HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>*>(rawMemory)->getNumberEntries();
+	HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>* node = reinterpret_cast<HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>*>(rawMemory);
+	//nodes which are still reachable from a snapshot are retired instead of being freed
+	HOTSingleThreadedSnapshotRegistry* snapshotRegistry = HOTSingleThreadedSnapshotRegistry::getActiveRegistry();
+	if(snapshotRegistry != nullptr && snapshotRegistry->retireIfShared(node->toChildPointer())) {
+		return;
+	}
+	size_t previousNumberEntries = node->getNumberEntries();
 	hot::commons::NodeAllocationInformation const & allocationInformation = hot::commons::NodeAllocationInformations<HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>>::getAllocationInformation(previousNumberEntries);
-	HOTSingleThreadedNodeBase::getMemoryPool()->returnToPool(allocationInformation.mTotalSizeInBytes/sizeof(uint64_t), rawMemory);
+	HOTSingleThreadedNodeBase::getMemoryPool(node->mAllocatorId)->returnToPool(allocationInformation.mTotalSizeInBytes/sizeof(uint64_t), rawMemory);
 }
 
 template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inline hot::commons::NodeAllocationInformation HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::getNodeAllocationInformation(uint16_t const numberEntries) {
 	constexpr uint32_t entriesMasksBaseSize = static_cast<uint32_t>(sizeof(hot::commons::SparsePartialKeys<PartialKeyType>));
 	constexpr uint32_t baseSize = static_cast<uint32_t>(sizeof(HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>)) - entriesMasksBaseSize;
+	constexpr uint16_t maximumCapacity = NodeCapacityPolicy::getCapacity(hot::commons::MAXIMUM_NUMBER_NODE_ENTRIES);
+	static_assert(
+		hot::commons::SparsePartialKeys<PartialKeyType>::estimateSize(maximumCapacity) + baseSize + SubtreeCountPolicy::getSizeInBytes(maximumCapacity) + calculatePointerSize(maximumCapacity)
+			<= MAXIMUM_NODE_SIZE_IN_LONGS * sizeof(uint64_t),
+		"the largest node of each node type must fit into the memory pools and the slots of the slab allocator"
+	);
 
-	uint32_t pointersSize = calculatePointerSize(numberEntries);
-	uint16_t pointerOffset = hot::commons::SparsePartialKeys<PartialKeyType>::estimateSize(numberEntries) + baseSize;
+	uint16_t capacity = NodeCapacityPolicy::getCapacity(numberEntries);
+	uint32_t pointersSize = calculatePointerSize(capacity);
+	//the subtree counts are located between the partial keys and the child pointers
+	uint16_t pointerOffset = hot::commons::SparsePartialKeys<PartialKeyType>::estimateSize(capacity) + baseSize + SubtreeCountPolicy::getSizeInBytes(capacity);
 	uint32_t rawSize = pointersSize + pointerOffset;
 	assert((rawSize % 8) == 0);
 
@@ -129,20 +152,21 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 
 	hot::commons::DiscriminativeBit const & keyInformation = insertInformation.mKeyInformation;
 	PartialKeyConversionInformation const & conversionInformation = getConversionInformation(sourceNode, keyInformation);
+	hot::commons::ParallelBitMask<uint32_t> const conversion(conversionInformation.mConversionMask);
 
 	unsigned int firstIndexInAffectedSubtree = insertInformation.getFirstIndexInAffectedSubtree();
 	unsigned int numberEntriesInAffectedSubtree = insertInformation.getNumberEntriesInAffectedSubtree();
 
 	for(unsigned int i = 0u; i < firstIndexInAffectedSubtree; ++i) {
-		targetMasks[i] = _pdep_u32(existingMasks[i], conversionInformation.mConversionMask);
+		targetMasks[i] = conversion.depositBits(existingMasks[i]);
 		targetPointers[i] = existingPointers[i];
 	}
 
-	uint32_t convertedSubTreePrefixMask = _pdep_u32(insertInformation.mSubtreePrefixPartialKey, conversionInformation.mConversionMask);
+	uint32_t convertedSubTreePrefixMask = conversion.depositBits(insertInformation.mSubtreePrefixPartialKey);
 	unsigned int firstIndexAfterAffectedSubtree = firstIndexInAffectedSubtree + numberEntriesInAffectedSubtree;
 	if(keyInformation.mValue) {
 		for (unsigned int i = firstIndexInAffectedSubtree; i < firstIndexAfterAffectedSubtree; ++i) {
-			targetMasks[i] = _pdep_u32(existingMasks[i], conversionInformation.mConversionMask);
+			targetMasks[i] = conversion.depositBits(existingMasks[i]);
 			targetPointers[i] = existingPointers[i];
 		}
 		targetMasks[firstIndexAfterAffectedSubtree] = static_cast<PartialKeyType>(convertedSubTreePrefixMask | conversionInformation.mAdditionalMask);
@@ -152,16 +176,18 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 		targetPointers[firstIndexInAffectedSubtree] = newValue;
 		for (unsigned int i = firstIndexInAffectedSubtree; i < firstIndexAfterAffectedSubtree; ++i) {
 			unsigned int targetIndex = i + 1u;
-			targetMasks[targetIndex] = static_cast<PartialKeyType>(_pdep_u32(existingMasks[i], conversionInformation.mConversionMask) | conversionInformation.mAdditionalMask);
+			targetMasks[targetIndex] = static_cast<PartialKeyType>(conversion.depositBits(existingMasks[i]) | conversionInformation.mAdditionalMask);
 			targetPointers[targetIndex] = existingPointers[i];
 		}
 	}
 
 	for(unsigned int i = firstIndexAfterAffectedSubtree; i < oldNumberEntries; ++i) {
 		unsigned int targetIndex = i + 1u;
-		targetMasks[targetIndex] = _pdep_u32(existingMasks[i], conversionInformation.mConversionMask);
+		targetMasks[targetIndex] = conversion.depositBits(existingMasks[i]);
 		targetPointers[targetIndex] = existingPointers[i];
 	}
+
+	initializeSubtreeCounts();
 }
 
 //remove entry from node
@@ -175,6 +201,7 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 ) : HOTSingleThreadedNode(sourceNode.mHeight, newNumberEntries, discriminativeBitsRepresentation) {
 
 	compressRangeIntoNewNode(sourceNode, compressionMask, firstIndexInRange, 0, numberEntriesInRange);
+	initializeSubtreeCounts();
 
 	//This is important for the tree to have fast lookup and maintain integrity!! the first mask always is zero!!
 	mPartialKeys.mEntries[0] = 0u;
@@ -196,8 +223,10 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 	PartialKeyConversionInformation const & conversionInformation = getConversionInformationForCompressionMask(compressionMask, keyInformation);
 
 	PartialKeyType additionalBitConversionMask = conversionInformation.mConversionMask;
+	hot::commons::ParallelBitMask<uint32_t> const compression(compressionMask);
+	hot::commons::ParallelBitMask<uint32_t> const additionalBitConversion(additionalBitConversionMask);
 
-	PartialKeyType newMask = static_cast<PartialKeyType>(_pdep_u32(_pext_u32(insertInformation.mSubtreePrefixPartialKey, compressionMask), additionalBitConversionMask))
+	PartialKeyType newMask = static_cast<PartialKeyType>(additionalBitConversion.depositBits(compression.extractBits(insertInformation.mSubtreePrefixPartialKey)))
 		| (keyInformation.mValue * conversionInformation.mAdditionalMask);
 
 	unsigned int numberEntriesBeforeAffectedSubtree = insertInformation.getFirstIndexInAffectedSubtree() - firstIndexInRange;
@@ -210,7 +239,7 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 
 	for(unsigned int targetIndex = 0; targetIndex < numberEntriesBeforeAffectedSubtree; ++targetIndex) {
 		unsigned int sourceIndex = firstIndexInRange + targetIndex;
-		targetMasks[targetIndex] = _pdep_u32(_pext_u32(existingMasks[sourceIndex], compressionMask), additionalBitConversionMask);
+		targetMasks[targetIndex] = additionalBitConversion.depositBits(compression.extractBits(existingMasks[sourceIndex]));
 		targetPointers[targetIndex] = existingPointers[sourceIndex];
 	}
 
@@ -222,7 +251,7 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 		unsigned int sourceIndex = insertInformation.getFirstIndexInAffectedSubtree() + indexInAffectedSubtree;
 		unsigned int targetIndex = firstTargetIndexInAffectedSubtree + indexInAffectedSubtree;
 
-		targetMasks[targetIndex] = _pdep_u32(_pext_u32(existingMasks[sourceIndex], compressionMask), additionalBitConversionMask) | additionalMaskForExistingEntries;
+		targetMasks[targetIndex] = additionalBitConversion.depositBits(compression.extractBits(existingMasks[sourceIndex])) | additionalMaskForExistingEntries;
 		targetPointers[targetIndex] = existingPointers[sourceIndex];
 	}
 
@@ -233,13 +262,14 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 	for(unsigned int indexAfterAffectedSubtree = 0; indexAfterAffectedSubtree < numberEntriesAfterAffectedSubtree; ++indexAfterAffectedSubtree) {
 		unsigned int sourceIndex = sourceIndexAfterAffectedSubtree + indexAfterAffectedSubtree;
 		unsigned int targetIndex = firstTargeIndexAfterAffectedSubtree + indexAfterAffectedSubtree;
-		targetMasks[targetIndex] = _pdep_u32(_pext_u32(existingMasks[sourceIndex], compressionMask), additionalBitConversionMask);
+		targetMasks[targetIndex] = additionalBitConversion.depositBits(compression.extractBits(existingMasks[sourceIndex]));
 		targetPointers[targetIndex] = existingPointers[sourceIndex];
 	}
 
 	uint32_t targetIndexForNewValue = numberEntriesBeforeAffectedSubtree + (keyInformation.mValue * insertInformation.getNumberEntriesInAffectedSubtree());
 	targetMasks[targetIndexForNewValue] = newMask;
 	targetPointers[targetIndexForNewValue] = newValue;
+	initializeSubtreeCounts();
 
 	//This is important for the tree to have fast lookup and maintain integrity!!
 	targetMasks[0] = 0ul;
@@ -256,9 +286,10 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 	uint32_t indexOfEntryToRemove = deletionInformation.getIndexOfEntryToRemove();
 	compressRangeIntoNewNode(sourceNode, deletionInformation.getCompressionMask(), 0, 0, indexOfEntryToRemove);
 	compressRangeIntoNewNode(sourceNode, deletionInformation.getCompressionMask(), indexOfEntryToRemove + 1, indexOfEntryToRemove, numberEntries - indexOfEntryToRemove);
+	initializeSubtreeCounts();
 
 	uint32_t lastIndexInRange = deletionInformation.getAffectedBiNode().mRight.getLastIndexInRange();
-	uint32_t deleteUnusedBitMask = ~_pext_u32(deletionInformation.getAffectedBiNode().mDiscriminativeBitMask, deletionInformation.getCompressionMask());
+	uint32_t deleteUnusedBitMask = ~hot::commons::extractBits32(deletionInformation.getAffectedBiNode().mDiscriminativeBitMask, deletionInformation.getCompressionMask());
 
 	for(uint32_t i=deletionInformation.getAffectedBiNode().mLeft.mFirstIndexInRange; i < lastIndexInRange; ++i) {
 		mPartialKeys.mEntries[i] = mPartialKeys.mEntries[i] & deleteUnusedBitMask;
@@ -270,6 +301,34 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 	assert(getMaskForLargerEntries() != mUsedEntriesMask);
 };
 
+//remove multiple entries from node
+template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> template<typename SourceDiscriminativeBitsRepresentation, typename SourcePartialKeyType> inline HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::HOTSingleThreadedNode(
+	HOTSingleThreadedNode<SourceDiscriminativeBitsRepresentation, SourcePartialKeyType> const & sourceNode,
+	uint16_t const numberEntries,
+	DiscriminativeBitsRepresentation const & discriminativeBitsRepresentation,
+	SourcePartialKeyType compressionMask,
+	uint32_t remainingEntriesMask,
+	SourcePartialKeyType const * remainingPartialKeys
+) : HOTSingleThreadedNode(sourceNode.mHeight, numberEntries, discriminativeBitsRepresentation) {
+	HOTSingleThreadedChildPointer const * __restrict__ existingPointers = sourceNode.getPointers();
+	HOTSingleThreadedChildPointer * __restrict__ targetPointers = getPointers();
+	PartialKeyType __restrict__ * targetMasks = mPartialKeys.mEntries;
+	hot::commons::ParallelBitMask<uint32_t> const compression(compressionMask);
+
+	for(unsigned int targetIndex = 0u; targetIndex < numberEntries; ++targetIndex) {
+		unsigned int sourceIndex = hot::commons::countTrailingZeros32(remainingEntriesMask);
+		targetMasks[targetIndex] = static_cast<PartialKeyType>(compression.extractBits(remainingPartialKeys[targetIndex]));
+		targetPointers[targetIndex] = existingPointers[sourceIndex];
+		remainingEntriesMask = hot::commons::resetLowestSetBit32(remainingEntriesMask);
+	}
+	initializeSubtreeCounts();
+
+	//This is important for the tree to have fast lookup and maintain integrity!! the first mask always is zero!!
+	mPartialKeys.mEntries[0] = 0u;
+
+	assert(getMaskForLargerEntries() != mUsedEntriesMask);
+}
+
 template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> template<typename SourceDiscriminativeBitsRepresentation, typename SourcePartialKeyType> inline HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::HOTSingleThreadedNode(
 	HOTSingleThreadedNode<SourceDiscriminativeBitsRepresentation, SourcePartialKeyType> const & sourceNode, uint16_t const numberEntries, DiscriminativeBitsRepresentation const & discriminativeBitsRepresentation,
 	HOTSingleThreadedDeletionInformation const & deletionInformation, hot::commons::DiscriminativeBit const & keyInformation, HOTSingleThreadedChildPointer const & newValue
@@ -288,6 +347,7 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 	copyAndRemove(sourceNode, deletionInformation, conversionInformation.mConversionMask, targetIndexOffset);
 
 	addHighBitToMasksInRightHalf((keyInformation.mValue * (numberEntriesInSourceNodeToCopy  - 1)) + 1);
+	initializeSubtreeCounts();
 
 	//This is important for the tree to have fast lookup and maintain integrity!! the first mask always is zero!!
 	mPartialKeys.mEntries[0] = 0u;
@@ -316,6 +376,7 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 		copyAndRecode(rightSourceNode, rightRecodingMask, entriesInLeftSide - 1);
 		addHighBitToMasksInRightHalf(entriesInLeftSide  - 1);
 	}
+	initializeSubtreeCounts();
 
 	//ensure that first entry is always zero
 	mPartialKeys.mEntries[0] = 0;
@@ -326,23 +387,24 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 ) {
 	uint32_t numberSourceEntries = sourceNode.getNumberEntries();
 	uint32_t indexOfEntryToRemove = deletionInformation.getIndexOfEntryToRemove();
-	uint32_t compressionMask = deletionInformation.getCompressionMask();
+	hot::commons::ParallelBitMask<uint32_t> const compression(deletionInformation.getCompressionMask());
+	hot::commons::ParallelBitMask<uint32_t> const sourceRecoding(sourceRecodingMask);
 	HOTSingleThreadedChildPointer const* sourceValues = sourceNode.getPointers();
 
 	for(uint32_t i=0; i < indexOfEntryToRemove; ++i) {
 		size_t writeIndex = i + targetStartIndex;
-		mPartialKeys.mEntries[writeIndex] = _pdep_u32(_pext_u32(sourceNode.mPartialKeys.mEntries[i], compressionMask), sourceRecodingMask);
+		mPartialKeys.mEntries[writeIndex] = sourceRecoding.depositBits(compression.extractBits(sourceNode.mPartialKeys.mEntries[i]));
 		mFirstChildPointer[writeIndex] = sourceValues[i];
 	}
 
 	for(uint32_t i=indexOfEntryToRemove + 1; i < numberSourceEntries; ++i) {
 		size_t writeIndex = i + targetStartIndex - 1;
-		mPartialKeys.mEntries[writeIndex] = _pdep_u32(_pext_u32(sourceNode.mPartialKeys.mEntries[i], compressionMask), sourceRecodingMask);
+		mPartialKeys.mEntries[writeIndex] = sourceRecoding.depositBits(compression.extractBits(sourceNode.mPartialKeys.mEntries[i]));
 		mFirstChildPointer[writeIndex] = sourceValues[i];
 	}
 
 	uint32_t lastIndexInRange = deletionInformation.getAffectedBiNode().mRight.getLastIndexInRange();
-	uint32_t deleteUnusedBitMask = ~_pdep_u32(_pext_u32(deletionInformation.getAffectedBiNode().mDiscriminativeBitMask, deletionInformation.getCompressionMask()), sourceRecodingMask);
+	uint32_t deleteUnusedBitMask = ~sourceRecoding.depositBits(compression.extractBits(deletionInformation.getAffectedBiNode().mDiscriminativeBitMask));
 	for(uint32_t i=deletionInformation.getAffectedBiNode().mLeft.mFirstIndexInRange; i < lastIndexInRange; ++i) {
 		uint32_t targetIndex = i + targetStartIndex;
 		mPartialKeys.mEntries[targetIndex] = mPartialKeys.mEntries[targetIndex] & deleteUnusedBitMask;
@@ -354,8 +416,9 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 		SourceNodeType const & sourceNode, uint32_t recodingMask, uint32_t targetStartIndex
 ) {
 	uint32_t numberSourceEntries = sourceNode.getNumberEntries();
+	hot::commons::ParallelBitMask<uint32_t> const recoding(recodingMask);
 	for(uint32_t i=0; i < numberSourceEntries; ++i) {
-		mPartialKeys.mEntries[targetStartIndex + i] = _pdep_u32(sourceNode.mPartialKeys.mEntries[i], recodingMask);
+		mPartialKeys.mEntries[targetStartIndex + i] = recoding.depositBits(sourceNode.mPartialKeys.mEntries[i]);
 	}
 	std::memmove(mFirstChildPointer + targetStartIndex, sourceNode.getPointers(), numberSourceEntries * sizeof(HOTSingleThreadedChildPointer));
 }
@@ -370,11 +433,11 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> voi
 	}
 }
 
-template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inline HOTSingleThreadedChildPointer const * HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::search(uint8_t const * keyBytes) const {
+template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> template<typename KeyBytesType> inline HOTSingleThreadedChildPointer const * HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::search(KeyBytesType const & keyBytes) const {
 	return getPointers() + toResultIndex(mPartialKeys.search(mDiscriminativeBitsRepresentation.extractMask(keyBytes)));
 }
 
-template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inline HOTSingleThreadedChildPointer* HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::searchForInsert(hot::commons::SearchResultForInsert & searchResultOut, uint8_t const * keyBytes) const {
+template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> template<typename KeyBytesType> inline HOTSingleThreadedChildPointer* HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::searchForInsert(hot::commons::SearchResultForInsert & searchResultOut, KeyBytesType const & keyBytes) const {
 	uint32_t resultIndex = toResultIndex(mPartialKeys.search(mDiscriminativeBitsRepresentation.extractMask(keyBytes)));
 	searchResultOut.init(resultIndex, mDiscriminativeBitsRepresentation.mMostSignificantDiscriminativeBitIndex);
 	return mFirstChildPointer + resultIndex;
@@ -400,7 +463,7 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inl
 
 	assert(affectedSubtreeMask != 0);
 	uint32_t firstIndexInAffectedSubtree = __builtin_ctz(affectedSubtreeMask);
-	uint32_t numberEntriesInAffectedSubtree = _mm_popcnt_u32(affectedSubtreeMask);
+	uint32_t numberEntriesInAffectedSubtree = hot::commons::populationCount32(affectedSubtreeMask);
 
 	return { subtreePrefixMask, firstIndexInAffectedSubtree, numberEntriesInAffectedSubtree, discriminativeBit };
 }
@@ -437,6 +500,75 @@ HOTSingleThreadedChildPointer HOTSingleThreadedNode<DiscriminativeBitsRepresenta
 	});
 }
 
+template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inline bool HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::tryToAddEntryInPlace(
+	hot::commons::InsertInformation const & insertInformation, HOTSingleThreadedChildPointer const & newValue
+) {
+	return hasSpareCapacity() && mDiscriminativeBitsRepresentation.insert(insertInformation.mKeyInformation, [&](auto const & newDiscriminativeBitsRepresentation) -> bool {
+		return (newDiscriminativeBitsRepresentation.calculateNumberBitsUsed() <= (sizeof(PartialKeyType) * 8))
+			&& addEntryInPlace(newDiscriminativeBitsRepresentation, insertInformation, newValue);
+	});
+}
+
+template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inline bool HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::hasSpareCapacity() const {
+	uint16_t numberEntries = static_cast<uint16_t>(getNumberEntries());
+	return !isFull() && (NodeCapacityPolicy::getCapacity(numberEntries) == NodeCapacityPolicy::getCapacity(numberEntries + 1u));
+}
+
+template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inline bool HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::addEntryInPlace(
+	DiscriminativeBitsRepresentation const & newDiscriminativeBitsRepresentation, hot::commons::InsertInformation const & insertInformation, HOTSingleThreadedChildPointer const & newValue
+) {
+	unsigned int oldNumberEntries = static_cast<unsigned int>(getNumberEntries());
+	uint32_t sourceMaskBits = mDiscriminativeBitsRepresentation.getAllMaskBits();
+	mDiscriminativeBitsRepresentation = newDiscriminativeBitsRepresentation;
+
+	HOTSingleThreadedChildPointer * pointers = getPointers();
+	PartialKeyType * masks = mPartialKeys.mEntries;
+
+	hot::commons::DiscriminativeBit const & keyInformation = insertInformation.mKeyInformation;
+	PartialKeyConversionInformation const & conversionInformation = getConversionInformation(sourceMaskBits, keyInformation);
+	hot::commons::ParallelBitMask<uint32_t> const conversion(conversionInformation.mConversionMask);
+
+	unsigned int firstIndexInAffectedSubtree = insertInformation.getFirstIndexInAffectedSubtree();
+	unsigned int firstIndexAfterAffectedSubtree = firstIndexInAffectedSubtree + insertInformation.getNumberEntriesInAffectedSubtree();
+	PartialKeyType convertedSubTreePrefixMask = static_cast<PartialKeyType>(conversion.depositBits(insertInformation.mSubtreePrefixPartialKey));
+
+	//entries are moved towards the end of the node, hence they are processed in descending order to not overwrite entries which are not moved yet
+	for(unsigned int targetIndex = oldNumberEntries; targetIndex > firstIndexAfterAffectedSubtree; --targetIndex) {
+		masks[targetIndex] = static_cast<PartialKeyType>(conversion.depositBits(masks[targetIndex - 1u]));
+		pointers[targetIndex] = pointers[targetIndex - 1u];
+	}
+
+	if(keyInformation.mValue) {
+		masks[firstIndexAfterAffectedSubtree] = static_cast<PartialKeyType>(convertedSubTreePrefixMask | conversionInformation.mAdditionalMask);
+		pointers[firstIndexAfterAffectedSubtree] = newValue;
+		for(unsigned int i = firstIndexInAffectedSubtree; i < firstIndexAfterAffectedSubtree; ++i) {
+			masks[i] = static_cast<PartialKeyType>(conversion.depositBits(masks[i]));
+		}
+	} else {
+		for(unsigned int targetIndex = firstIndexAfterAffectedSubtree; targetIndex > firstIndexInAffectedSubtree; --targetIndex) {
+			masks[targetIndex] = static_cast<PartialKeyType>(conversion.depositBits(masks[targetIndex - 1u]) | conversionInformation.mAdditionalMask);
+			pointers[targetIndex] = pointers[targetIndex - 1u];
+		}
+		masks[firstIndexInAffectedSubtree] = convertedSubTreePrefixMask;
+		pointers[firstIndexInAffectedSubtree] = newValue;
+	}
+
+	for(unsigned int i = 0u; i < firstIndexInAffectedSubtree; ++i) {
+		masks[i] = static_cast<PartialKeyType>(conversion.depositBits(masks[i]));
+	}
+
+	mUsedEntriesMask = convertNumbeEntriesToEntriesMask(oldNumberEntries + 1u);
+	initializeSubtreeCounts();
+	return true;
+}
+
+template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> template<typename OtherDiscriminativeBitsRepresentation> inline bool HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::addEntryInPlace(
+	OtherDiscriminativeBitsRepresentation const & /* newDiscriminativeBitsRepresentation */, hot::commons::InsertInformation const & /* insertInformation */, HOTSingleThreadedChildPointer const & /* newValue */
+) {
+	//a different discriminative bits representation requires a different node type
+	return false;
+}
+
 template<typename DiscriminativeBitsRepresentation, typename PartialKeyType>  inline HOTSingleThreadedChildPointer HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::removeEntry(HOTSingleThreadedDeletionInformation const & deletionInformation) const {
 	size_t numberEntries = getNumberEntries();
 	size_t newNumberEntries = numberEntries - 1;
@@ -459,6 +591,56 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType>  in
 		: getPointers()[1-deletionInformation.getIndexOfEntryToRemove()];
 };
 
+template<typename DiscriminativeBitsRepresentation, typename PartialKeyType>  inline HOTSingleThreadedChildPointer HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::removeEntries(uint32_t removedEntriesMask) const {
+	uint32_t remainingEntriesMask = mUsedEntriesMask & ~removedEntriesMask;
+	uint16_t newNumberEntries = static_cast<uint16_t>(hot::commons::populationCount32(remainingEntriesMask));
+	assert(newNumberEntries > 0);
+
+	if(newNumberEntries == 1) {
+		return getPointers()[hot::commons::countTrailingZeros32(remainingEntriesMask)];
+	}
+
+	//The partial keys of the remaining entries are recomputed from their predecessors among the remaining entries.
+	//Two successive remaining entries are distinguished by the most significant bit in which their partial keys differ, which marks their lowest common BiNode.
+	//The partial key of the larger entry consists of this bit and those bits of its predecessor's recomputed partial key, which are more significant.
+	//Thereby, bits of BiNodes which only discriminated removed entries are dropped, even if the same bit is still used by other BiNodes of the node.
+	std::array<PartialKeyType, 32> remainingPartialKeys;
+	PartialKeyType relevantBits = 0u;
+
+	uint32_t previousEntryIndex = hot::commons::countTrailingZeros32(remainingEntriesMask);
+	uint32_t successiveEntriesMask = hot::commons::resetLowestSetBit32(remainingEntriesMask);
+	remainingPartialKeys[0] = 0u;
+	for(unsigned int targetIndex = 1u; targetIndex < newNumberEntries; ++targetIndex) {
+		uint32_t entryIndex = hot::commons::countTrailingZeros32(successiveEntriesMask);
+		PartialKeyType discriminativeBitMask = mDiscriminativeBitsRepresentation.getMostSignifikantMaskBit(
+			static_cast<PartialKeyType>(mPartialKeys.mEntries[previousEntryIndex] ^ mPartialKeys.mEntries[entryIndex])
+		);
+		uint32_t discriminativeBitPosition = mDiscriminativeBitsRepresentation.getLeastSignificantBitIndex(discriminativeBitMask);
+		PartialKeyType prefixBitsMask = mDiscriminativeBitsRepresentation.template getPrefixBitsMask<PartialKeyType>(hot::commons::DiscriminativeBit(discriminativeBitPosition));
+
+		remainingPartialKeys[targetIndex] = (remainingPartialKeys[targetIndex - 1u] & prefixBitsMask) | discriminativeBitMask;
+		relevantBits |= discriminativeBitMask;
+
+		previousEntryIndex = entryIndex;
+		successiveEntriesMask = hot::commons::resetLowestSetBit32(successiveEntriesMask);
+	}
+
+	HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType> const &self = *this;
+
+	return hot::commons::extractAndExecuteWithCorrectMaskAndDiscriminativeBitsRepresentation(mDiscriminativeBitsRepresentation, relevantBits,
+		[&](auto const &finalDiscriminativeBitsRepresentation, auto maximumMask) {
+			using FinalDiscriminativeBitsRepresentationType = typename std::remove_const<
+				typename std::remove_reference<decltype(finalDiscriminativeBitsRepresentation)>::type
+			>::type;
+
+			return (new(
+				newNumberEntries) HOTSingleThreadedNode<FinalDiscriminativeBitsRepresentationType, decltype(maximumMask)>(
+				self, newNumberEntries, finalDiscriminativeBitsRepresentation, relevantBits, remainingEntriesMask, remainingPartialKeys.data()
+			))->toChildPointer();
+		}
+	);
+};
+
 template<typename DiscriminativeBitsRepresentation, typename PartialKeyType>  inline HOTSingleThreadedChildPointer HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::removeAndAddEntry(
 	HOTSingleThreadedDeletionInformation const & deletionInformation, hot::commons::DiscriminativeBit const & keyInformation, HOTSingleThreadedChildPointer const & newValue
 ) const {
@@ -478,9 +660,9 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType>  in
 					))->toChildPointer();
 				}
 			)
-			: hot::commons::createTwoEntriesNode<HOTSingleThreadedChildPointer, HOTSingleThreadedNode>(hot::commons::BiNode<HOTSingleThreadedChildPointer>::createFromExistingAndNewEntry(
+			: createTwoEntriesNode(hot::commons::BiNode<HOTSingleThreadedChildPointer>::createFromExistingAndNewEntry(
 				keyInformation, getPointers()[1-deletionInformation.getIndexOfEntryToRemove()], newValue
-			))->toChildPointer();
+			));
 };
 
 
@@ -507,6 +689,21 @@ HOTSingleThreadedChildPointer HOTSingleThreadedNode<DiscriminativeBitsRepresenta
 	}
 }
 
+template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inline
+HOTSingleThreadedChildPointer HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::relocate() const {
+	hot::commons::NodeAllocationInformation const & allocationInformation = hot::commons::NodeAllocationInformations<HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>>::getAllocationInformation(getNumberEntries());
+	void* memory = HOTSingleThreadedNodeBase::getMemoryPool(mAllocatorId)->allocFresh(allocationInformation.mTotalSizeInBytes/sizeof(uint64_t));
+	HOTSingleThreadedSnapshotRegistry* snapshotRegistry = HOTSingleThreadedSnapshotRegistry::getActiveRegistry();
+	if(snapshotRegistry != nullptr) {
+		snapshotRegistry->recordCreation(reinterpret_cast<HOTSingleThreadedNodeBase const *>(memory));
+	}
+
+	std::memcpy(memory, this, allocationInformation.mTotalSizeInBytes);
+	HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>* relocatedNode = reinterpret_cast<HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>*>(memory);
+	relocatedNode->mFirstChildPointer = reinterpret_cast<HOTSingleThreadedChildPointer*>(reinterpret_cast<char*>(memory) + allocationInformation.mPointerOffset);
+	return relocatedNode->toChildPointer();
+}
+
 template<typename DiscriminativeBitsRepresentation, typename PartialKeyType>  inline
 HOTSingleThreadedChildPointer HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::compressEntriesAndAddOneEntryIntoNewNode(
 	uint32_t firstIndexInRange, uint16_t numberEntriesInRange, hot::commons::InsertInformation const & insertInformation, HOTSingleThreadedChildPointer const & newValue
@@ -532,7 +729,7 @@ HOTSingleThreadedChildPointer HOTSingleThreadedNode<DiscriminativeBitsRepresenta
 		});
 	} else {
 		hot::commons::BiNode<HOTSingleThreadedChildPointer> const & binaryNode = hot::commons::BiNode<HOTSingleThreadedChildPointer>::createFromExistingAndNewEntry(insertInformation.mKeyInformation, getPointers()[firstIndexInRange], newValue);
-		return hot::commons::createTwoEntriesNode<HOTSingleThreadedChildPointer, HOTSingleThreadedNode>(binaryNode)->toChildPointer();
+		return createTwoEntriesNode(binaryNode);
 	}
 }
 
@@ -546,13 +743,19 @@ uint16_t HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>
 	return mDiscriminativeBitsRepresentation.getLeastSignificantBitIndex(mask);
 }
 
+template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inline
+uint16_t HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::getSeparatingBitIndex(unsigned int entryIndex) const {
+	assert(entryIndex > 0 && entryIndex < getNumberEntries());
+	return mDiscriminativeBitsRepresentation.getLeastSignificantBitIndex(static_cast<uint32_t>(mPartialKeys.mEntries[entryIndex]));
+}
+
 template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inline hot::commons::BiNode<HOTSingleThreadedChildPointer> HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>::split(
 	hot::commons::InsertInformation const & insertInformation, HOTSingleThreadedChildPointer const & newValue
 ) const {
 	uint32_t largerEntries = getMaskForLargerEntries();
 	assert(largerEntries != 0);
 
-	uint32_t numberLargerEntries = _mm_popcnt_u32(largerEntries);
+	uint32_t numberLargerEntries = hot::commons::populationCount32(largerEntries);
 	uint32_t numberSmallerEntries = getNumberEntries() - numberLargerEntries;
 
 	assert(insertInformation.getNumberEntriesInAffectedSubtree() != getNumberEntries());
@@ -605,7 +808,7 @@ hot::commons::BiNodeInformation HOTSingleThreadedNode<DiscriminativeBitsRepresen
 	uint32_t affectedSubtreeMask = mPartialKeys.getAffectedSubtreeMask(prefixBitsMask, expectedPrefixBits) & mUsedEntriesMask;
 
 	uint32_t firstIndexInAffectedSubtree = affectedSubtreeMask == 0u ? 0u : __builtin_ctz(affectedSubtreeMask);
-	uint32_t numberEntriesInAffectedSubtree = _mm_popcnt_u32(affectedSubtreeMask);
+	uint32_t numberEntriesInAffectedSubtree = hot::commons::populationCount32(affectedSubtreeMask);
 
 	uint32_t numberEntriesInLeftSubtree = (numberEntriesInAffectedSubtree - discriminativeBitValueOfEntry) * discriminativeBitValueOfEntry + (1 - discriminativeBitValueOfEntry);
 	uint32_t numberEntriesInRightSubtree = numberEntriesInAffectedSubtree - numberEntriesInLeftSubtree;
@@ -632,10 +835,11 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> tem
 
 	uint32_t firstIndexOutOfRange = firstIndexInTarget + numberEntriesInRange;
 	uint32_t sourceIndex = firstIndexInSourceRange;
+	hot::commons::ParallelBitMask<uint32_t> const compression(compressionMask);
 
 	for(uint32_t targetIndex = firstIndexInTarget; targetIndex < firstIndexOutOfRange; ++targetIndex) {
 		targetPointers[targetIndex] = sourcePointers[sourceIndex];
-		targetMasks[targetIndex] = _pext_u32(sourceMasks[sourceIndex], compressionMask);
+		targetMasks[targetIndex] = compression.extractBits(sourceMasks[sourceIndex]);
 		++sourceIndex;
 	}
 }
@@ -653,7 +857,7 @@ typename HOTSingleThreadedNode<DiscriminativeBitsRepresentation, PartialKeyType>
 	SourcePartialKeyType compressionMask, hot::commons::DiscriminativeBit const & significantKeyInformation
 ) const
 {
-	uint32_t allIntermediateMaskBits = _pext_u32(compressionMask, compressionMask);
+	uint32_t allIntermediateMaskBits = hot::commons::extractBits32(compressionMask, compressionMask);
 	return getConversionInformation(allIntermediateMaskBits, significantKeyInformation);
 }
 
@@ -689,7 +893,7 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inl
 
 		uint32_t rangeMask = ((UINT32_MAX >> (32 - numberEntriesInRange))) << minEntryIndexInRange;
 		uint32_t upperEntriesMask = mPartialKeys.findMasksByPattern(mostSignificantMaskBitInRange) & rangeMask;
-		size_t minimumUpperRangeEntryIndex = __tzcnt_u32(upperEntriesMask);
+		size_t minimumUpperRangeEntryIndex = hot::commons::countTrailingZeros32(upperEntriesMask);
 		size_t numberEntriesInLowerHalf = minimumUpperRangeEntryIndex - minEntryIndexInRange;
 		size_t numberEntriesInUpperHalf = numberEntriesInRange - numberEntriesInLowerHalf;
 		collectEntryDepth(entryDepths, minEntryIndexInRange, numberEntriesInLowerHalf, currentDepth + 1, usedMaskBits);
@@ -729,8 +933,8 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inl
 
 		int significantBitValue = significantBitValueStack[stackIndex];
 		if(significantBitValue == -1) {
-			if(_mm_popcnt_u32(entriesMask) == 1) {
-				uint entryIndex = __tzcnt_u32(entriesMask);
+			if(hot::commons::populationCount32(entriesMask) == 1) {
+				uint entryIndex = hot::commons::countTrailingZeros32(entriesMask);
 				uint32_t entryMask = 1l << entryIndex;
 				if((entryMask & entriesVisitedMask) != 0) {
 					std::cout << "Mask for path [";
@@ -758,8 +962,8 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inl
 				uint parentStackIndex = stackIndex - 1;
 				uint32_t currentSubtreeMask = entriesMaskStack[stackIndex];
 				assert(currentSubtreeMask != 0);
-				unsigned int firstBitInRange = _tzcnt_u32(currentSubtreeMask);
-				PartialKeyType subTreeBits = mPartialKeys.getRelevantBitsForRange(firstBitInRange, _mm_popcnt_u32(currentSubtreeMask));
+				unsigned int firstBitInRange = hot::commons::countTrailingZeros32(currentSubtreeMask);
+				PartialKeyType subTreeBits = mPartialKeys.getRelevantBitsForRange(firstBitInRange, hot::commons::populationCount32(currentSubtreeMask));
 				mostSignificantBitStack[stackIndex] = mDiscriminativeBitsRepresentation.getMostSignifikantMaskBit(subTreeBits);
 				prefixStack[stackIndex] = prefixStack[parentStackIndex] + (significantBitValueStack[parentStackIndex] * mostSignificantBitStack[parentStackIndex]);
 				subtreeBitsUsedStack[stackIndex] = subTreeBits & ~(mostSignificantBitStack[stackIndex]);
@@ -825,7 +1029,7 @@ template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> inl
 	std::map<uint16_t, uint16_t> maskBitMapping;
 	for(uint16_t extractionBitIndex : mDiscriminativeBitsRepresentation.getDiscriminativeBits()) {
 		uint32_t singleBitMask = mDiscriminativeBitsRepresentation.getMaskFor({ extractionBitIndex, 1 });
-		uint maskBitPosition = __tzcnt_u32(singleBitMask);
+		uint maskBitPosition = hot::commons::countTrailingZeros32(singleBitMask);
 		maskBitMapping[extractionBitIndex] = maskBitPosition;
 	}
 	return maskBitMapping;
@@ -856,6 +1060,12 @@ template<typename LeftDiscriminativeBitsRepresentation, typename LeftPartialKeyT
 };
 
 
+inline HOTSingleThreadedChildPointer createTwoEntriesNode(hot::commons::BiNode<HOTSingleThreadedChildPointer> const & binaryNode) {
+	HOTSingleThreadedNode<hot::commons::SingleMaskPartialKeyMapping, uint8_t>* node = hot::commons::createTwoEntriesNode<HOTSingleThreadedChildPointer, HOTSingleThreadedNode>(binaryNode);
+	node->initializeSubtreeCounts();
+	return node->toChildPointer();
+}
+
 inline HOTSingleThreadedChildPointer mergeNodesAndRemoveEntryIfPossible(uint32_t rootDiscriminativeBitPosition, HOTSingleThreadedChildPointer const &left,
 												HOTSingleThreadedChildPointer const &right,
 												HOTSingleThreadedDeletionInformation const &deletionInformation,
@@ -885,6 +1095,6 @@ inline HOTSingleThreadedChildPointer mergeNodesAndRemoveEntryIfPossible(uint32_t
 		});
 }
 
-} }
+} } }
 
 #endif
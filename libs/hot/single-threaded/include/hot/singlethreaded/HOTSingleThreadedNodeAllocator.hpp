@@ -0,0 +1,406 @@
+#ifndef __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_NODE_ALLOCATOR__
+#define __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_NODE_ALLOCATOR__
+
+#include <cassert>
+#include <cstdint>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include <hot/commons/NodeMemory.hpp>
+
+#include "hot/singlethreaded/MemoryArena.hpp"
+#include "hot/singlethreaded/MemoryPool.hpp"
+#include "hot/singlethreaded/HOTSingleThreadedSubtreeCountPolicy.hpp"
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+static_assert(SubtreeCountPolicy::getSizeInBytes(hot::commons::MAXIMUM_NUMBER_NODE_ENTRIES) <= hot::commons::MAXIMUM_SUBTREE_COUNTS_SIZE_IN_BYTES, "the subtree counts must fit into the slots of the slab allocator");
+constexpr size_t MAXIMUM_NODE_SIZE_IN_LONGS = hot::commons::getMaximumNodeSizeInBytes(SubtreeCountPolicy::getSizeInBytes(hot::commons::MAXIMUM_NUMBER_NODE_ENTRIES)) / sizeof(uint64_t);
+static_assert(MAXIMUM_NODE_SIZE_IN_LONGS * sizeof(uint64_t) <= hot::commons::MAXIMUM_SLAB_NODE_SIZE_IN_BYTES, "each allocation of the memory pools must fit into the slots of the slab allocator");
+constexpr size_t NODE_MEMORY_POOL_ALIGNMENT = 64u;
+
+using NodeMemoryPool = MemoryPool<uint64_t, MAXIMUM_NODE_SIZE_IN_LONGS>;
+
+/**
+ * Identifies the memory pool a node was allocated from. Each node stores the identifier of its memory pool to return itself to this pool on deletion.
+ */
+using NodeAllocatorId = uint16_t;
+
+/**
+ * identifies the process wide memory pool, which is shared by all tries using the { @link GlobalNodeAllocatorPolicy }
+ */
+constexpr NodeAllocatorId GLOBAL_NODE_ALLOCATOR_ID = 0u;
+
+/**
+ * identifies the memory pool of the thread allocating or deleting a node
+ */
+constexpr NodeAllocatorId THREAD_LOCAL_NODE_ALLOCATOR_ID = 1u;
+
+constexpr size_t MAXIMUM_NUMBER_NODE_ALLOCATORS = static_cast<size_t>(UINT16_MAX) + 1u;
+
+/**
+ * The NodeAllocatorRegistry maps allocator identifiers to memory pools.
+ *
+ * Besides the global and the thread local memory pools, memory pools owned by individual trie instances can be registered.
+ * Registering and unregistering a memory pool is thread safe, while the memory pools themselves are not synchronized.
+ * Each thread furthermore has a current allocator, which is used to allocate new nodes.
+ * If no allocator was explicitly activated, nodes are allocated from the pool of the allocating thread.
+ */
+class NodeAllocatorRegistry {
+	using PoolSlots = std::array<std::atomic<NodeMemoryPool*>, MAXIMUM_NUMBER_NODE_ALLOCATORS>;
+
+public:
+	/**
+	 * @return the process wide memory pool. It is not synchronized and therefore must only be used by a single thread at a time.
+	 */
+	static inline NodeMemoryPool* getGlobalMemoryPool();
+
+	/**
+	 * @return the memory pool of the calling thread
+	 */
+	static inline NodeMemoryPool* getThreadLocalMemoryPool();
+
+	/**
+	 * @param allocatorId the identifier of a memory pool
+	 * @return the memory pool corresponding to the given identifier
+	 */
+	static inline NodeMemoryPool* getMemoryPool(NodeAllocatorId allocatorId);
+
+	/**
+	 * registers a memory pool and assigns it an unused identifier
+	 *
+	 * @param memoryPool the memory pool to register
+	 * @return the identifier assigned to the memory pool
+	 */
+	static inline NodeAllocatorId registerMemoryPool(NodeMemoryPool* memoryPool);
+
+	/**
+	 * releases the identifier of a previously registered memory pool. No node allocated from this pool may exist anymore.
+	 *
+	 * @param allocatorId the identifier of the memory pool to unregister
+	 */
+	static inline void unregisterMemoryPool(NodeAllocatorId allocatorId);
+
+	/**
+	 * @return the identifier of the allocator used by the calling thread to allocate new nodes
+	 */
+	static inline NodeAllocatorId getCurrentAllocatorId();
+
+	/**
+	 * @param allocatorId the identifier of the allocator the calling thread uses to allocate new nodes from now on
+	 * @return the identifier of the previously used allocator
+	 */
+	static inline NodeAllocatorId setCurrentAllocatorId(NodeAllocatorId allocatorId);
+
+private:
+	static inline PoolSlots & getPoolSlots();
+	static inline NodeAllocatorId & getCurrentAllocatorIdOfThread();
+};
+
+/**
+ * Activates an allocator for the calling thread for the lifetime of the scope object and restores the previously active allocator afterwards.
+ */
+class NodeAllocatorScope {
+	NodeAllocatorId const mPreviousAllocatorId;
+
+public:
+	inline explicit NodeAllocatorScope(NodeAllocatorId allocatorId);
+	NodeAllocatorScope(NodeAllocatorScope const & other) = delete;
+	NodeAllocatorScope& operator=(NodeAllocatorScope const & other) = delete;
+	inline ~NodeAllocatorScope();
+};
+
+/**
+ * Allocates all nodes from a single process wide memory pool. As this pool is not synchronized, all tries using this policy must only be modified by a single thread at a time.
+ * This corresponds to the original behaviour of HOTSingleThreaded.
+ *
+ * Each policy states whether the nodes of a trie may be allocated by multiple threads at once (ALLOWS_CONCURRENT_ALLOCATION),
+ * in which case a parallel bulk load allocates them from the thread local memory pools of the participating threads.
+ */
+struct GlobalNodeAllocatorPolicy {
+	static constexpr bool RELEASES_NODES_IN_BULK = false;
+	static constexpr bool ALLOWS_CONCURRENT_ALLOCATION = true;
+
+	inline NodeAllocatorId getAllocatorId() const;
+	inline NodeMemoryPool const * getMemoryPool() const;
+	inline void swap(GlobalNodeAllocatorPolicy & other);
+	template<typename ChildPointerType> inline void deleteAllNodes(ChildPointerType & root);
+};
+
+/**
+ * Allocates nodes from a memory pool owned by the modifying thread.
+ * Tries using this policy can be modified concurrently as long as each trie is only modified by a single thread at a time.
+ * Nodes deleted by a different thread than the one which allocated them are returned to the pool of the deleting thread.
+ */
+struct ThreadLocalNodeAllocatorPolicy {
+	static constexpr bool RELEASES_NODES_IN_BULK = false;
+	static constexpr bool ALLOWS_CONCURRENT_ALLOCATION = true;
+
+	inline NodeAllocatorId getAllocatorId() const;
+	inline NodeMemoryPool const * getMemoryPool() const;
+	inline void swap(ThreadLocalNodeAllocatorPolicy & other);
+	template<typename ChildPointerType> inline void deleteAllNodes(ChildPointerType & root);
+};
+
+/**
+ * Allocates nodes from a memory pool owned by the trie instance.
+ * Besides allowing to modify different tries concurrently without any synchronization, this allows to attribute memory allocations to individual tries.
+ * The memory pool is aligned to cache line boundaries to prevent false sharing between the free lists of different instances.
+ */
+class PerInstanceNodeAllocatorPolicy {
+	struct alignas(NODE_MEMORY_POOL_ALIGNMENT) RegisteredMemoryPool {
+		NodeMemoryPool mMemoryPool;
+		NodeAllocatorId const mAllocatorId;
+
+		inline RegisteredMemoryPool();
+		inline ~RegisteredMemoryPool();
+	};
+
+	std::unique_ptr<RegisteredMemoryPool> mRegisteredMemoryPool;
+
+public:
+	static constexpr bool RELEASES_NODES_IN_BULK = false;
+	static constexpr bool ALLOWS_CONCURRENT_ALLOCATION = false;
+
+	inline PerInstanceNodeAllocatorPolicy();
+
+	inline NodeAllocatorId getAllocatorId() const;
+	inline NodeMemoryPool const * getMemoryPool() const;
+	inline void swap(PerInstanceNodeAllocatorPolicy & other);
+	template<typename ChildPointerType> inline void deleteAllNodes(ChildPointerType & root);
+};
+
+/**
+ * Allocates all nodes of a trie from a private memory arena.
+ *
+ * Nodes replaced during modifications are reused by the trie itself, but never released individually.
+ * Instead, deleting all nodes of the trie releases the whole arena at once without traversing the trie.
+ * This makes tearing down or clearing large tries cheap, e.g. when index generations are rotated or rebuilt.
+ * As the arena is not synchronized, all nodes of such a trie are allocated by the modifying thread, including those created by a parallel bulk load.
+ */
+class ArenaNodeAllocatorPolicy {
+	struct alignas(NODE_MEMORY_POOL_ALIGNMENT) RegisteredArena {
+		MemoryArena mArena;
+		NodeMemoryPool mMemoryPool;
+		NodeAllocatorId const mAllocatorId;
+
+		inline RegisteredArena();
+		inline ~RegisteredArena();
+	};
+
+	std::unique_ptr<RegisteredArena> mRegisteredArena;
+
+public:
+	static constexpr bool RELEASES_NODES_IN_BULK = true;
+	static constexpr bool ALLOWS_CONCURRENT_ALLOCATION = false;
+
+	inline ArenaNodeAllocatorPolicy();
+
+	inline NodeAllocatorId getAllocatorId() const;
+	inline NodeMemoryPool const * getMemoryPool() const;
+	inline void swap(ArenaNodeAllocatorPolicy & other);
+
+	/**
+	 * releases the memory of all nodes allocated from the arena. No node of the trie may be accessed afterwards.
+	 *
+	 * @param root the root of the trie, which is not traversed
+	 */
+	template<typename ChildPointerType> inline void deleteAllNodes(ChildPointerType & root);
+
+	/**
+	 * @return the number of chunks currently allocated by the arena
+	 */
+	inline size_t getNumberArenaChunks() const;
+};
+
+/**
+ * Used by the read only tries of snapshots, which share their nodes with the trie the snapshot was taken from.
+ * Such a trie never allocates nodes and neither owns nor deletes the nodes it references.
+ */
+struct SnapshotNodeAllocatorPolicy {
+	static constexpr bool RELEASES_NODES_IN_BULK = false;
+	static constexpr bool ALLOWS_CONCURRENT_ALLOCATION = false;
+
+	inline NodeAllocatorId getAllocatorId() const;
+	inline NodeMemoryPool const * getMemoryPool() const;
+	inline void swap(SnapshotNodeAllocatorPolicy & other);
+	template<typename ChildPointerType> inline void deleteAllNodes(ChildPointerType & root);
+};
+
+inline NodeMemoryPool* NodeAllocatorRegistry::getGlobalMemoryPool() {
+	static NodeMemoryPool memoryPool {};
+	return &memoryPool;
+}
+
+inline NodeMemoryPool* NodeAllocatorRegistry::getThreadLocalMemoryPool() {
+	static thread_local NodeMemoryPool memoryPool {};
+	return &memoryPool;
+}
+
+inline NodeMemoryPool* NodeAllocatorRegistry::getMemoryPool(NodeAllocatorId allocatorId) {
+	switch(allocatorId) {
+		case GLOBAL_NODE_ALLOCATOR_ID:
+			return getGlobalMemoryPool();
+		case THREAD_LOCAL_NODE_ALLOCATOR_ID:
+			return getThreadLocalMemoryPool();
+		default:
+			NodeMemoryPool* memoryPool = getPoolSlots()[allocatorId].load(std::memory_order_acquire);
+			assert(memoryPool != nullptr);
+			return memoryPool;
+	}
+}
+
+inline NodeAllocatorId NodeAllocatorRegistry::registerMemoryPool(NodeMemoryPool* memoryPool) {
+	PoolSlots & poolSlots = getPoolSlots();
+	for(size_t allocatorId = THREAD_LOCAL_NODE_ALLOCATOR_ID + 1u; allocatorId < MAXIMUM_NUMBER_NODE_ALLOCATORS; ++allocatorId) {
+		NodeMemoryPool* expectedPool = nullptr;
+		if(poolSlots[allocatorId].load(std::memory_order_relaxed) == nullptr && poolSlots[allocatorId].compare_exchange_strong(expectedPool, memoryPool, std::memory_order_acq_rel)) {
+			return static_cast<NodeAllocatorId>(allocatorId);
+		}
+	}
+	//"All allocator identifiers are in use"
+	throw std::bad_alloc();
+}
+
+inline void NodeAllocatorRegistry::unregisterMemoryPool(NodeAllocatorId allocatorId) {
+	assert(allocatorId > THREAD_LOCAL_NODE_ALLOCATOR_ID);
+	getPoolSlots()[allocatorId].store(nullptr, std::memory_order_release);
+}
+
+inline NodeAllocatorId NodeAllocatorRegistry::getCurrentAllocatorId() {
+	return getCurrentAllocatorIdOfThread();
+}
+
+inline NodeAllocatorId NodeAllocatorRegistry::setCurrentAllocatorId(NodeAllocatorId allocatorId) {
+	NodeAllocatorId & currentAllocatorId = getCurrentAllocatorIdOfThread();
+	NodeAllocatorId previousAllocatorId = currentAllocatorId;
+	currentAllocatorId = allocatorId;
+	return previousAllocatorId;
+}
+
+inline NodeAllocatorRegistry::PoolSlots & NodeAllocatorRegistry::getPoolSlots() {
+	static PoolSlots poolSlots {};
+	return poolSlots;
+}
+
+inline NodeAllocatorId & NodeAllocatorRegistry::getCurrentAllocatorIdOfThread() {
+	static thread_local NodeAllocatorId currentAllocatorId = THREAD_LOCAL_NODE_ALLOCATOR_ID;
+	return currentAllocatorId;
+}
+
+inline NodeAllocatorScope::NodeAllocatorScope(NodeAllocatorId allocatorId) : mPreviousAllocatorId(NodeAllocatorRegistry::setCurrentAllocatorId(allocatorId)) {
+}
+
+inline NodeAllocatorScope::~NodeAllocatorScope() {
+	NodeAllocatorRegistry::setCurrentAllocatorId(mPreviousAllocatorId);
+}
+
+inline NodeAllocatorId GlobalNodeAllocatorPolicy::getAllocatorId() const {
+	return GLOBAL_NODE_ALLOCATOR_ID;
+}
+
+inline NodeMemoryPool const * GlobalNodeAllocatorPolicy::getMemoryPool() const {
+	return NodeAllocatorRegistry::getGlobalMemoryPool();
+}
+
+inline void GlobalNodeAllocatorPolicy::swap(GlobalNodeAllocatorPolicy & /* other */) {
+}
+
+template<typename ChildPointerType> inline void GlobalNodeAllocatorPolicy::deleteAllNodes(ChildPointerType & root) {
+	root.deleteSubtree();
+}
+
+inline NodeAllocatorId ThreadLocalNodeAllocatorPolicy::getAllocatorId() const {
+	return THREAD_LOCAL_NODE_ALLOCATOR_ID;
+}
+
+inline NodeMemoryPool const * ThreadLocalNodeAllocatorPolicy::getMemoryPool() const {
+	return NodeAllocatorRegistry::getThreadLocalMemoryPool();
+}
+
+inline void ThreadLocalNodeAllocatorPolicy::swap(ThreadLocalNodeAllocatorPolicy & /* other */) {
+}
+
+template<typename ChildPointerType> inline void ThreadLocalNodeAllocatorPolicy::deleteAllNodes(ChildPointerType & root) {
+	root.deleteSubtree();
+}
+
+inline PerInstanceNodeAllocatorPolicy::RegisteredMemoryPool::RegisteredMemoryPool() : mMemoryPool(), mAllocatorId(NodeAllocatorRegistry::registerMemoryPool(&mMemoryPool)) {
+}
+
+inline PerInstanceNodeAllocatorPolicy::RegisteredMemoryPool::~RegisteredMemoryPool() {
+	NodeAllocatorRegistry::unregisterMemoryPool(mAllocatorId);
+}
+
+inline PerInstanceNodeAllocatorPolicy::PerInstanceNodeAllocatorPolicy() : mRegisteredMemoryPool(new RegisteredMemoryPool()) {
+}
+
+inline NodeAllocatorId PerInstanceNodeAllocatorPolicy::getAllocatorId() const {
+	return mRegisteredMemoryPool->mAllocatorId;
+}
+
+inline NodeMemoryPool const * PerInstanceNodeAllocatorPolicy::getMemoryPool() const {
+	return &mRegisteredMemoryPool->mMemoryPool;
+}
+
+inline void PerInstanceNodeAllocatorPolicy::swap(PerInstanceNodeAllocatorPolicy & other) {
+	std::swap(mRegisteredMemoryPool, other.mRegisteredMemoryPool);
+}
+
+template<typename ChildPointerType> inline void PerInstanceNodeAllocatorPolicy::deleteAllNodes(ChildPointerType & root) {
+	root.deleteSubtree();
+}
+
+inline ArenaNodeAllocatorPolicy::RegisteredArena::RegisteredArena() : mArena(), mMemoryPool(&mArena), mAllocatorId(NodeAllocatorRegistry::registerMemoryPool(&mMemoryPool)) {
+}
+
+inline ArenaNodeAllocatorPolicy::RegisteredArena::~RegisteredArena() {
+	NodeAllocatorRegistry::unregisterMemoryPool(mAllocatorId);
+}
+
+inline ArenaNodeAllocatorPolicy::ArenaNodeAllocatorPolicy() : mRegisteredArena(new RegisteredArena()) {
+}
+
+inline NodeAllocatorId ArenaNodeAllocatorPolicy::getAllocatorId() const {
+	return mRegisteredArena->mAllocatorId;
+}
+
+inline NodeMemoryPool const * ArenaNodeAllocatorPolicy::getMemoryPool() const {
+	return &mRegisteredArena->mMemoryPool;
+}
+
+inline void ArenaNodeAllocatorPolicy::swap(ArenaNodeAllocatorPolicy & other) {
+	std::swap(mRegisteredArena, other.mRegisteredArena);
+}
+
+template<typename ChildPointerType> inline void ArenaNodeAllocatorPolicy::deleteAllNodes(ChildPointerType & /* root */) {
+	mRegisteredArena->mMemoryPool.discardFreeLists();
+	mRegisteredArena->mArena.releaseAll();
+}
+
+inline size_t ArenaNodeAllocatorPolicy::getNumberArenaChunks() const {
+	return mRegisteredArena->mArena.getNumberChunks();
+}
+
+inline NodeAllocatorId SnapshotNodeAllocatorPolicy::getAllocatorId() const {
+	return THREAD_LOCAL_NODE_ALLOCATOR_ID;
+}
+
+inline NodeMemoryPool const * SnapshotNodeAllocatorPolicy::getMemoryPool() const {
+	return NodeAllocatorRegistry::getThreadLocalMemoryPool();
+}
+
+inline void SnapshotNodeAllocatorPolicy::swap(SnapshotNodeAllocatorPolicy & /* other */) {
+}
+
+template<typename ChildPointerType> inline void SnapshotNodeAllocatorPolicy::deleteAllNodes(ChildPointerType & /* root */) {
+}
+
+} } }
+
+#endif
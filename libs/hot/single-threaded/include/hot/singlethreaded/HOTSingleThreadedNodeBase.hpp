@@ -7,21 +7,23 @@
 
 #include <hot/commons/NodeAllocationInformation.hpp>
 
-#include "hot/singlethreaded/MemoryPool.hpp"
+#include "hot/singlethreaded/HOTSingleThreadedNodeAllocator.hpp"
 #include "hot/singlethreaded/HOTSingleThreadedNodeBaseInterface.hpp"
 #include "hot/singlethreaded/HOTSingleThreadedChildPointerInterface.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
 constexpr uint32_t ALL_ENTRIES_USED = UINT32_MAX; //32 1 bits
 
-namespace hot { namespace singlethreaded {
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
-inline MemoryPool<uint64_t, MAXIMUM_NODE_SIZE_IN_LONGS>* HOTSingleThreadedNodeBase::getMemoryPool() {
-	static MemoryPool<uint64_t, MAXIMUM_NODE_SIZE_IN_LONGS> memoryPool {};
-	return &memoryPool;
+static_assert(sizeof(HOTSingleThreadedNodeBase) == 16u, "the allocator identifier must fit into the padding of the node header");
+
+inline NodeMemoryPool* HOTSingleThreadedNodeBase::getMemoryPool(NodeAllocatorId allocatorId) {
+	return NodeAllocatorRegistry::getMemoryPool(allocatorId);
 }
 
 HOTSingleThreadedNodeBase::HOTSingleThreadedNodeBase(uint16_t const level, hot::commons::NodeAllocationInformation const & nodeAllocationInformation)
-	: mFirstChildPointer(reinterpret_cast<HOTSingleThreadedChildPointer*>(reinterpret_cast<char*>(this) + nodeAllocationInformation.mPointerOffset)), mUsedEntriesMask(nodeAllocationInformation.mEntriesMask), mHeight(level) {
+	: mFirstChildPointer(reinterpret_cast<HOTSingleThreadedChildPointer*>(reinterpret_cast<char*>(this) + nodeAllocationInformation.mPointerOffset)), mUsedEntriesMask(nodeAllocationInformation.mEntriesMask), mHeight(level), mAllocatorId(NodeAllocatorRegistry::getCurrentAllocatorId()) {
 }
 
 inline __attribute__((always_inline)) size_t HOTSingleThreadedNodeBase::getNumberEntries() const {
@@ -47,8 +49,53 @@ inline __attribute__((always_inline)) unsigned int HOTSingleThreadedNodeBase::to
 	return hot::commons::getMostSignificantBitIndex(resultMaskForChildsOnly);
 }
 
+inline SubtreeCount* HOTSingleThreadedNodeBase::getSubtreeCountsEnd() {
+	return reinterpret_cast<SubtreeCount*>(mFirstChildPointer);
+}
+
+inline SubtreeCount const * HOTSingleThreadedNodeBase::getSubtreeCountsEnd() const {
+	return reinterpret_cast<SubtreeCount const *>(mFirstChildPointer);
+}
+
+inline size_t HOTSingleThreadedNodeBase::getNumberValuesInSubtreeOfEntry(size_t entryIndex) const {
+	assert(SubtreeCountPolicy::MAINTAINS_SUBTREE_COUNTS && entryIndex < getNumberEntries());
+	return *(getSubtreeCountsEnd() - (entryIndex + 1u));
+}
+
+inline size_t HOTSingleThreadedNodeBase::getNumberValuesBeforeEntry(size_t entryIndex) const {
+	assert(SubtreeCountPolicy::MAINTAINS_SUBTREE_COUNTS && entryIndex <= getNumberEntries());
+	//as the counts are stored in reverse order, the counts of the preceding entries are stored contiguously directly in front of the child pointers
+	SubtreeCount const * counts = getSubtreeCountsEnd() - entryIndex;
+	size_t numberValues = 0u;
+	for(size_t i = 0u; i < entryIndex; ++i) {
+		numberValues += counts[i];
+	}
+	return numberValues;
+}
+
+inline size_t HOTSingleThreadedNodeBase::getNumberValuesInSubtree() const {
+	return getNumberValuesBeforeEntry(getNumberEntries());
+}
+
+inline void HOTSingleThreadedNodeBase::updateSubtreeCount(size_t entryIndex) {
+	if(SubtreeCountPolicy::MAINTAINS_SUBTREE_COUNTS) {
+		size_t numberValues = getPointers()[entryIndex].getNumberValuesInSubtree();
+		assert(numberValues <= UINT32_MAX);
+		*(getSubtreeCountsEnd() - (entryIndex + 1u)) = static_cast<SubtreeCount>(numberValues);
+	}
+}
+
+inline void HOTSingleThreadedNodeBase::initializeSubtreeCounts() {
+	if(SubtreeCountPolicy::MAINTAINS_SUBTREE_COUNTS) {
+		size_t numberEntries = getNumberEntries();
+		for(size_t entryIndex = 0u; entryIndex < numberEntries; ++entryIndex) {
+			updateSubtreeCount(entryIndex);
+		}
+	}
+}
+
 inline size_t HOTSingleThreadedNodeBase::getNumberAllocations() {
-	return getMemoryPool()->getNumberAllocations();
+	return NodeAllocatorRegistry::getGlobalMemoryPool()->getNumberAllocations();
 }
 
 
@@ -80,6 +127,6 @@ inline typename  HOTSingleThreadedNodeBase::const_iterator HOTSingleThreadedNode
 	return getPointers() + getNumberEntries();
 }
 
-} }
+} } }
 
 #endif
@@ -8,12 +8,13 @@
 #include <hot/commons/NodeAllocationInformation.hpp>
 
 #include "hot/singlethreaded/HOTSingleThreadedChildPointerInterface.hpp"
-#include "hot/singlethreaded/MemoryPool.hpp"
+#include "hot/singlethreaded/HOTSingleThreadedNodeAllocator.hpp"
+#include "hot/singlethreaded/HOTSingleThreadedSubtreeCountPolicy.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace singlethreaded {
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 constexpr size_t SIMD_COB_TRIE_NODE_ALIGNMENT = 8;
-constexpr size_t MAXIMUM_NODE_SIZE_IN_LONGS = 60u;
 
 struct alignas(SIMD_COB_TRIE_NODE_ALIGNMENT) HOTSingleThreadedNodeBase {
 	using const_iterator = HOTSingleThreadedChildPointer const *;
@@ -46,8 +47,14 @@ public:
 	 */
 	uint16_t const mHeight;
 
+	/**
+	 * the identifier of the memory pool this node was allocated from and is returned to on deletion.
+	 * It occupies otherwise unused padding bytes and therefore does not increase the size of a node.
+	 */
+	NodeAllocatorId const mAllocatorId;
+
 protected:
-	inline static MemoryPool<uint64_t, MAXIMUM_NODE_SIZE_IN_LONGS>* getMemoryPool();
+	inline static NodeMemoryPool* getMemoryPool(NodeAllocatorId allocatorId);
 
 	inline HOTSingleThreadedNodeBase(uint16_t const level, hot::commons::NodeAllocationInformation const & allocationInformation);
 	inline void operator delete (void * rawMemory) = delete;
@@ -86,9 +93,19 @@ protected:
 	 */
 	inline unsigned int toResultIndex( uint32_t resultMask ) const;
 
+	/**
+	 * @return a pointer to the end of the subtree counts, which coincides with the first child pointer. The count of the entry with index i is stored at offset -(i + 1).
+	 */
+	inline SubtreeCount* getSubtreeCountsEnd();
+
+	/**
+	 * @return a pointer to the end of the subtree counts, which coincides with the first child pointer. The count of the entry with index i is stored at offset -(i + 1).
+	 */
+	inline SubtreeCount const * getSubtreeCountsEnd() const;
+
 public:
 	/**
-	 * @return the total number of allocations executed on the underlying memory pool
+	 * @return the total number of allocations executed on the process wide memory pool
 	 */
 	static inline size_t getNumberAllocations();
 
@@ -112,6 +129,44 @@ public:
 	 */
 	inline HOTSingleThreadedChildPointer const * getPointers() const;
 
+	/**
+	 * Determines the number of values stored in the subtree of a single entry.
+	 * This is only defined if subtree counts are maintained (see { @link SubtreeCountPolicy }).
+	 *
+	 * @param entryIndex the index of the entry
+	 * @return the number of values stored in the subtree of the given entry
+	 */
+	inline size_t getNumberValuesInSubtreeOfEntry(size_t entryIndex) const;
+
+	/**
+	 * Determines the number of values stored in the subtrees of all entries preceding the given entry.
+	 * This is only defined if subtree counts are maintained (see { @link SubtreeCountPolicy }).
+	 *
+	 * @param entryIndex the index of the entry. It may be equal to the number of entries to determine the number of values in the subtree of the whole node.
+	 * @return the number of values stored in the subtrees of the entries with an index smaller than entryIndex
+	 */
+	inline size_t getNumberValuesBeforeEntry(size_t entryIndex) const;
+
+	/**
+	 * @return the number of values stored in the subtree rooted at this node. This is only defined if subtree counts are maintained (see { @link SubtreeCountPolicy }).
+	 */
+	inline size_t getNumberValuesInSubtree() const;
+
+	/**
+	 * Recalculates the subtree count of a single entry from the subtree its child pointer references.
+	 * It has to be called whenever a child pointer is replaced or its subtree is modified after the node was constructed.
+	 * In case subtree counts are not maintained, this is a no-op.
+	 *
+	 * @param entryIndex the index of the entry to recalculate the subtree count for
+	 */
+	inline void updateSubtreeCount(size_t entryIndex);
+
+	/**
+	 * Recalculates the subtree counts of all entries from the subtrees their child pointers reference.
+	 * In case subtree counts are not maintained, this is a no-op.
+	 */
+	inline void initializeSubtreeCounts();
+
 	/**
 	 * @return an iterator pointing to the first entry stored in this node
 	 */
@@ -133,6 +188,6 @@ public:
 	inline const_iterator end() const;
 };
 
-} }
+} } }
 
 #endif
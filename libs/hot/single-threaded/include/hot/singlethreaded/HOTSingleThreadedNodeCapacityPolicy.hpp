@@ -0,0 +1,51 @@
+#ifndef __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_NODE_CAPACITY_POLICY__
+#define __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_NODE_CAPACITY_POLICY__
+
+#include <cstdint>
+
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+/**
+ * Allocates each node with exactly the space required for its entries.
+ * Every insert into a node therefore copies the node into a newly allocated node.
+ */
+struct ExactNodeCapacityPolicy {
+	/**
+	 * @param numberEntries the number of entries stored in a node
+	 * @return the number of entries the node has space for
+	 */
+	static constexpr uint16_t getCapacity(uint16_t const numberEntries) {
+		return numberEntries;
+	}
+};
+
+/**
+ * Allocates each node with spare entry slots by rounding its capacity up to 4, 8, 16 or 32 entries.
+ * An insert into a node whose capacity suffices for an additional entry and whose partial key representation remains unchanged is executed in place.
+ * This trades memory for fewer allocations and copies on insert heavy workloads.
+ */
+struct SlackNodeCapacityPolicy {
+	/**
+	 * @param numberEntries the number of entries stored in a node
+	 * @return the number of entries the node has space for
+	 */
+	static constexpr uint16_t getCapacity(uint16_t const numberEntries) {
+		return (numberEntries <= 4u) ? 4u : ((numberEntries <= 8u) ? 8u : ((numberEntries <= 16u) ? 16u : 32u));
+	}
+};
+
+/**
+ * The node capacity policy used by HOTSingleThreaded. Nodes are allocated with slack capacity if USE_NODE_SLACK_CAPACITY is defined.
+ * As the capacity determines the memory layout of the nodes, all translation units of a program must agree on this setting.
+ */
+#ifdef USE_NODE_SLACK_CAPACITY
+using NodeCapacityPolicy = SlackNodeCapacityPolicy;
+#else
+using NodeCapacityPolicy = ExactNodeCapacityPolicy;
+#endif
+
+} } }
+
+#endif
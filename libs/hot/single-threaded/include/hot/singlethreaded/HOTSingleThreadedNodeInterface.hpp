@@ -17,8 +17,9 @@
 
 #include "hot/singlethreaded/HOTSingleThreadedDeletionInformation.hpp"
 #include "hot/singlethreaded/HOTSingleThreadedNodeBaseInterface.hpp"
+#include <hot/commons/InstructionSet.hpp>
 
-namespace hot { namespace singlethreaded {
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 template<typename DiscriminativeBitsRepresentation, typename PartialKeyType> struct alignas(SIMD_COB_TRIE_NODE_ALIGNMENT) HOTSingleThreadedNode;
 
@@ -149,6 +150,27 @@ public:
 		HOTSingleThreadedDeletionInformation const & deletionInformation
 	);
 
+	/**
+	 * Constructs a new node consisting of a subset of the source node's entries
+	 *
+	 * @tparam SourceDiscriminativeBitsRepresentation the discriminative bits representation of the source node
+	 * @tparam SourcePartialKeyType the partial key type used to store partial keys in the source node
+	 * @param the source node
+	 * @param numberEntries the number of entries to store in the new node. this must be equal to the number of entries in the remaining entries mask
+	 * @param discriminativeBitsRepresentation the discriminative bits information, which is required to distinguish all entries which remain in the new node
+	 * @param compressionMask the compression mask which can be used to recode the remaining partial keys from the source representation to the representation for the new node
+	 * @param remainingEntriesMask a mask having the bits of the source node's entries to copy set
+	 * @param remainingPartialKeys the partial keys of the entries to copy in the source representation. They only contain the discriminative bits of BiNodes which still distinguish remaining entries.
+	 */
+	template<typename SourceDiscriminativeBitsRepresentation, typename SourcePartialKeyType> inline HOTSingleThreadedNode(
+		HOTSingleThreadedNode<SourceDiscriminativeBitsRepresentation, SourcePartialKeyType> const & sourceNode,
+		uint16_t const numberEntries,
+		DiscriminativeBitsRepresentation const & discriminativeBitsRepresentation,
+		SourcePartialKeyType compressionMask,
+		uint32_t remainingEntriesMask,
+		SourcePartialKeyType const * remainingPartialKeys
+	);
+
 	/**
 	 * Constructs a new node by simultaneously removing a single entry and adding a new entry
 	 *
@@ -200,10 +222,10 @@ public:
 	 * 	4. returns the result candidate at this location
 	 *
 	 *
-	 * @param keyBytes the key bytes of the search key
+	 * @param keyBytes the key bytes of the search key, which are either a pointer to the bytes of a fixed size key or a { @link idx::contenthelpers::KeyBytesView } of a variable length key
 	 * @return the result candidate
 	 */
-	inline HOTSingleThreadedChildPointer const * search(uint8_t const * keyBytes) const;
+	template<typename KeyBytesType> inline HOTSingleThreadedChildPointer const * search(KeyBytesType const & keyBytes) const;
 
 	/**
 	 * searches the node and returns a potential result candidate by:
@@ -216,10 +238,10 @@ public:
 	 * and the index of the result candidate. Both informations are required in HOT's insertion algorithm
 	 *
 	 * @param searchResultOut an outparameter for the additional result information
-	 * @param keyBytes the key bytes of the search key
+	 * @param keyBytes the key bytes of the search key, which are either a pointer to the bytes of a fixed size key or a { @link idx::contenthelpers::KeyBytesView } of a variable length key
 	 * @return the result candidate
 	 */
-	inline HOTSingleThreadedChildPointer* searchForInsert(hot::commons::SearchResultForInsert & searchResultOut, uint8_t const * keyBytes) const;
+	template<typename KeyBytesType> inline HOTSingleThreadedChildPointer* searchForInsert(hot::commons::SearchResultForInsert & searchResultOut, KeyBytesType const & keyBytes) const;
 
 	/**
 	 * Determines the information required to insert a new entry in the node.
@@ -256,6 +278,25 @@ public:
 		hot::commons::InsertInformation const & insertInformation, HOTSingleThreadedChildPointer const & newValue
 	) const;
 
+	/**
+	 * Inserts a new value into this node without allocating a new node.
+	 * This is only possible if the node was allocated with a spare entry slot (see { @link NodeCapacityPolicy })
+	 * and the new value does not require to change the node's discriminative bits representation type or partial key type.
+	 * In all other cases the node remains unchanged and { @link #addEntry } must be used instead.
+	 *
+	 * @param insertInformation the insertion information used to determine the insertion position and potential recoding information
+	 * @param newValue the new value to insert
+	 * @return whether the new value was inserted into this node
+	 */
+	inline bool tryToAddEntryInPlace(
+		hot::commons::InsertInformation const & insertInformation, HOTSingleThreadedChildPointer const & newValue
+	);
+
+	/**
+	 * @return whether an additional entry fits into the memory allocated for this node
+	 */
+	inline bool hasSpareCapacity() const;
+
 	/**
 	 * This method creats a copy of the existing node without the entry described by the deletion information
 	 *
@@ -264,6 +305,15 @@ public:
 	 */
 	inline HOTSingleThreadedChildPointer removeEntry(HOTSingleThreadedDeletionInformation const & deletionInformation) const;
 
+	/**
+	 * This method creates a copy of the existing node without all of the entries contained in the given mask.
+	 * In contrast to repeatedly calling { @link #removeEntry }, only a single new node is created regardless of the number of removed entries.
+	 *
+	 * @param removedEntriesMask a mask having the bits of the entries to remove set. At least one entry must remain.
+	 * @return the newly created node or the single remaining entry in case all but one entry are removed
+	 */
+	inline HOTSingleThreadedChildPointer removeEntries(uint32_t removedEntriesMask) const;
+
 	/**
 	 * This method creats a copy of the existing node with a single entry removed and an additional entry added.
 	 *
@@ -283,6 +333,15 @@ public:
 	 */
 	inline HOTSingleThreadedChildPointer compressEntries(uint32_t firstIndexInRange, uint16_t numberEntriesInRange) const;
 
+	/**
+	 * This method creates an identical copy of the current node in memory which is freshly allocated from the node's memory pool.
+	 * In contrast to nodes created by other operations, the copy never reuses the memory of previously deleted nodes.
+	 * Hence, nodes relocated one after the other are placed next to each other in case the memory pool is backed by an arena.
+	 *
+	 * @return the relocated node
+	 */
+	inline HOTSingleThreadedChildPointer relocate() const;
+
 	/**
 	 * This methods creates a new node from a range of the current node's entries and an additional new entry to insert
 	 *
@@ -304,6 +363,14 @@ public:
 	 */
 	inline uint16_t getLeastSignificantDiscriminativeBitForEntry(unsigned int entryIndex) const;
 
+	/**
+	 * Determines the index of the discriminative bit separating an entry from its preceding entry, which is the least significant bit set in the entry's sparse partial key.
+	 *
+	 * @param entryIndex the index of the entry, which must not be the first entry
+	 * @return the index of the most significant bit in which the keys of the entry differ from the keys of the preceding entry
+	 */
+	inline uint16_t getSeparatingBitIndex(unsigned int entryIndex) const;
+
 	/**
 	 * This method handles an overflow which would occure when inserting the new value into the current node.
 	 * Therefore, it combines an insert with a node split and returns a new BiNode pointing to the newly created nodes
@@ -368,6 +435,14 @@ private:
 
 	inline void addHighBitToMasksInRightHalf(uint32_t firstIndexInRightHalf);
 
+	inline bool addEntryInPlace(
+		DiscriminativeBitsRepresentation const & newDiscriminativeBitsRepresentation, hot::commons::InsertInformation const & insertInformation, HOTSingleThreadedChildPointer const & newValue
+	);
+
+	template<typename OtherDiscriminativeBitsRepresentation> inline bool addEntryInPlace(
+		OtherDiscriminativeBitsRepresentation const & newDiscriminativeBitsRepresentation, hot::commons::InsertInformation const & insertInformation, HOTSingleThreadedChildPointer const & newValue
+	);
+
 	template<typename SourceDiscriminativeBitsRepresentation, typename SourcePartialKeyType> inline PartialKeyConversionInformation getConversionInformation(
 		HOTSingleThreadedNode<SourceDiscriminativeBitsRepresentation, SourcePartialKeyType> const & sourceNode, hot::commons::DiscriminativeBit const & significantKeyInformation
 	) const;
@@ -431,12 +506,20 @@ private:
 
 };
 
+/**
+ * creates a node consisting of the two entries of a binary node and initializes its subtree counts
+ *
+ * @param binaryNode the binary node to create the node from
+ * @return a child pointer to the newly created node
+ */
+inline HOTSingleThreadedChildPointer createTwoEntriesNode(hot::commons::BiNode<HOTSingleThreadedChildPointer> const & binaryNode);
+
 inline HOTSingleThreadedChildPointer mergeNodesAndRemoveEntryIfPossible(uint32_t rootDiscriminativeBitPosition, HOTSingleThreadedChildPointer const &left, HOTSingleThreadedChildPointer const &right, HOTSingleThreadedDeletionInformation const &deletionInformation, bool entryToDeleteIsInRightSide);
 template<typename LeftDiscriminativeBitsRepresentation, typename LeftPartialKeyType, typename RightDiscriminativeBitsRepresentation, typename RightPartialKeyType> inline HOTSingleThreadedChildPointer mergeNodesAndRemoveEntry(
 	hot::commons::NodeMergeInformation const & mergeInformation, HOTSingleThreadedNode<LeftDiscriminativeBitsRepresentation, LeftPartialKeyType> const & left, HOTSingleThreadedNode<RightDiscriminativeBitsRepresentation, RightPartialKeyType> const & right, HOTSingleThreadedDeletionInformation const & deletionInformation, bool entryToDeleteIsInRightSide
 );
 
 
-} }
+} } }
 
 #endif
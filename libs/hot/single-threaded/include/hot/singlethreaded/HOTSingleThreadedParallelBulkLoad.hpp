@@ -0,0 +1,111 @@
+#ifndef __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_PARALLEL_BULK_LOAD__
+#define __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_PARALLEL_BULK_LOAD__
+
+/**
+ * Defines { @link bulkLoadParallel }, which loads a sorted sequence of values into a { @link HOTSingleThreaded } using multiple threads.
+ * As the parallel bulk load is executed by TBB tasks, it is kept separate from the remaining trie,
+ * such that only users of the parallel bulk load include this header and link against TBB (see the hot-single-threaded-parallel-lib target).
+ */
+
+#include <cstdint>
+
+#include <iterator>
+#include <utility>
+
+#include <hot/commons/DiscriminativeBit.hpp>
+#include <hot/commons/ParallelBulkLoader.hpp>
+
+#include "hot/singlethreaded/HOTSingleThreaded.hpp"
+
+#include "idx/contenthelpers/KeyUtilities.hpp"
+#include "idx/contenthelpers/TidConverters.hpp"
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+/**
+ * Executes { @link bulkLoadParallel } on the internals of a trie, which is declared as friend of { @link HOTSingleThreaded }.
+ *
+ * @tparam TrieType the type of the trie to load the values into
+ */
+template<typename TrieType> struct HOTSingleThreadedParallelBulkLoader;
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> struct HOTSingleThreadedParallelBulkLoader<HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>> {
+	using TrieType = HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>;
+	using KeyType = typename TrieType::KeyType;
+
+	template<typename RandomAccessIterator> static inline size_t load(TrieType & trie, RandomAccessIterator begin, RandomAccessIterator end);
+};
+
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy> template<typename RandomAccessIterator>
+inline size_t HOTSingleThreadedParallelBulkLoader<HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>>::load(TrieType & trie, RandomAccessIterator begin, RandomAccessIterator end) {
+	for(RandomAccessIterator current = begin; current != end; ++current) {
+		idx::contenthelpers::checkKey(TrieType::extractKey(*current));
+	}
+	if(!trie.isEmpty()) {
+		size_t numberInsertedValues = 0u;
+		for(RandomAccessIterator current = begin; current != end; ++current) {
+			numberInsertedValues += trie.insert(*current);
+		}
+		return numberInsertedValues;
+	}
+
+	if(!NodeAllocatorPolicy::ALLOWS_CONCURRENT_ALLOCATION || (trie.mSnapshotRegistry && trie.mSnapshotRegistry->hasLiveSnapshots())) {
+		//all nodes must be allocated from the memory pool or the arena owned by this trie, which cannot be shared between threads.
+		//While snapshots are live, the creation of each node must be recorded by the modifying thread.
+		return trie.bulkLoad(begin, end);
+	}
+
+	//nodes are allocated by multiple threads, hence each thread allocates from its own memory pool
+	NodeAllocatorScope allocatorScope { THREAD_LOCAL_NODE_ALLOCATOR_ID };
+	std::pair<HOTSingleThreadedChildPointer, size_t> loadResult = hot::commons::parallelBulkLoad<HOTSingleThreadedChildPointer, HOTSingleThreadedNode>(
+		static_cast<size_t>(std::distance(begin, end)),
+		[&](size_t index) {
+			auto const & fixedSizeKey = idx::contenthelpers::toByteComparableKey(TrieType::extractKey(begin[index]));
+			auto const & nextFixedSizeKey = idx::contenthelpers::toByteComparableKey(TrieType::extractKey(begin[index + 1]));
+			uint16_t separatingBitIndex = hot::commons::NO_SEPARATING_BIT_INDEX;
+			hot::commons::executeForDiffingKeys(
+				idx::contenthelpers::interpretAsByteArray(fixedSizeKey), idx::contenthelpers::interpretAsByteArray(nextFixedSizeKey), idx::contenthelpers::getMaxKeyLength<KeyType>(),
+				[&](hot::commons::DiscriminativeBit const & separatingBit) {
+					separatingBitIndex = separatingBit.mValue ? separatingBit.mAbsoluteBitIndex : hot::commons::DESCENDING_KEYS_SEPARATING_BIT_INDEX;
+				}
+			);
+			return separatingBitIndex;
+		},
+		[&](size_t index) {
+			return HOTSingleThreadedChildPointer(idx::contenthelpers::valueToTid(begin[index]));
+		}
+	);
+	trie.mRoot = loadResult.first;
+	trie.initializeSubtreeCountsBottomUp(trie.mRoot);
+	return loadResult.second;
+}
+
+/**
+ * Loads a sequence of values, which is sorted in ascending key order, into an empty index using multiple threads.
+ *
+ * The sequence is recursively partitioned at the most significant bit separating any two adjacent keys of a partition.
+ * Each partition is loaded by a separate TBB task and the roots of the resulting subtries are stitched together into the top levels of the trie.
+ * The number of threads used is bounded by the concurrency of the calling thread's task arena.
+ * In case the node allocator policy allows concurrent allocations (see { @link GlobalNodeAllocatorPolicy }), the nodes are allocated from the thread local memory pools of the participating threads.
+ * Policies owning a private memory pool or arena, as well as tries with live snapshots, load the values sequentially by { @link HOTSingleThreaded#bulkLoad(Iterator, Iterator) }.
+ * The resulting trie is equivalent to a trie constructed by { @link HOTSingleThreaded#bulkLoad(Iterator, Iterator) }.
+ * Values with a key equal to the key of their predecessor are not loaded.
+ * In case the index is not empty, the values are inserted one by one using { @link HOTSingleThreaded#insert(ValueType const &) }.
+ *
+ * @tparam RandomAccessIterator a random access iterator whose value type is ValueType
+ * @param trie the index to load the values into
+ * @param begin an iterator to the value with the smallest key
+ * @param end the iterator marking the end of the sequence of values
+ * @return the number of values loaded into the index
+ * @throws std::length_error if any key is longer than the maximum key length (see { @link idx::contenthelpers::isSupportedKeyLength }). In this case no value is loaded.
+ * @throws std::invalid_argument if any key is a length delimited key ending with a zero byte (see { @link idx::contenthelpers::isDistinguishableKey }) or if the index is empty and the keys are not in ascending order. In this case no value is loaded.
+ */
+template<typename ValueType, template <typename> typename KeyExtractor, typename NodeAllocatorPolicy, typename RandomAccessIterator>
+inline size_t bulkLoadParallel(HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy> & trie, RandomAccessIterator begin, RandomAccessIterator end) {
+	return HOTSingleThreadedParallelBulkLoader<HOTSingleThreaded<ValueType, KeyExtractor, NodeAllocatorPolicy>>::load(trie, begin, end);
+}
+
+} } }
+
+#endif
@@ -0,0 +1,187 @@
+#ifndef __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_SNAPSHOT__
+#define __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_SNAPSHOT__
+
+#include <cstdint>
+#include <memory>
+
+#include "hot/singlethreaded/HOTSingleThreadedInterface.hpp"
+#include "hot/singlethreaded/HOTSingleThreadedNodeAllocator.hpp"
+#include "hot/singlethreaded/HOTSingleThreadedSnapshotRegistry.hpp"
+#include "hot/commons/InstructionSet.hpp"
+
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+/**
+ * A read only handle to the state of a HOTSingleThreaded instance at the time the snapshot was taken (see { @link HOTSingleThreaded#snapshot() }).
+ *
+ * The snapshot references the root of the trie at this point in time and shares all nodes with it. As long as the snapshot is live, the trie
+ * does not modify or free any of these nodes. Releasing the snapshot, by destroying the handle, allows the trie to free the nodes replaced since the snapshot was taken.
+ * A snapshot can be read and released by any thread, also concurrently to modifications of the trie it was taken from. It must be released before this trie is destroyed.
+ *
+ * @tparam ValueType the value type of the trie the snapshot was taken from
+ * @tparam KeyExtractor the key extractor of the trie the snapshot was taken from
+ */
+template<typename ValueType, template <typename> typename KeyExtractor> class HOTSingleThreadedSnapshot {
+public:
+	using TrieType = HOTSingleThreaded<ValueType, KeyExtractor, SnapshotNodeAllocatorPolicy>;
+	using KeyType = typename TrieType::KeyType;
+	using const_iterator = typename TrieType::const_iterator;
+	using const_reverse_iterator = typename TrieType::const_reverse_iterator;
+
+private:
+	std::shared_ptr<HOTSingleThreadedSnapshotRegistry> mSnapshotRegistry;
+	uint64_t mVersion;
+	TrieType mTrie;
+
+public:
+	/**
+	 * creates a handle for an already acquired snapshot
+	 *
+	 * @param snapshotRegistry the registry of the trie the snapshot was taken from
+	 * @param version the version of the snapshot acquired from the registry
+	 * @param root the root of the trie at the time the snapshot was taken
+	 */
+	inline HOTSingleThreadedSnapshot(std::shared_ptr<HOTSingleThreadedSnapshotRegistry> const & snapshotRegistry, uint64_t version, HOTSingleThreadedChildPointer const & root);
+	HOTSingleThreadedSnapshot(HOTSingleThreadedSnapshot const & other) = delete;
+	inline HOTSingleThreadedSnapshot(HOTSingleThreadedSnapshot && other);
+
+	HOTSingleThreadedSnapshot& operator=(HOTSingleThreadedSnapshot const & other) = delete;
+	inline HOTSingleThreadedSnapshot& operator=(HOTSingleThreadedSnapshot && other);
+
+	/**
+	 * releases the snapshot
+	 */
+	inline ~HOTSingleThreadedSnapshot();
+
+	inline bool isEmpty() const;
+
+	/**
+	 * For a given key it looks up the value stored at the time the snapshot was taken
+	 *
+	 * @param key the key to lookup
+	 * @return the looked up value. The result is valid, if a matching record was found.
+	 */
+	inline idx::contenthelpers::OptionalValue<ValueType> lookup(KeyType const & key) const;
+
+	/**
+	 * @return an iterator to the first value according to the key order.
+	 */
+	inline const_iterator begin() const;
+
+	/**
+	 * @return an iterator which is positioned after the last element.
+	 */
+	inline const_iterator end() const;
+
+	/**
+	 * @return a reverse iterator to the last value according to the key order
+	 */
+	inline const_reverse_iterator rbegin() const;
+
+	/**
+	 * @return the reverse iterator which is positioned before the first element
+	 */
+	inline const_reverse_iterator rend() const;
+
+	/**
+	 * @param searchKey the key to search for
+	 * @return an iterator to the value with the given key or the end iterator if no such value exists
+	 */
+	inline const_iterator find(KeyType const & searchKey) const;
+
+	/**
+	 * @param searchKey the key to search for
+	 * @return an iterator to the first value whose key is not smaller than the search key
+	 */
+	inline const_iterator lower_bound(KeyType const & searchKey) const;
+
+	/**
+	 * @param searchKey the key to search for
+	 * @return an iterator to the first value whose key is larger than the search key
+	 */
+	inline const_iterator upper_bound(KeyType const & searchKey) const;
+
+	/**
+	 * @return a read only trie referencing the nodes of the snapshot, which provides all other read only operations of HOTSingleThreaded
+	 */
+	inline TrieType const & getTrie() const;
+
+private:
+	inline void release();
+};
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::HOTSingleThreadedSnapshot(
+	std::shared_ptr<HOTSingleThreadedSnapshotRegistry> const & snapshotRegistry, uint64_t version, HOTSingleThreadedChildPointer const & root
+) : mSnapshotRegistry(snapshotRegistry), mVersion(version), mTrie() {
+	mTrie.mRoot = root;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::HOTSingleThreadedSnapshot(HOTSingleThreadedSnapshot && other)
+	: mSnapshotRegistry(std::move(other.mSnapshotRegistry)), mVersion(other.mVersion), mTrie(std::move(other.mTrie)) {
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline HOTSingleThreadedSnapshot<ValueType, KeyExtractor> & HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::operator=(HOTSingleThreadedSnapshot && other) {
+	if(this != &other) {
+		release();
+		mSnapshotRegistry = std::move(other.mSnapshotRegistry);
+		mVersion = other.mVersion;
+		mTrie = std::move(other.mTrie);
+	}
+	return *this;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::~HOTSingleThreadedSnapshot() {
+	release();
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline bool HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::isEmpty() const {
+	return mTrie.isEmpty();
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline idx::contenthelpers::OptionalValue<ValueType> HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::lookup(KeyType const & key) const {
+	return mTrie.lookup(key);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::const_iterator HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::begin() const {
+	return mTrie.begin();
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::const_iterator HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::end() const {
+	return mTrie.end();
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::const_reverse_iterator HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::rbegin() const {
+	return mTrie.rbegin();
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::const_reverse_iterator HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::rend() const {
+	return mTrie.rend();
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::const_iterator HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::find(KeyType const & searchKey) const {
+	return mTrie.find(searchKey);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::const_iterator HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::lower_bound(KeyType const & searchKey) const {
+	return mTrie.lower_bound(searchKey);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::const_iterator HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::upper_bound(KeyType const & searchKey) const {
+	return mTrie.upper_bound(searchKey);
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline typename HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::TrieType const & HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::getTrie() const {
+	return mTrie;
+}
+
+template<typename ValueType, template <typename> typename KeyExtractor> inline void HOTSingleThreadedSnapshot<ValueType, KeyExtractor>::release() {
+	//a moved from handle no longer references its snapshot
+	if(mSnapshotRegistry) {
+		mSnapshotRegistry->releaseSnapshot(mVersion);
+		mSnapshotRegistry.reset();
+	}
+}
+
+} } }
+
+#endif
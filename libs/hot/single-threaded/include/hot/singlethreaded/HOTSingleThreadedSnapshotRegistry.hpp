@@ -0,0 +1,265 @@
+#ifndef __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_SNAPSHOT_REGISTRY__
+#define __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_SNAPSHOT_REGISTRY__
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "hot/singlethreaded/HOTSingleThreadedChildPointerInterface.hpp"
+#include "hot/commons/InstructionSet.hpp"
+
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+class HOTSingleThreadedNodeBase;
+
+/**
+ * Keeps track of the live snapshots of a single HOTSingleThreaded instance and of the nodes which are still reachable from them.
+ *
+ * The modifications of a trie are grouped into versions. Taking a snapshot ends the current version, hence all nodes created up to this point are shared with the snapshot.
+ * Shared nodes must neither be modified in place nor be freed by the modifying thread. Instead they are copied before being modified and retired instead of being freed.
+ * A retired node is freed as soon as no live snapshot remains, which was taken between the creation and the retirement of the node.
+ *
+ * The version a node was created in is only recorded while snapshots are live and it is forgotten once no live snapshot is older than the node.
+ * Hence, the memory overhead is proportional to the number of nodes changed since the oldest live snapshot was taken.
+ * Snapshots can be released by any thread, while all other operations must be executed by the thread modifying the trie. Retired nodes are therefore only freed by the modifying thread.
+ */
+class HOTSingleThreadedSnapshotRegistry {
+	struct RetiredNode {
+		HOTSingleThreadedChildPointer mNode;
+		uint64_t mCreationVersion;
+		uint64_t mRetirementVersion;
+	};
+
+	std::mutex mLiveSnapshotsMutex;
+	//maps the version of each live snapshot to the number of snapshots taken in this version
+	std::map<uint64_t, size_t> mLiveSnapshots;
+	std::atomic<bool> mHasReleasedSnapshots;
+
+	uint64_t mCurrentVersion;
+	//the versions of the oldest and the latest live snapshot as seen by the modifying thread. Zero in case no snapshot is live.
+	uint64_t mOldestLiveSnapshotVersion;
+	uint64_t mLatestLiveSnapshotVersion;
+	//nodes which are not contained were created before the oldest live snapshot was taken
+	std::unordered_map<HOTSingleThreadedNodeBase const *, uint64_t> mCreationVersions;
+	std::vector<RetiredNode> mRetiredNodes;
+
+public:
+	inline HOTSingleThreadedSnapshotRegistry();
+	HOTSingleThreadedSnapshotRegistry(HOTSingleThreadedSnapshotRegistry const & other) = delete;
+	HOTSingleThreadedSnapshotRegistry& operator=(HOTSingleThreadedSnapshotRegistry const & other) = delete;
+	inline ~HOTSingleThreadedSnapshotRegistry();
+
+	/**
+	 * registers a new snapshot of the current state of the trie and ends the current version.
+	 *
+	 * @return the version of the snapshot, which must be passed to { @link #releaseSnapshot(uint64_t) } once the snapshot is no longer used
+	 */
+	inline uint64_t acquireSnapshot();
+
+	/**
+	 * releases a snapshot. This may be called by any thread. Nodes which are no longer reachable are freed by the next modification of the trie.
+	 *
+	 * @param version the version of the released snapshot
+	 */
+	inline void releaseSnapshot(uint64_t version);
+
+	/**
+	 * @return whether a snapshot was live when the modifying thread last reclaimed retired nodes
+	 */
+	inline bool hasLiveSnapshots() const;
+
+	/**
+	 * @param node the node to check
+	 * @return whether the node might be reachable from a live snapshot and therefore must not be modified
+	 */
+	inline bool isShared(HOTSingleThreadedNodeBase const * node) const;
+
+	/**
+	 * records that a node was created in the current version
+	 *
+	 * @param node the created node
+	 */
+	inline void recordCreation(HOTSingleThreadedNodeBase const * node);
+
+	/**
+	 * Retires a node which is removed from the trie in case it is shared with a live snapshot.
+	 *
+	 * @param node the node which is removed from the trie
+	 * @return whether the node was retired. Otherwise it is not reachable from any snapshot and must be freed by the caller.
+	 */
+	inline bool retireIfShared(HOTSingleThreadedChildPointer const & node);
+
+	/**
+	 * In case snapshots were released since the last call, frees all retired nodes, which are no longer reachable from a live snapshot.
+	 */
+	inline void reclaimRetiredNodes();
+
+	/**
+	 * @return the number of retired nodes, which are not yet freed
+	 */
+	inline size_t getNumberRetiredNodes() const;
+
+	/**
+	 * @return the registry of the trie the calling thread currently modifies or nullptr if no snapshot of this trie was ever taken
+	 */
+	static inline HOTSingleThreadedSnapshotRegistry* getActiveRegistry();
+
+private:
+	friend class SnapshotRegistryScope;
+
+	static inline HOTSingleThreadedSnapshotRegistry* & getActiveRegistryOfThread();
+
+	inline uint64_t getCreationVersion(HOTSingleThreadedNodeBase const * node) const;
+};
+
+/**
+ * Activates the snapshot registry of the trie modified by the calling thread for the lifetime of the scope object and restores the previously active registry afterwards.
+ * While a registry is active, nodes created by the calling thread are recorded and nodes freed by the calling thread are retired in case they are shared with a live snapshot.
+ */
+class SnapshotRegistryScope {
+	HOTSingleThreadedSnapshotRegistry* const mPreviousRegistry;
+
+public:
+	inline explicit SnapshotRegistryScope(HOTSingleThreadedSnapshotRegistry* registry);
+	SnapshotRegistryScope(SnapshotRegistryScope const & other) = delete;
+	SnapshotRegistryScope& operator=(SnapshotRegistryScope const & other) = delete;
+	inline ~SnapshotRegistryScope();
+};
+
+inline HOTSingleThreadedSnapshotRegistry::HOTSingleThreadedSnapshotRegistry()
+	: mLiveSnapshotsMutex(), mLiveSnapshots(), mHasReleasedSnapshots(false), mCurrentVersion(1u), mOldestLiveSnapshotVersion(0u), mLatestLiveSnapshotVersion(0u), mCreationVersions(), mRetiredNodes() {
+}
+
+inline HOTSingleThreadedSnapshotRegistry::~HOTSingleThreadedSnapshotRegistry() {
+	//all snapshots must be released and the retired nodes reclaimed before the trie is destroyed
+	assert(mRetiredNodes.empty());
+}
+
+inline uint64_t HOTSingleThreadedSnapshotRegistry::acquireSnapshot() {
+	uint64_t version = mCurrentVersion;
+	{
+		std::lock_guard<std::mutex> lock { mLiveSnapshotsMutex };
+		++mLiveSnapshots[version];
+	}
+	if(mOldestLiveSnapshotVersion == 0u) {
+		mOldestLiveSnapshotVersion = version;
+	}
+	mLatestLiveSnapshotVersion = version;
+	++mCurrentVersion;
+	return version;
+}
+
+inline void HOTSingleThreadedSnapshotRegistry::releaseSnapshot(uint64_t version) {
+	std::lock_guard<std::mutex> lock { mLiveSnapshotsMutex };
+	auto liveSnapshot = mLiveSnapshots.find(version);
+	assert(liveSnapshot != mLiveSnapshots.end());
+	if(--liveSnapshot->second == 0u) {
+		mLiveSnapshots.erase(liveSnapshot);
+	}
+	mHasReleasedSnapshots.store(true, std::memory_order_release);
+}
+
+inline bool HOTSingleThreadedSnapshotRegistry::hasLiveSnapshots() const {
+	return mLatestLiveSnapshotVersion != 0u;
+}
+
+inline bool HOTSingleThreadedSnapshotRegistry::isShared(HOTSingleThreadedNodeBase const * node) const {
+	return hasLiveSnapshots() && getCreationVersion(node) <= mLatestLiveSnapshotVersion;
+}
+
+inline void HOTSingleThreadedSnapshotRegistry::recordCreation(HOTSingleThreadedNodeBase const * node) {
+	if(hasLiveSnapshots()) {
+		mCreationVersions[node] = mCurrentVersion;
+	}
+}
+
+inline bool HOTSingleThreadedSnapshotRegistry::retireIfShared(HOTSingleThreadedChildPointer const & node) {
+	//without live snapshots no creation versions are recorded
+	if(!hasLiveSnapshots()) {
+		return false;
+	}
+
+	HOTSingleThreadedNodeBase const * nodeBase = node.getNode();
+	uint64_t creationVersion = getCreationVersion(nodeBase);
+	mCreationVersions.erase(nodeBase);
+
+	//a node is reachable from all snapshots taken after its creation and before its retirement
+	bool isRetired = creationVersion <= mLatestLiveSnapshotVersion;
+	if(isRetired) {
+		mRetiredNodes.push_back({ node, creationVersion, mCurrentVersion });
+	}
+	return isRetired;
+}
+
+inline void HOTSingleThreadedSnapshotRegistry::reclaimRetiredNodes() {
+	if(!mHasReleasedSnapshots.exchange(false, std::memory_order_acq_rel)) {
+		return;
+	}
+
+	std::vector<HOTSingleThreadedChildPointer> unreachableNodes;
+	{
+		std::lock_guard<std::mutex> lock { mLiveSnapshotsMutex };
+		mOldestLiveSnapshotVersion = mLiveSnapshots.empty() ? 0u : mLiveSnapshots.begin()->first;
+		mLatestLiveSnapshotVersion = mLiveSnapshots.empty() ? 0u : mLiveSnapshots.rbegin()->first;
+
+		size_t numberRemainingNodes = 0u;
+		for(RetiredNode const & retiredNode : mRetiredNodes) {
+			auto oldestReachingSnapshot = mLiveSnapshots.lower_bound(retiredNode.mCreationVersion);
+			if(oldestReachingSnapshot != mLiveSnapshots.end() && oldestReachingSnapshot->first < retiredNode.mRetirementVersion) {
+				mRetiredNodes[numberRemainingNodes++] = retiredNode;
+			} else {
+				unreachableNodes.push_back(retiredNode.mNode);
+			}
+		}
+		mRetiredNodes.resize(numberRemainingNodes);
+	}
+
+	//the creation version of nodes created before the oldest live snapshot does not influence whether they are shared or reachable anymore
+	if(mOldestLiveSnapshotVersion == 0u) {
+		mCreationVersions.clear();
+	} else {
+		for(auto creationVersion = mCreationVersions.begin(); creationVersion != mCreationVersions.end();) {
+			creationVersion = (creationVersion->second <= mOldestLiveSnapshotVersion) ? mCreationVersions.erase(creationVersion) : std::next(creationVersion);
+		}
+	}
+
+	//the unreachable nodes are freed directly instead of being checked again
+	SnapshotRegistryScope withoutRegistry { nullptr };
+	for(HOTSingleThreadedChildPointer const & unreachableNode : unreachableNodes) {
+		unreachableNode.free();
+	}
+}
+
+inline size_t HOTSingleThreadedSnapshotRegistry::getNumberRetiredNodes() const {
+	return mRetiredNodes.size();
+}
+
+inline HOTSingleThreadedSnapshotRegistry* HOTSingleThreadedSnapshotRegistry::getActiveRegistry() {
+	return getActiveRegistryOfThread();
+}
+
+inline HOTSingleThreadedSnapshotRegistry* & HOTSingleThreadedSnapshotRegistry::getActiveRegistryOfThread() {
+	static thread_local HOTSingleThreadedSnapshotRegistry* activeRegistry = nullptr;
+	return activeRegistry;
+}
+
+inline uint64_t HOTSingleThreadedSnapshotRegistry::getCreationVersion(HOTSingleThreadedNodeBase const * node) const {
+	auto creationVersion = mCreationVersions.find(node);
+	return (creationVersion == mCreationVersions.end()) ? 0u : creationVersion->second;
+}
+
+inline SnapshotRegistryScope::SnapshotRegistryScope(HOTSingleThreadedSnapshotRegistry* registry) : mPreviousRegistry(HOTSingleThreadedSnapshotRegistry::getActiveRegistryOfThread()) {
+	HOTSingleThreadedSnapshotRegistry::getActiveRegistryOfThread() = registry;
+}
+
+inline SnapshotRegistryScope::~SnapshotRegistryScope() {
+	HOTSingleThreadedSnapshotRegistry::getActiveRegistryOfThread() = mPreviousRegistry;
+}
+
+} } }
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_SUBTREE_COUNT_POLICY__
+#define __HOT__SINGLE_THREADED__HOT_SINGLE_THREADED_SUBTREE_COUNT_POLICY__
+
+#include <cstdint>
+
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+/**
+ * the type used to store the number of values contained in the subtree of a single node entry
+ */
+using SubtreeCount = uint32_t;
+
+/**
+ * Does not store any subtree counts. Nodes therefore have exactly the same layout and size as without order statistics.
+ */
+struct NoSubtreeCountPolicy {
+	static constexpr bool MAINTAINS_SUBTREE_COUNTS = false;
+
+	/**
+	 * @param capacity the number of entries a node has space for
+	 * @return the number of bytes required to store the subtree counts of a node with the given capacity
+	 */
+	static constexpr uint16_t getSizeInBytes(uint16_t const /* capacity */) {
+		return 0u;
+	}
+};
+
+/**
+ * Stores for each entry of a node the number of values contained in the subtree of this entry.
+ * The counts are stored in reverse entry order directly in front of the node's child pointers,
+ * hence the number of values contained in the subtrees of the first n entries is the sum of the n counts preceding the child pointers.
+ * Based on these counts the rank of a key and the value with a given rank are determined in time proportional to the height of the trie.
+ * A single subtree count is limited to 2^32 - 1 values.
+ */
+struct EntrySubtreeCountPolicy {
+	static constexpr bool MAINTAINS_SUBTREE_COUNTS = true;
+
+	/**
+	 * @param capacity the number of entries a node has space for
+	 * @return the number of bytes required to store the subtree counts of a node with the given capacity, rounded up to preserve the alignment of the child pointers
+	 */
+	static constexpr uint16_t getSizeInBytes(uint16_t const capacity) {
+		return static_cast<uint16_t>(((capacity * sizeof(SubtreeCount)) + 7u) & ~static_cast<size_t>(7u));
+	}
+};
+
+/**
+ * The subtree count policy used by HOTSingleThreaded. Subtree counts are only maintained if USE_ORDER_STATISTICS is defined.
+ * As the subtree counts are part of the memory layout of the nodes, all translation units of a program must agree on this setting.
+ */
+#ifdef USE_ORDER_STATISTICS
+using SubtreeCountPolicy = EntrySubtreeCountPolicy;
+#else
+using SubtreeCountPolicy = NoSubtreeCountPolicy;
+#endif
+
+} } }
+
+#endif
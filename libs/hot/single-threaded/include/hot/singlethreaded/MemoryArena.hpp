@@ -0,0 +1,163 @@
+#ifndef __HOT__SINGLE_THREADED__MEMORY_ARENA__
+#define __HOT__SINGLE_THREADED__MEMORY_ARENA__
+
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+
+#include <algorithm>
+#include <new>
+
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
+
+constexpr size_t MEMORY_ARENA_CHUNK_SIZE = 2u * 1024u * 1024u;
+constexpr size_t MEMORY_ARENA_CHUNK_ALIGNMENT = 64u;
+
+/**
+ * the number of bytes at the end of each chunk which are never handed out, as simd instructions may read beyond the end of the last allocated object
+ */
+constexpr size_t MEMORY_ARENA_TRAILING_PADDING = 64u;
+
+/**
+ * A MemoryArena hands out memory by bumping a pointer into large chunks.
+ *
+ * All memory of the arena is released at once, either by calling { @link #releaseAll() } or when the arena is destroyed.
+ * The cost of releasing the arena is therefore only proportional to the number of chunks and not to the number of allocated objects.
+ * Additionally, individual allocations can be released by { @link #release(void*) }. Each chunk counts its allocations which were not released yet
+ * and is freed as soon as this count drops to zero, unless memory is currently allocated from it.
+ * A MemoryArena is not synchronized.
+ */
+class MemoryArena {
+	struct alignas(MEMORY_ARENA_CHUNK_ALIGNMENT) ChunkHeader {
+		ChunkHeader* mPreviousChunk;
+		ChunkHeader* mNextChunk;
+		size_t mNumberLiveAllocations;
+	};
+
+	ChunkHeader* mCurrentChunk;
+	uintptr_t mNextFreeAddress;
+	uintptr_t mChunkEndAddress;
+	size_t mNumberChunks;
+
+public:
+	MemoryArena() : mCurrentChunk(nullptr), mNextFreeAddress(0u), mChunkEndAddress(0u), mNumberChunks(0u) {
+	}
+
+	MemoryArena(MemoryArena const & other) = delete;
+	MemoryArena& operator=(MemoryArena const & other) = delete;
+
+	~MemoryArena() {
+		releaseAll();
+	}
+
+	/**
+	 * @param sizeInBytes the size of the memory to allocate
+	 * @param requestedAlignment the alignment of the allocated memory. It must be a power of two not larger than the chunk alignment.
+	 * 	Like memory returned by malloc, the memory is at least aligned to alignof(std::max_align_t), as the low bits of node addresses are used to tag child pointers.
+	 * @return the allocated memory, which remains valid until the arena is released
+	 */
+	inline void* allocate(size_t sizeInBytes, size_t requestedAlignment) {
+		assert(requestedAlignment <= MEMORY_ARENA_CHUNK_ALIGNMENT && (requestedAlignment & (requestedAlignment - 1u)) == 0u);
+		assert(sizeInBytes + sizeof(ChunkHeader) + MEMORY_ARENA_TRAILING_PADDING <= MEMORY_ARENA_CHUNK_SIZE);
+
+		size_t alignment = std::max(requestedAlignment, alignof(std::max_align_t));
+		uintptr_t alignedAddress = (mNextFreeAddress + alignment - 1u) & ~(alignment - 1u);
+		if(alignedAddress + sizeInBytes > mChunkEndAddress) {
+			addChunk();
+			alignedAddress = mNextFreeAddress;
+		}
+		mNextFreeAddress = alignedAddress + sizeInBytes;
+		++mCurrentChunk->mNumberLiveAllocations;
+		return reinterpret_cast<void*>(alignedAddress);
+	}
+
+	/**
+	 * releases a single allocation. The chunk containing it is freed once all of its allocations were released.
+	 *
+	 * @param memory memory previously allocated from this arena and not released yet
+	 */
+	inline void release(void* memory) {
+		//chunks are aligned to their size, hence the chunk of an allocation is determined from its address
+		ChunkHeader* chunk = reinterpret_cast<ChunkHeader*>(reinterpret_cast<uintptr_t>(memory) & ~(MEMORY_ARENA_CHUNK_SIZE - 1u));
+		assert(chunk->mNumberLiveAllocations > 0u);
+		--chunk->mNumberLiveAllocations;
+		if(chunk->mNumberLiveAllocations == 0u && chunk != mCurrentChunk) {
+			releaseChunk(chunk);
+		}
+	}
+
+	/**
+	 * places subsequent allocations into a new chunk, such that they do not share a chunk with any previous allocation.
+	 * The current chunk is freed as soon as all of its allocations were released.
+	 */
+	inline void startNewChunk() {
+		if(mCurrentChunk == nullptr) {
+			return;
+		}
+		if(mCurrentChunk->mNumberLiveAllocations == 0u) {
+			mNextFreeAddress = reinterpret_cast<uintptr_t>(mCurrentChunk) + sizeof(ChunkHeader);
+		} else {
+			addChunk();
+		}
+	}
+
+	/**
+	 * releases all memory allocated from this arena. Afterwards the arena can be used for new allocations again.
+	 */
+	inline void releaseAll() {
+		while(mCurrentChunk != nullptr) {
+			ChunkHeader* previousChunk = mCurrentChunk->mPreviousChunk;
+			free(mCurrentChunk);
+			mCurrentChunk = previousChunk;
+		}
+		mNextFreeAddress = 0u;
+		mChunkEndAddress = 0u;
+		mNumberChunks = 0u;
+	}
+
+	/**
+	 * @return the number of chunks currently allocated by this arena
+	 */
+	size_t getNumberChunks() const {
+		return mNumberChunks;
+	}
+
+private:
+	inline void addChunk() {
+		void* rawChunk = nullptr;
+		int error = posix_memalign(&rawChunk, MEMORY_ARENA_CHUNK_SIZE, MEMORY_ARENA_CHUNK_SIZE);
+		if(error != 0) {
+			//"Got error on alignment"
+			throw std::bad_alloc();
+		}
+		ChunkHeader* previousChunk = mCurrentChunk;
+		mCurrentChunk = new (rawChunk) ChunkHeader { previousChunk, nullptr, 0u };
+		if(previousChunk != nullptr) {
+			previousChunk->mNextChunk = mCurrentChunk;
+			if(previousChunk->mNumberLiveAllocations == 0u) {
+				releaseChunk(previousChunk);
+			}
+		}
+		mNextFreeAddress = reinterpret_cast<uintptr_t>(rawChunk) + sizeof(ChunkHeader);
+		mChunkEndAddress = reinterpret_cast<uintptr_t>(rawChunk) + MEMORY_ARENA_CHUNK_SIZE - MEMORY_ARENA_TRAILING_PADDING;
+		++mNumberChunks;
+	}
+
+	inline void releaseChunk(ChunkHeader* chunk) {
+		assert(chunk != mCurrentChunk);
+		//only the current chunk has no successor
+		chunk->mNextChunk->mPreviousChunk = chunk->mPreviousChunk;
+		if(chunk->mPreviousChunk != nullptr) {
+			chunk->mPreviousChunk->mNextChunk = chunk->mNextChunk;
+		}
+		free(chunk);
+		--mNumberChunks;
+	}
+};
+
+}}}
+
+#endif
@@ -5,7 +5,12 @@
 #include <array>
 #include <cassert>
 
-namespace hot { namespace singlethreaded {
+#include <hot/commons/NodeMemory.hpp>
+
+#include "hot/singlethreaded/MemoryArena.hpp"
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace singlethreaded { inline namespace HOT_INSTRUCTION_SET_NAMESPACE {
 
 class FreeListEntry;
 
@@ -41,16 +46,29 @@ template<typename ElementType, size_t NUMBER_LISTS, size_t EVICTION_BEGIN_SIZE,
 	std::array<FreeListEntry*, NUMBER_LISTS> mFreeLists;
 	size_t mNumberAllocations;
 	size_t mNumberFrees;
+	MemoryArena* mArena;
 
 public:
-	MemoryPool() : mNumberAllocations(0ul), mNumberFrees(0ul) {
-		std::fill(mFreeLists.begin(), mFreeLists.end(), &TERMINATING_ENTRY);
+	MemoryPool() : MemoryPool(nullptr) {
+	}
+
+	/**
+	 * Creates a memory pool, which in case an arena is given, allocates all its memory from this arena.
+	 * Memory returned to an arena backed pool is only reused by the pool itself and is only released to the arena by { @link #releaseFreeLists() }.
+	 *
+	 * @param arena the arena to allocate memory from or nullptr to allocate each element individually
+	 */
+	explicit MemoryPool(MemoryArena* arena) : mNumberAllocations(0ul), mNumberFrees(0ul), mArena(arena) {
+		discardFreeLists();
 	}
 
 	MemoryPool(MemoryPool<ElementType, NUMBER_LISTS> const & other) = delete;
 	MemoryPool& operator=(MemoryPool<ElementType, NUMBER_LISTS> const & other) = delete;
 
 	~MemoryPool() {
+		if(mArena != nullptr) {
+			return;
+		}
 		for(FreeListEntry** freeList = mFreeLists.begin(); freeList != mFreeLists.end(); ++freeList) {
 			while((*freeList)->getListSize() > 0) {
 				*freeList = freeEntry(*freeList);
@@ -63,12 +81,7 @@ public:
 
 		void* rawMemory;
 		if(head->getListSize() == 0) {
-			++mNumberAllocations;
-			int error = posix_memalign(&rawMemory, sizeof(ElementType), numberElements * sizeof(ElementType));
-			if(error != 0) {
-				//"Got error on alignment"
-				throw std::bad_alloc();
-			}
+			rawMemory = allocFresh(numberElements);
 		} else {
 			rawMemory = reinterpret_cast<void*>(head);
 			head = head->getNext();
@@ -77,12 +90,29 @@ public:
 		return rawMemory;
 	}
 
+	/**
+	 * Allocates memory without reusing pooled elements. Consecutive fresh allocations from an arena backed pool are therefore adjacent to each other.
+	 * The memory is returned to the pool like any other allocation.
+	 *
+	 * @param numberElements the number of elements to allocate
+	 * @return the allocated memory
+	 */
+	void* allocFresh(size_t numberElements) {
+		assert(numberElements > 0);
+		assert(numberElements <= NUMBER_LISTS);
+
+		++mNumberAllocations;
+		return (mArena == nullptr)
+			? hot::commons::allocateNodeMemory(numberElements * sizeof(ElementType), sizeof(ElementType))
+			: mArena->allocate(numberElements * sizeof(ElementType), sizeof(ElementType));
+	}
+
 	void returnToPool(size_t numberElements, void* rawMemory) {
 		FreeListEntry* & head = getFreeListHead(numberElements);
-		if(head->getListSize() < SIZE_BEFORE_EVICTION_BEGIN_SIZE) {
+		if(mArena != nullptr || head->getListSize() < SIZE_BEFORE_EVICTION_BEGIN_SIZE) {
 			head = new (rawMemory) FreeListEntry(head);
 		} else {
-			free(rawMemory);
+			hot::commons::releaseNodeMemory(rawMemory);
 			++mNumberFrees;
 			while (head->getListSize() > EVICTION_END_SIZE) {
 				head = freeEntry(head);
@@ -98,11 +128,43 @@ public:
 		return mNumberFrees;
 	}
 
+	/**
+	 * Lets the subsequent allocations of an arena backed pool start in a new chunk of its arena (see { @link MemoryArena#startNewChunk() }).
+	 * This has no effect on pools without an arena.
+	 */
+	void startNewArenaChunk() {
+		if(mArena != nullptr) {
+			mArena->startNewChunk();
+		}
+	}
+
+	/**
+	 * Releases all pooled elements. Memory of an arena backed pool is returned to its arena, which frees each chunk as soon as none of its memory is in use anymore.
+	 */
+	void releaseFreeLists() {
+		for(FreeListEntry* & head : mFreeLists) {
+			while(head->getListSize() > 0) {
+				head = freeEntry(head);
+			}
+		}
+	}
+
+	/**
+	 * Forgets all pooled elements without releasing them, which is only valid for arena backed pools after their arena was released.
+	 */
+	void discardFreeLists() {
+		std::fill(mFreeLists.begin(), mFreeLists.end(), &TERMINATING_ENTRY);
+	}
+
 private:
 	FreeListEntry* freeEntry(FreeListEntry* head) {
 		assert(head->getListSize() != 0u);
 		FreeListEntry* next = head->getNext();
-		free(head);
+		if(mArena == nullptr) {
+			hot::commons::releaseNodeMemory(head);
+		} else {
+			mArena->release(head);
+		}
 		++mNumberFrees;
 		return next;
 	}
@@ -122,6 +184,6 @@ private:
 template<typename ElementType, size_t NUMBER_LISTS, size_t EVICTION_BEGIN_SIZE, size_t EVICTION_END_SIZE>
 	FreeListEntry MemoryPool<ElementType, NUMBER_LISTS, EVICTION_BEGIN_SIZE, EVICTION_END_SIZE>::TERMINATING_ENTRY {};
 
-}}
+}}}
 
 #endif
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <thread>
 #include <future>
+#include <string>
 
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
@@ -47,6 +48,14 @@ constexpr auto hasDeletionFunctionality = [](auto && x) {
 		   boost::hana::is_valid([](auto &&x) -> decltype(x.remove(std::declval<decltype(x.getThreadInformation()) &>(), uint64_t())) {})(x);
 };
 
+constexpr auto hasBatchLookupFunctionality = boost::hana::is_valid([](auto&& x) -> decltype(x.searchBatch(std::declval<uint64_t const *>(), size_t())) { });
+constexpr auto hasBatchDeletionFunctionality = boost::hana::is_valid([](auto&& x) -> decltype(x.removeBatch(std::declval<uint64_t const *>(), size_t())) { });
+constexpr auto hasScanWithIteratorFunctionality = boost::hana::is_valid([](auto&& x) -> decltype(x.scanWithIterator(uint64_t(), size_t(), uint64_t())) { });
+constexpr auto hasRangeScanFunctionality = boost::hana::is_valid([](auto&& x) -> decltype(x.scanRange(uint64_t(), size_t(), uint64_t())) { });
+constexpr auto hasBulkLoadFunctionality = boost::hana::is_valid([](auto&& x) -> decltype(x.bulkLoad(std::declval<std::vector<uint64_t> const &>())) { });
+constexpr auto hasParallelBulkLoadFunctionality = boost::hana::is_valid([](auto&& x) -> decltype(x.bulkLoadParallel(std::declval<std::vector<uint64_t> const &>())) { });
+constexpr auto hasReleaseBulkLoadedIndexFunctionality = boost::hana::is_valid([](auto&& x) -> decltype(x.releaseBulkLoadedIndex()) { });
+
 constexpr auto hasThreadInfo = boost::hana::is_valid([](auto&& x) -> decltype(x.getThreadInformation()) { });
 
 template<typename Benchmarkable> auto getThreadInfo(Benchmarkable & benchmarkable) {
@@ -66,14 +75,21 @@ template<typename Benchmarkable> auto getThreadInfo(Benchmarkable & benchmarkabl
  *
  * The following methods are optional:
  *   - bool remove(uint64_t key) (returns true, if the key to remove was previously contained)
+ *   - bool searchBatch(uint64_t const * keys, size_t numberKeys) (returns true, if all of the given keys were contained. Only used if -lookupBatch is specified)
+ *   - bool removeBatch(uint64_t const * sortedKeys, size_t numberKeys) (returns true, if all of the given sorted keys were contained and removed. Only used if -deleteBatch is specified)
  *   - bool iterateAll(std::vector<uint64_t> expectedKeys) scans all entries and returns true, if the actually contained entries match the expected keys
+ *   - bool scanWithIterator(uint64_t startKey, size_t numberValues, uint64_t expectedLastKey) scans numberValues values starting at startKey one at a time and returns true, if the last scanned key matches the expected key. Only used if -scanSweep is specified
+ *   - bool scanRange(uint64_t startKey, size_t numberValues, uint64_t expectedLastKey) same as scanWithIterator but uses the index' native range scan. Only used if -scanSweep is specified
+ *   - bool bulkLoad(std::vector<uint64_t> const & sortedKeys) builds a separate index from the sorted keys and returns true, if all keys were loaded. Only used if -bulkLoad is specified
+ *   - bool bulkLoadParallel(std::vector<uint64_t> const & sortedKeys) same as bulkLoad but uses all threads of the current tbb task arena. It is executed for 1, 2, 4, ... up to -threads threads. Only used if -bulkLoad is specified
+ *   - void releaseBulkLoadedIndex() frees the index built by the last bulk load, such that its destruction is not measured as part of the next bulk load
  *
  * For concurrent index structures the class to benchmark must provide a threadinfo getThreadInformation which is passed as the first argument to each method.
  * If the actual index does not require a special thread info object, for the sake of simplicity please provide a dummy wrapper parameter.
  *
  * It creates a commandline interface with the following behaviour:
  *
- * Usage: hot-single-threaded-integer-benchmark -insert=<insertType> [-insertModifier=<modifierType>] [-input=<insertFileName>] -size=<size> [-lookup=<lookupType>] [-lookupFile=<lookupFileName>] [-help] [-verbose=<true/false>] [-insertModifier=<true/false>]
+ * Usage: hot-single-threaded-integer-benchmark -insert=<insertType> [-insertModifier=<modifierType>] [-input=<insertFileName>] -size=<size> [-lookup=<lookupType>] [-lookupFile=<lookupFileName>] [-lookupBatch=<batchSize>] [-scanSweep=<maxScanLength>] [-deleteBatch=<batchSize>] [-bulkLoad=<true/false>] [-help] [-verbose=<true/false>] [-insertModifier=<true/false>]
  *	description: hot-single-threaded-integer-benchmark/hot-single-threaded-integer-benchmark
  *		inserts <size> values of a given generator type (<insertType>) into the index structure
  *		After that lookup is executed with provided data. Either a modification of the input type or a separate data file
@@ -90,6 +106,13 @@ template<typename Benchmarkable> auto getThreadInfo(Benchmarkable & benchmarkabl
  *		-help: show the usage dialog.
  *		-insertOnly: specifies whether only the insert operation should be executed.
  *		-threads: specifies the number of threads used for inserts as well as lookups.
+ *		-lookupBatch: specifies the number of keys which are looked up together in an additional batched lookup phase. Only executed if the benchmarked index supports batched lookups.
+ *		-scanSweep: specifies the maximum scan length of an additional scan phase, which is executed for scan lengths of 1, 2, 4, ... up to <maxScanLength> values.
+ *			For each scan length, scans with single step iteration and native range scans are measured separately. Only executed if the benchmarked index supports them.
+ *		-deleteBatch: specifies the number of sorted keys which are removed together in an additional batched delete phase. Before this phase, the keys removed by the regular delete phase are inserted again without being measured.
+ *			Only executed if the benchmarked index supports batched deletes.
+ *		-bulkLoad: specifies whether the sorted insert data is additionally bulk loaded into a separate index to compare it with the insert operation. Only executed if the benchmarked index supports bulk loading.
+ *			In case the index supports parallel bulk loading, the build throughput is additionally reported for 1, 2, 4, ... up to <threads> threads.
  *		-verbose: specifies to show debug messages.
  *
  *	potential parameter values:
@@ -194,6 +217,13 @@ public:
 		mBenchmarkResults.add(operationName, result);
 	}
 
+	template<typename BulkLoadable> void releaseBulkLoadedIndex(BulkLoadable & bulkLoadable) {
+		boost::hana::if_(hasReleaseBulkLoadedIndexFunctionality(bulkLoadable),
+			[](auto & bulkLoadable) -> void { bulkLoadable.releaseBulkLoadedIndex(); },
+			[](auto & /* bulkLoadable */) -> void { }
+		)(bulkLoadable);
+	}
+
 	bool insertRange(const tbb::blocked_range<size_t>& range, std::vector<uint64_t> const & insertKeys) {
 		return boost::hana::if_(hasThreadInfo(mBenchmarkable),
 			[&](auto & benchmarkable) {
@@ -240,6 +270,20 @@ public:
 		)(mBenchmarkable);
 	}
 
+	template<typename BatchBenchmarkable> bool searchBatchInRange(BatchBenchmarkable & benchmarkable, const tbb::blocked_range<size_t>& range, std::vector<uint64_t> const & lookupKeys, size_t batchSize) {
+		bool allLookedUp = true;
+		size_t totalNumberKeys = lookupKeys.size();
+		size_t i = range.begin();
+		while(i < range.end()) {
+			size_t index = i % totalNumberKeys;
+			//batches never wrap around the end of the lookup keys, to allow passing them as a single consecutive array
+			size_t numberKeysInBatch = std::min({ batchSize, range.end() - i, totalNumberKeys - index });
+			allLookedUp &= benchmarkable.searchBatch(lookupKeys.data() + index, numberKeysInBatch);
+			i += numberKeysInBatch;
+		}
+		return allLookedUp;
+	}
+
 	int run() {
 		std::vector<uint64_t> & insertKeys = mBenchmarkConfiguration.getInsertValues();
 		tbb::task_arena multithreadedArena(mBenchmarkConfiguration.mNumberThreads, 0);
@@ -286,6 +330,45 @@ public:
 				});
 		mBenchmarkResults.setIndexStatistics(mBenchmarkable.getStatistics());
 
+		if(mBenchmarkConfiguration.isBulkLoad()) {
+			std::vector<uint64_t> sortedKeys(insertKeys.begin(), insertKeys.end());
+			std::sort(sortedKeys.begin(), sortedKeys.end());
+
+			boost::hana::if_(hasBulkLoadFunctionality(mBenchmarkable),
+				[&, this](auto && benchmarkable) -> void {
+					this->benchmarkOperation("bulk-load", sortedKeys, sortedKeys.size(), [&](std::vector<uint64_t> const &keys) {
+						return benchmarkable.bulkLoad(keys);
+					});
+					this->releaseBulkLoadedIndex(benchmarkable);
+				},
+				[&](auto && /* benchmarkable */) -> void { }
+			)(mBenchmarkable);
+
+			boost::hana::if_(hasParallelBulkLoadFunctionality(mBenchmarkable),
+				[&, this](auto && benchmarkable) -> void {
+					size_t maximumNumberThreads = this->mBenchmarkConfiguration.mNumberThreads;
+					size_t numberThreads = 1u;
+					while(true) {
+						tbb::task_arena bulkLoadArena(static_cast<int>(numberThreads));
+						this->benchmarkOperation("parallel-bulk-load-" + std::to_string(numberThreads) + "-threads", sortedKeys, sortedKeys.size(), [&](std::vector<uint64_t> const &keys) {
+							bool allLoaded = false;
+							bulkLoadArena.execute([&] {
+								allLoaded = benchmarkable.bulkLoadParallel(keys);
+							});
+							return allLoaded;
+						});
+						this->releaseBulkLoadedIndex(benchmarkable);
+
+						if(numberThreads >= maximumNumberThreads) {
+							break;
+						}
+						numberThreads = std::min(numberThreads * 2u, maximumNumberThreads);
+					}
+				},
+				[&](auto && /* benchmarkable */) -> void { }
+			)(mBenchmarkable);
+		}
+
 		//std::cout << "Insert Finished" << std::endl;
 		if(!mBenchmarkConfiguration.isInsertOnly()) {
 			std::vector<uint64_t> const &lookupKeys = mBenchmarkConfiguration.getLookupValues();
@@ -372,6 +455,36 @@ public:
 						)(mBenchmarkable);
 					}
 						});
+
+			size_t lookupBatchSize = mBenchmarkConfiguration.getLookupBatchSize();
+			if(lookupBatchSize > 0) {
+				boost::hana::if_(hasBatchLookupFunctionality(mBenchmarkable),
+					[&,this](auto && benchmarkable) -> void {
+						this->benchmarkOperation("lookup-batch", lookupKeys, totalNumberLookups, [&](std::vector<uint64_t> const &keys) {
+							if (mBenchmarkConfiguration.mNumberThreads > 1) {
+								std::atomic<bool> allThreadSucceeded{true};
+								tbb::task_group lookupGroup;
+								multithreadedArena.execute([&] {
+									lookupGroup.run([&] { // run in task group
+										tbb::parallel_for(tbb::blocked_range<size_t>(0, totalNumberLookups, std::max<size_t>(10000, lookupBatchSize)),
+											[&](const tbb::blocked_range<size_t> &range) {
+												if (!this->searchBatchInRange(benchmarkable, range, keys, lookupBatchSize)) {
+													allThreadSucceeded.store(false, std::memory_order_release);
+												}
+											});
+									});
+								});
+								lookupGroup.wait();
+
+								return allThreadSucceeded.load(std::memory_order_acquire);
+							} else {
+								return this->searchBatchInRange(benchmarkable, tbb::blocked_range<size_t>(0, totalNumberLookups, totalNumberLookups), keys, lookupBatchSize);
+							}
+						});
+					},
+					[&](auto && /* benchmarkable */) -> void{ }
+				)(mBenchmarkable);
+			}
 		}
 		if(!mBenchmarkConfiguration.isInsertOnly()) {
 			boost::hana::if_(hasIterateAllFunctionality(mBenchmarkable),
@@ -452,6 +565,51 @@ public:
 			)(mBenchmarkable);
 		}
 
+		size_t maxScanLength = mBenchmarkConfiguration.getMaxScanLength();
+		if(!mBenchmarkConfiguration.isInsertOnly() && maxScanLength > 0) {
+			std::vector<uint64_t> const &scanStartKeys = mBenchmarkConfiguration.getLookupValues();
+			std::vector<uint64_t> sortedKeys(insertKeys.begin(), insertKeys.end());
+			std::sort(sortedKeys.begin(), sortedKeys.end());
+
+			for(size_t scanLength = 1; scanLength <= maxScanLength; scanLength *= 2) {
+				//roughly the same number of values is scanned for each scan length
+				size_t numberScans = std::max<size_t>(10'000'000u / scanLength, 100'000u);
+				std::vector<uint64_t> startKeys(numberScans);
+				std::vector<uint64_t> expectedLastKeys(numberScans);
+				for(size_t i = 0; i < numberScans; ++i) {
+					startKeys[i] = scanStartKeys[i % scanStartKeys.size()];
+					size_t startIndex = std::lower_bound(sortedKeys.begin(), sortedKeys.end(), startKeys[i]) - sortedKeys.begin();
+					expectedLastKeys[i] = sortedKeys[std::min(startIndex + scanLength, sortedKeys.size()) - 1];
+				}
+
+				boost::hana::if_(hasScanWithIteratorFunctionality(mBenchmarkable),
+					[&,this](auto && benchmarkable) -> void {
+						this->benchmarkOperation("scan-iterator-" + std::to_string(scanLength), startKeys, numberScans, [&](std::vector<uint64_t> const &keys) {
+							bool allScanned = true;
+							for(size_t i = 0; i < numberScans; ++i) {
+								allScanned &= benchmarkable.scanWithIterator(keys[i], scanLength, expectedLastKeys[i]);
+							}
+							return allScanned;
+						});
+					},
+					[&](auto && /* benchmarkable */) -> void{ }
+				)(mBenchmarkable);
+
+				boost::hana::if_(hasRangeScanFunctionality(mBenchmarkable),
+					[&,this](auto && benchmarkable) -> void {
+						this->benchmarkOperation("scan-range-" + std::to_string(scanLength), startKeys, numberScans, [&](std::vector<uint64_t> const &keys) {
+							bool allScanned = true;
+							for(size_t i = 0; i < numberScans; ++i) {
+								allScanned &= benchmarkable.scanRange(keys[i], scanLength, expectedLastKeys[i]);
+							}
+							return allScanned;
+						});
+					},
+					[&](auto && /* benchmarkable */) -> void{ }
+				)(mBenchmarkable);
+			}
+		}
+
 		boost::hana::if_(hasDeletionFunctionality(mBenchmarkable),
 			 [&,this](auto && benchmarkable) -> void {
 					 benchmarkOperation("delete", insertKeys, insertKeys.size(), [&, this](std::vector<uint64_t> const &keys) {
@@ -498,6 +656,29 @@ public:
 			[&](auto && /* benchmarkable */) -> void{ }
 		)(mBenchmarkable);
 
+		size_t deleteBatchSize = mBenchmarkConfiguration.getDeleteBatchSize();
+		if(deleteBatchSize > 0) {
+			boost::hana::if_(hasBatchDeletionFunctionality(mBenchmarkable),
+				[&,this](auto && benchmarkable) -> void {
+					std::vector<uint64_t> sortedKeys(insertKeys.begin(), insertKeys.end());
+					std::sort(sortedKeys.begin(), sortedKeys.end());
+					//the keys removed by the delete phase are inserted again, which is not part of the measurement
+					for(uint64_t key : insertKeys) {
+						benchmarkable.insert(key);
+					}
+
+					this->benchmarkOperation("delete-batch", sortedKeys, sortedKeys.size(), [&](std::vector<uint64_t> const &keys) {
+						bool allDeleted = true;
+						for(size_t batchStart = 0; batchStart < keys.size(); batchStart += deleteBatchSize) {
+							allDeleted &= benchmarkable.removeBatch(keys.data() + batchStart, std::min(deleteBatchSize, keys.size() - batchStart));
+						}
+						return allDeleted;
+					});
+				},
+				[&](auto && /* benchmarkable */) -> void{ }
+			)(mBenchmarkable);
+		}
+
 		writeYAML(std::cout);
 
 		return 0;
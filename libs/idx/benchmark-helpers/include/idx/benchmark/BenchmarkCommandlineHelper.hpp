@@ -27,7 +27,7 @@ private:
 public:
 	BenchmarkCommandlineHelper(int argc, char **argv, std::string /* dataStructureName */, std::map<std::string, std::string> const & additionalConfigOptions) : mArgc(argc), mArgv(argv), mAdditionalConfigOptions(additionalConfigOptions), mParser(argc, argv, [=]() {
 		std::cout << std::endl;
-		std::cout << "Usage: " << argv[0] << " -insert=<insertType> [-insertModifier=<modifierType>] [-input=<insertFileName>] -size=<size> [-lookup=<lookupType>] [-lookupFile=<lookupFileName>] [-help] [-verbose=<true/false>] [-insertModifier=<true/false>]";
+		std::cout << "Usage: " << argv[0] << " -insert=<insertType> [-insertModifier=<modifierType>] [-input=<insertFileName>] -size=<size> [-lookup=<lookupType>] [-lookupFile=<lookupFileName>] [-lookupBatch=<batchSize>] [-scanSweep=<maxScanLength>] [-deleteBatch=<batchSize>] [-bulkLoad=<true/false>] [-help] [-verbose=<true/false>] [-insertModifier=<true/false>]";
 		for(auto const & entry : additionalConfigOptions) {
 			std::cout << " [-" << entry.first << "=<" << entry.first << ">]";
 		}
@@ -47,6 +47,11 @@ public:
 		std::cout << "\t\t-help: show the usage dialog. " << std::endl;
 		std::cout << "\t\t-insertOnly: specifies whether only the insert operation should be executed." << std::endl;
 		std::cout << "\t\t-threads: specifies the number of threads used for inserts as well as lookups." << std::endl;
+		std::cout << "\t\t-lookupBatch: specifies the number of keys which are looked up together in an additional batched lookup phase. Only executed if the benchmarked index supports batched lookups." << std::endl;
+		std::cout << "\t\t-scanSweep: specifies the maximum scan length of an additional scan phase, which is executed for scan lengths of 1, 2, 4, ... up to <maxScanLength> values. Only executed if the benchmarked index supports scans." << std::endl;
+		std::cout << "\t\t-deleteBatch: specifies the number of sorted keys which are removed together in an additional batched delete phase. Only executed if the benchmarked index supports batched deletes." << std::endl;
+		std::cout << "\t\t-bulkLoad: specifies whether the sorted insert data is additionally bulk loaded into a separate index to compare it with the insert operation. Only executed if the benchmarked index supports bulk loading." << std::endl;
+		std::cout << "\t\t\tIn case the index supports parallel bulk loading, the build throughput is additionally reported for 1, 2, 4, ... up to <threads> threads." << std::endl;
 		std::cout << "\t\t-verbose: specifies to show debug messages. " << std::endl;
 
 
@@ -68,7 +73,7 @@ public:
 	}
 
 	BenchmarkConfiguration parseArguments() {
-		std::set<std::string> allowedConfigOptions { "insert", "insertOnly", "insertModifier", "input", "size", "lookup", "lookupFile", "verbose", "threads" };
+		std::set<std::string> allowedConfigOptions { "insert", "insertOnly", "insertModifier", "input", "size", "lookup", "lookupFile", "verbose", "threads", "lookupBatch", "scanSweep", "deleteBatch", "bulkLoad" };
 		for(auto const & entry : mAdditionalConfigOptions) {
 			allowedConfigOptions.insert(entry.first);
 		}
@@ -21,6 +21,10 @@ public:
 	std::map<std::string, std::string> mRawArguments;
 	bool mInsertOnly;
 	size_t mNumberThreads;
+	size_t mLookupBatchSize;
+	size_t mMaxScanLength;
+	size_t mDeleteBatchSize;
+	bool mBulkLoad;
 
 	BenchmarkConfiguration(idx::utils::CommandParser const & params)
 			: mInsertKeys(new std::vector<uint64_t>)
@@ -29,6 +33,10 @@ public:
 			, mRawArguments(params.getRawArguments())
 			, mInsertOnly(params.get<bool>("insertOnly", false))
 			, mNumberThreads(params.get<size_t>("threads", 1))
+			, mLookupBatchSize(params.get<size_t>("lookupBatch", 0))
+			, mMaxScanLength(params.get<size_t>("scanSweep", 0))
+			, mDeleteBatchSize(params.get<size_t>("deleteBatch", 0))
+			, mBulkLoad(params.get<bool>("bulkLoad", false))
 	{
 		*mInsertKeys = idx::utils::creatDataSet(params, "insert");
 		applyInputModifier(params);
@@ -41,6 +49,22 @@ public:
 		return mInsertOnly;
 	}
 
+	size_t getLookupBatchSize() const {
+		return mLookupBatchSize;
+	}
+
+	size_t getMaxScanLength() const {
+		return mMaxScanLength;
+	}
+
+	size_t getDeleteBatchSize() const {
+		return mDeleteBatchSize;
+	}
+
+	bool isBulkLoad() const {
+		return mBulkLoad;
+	}
+
 	std::vector<uint64_t> & getInsertValues() {
 		return *mInsertKeys;
 	}
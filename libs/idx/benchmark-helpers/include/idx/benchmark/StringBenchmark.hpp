@@ -6,7 +6,9 @@
 #include <iostream>
 #include <fstream>
 #include <cstdint>
+#include <cstring>
 #include <future>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -42,6 +44,18 @@ constexpr auto hasIterateFunctionality = [](auto && x) {
 		   boost::hana::is_valid([](auto &&x) -> decltype(x.iterate(std::declval<decltype(x.getThreadInformation()) &>(), std::vector<std::pair<char*, size_t>>())) {})(x);
 };
 
+constexpr auto hasBatchLookupFunctionality = boost::hana::is_valid([](auto&& x) -> decltype(x.searchBatch(std::declval<std::pair<char*, size_t> const *>(), size_t())) { });
+
+constexpr auto hasPrefixScanWithLowerBoundFunctionality = [](auto && x) {
+	return boost::hana::is_valid([](auto &&x) -> decltype(x.prefixScanWithLowerBound(std::pair<char*, size_t>(), size_t())) {})(x) ||
+		   boost::hana::is_valid([](auto &&x) -> decltype(x.prefixScanWithLowerBound(std::declval<decltype(x.getThreadInformation()) &>(), std::pair<char*, size_t>(), size_t())) {})(x);
+};
+
+constexpr auto hasPrefixScanFunctionality = [](auto && x) {
+	return boost::hana::is_valid([](auto &&x) -> decltype(x.prefixScan(std::pair<char*, size_t>(), size_t())) {})(x) ||
+		   boost::hana::is_valid([](auto &&x) -> decltype(x.prefixScan(std::declval<decltype(x.getThreadInformation()) &>(), std::pair<char*, size_t>(), size_t())) {})(x);
+};
+
 constexpr auto hasRemoveFunctionality = [](auto && x) {
 	return boost::hana::is_valid([](auto &&x) -> decltype(x.remove(std::pair<char*, size_t>())) {})(x) ||
 		   boost::hana::is_valid([](auto &&x) -> decltype(x.remove(x.getThreadInformation(), std::pair<char*, size_t>())) {})(x) ||
@@ -58,14 +72,18 @@ constexpr auto hasRemoveFunctionality = [](auto && x) {
  *
  * The following methods are optional:
  *   - bool remove(std::pair<char*, size_t> const & key)  (returns true, if the key to remove was previously contained)
+ *   - bool searchBatch(std::pair<char*, size_t> const * lookupKeys, size_t numberKeys) (returns true, if all of the given keys were contained. Only used if -lookupBatch is specified)
  *   - bool iterate(std::vector<std::pair<char*, size_t>> const & iterateKeys) scans all entries and returns true, if the actually contained entries match the expected keys
+ *   - bool prefixScanWithLowerBound(std::pair<char*, size_t> const & prefix, size_t expectedNumberValues) visits all keys starting with the first prefix.second characters of prefix.first by searching the lower bound of the prefix and comparing each following key.
+ *   	It returns true, if the expected number of keys was visited. Only used if -prefixScan is specified
+ *   - bool prefixScan(std::pair<char*, size_t> const & prefix, size_t expectedNumberValues) same as prefixScanWithLowerBound but uses the index' native prefix scan. Only used if -prefixScan is specified
  *
  * For concurrent index structures the class to benchmark must provide a threadinfo getThreadInformation which is passed as the first argument to each method.
  * If the actual index does not require a special thread info object, for the sake of simplicity please provide a dummy wrapper parameter.
  *
  * It creates a commandline interface with the following behaviour:
  *
- * Usage: -inputFile=<insertFile> [-insertModifier=<modifierType>] -size=<size> [-lookupModifier=<lookupType>] [-lookupFile=<lookupFileName>] [-help] [-verbose=<true/false>]
+ * Usage: -inputFile=<insertFile> [-insertModifier=<modifierType>] -size=<size> [-lookupModifier=<lookupType>] [-lookupFile=<lookupFileName>] [-lookupBatch=<batchSize>] [-prefixScan=<prefixLength>] [-maxKeyLength=<maxKeyLength>] [-help] [-verbose=<true/false>]
  *	description: inserts <size> strings into the benchmarked index structure
  *		After that lookup is executed with either the inserted strings or a new set of string. Both the insertion as well as the lookup order can be modified.
  *		The lookup is executed n times the size of the lookup data set, where n is the smallest natural number which results in at least 100 million lookup operations
@@ -81,6 +99,11 @@ constexpr auto hasRemoveFunctionality = [](auto && x) {
  *	-verbose: specifies whether verbose debug output should be printed or not.
  *	-insertOnly: specifies whether only the insert operation should be executed.
  *	-threads: specifies the number of threads used for insertion as well as lookup operations.
+ *	-lookupBatch: specifies the number of keys which are looked up together in an additional batched lookup phase. Only executed if the benchmarked index supports batched lookups.
+ *	-prefixScan: specifies the length of the prefixes used in an additional prefix scan phase. The prefixes are the first <prefixLength> characters of the lookup strings.
+ *		Prefix scans emulated by a lower bound search followed by comparing each key and native prefix scans are measured separately. Only executed if the benchmarked index supports them.
+ *	-maxKeyLength: specifies the maximum length of the strings read from the input and lookup files. Longer lines are skipped. Defaults to 126 characters.
+ *		Longer strings require an index supporting long keys, e.g. one compiled with USE_LONG_KEYS.
  *	-help: prints this usage message and terminates the application.
  *
  *
@@ -176,6 +199,80 @@ public:
 		mBenchmarkResults.add(operationName, result);
 	}
 
+	void benchmarkPrefixScans(size_t prefixLength, std::vector<std::pair<char*, size_t>> const & insertKeys, std::vector<std::pair<char*, size_t>> const & lookupKeys) {
+		std::vector<std::pair<char*, size_t>> sortedInsertKeys(insertKeys.begin(), insertKeys.end());
+		std::sort(sortedInsertKeys.begin(), sortedInsertKeys.end(), ConstCharStarComparator());
+
+		size_t numberScans = std::min<size_t>(lookupKeys.size(), 1'000'000u);
+		//the prefixes are copied to zero terminate them, as the emulated prefix scans search for their lower bound
+		std::vector<std::string> prefixStrings;
+		prefixStrings.reserve(numberScans);
+		std::vector<std::pair<char*, size_t>> prefixes;
+		std::vector<size_t> expectedNumberValues;
+		for(size_t i = 0; i < numberScans; ++i) {
+			prefixStrings.emplace_back(lookupKeys[i].first, std::min(prefixLength, lookupKeys[i].second));
+			std::string const & prefix = prefixStrings.back();
+			prefixes.emplace_back(const_cast<char*>(prefix.c_str()), prefix.size());
+
+			size_t numberMatchingKeys = 0;
+			for(auto it = std::lower_bound(sortedInsertKeys.begin(), sortedInsertKeys.end(), prefixes.back(), ConstCharStarComparator());
+				it != sortedInsertKeys.end() && strncmp(it->first, prefix.c_str(), prefix.size()) == 0; ++it) {
+				++numberMatchingKeys;
+			}
+			expectedNumberValues.push_back(numberMatchingKeys);
+		}
+
+		boost::hana::if_(hasPrefixScanWithLowerBoundFunctionality(mBenchmarkable),
+			[&,this](auto && benchmarkable) -> void {
+				this->benchmarkOperation("prefix-scan-lower-bound-" + std::to_string(prefixLength), prefixes, numberScans, [&](std::vector<std::pair<char *, size_t>> const &keys) {
+					return boost::hana::if_(hasThreadInfo(benchmarkable),
+						[&](auto &benchmarkable) {
+							bool allScanned = true;
+							decltype(benchmarkable.getThreadInformation()) threadInfo = benchmarkable.getThreadInformation();
+							for(size_t i = 0; i < numberScans; ++i) {
+								allScanned &= benchmarkable.prefixScanWithLowerBound(threadInfo, keys[i], expectedNumberValues[i]);
+							}
+							return allScanned;
+						},
+						[&](auto &benchmarkable) {
+							bool allScanned = true;
+							for(size_t i = 0; i < numberScans; ++i) {
+								allScanned &= benchmarkable.prefixScanWithLowerBound(keys[i], expectedNumberValues[i]);
+							}
+							return allScanned;
+						}
+					)(benchmarkable);
+				});
+			},
+			[&](auto && /* benchmarkable */) -> void{ }
+		)(mBenchmarkable);
+
+		boost::hana::if_(hasPrefixScanFunctionality(mBenchmarkable),
+			[&,this](auto && benchmarkable) -> void {
+				this->benchmarkOperation("prefix-scan-" + std::to_string(prefixLength), prefixes, numberScans, [&](std::vector<std::pair<char *, size_t>> const &keys) {
+					return boost::hana::if_(hasThreadInfo(benchmarkable),
+						[&](auto &benchmarkable) {
+							bool allScanned = true;
+							decltype(benchmarkable.getThreadInformation()) threadInfo = benchmarkable.getThreadInformation();
+							for(size_t i = 0; i < numberScans; ++i) {
+								allScanned &= benchmarkable.prefixScan(threadInfo, keys[i], expectedNumberValues[i]);
+							}
+							return allScanned;
+						},
+						[&](auto &benchmarkable) {
+							bool allScanned = true;
+							for(size_t i = 0; i < numberScans; ++i) {
+								allScanned &= benchmarkable.prefixScan(keys[i], expectedNumberValues[i]);
+							}
+							return allScanned;
+						}
+					)(benchmarkable);
+				});
+			},
+			[&](auto && /* benchmarkable */) -> void{ }
+		)(mBenchmarkable);
+	}
+
 	int run() {
 		std::vector<std::pair<char*, size_t>> & insertKeys = mBenchmarkConfiguration.getInsertStrings();
 		tbb::task_arena multithreadedArena(mBenchmarkConfiguration.mNumberThreads, 0);
@@ -283,6 +380,47 @@ public:
 
 														 return allThreadSucceeded.load(std::memory_order_acquire);
 												 });
+
+			size_t lookupBatchSize = mBenchmarkConfiguration.getLookupBatchSize();
+			if(lookupBatchSize > 0) {
+				boost::hana::if_(hasBatchLookupFunctionality(mBenchmarkable),
+					[&,this](auto && benchmarkable) -> void {
+						std::atomic<bool> allBatchesSucceeded { true };
+						this->benchmarkOperation("lookup-batch", lookupKeys, totalNumberLookups, [&](std::vector<std::pair<char *, size_t>> const &keys) {
+							tbb::task_group lookupGroup;
+							multithreadedArena.execute([&] {
+								lookupGroup.run([&] { // run in task group
+									tbb::parallel_for(tbb::blocked_range<size_t>(0, totalNumberLookups, std::max<size_t>(10000, lookupBatchSize)),
+										[&](const tbb::blocked_range<size_t> &range) {
+											bool allLookedUp = true;
+											size_t i = range.begin();
+											while(i < range.end()) {
+												size_t index = i % totalNumberKeys;
+												//batches never wrap around the end of the lookup keys, to allow passing them as a single consecutive array
+												size_t numberKeysInBatch = std::min({ lookupBatchSize, range.end() - i, totalNumberKeys - index });
+												allLookedUp &= benchmarkable.searchBatch(keys.data() + index, numberKeysInBatch);
+												i += numberKeysInBatch;
+											}
+											if (!allLookedUp) {
+												allBatchesSucceeded.store(false, std::memory_order_release);
+											}
+										});
+								});
+							});
+
+							lookupGroup.wait();
+
+							return allBatchesSucceeded.load(std::memory_order_acquire);
+						});
+					},
+					[&](auto && /* benchmarkable */) -> void{ }
+				)(mBenchmarkable);
+			}
+
+			size_t prefixScanLength = mBenchmarkConfiguration.getPrefixScanLength();
+			if(prefixScanLength > 0) {
+				benchmarkPrefixScans(prefixScanLength, insertKeys, lookupKeys);
+			}
 		}
 
 		boost::hana::if_(hasIterateFunctionality(mBenchmarkable),
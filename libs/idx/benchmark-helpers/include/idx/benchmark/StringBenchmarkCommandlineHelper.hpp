@@ -27,7 +27,7 @@ private:
 public:
 	StringBenchmarkCommandlineHelper(int argc, char **argv, std::string /* dataStructureName */, std::map<std::string, std::string> const & additionalConfigOptions) : mArgc(argc), mArgv(argv), mAdditionalConfigOptions(additionalConfigOptions), mParser(argc, argv, [&]() {
 		std::cout << std::endl;
-		std::cout << "Usage: " << argv[0] << " -inputFile=<insertFile> [-insertModifier=<modifierType>] -size=<size> [-lookupModifier=<lookupType>] [-lookupFile=<lookupFileName>] [-help] [-verbose=<true/false>]";// [-writeDotRepresentation=<dotFileName>]";
+		std::cout << "Usage: " << argv[0] << " -inputFile=<insertFile> [-insertModifier=<modifierType>] -size=<size> [-lookupModifier=<lookupType>] [-lookupFile=<lookupFileName>] [-lookupBatch=<batchSize>] [-prefixScan=<prefixLength>] [-help] [-verbose=<true/false>]";// [-writeDotRepresentation=<dotFileName>]";
 		for(auto const & entry : additionalConfigOptions) {
 			std::cout << " [-" << entry.first << "=<" << entry.first << ">]";
 		}
@@ -50,6 +50,9 @@ public:
 		std::cout << "\t" << "-verbose: specifies whether verbose debug output should be printed or not." << std::endl;
 		std::cout << "\t" << "-insertOnly: specifies whether only the insert operation should be executed." << std::endl;
 		std::cout << "\t" << "-threads: specifies the number of threads used for insertion as well as lookup operations." << std::endl;
+		std::cout << "\t" << "-lookupBatch: specifies the number of keys which are looked up together in an additional batched lookup phase. Only executed if the benchmarked index supports batched lookups." << std::endl;
+		std::cout << "\t" << "-prefixScan: specifies the length of the prefixes used in an additional prefix scan phase. The prefixes are the first <prefixLength> characters of the lookup strings." << std::endl;
+		std::cout << "\t\t" << "Prefix scans emulated by a lower bound search followed by comparing each key and native prefix scans are measured separately. Only executed if the benchmarked index supports them." << std::endl;
 		//std::cout << "\t" << "-writeDotRepresentation: specifies a filename where a dot representation of the graph should be writte to, if no filename is specified no dot representation will be generated." << std::endl;
 		std::cout << "\t" << "-help: prints this usage message and terminates the application." << std::endl;
 		std::cout << std::endl;
@@ -57,7 +60,7 @@ public:
 	}
 
 	StringBenchmarkConfiguration parseArguments() {
-		std::set<std::string> allowedConfigOptions { "inputFile", "insertOnly", "insertModifier", "size", "lookupModifier", "lookupFile", "verbose", "writeDotRepresentation", "threads" };
+		std::set<std::string> allowedConfigOptions { "inputFile", "insertOnly", "insertModifier", "size", "lookupModifier", "lookupFile", "verbose", "writeDotRepresentation", "threads", "lookupBatch", "prefixScan" };
 		for(auto const & entry : mAdditionalConfigOptions) {
 			allowedConfigOptions.insert(entry.first);
 		}
@@ -38,6 +38,9 @@ public:
 	bool mWriteDotFile;
 	std::string mDotFileLocation;
 	size_t mNumberThreads;
+	size_t mLookupBatchSize;
+	size_t mPrefixScanLength;
+	size_t mMaxKeyLength;
 
 	StringBenchmarkConfiguration(idx::utils::CommandParser const & params)
 			: mInsertStrings(new std::vector<std::pair<char*, size_t>>)
@@ -48,6 +51,9 @@ public:
 			, mWriteDotFile(params.has("writeDotRepresentation"))
 			, mDotFileLocation(mWriteDotFile ? params.expect<std::string>("writeDotRepresentation") : "")
 			, mNumberThreads(params.get<size_t>("threads", 1))
+			, mLookupBatchSize(params.get<size_t>("lookupBatch", 0))
+			, mPrefixScanLength(params.get<size_t>("prefixScan", 0))
+			, mMaxKeyLength(params.get<size_t>("maxKeyLength", 126))
 	{
 		createInsertStrings(params);
 		createLookupStrings(params);
@@ -67,6 +73,18 @@ public:
 		return mDotFileLocation;
 	}
 
+	size_t getLookupBatchSize() const {
+		return mLookupBatchSize;
+	}
+
+	size_t getPrefixScanLength() const {
+		return mPrefixScanLength;
+	}
+
+	size_t getMaxKeyLength() const {
+		return mMaxKeyLength;
+	}
+
 	std::vector<std::pair<char*, size_t>> & getInsertStrings() {
 		return *mInsertStrings;
 	}
@@ -94,7 +112,7 @@ private:
 		std::string line;
 		std::ifstream input(fileName);
 		while(std::getline(input, line) && (numberEntries == SIZE_MAX || resultVector.size() < numberEntries)) {
-			if(line.length() < 127) {
+			if(line.length() <= mMaxKeyLength) {
 				char *lineBuffer = new char[line.length() + 2];
 				lineBuffer = lineBuffer + (((uintptr_t) lineBuffer)%2);
 				strcpy(lineBuffer, line.c_str());
@@ -5,21 +5,43 @@
 
 #include <cstring>
 
+#include "idx/contenthelpers/KeyUtilities.hpp"
+
 namespace idx { namespace contenthelpers {
 
+template<typename Value> __attribute__((always_inline)) inline bool contentEquals(Value const & value1, Value const & value2, std::false_type /* isEqualityDefinedByEncoding */) {
+	return value1 == value2;
+}
+
+template<typename Value> inline bool contentEquals(Value const & value1, Value const & value2, std::true_type /* isEqualityDefinedByEncoding */) {
+	return encodeOrderPreserving(value1) == encodeOrderPreserving(value2);
+}
+
 /**
  * checks value equality for two given values
  * template specializations allow to adapt its behaviour for specific types.
  * For instance a specialization exist which compares two c-strings by using strcmp.
+ * Floating point keys and tuple keys are compared by their order preserving encodings, which ensures that NaN keys are found and that the equality of keys matches the equality of their bytes.
  */
 template<typename Value> __attribute__((always_inline)) inline bool contentEquals(Value value1, Value value2) {
-	return value1 == value2;
+	return contentEquals(value1, value2, std::integral_constant<bool, isEqualityDefinedByEncoding<Value>()>());
 }
 
 template<> __attribute__((always_inline)) inline bool contentEquals<char const*>(char const* value1, char const* value2) {
 	return strcmp(value1, value2) == 0;
 }
 
+//length delimited keys are only equal if their lengths are equal, hence a key ending with a zero byte never matches a stored key (see { @link LengthDelimitedKey })
+template<> __attribute__((always_inline)) inline bool contentEquals<LengthDelimitedKey>(LengthDelimitedKey value1, LengthDelimitedKey value2) {
+	return value1.second == value2.second && memcmp(value1.first, value2.first, value1.second) == 0;
+}
+
+#if __cplusplus >= 201703L
+template<> __attribute__((always_inline)) inline bool contentEquals<std::string_view>(std::string_view value1, std::string_view value2) {
+	return value1 == value2;
+}
+#endif
+
 } }
 
 #endif
\ No newline at end of file
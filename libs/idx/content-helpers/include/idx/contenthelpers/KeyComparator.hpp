@@ -4,6 +4,8 @@
 /** @author robert.binna@uibk.ac.at */
 
 #include "idx/contenthelpers/CStringComparator.hpp"
+#include "idx/contenthelpers/LengthDelimitedKeyComparator.hpp"
+#include "idx/contenthelpers/OrderPreservingKeyComparator.hpp"
 
 namespace idx { namespace contenthelpers {
 
@@ -20,6 +22,29 @@ template<> struct KeyComparator<const char*> {
 	using type = idx::contenthelpers::CStringComparator;
 };
 
+template<> struct KeyComparator<LengthDelimitedKey> {
+	using type = idx::contenthelpers::LengthDelimitedKeyComparator<LengthDelimitedKey>;
+};
+
+//floating point keys and tuple keys, which may contain floating point elements, are compared like their encodings to order and find NaN keys
+template<> struct KeyComparator<float> {
+	using type = idx::contenthelpers::OrderPreservingKeyComparator<float>;
+};
+
+template<> struct KeyComparator<double> {
+	using type = idx::contenthelpers::OrderPreservingKeyComparator<double>;
+};
+
+template<typename... ElementTypes> struct KeyComparator<std::tuple<ElementTypes...>> {
+	using type = idx::contenthelpers::OrderPreservingKeyComparator<std::tuple<ElementTypes...>>;
+};
+
+#if __cplusplus >= 201703L
+template<> struct KeyComparator<std::string_view> {
+	using type = idx::contenthelpers::LengthDelimitedKeyComparator<std::string_view>;
+};
+#endif
+
 } }
 
 #endif
\ No newline at end of file
@@ -3,21 +3,64 @@
 
 /** @author robert.binna@uibk.ac.at */
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <cstring>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+#include "idx/contenthelpers/OrderPreservingKeyEncoder.hpp"
 
 namespace idx { namespace contenthelpers {
 
 /**
- * returns a big endian representation of the given key. If the key is already in big endian representation the key itself will be returned
+ * @tparam KeyType the type of the key
+ * @return whether the bytes of a key of the given type must be encoded by an { @link OrderPreservingKeyEncoder } to reflect the order of the keys.
+ * 	This is the case for all supported types except unsigned integers of up to 64 bits, whose byte order is swapped more efficiently.
+ */
+template<typename KeyType> constexpr bool requiresOrderPreservingEncoding() {
+	return OrderPreservingKeyEncoder<KeyType>::IS_SUPPORTED && !(std::is_unsigned<KeyType>::value && sizeof(KeyType) <= sizeof(uint64_t));
+}
+
+template<typename KeyType> struct IsTupleKey : public std::false_type {
+};
+
+template<typename... ElementTypes> struct IsTupleKey<std::tuple<ElementTypes...>> : public std::true_type {
+};
+
+/**
+ * @tparam KeyType the type of the key
+ * @return whether two keys of the given type are equal if and only if their order preserving encodings are equal.
+ * 	This is the case for floating point keys and tuple keys, which may contain floating point elements, as NaNs are never equal to themselves and -0.0 is equal to 0.0 although their bits differ.
+ */
+template<typename KeyType> constexpr bool isEqualityDefinedByEncoding() {
+	return std::is_floating_point<KeyType>::value || IsTupleKey<KeyType>::value;
+}
+
+template<typename KeyType> inline auto toBigEndianByteOrder(KeyType const & key, std::true_type /* requiresOrderPreservingEncoding */) {
+	return encodeOrderPreserving(key);
+}
+
+template<typename KeyType> inline __attribute__((always_inline)) auto toBigEndianByteOrder(KeyType const & key, std::false_type /* requiresOrderPreservingEncoding */) {
+	return key;
+}
+
+/**
+ * returns a big endian representation of the given key. If the key is already in big endian representation the key itself will be returned.
+ * Keys like signed integers, floating point numbers or tuples, whose bytes do not reflect their order, are converted to their order preserving encoding.
  *
  * @tparam KeyType the type of the key to convert
  * @param key the key to convert
  * @return the big endian key representation
  */
 template<typename KeyType> inline auto toBigEndianByteOrder(KeyType const & key) {
-	return key;
+	return toBigEndianByteOrder(key, std::integral_constant<bool, requiresOrderPreservingEncoding<KeyType>()>());
 };
 
 template<> __attribute__((always_inline)) inline auto toBigEndianByteOrder<uint64_t>(uint64_t const & key) {
@@ -34,13 +77,20 @@ template<> inline auto toBigEndianByteOrder<uint16_t>(uint16_t const & key) {
 
 /**
  * @tparam KeyType the type of the key to determine the maximum key length
- * @return the maximum length of a key of a given type
+ * @return the maximum length of a key of a given type, which is the size of its big endian representation
  */
 template<typename KeyType> constexpr inline __attribute__((always_inline)) size_t getMaxKeyLength() {
-	return sizeof(KeyType);
+	return sizeof(decltype(toBigEndianByteOrder(std::declval<KeyType>())));
 }
 
+#ifdef USE_LONG_KEYS
+/**
+ * With long keys, string keys are limited by the 16 bit discriminative bit indexes, which can address the bits of the first 8192 bytes.
+ */
+constexpr size_t MAX_STRING_KEY_LENGTH = 8191;
+#else
 constexpr size_t MAX_STRING_KEY_LENGTH = 255;
+#endif
 template<> constexpr inline size_t getMaxKeyLength<char const *>() {
 	return MAX_STRING_KEY_LENGTH;
 }
@@ -60,6 +110,118 @@ template<> inline size_t getKeyLength<char const *>(char const * const & key) {
 	return std::min<size_t>(strlen(key) + 1u, MAX_STRING_KEY_LENGTH);
 }
 
+/**
+ * A length delimited binary key consists of a pointer to its first byte and its length in bytes. In contrast to c strings it may contain zero bytes.
+ * The last byte of a non empty key must not be a zero byte, as the bytes of a key are searched like its zero padded fixed size representation (see { @link KeyBytesView }).
+ * Otherwise keys, which only differ in trailing zero bytes, e.g. { "a", 1 } and { "a\0", 2 }, could not be distinguished. This restriction applies to std::string_view keys as well.
+ * Indexes reject such keys on insertion (see { @link #checkKey }) and never find them on lookup. Keys which require trailing zero bytes can be made valid by appending a terminating non zero byte.
+ */
+using LengthDelimitedKey = std::pair<char const *, size_t>;
+
+/**
+ * @param bytes the first byte of a length delimited key
+ * @param length the length of the key in bytes
+ * @return whether the key can be distinguished from all other keys by its zero padded representation, which requires that it does not end with a zero byte
+ */
+inline bool isValidLengthDelimitedKey(char const * bytes, size_t length) {
+	return length == 0u || bytes[length - 1u] != '\0';
+}
+
+template<> constexpr inline size_t getMaxKeyLength<LengthDelimitedKey>() {
+	return MAX_STRING_KEY_LENGTH;
+}
+
+template<> inline size_t getKeyLength<LengthDelimitedKey>(LengthDelimitedKey const & key) {
+	return std::min<size_t>(key.second, MAX_STRING_KEY_LENGTH);
+}
+
+#if __cplusplus >= 201703L
+//std::string_view keys are length delimited keys and therefore must not end with a zero byte either
+template<> constexpr inline size_t getMaxKeyLength<std::string_view>() {
+	return MAX_STRING_KEY_LENGTH;
+}
+
+template<> inline size_t getKeyLength<std::string_view>(std::string_view const & key) {
+	return std::min<size_t>(key.size(), MAX_STRING_KEY_LENGTH);
+}
+#endif
+
+/**
+ * determines whether all bytes of the given key are addressable by the discriminative bits of an index.
+ * Fixed size keys are always supported. Variable length keys are supported up to { @link MAX_STRING_KEY_LENGTH } bytes including the terminating zero byte of c strings.
+ *
+ * @tparam KeyType the type of the key
+ * @param key the key to check
+ * @return whether the key can be stored in an index without being truncated
+ */
+template<typename KeyType> inline __attribute__((always_inline)) bool isSupportedKeyLength(KeyType const & /* key */) {
+	return true;
+}
+
+template<> inline bool isSupportedKeyLength<char const *>(char const * const & key) {
+	return strnlen(key, MAX_STRING_KEY_LENGTH) < MAX_STRING_KEY_LENGTH;
+}
+
+template<> inline bool isSupportedKeyLength<LengthDelimitedKey>(LengthDelimitedKey const & key) {
+	return key.second <= MAX_STRING_KEY_LENGTH;
+}
+
+#if __cplusplus >= 201703L
+template<> inline bool isSupportedKeyLength<std::string_view>(std::string_view const & key) {
+	return key.size() <= MAX_STRING_KEY_LENGTH;
+}
+#endif
+
+/**
+ * rejects keys, which are too long to be stored in an index. Storing such a key would truncate it, hence keys only differing after the maximum key length would be considered equal.
+ *
+ * @tparam KeyType the type of the key
+ * @param key the key to check
+ * @throws std::length_error in case the key is longer than the maximum key length (see { @link #isSupportedKeyLength })
+ */
+template<typename KeyType> inline __attribute__((always_inline)) void checkKeyLength(KeyType const & key) {
+	if(!isSupportedKeyLength(key)) {
+		throw std::length_error("the key is longer than the maximum key length supported by the index");
+	}
+}
+
+/**
+ * determines whether a key can be distinguished from all other keys of its type by its zero padded representation.
+ * This is the case for all keys except length delimited keys ending with a zero byte (see { @link LengthDelimitedKey }).
+ *
+ * @tparam KeyType the type of the key
+ * @param key the key to check
+ * @return whether the key can be stored in an index
+ */
+template<typename KeyType> inline __attribute__((always_inline)) bool isDistinguishableKey(KeyType const & /* key */) {
+	return true;
+}
+
+template<> inline bool isDistinguishableKey<LengthDelimitedKey>(LengthDelimitedKey const & key) {
+	return isValidLengthDelimitedKey(key.first, key.second);
+}
+
+#if __cplusplus >= 201703L
+template<> inline bool isDistinguishableKey<std::string_view>(std::string_view const & key) {
+	return isValidLengthDelimitedKey(key.data(), key.size());
+}
+#endif
+
+/**
+ * rejects keys, which cannot be stored in an index without being confused with other keys.
+ *
+ * @tparam KeyType the type of the key
+ * @param key the key to check
+ * @throws std::length_error in case the key is longer than the maximum key length (see { @link #isSupportedKeyLength })
+ * @throws std::invalid_argument in case the key is a length delimited key ending with a zero byte (see { @link #isDistinguishableKey })
+ */
+template<typename KeyType> inline __attribute__((always_inline)) void checkKey(KeyType const & key) {
+	checkKeyLength(key);
+	if(!isDistinguishableKey(key)) {
+		throw std::invalid_argument("the length delimited key ends with a zero byte and cannot be distinguished from the key without it");
+	}
+}
+
 template<typename KeyType> inline __attribute__((always_inline)) auto toFixSizedKey(KeyType const & key) {
 	return key;
 }
@@ -94,6 +256,91 @@ template<> inline uint8_t const* interpretAsByteArray<const char*>(const char *
 	return reinterpret_cast<uint8_t const *>(cStringKey);
 }
 
+/**
+ * A view of the bytes of a variable length key, which allows to search for the key in place.
+ * All bytes following the key's length are treated as zero bytes. Hence, the view has the same bytes as the zero padded fixed size representation of the key without materializing it.
+ * As a consequence, keys which only differ in trailing zero bytes are searched alike, hence length delimited keys must not end with a zero byte (see { @link LengthDelimitedKey }).
+ */
+struct KeyBytesView {
+	uint8_t const * mBytes;
+	size_t mLength;
+
+	inline __attribute__((always_inline)) uint8_t operator[](size_t index) const {
+		return (index < mLength) ? mBytes[index] : static_cast<uint8_t>(0u);
+	}
+};
+
+/**
+ * returns the representation of a key, which is used to search for the key by its bytes.
+ * For fixed size keys this is the fixed size key in big endian byte order. For variable length keys this is a view of the key's bytes, which does not copy the key.
+ * The bytes of the representation are accessed by { @link #interpretAsByteArray }.
+ *
+ * @tparam KeyType the type of the key
+ * @param key the key to convert
+ * @return the representation of the key
+ */
+template<typename KeyType> inline __attribute__((always_inline)) auto toByteComparableKey(KeyType const & key) {
+	return toFixSizedKey(toBigEndianByteOrder(key));
+}
+
+template<> inline auto toByteComparableKey<char const *>(char const * const & key) {
+	return KeyBytesView { reinterpret_cast<uint8_t const *>(key), strnlen(key, MAX_STRING_KEY_LENGTH) };
+}
+
+template<> inline auto toByteComparableKey<LengthDelimitedKey>(LengthDelimitedKey const & key) {
+	return KeyBytesView { reinterpret_cast<uint8_t const *>(key.first), getKeyLength(key) };
+}
+
+#if __cplusplus >= 201703L
+template<> inline auto toByteComparableKey<std::string_view>(std::string_view const & key) {
+	return KeyBytesView { reinterpret_cast<uint8_t const *>(key.data()), getKeyLength(key) };
+}
+#endif
+
+inline __attribute__((always_inline)) KeyBytesView interpretAsByteArray(KeyBytesView const & keyBytes) {
+	return keyBytes;
+}
+
+/**
+ * the type used to access the bytes of a key of a given type, which is either a pointer to the bytes of a fixed size key or a { @link KeyBytesView }
+ */
+template<typename KeyType> using KeyBytesType = decltype(interpretAsByteArray(toByteComparableKey(std::declval<KeyType>())));
+
+/**
+ * returns a view of all bytes of a length delimited key. In contrast to { @link #toByteComparableKey } the view is not truncated to the maximum key length,
+ * which allows to compare keys exceeding the maximum key length with stored keys without false matches.
+ *
+ * @param key the key to get all bytes for
+ * @return the view of all bytes of the key
+ */
+inline KeyBytesView getAllKeyBytes(LengthDelimitedKey const & key) {
+	return KeyBytesView { reinterpret_cast<uint8_t const *>(key.first), key.second };
+}
+
+#if __cplusplus >= 201703L
+inline KeyBytesView getAllKeyBytes(std::string_view const & key) {
+	return KeyBytesView { reinterpret_cast<uint8_t const *>(key.data()), key.size() };
+}
+#endif
+
+/**
+ * lexicographically compares the bytes of two keys, where bytes following the length of a key are treated as zero bytes
+ *
+ * @param first the first key
+ * @param second the second key
+ * @return a negative value, zero or a positive value in case the first key is smaller, equal or larger than the second key
+ */
+inline int compareKeyBytes(KeyBytesView const & first, KeyBytesView const & second) {
+	size_t commonLength = std::min(first.mLength, second.mLength);
+	int comparisonResult = std::memcmp(first.mBytes, second.mBytes, commonLength);
+	if(comparisonResult == 0) {
+		KeyBytesView const & longerKey = (first.mLength > second.mLength) ? first : second;
+		bool hasNonZeroSuffix = std::any_of(longerKey.mBytes + commonLength, longerKey.mBytes + longerKey.mLength, [](uint8_t keyByte) { return keyByte != 0u; });
+		comparisonResult = hasNonZeroSuffix ? ((first.mLength > second.mLength) ? 1 : -1) : 0;
+	}
+	return comparisonResult;
+}
+
 }}
 
 #endif
\ No newline at end of file
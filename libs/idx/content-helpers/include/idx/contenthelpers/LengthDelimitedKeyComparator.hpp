@@ -0,0 +1,22 @@
+#ifndef __IDX__CONTENTHELPERS__LENGTH_DELIMITED_KEY_COMPARATOR__HPP__
+#define __IDX__CONTENTHELPERS__LENGTH_DELIMITED_KEY_COMPARATOR__HPP__
+
+#include "idx/contenthelpers/KeyUtilities.hpp"
+
+namespace idx { namespace contenthelpers {
+
+/**
+ * Comparator which lexicographically compares two length delimited keys in the same way as their zero padded fixed size representations.
+ *
+ * @tparam KeyType the type of the keys to compare, which is either { @link LengthDelimitedKey } or std::string_view
+ */
+template<typename KeyType> class LengthDelimitedKeyComparator {
+public:
+	inline bool operator()(KeyType const & first, KeyType const & second) const {
+		return compareKeyBytes(getAllKeyBytes(first), getAllKeyBytes(second)) < 0;
+	};
+};
+
+} }
+
+#endif
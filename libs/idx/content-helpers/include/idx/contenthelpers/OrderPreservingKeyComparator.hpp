@@ -0,0 +1,25 @@
+#ifndef __IDX__CONTENTHELPERS__ORDER_PRESERVING_KEY_COMPARATOR__HPP__
+#define __IDX__CONTENTHELPERS__ORDER_PRESERVING_KEY_COMPARATOR__HPP__
+
+#include <cstring>
+
+#include "idx/contenthelpers/OrderPreservingKeyEncoder.hpp"
+
+namespace idx { namespace contenthelpers {
+
+/**
+ * Comparator which compares two keys by their order preserving encodings (see { @link OrderPreservingKeyEncoder }).
+ * In contrast to std::less it orders keys containing NaNs in the same way as they are ordered in an index operating on the encoded keys.
+ *
+ * @tparam KeyType the type of the keys to compare, e.g. float, double or a std::tuple containing floating point elements
+ */
+template<typename KeyType> class OrderPreservingKeyComparator {
+public:
+	inline bool operator()(KeyType const & first, KeyType const & second) const {
+		return std::memcmp(encodeOrderPreserving(first).data(), encodeOrderPreserving(second).data(), OrderPreservingKeyEncoder<KeyType>::ENCODED_LENGTH) < 0;
+	};
+};
+
+} }
+
+#endif
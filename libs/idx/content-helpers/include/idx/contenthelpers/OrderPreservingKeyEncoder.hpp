@@ -0,0 +1,169 @@
+#ifndef __IDX__CONTENTHELPERS__ORDER_PRESERVING_KEY_ENCODER__HPP__
+#define __IDX__CONTENTHELPERS__ORDER_PRESERVING_KEY_ENCODER__HPP__
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace idx { namespace contenthelpers {
+
+/**
+ * An order preserving key encoder maps keys of a given type to fixed size byte arrays.
+ * The lexicographic order of the encoded byte arrays corresponds to the order of the keys, hence the encoded keys can be indexed by structures which only operate on the bytes of a key.
+ *
+ * Specializations exist for
+ * 	+ unsigned integers including unsigned __int128, which are encoded in big endian byte order
+ * 	+ signed integers including __int128, which are encoded like unsigned integers after flipping their sign bit
+ * 	+ float and double, which are encoded according to their total order with -0.0 being equal to 0.0 and all NaNs being equal and larger than positive infinity
+ * 	+ byte arrays like UUIDs, which are stored as std::array<uint8_t, N> and are already in lexicographic order
+ * 	+ std::tuple of the above types, which are encoded by concatenating the encodings of their elements and compare like std::tuple
+ *
+ * Each specialization provides IS_SUPPORTED, the length of the encoded keys as ENCODED_LENGTH and a function encode(key, encodedKey), which writes ENCODED_LENGTH bytes to encodedKey.
+ *
+ * @tparam KeyType the type of the keys to encode
+ */
+template<typename KeyType, typename Enable = void> struct OrderPreservingKeyEncoder {
+	static constexpr bool IS_SUPPORTED = false;
+};
+
+template<typename UnsignedKeyType> struct UnsignedIntegerKeyEncoder {
+	static constexpr bool IS_SUPPORTED = true;
+	static constexpr size_t ENCODED_LENGTH = sizeof(UnsignedKeyType);
+
+	static inline __attribute__((always_inline)) void encode(UnsignedKeyType key, uint8_t * encodedKey) {
+		for(size_t i = ENCODED_LENGTH; i > 0u; --i) {
+			encodedKey[i - 1u] = static_cast<uint8_t>(key);
+			key = static_cast<UnsignedKeyType>(key >> 8u);
+		}
+	}
+};
+
+template<typename SignedKeyType, typename UnsignedKeyType> struct SignedIntegerKeyEncoder {
+	static constexpr bool IS_SUPPORTED = true;
+	static constexpr size_t ENCODED_LENGTH = sizeof(SignedKeyType);
+
+	static inline __attribute__((always_inline)) void encode(SignedKeyType key, uint8_t * encodedKey) {
+		//flipping the sign bit orders negative values in two's complement before positive values
+		constexpr UnsignedKeyType signBit = static_cast<UnsignedKeyType>(static_cast<UnsignedKeyType>(1u) << (ENCODED_LENGTH * 8u - 1u));
+		UnsignedIntegerKeyEncoder<UnsignedKeyType>::encode(static_cast<UnsignedKeyType>(static_cast<UnsignedKeyType>(key) ^ signBit), encodedKey);
+	}
+};
+
+template<typename FloatingPointKeyType, typename BitsType> struct FloatingPointKeyEncoder {
+	static_assert(sizeof(FloatingPointKeyType) == sizeof(BitsType), "the bits type must have the size of the floating point type");
+
+	static constexpr bool IS_SUPPORTED = true;
+	static constexpr size_t ENCODED_LENGTH = sizeof(FloatingPointKeyType);
+
+	static inline void encode(FloatingPointKeyType key, uint8_t * encodedKey) {
+		FloatingPointKeyType normalizedKey = std::isnan(key) ? std::numeric_limits<FloatingPointKeyType>::quiet_NaN() : (key == 0 ? 0 : key);
+		BitsType bits;
+		std::memcpy(&bits, &normalizedKey, sizeof(bits));
+		constexpr BitsType signBit = static_cast<BitsType>(1u) << (ENCODED_LENGTH * 8u - 1u);
+		//the magnitudes of negative values are ordered in reverse and negative values must be ordered before positive values
+		bits = ((bits & signBit) != 0u) ? static_cast<BitsType>(~bits) : static_cast<BitsType>(bits | signBit);
+		UnsignedIntegerKeyEncoder<BitsType>::encode(bits, encodedKey);
+	}
+};
+
+template<typename KeyType> struct OrderPreservingKeyEncoder<KeyType, typename std::enable_if<std::is_integral<KeyType>::value && std::is_unsigned<KeyType>::value>::type>
+	: public UnsignedIntegerKeyEncoder<KeyType> {
+};
+
+template<typename KeyType> struct OrderPreservingKeyEncoder<KeyType, typename std::enable_if<std::is_integral<KeyType>::value && std::is_signed<KeyType>::value>::type>
+	: public SignedIntegerKeyEncoder<KeyType, typename std::make_unsigned<KeyType>::type> {
+};
+
+template<> struct OrderPreservingKeyEncoder<unsigned __int128> : public UnsignedIntegerKeyEncoder<unsigned __int128> {
+};
+
+template<> struct OrderPreservingKeyEncoder<__int128> : public SignedIntegerKeyEncoder<__int128, unsigned __int128> {
+};
+
+template<> struct OrderPreservingKeyEncoder<float> : public FloatingPointKeyEncoder<float, uint32_t> {
+};
+
+template<> struct OrderPreservingKeyEncoder<double> : public FloatingPointKeyEncoder<double, uint64_t> {
+};
+
+template<size_t numberBytes> struct OrderPreservingKeyEncoder<std::array<uint8_t, numberBytes>> {
+	static constexpr bool IS_SUPPORTED = true;
+	static constexpr size_t ENCODED_LENGTH = numberBytes;
+
+	static inline void encode(std::array<uint8_t, numberBytes> const & key, uint8_t * encodedKey) {
+		std::memcpy(encodedKey, key.data(), numberBytes);
+	}
+};
+
+template<typename... ElementTypes> constexpr bool areAllKeyElementsSupported() {
+	bool isSupported = true;
+	for(bool isElementSupported : { true, OrderPreservingKeyEncoder<ElementTypes>::IS_SUPPORTED... }) {
+		isSupported &= isElementSupported;
+	}
+	return isSupported;
+}
+
+template<typename... ElementTypes> constexpr size_t getSumOfEncodedKeyElementLengths() {
+	size_t length = 0u;
+	for(size_t elementLength : { static_cast<size_t>(0u), OrderPreservingKeyEncoder<ElementTypes>::ENCODED_LENGTH... }) {
+		length += elementLength;
+	}
+	return length;
+}
+
+template<typename... ElementTypes> struct OrderPreservingKeyEncoder<std::tuple<ElementTypes...>> {
+	static_assert(areAllKeyElementsSupported<ElementTypes...>(), "all elements of a tuple key must be supported by an order preserving key encoder");
+
+private:
+	template<typename ElementType> static inline void encodeElement(ElementType const & element, uint8_t * & encodedKey) {
+		OrderPreservingKeyEncoder<ElementType>::encode(element, encodedKey);
+		encodedKey += OrderPreservingKeyEncoder<ElementType>::ENCODED_LENGTH;
+	}
+
+	template<size_t... elementIndexes> static inline void encodeElements(std::tuple<ElementTypes...> const & key, uint8_t * encodedKey, std::index_sequence<elementIndexes...>) {
+		//the elements must be encoded from left to right, which is guaranteed for the elements of an initializer list
+		int encodeInOrder[] = { 0, (encodeElement(std::get<elementIndexes>(key), encodedKey), 0)... };
+		(void) encodeInOrder;
+	}
+
+public:
+	static constexpr bool IS_SUPPORTED = true;
+	//as each element is encoded with a fixed length, the encoded elements are concatenated without separators
+	static constexpr size_t ENCODED_LENGTH = getSumOfEncodedKeyElementLengths<ElementTypes...>();
+
+	static inline void encode(std::tuple<ElementTypes...> const & key, uint8_t * encodedKey) {
+		encodeElements(key, encodedKey, std::index_sequence_for<ElementTypes...>());
+	}
+};
+
+template<typename KeyType, typename Enable> constexpr bool OrderPreservingKeyEncoder<KeyType, Enable>::IS_SUPPORTED;
+template<typename UnsignedKeyType> constexpr bool UnsignedIntegerKeyEncoder<UnsignedKeyType>::IS_SUPPORTED;
+template<typename UnsignedKeyType> constexpr size_t UnsignedIntegerKeyEncoder<UnsignedKeyType>::ENCODED_LENGTH;
+template<typename SignedKeyType, typename UnsignedKeyType> constexpr bool SignedIntegerKeyEncoder<SignedKeyType, UnsignedKeyType>::IS_SUPPORTED;
+template<typename SignedKeyType, typename UnsignedKeyType> constexpr size_t SignedIntegerKeyEncoder<SignedKeyType, UnsignedKeyType>::ENCODED_LENGTH;
+template<typename FloatingPointKeyType, typename BitsType> constexpr bool FloatingPointKeyEncoder<FloatingPointKeyType, BitsType>::IS_SUPPORTED;
+template<typename FloatingPointKeyType, typename BitsType> constexpr size_t FloatingPointKeyEncoder<FloatingPointKeyType, BitsType>::ENCODED_LENGTH;
+template<size_t numberBytes> constexpr bool OrderPreservingKeyEncoder<std::array<uint8_t, numberBytes>>::IS_SUPPORTED;
+template<size_t numberBytes> constexpr size_t OrderPreservingKeyEncoder<std::array<uint8_t, numberBytes>>::ENCODED_LENGTH;
+template<typename... ElementTypes> constexpr bool OrderPreservingKeyEncoder<std::tuple<ElementTypes...>>::IS_SUPPORTED;
+template<typename... ElementTypes> constexpr size_t OrderPreservingKeyEncoder<std::tuple<ElementTypes...>>::ENCODED_LENGTH;
+
+/**
+ * @tparam KeyType the type of the key to encode
+ * @param key the key to encode
+ * @return the fixed size byte array, whose lexicographic order corresponds to the order of the keys
+ */
+template<typename KeyType> inline std::array<uint8_t, OrderPreservingKeyEncoder<KeyType>::ENCODED_LENGTH> encodeOrderPreserving(KeyType const & key) {
+	std::array<uint8_t, OrderPreservingKeyEncoder<KeyType>::ENCODED_LENGTH> encodedKey;
+	OrderPreservingKeyEncoder<KeyType>::encode(key, encodedKey.data());
+	return encodedKey;
+}
+
+} }
+
+#endif
@@ -56,6 +56,28 @@ public:
 	}
 };
 
+/**
+ * A TidPrefetcher issues a prefetch for the memory a tuple identifier refers to.
+ * Depending on the value representation different template specializations exist.
+ * In the default case the tuple identifier is the value itself and therefore no memory has to be prefetched.
+ *
+ * @tparam ValueType the type of the value represented by the tuple identifier
+ */
+template<typename ValueType>
+class TidPrefetcher {
+public:
+	__attribute__((always_inline)) inline void operator()(intptr_t /* tid */) {
+	}
+};
+
+template<typename ValueType>
+class TidPrefetcher<ValueType *> {
+public:
+	__attribute__((always_inline)) inline void operator()(intptr_t tid) {
+		__builtin_prefetch(reinterpret_cast<ValueType const *>(tid));
+	}
+};
+
 template<typename ValueType>
 __attribute__((always_inline)) inline ValueType tidToValue(intptr_t tid) {
 	TidToValueConverter<ValueType> convert;
@@ -68,6 +90,12 @@ __attribute__((always_inline)) inline intptr_t valueToTid(ValueType value) {
 	return convert(value);
 }
 
+template<typename ValueType>
+__attribute__((always_inline)) inline void prefetchTid(intptr_t tid) {
+	TidPrefetcher<ValueType> prefetch;
+	prefetch(tid);
+}
+
 } }
 
 #endif
\ No newline at end of file
@@ -9,12 +9,20 @@
 
 namespace idx { namespace utils {
 
-std::vector<std::pair<char *, size_t>> readStrings(std::string const &fileName,  size_t numberEntries = SIZE_MAX) {
+/**
+ * reads the lines of a file as strings
+ *
+ * @param fileName the name of the file to read
+ * @param numberEntries the maximum number of strings to read
+ * @param maxLength the maximum length of the strings to read, longer lines are skipped
+ * @return the strings read together with their lengths
+ */
+std::vector<std::pair<char *, size_t>> readStrings(std::string const &fileName,  size_t numberEntries = SIZE_MAX, size_t maxLength = 126) {
 	std::vector <std::pair<char *, size_t>> resultVector;
 	std::string line;
 	std::ifstream input(fileName);
 	while (std::getline(input, line) && (numberEntries == SIZE_MAX || resultVector.size() < numberEntries)) {
-		if (line.length() < 127) {
+		if (line.length() <= maxLength) {
 			char *lineBuffer = new char[line.length() + 2];
 			lineBuffer = lineBuffer + (((uintptr_t) lineBuffer) % 2);
 			strcpy(lineBuffer, line.c_str());
@@ -0,0 +1,22 @@
+#include <boost/test/unit_test.hpp>
+#include <hot/commons/InstructionSet.hpp>
+
+namespace hot { namespace commons {
+
+BOOST_AUTO_TEST_SUITE(InstructionSetTest)
+
+BOOST_AUTO_TEST_CASE(testCompiledInstructionSetIsSupported) {
+	BOOST_REQUIRE(isCompiledInstructionSetSupported());
+	BOOST_REQUIRE(getSupportedInstructionSet() == detectInstructionSet());
+}
+
+BOOST_AUTO_TEST_CASE(testInstructionSetsIncludeLowerInstructionSets) {
+	BOOST_REQUIRE(isCompiledFor(InstructionSet::SSE2));
+	BOOST_REQUIRE(isCompiledFor(COMPILED_INSTRUCTION_SET));
+	BOOST_REQUIRE_EQUAL(isCompiledFor(InstructionSet::AVX512), COMPILED_INSTRUCTION_SET == InstructionSet::AVX512);
+	BOOST_REQUIRE_EQUAL(isCompiledFor(InstructionSet::AVX2), COMPILED_INSTRUCTION_SET != InstructionSet::SSE2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}}
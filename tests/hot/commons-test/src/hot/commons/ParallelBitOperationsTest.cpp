@@ -0,0 +1,128 @@
+#include <random>
+
+#include <boost/test/unit_test.hpp>
+#include <hot/commons/ParallelBitOperations.hpp>
+
+namespace hot { namespace commons {
+
+BOOST_AUTO_TEST_SUITE(ParallelBitOperationsTest)
+
+BOOST_AUTO_TEST_CASE(testPortableExtractBits) {
+	using PortableOperations = ParallelBitOperations<InstructionSet::SSE2>;
+	BOOST_REQUIRE_EQUAL(PortableOperations::extractBits<uint32_t>(0b10110110u, 0b11110000u), 0b1011u);
+	BOOST_REQUIRE_EQUAL(PortableOperations::extractBits<uint32_t>(0b10110110u, 0b01010101u), 0b0110u);
+	BOOST_REQUIRE_EQUAL(PortableOperations::extractBits<uint32_t>(UINT32_MAX, 0u), 0u);
+	BOOST_REQUIRE_EQUAL(PortableOperations::extractBits<uint32_t>(0x80000001u, UINT32_MAX), 0x80000001u);
+	BOOST_REQUIRE_EQUAL(PortableOperations::extractBits<uint64_t>(0x8000000000000000ul, 0x8000000000000001ul), 0b10u);
+}
+
+BOOST_AUTO_TEST_CASE(testPortableDepositBits) {
+	using PortableOperations = ParallelBitOperations<InstructionSet::SSE2>;
+	BOOST_REQUIRE_EQUAL(PortableOperations::depositBits<uint32_t>(0b1011u, 0b11110000u), 0b10110000u);
+	BOOST_REQUIRE_EQUAL(PortableOperations::depositBits<uint32_t>(0b0110u, 0b01010101u), 0b00010100u);
+	BOOST_REQUIRE_EQUAL(PortableOperations::depositBits<uint32_t>(UINT32_MAX, 0u), 0u);
+	BOOST_REQUIRE_EQUAL(PortableOperations::depositBits<uint64_t>(0b10u, 0x8000000000000001ul), 0x8000000000000000ul);
+}
+
+BOOST_AUTO_TEST_CASE(testImplementationsAreEquivalent) {
+	std::mt19937_64 randomGenerator(42u);
+	for(size_t i = 0u; i < 100000u; ++i) {
+		uint64_t source = randomGenerator();
+		uint64_t mask = randomGenerator() & randomGenerator();
+		uint32_t source32 = static_cast<uint32_t>(source);
+		uint32_t mask32 = static_cast<uint32_t>(mask);
+
+		uint64_t extractedBits = ParallelBitOperations<InstructionSet::SSE2>::extractBits(source, mask);
+		uint64_t depositedBits = ParallelBitOperations<InstructionSet::SSE2>::depositBits(source, mask);
+		uint32_t extractedBits32 = ParallelBitOperations<InstructionSet::SSE2>::extractBits(source32, mask32);
+		uint32_t depositedBits32 = ParallelBitOperations<InstructionSet::SSE2>::depositBits(source32, mask32);
+
+		//depositing the extracted bits restores the masked source bits
+		BOOST_REQUIRE_EQUAL(ParallelBitOperations<InstructionSet::SSE2>::depositBits(extractedBits, mask), source & mask);
+
+		BOOST_REQUIRE_EQUAL(extractBits64(source, mask), extractedBits);
+		BOOST_REQUIRE_EQUAL(depositBits64(source, mask), depositedBits);
+		BOOST_REQUIRE_EQUAL(extractBits32(source32, mask32), extractedBits32);
+		BOOST_REQUIRE_EQUAL(depositBits32(source32, mask32), depositedBits32);
+
+		if(getSupportedInstructionSet() >= InstructionSet::AVX2) {
+			BOOST_REQUIRE_EQUAL(ParallelBitOperations<InstructionSet::AVX2>::extractBits(source, mask), extractedBits);
+			BOOST_REQUIRE_EQUAL(ParallelBitOperations<InstructionSet::AVX2>::depositBits(source, mask), depositedBits);
+			BOOST_REQUIRE_EQUAL(ParallelBitOperations<InstructionSet::AVX2>::extractBits(source32, mask32), extractedBits32);
+			BOOST_REQUIRE_EQUAL(ParallelBitOperations<InstructionSet::AVX2>::depositBits(source32, mask32), depositedBits32);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testEmulationIsEquivalent) {
+	BOOST_REQUIRE_EQUAL(ParallelBitOperationsEmulation<uint32_t>(0b01010101u).extractBits(0b10110110u), 0b0110u);
+	BOOST_REQUIRE_EQUAL(ParallelBitOperationsEmulation<uint32_t>(0b01010101u).depositBits(0b0110u), 0b00010100u);
+	BOOST_REQUIRE_EQUAL(ParallelBitOperationsEmulation<uint32_t>(0u).extractBits(UINT32_MAX), 0u);
+	BOOST_REQUIRE_EQUAL(ParallelBitOperationsEmulation<uint32_t>(UINT32_MAX).depositBits(0x80000001u), 0x80000001u);
+	BOOST_REQUIRE_EQUAL(ParallelBitOperationsEmulation<uint64_t>(0x8000000000000001ul).extractBits(0x8000000000000000ul), 0b10u);
+	BOOST_REQUIRE_EQUAL(ParallelBitOperationsEmulation<uint64_t>(UINT64_MAX).extractBits(0x8000000000000001ul), 0x8000000000000001ul);
+
+	std::mt19937_64 randomGenerator(42u);
+	for(size_t i = 0u; i < 100000u; ++i) {
+		uint64_t source = randomGenerator();
+		//masks with few and many bits set, as microcoded implementations depend on the number of bits set
+		uint64_t mask = ((i % 2u) == 0u) ? (randomGenerator() & randomGenerator() & randomGenerator()) : (randomGenerator() | randomGenerator());
+		uint32_t source32 = static_cast<uint32_t>(source);
+		uint32_t mask32 = static_cast<uint32_t>(mask >> (i % 32u));
+
+		ParallelBitOperationsEmulation<uint64_t> emulation(mask);
+		ParallelBitOperationsEmulation<uint32_t> emulation32(mask32);
+		BOOST_REQUIRE_EQUAL(emulation.extractBits(source), ParallelBitOperations<InstructionSet::SSE2>::extractBits(source, mask));
+		BOOST_REQUIRE_EQUAL(emulation.depositBits(source), ParallelBitOperations<InstructionSet::SSE2>::depositBits(source, mask));
+		BOOST_REQUIRE_EQUAL(emulation32.extractBits(source32), ParallelBitOperations<InstructionSet::SSE2>::extractBits(source32, mask32));
+		BOOST_REQUIRE_EQUAL(emulation32.depositBits(source32), ParallelBitOperations<InstructionSet::SSE2>::depositBits(source32, mask32));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testEmulationStepsAreEquivalent) {
+	std::mt19937_64 randomGenerator(42u);
+	for(size_t i = 0u; i < 10000u; ++i) {
+		uint64_t source = randomGenerator();
+		uint64_t mask = randomGenerator() & randomGenerator();
+
+		ParallelBitOperationsEmulationSteps<uint64_t> const steps(mask);
+		BOOST_REQUIRE_EQUAL(steps.extractBits(source, mask), ParallelBitOperations<InstructionSet::SSE2>::extractBits(source, mask));
+		BOOST_REQUIRE_EQUAL(steps.depositBits(source, mask), ParallelBitOperations<InstructionSet::SSE2>::depositBits(source, mask));
+		BOOST_REQUIRE_EQUAL(extractBits64(source, mask, steps), extractBits64(source, mask));
+		BOOST_REQUIRE_EQUAL(depositBits64(source, mask, steps), depositBits64(source, mask));
+	}
+	BOOST_REQUIRE_EQUAL(ParallelBitOperationsEmulationSteps<uint64_t>().extractBits(UINT64_MAX, 0u), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(testSelectingTheImplementationAtRuntime) {
+	//the emulation is only selected on request, as it has not been measured on the processors it is expected to perform best on
+	BOOST_REQUIRE(getParallelBitOperationsImplementation() == ParallelBitOperationsImplementation::Instructions);
+
+	std::mt19937_64 randomGenerator(42u);
+	for(ParallelBitOperationsImplementation implementation : { ParallelBitOperationsImplementation::Instructions, ParallelBitOperationsImplementation::Emulation }) {
+		setParallelBitOperationsImplementation(implementation);
+		BOOST_REQUIRE(getParallelBitOperationsImplementation() == implementation);
+
+		for(size_t i = 0u; i < 10000u; ++i) {
+			uint64_t source = randomGenerator();
+			uint64_t mask = randomGenerator() & randomGenerator();
+			uint32_t source32 = static_cast<uint32_t>(source);
+			uint32_t mask32 = static_cast<uint32_t>(mask);
+
+			BOOST_REQUIRE_EQUAL(extractBits64(source, mask), ParallelBitOperations<InstructionSet::SSE2>::extractBits(source, mask));
+			BOOST_REQUIRE_EQUAL(depositBits64(source, mask), ParallelBitOperations<InstructionSet::SSE2>::depositBits(source, mask));
+			BOOST_REQUIRE_EQUAL(extractBits32(source32, mask32), ParallelBitOperations<InstructionSet::SSE2>::extractBits(source32, mask32));
+			BOOST_REQUIRE_EQUAL(depositBits32(source32, mask32), ParallelBitOperations<InstructionSet::SSE2>::depositBits(source32, mask32));
+			BOOST_REQUIRE_EQUAL(ParallelBitMask<uint64_t>(mask).extractBits(source), extractBits64(source, mask));
+			BOOST_REQUIRE_EQUAL(ParallelBitMask<uint64_t>(mask).depositBits(source), depositBits64(source, mask));
+			BOOST_REQUIRE_EQUAL(ParallelBitMask<uint32_t>(mask32).extractBits(source32), extractBits32(source32, mask32));
+			BOOST_REQUIRE_EQUAL(ParallelBitMask<uint32_t>(mask32).depositBits(source32), depositBits32(source32, mask32));
+		}
+	}
+
+	setParallelBitOperationsImplementation(ParallelBitOperationsImplementation::Instructions);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}}
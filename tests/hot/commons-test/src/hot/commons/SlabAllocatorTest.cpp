@@ -0,0 +1,109 @@
+//
+//  @author robert.binna@uibk.ac.at
+//
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <hot/commons/SlabAllocator.hpp>
+
+namespace hot { namespace commons {
+
+BOOST_AUTO_TEST_SUITE(SlabAllocatorTest)
+
+BOOST_AUTO_TEST_CASE(testObjectsAreCacheLineAlignedAndDisjoint) {
+	SlabAllocator<512> allocator { SlabBacking::REGULAR_PAGES };
+
+	std::vector<std::pair<char*, size_t>> objects;
+	for(size_t i = 0u; i < 20000u; ++i) {
+		size_t size = 8u + (i * 8u) % 504u;
+		char* object = reinterpret_cast<char*>(allocator.allocate(size));
+		BOOST_REQUIRE_EQUAL(reinterpret_cast<uintptr_t>(object) % SLAB_OBJECT_ALIGNMENT, 0u);
+		std::memset(object, static_cast<int>(i % 256u), size);
+		objects.emplace_back(object, size);
+	}
+
+	std::sort(objects.begin(), objects.end());
+	for(size_t i = 1u; i < objects.size(); ++i) {
+		BOOST_REQUIRE_LE(objects[i - 1].first + objects[i - 1].second, objects[i].first);
+	}
+
+	for(std::pair<char*, size_t> const & object : objects) {
+		allocator.release(object.first);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testEmptySlabsAreReturned) {
+	SlabAllocator<512> allocator { SlabBacking::REGULAR_PAGES };
+	BOOST_REQUIRE_EQUAL(allocator.getNumberSlabs(), 0u);
+
+	//more objects than fit into a single slab
+	size_t numberObjects = 3u * (SLAB_SIZE / 256u);
+	std::vector<void*> objects;
+	for(size_t i = 0u; i < numberObjects; ++i) {
+		objects.push_back(allocator.allocate(256u));
+	}
+	BOOST_REQUIRE_GE(allocator.getNumberSlabs(), 3u);
+
+	for(void* object : objects) {
+		allocator.release(object);
+	}
+	//a single empty slab is retained per size class
+	BOOST_REQUIRE_EQUAL(allocator.getNumberSlabs(), 1u);
+
+	//the retained slab is reused
+	void* object = allocator.allocate(200u);
+	BOOST_REQUIRE_EQUAL(allocator.getNumberSlabs(), 1u);
+	allocator.release(object);
+}
+
+BOOST_AUTO_TEST_CASE(testReleasedObjectsAreReused) {
+	SlabAllocator<512> allocator { SlabBacking::TRANSPARENT_HUGE_PAGES };
+	void* first = allocator.allocate(100u);
+	void* second = allocator.allocate(100u);
+	allocator.release(first);
+	BOOST_REQUIRE_EQUAL(allocator.allocate(128u), first);
+	allocator.release(first);
+	allocator.release(second);
+}
+
+BOOST_AUTO_TEST_CASE(testConcurrentAllocations) {
+	SlabAllocator<512> allocator;
+	std::vector<std::thread> threads;
+	std::vector<bool> isThreadCorrect(4u, false);
+	for(size_t threadId = 0u; threadId < 4u; ++threadId) {
+		threads.emplace_back([&, threadId]() {
+			bool isCorrect = true;
+			std::vector<uint64_t*> objects;
+			for(size_t i = 0u; i < 50000u; ++i) {
+				uint64_t* object = reinterpret_cast<uint64_t*>(allocator.allocate(64u + (i % 7u) * 64u));
+				*object = threadId * 1000000u + i;
+				objects.push_back(object);
+				if((i % 3u) == 0u) {
+					allocator.release(objects[i / 2u]);
+					objects[i / 2u] = nullptr;
+				}
+			}
+			for(size_t i = 0u; i < objects.size(); ++i) {
+				if(objects[i] != nullptr) {
+					isCorrect &= (*objects[i] == threadId * 1000000u + i);
+					allocator.release(objects[i]);
+				}
+			}
+			isThreadCorrect[threadId] = isCorrect;
+		});
+	}
+	for(std::thread & thread : threads) {
+		thread.join();
+	}
+	for(bool isCorrect : isThreadCorrect) {
+		BOOST_REQUIRE(isCorrect);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}}
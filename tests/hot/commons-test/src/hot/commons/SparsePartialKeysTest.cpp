@@ -7,6 +7,7 @@
 #include <initializer_list>
 #include <iostream>
 #include <memory>
+#include <random>
 
 #include <sstream>
 #include <boost/test/unit_test.hpp>
@@ -31,6 +32,47 @@ template<typename PartialKeyType> SparsePartialKeys<PartialKeyType>* allocateMas
 	return reinterpret_cast<SparsePartialKeys<PartialKeyType>*>(memoryForMasks);
 }
 
+template<typename PartialKeyType> uint32_t findMasksByPatternSequentially(SparsePartialKeys<PartialKeyType> const & partialKeys, PartialKeyType consideredBits, PartialKeyType expectedBits) {
+	uint32_t resultMask = 0u;
+	for(size_t i = 0u; i < MAXIMUM_NUMBER_MASK_ENTRIES; ++i) {
+		resultMask |= static_cast<uint32_t>((partialKeys.mEntries[i] & consideredBits) == expectedBits) << i;
+	}
+	return resultMask;
+}
+
+template<typename PartialKeyType, InstructionSet instructionSet> void checkInstructionSetSpecificImplementation(SparsePartialKeys<PartialKeyType> const & partialKeys, PartialKeyType searchKey, PartialKeyType consideredBits, PartialKeyType expectedBits) {
+	if(getSupportedInstructionSet() >= instructionSet) {
+		BOOST_REQUIRE_EQUAL(partialKeys.template search<instructionSet>(searchKey), findMasksByPatternSequentially<PartialKeyType>(partialKeys, static_cast<PartialKeyType>(~searchKey), 0u));
+		BOOST_REQUIRE_EQUAL(partialKeys.template findMasksByPattern<instructionSet>(consideredBits, expectedBits), findMasksByPatternSequentially(partialKeys, consideredBits, expectedBits));
+	}
+}
+
+/**
+ * compares the implementations for all instruction sets supported by the executing processor with a sequential implementation
+ */
+template<typename PartialKeyType> void testInstructionSetSpecificImplementations() {
+	SparsePartialKeys<PartialKeyType>* partialKeys = allocateMasks<PartialKeyType>();
+	std::mt19937_64 randomGenerator(42u);
+
+	for(size_t iteration = 0u; iteration < 10000u; ++iteration) {
+		for(size_t i = 0u; i < MAXIMUM_NUMBER_MASK_ENTRIES; ++i) {
+			//sparse partial keys have only few bits set
+			partialKeys->mEntries[i] = static_cast<PartialKeyType>(randomGenerator() & randomGenerator() & randomGenerator());
+		}
+		//ensures that there are matches for the search key
+		PartialKeyType searchKey = static_cast<PartialKeyType>(randomGenerator() | partialKeys->mEntries[iteration % MAXIMUM_NUMBER_MASK_ENTRIES]);
+		PartialKeyType consideredBits = static_cast<PartialKeyType>(randomGenerator() & randomGenerator());
+		PartialKeyType expectedBits = static_cast<PartialKeyType>(partialKeys->mEntries[(iteration + 1u) % MAXIMUM_NUMBER_MASK_ENTRIES] & consideredBits);
+
+		checkInstructionSetSpecificImplementation<PartialKeyType, InstructionSet::SSE2>(*partialKeys, searchKey, consideredBits, expectedBits);
+		checkInstructionSetSpecificImplementation<PartialKeyType, InstructionSet::AVX2>(*partialKeys, searchKey, consideredBits, expectedBits);
+		checkInstructionSetSpecificImplementation<PartialKeyType, InstructionSet::AVX512>(*partialKeys, searchKey, consideredBits, expectedBits);
+		BOOST_REQUIRE_EQUAL(partialKeys->findMasksByPattern(consideredBits, expectedBits), findMasksByPatternSequentially(*partialKeys, consideredBits, expectedBits));
+	}
+
+	free(partialKeys);
+}
+
 BOOST_AUTO_TEST_SUITE(EntriesMasksTest)
 
 BOOST_AUTO_TEST_CASE(getRelevantBitsForEntriesSimple) {
@@ -1184,6 +1226,18 @@ BOOST_AUTO_TEST_CASE(testPrintMasks32) {
 	testPrintMasksWith32BitSet();
 }
 
+BOOST_AUTO_TEST_CASE(testInstructionSetSpecificImplementations8) {
+	testInstructionSetSpecificImplementations<uint8_t>();
+}
+
+BOOST_AUTO_TEST_CASE(testInstructionSetSpecificImplementations16) {
+	testInstructionSetSpecificImplementations<uint16_t>();
+}
+
+BOOST_AUTO_TEST_CASE(testInstructionSetSpecificImplementations32) {
+	testInstructionSetSpecificImplementations<uint32_t>();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }}
\ No newline at end of file
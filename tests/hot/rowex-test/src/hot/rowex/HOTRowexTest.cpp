@@ -12,10 +12,12 @@
 #include <mutex>
 
 #include <bitset>
+#include <cstring>
 #include <set>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
+#include <tbb/task_arena.h>
 #include <hot/rowex/HOTRowex.hpp>
 
 #include <hot/testhelpers/PartialKeyMappingTestHelper.hpp>
@@ -260,6 +262,117 @@ std::shared_ptr<hot::rowex::HOTRowex<ValueType, idx::contenthelpers::IdentityKey
 	return cobTrie;
 }
 
+template<typename ValueType>
+void testParallelBulkLoad(std::vector<ValueType> const &sortedValues, size_t numberThreads) {
+	hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthelpers::IdentityKeyExtractor> sequentiallyLoadedTrie;
+	size_t numberSequentiallyLoadedValues = sequentiallyLoadedTrie.bulkLoad(sortedValues.begin(), sortedValues.end());
+
+	hot::rowex::HOTRowex<ValueType, idx::contenthelpers::IdentityKeyExtractor> cobTrie;
+	size_t numberParallelLoadedValues = 0u;
+	tbb::task_arena arena(static_cast<int>(numberThreads));
+	arena.execute([&]() {
+		numberParallelLoadedValues = cobTrie.bulkLoadParallel(sortedValues.begin(), sortedValues.end());
+	});
+	BOOST_REQUIRE_EQUAL(numberParallelLoadedValues, numberSequentiallyLoadedValues);
+
+	bool isValid = isSubTreeValid<ValueType, idx::contenthelpers::IdentityKeyExtractor>(&cobTrie.mRoot);
+	BOOST_REQUIRE(isValid);
+	BOOST_REQUIRE_EQUAL(cobTrie.mRoot.getHeight(), sequentiallyLoadedTrie.mRoot.getHeight());
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(cobTrie.begin(), cobTrie.end(), sequentiallyLoadedTrie.begin(), sequentiallyLoadedTrie.end());
+
+	for(ValueType const & value : sortedValues) {
+		BOOST_REQUIRE(cobTrie.lookup(value).compliesWith({ true, value }));
+	}
+}
+
+template<typename ValueType>
+void testReverseIteration(std::vector<ValueType> const &values, std::vector<ValueType> const & probeKeys) {
+	using KeyComparatorType = typename idx::contenthelpers::KeyComparator<ValueType>::type;
+	using TrieType = hot::rowex::HOTRowex<ValueType, idx::contenthelpers::IdentityKeyExtractor>;
+
+	//works only because key == value
+	std::set<ValueType, KeyComparatorType> expectedValues(values.begin(), values.end());
+	TrieType cobTrie;
+	for(ValueType const & value : values) {
+		cobTrie.insert(value);
+	}
+
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(cobTrie.rbegin(), cobTrie.rend(), expectedValues.rbegin(), expectedValues.rend());
+
+	typename TrieType::const_iterator first = cobTrie.begin();
+	BOOST_REQUIRE(--first == cobTrie.end());
+	BOOST_REQUIRE(--first == cobTrie.end());
+
+	for(ValueType const & probeKey : probeKeys) {
+		for(bool isFloor : { true, false }) {
+			//the last entry not larger (floor) or smaller (predecessor) than the probe key
+			auto expected = isFloor ? expectedValues.upper_bound(probeKey) : expectedValues.lower_bound(probeKey);
+			typename TrieType::const_iterator actual = isFloor ? cobTrie.floor(probeKey) : cobTrie.predecessor(probeKey);
+			if(expected == expectedValues.begin()) {
+				BOOST_REQUIRE(actual == cobTrie.end());
+				continue;
+			}
+			--expected;
+			BOOST_REQUIRE(actual != cobTrie.end());
+			BOOST_REQUIRE_EQUAL(*actual, *expected);
+
+			//traverses backwards beyond the buffered entries and afterwards forwards again starting at the determined entry
+			typename TrieType::const_iterator current = actual;
+			auto expectedCurrent = expected;
+			size_t numberSteps = 0u;
+			while(numberSteps < 300u && expectedCurrent != expectedValues.begin()) {
+				--current;
+				--expectedCurrent;
+				++numberSteps;
+				BOOST_REQUIRE(current != cobTrie.end());
+				BOOST_REQUIRE_EQUAL(*current, *expectedCurrent);
+			}
+			if(numberSteps < 300u) {
+				BOOST_REQUIRE(--typename TrieType::const_iterator(current) == cobTrie.end());
+			}
+			for(size_t i = 0u; i < numberSteps; ++i) {
+				++current;
+				++expectedCurrent;
+				BOOST_REQUIRE_EQUAL(*current, *expectedCurrent);
+			}
+			if(++expected != expectedValues.end()) {
+				BOOST_REQUIRE_EQUAL(*++current, *expected);
+			} else {
+				BOOST_REQUIRE(++current == cobTrie.end());
+			}
+		}
+	}
+}
+
+void testPrefixScan(std::vector<char const *> const &values, std::vector<std::string> const & prefixes) {
+	using KeyComparatorType = typename idx::contenthelpers::KeyComparator<char const *>::type;
+
+	//works only because key == value
+	std::set<char const *, KeyComparatorType> expectedValues(values.begin(), values.end());
+	CStringTrieType cobTrie;
+	for(char const * value : values) {
+		cobTrie.insert(value);
+	}
+
+	std::vector<char const *> scannedValues;
+	auto collectBatch = [&](char const * const * batch, size_t numberValues) {
+		BOOST_REQUIRE_GT(numberValues, 0u);
+		BOOST_REQUIRE_LE(numberValues, hot::commons::MAXIMUM_NUMBER_NODE_ENTRIES);
+		scannedValues.insert(scannedValues.end(), batch, batch + numberValues);
+	};
+
+	for(std::string const & prefix : prefixes) {
+		std::vector<char const *> expectedScannedValues;
+		for(auto it = expectedValues.lower_bound(prefix.c_str()); it != expectedValues.end() && std::strncmp(*it, prefix.c_str(), prefix.size()) == 0; ++it) {
+			expectedScannedValues.push_back(*it);
+		}
+
+		scannedValues.clear();
+		BOOST_REQUIRE_EQUAL(cobTrie.prefixScan(prefix.c_str(), prefix.size(), collectBatch), expectedScannedValues.size());
+		BOOST_REQUIRE_EQUAL_COLLECTIONS(scannedValues.begin(), scannedValues.end(), expectedScannedValues.begin(), expectedScannedValues.end());
+	}
+}
+
 BOOST_AUTO_TEST_SUITE(HOTRowexTest)
 
 
@@ -589,6 +702,107 @@ BOOST_AUTO_TEST_CASE(testUpsert) {
 }
 
 
+BOOST_AUTO_TEST_CASE(testParallelBulkLoadRandomValues) {
+	idx::utils::RandomRangeGenerator<uint64_t> rnd{12344567, 0, INT64_MAX};
+	std::set<uint64_t> temporarySet;
+	for(size_t i = 0u; i < 300000u; ++i) {
+		temporarySet.insert(rnd());
+	}
+	std::vector<uint64_t> values(temporarySet.begin(), temporarySet.end());
+	testParallelBulkLoad(values, 4u);
+}
+
+BOOST_AUTO_TEST_CASE(testParallelBulkLoadWithStrings) {
+	std::vector<std::string> const &strings = getLongStrings();
+	std::set<std::string> temporarySet(strings.begin(), strings.end());
+	std::vector<std::string> sortedStrings(temporarySet.begin(), temporarySet.end());
+	testParallelBulkLoad(hot::testhelpers::stdStringsToCStrings(sortedStrings), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(testParallelBulkLoadInsertsIntoNonEmptyTrie) {
+	HOTRowexUint64 cobTrie;
+	cobTrie.insert(5u);
+
+	std::vector<uint64_t> values { 1u, 2u, 5u, 9u };
+	BOOST_REQUIRE_EQUAL(cobTrie.bulkLoadParallel(values.begin(), values.end()), 3u);
+
+	std::vector<uint64_t> expectedValues { 1u, 2u, 5u, 9u };
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(cobTrie.begin(), cobTrie.end(), expectedValues.begin(), expectedValues.end());
+}
+
+BOOST_AUTO_TEST_CASE(testParallelBulkLoadRejectsUnsortedValues) {
+	std::vector<uint64_t> values;
+	for(uint64_t i = 0u; i < 20000u; ++i) {
+		values.push_back(i * 3u);
+	}
+	//a single pair of adjacent values in descending order in the middle of the sequence
+	std::swap(values[12345u], values[12346u]);
+
+	HOTRowexUint64 cobTrie;
+	BOOST_REQUIRE_THROW(cobTrie.bulkLoadParallel(values.begin(), values.end()), std::invalid_argument);
+	BOOST_REQUIRE(cobTrie.begin() == cobTrie.end());
+
+	std::swap(values[12345u], values[12346u]);
+	BOOST_REQUIRE_EQUAL(cobTrie.bulkLoadParallel(values.begin(), values.end()), values.size());
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(cobTrie.begin(), cobTrie.end(), values.begin(), values.end());
+}
+
+BOOST_AUTO_TEST_CASE(testReverseIterationSequentialValues) {
+	std::vector<uint64_t> values;
+	for(uint64_t i = 0u; i < 20000u; ++i) {
+		values.push_back(i * 3u + 1u);
+	}
+	testReverseIteration<uint64_t>(values, { 0u, 1u, 2u, 3u, 4u, 1001u, 30000u, 59995u, 59998u, 59999u, UINT64_MAX });
+}
+
+BOOST_AUTO_TEST_CASE(testReverseIterationRandomValues) {
+	std::vector<uint64_t> values = getRandomNumbers(50000).second;
+	std::vector<uint64_t> probeKeys = { 0u, UINT64_MAX };
+	for(size_t i = 0u; i < values.size(); i += 997u) {
+		probeKeys.push_back(values[i]);
+		probeKeys.push_back(values[i] + 1u);
+		probeKeys.push_back(values[i] - 1u);
+	}
+	testReverseIteration<uint64_t>(values, probeKeys);
+}
+
+BOOST_AUTO_TEST_CASE(testReverseIterationSmallSets) {
+	testReverseIteration<uint64_t>({ 42u }, { 0u, 41u, 42u, 43u });
+	testReverseIteration<uint64_t>({ 41u, 43u }, { 0u, 41u, 42u, 43u, 44u });
+}
+
+BOOST_AUTO_TEST_CASE(testReverseIterationWithStrings) {
+	std::vector<std::string> const &strings = getLongStrings();
+	std::vector<std::string> probeStrings = { "", "a", "zzzzzzzz" };
+	for(size_t i = 0u; i < strings.size(); i += 101u) {
+		probeStrings.push_back(strings[i]);
+		probeStrings.push_back(strings[i] + "a");
+		probeStrings.push_back(strings[i].substr(0, strings[i].size() / 2));
+	}
+	testReverseIteration<const char*>(hot::testhelpers::stdStringsToCStrings(strings), hot::testhelpers::stdStringsToCStrings(probeStrings));
+}
+
+BOOST_AUTO_TEST_CASE(testPrefixScanWithStrings) {
+	std::vector<std::string> const &strings = getLongStrings();
+	std::vector<std::string> prefixes { "", "<", "<http://", "a", "\x7f" };
+	for(size_t i = 0u; i < strings.size(); i += 37u) {
+		for(size_t prefixLength : { 1u, 5u, 12u, 20u, 30u, 45u }) {
+			prefixes.push_back(strings[i].substr(0u, prefixLength));
+		}
+		prefixes.push_back(strings[i]);
+		prefixes.push_back(strings[i] + "a");
+		prefixes.push_back(strings[i].substr(0u, strings[i].size() - 1u) + "~");
+	}
+	testPrefixScan(hot::testhelpers::stdStringsToCStrings(strings), prefixes);
+}
+
+BOOST_AUTO_TEST_CASE(testPrefixScanSmallSets) {
+	testPrefixScan({}, { "", "a" });
+	testPrefixScan({ "fernando@terras.com" }, { "", "f", "fernando", "fernando@terras.com", "fernando@terras.com.bt", "g", "e" });
+	testPrefixScan({ "fernando@terras.com.bt", "fernando@terras.com" }, { "", "fernando@terras.com", "fernando@terras.com.", "fernando@terras.co", "fernando@terras.com.bt", "fernando@terras.comb" });
+	testPrefixScan({ "ab", "abc", "abd", "ac", "b", "ba" }, { "", "a", "ab", "abc", "abcd", "ac", "b", "ba", "bb", "c" });
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#ifndef __HOT__SINGLE_THREADED__INSTRUCTION_SET_VARIANT_WORKLOAD__
+#define __HOT__SINGLE_THREADED__INSTRUCTION_SET_VARIANT_WORKLOAD__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <idx/contenthelpers/IdentityKeyExtractor.hpp>
+
+#include <hot/singlethreaded/HOTSingleThreaded.hpp>
+
+namespace hot { namespace singlethreaded {
+
+/**
+ * The workload is included by each translation unit compiling a variant of the test. It has internal linkage,
+ * which ensures that each variant runs its own code instead of the code of another variant selected by the linker.
+ */
+namespace {
+
+template<typename KeyType> std::string describeKey(KeyType const & key);
+
+template<> std::string describeKey<uint64_t>(uint64_t const & key) {
+	return std::to_string(key);
+}
+
+template<> std::string describeKey<char const *>(char const * const & key) {
+	return std::string(key);
+}
+
+template<typename KeyType> void runWorkloadOnIndex(std::vector<KeyType> const & keys, std::vector<std::string> & description) {
+	HOTSingleThreaded<KeyType, idx::contenthelpers::IdentityKeyExtractor> index;
+
+	for(KeyType const & key : keys) {
+		description.push_back(index.insert(key) ? "inserted" : "duplicate");
+	}
+	//removes every third key, which merges and shrinks nodes
+	for(size_t i = 0u; i < keys.size(); i += 3u) {
+		description.push_back(index.remove(keys[i]) ? "removed" : "missing");
+	}
+	for(KeyType const & key : keys) {
+		idx::contenthelpers::OptionalValue<KeyType> result = index.lookup(key);
+		description.push_back(result.mIsValid ? describeKey(result.mValue) : "not found");
+	}
+	for(KeyType const & value : index) {
+		description.push_back(describeKey(value));
+	}
+}
+
+std::vector<std::string> runInstructionSetVariantWorkload(std::vector<uint64_t> const & integerKeys, std::vector<std::string> const & stringKeys) {
+	std::vector<std::string> description;
+	runWorkloadOnIndex(integerKeys, description);
+
+	std::vector<char const *> cStringKeys;
+	for(std::string const & key : stringKeys) {
+		cStringKeys.push_back(key.c_str());
+	}
+	runWorkloadOnIndex(cStringKeys, description);
+	return description;
+}
+
+}
+
+}}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef __HOT__SINGLE_THREADED__INSTRUCTION_SET_VARIANTS__
+#define __HOT__SINGLE_THREADED__INSTRUCTION_SET_VARIANTS__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <hot/commons/InstructionSetDispatch.hpp>
+
+namespace hot { namespace singlethreaded {
+
+/**
+ * Builds an index of integer keys and an index of string keys, modifies them and describes their contents and the results of all operations.
+ * The description is independent of the instruction set the indexes are compiled for.
+ */
+using InstructionSetVariantWorkload = std::vector<std::string> (*)(std::vector<uint64_t> const & integerKeys, std::vector<std::string> const & stringKeys);
+
+struct InstructionSetVariant {
+	hot::commons::InstructionSet mInstructionSet;
+	InstructionSetVariantWorkload mRunWorkload;
+};
+
+/**
+ * @return the workload compiled for the instruction set of the test executable
+ */
+InstructionSetVariant getCompiledInstructionSetVariant();
+
+/**
+ * @return the workload compiled for AVX2 in a target region, regardless of the instruction set of the test executable
+ */
+InstructionSetVariant getAVX2InstructionSetVariant();
+
+/**
+ * @return the workload compiled for AVX-512 in a target region, regardless of the instruction set of the test executable
+ */
+InstructionSetVariant getAVX512InstructionSetVariant();
+
+}}
+
+#endif
@@ -0,0 +1,22 @@
+//compiles the workload for AVX-512, even if the test executable is compiled for the x86-64 baseline
+#define HOT_TARGET_AVX512
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <idx/contenthelpers/IdentityKeyExtractor.hpp>
+
+#include "hot/singlethreaded/InstructionSetVariants.hpp"
+
+#include <hot/commons/BeginInstructionSetTarget.hpp>
+#include "hot/singlethreaded/InstructionSetVariantWorkload.hpp"
+#include <hot/commons/EndInstructionSetTarget.hpp>
+
+namespace hot { namespace singlethreaded {
+
+InstructionSetVariant getAVX512InstructionSetVariant() {
+	return { hot::commons::InstructionSet::AVX512, &runInstructionSetVariantWorkload };
+}
+
+}}
@@ -7,6 +7,8 @@
 #include <functional>
 #include <memory>
 #include <iostream>
+#include <random>
+#include <set>
 #include <unordered_set>
 
 #include <boost/test/unit_test.hpp>
@@ -236,6 +238,55 @@ template<typename ValueType, typename ResultHandler> void insertIntoSingleNodeWi
 	);
 }
 
+/**
+ * Inserts a value, which is not contained yet, into a node by trying to insert it in place. If this is not possible the node must remain unchanged and is replaced by a copy created with addEntry.
+ * An in place insert must result in the same discriminative bits, partial keys and child pointers as a copy created with addEntry.
+ *
+ * @return the node containing the new value, which is the given node if and only if the value was inserted in place
+ */
+template<typename ValueType> HOTSingleThreadedChildPointer addEntryInPlaceOrCopy(HOTSingleThreadedChildPointer nodePointer, ValueType newValue, bool expectedToBeInsertedInPlace) {
+	return nodePointer.executeForSpecificNodeType(false, [&](auto & node) -> HOTSingleThreadedChildPointer {
+		using NodeType = typename BaseType<decltype(node)>::type;
+		hot::commons::SearchResultForInsert const & searchResult = searchForInsert(std::shared_ptr<NodeType const>(&node, [](NodeType const *) {}), newValue);
+		ValueType const & existingValue = idx::contenthelpers::tidToValue<ValueType>(node.getPointers()[searchResult.mEntryIndex].getTid());
+		hot::commons::InsertInformation const & insertInformation = node.getInsertInformation(searchResult.mEntryIndex, getSignifkantKeyInformation(existingValue, newValue));
+		HOTSingleThreadedChildPointer const newValuePointer(idx::contenthelpers::valueToTid(newValue));
+
+		HOTSingleThreadedChildPointer copiedNodePointer = node.addEntry(insertInformation, newValuePointer);
+		std::vector<typename NodeType::PartialKeyType> previousPartialKeys(node.mPartialKeys.mEntries, node.mPartialKeys.mEntries + node.getNumberEntries());
+		std::vector<HOTSingleThreadedChildPointer> previousPointers(node.begin(), node.end());
+
+		bool isInsertedInPlace = node.tryToAddEntryInPlace(insertInformation, newValuePointer);
+		BOOST_REQUIRE_EQUAL(isInsertedInPlace, expectedToBeInsertedInPlace);
+		if(!isInsertedInPlace) {
+			BOOST_REQUIRE_EQUAL(node.getNumberEntries(), previousPointers.size());
+			BOOST_REQUIRE(std::equal(previousPartialKeys.begin(), previousPartialKeys.end(), node.mPartialKeys.mEntries));
+			BOOST_REQUIRE(std::equal(previousPointers.begin(), previousPointers.end(), node.begin()));
+			nodePointer.free();
+			return copiedNodePointer;
+		}
+
+		copiedNodePointer.executeForSpecificNodeType(false, [&](auto const & copiedNode) {
+			BOOST_REQUIRE((std::is_same<NodeType, typename BaseType<decltype(copiedNode)>::type>::value));
+			BOOST_REQUIRE_EQUAL(node.getNumberEntries(), copiedNode.getNumberEntries());
+			BOOST_REQUIRE(node.mDiscriminativeBitsRepresentation.getDiscriminativeBits() == copiedNode.mDiscriminativeBitsRepresentation.getDiscriminativeBits());
+			for(size_t i = 0u; i < node.getNumberEntries(); ++i) {
+				BOOST_REQUIRE_EQUAL(static_cast<uint32_t>(node.mPartialKeys.mEntries[i]), static_cast<uint32_t>(copiedNode.mPartialKeys.mEntries[i]));
+				BOOST_REQUIRE(node.getPointers()[i] == copiedNode.getPointers()[i]);
+			}
+		});
+		copiedNodePointer.free();
+		return nodePointer;
+	});
+}
+
+template<typename ValueType> void checkNode(HOTSingleThreadedChildPointer const & nodePointer, std::vector<ValueType> const & values, size_t numberValuesContained) {
+	nodePointer.executeForSpecificNodeType(false, [&](auto const & node) {
+		using NodeType = typename BaseType<decltype(node)>::type;
+		checkNode(std::shared_ptr<NodeType const>(&node, [](NodeType const *) {}), numberValuesContained, values, numberValuesContained);
+	});
+}
+
 HOTSingleThreadedDeletionInformation getDeletionInformation(HOTSingleThreadedChildPointer const & nodePointer, uint32_t indexOfEntryToRemove) {
 	return nodePointer.executeForSpecificNodeType(false, [indexOfEntryToRemove](auto const & node) {
 		return node.getDeletionInformation(indexOfEntryToRemove);
@@ -313,6 +364,56 @@ template<typename ValueType> void testRemove(std::vector<ValueType> const & valu
 	testStepwiseDeletion(randomOrderedValues);
 }
 
+template<typename ValueType> void testRemoveEntries(std::vector<ValueType> const & valuesToInsert) {
+	std::set<ValueType, typename idx::contenthelpers::KeyComparator<ValueType>::type> uniqueValues { valuesToInsert.begin(), valuesToInsert.end() };
+	std::vector<ValueType> sortedUniqueValues { uniqueValues.begin(), uniqueValues.end() };
+	uint32_t numberEntries = static_cast<uint32_t>(sortedUniqueValues.size());
+	uint32_t allEntriesMask = UINT32_MAX >> (32u - numberEntries);
+
+	std::vector<uint32_t> removedEntriesMasks;
+	for(uint32_t i = 0u; i < numberEntries; ++i) {
+		removedEntriesMasks.push_back(1u << i);
+		removedEntriesMasks.push_back(allEntriesMask & ~(1u << i));
+		removedEntriesMasks.push_back(allEntriesMask >> i);
+		removedEntriesMasks.push_back((allEntriesMask << i) & allEntriesMask);
+	}
+	removedEntriesMasks.push_back(allEntriesMask & 0x55555555u);
+	removedEntriesMasks.push_back(allEntriesMask & 0xAAAAAAAAu);
+	std::mt19937 randomGenerator(42u);
+	for(size_t i = 0u; i < 200u; ++i) {
+		removedEntriesMasks.push_back(static_cast<uint32_t>(randomGenerator()) & allEntriesMask);
+	}
+
+	insertIntoSingleNodeWithoutTypeCheck(valuesToInsert, [&](auto const & initialNode) {
+		for(uint32_t removedEntriesMask : removedEntriesMasks) {
+			std::vector<ValueType> remainingValues;
+			for(uint32_t i = 0u; i < numberEntries; ++i) {
+				if((removedEntriesMask & (1u << i)) == 0u) {
+					remainingValues.push_back(sortedUniqueValues[i]);
+				}
+			}
+			if(remainingValues.empty()) {
+				continue;
+			}
+
+			HOTSingleThreadedChildPointer result = initialNode->removeEntries(removedEntriesMask);
+			if(remainingValues.size() == 1u) {
+				BOOST_REQUIRE(result.isLeaf());
+				BOOST_REQUIRE_EQUAL(idx::contenthelpers::tidToValue<ValueType>(result.getTid()), remainingValues[0]);
+			} else {
+				result.executeForSpecificNodeType(false, [&](auto const & nodeWithEntriesRemoved) {
+					typedef typename BaseType<decltype(nodeWithEntriesRemoved)>::type ResultingNodeType;
+					std::shared_ptr<ResultingNodeType const> resultingNode { &nodeWithEntriesRemoved };
+					checkNode(resultingNode, remainingValues.size(), remainingValues, remainingValues.size());
+					for(size_t i = 0u; i < remainingValues.size(); ++i) {
+						BOOST_REQUIRE_EQUAL(searchForInsert(resultingNode, remainingValues[i]).mEntryIndex, i);
+					}
+				});
+			}
+		}
+	});
+}
+
 template<typename ValueType, typename InitialNodeType> void testCompressToSingleEntry(std::shared_ptr<const InitialNodeType> const & initialNode, std::vector<ValueType> const & sortedEntries) {
 	for(uint32_t i=1; i < sortedEntries.size(); ++i) {
 		hot::singlethreaded::HOTSingleThreadedChildPointer childPointer = initialNode->compressEntries(i, 1u);
@@ -1087,6 +1188,22 @@ BOOST_AUTO_TEST_CASE(testRemoveAndAdd) {
 	executeTestRemoveAndAdd(initialEntries, 1ul, 65ul);
 }
 
+BOOST_AUTO_TEST_CASE(testRemoveMultipleEntries) {
+	std::vector<uint64_t> sequentialValues;
+	std::vector<uint64_t> sparseValues;
+	std::vector<uint64_t> randomValues;
+	std::mt19937_64 randomGenerator(4711u);
+	for(uint64_t i = 0u; i < 32u; ++i) {
+		sequentialValues.push_back(i + 32u);
+		sparseValues.push_back(1ul << (i * 2u));
+		randomValues.push_back(randomGenerator() >> 1u);
+	}
+	testRemoveEntries(sequentialValues);
+	testRemoveEntries(sparseValues);
+	testRemoveEntries(randomValues);
+	testRemoveEntries(std::vector<uint64_t> { 34u, 36u, 49u, 101u });
+}
+
 BOOST_AUTO_TEST_CASE(testSplitAndMergeStrings) {
 	std::vector<std::string> strings;
 	std::string prefix { "" };
@@ -1783,6 +1900,68 @@ BOOST_AUTO_TEST_CASE(testGetDeletionInformation) {
 	});
 }
 
+#ifdef USE_NODE_SLACK_CAPACITY
+BOOST_AUTO_TEST_CASE(testAddEntryInPlace) {
+	std::vector<uint64_t> values { 0u, 16u, 8u, 4u, 2u, 1u, 24u, 12u };
+	HOTSingleThreadedChildPointer node = hot::commons::createTwoEntriesNode<HOTSingleThreadedChildPointer, HOTSingleThreadedNode>(createBiNodeForValues(values[0], values[1]))->toChildPointer();
+
+	//a node with two entries is allocated with a capacity of 4 entries
+	HOTSingleThreadedNodeBase const * initialNode = node.getNode();
+	for(size_t i = 2u; i < 4u; ++i) {
+		node = addEntryInPlaceOrCopy(node, values[i], true);
+		BOOST_REQUIRE_EQUAL(node.getNode(), initialNode);
+		checkNode(node, values, i + 1u);
+	}
+
+	//the fifth entry exceeds the capacity, hence the node is copied into a node with a capacity of 8 entries
+	node = addEntryInPlaceOrCopy(node, values[4], false);
+	BOOST_REQUIRE(node.getNode() != initialNode);
+	checkNode(node, values, 5u);
+
+	//the grown node is filled up to its capacity in place
+	HOTSingleThreadedNodeBase const * grownNode = node.getNode();
+	for(size_t i = 5u; i < values.size(); ++i) {
+		node = addEntryInPlaceOrCopy(node, values[i], true);
+		BOOST_REQUIRE_EQUAL(node.getNode(), grownNode);
+		checkNode(node, values, i + 1u);
+	}
+	node.free();
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(testAddEntryToFullNodeCopiesTheNode) {
+	std::vector<uint64_t> values;
+	for(uint64_t i = 0u; i < 32u; ++i) {
+		values.push_back((i * 13u) % 32u);
+	}
+	HOTSingleThreadedChildPointer node = hot::commons::createTwoEntriesNode<HOTSingleThreadedChildPointer, HOTSingleThreadedNode>(createBiNodeForValues(values[0], values[1]))->toChildPointer();
+
+	//all values fit into 8 bit partial keys, hence only the capacity of the node determines whether a value is inserted in place
+	for(size_t i = 2u; i < values.size(); ++i) {
+		uint16_t numberEntries = static_cast<uint16_t>(i);
+		HOTSingleThreadedNodeBase const * previousNode = node.getNode();
+		bool hasSpareCapacity = NodeCapacityPolicy::getCapacity(numberEntries) == NodeCapacityPolicy::getCapacity(numberEntries + 1u);
+		node = addEntryInPlaceOrCopy(node, values[i], hasSpareCapacity);
+		BOOST_REQUIRE_EQUAL(node.getNode() == previousNode, hasSpareCapacity);
+		checkNode(node, values, i + 1u);
+	}
+
+	//a full node is never extended in place but split by the trie
+	BOOST_REQUIRE(node.getNode()->isFull());
+	node.executeForSpecificNodeType(false, [&](auto & fullNode) {
+		uint64_t newValue = 32u;
+		hot::commons::SearchResultForInsert searchResult;
+		auto const & fixedSizedKey = idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(newValue));
+		fullNode.searchForInsert(searchResult, idx::contenthelpers::interpretAsByteArray(fixedSizedKey));
+		uint64_t existingValue = idx::contenthelpers::tidToValue<uint64_t>(fullNode.getPointers()[searchResult.mEntryIndex].getTid());
+		hot::commons::InsertInformation const & insertInformation = fullNode.getInsertInformation(searchResult.mEntryIndex, getSignifkantKeyInformation(existingValue, newValue));
+		BOOST_REQUIRE(!fullNode.hasSpareCapacity());
+		BOOST_REQUIRE(!fullNode.tryToAddEntryInPlace(insertInformation, HOTSingleThreadedChildPointer(idx::contenthelpers::valueToTid(newValue))));
+	});
+	checkNode(node, values, values.size());
+	node.free();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }}
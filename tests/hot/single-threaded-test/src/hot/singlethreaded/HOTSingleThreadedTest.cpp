@@ -3,12 +3,24 @@
 //
 //
 
+#include <algorithm>
 #include <bitset>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <random>
 #include <set>
+#include <thread>
+#include <tuple>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
+#include <tbb/task_arena.h>
 #include <hot/singlethreaded/HOTSingleThreaded.hpp>
+#include <hot/singlethreaded/HOTSingleThreadedParallelBulkLoad.hpp>
 
 #include <hot/testhelpers/PartialKeyMappingTestHelper.hpp>
 #include <hot/testhelpers/SampleTriples.hpp>
@@ -32,10 +44,38 @@ inline bool isPartitionCorrect(HOTSingleThreadedChildPointer const * childPointe
 	});
 }
 
+#ifdef USE_ORDER_STATISTICS
+//checks whether the subtree count of each entry matches the number of values actually contained in the entry's subtree
+inline bool areSubtreeCountsCorrect(HOTSingleThreadedChildPointer const & subtreeRoot, size_t & numberValuesInSubtree) {
+	if(subtreeRoot.isLeaf()) {
+		numberValuesInSubtree = 1u;
+		return true;
+	}
+
+	HOTSingleThreadedNodeBase const * node = subtreeRoot.getNode();
+	bool areCountsCorrect = true;
+	numberValuesInSubtree = 0u;
+	for(size_t entryIndex = 0u; entryIndex < node->getNumberEntries(); ++entryIndex) {
+		size_t numberValuesInEntry = 0u;
+		areCountsCorrect &= areSubtreeCountsCorrect(node->getPointers()[entryIndex], numberValuesInEntry);
+		areCountsCorrect &= (node->getNumberValuesInSubtreeOfEntry(entryIndex) == numberValuesInEntry);
+		numberValuesInSubtree += numberValuesInEntry;
+	}
+	return areCountsCorrect;
+}
+#endif
+
 template<typename ValueType, template <typename> typename KeyExtractor> inline bool isSubTreeValid(HOTSingleThreadedChildPointer const * currentSubtreeRoot) {
 	if(currentSubtreeRoot->isLeaf() || currentSubtreeRoot->getNode() == nullptr) {
 		return true;
 	}
+#ifdef USE_ORDER_STATISTICS
+	size_t numberValues = 0u;
+	if(!areSubtreeCountsCorrect(*currentSubtreeRoot, numberValues)) {
+		std::cout << "the subtree counts do not match the number of values contained in the subtrees" << std::endl;
+		return false;
+	}
+#endif
 	KeyExtractor<ValueType> extractKey;
 	using KeyType = decltype(extractKey(std::declval<ValueType>()));
 
@@ -50,8 +90,8 @@ template<typename ValueType, template <typename> typename KeyExtractor> inline b
 	while(isValid && stackIndex >= 0) {
 		if(nodeStack[stackIndex]->isLeaf()) {
 			KeyType const & key = extractKey(idx::contenthelpers::tidToValue<ValueType>(nodeStack[stackIndex]->getTid()));
-			auto const & fixedSizedKey = idx::contenthelpers::toFixSizedKey(idx::contenthelpers::toBigEndianByteOrder(key));
-			uint8_t const * rawValue = idx::contenthelpers::interpretAsByteArray(fixedSizedKey);
+			auto const & fixedSizedKey = idx::contenthelpers::toByteComparableKey(key);
+			auto rawValue = idx::contenthelpers::interpretAsByteArray(fixedSizedKey);
 
 			for(int i=0; i < stackIndex; ++i) {
 				bool isNodeEntryValid = (*nodeStack[i+1] == (*nodeStack[i]->search(rawValue)));
@@ -123,6 +163,549 @@ std::shared_ptr<hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthe
 	return hotSingleThreaded;
 }
 
+template<typename ValueType>
+void testBulkLoad(std::vector<ValueType> const &values) {
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthelpers::IdentityKeyExtractor>;
+
+	//works only because key == value
+	std::set<ValueType, typename idx::contenthelpers::KeyComparator<ValueType>::type> temporarySet(values.begin(), values.end());
+	std::vector<ValueType> sortedValues(temporarySet.begin(), temporarySet.end());
+
+	std::shared_ptr<TrieType> incrementalTrie = insertWithoutCheck(values);
+	TrieType bulkLoadedTrie;
+	BOOST_REQUIRE_EQUAL(bulkLoadedTrie.bulkLoad(sortedValues.begin(), sortedValues.end()), sortedValues.size());
+
+	bool subtreeValid = isSubTreeValid<ValueType, idx::contenthelpers::IdentityKeyExtractor>(&(bulkLoadedTrie.mRoot));
+	BOOST_REQUIRE(subtreeValid);
+	BOOST_REQUIRE_EQUAL(bulkLoadedTrie.getHeight(), incrementalTrie->getHeight());
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(bulkLoadedTrie.begin(), bulkLoadedTrie.end(), sortedValues.begin(), sortedValues.end());
+
+	for(ValueType const & value : sortedValues) {
+		BOOST_REQUIRE(bulkLoadedTrie.lookup(value).compliesWith({ true, value }));
+	}
+}
+
+template<typename ValueType>
+void testParallelBulkLoad(std::vector<ValueType> const &sortedValues, size_t numberThreads) {
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthelpers::IdentityKeyExtractor>;
+
+	TrieType sequentiallyLoadedTrie;
+	size_t numberSequentiallyLoadedValues = sequentiallyLoadedTrie.bulkLoad(sortedValues.begin(), sortedValues.end());
+
+	TrieType parallelLoadedTrie;
+	size_t numberParallelLoadedValues = 0u;
+	tbb::task_arena arena(static_cast<int>(numberThreads));
+	arena.execute([&]() {
+		numberParallelLoadedValues = hot::singlethreaded::bulkLoadParallel(parallelLoadedTrie, sortedValues.begin(), sortedValues.end());
+	});
+	BOOST_REQUIRE_EQUAL(numberParallelLoadedValues, numberSequentiallyLoadedValues);
+
+	bool subtreeValid = isSubTreeValid<ValueType, idx::contenthelpers::IdentityKeyExtractor>(&(parallelLoadedTrie.mRoot));
+	BOOST_REQUIRE(subtreeValid);
+	BOOST_REQUIRE_EQUAL(parallelLoadedTrie.getHeight(), sequentiallyLoadedTrie.getHeight());
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(parallelLoadedTrie.begin(), parallelLoadedTrie.end(), sequentiallyLoadedTrie.begin(), sequentiallyLoadedTrie.end());
+
+	for(ValueType const & value : sortedValues) {
+		BOOST_REQUIRE(parallelLoadedTrie.lookup(value).compliesWith({ true, value }));
+	}
+}
+
+template<typename ValueType>
+void testRemoveRange(std::vector<ValueType> const &values, std::vector<std::pair<ValueType, ValueType>> const & ranges) {
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthelpers::IdentityKeyExtractor>;
+	typename idx::contenthelpers::KeyComparator<ValueType>::type compareKeys;
+
+	//works only because key == value
+	std::set<ValueType, typename idx::contenthelpers::KeyComparator<ValueType>::type> expectedValues(values.begin(), values.end());
+	std::shared_ptr<TrieType> trie = insertWithoutCheck(values);
+
+	for(std::pair<ValueType, ValueType> const & range : ranges) {
+		size_t numberExpectedRemovedValues = 0u;
+		if(!compareKeys(range.second, range.first)) {
+			auto rangeBegin = expectedValues.lower_bound(range.first);
+			auto rangeEnd = expectedValues.upper_bound(range.second);
+			numberExpectedRemovedValues = static_cast<size_t>(std::distance(rangeBegin, rangeEnd));
+			expectedValues.erase(rangeBegin, rangeEnd);
+		}
+
+		BOOST_REQUIRE_EQUAL(trie->removeRange(range.first, range.second), numberExpectedRemovedValues);
+		bool subtreeValid = isSubTreeValid<ValueType, idx::contenthelpers::IdentityKeyExtractor>(&(trie->mRoot));
+		BOOST_REQUIRE(subtreeValid);
+		BOOST_REQUIRE_EQUAL_COLLECTIONS(trie->begin(), trie->end(), expectedValues.begin(), expectedValues.end());
+	}
+
+	for(ValueType const & value : values) {
+		BOOST_REQUIRE_EQUAL(trie->lookup(value).mIsValid, expectedValues.find(value) != expectedValues.end());
+	}
+
+	//the trie remains fully functional after removing ranges
+	for(ValueType const & value : values) {
+		trie->insert(value);
+	}
+	bool subtreeValid = isSubTreeValid<ValueType, idx::contenthelpers::IdentityKeyExtractor>(&(trie->mRoot));
+	BOOST_REQUIRE(subtreeValid);
+	std::set<ValueType, typename idx::contenthelpers::KeyComparator<ValueType>::type> allValues(values.begin(), values.end());
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(trie->begin(), trie->end(), allValues.begin(), allValues.end());
+}
+
+template<typename ValueType>
+void testRemoveBatch(std::vector<ValueType> const &values, std::vector<std::vector<ValueType>> const & batches) {
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthelpers::IdentityKeyExtractor>;
+	using KeyComparatorType = typename idx::contenthelpers::KeyComparator<ValueType>::type;
+
+	//works only because key == value
+	std::set<ValueType, KeyComparatorType> expectedValues(values.begin(), values.end());
+	std::shared_ptr<TrieType> trie = insertWithoutCheck(values);
+
+	for(std::vector<ValueType> batch : batches) {
+		std::sort(batch.begin(), batch.end(), KeyComparatorType());
+		size_t numberExpectedRemovedValues = 0u;
+		for(ValueType const & key : batch) {
+			numberExpectedRemovedValues += expectedValues.erase(key);
+		}
+
+		BOOST_REQUIRE_EQUAL(trie->removeBatch(batch.data(), batch.size()), numberExpectedRemovedValues);
+		bool subtreeValid = isSubTreeValid<ValueType, idx::contenthelpers::IdentityKeyExtractor>(&(trie->mRoot));
+		BOOST_REQUIRE(subtreeValid);
+		BOOST_REQUIRE_EQUAL_COLLECTIONS(trie->begin(), trie->end(), expectedValues.begin(), expectedValues.end());
+	}
+
+	for(ValueType const & value : values) {
+		BOOST_REQUIRE_EQUAL(trie->lookup(value).mIsValid, expectedValues.find(value) != expectedValues.end());
+	}
+
+	//the trie remains fully functional after removing batches
+	for(ValueType const & value : values) {
+		trie->insert(value);
+	}
+	bool subtreeValid = isSubTreeValid<ValueType, idx::contenthelpers::IdentityKeyExtractor>(&(trie->mRoot));
+	BOOST_REQUIRE(subtreeValid);
+	std::set<ValueType, KeyComparatorType> allValues(values.begin(), values.end());
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(trie->begin(), trie->end(), allValues.begin(), allValues.end());
+}
+
+template<typename ValueType>
+void testScanRange(std::vector<ValueType> const &values, std::vector<std::pair<ValueType, ValueType>> const & ranges) {
+	using KeyComparatorType = typename idx::contenthelpers::KeyComparator<ValueType>::type;
+	KeyComparatorType compareKeys;
+
+	//works only because key == value
+	std::set<ValueType, KeyComparatorType> expectedValues(values.begin(), values.end());
+	std::shared_ptr<hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthelpers::IdentityKeyExtractor>> trie = insertWithoutCheck(values);
+
+	std::vector<ValueType> scannedValues;
+	auto collectBatch = [&](ValueType const * batch, size_t numberValues) {
+		BOOST_REQUIRE_GT(numberValues, 0u);
+		BOOST_REQUIRE_LE(numberValues, hot::singlethreaded::MAXIMUM_NUMBER_NODE_ENTRIES);
+		scannedValues.insert(scannedValues.end(), batch, batch + numberValues);
+	};
+
+	for(std::pair<ValueType, ValueType> const & range : ranges) {
+		auto rangeStart = expectedValues.lower_bound(range.first);
+		auto rangeEnd = compareKeys(range.second, range.first) ? rangeStart : expectedValues.upper_bound(range.second);
+
+		scannedValues.clear();
+		BOOST_REQUIRE_EQUAL(trie->scanRange(range.first, range.second, collectBatch), static_cast<size_t>(std::distance(rangeStart, rangeEnd)));
+		BOOST_REQUIRE_EQUAL_COLLECTIONS(scannedValues.begin(), scannedValues.end(), rangeStart, rangeEnd);
+
+		for(size_t limit : { 0u, 1u, 2u, 31u, 32u, 33u, 1000u }) {
+			std::vector<ValueType> expectedScannedValues;
+			for(auto it = rangeStart; it != expectedValues.end() && expectedScannedValues.size() < limit; ++it) {
+				expectedScannedValues.push_back(*it);
+			}
+
+			scannedValues.clear();
+			BOOST_REQUIRE_EQUAL(trie->scanRangeWithLimit(range.first, limit, collectBatch), expectedScannedValues.size());
+			BOOST_REQUIRE_EQUAL_COLLECTIONS(scannedValues.begin(), scannedValues.end(), expectedScannedValues.begin(), expectedScannedValues.end());
+		}
+	}
+}
+
+void testPrefixScan(std::vector<char const *> const &values, std::vector<std::string> const & prefixes) {
+	using KeyComparatorType = typename idx::contenthelpers::KeyComparator<char const *>::type;
+
+	//works only because key == value
+	std::set<char const *, KeyComparatorType> expectedValues(values.begin(), values.end());
+	std::shared_ptr<hot::singlethreaded::HOTSingleThreaded<char const *, idx::contenthelpers::IdentityKeyExtractor>> trie = insertWithoutCheck(values);
+
+	std::vector<char const *> scannedValues;
+	auto collectBatch = [&](char const * const * batch, size_t numberValues) {
+		BOOST_REQUIRE_GT(numberValues, 0u);
+		BOOST_REQUIRE_LE(numberValues, hot::singlethreaded::MAXIMUM_NUMBER_NODE_ENTRIES);
+		scannedValues.insert(scannedValues.end(), batch, batch + numberValues);
+	};
+
+	for(std::string const & prefix : prefixes) {
+		std::vector<char const *> expectedScannedValues;
+		for(auto it = expectedValues.lower_bound(prefix.c_str()); it != expectedValues.end() && std::strncmp(*it, prefix.c_str(), prefix.size()) == 0; ++it) {
+			expectedScannedValues.push_back(*it);
+		}
+
+		scannedValues.clear();
+		BOOST_REQUIRE_EQUAL(trie->prefixScan(prefix.c_str(), prefix.size(), collectBatch), expectedScannedValues.size());
+		BOOST_REQUIRE_EQUAL_COLLECTIONS(scannedValues.begin(), scannedValues.end(), expectedScannedValues.begin(), expectedScannedValues.end());
+	}
+}
+
+void testLongestPrefixMatch(std::vector<char const *> const &values, std::vector<std::string> const & searchKeys) {
+	using KeyComparatorType = typename idx::contenthelpers::KeyComparator<char const *>::type;
+
+	//works only because key == value
+	std::set<char const *, KeyComparatorType> expectedValues(values.begin(), values.end());
+	std::shared_ptr<hot::singlethreaded::HOTSingleThreaded<char const *, idx::contenthelpers::IdentityKeyExtractor>> trie = insertWithoutCheck(values);
+
+	for(std::string const & searchKey : searchKeys) {
+		idx::contenthelpers::OptionalValue<char const *> expectedMatch;
+		for(size_t prefixLength = searchKey.size() + 1u; prefixLength-- > 0u && !expectedMatch.mIsValid;) {
+			auto it = expectedValues.find(searchKey.substr(0u, prefixLength).c_str());
+			if(it != expectedValues.end()) {
+				expectedMatch = idx::contenthelpers::OptionalValue<char const *>(true, *it);
+			}
+		}
+
+		idx::contenthelpers::OptionalValue<char const *> const & match = trie->longestPrefixMatch(searchKey.c_str());
+		BOOST_REQUIRE_EQUAL(match.mIsValid, expectedMatch.mIsValid);
+		if(match.mIsValid) {
+			BOOST_REQUIRE_EQUAL(match.mValue, expectedMatch.mValue);
+		}
+	}
+}
+
+template<typename ValueType>
+void testReverseIteration(std::vector<ValueType> const &values, std::vector<ValueType> const & probeKeys) {
+	using KeyComparatorType = typename idx::contenthelpers::KeyComparator<ValueType>::type;
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthelpers::IdentityKeyExtractor>;
+
+	//works only because key == value
+	std::set<ValueType, KeyComparatorType> expectedValues(values.begin(), values.end());
+	std::shared_ptr<TrieType> trie = insertWithoutCheck(values);
+
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(trie->rbegin(), trie->rend(), expectedValues.rbegin(), expectedValues.rend());
+
+	typename TrieType::const_iterator first = trie->begin();
+	BOOST_REQUIRE(--first == trie->end());
+	BOOST_REQUIRE(--first == trie->end());
+
+	for(ValueType const & probeKey : probeKeys) {
+		for(bool isFloor : { true, false }) {
+			//the last entry not larger (floor) or smaller (predecessor) than the probe key
+			auto expected = isFloor ? expectedValues.upper_bound(probeKey) : expectedValues.lower_bound(probeKey);
+			typename TrieType::const_iterator actual = isFloor ? trie->floor(probeKey) : trie->predecessor(probeKey);
+			if(expected == expectedValues.begin()) {
+				BOOST_REQUIRE(actual == trie->end());
+				continue;
+			}
+			--expected;
+			BOOST_REQUIRE(actual != trie->end());
+			BOOST_REQUIRE_EQUAL(*actual, *expected);
+
+			//traverses backwards and afterwards forwards again starting at the determined entry
+			typename TrieType::const_iterator current = actual;
+			auto expectedCurrent = expected;
+			size_t numberSteps = 0u;
+			while(numberSteps < 40u && expectedCurrent != expectedValues.begin()) {
+				--current;
+				--expectedCurrent;
+				++numberSteps;
+				BOOST_REQUIRE(current != trie->end());
+				BOOST_REQUIRE_EQUAL(*current, *expectedCurrent);
+			}
+			if(numberSteps < 40u) {
+				BOOST_REQUIRE(--typename TrieType::const_iterator(current) == trie->end());
+			}
+			for(size_t i = 0u; i < numberSteps; ++i) {
+				++current;
+			}
+			BOOST_REQUIRE(current == actual);
+		}
+	}
+}
+
+template<typename ValueType, typename ValueSet>
+void checkSnapshot(hot::singlethreaded::HOTSingleThreadedSnapshot<ValueType, idx::contenthelpers::IdentityKeyExtractor> const & snapshot, ValueSet const & expectedValues, std::vector<ValueType> const & probeKeys) {
+	BOOST_REQUIRE_EQUAL(snapshot.isEmpty(), expectedValues.empty());
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(snapshot.begin(), snapshot.end(), expectedValues.begin(), expectedValues.end());
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(snapshot.rbegin(), snapshot.rend(), expectedValues.rbegin(), expectedValues.rend());
+	for(ValueType const & probeKey : probeKeys) {
+		bool isContained = expectedValues.find(probeKey) != expectedValues.end();
+		BOOST_REQUIRE_EQUAL(snapshot.lookup(probeKey).mIsValid, isContained);
+		BOOST_REQUIRE_EQUAL(snapshot.find(probeKey) != snapshot.end(), isContained);
+		auto expectedLowerBound = expectedValues.lower_bound(probeKey);
+		auto actualLowerBound = snapshot.lower_bound(probeKey);
+		BOOST_REQUIRE_EQUAL(actualLowerBound == snapshot.end(), expectedLowerBound == expectedValues.end());
+		if(expectedLowerBound != expectedValues.end()) {
+			BOOST_REQUIRE_EQUAL(*actualLowerBound, *expectedLowerBound);
+		}
+	}
+}
+
+template<typename ValueType>
+void testSnapshots(std::vector<ValueType> const &values, size_t numberRounds) {
+	using KeyComparatorType = typename idx::contenthelpers::KeyComparator<ValueType>::type;
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthelpers::IdentityKeyExtractor>;
+	using SnapshotType = hot::singlethreaded::HOTSingleThreadedSnapshot<ValueType, idx::contenthelpers::IdentityKeyExtractor>;
+	using ValueSet = std::set<ValueType, KeyComparatorType>;
+
+	//works only because key == value
+	TrieType trie;
+	ValueSet expectedValues;
+	for(size_t i = 0u; i < values.size(); i += 2u) {
+		trie.insert(values[i]);
+		expectedValues.insert(values[i]);
+	}
+
+	std::vector<std::pair<SnapshotType, ValueSet>> snapshots;
+	size_t roundSize = values.size() / numberRounds;
+	for(size_t round = 0u; round < numberRounds; ++round) {
+		snapshots.emplace_back(trie.snapshot(), expectedValues);
+		//every third round the oldest live snapshot is released
+		if((round % 3u) == 2u) {
+			snapshots.erase(snapshots.begin());
+		}
+
+		//the values of each round, which were not inserted initially, are inserted. Of the others every second is removed and every second upserted.
+		size_t roundBegin = round * roundSize;
+		for(size_t i = roundBegin; i < roundBegin + roundSize; ++i) {
+			if((i % 2u) == 1u) {
+				BOOST_REQUIRE_EQUAL(trie.insert(values[i]), expectedValues.insert(values[i]).second);
+			} else if((i % 4u) == 0u) {
+				BOOST_REQUIRE_EQUAL(trie.remove(values[i]), expectedValues.erase(values[i]) == 1u);
+			} else {
+				BOOST_REQUIRE_EQUAL(trie.upsert(values[i]).mIsValid, !expectedValues.insert(values[i]).second);
+			}
+		}
+
+		if(expectedValues.size() > 16u) {
+			std::vector<ValueType> sortedValues(expectedValues.begin(), expectedValues.end());
+			size_t rangeBegin = (round * 7919u) % (sortedValues.size() - 16u);
+			BOOST_REQUIRE_EQUAL(trie.removeRange(sortedValues[rangeBegin], sortedValues[rangeBegin + 7u]), 8u);
+			std::vector<ValueType> batch;
+			for(size_t i = rangeBegin + 8u; i < sortedValues.size(); i += 5u) {
+				batch.push_back(sortedValues[i]);
+			}
+			BOOST_REQUIRE_EQUAL(trie.removeBatch(batch.data(), batch.size()), batch.size());
+			expectedValues.erase(expectedValues.find(sortedValues[rangeBegin]), expectedValues.upper_bound(sortedValues[rangeBegin + 7u]));
+			for(ValueType const & removedValue : batch) {
+				expectedValues.erase(removedValue);
+			}
+		}
+
+		bool subtreeValid = isSubTreeValid<ValueType, idx::contenthelpers::IdentityKeyExtractor>(&(trie.mRoot));
+		BOOST_REQUIRE(subtreeValid);
+		BOOST_REQUIRE_EQUAL_COLLECTIONS(trie.begin(), trie.end(), expectedValues.begin(), expectedValues.end());
+		BOOST_REQUIRE_GT(trie.getNumberRetiredNodes(), 0u);
+
+		//each live snapshot still contains the values at the time it was taken
+		for(std::pair<SnapshotType, ValueSet> const & snapshot : snapshots) {
+			checkSnapshot(snapshot.first, snapshot.second, std::vector<ValueType>(values.begin() + roundBegin, values.begin() + roundBegin + roundSize));
+		}
+	}
+
+	//once all snapshots are released, the retired nodes are freed by the next modification
+	snapshots.clear();
+	trie.insert(values[0]);
+	expectedValues.insert(values[0]);
+	BOOST_REQUIRE_EQUAL(trie.getNumberRetiredNodes(), 0u);
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(trie.begin(), trie.end(), expectedValues.begin(), expectedValues.end());
+
+	//without live snapshots all nodes are modified in place again
+	for(ValueType const & value : values) {
+		trie.remove(value);
+	}
+	BOOST_REQUIRE(trie.isEmpty());
+	BOOST_REQUIRE_EQUAL(trie.getNumberRetiredNodes(), 0u);
+}
+
+template<typename ValueType>
+void testSaveAndLoad(std::vector<ValueType> const & values) {
+	using KeyComparatorType = typename idx::contenthelpers::KeyComparator<ValueType>::type;
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthelpers::IdentityKeyExtractor>;
+
+	//works only because key == value
+	TrieType trie;
+	std::set<ValueType, KeyComparatorType> expectedValues;
+	for(ValueType const & value : values) {
+		trie.insert(value);
+		expectedValues.insert(value);
+	}
+
+	std::string filePath = "hot-single-threaded-test-save-and-load.bin";
+	BOOST_REQUIRE(trie.save(filePath));
+	TrieType loadedTrie;
+	loadedTrie.insert(values[0]);
+	BOOST_REQUIRE(loadedTrie.load(filePath));
+	std::remove(filePath.c_str());
+
+	//the loaded trie consists of identical copies of the saved nodes
+	BOOST_REQUIRE_EQUAL(loadedTrie.isEmpty(), trie.isEmpty());
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(loadedTrie.begin(), loadedTrie.end(), expectedValues.begin(), expectedValues.end());
+	if(trie.isRootANode()) {
+		BOOST_REQUIRE(loadedTrie.mRoot.getNode() != trie.mRoot.getNode());
+		BOOST_REQUIRE(loadedTrie.mRoot.getNodeType() == trie.mRoot.getNodeType());
+		bool subtreeValid = isSubTreeValid<ValueType, idx::contenthelpers::IdentityKeyExtractor>(&(loadedTrie.mRoot));
+		BOOST_REQUIRE(subtreeValid);
+		BOOST_REQUIRE_EQUAL(loadedTrie.getHeight(), trie.getHeight());
+		//the nodes are placed differently in memory
+		std::pair<size_t, std::map<std::string, double>> loadedStatistics = loadedTrie.getStatistics();
+		std::pair<size_t, std::map<std::string, double>> statistics = trie.getStatistics();
+		loadedStatistics.second.erase("averageParentChildAddressDistance");
+		statistics.second.erase("averageParentChildAddressDistance");
+		BOOST_REQUIRE(loadedStatistics == statistics);
+	} else {
+		BOOST_REQUIRE(loadedTrie.mRoot == trie.mRoot);
+	}
+	for(ValueType const & value : values) {
+		BOOST_REQUIRE(loadedTrie.lookup(value).mIsValid);
+	}
+
+	//the loaded trie can be modified like any other trie without affecting the saved trie
+	std::set<ValueType, KeyComparatorType> savedValues = expectedValues;
+	for(size_t i = 0u; i < values.size(); i += 2u) {
+		BOOST_REQUIRE_EQUAL(loadedTrie.remove(values[i]), expectedValues.erase(values[i]) == 1u);
+	}
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(loadedTrie.begin(), loadedTrie.end(), expectedValues.begin(), expectedValues.end());
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(trie.begin(), trie.end(), savedValues.begin(), savedValues.end());
+}
+
+template<typename ValueType, typename SetType, typename IteratorType> void checkFrozenBound(SetType const & expectedValues, typename SetType::const_iterator const & expectedBound, IteratorType const & bound, IteratorType const & end) {
+	BOOST_REQUIRE_EQUAL(bound == end, expectedBound == expectedValues.end());
+	if(expectedBound != expectedValues.end()) {
+		BOOST_REQUIRE(idx::contenthelpers::contentEquals(*bound, *expectedBound));
+	}
+}
+
+template<typename ValueType>
+void testFreeze(std::vector<ValueType> const & values, std::vector<ValueType> const & probeKeys) {
+	using KeyComparatorType = typename idx::contenthelpers::KeyComparator<ValueType>::type;
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthelpers::IdentityKeyExtractor>;
+
+	//works only because key == value
+	TrieType trie;
+	std::set<ValueType, KeyComparatorType> expectedValues;
+	for(ValueType const & value : values) {
+		trie.insert(value);
+		expectedValues.insert(value);
+	}
+
+	hot::singlethreaded::HOTSingleThreadedFrozen<ValueType, idx::contenthelpers::IdentityKeyExtractor> frozenTrie = trie.freeze();
+	BOOST_REQUIRE_EQUAL(frozenTrie.getNumberValues(), expectedValues.size());
+	BOOST_REQUIRE_EQUAL(frozenTrie.getHeight(), trie.getHeight());
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(frozenTrie.begin(), frozenTrie.end(), expectedValues.begin(), expectedValues.end());
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(frozenTrie.rbegin(), frozenTrie.rend(), expectedValues.rbegin(), expectedValues.rend());
+	if(trie.isRootANode() && expectedValues.size() > 1000u) {
+		BOOST_REQUIRE_LT(frozenTrie.getSizeInBytes(), trie.getStatistics().first);
+	}
+
+	for(ValueType const & value : values) {
+		idx::contenthelpers::OptionalValue<ValueType> const & result = frozenTrie.lookup(value);
+		BOOST_REQUIRE(result.mIsValid);
+		BOOST_REQUIRE(idx::contenthelpers::contentEquals(result.mValue, value));
+	}
+
+	for(ValueType const & probeKey : probeKeys) {
+		auto expectedMatch = expectedValues.find(probeKey);
+		BOOST_REQUIRE_EQUAL(frozenTrie.lookup(probeKey).mIsValid, expectedMatch != expectedValues.end());
+		checkFrozenBound<ValueType>(expectedValues, expectedMatch, frozenTrie.find(probeKey), frozenTrie.end());
+		checkFrozenBound<ValueType>(expectedValues, expectedValues.lower_bound(probeKey), frozenTrie.lower_bound(probeKey), frozenTrie.end());
+		checkFrozenBound<ValueType>(expectedValues, expectedValues.upper_bound(probeKey), frozenTrie.upper_bound(probeKey), frozenTrie.end());
+	}
+
+	//the frozen trie is independent of the trie it was created from
+	trie.remove(values[0]);
+	BOOST_REQUIRE(frozenTrie.lookup(values[0]).mIsValid);
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(frozenTrie.begin(), frozenTrie.end(), expectedValues.begin(), expectedValues.end());
+}
+
+#ifdef USE_ORDER_STATISTICS
+template<typename ValueType>
+void checkOrderStatistics(hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthelpers::IdentityKeyExtractor> const & trie, std::vector<ValueType> const & sortedValues, std::vector<ValueType> const & probeKeys) {
+	using KeyComparatorType = typename idx::contenthelpers::KeyComparator<ValueType>::type;
+	KeyComparatorType compareKeys;
+
+	size_t numberValues = sortedValues.size();
+	size_t stepSize = std::max<size_t>(1u, numberValues / 200u);
+	for(size_t i = 0u; i < numberValues; i += stepSize) {
+		BOOST_REQUIRE_EQUAL(trie.rank(sortedValues[i]), i);
+		BOOST_REQUIRE(trie.select(i) != trie.end());
+		BOOST_REQUIRE_EQUAL(*trie.select(i), sortedValues[i]);
+		BOOST_REQUIRE(trie.scan(sortedValues[i], numberValues - i - 1).compliesWith({ true, sortedValues[numberValues - 1] }));
+		BOOST_REQUIRE(!trie.scan(sortedValues[i], numberValues - i).mIsValid);
+		BOOST_REQUIRE_EQUAL(trie.count(sortedValues[i], sortedValues[numberValues - 1 - i]), (2 * i < numberValues) ? (numberValues - 2 * i) : 0u);
+	}
+	BOOST_REQUIRE(trie.select(numberValues) == trie.end());
+
+	for(ValueType const & key : probeKeys) {
+		size_t expectedRank = static_cast<size_t>(std::lower_bound(sortedValues.begin(), sortedValues.end(), key, compareKeys) - sortedValues.begin());
+		size_t expectedUpperRank = static_cast<size_t>(std::upper_bound(sortedValues.begin(), sortedValues.end(), key, compareKeys) - sortedValues.begin());
+		BOOST_REQUIRE_EQUAL(trie.rank(key), expectedRank);
+		BOOST_REQUIRE_EQUAL(trie.count(key, key), expectedUpperRank - expectedRank);
+		if(numberValues > 0u) {
+			BOOST_REQUIRE_EQUAL(trie.count(key, sortedValues[numberValues - 1]), compareKeys(sortedValues[numberValues - 1], key) ? 0u : numberValues - expectedRank);
+			BOOST_REQUIRE_EQUAL(trie.count(sortedValues[0], key), expectedUpperRank);
+		}
+		idx::contenthelpers::OptionalValue<ValueType> const & scanResult = trie.scan(key, 1u);
+		BOOST_REQUIRE_EQUAL(scanResult.mIsValid, expectedRank + 1u < numberValues);
+		if(scanResult.mIsValid) {
+			BOOST_REQUIRE_EQUAL(scanResult.mValue, sortedValues[expectedRank + 1u]);
+		}
+	}
+}
+
+template<typename ValueType>
+void testOrderStatistics(std::vector<ValueType> const & values, std::vector<ValueType> const & probeKeys) {
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthelpers::IdentityKeyExtractor>;
+	using KeyComparatorType = typename idx::contenthelpers::KeyComparator<ValueType>::type;
+
+	//works only because key == value
+	std::set<ValueType, KeyComparatorType> expectedValues(values.begin(), values.end());
+	std::shared_ptr<TrieType> trie = insertWithoutCheck(values);
+	checkOrderStatistics(*trie, std::vector<ValueType>(expectedValues.begin(), expectedValues.end()), probeKeys);
+
+	TrieType bulkLoadedTrie;
+	bulkLoadedTrie.bulkLoad(expectedValues.begin(), expectedValues.end());
+	bool bulkLoadedSubtreeValid = isSubTreeValid<ValueType, idx::contenthelpers::IdentityKeyExtractor>(&(bulkLoadedTrie.mRoot));
+	BOOST_REQUIRE(bulkLoadedSubtreeValid);
+	checkOrderStatistics(bulkLoadedTrie, std::vector<ValueType>(expectedValues.begin(), expectedValues.end()), probeKeys);
+
+	//every third value is removed individually
+	for(size_t i = 0u; i < values.size(); i += 3u) {
+		trie->remove(values[i]);
+		expectedValues.erase(values[i]);
+	}
+	bool subtreeValid = isSubTreeValid<ValueType, idx::contenthelpers::IdentityKeyExtractor>(&(trie->mRoot));
+	BOOST_REQUIRE(subtreeValid);
+	checkOrderStatistics(*trie, std::vector<ValueType>(expectedValues.begin(), expectedValues.end()), probeKeys);
+
+	if(expectedValues.size() > 4u) {
+		//a range in the middle and a sorted batch of every other remaining value are removed
+		std::vector<ValueType> remainingValues(expectedValues.begin(), expectedValues.end());
+		ValueType lowerKey = remainingValues[remainingValues.size() / 4u];
+		ValueType upperKey = remainingValues[remainingValues.size() / 2u];
+		trie->removeRange(lowerKey, upperKey);
+		expectedValues.erase(expectedValues.lower_bound(lowerKey), expectedValues.upper_bound(upperKey));
+
+		std::vector<ValueType> batch;
+		for(size_t i = 0u; i < remainingValues.size(); i += 2u) {
+			batch.push_back(remainingValues[i]);
+			expectedValues.erase(remainingValues[i]);
+		}
+		trie->removeBatch(batch.data(), batch.size());
+		subtreeValid = isSubTreeValid<ValueType, idx::contenthelpers::IdentityKeyExtractor>(&(trie->mRoot));
+		BOOST_REQUIRE(subtreeValid);
+		checkOrderStatistics(*trie, std::vector<ValueType>(expectedValues.begin(), expectedValues.end()), probeKeys);
+	}
+
+	//reinserting all values including upserts of existing values restores the initial order statistics
+	for(ValueType const & value : values) {
+		trie->upsert(value);
+	}
+	subtreeValid = isSubTreeValid<ValueType, idx::contenthelpers::IdentityKeyExtractor>(&(trie->mRoot));
+	BOOST_REQUIRE(subtreeValid);
+	std::set<ValueType, KeyComparatorType> allValues(values.begin(), values.end());
+	checkOrderStatistics(*trie, std::vector<ValueType>(allValues.begin(), allValues.end()), probeKeys);
+}
+#endif
+
 template<typename ValueType>
 std::shared_ptr<hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthelpers::IdentityKeyExtractor>> testValues(std::vector<ValueType> const &valuesToInsert, int expectedLevel=-1) {
 	std::shared_ptr<hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthelpers::IdentityKeyExtractor>> hotSingleThreaded = std::make_shared<hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthelpers::IdentityKeyExtractor>>();
@@ -244,6 +827,128 @@ std::shared_ptr<hot::singlethreaded::HOTSingleThreaded<ValueType, idx::contenthe
 	//std::cout << "Checked Integrity" << std::endl;
 }
 
+//generates distinct binary keys, which contain zero bytes but do not end with one, as keys only differing in trailing zero bytes are considered equal
+std::vector<std::string> getBinaryKeysWithZeroBytes(size_t numberKeys) {
+	std::set<std::string> keys { std::string("a"), std::string("\0a", 2u), std::string("\0\0a", 3u), std::string("a\0a", 3u), std::string("a\x01", 2u), std::string("\xff\0\xff", 3u) };
+	std::mt19937 randomGenerator(42u);
+	std::uniform_int_distribution<size_t> lengthDistribution(1u, 64u);
+	std::uniform_int_distribution<int> byteDistribution(0, 255);
+	while(keys.size() < numberKeys) {
+		std::string key(lengthDistribution(randomGenerator), '\0');
+		for(char & keyByte : key) {
+			int byteClass = byteDistribution(randomGenerator);
+			keyByte = static_cast<char>((byteClass < 96) ? 0 : byteDistribution(randomGenerator));
+		}
+		key.back() = static_cast<char>(1 + byteDistribution(randomGenerator) % 255);
+		keys.insert(key);
+	}
+	return { keys.begin(), keys.end() };
+}
+
+template<typename KeyType> void testLengthDelimitedKeys(std::vector<std::string> const & keyStrings) {
+	using EntryType = std::pair<KeyType, uint64_t>;
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<EntryType*, idx::contenthelpers::PairPointerKeyExtractor>;
+
+	std::vector<EntryType> entries;
+	for(size_t i = 0u; i < keyStrings.size(); ++i) {
+		entries.push_back({ KeyType { keyStrings[i].data(), keyStrings[i].size() }, i });
+	}
+
+	TrieType trie;
+	for(EntryType & entry : entries) {
+		BOOST_REQUIRE(trie.insert(&entry));
+	}
+	BOOST_REQUIRE((isSubTreeValid<EntryType*, idx::contenthelpers::PairPointerKeyExtractor>(&trie.mRoot)));
+
+	std::set<std::string> const keySet(keyStrings.begin(), keyStrings.end());
+	for(size_t i = 0u; i < keyStrings.size(); ++i) {
+		std::string const keyCopy = keyStrings[i];
+		EntryType duplicate { KeyType { keyCopy.data(), keyCopy.size() }, i };
+		BOOST_REQUIRE(!trie.insert(&duplicate));
+
+		idx::contenthelpers::OptionalValue<EntryType*> const & result = trie.lookup(KeyType { keyCopy.data(), keyCopy.size() });
+		BOOST_REQUIRE(result.mIsValid);
+		BOOST_REQUIRE_EQUAL(result.mValue->second, i);
+
+		std::string const missingKey = keyCopy + std::string("\0\x01", 2u);
+		if(keySet.find(missingKey) == keySet.end()) {
+			BOOST_REQUIRE(!trie.lookup(KeyType { missingKey.data(), missingKey.size() }).mIsValid);
+		}
+	}
+
+	std::vector<std::string> sortedKeys(keySet.begin(), keySet.end());
+	std::vector<std::string> iteratedKeys;
+	for(EntryType* entry : trie) {
+		iteratedKeys.push_back(keyStrings[entry->second]);
+	}
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(iteratedKeys.begin(), iteratedKeys.end(), sortedKeys.begin(), sortedKeys.end());
+
+	for(size_t i = 0u; i < keyStrings.size(); i += 2u) {
+		std::string const keyCopy = keyStrings[i];
+		BOOST_REQUIRE(trie.remove(KeyType { keyCopy.data(), keyCopy.size() }));
+	}
+	BOOST_REQUIRE((isSubTreeValid<EntryType*, idx::contenthelpers::PairPointerKeyExtractor>(&trie.mRoot)));
+	for(size_t i = 0u; i < keyStrings.size(); ++i) {
+		BOOST_REQUIRE_EQUAL(trie.lookup(KeyType { keyStrings[i].data(), keyStrings[i].size() }).mIsValid, (i % 2u) == 1u);
+	}
+}
+
+template<typename KeyType> void testOrderPreservingEncodedKeys(std::vector<KeyType> const & keys) {
+	using EntryType = std::pair<KeyType, uint64_t>;
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<EntryType*, idx::contenthelpers::PairPointerKeyExtractor>;
+
+	std::vector<EntryType> entries;
+	//std::less and operator== would neither order nor find NaN keys
+	std::set<KeyType, typename idx::contenthelpers::KeyComparator<KeyType>::type> expectedKeys;
+	for(size_t i = 0u; i < keys.size(); ++i) {
+		entries.push_back({ keys[i], i });
+	}
+
+	TrieType trie;
+	for(EntryType & entry : entries) {
+		BOOST_REQUIRE_EQUAL(trie.insert(&entry), expectedKeys.insert(entry.first).second);
+	}
+	BOOST_REQUIRE((isSubTreeValid<EntryType*, idx::contenthelpers::PairPointerKeyExtractor>(&trie.mRoot)));
+
+	std::vector<KeyType> iteratedKeys;
+	for(EntryType* entry : trie) {
+		iteratedKeys.push_back(entry->first);
+	}
+	BOOST_REQUIRE(std::equal(iteratedKeys.begin(), iteratedKeys.end(), expectedKeys.begin(), expectedKeys.end(), [](KeyType const & iteratedKey, KeyType const & expectedKey) {
+		return idx::contenthelpers::contentEquals(iteratedKey, expectedKey);
+	}));
+
+	for(size_t i = 0u; i < keys.size(); ++i) {
+		idx::contenthelpers::OptionalValue<EntryType*> const & result = trie.lookup(keys[i]);
+		BOOST_REQUIRE(result.mIsValid);
+		BOOST_REQUIRE(idx::contenthelpers::contentEquals(result.mValue->first, keys[i]));
+
+		auto expectedLowerBound = expectedKeys.lower_bound(keys[i]);
+		typename TrieType::const_iterator lowerBound = trie.lower_bound(keys[i]);
+		BOOST_REQUIRE(idx::contenthelpers::contentEquals((*lowerBound)->first, *expectedLowerBound));
+	}
+
+	for(size_t i = 0u; i < keys.size(); i += 2u) {
+		BOOST_REQUIRE_EQUAL(trie.remove(keys[i]), expectedKeys.erase(keys[i]) == 1u);
+	}
+	BOOST_REQUIRE((isSubTreeValid<EntryType*, idx::contenthelpers::PairPointerKeyExtractor>(&trie.mRoot)));
+	for(KeyType const & key : keys) {
+		BOOST_REQUIRE_EQUAL(trie.lookup(key).mIsValid, expectedKeys.find(key) != expectedKeys.end());
+	}
+}
+
+inline bool containsOnlySingleMaskNodes(HOTSingleThreadedChildPointer const & subtree) {
+	if(subtree.isLeaf() || subtree.getNode() == nullptr) {
+		return true;
+	}
+	bool isSingleMaskNode = subtree.getNodeType() <= hot::commons::NodeType::SINGLE_MASK_32_BIT_PARTIAL_KEYS;
+	HOTSingleThreadedNodeBase const * node = subtree.getNode();
+	for(unsigned int i = 0u; isSingleMaskNode && i < node->getNumberEntries(); ++i) {
+		isSingleMaskNode = containsOnlySingleMaskNodes(node->getPointers()[i]);
+	}
+	return isSingleMaskNode;
+}
+
 BOOST_AUTO_TEST_SUITE(HOTSingleThreadedTest)
 
 
@@ -303,6 +1008,37 @@ BOOST_AUTO_TEST_CASE(testRandomValues) {
 
 }
 
+BOOST_AUTO_TEST_CASE(testIntegerKeysOnlyResultInSingleMaskNodes) {
+	BOOST_REQUIRE(hot::commons::hasOnlySingleMaskNodeTypes(HOTSingleThreadedUint64::MAXIMUM_KEY_LENGTH));
+	BOOST_REQUIRE(!hot::commons::hasOnlySingleMaskNodeTypes(CStringTrieType::MAXIMUM_KEY_LENGTH));
+
+	std::vector<uint64_t> values;
+	idx::utils::RandomRangeGenerator<uint64_t> rnd{12344567, 0, INT64_MAX};
+	for(uint64_t i = 0u; i < 50000u; ++i) {
+		values.push_back(rnd());
+		//the discriminative bits of these values are spread over all key bytes
+		values.push_back(((i * 0x9E3779B97F4A7C15ul) ^ (i << 48u)) >> 1u);
+	}
+
+	HOTSingleThreadedUint64 insertedTrie;
+	for(uint64_t value : values) {
+		insertedTrie.insert(value);
+	}
+	std::set<uint64_t> sortedValues(values.begin(), values.end());
+	HOTSingleThreadedUint64 bulkLoadedTrie;
+	bulkLoadedTrie.bulkLoad(sortedValues.begin(), sortedValues.end());
+
+	for(size_t i = 0u; i < values.size(); i += 3u) {
+		insertedTrie.remove(values[i]);
+		bulkLoadedTrie.remove(values[i]);
+	}
+
+	for(HOTSingleThreadedUint64 const * trie : { &insertedTrie, &bulkLoadedTrie }) {
+		BOOST_REQUIRE((isSubTreeValid<uint64_t, idx::contenthelpers::IdentityKeyExtractor>(&trie->mRoot)));
+		BOOST_REQUIRE(containsOnlySingleMaskNodes(trie->mRoot));
+	}
+}
+
 BOOST_AUTO_TEST_CASE(testBoundsInteger) {
 	std::set<uint64_t> sortedValues;
 	idx::utils::RandomRangeGenerator<uint64_t> rnd{12344567, 0, INT64_MAX};
@@ -5375,6 +6111,65 @@ std::vector<std::string> getLongStrings() {
 	return strings;
 }
 
+std::vector<uint64_t> getSequentialValues(size_t numberValues, uint64_t stride) {
+	std::vector<uint64_t> values;
+	for(uint64_t i = 0u; i < numberValues; ++i) {
+		values.push_back(i * stride);
+	}
+	return values;
+}
+
+std::vector<uint64_t> getRandomValues(size_t numberValues) {
+	idx::utils::RandomRangeGenerator<uint64_t> rnd{12344567, 0, INT64_MAX};
+	std::vector<uint64_t> values;
+	for(size_t i = 0u; i < numberValues; ++i) {
+		values.push_back(rnd());
+	}
+	return values;
+}
+
+//the integer value sets each operation is tested with: sequential values with gaps between them, random values and small sets resulting in a root leaf, a single node or a node with few children
+std::vector<std::vector<uint64_t>> getIntegerValueSets() {
+	std::vector<std::vector<uint64_t>> valueSets { getSequentialValues(100000u, 2u), getRandomValues(100000u), {}, { 42u } };
+	for(size_t numberValues = 2u; numberValues < 70u; ++numberValues) {
+		valueSets.push_back(getSequentialValues(numberValues, 3u));
+	}
+	return valueSets;
+}
+
+//the smallest and largest keys and each value together with its neighbouring keys, for large sets only a sample of the values is used
+std::vector<uint64_t> getProbeKeys(std::vector<uint64_t> const & values) {
+	std::vector<uint64_t> probeKeys { 0u, INT64_MAX, UINT64_MAX };
+	size_t stride = std::max<size_t>(1u, values.size() / 1000u);
+	for(size_t i = 0u; i < values.size(); i += stride) {
+		probeKeys.push_back(values[i] - 1u);
+		probeKeys.push_back(values[i]);
+		probeKeys.push_back(values[i] + 1u);
+	}
+	return probeKeys;
+}
+
+std::vector<char const*> getProbeKeys(std::vector<char const*> const & values) {
+	return { "", "a", "m", values[0], values[values.size() / 2u], "\x7f" };
+}
+
+//ranges of increasing width starting at the probe keys of the given values, followed by a range of a single key and a range whose bounds are swapped
+std::vector<std::pair<uint64_t, uint64_t>> getRanges(std::vector<uint64_t> const & values) {
+	constexpr size_t numberRanges = 40u;
+	std::vector<uint64_t> const & probeKeys = getProbeKeys(values);
+	uint64_t largestValue = values.empty() ? 0u : *std::max_element(values.begin(), values.end());
+
+	std::vector<std::pair<uint64_t, uint64_t>> ranges;
+	for(size_t i = 0u; i < numberRanges; ++i) {
+		uint64_t lowerKey = probeKeys[(i * 7919u) % probeKeys.size()];
+		uint64_t width = largestValue >> (numberRanges - 1u - i);
+		ranges.emplace_back(lowerKey, (lowerKey > UINT64_MAX - width) ? UINT64_MAX : lowerKey + width);
+	}
+	ranges.emplace_back(largestValue / 2u, largestValue / 2u);
+	ranges.emplace_back(largestValue, largestValue / 2u);
+	return ranges;
+}
+
 BOOST_AUTO_TEST_CASE(testWithLongStringsAndNodeSplit) {
 	std::vector<std::string> const &strings = getLongStrings();
 	testValues(hot::testhelpers::stdStringsToCStrings(strings));
@@ -5504,6 +6299,1246 @@ BOOST_AUTO_TEST_CASE(testUpsert) {
 
 }
 
+BOOST_AUTO_TEST_CASE(testLookupBatch) {
+	HOTSingleThreadedUint64 hotSingleThreaded;
+	idx::utils::RandomRangeGenerator<uint64_t> rnd{12344567, 0, INT64_MAX};
+
+	std::vector<uint64_t> lookupKeys;
+	for (size_t i = 0u; i < 100000u; ++i) {
+		uint64_t value = rnd();
+		if((i%3) != 0) {
+			hotSingleThreaded.insert(value);
+		}
+		lookupKeys.push_back(value);
+	}
+
+	std::vector<idx::contenthelpers::OptionalValue<uint64_t>> results(lookupKeys.size());
+	hotSingleThreaded.lookupBatch(lookupKeys.data(), lookupKeys.size(), results.data());
+
+	for (size_t i = 0u; i < lookupKeys.size(); ++i) {
+		BOOST_REQUIRE(results[i].compliesWith(hotSingleThreaded.lookup(lookupKeys[i])));
+		BOOST_REQUIRE_EQUAL(results[i].mIsValid, (i%3) != 0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testLookupBatchWithStrings) {
+	std::vector<std::string> const &strings = getLongStrings();
+	std::vector<char const *> cStrings = hot::testhelpers::stdStringsToCStrings(strings);
+	CStringTrieType hotSingleThreaded;
+
+	std::vector<idx::contenthelpers::OptionalValue<char const *>> results(cStrings.size());
+	hotSingleThreaded.lookupBatch(cStrings.data(), cStrings.size(), results.data());
+	for (size_t i = 0u; i < cStrings.size(); ++i) {
+		BOOST_REQUIRE(!results[i].mIsValid);
+	}
+
+	for (size_t i = 0u; i < cStrings.size(); i += 2) {
+		hotSingleThreaded.insert(cStrings[i]);
+	}
+
+	hotSingleThreaded.lookupBatch(cStrings.data(), cStrings.size(), results.data());
+	for (size_t i = 0u; i < cStrings.size(); ++i) {
+		BOOST_REQUIRE(results[i].compliesWith(hotSingleThreaded.lookup(cStrings[i])));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testBulkLoadWithIntegers) {
+	for(std::vector<uint64_t> const & values : getIntegerValueSets()) {
+		testBulkLoad(values);
+	}
+	//random sets of up to 200 values result in tries of two levels with differently sized nodes
+	for(size_t numberValues = 70u; numberValues < 200u; ++numberValues) {
+		testBulkLoad(getRandomValues(numberValues));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testBulkLoadWithStrings) {
+	std::vector<std::string> const &strings = getLongStrings();
+	testBulkLoad(hot::testhelpers::stdStringsToCStrings(strings));
+}
+
+BOOST_AUTO_TEST_CASE(testBulkLoadSkipsDuplicatesAndInsertsIntoNonEmptyTrie) {
+	std::vector<uint64_t> values { 1u, 2u, 2u, 5u, 9u, 9u, 9u, 12u };
+	HOTSingleThreadedUint64 hotSingleThreaded;
+	BOOST_REQUIRE_EQUAL(hotSingleThreaded.bulkLoad(values.begin(), values.end()), 5u);
+
+	std::vector<uint64_t> additionalValues { 3u, 5u, 7u };
+	BOOST_REQUIRE_EQUAL(hotSingleThreaded.bulkLoad(additionalValues.begin(), additionalValues.end()), 2u);
+
+	std::vector<uint64_t> expectedValues { 1u, 2u, 3u, 5u, 7u, 9u, 12u };
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(hotSingleThreaded.begin(), hotSingleThreaded.end(), expectedValues.begin(), expectedValues.end());
+	bool subtreeValid = isSubTreeValid<uint64_t, idx::contenthelpers::IdentityKeyExtractor>(&(hotSingleThreaded.mRoot));
+	BOOST_REQUIRE(subtreeValid);
+}
+
+BOOST_AUTO_TEST_CASE(testBulkLoadRejectsUnsortedValues) {
+	std::vector<uint64_t> values;
+	for(uint64_t i = 0u; i < 20000u; ++i) {
+		values.push_back(i * 3u);
+	}
+
+	//the pairs in descending order are detected before the first and after many nodes were loaded
+	for(size_t unsortedIndex : { 0u, 1u, 19000u, 19998u }) {
+		std::swap(values[unsortedIndex], values[unsortedIndex + 1u]);
+		HOTSingleThreadedUint64 hotSingleThreaded;
+		BOOST_REQUIRE_THROW(hotSingleThreaded.bulkLoad(values.begin(), values.end()), std::invalid_argument);
+		BOOST_REQUIRE(hotSingleThreaded.isEmpty());
+		//tries owning their memory pool load the values sequentially
+		hot::singlethreaded::HOTSingleThreaded<uint64_t, idx::contenthelpers::IdentityKeyExtractor, PerInstanceNodeAllocatorPolicy> perInstanceTrie;
+		BOOST_REQUIRE_THROW(hot::singlethreaded::bulkLoadParallel(perInstanceTrie, values.begin(), values.end()), std::invalid_argument);
+		BOOST_REQUIRE(perInstanceTrie.isEmpty());
+		std::swap(values[unsortedIndex], values[unsortedIndex + 1u]);
+	}
+
+	HOTSingleThreadedUint64 hotSingleThreaded;
+	BOOST_REQUIRE_EQUAL(hotSingleThreaded.bulkLoad(values.begin(), values.end()), values.size());
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(hotSingleThreaded.begin(), hotSingleThreaded.end(), values.begin(), values.end());
+}
+
+BOOST_AUTO_TEST_CASE(testParallelBulkLoadWithIntegers) {
+	for(std::vector<uint64_t> values : getIntegerValueSets()) {
+		std::sort(values.begin(), values.end());
+		for(size_t numberThreads : { 1u, 2u, 4u }) {
+			testParallelBulkLoad(values, numberThreads);
+		}
+	}
+	//enough values to be split into many more ranges than threads
+	for(size_t numberThreads : { 1u, 2u, 4u }) {
+		testParallelBulkLoad(getSequentialValues(300000u, 1u), numberThreads);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testParallelBulkLoadWithDuplicates) {
+	std::vector<uint64_t> values;
+	for(uint64_t i = 0u; i < 50000u; ++i) {
+		for(size_t j = 0u; j < (i % 4u); ++j) {
+			values.push_back(i * 7u);
+		}
+	}
+	testParallelBulkLoad(values, 4u);
+	testParallelBulkLoad(std::vector<uint64_t>(20000u, 42u), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(testParallelBulkLoadWithStrings) {
+	std::vector<std::string> const &strings = getLongStrings();
+	std::set<std::string> temporarySet(strings.begin(), strings.end());
+	for(size_t i = 0u; i < 50000u; ++i) {
+		temporarySet.insert(strings[i % strings.size()] + std::to_string(i * 31u));
+	}
+	std::vector<std::string> sortedStrings(temporarySet.begin(), temporarySet.end());
+	testParallelBulkLoad(hot::testhelpers::stdStringsToCStrings(sortedStrings), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(testParallelBulkLoadInsertsIntoNonEmptyTrie) {
+	HOTSingleThreadedUint64 hotSingleThreaded;
+	hotSingleThreaded.insert(5u);
+
+	std::vector<uint64_t> values { 1u, 2u, 5u, 9u };
+	BOOST_REQUIRE_EQUAL(hot::singlethreaded::bulkLoadParallel(hotSingleThreaded, values.begin(), values.end()), 3u);
+
+	std::vector<uint64_t> expectedValues { 1u, 2u, 5u, 9u };
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(hotSingleThreaded.begin(), hotSingleThreaded.end(), expectedValues.begin(), expectedValues.end());
+}
+
+BOOST_AUTO_TEST_CASE(testParallelBulkLoadRejectsUnsortedValues) {
+	std::vector<uint64_t> values;
+	for(uint64_t i = 0u; i < 20000u; ++i) {
+		values.push_back(i * 3u);
+	}
+	//a single pair of adjacent values in descending order in the middle of the sequence
+	std::swap(values[12345u], values[12346u]);
+
+	HOTSingleThreadedUint64 hotSingleThreaded;
+	BOOST_REQUIRE_THROW(hot::singlethreaded::bulkLoadParallel(hotSingleThreaded, values.begin(), values.end()), std::invalid_argument);
+	BOOST_REQUIRE(hotSingleThreaded.isEmpty());
+
+	std::swap(values[12345u], values[12346u]);
+	BOOST_REQUIRE_EQUAL(hot::singlethreaded::bulkLoadParallel(hotSingleThreaded, values.begin(), values.end()), values.size());
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(hotSingleThreaded.begin(), hotSingleThreaded.end(), values.begin(), values.end());
+}
+
+template<typename TrieType> size_t countValues(TrieType const & trie) {
+	size_t numberValues = 0u;
+	for(auto it = trie.begin(); it != trie.end(); ++it) {
+		++numberValues;
+	}
+	return numberValues;
+}
+
+template<typename NodeAllocatorPolicy> void testShardPerThread(size_t numberThreads) {
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<uint64_t, idx::contenthelpers::IdentityKeyExtractor, NodeAllocatorPolicy>;
+	std::vector<std::set<uint64_t>> valuesPerShard(numberThreads);
+	for(size_t shard = 0u; shard < numberThreads; ++shard) {
+		idx::utils::RandomRangeGenerator<uint64_t> rnd{12344567u + shard, 0, INT64_MAX};
+		for(size_t i = 0u; i < 100000u; ++i) {
+			valuesPerShard[shard].insert(rnd());
+		}
+	}
+
+	std::vector<bool> isShardCorrect(numberThreads, false);
+	std::vector<std::thread> threads;
+	for(size_t shard = 0u; shard < numberThreads; ++shard) {
+		threads.emplace_back([&, shard]() {
+			std::set<uint64_t> const & values = valuesPerShard[shard];
+			TrieType trie;
+			bool isCorrect = true;
+			for(uint64_t value : values) {
+				isCorrect &= trie.insert(value);
+			}
+			isCorrect &= (countValues(trie) == values.size()) && std::equal(values.begin(), values.end(), trie.begin());
+			size_t numberRemoved = 0u;
+			for(uint64_t value : values) {
+				if((value % 2u) == 0u) {
+					isCorrect &= trie.remove(value);
+					++numberRemoved;
+				}
+			}
+			isCorrect &= (countValues(trie) == (values.size() - numberRemoved));
+			isShardCorrect[shard] = isCorrect;
+		});
+	}
+	for(std::thread & thread : threads) {
+		thread.join();
+	}
+	for(size_t shard = 0u; shard < numberThreads; ++shard) {
+		BOOST_REQUIRE(isShardCorrect[shard]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testRemoveRangeWithIntegers) {
+	for(std::vector<uint64_t> const & values : getIntegerValueSets()) {
+		std::vector<std::pair<uint64_t, uint64_t>> ranges = getRanges(values);
+		//the remaining values are removed at once, afterwards the trie is empty
+		ranges.emplace_back(0u, UINT64_MAX);
+		ranges.emplace_back(0u, UINT64_MAX);
+		testRemoveRange(values, ranges);
+	}
+	testRemoveRange<uint64_t>({ 42u }, { { 43u, 50u }, { 1u, 41u }, { 42u, 42u } });
+}
+
+BOOST_AUTO_TEST_CASE(testRemoveRangeWithStrings) {
+	std::vector<std::string> const &strings = getLongStrings();
+	std::vector<char const*> values = hot::testhelpers::stdStringsToCStrings(strings);
+	std::set<char const*, typename idx::contenthelpers::KeyComparator<char const*>::type> sortedValues(values.begin(), values.end());
+	std::vector<char const*> sortedStrings(sortedValues.begin(), sortedValues.end());
+	size_t numberStrings = sortedStrings.size();
+	testRemoveRange(values, {
+		{ sortedStrings[numberStrings / 4u], sortedStrings[numberStrings / 2u] },
+		{ sortedStrings[0], sortedStrings[numberStrings / 8u] },
+		{ sortedStrings[numberStrings - 3u], sortedStrings[numberStrings - 1u] },
+		{ "", sortedStrings[numberStrings - 1u] }
+	});
+}
+
+BOOST_AUTO_TEST_CASE(testRemoveBatchWithIntegers) {
+	for(std::vector<uint64_t> const & values : getIntegerValueSets()) {
+		//a single key, every second value together with keys which are not contained, a dense range of duplicated keys and finally all remaining values
+		std::vector<std::vector<uint64_t>> batches { { 0u }, {}, {}, values };
+		for(size_t i = 0u; i < values.size(); ++i) {
+			if((i % 2u) == 0u) {
+				batches[1].push_back(values[i]);
+				batches[1].push_back(values[i] + 1u);
+			}
+			if(i >= values.size() / 4u && i < values.size() / 2u) {
+				batches[2].push_back(values[i]);
+				batches[2].push_back(values[i]);
+			}
+		}
+		testRemoveBatch(values, batches);
+	}
+	testRemoveBatch<uint64_t>({ 42u }, { {}, { 1u, 43u }, { 1u, 42u, 42u, 50u } });
+}
+
+BOOST_AUTO_TEST_CASE(testRemoveBatchWithStrings) {
+	std::vector<std::string> const &strings = getLongStrings();
+	std::vector<char const*> values = hot::testhelpers::stdStringsToCStrings(strings);
+	std::vector<char const*> everySecondString;
+	for(size_t i = 0u; i < values.size(); i += 2u) {
+		everySecondString.push_back(values[i]);
+	}
+	testRemoveBatch(values, { everySecondString, { "", "a", values[1] }, values });
+}
+
+BOOST_AUTO_TEST_CASE(testReverseIterationWithIntegers) {
+	for(std::vector<uint64_t> const & values : getIntegerValueSets()) {
+		testReverseIteration(values, getProbeKeys(values));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testReverseIterationWithStrings) {
+	std::vector<std::string> const &strings = getLongStrings();
+	std::vector<char const*> values = hot::testhelpers::stdStringsToCStrings(strings);
+	testReverseIteration(values, getProbeKeys(values));
+}
+
+BOOST_AUTO_TEST_CASE(testScanRangeWithIntegers) {
+	for(std::vector<uint64_t> const & values : getIntegerValueSets()) {
+		std::vector<std::pair<uint64_t, uint64_t>> ranges = getRanges(values);
+		ranges.emplace_back(0u, UINT64_MAX);
+		testScanRange(values, ranges);
+	}
+	testScanRange<uint64_t>({ 42u }, { { 0u, 41u }, { 0u, 42u }, { 42u, 42u }, { 43u, 50u }, { 42u, 1u } });
+}
+
+BOOST_AUTO_TEST_CASE(testScanRangeWithStrings) {
+	std::vector<std::string> const &strings = getLongStrings();
+	std::vector<char const*> values = hot::testhelpers::stdStringsToCStrings(strings);
+	std::set<char const*, typename idx::contenthelpers::KeyComparator<char const*>::type> sortedValues(values.begin(), values.end());
+	std::vector<char const*> sortedStrings(sortedValues.begin(), sortedValues.end());
+	size_t numberStrings = sortedStrings.size();
+	testScanRange(values, {
+		{ sortedStrings[numberStrings / 4u], sortedStrings[numberStrings / 2u] },
+		{ "", sortedStrings[numberStrings / 8u] },
+		{ "a", "b" },
+		{ sortedStrings[numberStrings - 3u], "\x7f" },
+		{ sortedStrings[numberStrings / 2u], sortedStrings[numberStrings / 4u] }
+	});
+}
+
+BOOST_AUTO_TEST_CASE(testPrefixScanWithStrings) {
+	std::vector<std::string> const &strings = getLongStrings();
+	std::vector<char const*> values = hot::testhelpers::stdStringsToCStrings(strings);
+	std::vector<std::string> prefixes { "", "<", "<http://", "a", "\x7f" };
+	for(size_t i = 0u; i < strings.size(); i += 37u) {
+		for(size_t prefixLength : { 1u, 5u, 12u, 20u, 30u, 45u }) {
+			prefixes.push_back(strings[i].substr(0u, prefixLength));
+		}
+		prefixes.push_back(strings[i]);
+		prefixes.push_back(strings[i] + "a");
+		prefixes.push_back(strings[i].substr(0u, strings[i].size() - 1u) + "~");
+	}
+	testPrefixScan(values, prefixes);
+}
+
+BOOST_AUTO_TEST_CASE(testPrefixScanSmallSets) {
+	testPrefixScan({}, { "", "a" });
+	testPrefixScan({ "fernando@terras.com" }, { "", "f", "fernando", "fernando@terras.com", "fernando@terras.com.bt", "g", "e" });
+	testPrefixScan({ "fernando@terras.com.bt", "fernando@terras.com" }, { "", "fernando@terras.com", "fernando@terras.com.", "fernando@terras.co", "fernando@terras.com.bt", "fernando@terras.comb" });
+	testPrefixScan({ "ab", "abc", "abd", "ac", "b", "ba" }, { "", "a", "ab", "abc", "abcd", "ac", "b", "ba", "bb", "c" });
+}
+
+BOOST_AUTO_TEST_CASE(testLongestPrefixMatchWithStrings) {
+	std::vector<std::string> const &strings = getLongStrings();
+	//the routing table consists of prefixes of different lengths and some of the full strings
+	std::vector<std::string> routes { "<", "<http://" };
+	for(size_t i = 0u; i < strings.size(); i += 7u) {
+		routes.push_back(strings[i].substr(0u, 5u + (i % 40u)));
+		if(i % 3u == 0u) {
+			routes.push_back(strings[i]);
+		}
+	}
+	std::vector<char const*> values = hot::testhelpers::stdStringsToCStrings(routes);
+
+	std::vector<std::string> searchKeys { "", "<", "<h", "a", "\x7f" };
+	for(size_t i = 0u; i < strings.size(); i += 5u) {
+		searchKeys.push_back(strings[i]);
+		searchKeys.push_back(strings[i] + "a");
+		searchKeys.push_back(strings[i].substr(0u, strings[i].size() / 2u));
+		searchKeys.push_back(strings[i].substr(0u, strings[i].size() - 1u) + "~");
+	}
+	testLongestPrefixMatch(values, searchKeys);
+}
+
+BOOST_AUTO_TEST_CASE(testLongestPrefixMatchSmallSets) {
+	testLongestPrefixMatch({}, { "", "a" });
+	testLongestPrefixMatch({ "10.1" }, { "", "1", "10.1", "10.12", "10.1.2.3", "10.2", "9" });
+	testLongestPrefixMatch({ "", "10.1" }, { "", "1", "10.1", "10.1.2.3", "10.2" });
+	testLongestPrefixMatch({ "10.", "10.1.", "10.1.2.", "10.1.2.3", "10.2.", "11." }, { "", "10", "10.", "10.1", "10.1.", "10.1.2", "10.1.2.3", "10.1.2.4", "10.1.3.1", "10.2.0.1", "10.3.0.1", "11.0.0.1", "12.0.0.1" });
+	testLongestPrefixMatch({ "a", "ab", "abc", "abd", "ac", "b", "ba" }, { "", "a", "aa", "ab", "abc", "abcd", "abe", "ac", "acd", "b", "ba", "bab", "bb", "c" });
+	//bit granular prefixes encoded as strings of binary digits
+	testLongestPrefixMatch({ "0", "01", "0110", "1", "11010" }, { "0", "00", "0111", "01101", "0110111", "10", "1101", "110101", "111" });
+}
+
+#ifdef USE_ORDER_STATISTICS
+BOOST_AUTO_TEST_CASE(testOrderStatisticsWithIntegers) {
+	for(std::vector<uint64_t> const & values : getIntegerValueSets()) {
+		testOrderStatistics(values, getProbeKeys(values));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testOrderStatisticsWithStrings) {
+	std::vector<std::string> const &strings = getLongStrings();
+	std::vector<char const*> values = hot::testhelpers::stdStringsToCStrings(strings);
+	testOrderStatistics(values, getProbeKeys(values));
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(testSnapshotsSequentialValues) {
+	testSnapshots(getSequentialValues(20000u, 1u), 10u);
+}
+
+BOOST_AUTO_TEST_CASE(testSnapshotsRandomValues) {
+	testSnapshots(getRandomValues(20000u), 10u);
+}
+
+BOOST_AUTO_TEST_CASE(testSnapshotsWithStrings) {
+	std::vector<std::string> const &strings = getLongStrings();
+	std::vector<char const*> values = hot::testhelpers::stdStringsToCStrings(strings);
+	testSnapshots(values, 4u);
+}
+
+BOOST_AUTO_TEST_CASE(testSnapshotsOfSmallTries) {
+	using SnapshotType = hot::singlethreaded::HOTSingleThreadedSnapshot<uint64_t, idx::contenthelpers::IdentityKeyExtractor>;
+	HOTSingleThreadedUint64 trie;
+	SnapshotType emptySnapshot = trie.snapshot();
+	trie.insert(42u);
+	SnapshotType leafSnapshot = trie.snapshot();
+	trie.insert(43u);
+	SnapshotType nodeSnapshot = trie.snapshot();
+	trie.upsert(42u);
+	trie.remove(43u);
+	trie.remove(42u);
+	BOOST_REQUIRE(trie.isEmpty());
+
+	checkSnapshot(emptySnapshot, std::set<uint64_t> {}, { 42u, 43u });
+	//find and lower_bound are only probed for tries whose root is a node
+	checkSnapshot(leafSnapshot, std::set<uint64_t> { 42u }, {});
+	BOOST_REQUIRE(leafSnapshot.lookup(42u).compliesWith({ true, 42u }));
+	BOOST_REQUIRE(!leafSnapshot.lookup(43u).mIsValid);
+	checkSnapshot(nodeSnapshot, std::set<uint64_t> { 42u, 43u }, { 41u, 42u, 43u, 44u });
+
+	//the handles can be moved and released in any order
+	SnapshotType movedSnapshot(std::move(nodeSnapshot));
+	checkSnapshot(movedSnapshot, std::set<uint64_t> { 42u, 43u }, { 42u, 43u });
+	leafSnapshot = std::move(movedSnapshot);
+	checkSnapshot(leafSnapshot, std::set<uint64_t> { 42u, 43u }, { 42u, 43u });
+}
+
+BOOST_AUTO_TEST_CASE(testSnapshotMemoryOverheadIsProportionalToChanges) {
+	HOTSingleThreadedUint64 trie;
+	for(uint64_t i = 0u; i < 100000u; ++i) {
+		trie.insert(i);
+	}
+
+	using SnapshotType = hot::singlethreaded::HOTSingleThreadedSnapshot<uint64_t, idx::contenthelpers::IdentityKeyExtractor>;
+	std::unique_ptr<SnapshotType> snapshot(new SnapshotType(trie.snapshot()));
+	BOOST_REQUIRE_EQUAL(trie.getNumberRetiredNodes(), 0u);
+
+	//repeatedly modifying the same values only copies the nodes on their paths once
+	for(int run = 0; run < 10; ++run) {
+		for(uint64_t i = 0u; i < 100u; ++i) {
+			trie.upsert(i);
+		}
+	}
+	size_t numberRetiredNodes = trie.getNumberRetiredNodes();
+	BOOST_REQUIRE_GT(numberRetiredNodes, 0u);
+	BOOST_REQUIRE_LE(numberRetiredNodes, 100u * trie.mRoot.getHeight());
+
+	//the snapshot can be read concurrently to modifications of the trie
+	bool isSnapshotCorrect = false;
+	std::thread reader([&]() {
+		uint64_t expectedValue = 0u;
+		bool isCorrect = true;
+		for(uint64_t value : *snapshot) {
+			isCorrect &= (value == expectedValue++);
+		}
+		isSnapshotCorrect = isCorrect && (expectedValue == 100000u);
+	});
+	for(uint64_t i = 0u; i < 100000u; i += 2u) {
+		trie.remove(i);
+	}
+	reader.join();
+	BOOST_REQUIRE(isSnapshotCorrect);
+	BOOST_REQUIRE_EQUAL(countValues(trie), 50000u);
+
+	snapshot.reset();
+	trie.remove(1u);
+	BOOST_REQUIRE_EQUAL(trie.getNumberRetiredNodes(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(testSaveAndLoadRandomValues) {
+	testSaveAndLoad(getRandomValues(100000u));
+}
+
+BOOST_AUTO_TEST_CASE(testSaveAndLoadWithStrings) {
+	std::vector<std::string> const &strings = getLongStrings();
+	std::vector<char const*> values = hot::testhelpers::stdStringsToCStrings(strings);
+	testSaveAndLoad(values);
+}
+
+BOOST_AUTO_TEST_CASE(testSaveAndLoadSmallTries) {
+	testSaveAndLoad<uint64_t>({ 42u });
+	for(uint64_t numberValues = 2u; numberValues < 70u; ++numberValues) {
+		testSaveAndLoad(getSequentialValues(numberValues, 3u));
+	}
+
+	HOTSingleThreadedUint64 emptyTrie;
+	std::string filePath = "hot-single-threaded-test-save-and-load-empty.bin";
+	BOOST_REQUIRE(emptyTrie.save(filePath));
+	HOTSingleThreadedUint64 loadedTrie;
+	loadedTrie.insert(42u);
+	loadedTrie.insert(43u);
+	BOOST_REQUIRE(loadedTrie.load(filePath));
+	std::remove(filePath.c_str());
+	BOOST_REQUIRE(loadedTrie.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(testSavedNodesDoNotContainUnusedSlots) {
+	HOTSingleThreadedUint64 trie;
+	for(uint64_t i = 0u; i < 20000u; ++i) {
+		trie.insert(i * 7u);
+	}
+	//the removed entries leave stale content in the unused slots of nodes with slack capacity
+	for(uint64_t i = 0u; i < 20000u; i += 3u) {
+		trie.remove(i * 7u);
+	}
+	std::string filePath = "hot-single-threaded-test-saved-nodes-do-not-contain-unused-slots.bin";
+	BOOST_REQUIRE(trie.save(filePath));
+	std::vector<char> fileContent;
+	{
+		std::ifstream input { filePath, std::ios::binary };
+		fileContent.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+	}
+	std::remove(filePath.c_str());
+
+	hot::singlethreaded::HOTSingleThreadedFileHeader fileHeader;
+	std::memcpy(&fileHeader, fileContent.data(), sizeof(fileHeader));
+	size_t recordOffset = sizeof(fileHeader);
+	for(uint64_t recordIndex = 0u; recordIndex < fileHeader.mNumberNodes; ++recordIndex) {
+		hot::singlethreaded::HOTSingleThreadedFileRecordHeader recordHeader;
+		std::memcpy(&recordHeader, fileContent.data() + recordOffset, sizeof(recordHeader));
+		char const * image = fileContent.data() + recordOffset + sizeof(recordHeader);
+		uint16_t numberEntries = static_cast<uint16_t>(reinterpret_cast<hot::singlethreaded::HOTSingleThreadedNodeBase const *>(image)->getNumberEntries());
+		size_t numberUnusedSlots = hot::singlethreaded::NodeCapacityPolicy::getCapacity(numberEntries) - numberEntries;
+		//neither the address of the first child pointer nor the unused child pointers are written
+		BOOST_REQUIRE(reinterpret_cast<hot::singlethreaded::HOTSingleThreadedNodeBase const *>(image)->mFirstChildPointer == nullptr);
+		BOOST_REQUIRE(std::all_of(image + recordHeader.mSizeInBytes - numberUnusedSlots * sizeof(hot::singlethreaded::HOTSingleThreadedChildPointer), image + recordHeader.mSizeInBytes, [](char byte) {
+			return byte == 0;
+		}));
+		recordOffset += sizeof(recordHeader) + recordHeader.mSizeInBytes;
+	}
+	BOOST_REQUIRE_EQUAL(recordOffset, fileContent.size());
+}
+
+BOOST_AUTO_TEST_CASE(testLoadInvalidFiles) {
+	HOTSingleThreadedUint64 trie;
+	for(uint64_t i = 0u; i < 10000u; ++i) {
+		trie.insert(i * 7u);
+	}
+	std::string filePath = "hot-single-threaded-test-load-invalid-files.bin";
+	BOOST_REQUIRE(trie.save(filePath));
+	std::vector<char> fileContent;
+	{
+		std::ifstream input { filePath, std::ios::binary };
+		fileContent.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+	}
+	auto writeFile = [&](std::vector<char> const & content) {
+		std::ofstream output { filePath, std::ios::binary | std::ios::trunc };
+		output.write(content.data(), static_cast<std::streamsize>(content.size()));
+	};
+
+	//files which cannot be opened or have an unknown format leave the trie unchanged
+	HOTSingleThreadedUint64 loadedTrie;
+	loadedTrie.insert(1u);
+	BOOST_REQUIRE(!loadedTrie.load("hot-single-threaded-test-missing-file.bin"));
+	std::vector<char> invalidMagic = fileContent;
+	invalidMagic[0] = 'X';
+	writeFile(invalidMagic);
+	BOOST_REQUIRE(!loadedTrie.load(filePath));
+	BOOST_REQUIRE_EQUAL(countValues(loadedTrie), 1u);
+
+	//files written for keys of a different maximum length or of a different kind of type are rejected in the same way
+	writeFile(fileContent);
+	hot::singlethreaded::HOTSingleThreaded<uint32_t, idx::contenthelpers::IdentityKeyExtractor> shorterKeysTrie;
+	BOOST_REQUIRE(!shorterKeysTrie.load(filePath));
+	BOOST_REQUIRE(shorterKeysTrie.isEmpty());
+	hot::singlethreaded::HOTSingleThreaded<int64_t, idx::contenthelpers::IdentityKeyExtractor> signedKeysTrie;
+	BOOST_REQUIRE(!signedKeysTrie.load(filePath));
+	BOOST_REQUIRE(signedKeysTrie.isEmpty());
+
+	//corrupted files leave the trie empty
+	writeFile(std::vector<char>(fileContent.begin(), fileContent.begin() + fileContent.size() / 2u));
+	BOOST_REQUIRE(!loadedTrie.load(filePath));
+	BOOST_REQUIRE(loadedTrie.isEmpty());
+
+	//the last record belongs to the root, whose last used child pointer references the record stored directly in front of it
+	hot::singlethreaded::HOTSingleThreadedFileHeader fileHeader;
+	std::memcpy(&fileHeader, fileContent.data(), sizeof(fileHeader));
+	size_t rootRecordOffset = sizeof(fileHeader);
+	hot::singlethreaded::HOTSingleThreadedFileRecordHeader recordHeader;
+	std::memcpy(&recordHeader, fileContent.data() + rootRecordOffset, sizeof(recordHeader));
+	for(uint64_t recordIndex = 1u; recordIndex < fileHeader.mNumberNodes; ++recordIndex) {
+		rootRecordOffset += sizeof(recordHeader) + recordHeader.mSizeInBytes;
+		std::memcpy(&recordHeader, fileContent.data() + rootRecordOffset, sizeof(recordHeader));
+	}
+	size_t rootImageOffset = rootRecordOffset + sizeof(recordHeader);
+	BOOST_REQUIRE_EQUAL(rootImageOffset + recordHeader.mSizeInBytes, fileContent.size());
+	uint16_t numberRootEntries = static_cast<uint16_t>(reinterpret_cast<hot::singlethreaded::HOTSingleThreadedNodeBase const *>(fileContent.data() + rootImageOffset)->getNumberEntries());
+	//the child pointers are followed by the unused slots of nodes with slack capacity
+	size_t lastRootChildOffset = rootImageOffset + recordHeader.mSizeInBytes
+		- (hot::singlethreaded::NodeCapacityPolicy::getCapacity(numberRootEntries) - numberRootEntries + 1u) * sizeof(hot::singlethreaded::HOTSingleThreadedChildPointer);
+	hot::singlethreaded::HOTSingleThreadedChildPointer const & lastRootChild = *reinterpret_cast<hot::singlethreaded::HOTSingleThreadedChildPointer const *>(fileContent.data() + lastRootChildOffset);
+	BOOST_REQUIRE(lastRootChild.isNode());
+	BOOST_REQUIRE_EQUAL(hot::singlethreaded::getReferencedRecordIndex(lastRootChild), fileHeader.mNumberNodes - 2u);
+	std::vector<char> corruptedReference = fileContent;
+	std::memset(corruptedReference.data() + lastRootChildOffset, 0, sizeof(hot::singlethreaded::HOTSingleThreadedChildPointer));
+	writeFile(corruptedReference);
+	loadedTrie.insert(1u);
+	BOOST_REQUIRE(!loadedTrie.load(filePath));
+	BOOST_REQUIRE(loadedTrie.isEmpty());
+
+	//multi mask nodes cannot occur for 8 byte keys
+	std::vector<char> unsupportedNodeType = fileContent;
+	hot::singlethreaded::HOTSingleThreadedFileRecordHeader unsupportedRecordHeader { static_cast<uint32_t>(hot::commons::NodeType::MULTI_MASK_8_BYTES_AND_8_BIT_PARTIAL_KEYS), recordHeader.mSizeInBytes };
+	std::memcpy(unsupportedNodeType.data() + rootRecordOffset, &unsupportedRecordHeader, sizeof(unsupportedRecordHeader));
+	writeFile(unsupportedNodeType);
+	loadedTrie.insert(1u);
+	BOOST_REQUIRE(!loadedTrie.load(filePath));
+	BOOST_REQUIRE(loadedTrie.isEmpty());
+
+	//a partial key mapping extracting a bit of the ninth key byte addresses memory behind 8 byte keys
+	BOOST_REQUIRE(trie.mRoot.getNodeType() <= hot::commons::NodeType::SINGLE_MASK_32_BIT_PARTIAL_KEYS);
+	size_t rootMappingOffset = rootImageOffset + trie.mRoot.executeForSpecificNodeType<8u>(false, [](auto const & node) {
+		return static_cast<size_t>(reinterpret_cast<char const*>(&node.mDiscriminativeBitsRepresentation) - reinterpret_cast<char const*>(&node));
+	});
+	std::vector<char> mappingOutsideOfKeys = fileContent;
+	hot::commons::SingleMaskPartialKeyMapping const mappingForNinthByte { hot::commons::DiscriminativeBit { 70u } };
+	std::memcpy(mappingOutsideOfKeys.data() + rootMappingOffset, &mappingForNinthByte, sizeof(mappingForNinthByte));
+	writeFile(mappingOutsideOfKeys);
+	loadedTrie.insert(1u);
+	BOOST_REQUIRE(!loadedTrie.load(filePath));
+	BOOST_REQUIRE(loadedTrie.isEmpty());
+
+	writeFile(fileContent);
+	BOOST_REQUIRE(loadedTrie.load(filePath));
+	std::remove(filePath.c_str());
+	BOOST_REQUIRE_EQUAL(countValues(loadedTrie), 10000u);
+}
+
+BOOST_AUTO_TEST_CASE(testFreezeRandomValues) {
+	idx::utils::RandomRangeGenerator<uint64_t> rnd{12344567, 0, INT64_MAX};
+	std::vector<uint64_t> values;
+	std::vector<uint64_t> probeKeys { 0u, UINT64_MAX };
+	for(size_t i = 0u; i < 100000u; ++i) {
+		values.push_back(rnd());
+	}
+	for(size_t i = 0u; i < 10000u; ++i) {
+		probeKeys.push_back(rnd());
+		probeKeys.push_back(values[i] - 1u);
+		probeKeys.push_back(values[i] + 1u);
+	}
+	testFreeze(values, probeKeys);
+}
+
+BOOST_AUTO_TEST_CASE(testFreezeWithStrings) {
+	std::vector<std::string> const &strings = getLongStrings();
+	std::vector<std::string> probeStrings { "" };
+	for(size_t i = 0u; i < strings.size(); i += 7u) {
+		probeStrings.push_back(strings[i] + "a");
+		probeStrings.push_back(strings[i].substr(0u, strings[i].size() / 2u));
+	}
+	std::vector<char const*> values = hot::testhelpers::stdStringsToCStrings(strings);
+	std::vector<char const*> probeKeys = hot::testhelpers::stdStringsToCStrings(probeStrings);
+	testFreeze(values, probeKeys);
+}
+
+BOOST_AUTO_TEST_CASE(testFreezeSmallTries) {
+	testFreeze<uint64_t>({ 42u }, { 0u, 41u, 42u, 43u });
+	for(uint64_t numberValues = 2u; numberValues < 70u; ++numberValues) {
+		std::vector<uint64_t> values;
+		std::vector<uint64_t> probeKeys;
+		for(uint64_t i = 0u; i < numberValues; ++i) {
+			values.push_back(i * 3u + 1u);
+		}
+		for(uint64_t i = 0u; i < numberValues * 3u + 2u; ++i) {
+			probeKeys.push_back(i);
+		}
+		testFreeze(values, probeKeys);
+	}
+
+	hot::singlethreaded::HOTSingleThreadedFrozen<uint64_t, idx::contenthelpers::IdentityKeyExtractor> emptyFrozenTrie = HOTSingleThreadedUint64().freeze();
+	BOOST_REQUIRE(emptyFrozenTrie.isEmpty());
+	BOOST_REQUIRE(!emptyFrozenTrie.lookup(42u).mIsValid);
+	BOOST_REQUIRE(emptyFrozenTrie.begin() == emptyFrozenTrie.end());
+	BOOST_REQUIRE(emptyFrozenTrie.rbegin() == emptyFrozenTrie.rend());
+	BOOST_REQUIRE(emptyFrozenTrie.lower_bound(42u) == emptyFrozenTrie.end());
+}
+
+BOOST_AUTO_TEST_CASE(testCompactRestoresLocality) {
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<uint64_t, idx::contenthelpers::IdentityKeyExtractor, ArenaNodeAllocatorPolicy>;
+	TrieType trie;
+	std::set<uint64_t> expectedValues;
+	idx::utils::RandomRangeGenerator<uint64_t> rnd{12344567, 0, INT64_MAX};
+	//interleaved inserts and removes scatter the nodes of each subtree
+	for(size_t i = 0u; i < 200000u; ++i) {
+		uint64_t value = rnd();
+		trie.insert(value);
+		expectedValues.insert(value);
+		if(i % 3u == 2u) {
+			uint64_t removedValue = *expectedValues.begin();
+			BOOST_REQUIRE(trie.remove(removedValue));
+			expectedValues.erase(removedValue);
+		}
+	}
+	std::pair<size_t, std::map<std::string, double>> statisticsBeforeCompaction = trie.getStatistics();
+	double distanceBeforeCompaction = statisticsBeforeCompaction.second["averageParentChildAddressDistance"];
+	size_t numberChunksBeforeCompaction = trie.getNodeAllocatorPolicy().getNumberArenaChunks();
+
+	size_t numberCalls = 0u;
+	while(!trie.compact(1000u)) {
+		++numberCalls;
+		BOOST_REQUIRE(trie.lookup(*expectedValues.rbegin()).mIsValid);
+	}
+	BOOST_REQUIRE_GT(numberCalls, 1u);
+
+	std::pair<size_t, std::map<std::string, double>> statisticsAfterCompaction = trie.getStatistics();
+	double distanceAfterCompaction = statisticsAfterCompaction.second["averageParentChildAddressDistance"];
+	BOOST_REQUIRE_GT(distanceAfterCompaction, 0.0);
+	BOOST_REQUIRE_LT(distanceAfterCompaction * 4.0, distanceBeforeCompaction);
+	BOOST_REQUIRE_LE(trie.getNodeAllocatorPolicy().getNumberArenaChunks(), numberChunksBeforeCompaction);
+
+	//compaction neither changes the structure nor the content of the trie
+	statisticsBeforeCompaction.second.erase("averageParentChildAddressDistance");
+	statisticsBeforeCompaction.second.erase("numberAllocations");
+	statisticsAfterCompaction.second.erase("averageParentChildAddressDistance");
+	statisticsAfterCompaction.second.erase("numberAllocations");
+	BOOST_REQUIRE(statisticsBeforeCompaction == statisticsAfterCompaction);
+	bool subtreeValid = isSubTreeValid<uint64_t, idx::contenthelpers::IdentityKeyExtractor>(&(trie.mRoot));
+	BOOST_REQUIRE(subtreeValid);
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(trie.begin(), trie.end(), expectedValues.begin(), expectedValues.end());
+}
+
+BOOST_AUTO_TEST_CASE(testRepeatedCompactionDoesNotGrowTheArena) {
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<uint64_t, idx::contenthelpers::IdentityKeyExtractor, ArenaNodeAllocatorPolicy>;
+	TrieType trie;
+	idx::utils::RandomRangeGenerator<uint64_t> rnd{12344567, 0, INT64_MAX};
+	std::vector<uint64_t> values;
+	for(size_t i = 0u; i < 1000000u; ++i) {
+		values.push_back(rnd());
+		trie.insert(values.back());
+	}
+	size_t numberChunksBeforeCompaction = trie.getNodeAllocatorPolicy().getNumberArenaChunks();
+	while(!trie.compact(1000u)) {
+	}
+	size_t numberChunksAfterFirstPass = trie.getNodeAllocatorPolicy().getNumberArenaChunks();
+	BOOST_REQUIRE_LE(numberChunksAfterFirstPass, numberChunksBeforeCompaction);
+	size_t numberChunksFreedByFirstPass = numberChunksBeforeCompaction - numberChunksAfterFirstPass;
+
+	//the chunks vacated by the relocated nodes are freed after each pass, hence further passes over the unchanged trie free at least as many chunks as the first one
+	for(size_t pass = 1u; pass < 6u; ++pass) {
+		while(!trie.compact(1000u)) {
+		}
+		size_t numberChunksAfterPass = trie.getNodeAllocatorPolicy().getNumberArenaChunks();
+		BOOST_REQUIRE_LE(numberChunksAfterPass, numberChunksBeforeCompaction);
+		BOOST_REQUIRE_GE(numberChunksBeforeCompaction - numberChunksAfterPass, numberChunksFreedByFirstPass);
+	}
+
+	BOOST_REQUIRE_EQUAL(countValues(trie), values.size());
+	for(uint64_t value : values) {
+		BOOST_REQUIRE(trie.lookup(value).mIsValid);
+	}
+	bool subtreeValid = isSubTreeValid<uint64_t, idx::contenthelpers::IdentityKeyExtractor>(&(trie.mRoot));
+	BOOST_REQUIRE(subtreeValid);
+}
+
+BOOST_AUTO_TEST_CASE(testCompactInterleavedWithModifications) {
+	HOTSingleThreadedUint64 trie;
+	std::set<uint64_t> expectedValues;
+	idx::utils::RandomRangeGenerator<uint64_t> rnd{12344567, 0, 100000u};
+	BOOST_REQUIRE(trie.compact(10u));
+	trie.insert(42u);
+	expectedValues.insert(42u);
+	BOOST_REQUIRE(trie.compact(10u));
+
+	size_t numberCompletedPasses = 0u;
+	for(size_t round = 0u; round < 2000u; ++round) {
+		for(size_t i = 0u; i < 50u; ++i) {
+			uint64_t value = rnd();
+			if(i % 2u == 0u) {
+				BOOST_REQUIRE_EQUAL(trie.insert(value), expectedValues.insert(value).second);
+			} else {
+				BOOST_REQUIRE_EQUAL(trie.remove(value), expectedValues.erase(value) == 1u);
+			}
+		}
+		numberCompletedPasses += trie.compact(25u);
+	}
+	BOOST_REQUIRE_GT(numberCompletedPasses, 0u);
+	bool subtreeValid = isSubTreeValid<uint64_t, idx::contenthelpers::IdentityKeyExtractor>(&(trie.mRoot));
+	BOOST_REQUIRE(subtreeValid);
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(trie.begin(), trie.end(), expectedValues.begin(), expectedValues.end());
+}
+
+BOOST_AUTO_TEST_CASE(testCompactWithSnapshots) {
+	HOTSingleThreadedUint64 trie;
+	for(uint64_t i = 0u; i < 100000u; ++i) {
+		trie.insert(i);
+	}
+
+	using SnapshotType = hot::singlethreaded::HOTSingleThreadedSnapshot<uint64_t, idx::contenthelpers::IdentityKeyExtractor>;
+	std::unique_ptr<SnapshotType> snapshot(new SnapshotType(trie.snapshot()));
+	BOOST_REQUIRE(!trie.compact(100u));
+	//the snapshot taken in between shares the nodes relocated by the previous call
+	std::unique_ptr<SnapshotType> secondSnapshot(new SnapshotType(trie.snapshot()));
+	for(uint64_t i = 0u; i < 100000u; i += 2u) {
+		trie.remove(i);
+	}
+	while(!trie.compact(100u)) {
+	}
+	BOOST_REQUIRE_GT(trie.getNumberRetiredNodes(), 0u);
+	BOOST_REQUIRE_EQUAL(countValues(*snapshot), 100000u);
+	BOOST_REQUIRE_EQUAL(countValues(*secondSnapshot), 100000u);
+	BOOST_REQUIRE_EQUAL(countValues(trie), 50000u);
+
+	snapshot.reset();
+	secondSnapshot.reset();
+	BOOST_REQUIRE(!trie.compact(1u));
+	BOOST_REQUIRE_EQUAL(trie.getNumberRetiredNodes(), 0u);
+	bool subtreeValid = isSubTreeValid<uint64_t, idx::contenthelpers::IdentityKeyExtractor>(&(trie.mRoot));
+	BOOST_REQUIRE(subtreeValid);
+}
+
+//removing most values of each range leaves underfull nodes behind, which keep the trie higher than a bulk loaded trie
+template<typename TrieType> void fillAndRemoveRanges(TrieType & trie, std::set<uint64_t> & expectedValues) {
+	for(uint64_t i = 0u; i < 200000u; ++i) {
+		trie.insert(i);
+	}
+	for(uint64_t rangeStart = 0u; rangeStart < 200000u; rangeStart += 1000u) {
+		trie.removeRange(rangeStart, rangeStart + 990u);
+		for(uint64_t i = rangeStart + 991u; i < rangeStart + 1000u; ++i) {
+			expectedValues.insert(i);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testRebalanceRestoresOptimalHeight) {
+	HOTSingleThreadedUint64 trie;
+	std::set<uint64_t> expectedValues;
+	fillAndRemoveRanges(trie, expectedValues);
+	std::map<std::string, double> statisticsBeforeRebalancing = trie.getStatistics().second;
+	BOOST_REQUIRE_GT(statisticsBeforeRebalancing["heightAboveOptimum"], 0.0);
+
+	trie.rebalance();
+	std::pair<size_t, std::map<std::string, double>> statisticsAfterRebalancing = trie.getStatistics();
+	BOOST_REQUIRE_EQUAL(statisticsAfterRebalancing.second["heightAboveOptimum"], 0.0);
+	BOOST_REQUIRE_EQUAL(statisticsAfterRebalancing.second["optimalHeight"], statisticsBeforeRebalancing["optimalHeight"]);
+	bool subtreeValid = isSubTreeValid<uint64_t, idx::contenthelpers::IdentityKeyExtractor>(&(trie.mRoot));
+	BOOST_REQUIRE(subtreeValid);
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(trie.begin(), trie.end(), expectedValues.begin(), expectedValues.end());
+
+	//a complete pass results in the same nodes as bulk loading the remaining values
+	HOTSingleThreadedUint64 bulkLoadedTrie;
+	bulkLoadedTrie.bulkLoad(expectedValues.begin(), expectedValues.end());
+	std::pair<size_t, std::map<std::string, double>> bulkLoadedStatistics = bulkLoadedTrie.getStatistics();
+	BOOST_REQUIRE_EQUAL(statisticsAfterRebalancing.first, bulkLoadedStatistics.first);
+	BOOST_REQUIRE_EQUAL(statisticsAfterRebalancing.second["height"], bulkLoadedStatistics.second["height"]);
+
+	//rebalancing an already optimal trie does not change it
+	trie.rebalance();
+	BOOST_REQUIRE_EQUAL(trie.getStatistics().first, statisticsAfterRebalancing.first);
+	BOOST_REQUIRE(trie.rebalance(1000000u));
+	BOOST_REQUIRE_EQUAL(trie.getStatistics().first, statisticsAfterRebalancing.first);
+}
+
+BOOST_AUTO_TEST_CASE(testRebalanceIncrementally) {
+	HOTSingleThreadedUint64 trie;
+	BOOST_REQUIRE(trie.rebalance(1u));
+	trie.rebalance();
+	trie.insert(42u);
+	BOOST_REQUIRE(trie.rebalance(1u));
+	trie.remove(42u);
+
+	std::set<uint64_t> expectedValues;
+	fillAndRemoveRanges(trie, expectedValues);
+	idx::utils::RandomRangeGenerator<uint64_t> rnd{12344567, 0, 200000u};
+	size_t numberCalls = 0u;
+	size_t numberPasses = 0u;
+	while(trie.getStatistics().second["heightAboveOptimum"] > 0.0) {
+		BOOST_REQUIRE_LT(numberPasses, 20u);
+		for(size_t i = 0u; i < 10u; ++i) {
+			uint64_t value = rnd();
+			if(i % 2u == 0u) {
+				BOOST_REQUIRE_EQUAL(trie.insert(value), expectedValues.insert(value).second);
+			} else {
+				BOOST_REQUIRE_EQUAL(trie.remove(value), expectedValues.erase(value) == 1u);
+			}
+			BOOST_REQUIRE_EQUAL(trie.lookup(value).mIsValid, expectedValues.count(value) == 1u);
+		}
+		numberPasses += trie.rebalance(5u);
+		++numberCalls;
+	}
+	BOOST_REQUIRE_GT(numberCalls, numberPasses);
+	bool subtreeValid = isSubTreeValid<uint64_t, idx::contenthelpers::IdentityKeyExtractor>(&(trie.mRoot));
+	BOOST_REQUIRE(subtreeValid);
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(trie.begin(), trie.end(), expectedValues.begin(), expectedValues.end());
+}
+
+BOOST_AUTO_TEST_CASE(testRebalanceWithSnapshots) {
+	HOTSingleThreadedUint64 trie;
+	std::set<uint64_t> expectedValues;
+	fillAndRemoveRanges(trie, expectedValues);
+
+	using SnapshotType = hot::singlethreaded::HOTSingleThreadedSnapshot<uint64_t, idx::contenthelpers::IdentityKeyExtractor>;
+	std::unique_ptr<SnapshotType> snapshot(new SnapshotType(trie.snapshot()));
+	BOOST_REQUIRE(!trie.rebalance(10u));
+	//the snapshot taken in between shares the nodes rebuilt by the previous call
+	std::unique_ptr<SnapshotType> secondSnapshot(new SnapshotType(trie.snapshot()));
+	trie.rebalance();
+	BOOST_REQUIRE_EQUAL(trie.getStatistics().second["heightAboveOptimum"], 0.0);
+	BOOST_REQUIRE_GT(trie.getNumberRetiredNodes(), 0u);
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(snapshot->begin(), snapshot->end(), expectedValues.begin(), expectedValues.end());
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(secondSnapshot->begin(), secondSnapshot->end(), expectedValues.begin(), expectedValues.end());
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(trie.begin(), trie.end(), expectedValues.begin(), expectedValues.end());
+
+	snapshot.reset();
+	secondSnapshot.reset();
+	trie.rebalance();
+	BOOST_REQUIRE_EQUAL(trie.getNumberRetiredNodes(), 0u);
+	bool subtreeValid = isSubTreeValid<uint64_t, idx::contenthelpers::IdentityKeyExtractor>(&(trie.mRoot));
+	BOOST_REQUIRE(subtreeValid);
+}
+
+BOOST_AUTO_TEST_CASE(testPerInstanceNodeAllocatorPolicy) {
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<uint64_t, idx::contenthelpers::IdentityKeyExtractor, PerInstanceNodeAllocatorPolicy>;
+	TrieType smallTrie;
+	TrieType largeTrie;
+	for(uint64_t i = 0u; i < 10000u; ++i) {
+		if(i < 100u) {
+			smallTrie.insert(i);
+		}
+		largeTrie.insert(i * 3u);
+	}
+
+	double numberSmallTrieAllocations = smallTrie.getStatistics().second["numberAllocations"];
+	double numberLargeTrieAllocations = largeTrie.getStatistics().second["numberAllocations"];
+	BOOST_REQUIRE_GT(numberSmallTrieAllocations, 0.0);
+	BOOST_REQUIRE_GT(numberLargeTrieAllocations, numberSmallTrieAllocations);
+
+	TrieType movedTrie(std::move(largeTrie));
+	BOOST_REQUIRE(largeTrie.isEmpty());
+	BOOST_REQUIRE_EQUAL(movedTrie.getStatistics().second["numberAllocations"], numberLargeTrieAllocations);
+	BOOST_REQUIRE(movedTrie.lookup(2997u).mIsValid);
+
+	for(uint64_t i = 0u; i < 10000u; ++i) {
+		BOOST_REQUIRE(movedTrie.remove(i * 3u));
+	}
+	BOOST_REQUIRE(movedTrie.isEmpty());
+
+	//the move assignment exchanges the tries together with their memory pools
+	smallTrie = std::move(movedTrie);
+	BOOST_REQUIRE(smallTrie.isEmpty());
+	BOOST_REQUIRE_EQUAL(countValues(movedTrie), 100u);
+
+	//nodes returned to the pool of the trie are reused by subsequent inserts
+	smallTrie.insert(1u);
+	smallTrie.insert(2u);
+	double numberAllocations = smallTrie.getStatistics().second["numberAllocations"];
+	BOOST_REQUIRE_GE(numberAllocations, numberLargeTrieAllocations);
+	smallTrie.remove(2u);
+	smallTrie.insert(3u);
+	BOOST_REQUIRE_EQUAL(smallTrie.getStatistics().second["numberAllocations"], numberAllocations);
+
+	//the nodes of a parallel bulk load are allocated from the pool of the trie instead of the thread local pools of the participating threads
+	std::vector<uint64_t> values;
+	for(uint64_t i = 0u; i < 100000u; ++i) {
+		values.push_back(i * 5u);
+	}
+	TrieType parallelLoadedTrie;
+	tbb::task_arena arena(4);
+	arena.execute([&]() {
+		BOOST_REQUIRE_EQUAL(hot::singlethreaded::bulkLoadParallel(parallelLoadedTrie, values.begin(), values.end()), values.size());
+	});
+	TrieType sequentiallyLoadedTrie;
+	sequentiallyLoadedTrie.bulkLoad(values.begin(), values.end());
+	BOOST_REQUIRE_EQUAL(parallelLoadedTrie.getStatistics().second["numberAllocations"], sequentiallyLoadedTrie.getStatistics().second["numberAllocations"]);
+	BOOST_REQUIRE(std::equal(values.begin(), values.end(), parallelLoadedTrie.begin()));
+}
+
+BOOST_AUTO_TEST_CASE(testArenaNodeAllocatorPolicy) {
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<uint64_t, idx::contenthelpers::IdentityKeyExtractor, ArenaNodeAllocatorPolicy>;
+	TrieType trie;
+	for(uint64_t i = 0u; i < 100000u; ++i) {
+		trie.insert(i * 7u);
+	}
+	for(uint64_t i = 0u; i < 100000u; i += 2u) {
+		BOOST_REQUIRE(trie.remove(i * 7u));
+	}
+	BOOST_REQUIRE_EQUAL(countValues(trie), 50000u);
+	BOOST_REQUIRE(trie.lookup(7u).mIsValid);
+	BOOST_REQUIRE(!trie.lookup(14u).mIsValid);
+
+	trie.clear();
+	BOOST_REQUIRE(trie.isEmpty());
+	BOOST_REQUIRE(!trie.lookup(7u).mIsValid);
+	BOOST_REQUIRE(trie.begin() == trie.end());
+
+	//a cleared trie reuses its arena and loads values sequentially to keep all nodes within the arena
+	std::vector<uint64_t> values;
+	for(uint64_t i = 0u; i < 20000u; ++i) {
+		values.push_back(i * 5u);
+	}
+	BOOST_REQUIRE_EQUAL(hot::singlethreaded::bulkLoadParallel(trie, values.begin(), values.end()), values.size());
+	BOOST_REQUIRE(std::equal(values.begin(), values.end(), trie.begin()));
+
+	TrieType movedTrie(std::move(trie));
+	BOOST_REQUIRE(trie.isEmpty());
+	BOOST_REQUIRE_EQUAL(countValues(movedTrie), values.size());
+	trie.insert(1u);
+	movedTrie.clear();
+	BOOST_REQUIRE(movedTrie.isEmpty());
+	BOOST_REQUIRE_EQUAL(countValues(trie), 1u);
+
+	for(int run = 0; run < 10; ++run) {
+		TrieType temporaryTrie;
+		for(uint64_t i = 0u; i < 1000u; ++i) {
+			temporaryTrie.insert(i);
+		}
+		BOOST_REQUIRE_EQUAL(countValues(temporaryTrie), 1000u);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testClearWithGlobalNodeAllocatorPolicy) {
+	hot::singlethreaded::HOTSingleThreaded<uint64_t, idx::contenthelpers::IdentityKeyExtractor> trie;
+	for(uint64_t i = 0u; i < 1000u; ++i) {
+		trie.insert(i);
+	}
+	trie.clear();
+	BOOST_REQUIRE(trie.isEmpty());
+	trie.insert(42u);
+	BOOST_REQUIRE_EQUAL(countValues(trie), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(testShardPerThreadWithArenaNodeAllocatorPolicy) {
+	testShardPerThread<ArenaNodeAllocatorPolicy>(4u);
+}
+
+BOOST_AUTO_TEST_CASE(testShardPerThreadWithPerInstanceNodeAllocatorPolicy) {
+	testShardPerThread<PerInstanceNodeAllocatorPolicy>(4u);
+}
+
+BOOST_AUTO_TEST_CASE(testShardPerThreadWithThreadLocalNodeAllocatorPolicy) {
+	testShardPerThread<ThreadLocalNodeAllocatorPolicy>(4u);
+}
+
+BOOST_AUTO_TEST_CASE(testLengthDelimitedKeysWithZeroBytes) {
+	testLengthDelimitedKeys<idx::contenthelpers::LengthDelimitedKey>(getBinaryKeysWithZeroBytes(20000u));
+}
+
+#if __cplusplus >= 201703L
+BOOST_AUTO_TEST_CASE(testStringViewKeysWithZeroBytes) {
+	testLengthDelimitedKeys<std::string_view>(getBinaryKeysWithZeroBytes(20000u));
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(testSignedIntegerKeys) {
+	std::mt19937_64 randomGenerator(42u);
+	std::vector<int64_t> keys { INT64_MIN, INT64_MIN + 1, -1, 0, 1, INT64_MAX };
+	for(size_t i = 0u; i < 20000u; ++i) {
+		keys.push_back(static_cast<int64_t>(randomGenerator() % 100000u) - 50000);
+	}
+	testOrderPreservingEncodedKeys(keys);
+}
+
+BOOST_AUTO_TEST_CASE(testFloatingPointKeys) {
+	std::mt19937_64 randomGenerator(42u);
+	std::normal_distribution<double> distribution(0.0, 1000.0);
+	std::vector<double> keys {
+		-std::numeric_limits<double>::infinity(), -0.0, 0.0, std::numeric_limits<double>::infinity(),
+		std::numeric_limits<double>::quiet_NaN(), -std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::signaling_NaN()
+	};
+	for(size_t i = 0u; i < 20000u; ++i) {
+		keys.push_back(distribution(randomGenerator));
+	}
+	keys.push_back(std::numeric_limits<double>::quiet_NaN());
+	testOrderPreservingEncodedKeys(keys);
+}
+
+BOOST_AUTO_TEST_CASE(testCompositeKeys) {
+	//a composite secondary index on (signed column, floating point column, primary key)
+	std::mt19937_64 randomGenerator(42u);
+	std::vector<std::tuple<int32_t, double, uint64_t>> keys;
+	for(uint64_t primaryKey = 0u; primaryKey < 20000u; ++primaryKey) {
+		keys.emplace_back(static_cast<int32_t>(randomGenerator() % 64u) - 32, static_cast<double>(static_cast<int64_t>(randomGenerator() % 16u) - 8) / 4.0, primaryKey);
+	}
+	//rows with a NaN in the floating point column
+	for(uint64_t primaryKey = 0u; primaryKey < 64u; ++primaryKey) {
+		keys.emplace_back(static_cast<int32_t>(primaryKey % 4u), std::numeric_limits<double>::quiet_NaN(), primaryKey % 32u);
+	}
+	testOrderPreservingEncodedKeys(keys);
+}
+
+BOOST_AUTO_TEST_CASE(testCStringKeysAreNotCopied) {
+	//each key is stored at the very end of its own buffer, hence reading beyond its terminating zero byte would be detected by the address sanitizer
+	std::vector<std::string> const & strings = getLongStrings();
+	std::vector<std::unique_ptr<char[]>> buffers;
+	std::vector<char const *> keys;
+	for(std::string const & string : strings) {
+		buffers.emplace_back(new char[string.size() + 1u]);
+		std::memcpy(buffers.back().get(), string.c_str(), string.size() + 1u);
+		keys.push_back(buffers.back().get());
+	}
+	CStringTrieType trie;
+	for(char const * key : keys) {
+		trie.insert(key);
+	}
+	BOOST_REQUIRE((isSubTreeValid<char const *, idx::contenthelpers::IdentityKeyExtractor>(&trie.mRoot)));
+	for(char const * key : keys) {
+		idx::contenthelpers::OptionalValue<char const *> const & result = trie.lookup(key);
+		BOOST_REQUIRE(result.mIsValid);
+		BOOST_REQUIRE_EQUAL(std::strcmp(result.mValue, key), 0);
+	}
+}
+
+#ifdef USE_LONG_KEYS
+//generates distinct keys of up to 4000 bytes, whose discriminative bits are mostly located behind their first 255 bytes and are spread over large parts of the keys
+std::vector<std::string> getKeysLongerThan255Bytes(size_t numberKeysPerPrefix) {
+	std::vector<std::string> prefixes { std::string(300u, 'a'), "<http://www.mpii.de/" + std::string(1000u, 'p') + "/", std::string(3500u, '/') };
+	std::set<std::string> keys { "a", "b", std::string(255u, 'a'), std::string(256u, 'a') + "b", std::string(255u, 'a') + "b" };
+	std::mt19937 randomGenerator(42u);
+	std::uniform_int_distribution<size_t> suffixLengthDistribution(1u, 400u);
+	std::uniform_int_distribution<int> characterDistribution('a', 'z');
+	for(std::string const & prefix : prefixes) {
+		size_t numberKeys = keys.size() + numberKeysPerPrefix;
+		while(keys.size() < numberKeys) {
+			std::string key = prefix + std::string(suffixLengthDistribution(randomGenerator), 'x');
+			//modify a few random characters of the key, which results in discriminative bits far apart from each other
+			std::uniform_int_distribution<size_t> positionDistribution(256u, key.size() - 1u);
+			for(size_t i = 0u; i < 4u; ++i) {
+				key[positionDistribution(randomGenerator)] = static_cast<char>(characterDistribution(randomGenerator));
+			}
+			keys.insert(key);
+		}
+	}
+	return { keys.begin(), keys.end() };
+}
+
+BOOST_AUTO_TEST_CASE(testKeysLongerThan255Bytes) {
+	std::vector<std::string> strings = getKeysLongerThan255Bytes(700u);
+	std::mt19937 randomGenerator(7u);
+	std::shuffle(strings.begin(), strings.end(), randomGenerator);
+	std::vector<char const *> values = hot::testhelpers::stdStringsToCStrings(strings);
+	testValues(values);
+
+	std::vector<std::vector<char const *>> batches { { values.begin(), values.begin() + values.size() / 2u }, { values.begin() + values.size() / 2u, values.end() } };
+	testRemoveBatch(values, batches);
+
+	//removing single keys merges nodes, whose discriminative bits are located behind the first 255 bytes
+	std::shared_ptr<CStringTrieType> trie = insertWithoutCheck(values);
+	for(size_t i = 0u; i < values.size(); ++i) {
+		BOOST_REQUIRE(trie->remove(values[i]));
+		BOOST_REQUIRE(!trie->lookup(values[i]).mIsValid);
+		if((i % 50u) == 0u || i == (values.size() - 1u)) {
+			BOOST_REQUIRE((isSubTreeValid<char const *, idx::contenthelpers::IdentityKeyExtractor>(&trie->mRoot)));
+		}
+	}
+	BOOST_REQUIRE(trie->isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(testBulkLoadWithKeysLongerThan255Bytes) {
+	std::vector<std::string> const & strings = getKeysLongerThan255Bytes(700u);
+	testBulkLoad(hot::testhelpers::stdStringsToCStrings(strings));
+}
+
+BOOST_AUTO_TEST_CASE(testPrefixScanWithKeysLongerThan255Bytes) {
+	std::vector<std::string> const & strings = getKeysLongerThan255Bytes(200u);
+	std::vector<std::string> prefixes { "", "a", std::string(255u, 'a'), std::string(256u, 'a'), std::string(300u, 'a'), "<http://www.mpii.de/" + std::string(1000u, 'p') };
+	for(size_t i = 0u; i < strings.size(); i += 23u) {
+		prefixes.push_back(strings[i].substr(0u, strings[i].size() / 2u));
+		prefixes.push_back(strings[i]);
+	}
+	testPrefixScan(hot::testhelpers::stdStringsToCStrings(strings), prefixes);
+}
+
+BOOST_AUTO_TEST_CASE(testSaveAndLoadWithKeysLongerThan255Bytes) {
+	std::vector<std::string> const & strings = getKeysLongerThan255Bytes(700u);
+	testSaveAndLoad(hot::testhelpers::stdStringsToCStrings(strings));
+}
+#endif
+
+#ifdef USE_PARALLEL_BIT_OPERATIONS_EMULATION
+BOOST_AUTO_TEST_CASE(testParallelBitOperationsEmulation) {
+	std::vector<uint64_t> const & triples = hot::testhelpers::getSampleTriples();
+	std::vector<std::string> const & strings = getLongStrings();
+
+	hot::commons::setParallelBitOperationsImplementation(hot::commons::ParallelBitOperationsImplementation::Emulation);
+	testValues(triples);
+	testValues(hot::testhelpers::stdStringsToCStrings(strings));
+	std::shared_ptr<HOTSingleThreadedUint64> trie = insertWithoutCheck(triples);
+
+	//the emulation steps are stored in the partial key mappings regardless of the selected implementation, therefore the implementation can be changed at any time
+	hot::commons::setParallelBitOperationsImplementation(hot::commons::ParallelBitOperationsImplementation::Instructions);
+	for(uint64_t triple : triples) {
+		BOOST_REQUIRE(trie->lookup(triple).mIsValid);
+	}
+	BOOST_REQUIRE((isSubTreeValid<uint64_t, idx::contenthelpers::IdentityKeyExtractor>(&trie->mRoot)));
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(testKeysLongerThanMaximumKeyLengthAreRejected) {
+	//with USE_LONG_KEYS the keys are longer than 8191 bytes, otherwise they are longer than 255 bytes
+	constexpr size_t maximumKeyLength = idx::contenthelpers::MAX_STRING_KEY_LENGTH;
+	std::string const longestKey(maximumKeyLength - 1u, 'a');
+	std::string const tooLongKey = longestKey + "b";
+	std::string const muchTooLongKey = longestKey + std::string(maximumKeyLength, 'c');
+
+	CStringTrieType trie;
+	BOOST_REQUIRE(trie.insert("a"));
+	BOOST_REQUIRE(trie.insert(longestKey.c_str()));
+	BOOST_REQUIRE_THROW(trie.insert(tooLongKey.c_str()), std::length_error);
+	BOOST_REQUIRE_THROW(trie.upsert(muchTooLongKey.c_str()), std::length_error);
+	BOOST_REQUIRE_EQUAL(trie.mRoot.getNumberEntries(), 2u);
+	BOOST_REQUIRE(trie.lookup(longestKey.c_str()).mIsValid);
+	//the too long keys share their first bytes with the longest key, but must neither be found nor match it
+	BOOST_REQUIRE(!trie.lookup(tooLongKey.c_str()).mIsValid);
+	BOOST_REQUIRE(!trie.lookup(muchTooLongKey.c_str()).mIsValid);
+
+	std::vector<char const *> sortedKeys { "a", longestKey.c_str(), tooLongKey.c_str() };
+	CStringTrieType bulkLoadedTrie;
+	BOOST_REQUIRE_THROW(bulkLoadedTrie.bulkLoad(sortedKeys.begin(), sortedKeys.end()), std::length_error);
+	BOOST_REQUIRE(bulkLoadedTrie.isEmpty());
+	BOOST_REQUIRE_THROW(hot::singlethreaded::bulkLoadParallel(bulkLoadedTrie, sortedKeys.begin(), sortedKeys.end()), std::length_error);
+	BOOST_REQUIRE(bulkLoadedTrie.isEmpty());
+
+	//length delimited keys do not require a terminating zero byte, hence they may use all bytes up to the maximum key length
+	using EntryType = std::pair<idx::contenthelpers::LengthDelimitedKey, uint64_t>;
+	using LengthDelimitedTrieType = hot::singlethreaded::HOTSingleThreaded<EntryType*, idx::contenthelpers::PairPointerKeyExtractor>;
+	EntryType longestEntry { { tooLongKey.data(), maximumKeyLength }, 1u };
+	EntryType tooLongEntry { { muchTooLongKey.data(), maximumKeyLength + 1u }, 2u };
+	LengthDelimitedTrieType lengthDelimitedTrie;
+	BOOST_REQUIRE(lengthDelimitedTrie.insert(&longestEntry));
+	BOOST_REQUIRE_THROW(lengthDelimitedTrie.insert(&tooLongEntry), std::length_error);
+	BOOST_REQUIRE_THROW(lengthDelimitedTrie.upsert(&tooLongEntry), std::length_error);
+	BOOST_REQUIRE_EQUAL(lengthDelimitedTrie.lookup(longestEntry.first).mValue, &longestEntry);
+	BOOST_REQUIRE(!lengthDelimitedTrie.lookup({ tooLongKey.data(), maximumKeyLength - 1u }).mIsValid);
+	//the first bytes of this key are equal to the bytes of the stored key, hence it would match the stored key if it was truncated
+	std::string const keyExtendingStoredKey = tooLongKey + "d";
+	BOOST_REQUIRE(!lengthDelimitedTrie.lookup({ keyExtendingStoredKey.data(), keyExtendingStoredKey.size() }).mIsValid);
+}
+
+template<typename KeyType> void testKeysEndingWithZeroByteAreRejected() {
+	using EntryType = std::pair<KeyType, uint64_t>;
+	using TrieType = hot::singlethreaded::HOTSingleThreaded<EntryType*, idx::contenthelpers::PairPointerKeyExtractor>;
+
+	//a trailing zero byte cannot be distinguished from the zero padding of the key without it
+	EntryType entry { KeyType { "a", 1u }, 1u };
+	EntryType entryWithTrailingZeroByte { KeyType { "a\0", 2u }, 2u };
+	EntryType entryWithZeroByte { KeyType { "a\0b", 3u }, 3u };
+	TrieType trie;
+	BOOST_REQUIRE(trie.insert(&entry));
+	BOOST_REQUIRE_THROW(trie.insert(&entryWithTrailingZeroByte), std::invalid_argument);
+	BOOST_REQUIRE_THROW(trie.upsert(&entryWithTrailingZeroByte), std::invalid_argument);
+	BOOST_REQUIRE(trie.insert(&entryWithZeroByte));
+	BOOST_REQUIRE_EQUAL(trie.lookup(KeyType { "a", 1u }).mValue, &entry);
+	BOOST_REQUIRE(!trie.lookup(KeyType { "a\0", 2u }).mIsValid);
+	BOOST_REQUIRE(!trie.remove(KeyType { "a\0", 2u }));
+	BOOST_REQUIRE(trie.lookup(KeyType { "a", 1u }).mIsValid);
+
+	std::vector<EntryType*> sortedEntries { &entry, &entryWithTrailingZeroByte, &entryWithZeroByte };
+	TrieType bulkLoadedTrie;
+	BOOST_REQUIRE_THROW(bulkLoadedTrie.bulkLoad(sortedEntries.begin(), sortedEntries.end()), std::invalid_argument);
+	BOOST_REQUIRE(bulkLoadedTrie.isEmpty());
+	BOOST_REQUIRE_THROW(hot::singlethreaded::bulkLoadParallel(bulkLoadedTrie, sortedEntries.begin(), sortedEntries.end()), std::invalid_argument);
+	BOOST_REQUIRE(bulkLoadedTrie.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(testLengthDelimitedKeysEndingWithZeroByteAreRejected) {
+	testKeysEndingWithZeroByteAreRejected<idx::contenthelpers::LengthDelimitedKey>();
+}
+
+#if __cplusplus >= 201703L
+BOOST_AUTO_TEST_CASE(testStringViewKeysEndingWithZeroByteAreRejected) {
+	testKeysEndingWithZeroByteAreRejected<std::string_view>();
+}
+#endif
 
 BOOST_AUTO_TEST_SUITE_END()
 
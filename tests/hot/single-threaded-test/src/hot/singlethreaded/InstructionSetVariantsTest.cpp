@@ -0,0 +1,75 @@
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hot/commons/InstructionSet.hpp>
+
+#include "hot/singlethreaded/InstructionSetVariants.hpp"
+#include "hot/singlethreaded/InstructionSetVariantWorkload.hpp"
+
+namespace hot { namespace singlethreaded {
+
+InstructionSetVariant getCompiledInstructionSetVariant() {
+	return { hot::commons::COMPILED_INSTRUCTION_SET, &runInstructionSetVariantWorkload };
+}
+
+BOOST_AUTO_TEST_SUITE(InstructionSetVariantsTest)
+
+BOOST_AUTO_TEST_CASE(testVariantsComputeTheSameResults) {
+	std::mt19937_64 randomNumberGenerator(42u);
+	std::vector<uint64_t> integerKeys;
+	std::vector<std::string> stringKeys;
+	for(size_t i = 0u; i < 20000u; ++i) {
+		uint64_t randomNumber = randomNumberGenerator();
+		//the modulo introduces duplicates
+		integerKeys.push_back(randomNumber % 50000u);
+		//keys with long common prefixes and different lengths require partial key mappings with multiple extraction masks
+		stringKeys.push_back(std::string(randomNumber % 64u, 'a') + std::to_string(randomNumber >> 40u) + std::string((randomNumber >> 8u) % 48u, 'b'));
+	}
+
+	InstructionSetVariant compiledVariant = getCompiledInstructionSetVariant();
+	std::vector<std::string> expectedDescription = compiledVariant.mRunWorkload(integerKeys, stringKeys);
+
+	for(InstructionSetVariant const & variant : { getAVX2InstructionSetVariant(), getAVX512InstructionSetVariant() }) {
+		if(variant.mInstructionSet > hot::commons::getSupportedInstructionSet()) {
+			BOOST_TEST_MESSAGE("skipping variant " << static_cast<unsigned>(variant.mInstructionSet) << " as it is not supported by the processor");
+			continue;
+		}
+		std::vector<std::string> description = variant.mRunWorkload(integerKeys, stringKeys);
+		BOOST_REQUIRE_EQUAL(description.size(), expectedDescription.size());
+		BOOST_REQUIRE(description == expectedDescription);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testSelectionOfVariants) {
+	using hot::commons::InstructionSet;
+	using hot::commons::selectForSupportedInstructionSet;
+
+	InstructionSetVariantWorkload baseline = getCompiledInstructionSetVariant().mRunWorkload;
+	InstructionSetVariantWorkload avx2 = getAVX2InstructionSetVariant().mRunWorkload;
+	InstructionSetVariantWorkload avx512 = getAVX512InstructionSetVariant().mRunWorkload;
+
+	std::array<InstructionSetVariantWorkload, hot::commons::NUMBER_INSTRUCTION_SETS> allVariants { { baseline, avx2, avx512 } };
+	BOOST_REQUIRE(selectForSupportedInstructionSet(allVariants, InstructionSet::SSE2) == baseline);
+	BOOST_REQUIRE(selectForSupportedInstructionSet(allVariants, InstructionSet::AVX2) == avx2);
+	BOOST_REQUIRE(selectForSupportedInstructionSet(allVariants, InstructionSet::AVX512) == avx512);
+
+	//falls back to the highest available variant
+	std::array<InstructionSetVariantWorkload, hot::commons::NUMBER_INSTRUCTION_SETS> withoutAVX512 { { baseline, avx2, nullptr } };
+	BOOST_REQUIRE(selectForSupportedInstructionSet(withoutAVX512, InstructionSet::AVX512) == avx2);
+
+	std::array<InstructionSetVariantWorkload, hot::commons::NUMBER_INSTRUCTION_SETS> onlyBaseline { { baseline, nullptr, nullptr } };
+	BOOST_REQUIRE(selectForSupportedInstructionSet(onlyBaseline, InstructionSet::AVX512) == baseline);
+
+	//without an explicit instruction set, the variant supported by the processor is selected
+	hot::commons::InstructionSet supportedInstructionSet = hot::commons::getSupportedInstructionSet();
+	BOOST_REQUIRE(selectForSupportedInstructionSet(allVariants) == allVariants[static_cast<size_t>(supportedInstructionSet)]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}}
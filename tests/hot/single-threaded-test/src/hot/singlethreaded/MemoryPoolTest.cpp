@@ -3,6 +3,7 @@
 //
 
 #include <iostream>
+#include <vector>
 
 #include <hot/singlethreaded/MemoryPool.hpp>
 #include <boost/test/unit_test.hpp>
@@ -103,6 +104,87 @@ BOOST_AUTO_TEST_CASE(testEviction) {
 	BOOST_REQUIRE_EQUAL(pool->getNumberFrees(), 28u);
 }
 
+BOOST_AUTO_TEST_CASE(testArenaBackedPool)
+{
+	MemoryArena arena;
+	MemoryPool<DummyElement, 10, 20, 8>* pool = new MemoryPool<DummyElement, 10, 20, 8>(&arena);
+
+	std::array<void*, 30> memory;
+	for(size_t i=0u; i < 30u; ++i) {
+		memory[i] = pool->alloc(4);
+	}
+	BOOST_REQUIRE_EQUAL(pool->getNumberAllocations(), 30u);
+	BOOST_REQUIRE_EQUAL(arena.getNumberChunks(), 1u);
+
+	//memory returned to an arena backed pool is never evicted
+	for(size_t i=0u; i < 30u; ++i) {
+		pool->returnToPool(4, memory[i]);
+	}
+	BOOST_REQUIRE_EQUAL(pool->getNumberFrees(), 0u);
+	for(size_t i=0u; i < 30u; ++i) {
+		pool->alloc(4);
+	}
+	BOOST_REQUIRE_EQUAL(pool->getNumberAllocations(), 30u);
+
+	arena.releaseAll();
+	pool->discardFreeLists();
+	BOOST_REQUIRE_EQUAL(arena.getNumberChunks(), 0u);
+	BOOST_REQUIRE(pool->alloc(4) != nullptr);
+	BOOST_REQUIRE_EQUAL(pool->getNumberAllocations(), 31u);
+	BOOST_REQUIRE_EQUAL(arena.getNumberChunks(), 1u);
+
+	delete pool;
+	BOOST_REQUIRE_EQUAL(arena.getNumberChunks(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(testReleasingFreeListsOfArenaBackedPool)
+{
+	MemoryArena arena;
+	MemoryPool<DummyElement, 10, 20, 8> pool(&arena);
+
+	//allocations of 80 bytes fill more than two chunks
+	std::vector<void*> memory;
+	while(arena.getNumberChunks() < 3u) {
+		memory.push_back(pool.alloc(10));
+	}
+	for(void* rawMemory : memory) {
+		pool.returnToPool(10, rawMemory);
+	}
+	BOOST_REQUIRE_EQUAL(arena.getNumberChunks(), 3u);
+
+	//only the chunk memory is currently allocated from is retained
+	pool.releaseFreeLists();
+	BOOST_REQUIRE_EQUAL(pool.getNumberFrees(), memory.size());
+	BOOST_REQUIRE_EQUAL(arena.getNumberChunks(), 1u);
+	BOOST_REQUIRE(pool.alloc(10) != nullptr);
+	BOOST_REQUIRE_EQUAL(arena.getNumberChunks(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(testStartingNewArenaChunk)
+{
+	MemoryArena arena;
+	MemoryPool<DummyElement, 10, 20, 8> pool(&arena);
+
+	//an empty arena does not allocate a chunk in advance
+	pool.startNewArenaChunk();
+	BOOST_REQUIRE_EQUAL(arena.getNumberChunks(), 0u);
+
+	void* previousMemory = pool.alloc(10);
+	pool.startNewArenaChunk();
+	void* memory = pool.alloc(10);
+	BOOST_REQUIRE_EQUAL(arena.getNumberChunks(), 2u);
+	BOOST_REQUIRE_NE(reinterpret_cast<uintptr_t>(previousMemory) / MEMORY_ARENA_CHUNK_SIZE, reinterpret_cast<uintptr_t>(memory) / MEMORY_ARENA_CHUNK_SIZE);
+
+	//the previous chunk is freed once its memory is released, while an unused current chunk is reused
+	pool.returnToPool(10, previousMemory);
+	pool.returnToPool(10, memory);
+	pool.releaseFreeLists();
+	BOOST_REQUIRE_EQUAL(arena.getNumberChunks(), 1u);
+	pool.startNewArenaChunk();
+	BOOST_REQUIRE_EQUAL(pool.alloc(10), memory);
+	BOOST_REQUIRE_EQUAL(arena.getNumberChunks(), 1u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }}
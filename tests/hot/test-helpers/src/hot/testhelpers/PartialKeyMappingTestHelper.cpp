@@ -6,6 +6,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <hot/commons/Algorithms.hpp>
 #include <hot/commons/DiscriminativeBit.hpp>
 
 #include "hot/testhelpers/PartialKeyMappingTestHelper.hpp"
@@ -73,7 +74,7 @@ template<unsigned int numberExtractionMasks> void checkRandomExtractionTypeSpeci
 		uint8_t extractionByte =  extractionInformation.getExtractionByte(i);
 		BOOST_REQUIRE_NE(extractionByte, 0);
 
-		allExtractionBitsSet += _mm_popcnt_u32(extractionByte);
+		allExtractionBitsSet += hot::commons::populationCount32(extractionByte);
 	}
 	BOOST_REQUIRE_EQUAL(allExtractionBitsSet, expectedNumberExtractionBits);
 }
@@ -133,18 +134,18 @@ template<typename ExtractionInformationType> void checkExtractionInformationOnEx
 	for(auto reverseBitsPositionIterator = expectedBits.rbegin(); reverseBitsPositionIterator != expectedBits.rend(); ++reverseBitsPositionIterator) {
 		std::array<uint8_t, 256> rawDataWithSingleExtractionBit = getRawBytesWithSingleBitSet(*reverseBitsPositionIterator);
 		uint32_t singleExtractedBit = extractionInformation.extractMask(rawDataWithSingleExtractionBit.data());
-		BOOST_REQUIRE_EQUAL(_mm_popcnt_u32(singleExtractedBit), 1);
+		BOOST_REQUIRE_EQUAL(hot::commons::populationCount32(singleExtractedBit), 1);
 		BOOST_REQUIRE_EQUAL(singleExtractedBit & reverseExtractedMask, 0u);
 
 		reverseExtractedMask |= singleExtractedBit;
-		BOOST_REQUIRE_EQUAL(_mm_popcnt_u32(reverseExtractedMask), expectedNumberReverseMasksBits);
+		BOOST_REQUIRE_EQUAL(hot::commons::populationCount32(reverseExtractedMask), expectedNumberReverseMasksBits);
 		BOOST_REQUIRE_EQUAL(extractionInformation.getMostSignifikantMaskBit(reverseExtractedMask), singleExtractedBit);
 		++expectedNumberReverseMasksBits;
 	}
 
 
 
-	BOOST_REQUIRE_EQUAL(_mm_popcnt_u32(extractionInformation.getAllMaskBits()), extractionInformation.calculateNumberBitsUsed());
+	BOOST_REQUIRE_EQUAL(hot::commons::populationCount32(extractionInformation.getAllMaskBits()), extractionInformation.calculateNumberBitsUsed());
 	BOOST_REQUIRE_EQUAL(extractionInformation.getAllMaskBits(), allBitsSet);
 
 	uint16_t expectedMostLeftBit = *expectedBits.begin();
@@ -203,7 +204,7 @@ template<typename SourceExtractionInformationType, typename ResultExtractionInfo
 	std::array<uint8_t, 256> rawExtractionBytesForValidExtractionBits =  getRawBytesWithBitsSet(validExtractionBits);
 	uint32_t extractionMask = sourceExtractionInformation.extractMask(rawExtractionBytesForValidExtractionBits.data());
 
-	BOOST_REQUIRE_EQUAL(static_cast<unsigned int>(_mm_popcnt_u32(extractionMask)), validExtractionBits.size());
+	BOOST_REQUIRE_EQUAL(static_cast<unsigned int>(hot::commons::populationCount32(extractionMask)), validExtractionBits.size());
 
 	ResultExtractionInformationType resultingExtractionMask = sourceExtractionInformation.extract(extractionMask, [](auto intermediateExtractionMask){
 		return expectReturnTypeForOperation<ResultExtractionInformationType>(intermediateExtractionMask, "Extract");
@@ -249,7 +250,7 @@ template<typename ExtractionInformationType> uint32_t getMaskForBits(ExtractionI
 	}
 	std::array<uint8_t, 256> rawExtractionBytesForValidExtractionBits =  getRawBytesWithBitsSet(bitsToSet);
 	uint32_t resultingMask = extractionInformationType.extractMask(rawExtractionBytesForValidExtractionBits.data());
-	BOOST_REQUIRE_EQUAL(_mm_popcnt_u32(resultingMask), numberBitsSet);
+	BOOST_REQUIRE_EQUAL(hot::commons::populationCount32(resultingMask), numberBitsSet);
 	return resultingMask;
 }
 
@@ -269,7 +270,7 @@ template<typename ExtractionInformationType> uint32_t getMaskWithAlteratingBitsS
 	}
 	std::array<uint8_t, 256> rawExtractionBytesForValidExtractionBits =  getRawBytesWithBitsSet(bitsToSet);
 	uint32_t resultingMask = extractionInformation.extractMask(rawExtractionBytesForValidExtractionBits.data());
-	BOOST_REQUIRE_EQUAL(static_cast<unsigned int>(_mm_popcnt_u32(resultingMask)), bitsSet);
+	BOOST_REQUIRE_EQUAL(static_cast<unsigned int>(hot::commons::populationCount32(resultingMask)), bitsSet);
 
 	return resultingMask;
 }
@@ -288,7 +289,7 @@ template<typename ExtractionInformationType> uint32_t getMaskForBitsWithIndexLar
 
 	std::array<uint8_t, 256> rawExtractionBytesForBitsLargerThanTreshold =  getRawBytesWithBitsSet(bitsLargerThanTreshold);
 	uint32_t bitsLargerThanThresholdMask = extractionInformation.extractMask(rawExtractionBytesForBitsLargerThanTreshold.data());
-	BOOST_REQUIRE_EQUAL(static_cast<unsigned int>(_mm_popcnt_u32(bitsLargerThanThresholdMask)), bitsLargerThanTreshold.size());
+	BOOST_REQUIRE_EQUAL(static_cast<unsigned int>(hot::commons::populationCount32(bitsLargerThanThresholdMask)), bitsLargerThanTreshold.size());
 
 	return bitsLargerThanThresholdMask;
 }
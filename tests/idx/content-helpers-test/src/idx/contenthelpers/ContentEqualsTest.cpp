@@ -5,6 +5,9 @@
 #include <boost/test/unit_test.hpp>
 #include <idx/contenthelpers/ContentEquals.hpp>
 
+#include <limits>
+#include <tuple>
+
 namespace idx { namespace contenthelpers {
 
 BOOST_AUTO_TEST_SUITE(ContentEqualsTest)
@@ -25,6 +28,41 @@ BOOST_AUTO_TEST_CASE(testEqualityCheckPointer) {
 	BOOST_REQUIRE(contenthelpers::contentEquals(sameAddressAsPointer1, pointer2) == false);
 }
 
+BOOST_AUTO_TEST_CASE(testEqualityCheckLengthDelimitedKeys) {
+	//zero bytes are part of a key as long as they are followed by a non zero byte
+	BOOST_REQUIRE(contenthelpers::contentEquals(LengthDelimitedKey { "a\0b", 3u }, LengthDelimitedKey { "a\0b", 3u }) == true);
+	BOOST_REQUIRE(contenthelpers::contentEquals(LengthDelimitedKey { "a\0b", 3u }, LengthDelimitedKey { "a\0\0b", 4u }) == false);
+	BOOST_REQUIRE(contenthelpers::contentEquals(LengthDelimitedKey { "a", 1u }, LengthDelimitedKey { "a\0b", 3u }) == false);
+	BOOST_REQUIRE(contenthelpers::contentEquals(LengthDelimitedKey { "\0a", 2u }, LengthDelimitedKey { "a", 1u }) == false);
+	BOOST_REQUIRE(contenthelpers::contentEquals(LengthDelimitedKey { "", 0u }, LengthDelimitedKey { "a", 1u }) == false);
+	BOOST_REQUIRE(contenthelpers::contentEquals(LengthDelimitedKey { "a", 1u }, LengthDelimitedKey { "a\0", 2u }) == false);
+
+	//keys only differing in trailing zero bytes cannot be distinguished by their zero padded bytes and are therefore invalid
+	BOOST_REQUIRE(isDistinguishableKey(LengthDelimitedKey { "a", 1u }));
+	BOOST_REQUIRE(!isDistinguishableKey(LengthDelimitedKey { "a\0", 2u }));
+	BOOST_REQUIRE(isValidLengthDelimitedKey("a", 1u));
+	BOOST_REQUIRE(isValidLengthDelimitedKey("a\0b", 3u));
+	BOOST_REQUIRE(isValidLengthDelimitedKey("", 0u));
+	BOOST_REQUIRE(!isValidLengthDelimitedKey("a\0", 2u));
+	BOOST_REQUIRE(!isValidLengthDelimitedKey("\0", 1u));
+}
+
+BOOST_AUTO_TEST_CASE(testEqualityCheckFloatingPointKeys) {
+	//NaNs must be equal to themselves, otherwise NaN keys could be inserted but never be found
+	BOOST_REQUIRE(contenthelpers::contentEquals(std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN()) == true);
+	BOOST_REQUIRE(contenthelpers::contentEquals(std::numeric_limits<double>::quiet_NaN(), -std::numeric_limits<double>::signaling_NaN()) == true);
+	BOOST_REQUIRE(contenthelpers::contentEquals(std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN()) == true);
+	BOOST_REQUIRE(contenthelpers::contentEquals(std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity()) == false);
+	BOOST_REQUIRE(contenthelpers::contentEquals(-0.0, 0.0) == true);
+	BOOST_REQUIRE(contenthelpers::contentEquals(1.5f, 1.5f) == true);
+	BOOST_REQUIRE(contenthelpers::contentEquals(1.5f, -1.5f) == false);
+
+	using TupleKey = std::tuple<int32_t, double>;
+	BOOST_REQUIRE(contenthelpers::contentEquals(TupleKey { 1, std::numeric_limits<double>::quiet_NaN() }, TupleKey { 1, std::numeric_limits<double>::quiet_NaN() }) == true);
+	BOOST_REQUIRE(contenthelpers::contentEquals(TupleKey { 1, std::numeric_limits<double>::quiet_NaN() }, TupleKey { 2, std::numeric_limits<double>::quiet_NaN() }) == false);
+	BOOST_REQUIRE(contenthelpers::contentEquals(TupleKey { 1, 2.0 }, TupleKey { 1, 2.0 }) == true);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }}
\ No newline at end of file
@@ -5,6 +5,9 @@
 #include <boost/test/unit_test.hpp>
 #include <idx/contenthelpers/KeyComparator.hpp>
 
+#include <limits>
+#include <tuple>
+
 namespace idx { namespace contenthelpers {
 
 BOOST_AUTO_TEST_SUITE(KeyComparatorTest)
@@ -25,6 +28,26 @@ BOOST_AUTO_TEST_CASE(testKeyComparatorForCString) {
 	BOOST_REQUIRE(compare("A", "A") == false);
 }
 
+BOOST_AUTO_TEST_CASE(testKeyComparatorForFloatingPointTypes) {
+	typename idx::contenthelpers::KeyComparator<double>::type compare;
+	double nan = std::numeric_limits<double>::quiet_NaN();
+
+	BOOST_REQUIRE(compare(-1.0, 1.0) == true);
+	BOOST_REQUIRE(compare(1.0, -1.0) == false);
+	BOOST_REQUIRE(compare(-0.0, 0.0) == false);
+	BOOST_REQUIRE(compare(std::numeric_limits<double>::infinity(), nan) == true);
+	BOOST_REQUIRE(compare(nan, std::numeric_limits<double>::infinity()) == false);
+	BOOST_REQUIRE(compare(nan, nan) == false);
+}
+
+BOOST_AUTO_TEST_CASE(testKeyComparatorForTuples) {
+	typename idx::contenthelpers::KeyComparator<std::tuple<int32_t, double>>::type compare;
+	double nan = std::numeric_limits<double>::quiet_NaN();
+
+	BOOST_REQUIRE(compare(std::make_tuple(-1, nan), std::make_tuple(1, 0.0)) == true);
+	BOOST_REQUIRE(compare(std::make_tuple(1, 0.0), std::make_tuple(1, nan)) == true);
+	BOOST_REQUIRE(compare(std::make_tuple(1, nan), std::make_tuple(1, nan)) == false);
+}
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <idx/contenthelpers/KeyUtilities.hpp>
+#include <idx/contenthelpers/OrderPreservingKeyEncoder.hpp>
+
+namespace idx { namespace contenthelpers {
+
+template<typename KeyType> int compareEncodedKeys(KeyType const & first, KeyType const & second) {
+	auto const & encodedFirst = encodeOrderPreserving(first);
+	auto const & encodedSecond = encodeOrderPreserving(second);
+	return std::memcmp(encodedFirst.data(), encodedSecond.data(), encodedFirst.size());
+}
+
+/**
+ * checks that the encoded keys are ordered like the keys themselves, by comparing each pair of adjacent keys after sorting them
+ */
+template<typename KeyType> void checkOrderIsPreserved(std::vector<KeyType> keys) {
+	std::sort(keys.begin(), keys.end());
+	for(size_t i = 1u; i < keys.size(); ++i) {
+		int comparisonResult = compareEncodedKeys(keys[i - 1u], keys[i]);
+		BOOST_REQUIRE(keys[i - 1u] < keys[i] ? comparisonResult < 0 : comparisonResult == 0);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(OrderPreservingKeyEncoderTest)
+
+BOOST_AUTO_TEST_CASE(testEncodedLengths) {
+	BOOST_REQUIRE_EQUAL(OrderPreservingKeyEncoder<int8_t>::ENCODED_LENGTH, 1u);
+	BOOST_REQUIRE_EQUAL(OrderPreservingKeyEncoder<int64_t>::ENCODED_LENGTH, 8u);
+	BOOST_REQUIRE_EQUAL(OrderPreservingKeyEncoder<float>::ENCODED_LENGTH, 4u);
+	BOOST_REQUIRE_EQUAL(OrderPreservingKeyEncoder<unsigned __int128>::ENCODED_LENGTH, 16u);
+	BOOST_REQUIRE_EQUAL((OrderPreservingKeyEncoder<std::array<uint8_t, 16u>>::ENCODED_LENGTH), 16u);
+	BOOST_REQUIRE_EQUAL((OrderPreservingKeyEncoder<std::tuple<int32_t, double, uint16_t>>::ENCODED_LENGTH), 14u);
+	BOOST_REQUIRE(!OrderPreservingKeyEncoder<char const *>::IS_SUPPORTED);
+
+	BOOST_REQUIRE_EQUAL(getMaxKeyLength<int32_t>(), 4u);
+	BOOST_REQUIRE_EQUAL((getMaxKeyLength<std::tuple<int32_t, double, uint16_t>>()), 14u);
+	BOOST_REQUIRE_EQUAL(getMaxKeyLength<uint64_t>(), 8u);
+}
+
+BOOST_AUTO_TEST_CASE(testUnsignedIntegersAreEncodedInBigEndianByteOrder) {
+	std::array<uint8_t, 4> const expectedBytes { { 0x01, 0x02, 0x03, 0x04 } };
+	BOOST_REQUIRE(encodeOrderPreserving(static_cast<uint32_t>(0x01020304u)) == expectedBytes);
+
+	unsigned __int128 largeKey = (static_cast<unsigned __int128>(0x0102030405060708ul) << 64u) | 0x090a0b0c0d0e0f10ul;
+	std::array<uint8_t, 16> const & encodedLargeKey = encodeOrderPreserving(largeKey);
+	for(size_t i = 0u; i < encodedLargeKey.size(); ++i) {
+		BOOST_REQUIRE_EQUAL(encodedLargeKey[i], i + 1u);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testSignedIntegers) {
+	checkOrderIsPreserved<int8_t>({ INT8_MIN, -100, -1, 0, 1, 100, INT8_MAX });
+	checkOrderIsPreserved<int16_t>({ INT16_MIN, -256, -255, -1, 0, 1, 255, 256, INT16_MAX });
+	checkOrderIsPreserved<int64_t>({ INT64_MIN, INT64_MIN + 1, -4294967296l, -1, 0, 1, 4294967296l, INT64_MAX - 1, INT64_MAX });
+
+	std::mt19937_64 randomGenerator(42u);
+	std::vector<int32_t> randomKeys;
+	std::vector<__int128> randomLargeKeys;
+	for(size_t i = 0u; i < 10000u; ++i) {
+		randomKeys.push_back(static_cast<int32_t>(randomGenerator()));
+		randomLargeKeys.push_back(static_cast<__int128>((static_cast<unsigned __int128>(randomGenerator()) << 64u) | randomGenerator()));
+	}
+	checkOrderIsPreserved(randomKeys);
+	checkOrderIsPreserved(randomLargeKeys);
+}
+
+BOOST_AUTO_TEST_CASE(testFloatingPointNumbers) {
+	double const infinity = std::numeric_limits<double>::infinity();
+	checkOrderIsPreserved<double>({
+		-infinity, std::numeric_limits<double>::lowest(), -1e100, -1.5, -1.0, -std::numeric_limits<double>::denorm_min(), -0.0, 0.0,
+		std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::min(), 1.0, 1.5, 1e100, std::numeric_limits<double>::max(), infinity
+	});
+	checkOrderIsPreserved<float>({ -std::numeric_limits<float>::infinity(), -3.5f, -0.0f, 0.0f, 1e-40f, 3.5f, std::numeric_limits<float>::infinity() });
+
+	BOOST_REQUIRE_EQUAL(compareEncodedKeys(-0.0, 0.0), 0);
+	BOOST_REQUIRE_EQUAL(compareEncodedKeys(std::numeric_limits<double>::quiet_NaN(), -std::numeric_limits<double>::quiet_NaN()), 0);
+	BOOST_REQUIRE_GT(compareEncodedKeys(std::numeric_limits<double>::quiet_NaN(), infinity), 0);
+
+	std::mt19937_64 randomGenerator(42u);
+	std::normal_distribution<double> distribution(0.0, 1000.0);
+	std::vector<double> randomKeys;
+	for(size_t i = 0u; i < 10000u; ++i) {
+		randomKeys.push_back(distribution(randomGenerator));
+	}
+	checkOrderIsPreserved(randomKeys);
+}
+
+BOOST_AUTO_TEST_CASE(testUuids) {
+	using Uuid = std::array<uint8_t, 16>;
+	checkOrderIsPreserved<Uuid>({
+		Uuid { { 0x00 } }, Uuid { { 0x00, 0x01 } }, Uuid { { 0x01 } }, Uuid { { 0x7f, 0xff } }, Uuid { { 0x80 } },
+		Uuid { { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe } },
+		Uuid { { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } }
+	});
+}
+
+BOOST_AUTO_TEST_CASE(testTuples) {
+	using CompositeKey = std::tuple<int32_t, double, uint16_t>;
+	std::vector<CompositeKey> keys;
+	for(int32_t first : { INT32_MIN, -1, 0, 1, INT32_MAX }) {
+		for(double second : { -2.5, -0.5, 0.0, 0.5, 2.5 }) {
+			for(uint16_t third : { 0u, 1u, 255u, 256u, 65535u }) {
+				keys.emplace_back(first, second, third);
+			}
+		}
+	}
+	checkOrderIsPreserved(keys);
+
+	std::mt19937_64 randomGenerator(42u);
+	std::vector<std::tuple<int8_t, int64_t>> randomKeys;
+	for(size_t i = 0u; i < 10000u; ++i) {
+		randomKeys.emplace_back(static_cast<int8_t>(randomGenerator() % 4u) - 2, static_cast<int64_t>(randomGenerator()));
+	}
+	checkOrderIsPreserved(randomKeys);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}}